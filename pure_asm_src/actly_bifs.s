@@ -42,6 +42,9 @@
     .text
     .align 4
 
+// Include configuration constants
+    .include "config.inc"
+
 // Define constants (matching scheduler.s and config.inc)
 .equ MAX_CORES, 128
 .equ PRIORITY_LEVELS, 4
@@ -58,23 +61,11 @@
 .equ BIF_YIELD_COST, 1
 .equ MAX_BLOCKING_TIME, 1000000
 
-// Define structure offsets (matching scheduler.s)
-.equ scheduler_current_reductions, 112
-.equ scheduler_total_yields, 128
-.equ scheduler_queues, 8
-.equ queue_count, 16
-    .equ scheduler_size, 248
-.equ queue_size, 24
-
-// Define PCB offsets (matching process.s)
-.equ pcb_state, 32
-.equ pcb_priority, 40
-.equ pcb_next, 0
-.equ pcb_prev, 8
-.equ pcb_blocking_data, 440
-.equ pcb_message_queue, 368
-.equ pcb_stack_base, 336
-.equ pcb_heap_base, 352
+// Scheduler state offsets (shared with scheduler.s)
+    .include "scheduler_state.inc"
+
+// PCB offsets (shared with process.s)
+    .include "pcb.inc"
 
 // Define size constants
 .equ MAX_STACK_SIZE, 65536
@@ -86,11 +77,13 @@
 .extern _scheduler_get_current_process
 .extern _scheduler_decrement_reductions
 .extern _scheduler_enqueue_process
+.extern _scheduler_inject_process
 .extern _scheduler_schedule
 .extern _process_save_context
 .extern _process_restore_context
 .extern _process_create
 .extern _process_preempt
+.extern _process_cancel_timeout
 
 // ------------------------------------------------------------
 // Actly BIF Function Exports
@@ -198,23 +191,26 @@ actly_yield_no_process:
 // Actly Spawn BIF Function
 // ------------------------------------------------------------
 // Spawn new process with specified parameters. This implements BEAM's
-// erlang:spawn/1 behavior with reduction counting.
+// erlang:spawn/1 behavior with reduction counting. The new process is
+// handed to the target scheduler with _scheduler_inject_process, so
+// the caller may run on any scheduler or thread.
 //
 // Parameters:
-//   x0 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
-//   x1 (uint64_t) - entry_point: Process entry point address
-//   x2 (uint64_t) - priority: Process priority level
-//   x3 (uint64_t) - stack_size: Stack size in bytes
-//   x4 (uint64_t) - heap_size: Heap size in bytes
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//   x2 (uint64_t) - entry_point: Process entry point address
+//   x3 (uint64_t) - priority: Process priority level
+//   x4 (uint64_t) - stack_size: Stack size in bytes
+//   x5 (uint64_t) - heap_size: Heap size in bytes
 //
 // Returns:
 //   x0 (uint64_t) - pid: New process PID on success, 0 on failure
 //
 // Complexity: O(1) - Constant time spawn operation
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 // Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16, x17, x18, x19, x20, x21, x22, x23, x24, x25, x26, x27, x28, x29, x30
 //
@@ -224,14 +220,16 @@ _actly_spawn:
     stp x21, x22, [sp, #-16]!
     stp x23, x24, [sp, #-16]!
     stp x25, x26, [sp, #-16]!
-    stp x27, x30, [sp], #16
+    stp x27, x30, [sp, #-16]!
 
-    // x0 = core_id, x1 = entry_point, x2 = priority, x3 = stack_size, x4 = heap_size
-    mov x19, x0  // Save core_id
-    mov x20, x1  // Save entry_point
-    mov x21, x2  // Save priority
-    mov x22, x3  // Save stack_size
-    mov x23, x4  // Save heap_size
+    // x0 = scheduler_states, x1 = core_id, x2 = entry_point, x3 = priority,
+    // x4 = stack_size, x5 = heap_size
+    mov x25, x0  // Save scheduler_states pointer
+    mov x19, x1  // Save core_id
+    mov x20, x2  // Save entry_point
+    mov x21, x3  // Save priority
+    mov x22, x4  // Save stack_size
+    mov x23, x5  // Save heap_size
 
     // Validate core ID
     cmp x19, #MAX_CORES
@@ -254,8 +252,9 @@ _actly_spawn:
     b.lt actly_spawn_invalid_heap_size
 
     // Decrement reduction count (spawn costs 10 reductions)
-    mov x0, x19  // core_id
-    mov x1, #BIF_SPAWN_COST  // reduction cost
+    mov x0, x25  // scheduler_states
+    mov x1, x19  // core_id
+    mov x2, #BIF_SPAWN_COST  // reduction cost
     bl _actly_bif_trap_check
     cbz x0, actly_spawn_preempted  // If preempted, return 0
 
@@ -270,11 +269,12 @@ _actly_spawn:
     // If creation failed, return 0
     cbz x24, actly_spawn_creation_failed
 
-    // Enqueue new process to ready queue
-    mov x0, x19  // core_id
-    mov x1, x24  // pcb (PID is also PCB pointer in our implementation)
-    mov x2, x21  // priority
-    bl _scheduler_enqueue_process
+    // Hand the new process to the target scheduler's inbox
+    mov x0, x25  // scheduler_states
+    mov x1, x19  // core_id
+    mov x2, x24  // pcb (PID is also PCB pointer in our implementation)
+    mov x3, x21  // priority
+    bl _scheduler_inject_process
 
     // Return new process PID
     mov x0, x24
@@ -390,6 +390,10 @@ _actly_exit:
     bl _actly_bif_trap_check
     cbz x0, actly_exit_preempted  // If preempted, return 0
 
+    // Drop any pending timeout before blocking_data is reused
+    mov x0, x21
+    bl _process_cancel_timeout
+
     // Save exit reason in PCB
     str x20, [x21, #pcb_blocking_data]  // Use blocking_data for exit reason
 
@@ -475,17 +479,18 @@ actly_exit_preempted:
 // This implements BEAM's BIF trap mechanism for reduction-based preemption.
 //
 // Parameters:
-//   x0 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
-//   x1 (uint64_t) - reduction_cost: Number of reductions to decrement
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//   x2 (uint64_t) - reduction_cost: Number of reductions to decrement
 //
 // Returns:
 //   x0 (int) - status: 0 = preempted, 1 = continued
 //
 // Complexity: O(1) - Constant time trap check
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 // Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16, x17, x18, x19, x20, x21, x22, x23, x24, x25, x26, x27, x28, x29, x30
 //
@@ -494,7 +499,7 @@ _actly_bif_trap_check:
     stp x19, x20, [sp, #-16]!
     stp x21, x22, [sp, #-16]!
     stp x23, x24, [sp, #-16]!
-    stp x25, x30, [sp], #16
+    stp x25, x30, [sp, #-16]!
 
     // x0 = scheduler_states, x1 = core_id, x2 = reduction_cost
     mov x19, x0  // Save scheduler_states pointer
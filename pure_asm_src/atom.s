@@ -0,0 +1,761 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// atom.s — Lock-Free Atom Table
+// ------------------------------------------------------------
+// Interns atom names to dense indices shared by every scheduler. An
+// atom term (term.s) carries its index, so atoms compare as words and
+// message dispatch on tags never touches a string; names are hashed
+// only when they are interned or looked up.
+//
+// Buckets are open-addressed: one control byte each (empty, busy or
+// 0x80 | top 7 hash bits) plus the atom index. A probe loads a
+// 16-byte group of control bytes with NEON and compares all of them
+// against the hash tag at once; only tag matches touch a name.
+//
+// Lookups take no locks and never wait. An insert claims an empty
+// control byte with an exclusive byte store (empty -> busy), reserves
+// its index and arena bytes with exclusive stores, writes the name,
+// then publishes the byte with a store-release. An insert that meets
+// a busy byte in its group waits for that one publish, since it may be
+// the same name; a lookup treats the busy bucket as not yet holding
+// the name. Probes of other groups are never held up.
+//
+// Every table starts with @false (0) and @true (1), then the
+// compile-time atoms passed to _atom_table_create in order. Their
+// names sit in the first pages of the name arena, which are made
+// read-only once they are interned.
+//
+// The file provides:
+//   - Table creation with pre-interned, read-only compile-time atoms
+//   - Concurrent intern and lock-free lookup
+//   - Name and count queries
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// External C library functions for memory management
+    .extern _mmap
+    .extern _munmap
+    .extern _mprotect
+
+// ------------------------------------------------------------
+// Atom Function Exports
+// ------------------------------------------------------------
+// Export the atom table functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _atom_table_create
+    .global _atom_table_destroy
+    .global _atom_intern
+    .global _atom_lookup
+    .global _atom_name
+    .global _atom_table_count
+    .global _atom_is_static
+
+// ------------------------------------------------------------
+// Atom Table Layout
+// ------------------------------------------------------------
+// One mapping: the name arena (read-only prefix, then dynamic names),
+// the 128-byte header the table pointer refers to, the control bytes,
+// the u32 bucket indices and the u64 record pointer of each atom. A
+// name record is a u64 length followed by the bytes, padded to 8.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ atom_base, 0                 // Mapping and arena start (8 bytes)
+    .equ atom_length, 8               // Mapping length for munmap (8 bytes)
+    .equ atom_capacity, 16            // Most atoms (8 bytes)
+    .equ atom_bucket_mask, 24         // buckets - 1, buckets = 2 * capacity (8 bytes)
+    .equ atom_next, 32                // Indices reserved (8 bytes, atomic)
+    .equ atom_arena_cursor, 40        // Next free arena byte (8 bytes, atomic)
+    .equ atom_arena_size, 48          // Arena bytes (8 bytes)
+    .equ atom_sealed, 56              // Read-only arena bytes (8 bytes)
+    .equ atom_controls, 64            // Control bytes (8 bytes)
+    .equ atom_slots, 72               // Bucket atom indices, u32 (8 bytes)
+    .equ atom_entries, 80             // Record pointer per atom (8 bytes)
+    .equ atom_static_count, 88        // Atoms in the read-only segment (8 bytes)
+    .equ atom_header_size, 128
+
+    .equ atom_record_length, 0        // Name bytes (8 bytes)
+    .equ atom_record_name, 8          // Name, padded to 8
+
+    .equ ATOM_BUILTIN_ARENA_BYTES, 32 // "false" and "true" records
+    .equ PROT_READ, 1
+
+    .equ FNV_PRIME_LOW, 0x1b3         // 64-bit FNV prime 0x100000001b3
+    .equ FNV_PRIME_HIGH, 0x100
+
+// ------------------------------------------------------------
+// Atom Table Create
+// ------------------------------------------------------------
+// Create a table holding @false, @true and the given compile-time
+// atoms (indices 2, 3, ... in order; a repeated name keeps its first
+// index), and make their names read-only.
+//
+// Parameters:
+//   x0 (uint64_t) - capacity: Most atoms, a power of two from
+//                   ATOM_TABLE_MIN_CAPACITY to ATOM_TABLE_MAX_CAPACITY
+//   x1 (const char**) - names: NUL-terminated names, or NULL if count is 0
+//   x2 (uint64_t) - count: Compile-time atoms, at most
+//                   capacity - ATOM_BUILTIN_COUNT
+//
+// Returns:
+//   x0 (void*) - table: Atom table, or NULL on invalid arguments (a
+//                NULL name, a name over ATOM_MAX_LENGTH bytes) or if
+//                mapping or sealing fails
+//
+// Complexity: O(total name length)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_atom_table_create:
+    cmp x0, #ATOM_TABLE_MIN_CAPACITY
+    b.lo atom_table_create_invalid
+    mov x9, #ATOM_TABLE_MAX_CAPACITY
+    cmp x0, x9
+    b.hi atom_table_create_invalid
+    sub x9, x0, #1
+    tst x0, x9
+    b.ne atom_table_create_invalid
+    sub x9, x0, #ATOM_BUILTIN_COUNT
+    cmp x2, x9
+    b.hi atom_table_create_invalid
+    cbz x2, atom_table_create_start
+    cbz x1, atom_table_create_invalid
+
+atom_table_create_start:
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    stp x26, x27, [sp, #-16]!
+
+    mov x19, x0                       // capacity
+    mov x20, x1                       // names
+    mov x21, x2                       // count
+
+    // Size the read-only segment: every compile-time record
+    mov x22, #ATOM_BUILTIN_ARENA_BYTES
+    mov x9, #0
+atom_table_create_measure:
+    cmp x9, x21
+    b.hs atom_table_create_measured
+    ldr x10, [x20, x9, lsl #3]
+    cbz x10, atom_table_create_rejected
+    mov x11, #0
+atom_table_create_strlen:
+    ldrb w12, [x10, x11]
+    cbz w12, atom_table_create_measured_one
+    add x11, x11, #1
+    cmp x11, #ATOM_MAX_LENGTH
+    b.hi atom_table_create_rejected
+    b atom_table_create_strlen
+
+atom_table_create_measured_one:
+    add x11, x11, #(atom_record_name + 7)
+    and x11, x11, #~7
+    add x22, x22, x11
+    add x9, x9, #1
+    b atom_table_create_measure
+
+atom_table_create_measured:
+    mov x10, #(ATOM_SEAL_ALIGN - 1)
+    add x22, x22, x10
+    and x22, x22, #~(ATOM_SEAL_ALIGN - 1) // Read-only bytes
+    mov x9, #ATOM_ARENA_BYTES_PER_ATOM
+    mul x23, x19, x9                  // Dynamic name budget
+    add x23, x23, x10
+    and x23, x23, #~(ATOM_SEAL_ALIGN - 1)
+    add x23, x23, x22                 // Arena bytes
+    lsl x24, x19, #1                  // Buckets
+
+    // Arena, header, controls (1 byte), slots (4) and entries (8 per atom)
+    add x25, x23, #atom_header_size
+    add x25, x25, x24
+    add x25, x25, x24, lsl #2
+    add x25, x25, x19, lsl #3
+
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, x25                       // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq atom_table_create_rejected
+
+    // Header (the mapping is zeroed)
+    add x26, x0, x23                  // table
+    str x0, [x26, #atom_base]
+    str x25, [x26, #atom_length]
+    str x19, [x26, #atom_capacity]
+    sub x9, x24, #1
+    str x9, [x26, #atom_bucket_mask]
+    str x23, [x26, #atom_arena_size]
+    add x9, x26, #atom_header_size
+    str x9, [x26, #atom_controls]
+    add x9, x9, x24
+    str x9, [x26, #atom_slots]
+    add x9, x9, x24, lsl #2
+    str x9, [x26, #atom_entries]
+
+    // @false and @true, from length-prefixed names
+    adr x27, atom_builtin_names
+    mov x25, #ATOM_BUILTIN_COUNT
+atom_table_create_builtin:
+    ldrb w2, [x27], #1
+    mov x1, x27
+    add x27, x27, x2
+    mov x0, x26
+    mov x3, #1
+    bl atom_find
+    sub x25, x25, #1
+    cbnz x25, atom_table_create_builtin
+
+    // Compile-time atoms in order
+    mov x25, #0
+atom_table_create_names:
+    cmp x25, x21
+    b.hs atom_table_create_seal
+    ldr x1, [x20, x25, lsl #3]
+    mov x2, #0
+atom_table_create_name_length:
+    ldrb w9, [x1, x2]
+    cbz w9, atom_table_create_name_intern
+    add x2, x2, #1
+    b atom_table_create_name_length
+
+atom_table_create_name_intern:
+    mov x0, x26
+    mov x3, #1
+    bl atom_find
+    add x25, x25, #1
+    b atom_table_create_names
+
+    // Dynamic names start past the read-only segment
+atom_table_create_seal:
+    str x22, [x26, #atom_arena_cursor]
+    str x22, [x26, #atom_sealed]
+    ldr x9, [x26, #atom_next]
+    str x9, [x26, #atom_static_count]
+    ldr x0, [x26, #atom_base]
+    mov x1, x22
+    mov x2, #PROT_READ
+    bl _mprotect
+    cbnz x0, atom_table_create_unmap
+
+    mov x0, x26
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+atom_table_create_unmap:
+    ldr x0, [x26, #atom_base]
+    ldr x1, [x26, #atom_length]
+    bl _munmap
+
+atom_table_create_rejected:
+    mov x0, #0
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+atom_table_create_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Atom Table Destroy
+// ------------------------------------------------------------
+// Unmap a table. No other thread may be using it.
+//
+// Parameters:
+//   x0 (void*) - table: Atom table
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if table is NULL or munmap fails
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_atom_table_destroy:
+    cbz x0, atom_table_destroy_invalid
+    stp x29, x30, [sp, #-16]!
+    ldr x1, [x0, #atom_length]
+    ldr x0, [x0, #atom_base]
+    bl _munmap
+    cmp x0, #0
+    cset x0, eq
+    ldp x29, x30, [sp], #16
+    ret
+
+atom_table_destroy_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Atom Intern
+// ------------------------------------------------------------
+// Return the atom for a name, adding it if it is new. Safe to call
+// from any number of threads at once; a name always gets one index.
+//
+// Parameters:
+//   x0 (void*) - table: Atom table
+//   x1 (const char*) - name: Name bytes (need not be NUL-terminated;
+//                      may be NULL if length is 0)
+//   x2 (uint64_t) - length: Name bytes, at most ATOM_MAX_LENGTH
+//
+// Returns:
+//   x0 (term_t) - atom: Atom term, or TERM_NONE on invalid arguments or
+//                 when the table or its name arena is full
+//
+// Complexity: O(length) expected
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_atom_intern:
+    mov x3, #1
+    b atom_find
+
+// ------------------------------------------------------------
+// Atom Lookup
+// ------------------------------------------------------------
+// Return the atom for a name without adding it. Never waits: a name
+// another thread is still interning is reported as not interned.
+//
+// Parameters:
+//   x0 (void*) - table: Atom table
+//   x1 (const char*) - name: Name bytes (may be NULL if length is 0)
+//   x2 (uint64_t) - length: Name bytes
+//
+// Returns:
+//   x0 (term_t) - atom: Atom term, or TERM_NONE if the name is not
+//                 interned or the arguments are invalid
+//
+// Complexity: O(length) expected
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_atom_lookup:
+    mov x3, #0
+    b atom_find
+
+// ------------------------------------------------------------
+// Atom Find (internal)
+// ------------------------------------------------------------
+// Probe for a name group by group from its hash, inserting it at the
+// first empty bucket when asked to.
+//
+// Parameters:
+//   x0 (void*) - table: Atom table
+//   x1 (const char*) - name: Name bytes
+//   x2 (uint64_t) - length: Name bytes
+//   x3 (uint64_t) - insert: 1 to add a missing name, 0 to only look
+//
+// Returns:
+//   x0 (term_t) - atom: Atom term, or TERM_NONE
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+atom_find:
+    cbz x0, atom_find_invalid
+    cmp x2, #ATOM_MAX_LENGTH
+    b.hi atom_find_invalid
+    cbz x2, atom_find_start
+    cbz x1, atom_find_invalid
+
+atom_find_start:
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    stp x26, x27, [sp, #-16]!
+    str x28, [sp, #-16]!
+
+    mov x19, x0                       // table
+    mov x20, x1                       // name
+    mov x21, x2                       // length
+    mov x23, x3                       // insert
+
+    // FNV-1a over the name
+    movz x22, #0x2325                 // FNV-1a offset basis
+    movk x22, #0x8422, lsl #16
+    movk x22, #0x9ce4, lsl #32
+    movk x22, #0xcbf2, lsl #48
+    mov x9, #FNV_PRIME_LOW
+    movk x9, #FNV_PRIME_HIGH, lsl #32
+    mov x10, #0
+atom_find_hash:
+    cmp x10, x21
+    b.hs atom_find_hashed
+    ldrb w11, [x20, x10]
+    eor x22, x22, x11
+    mul x22, x22, x9
+    add x10, x10, #1
+    b atom_find_hash
+
+atom_find_hashed:
+    // Tag is the top 7 bits; the low bits pick the first group
+    lsr x9, x22, #57
+    orr w9, w9, #ATOM_CTRL_FULL
+    dup v16.16b, w9
+    mov w28, w9                       // Tag byte, kept for publishing
+    ldr x9, [x19, #atom_bucket_mask]
+    and x24, x22, x9
+    and x24, x24, #~(ATOM_GROUP_SIZE - 1) // Group start
+    ldr x25, [x19, #atom_controls]
+
+atom_find_group:
+    add x9, x25, x24
+    ldr q0, [x9]
+    dmb ishld                         // Slots and records after the controls
+    cmeq v1.16b, v0.16b, v16.16b
+    shrn v1.8b, v1.8h, #4             // 4 mask bits per control byte
+    fmov x26, d1
+
+atom_find_candidate:
+    cbz x26, atom_find_misses
+    rbit x9, x26
+    clz x9, x9
+    lsr x9, x9, #2                    // Bucket within the group
+    lsl x10, x9, #2
+    mov x11, #0xF
+    lsl x11, x11, x10
+    bic x26, x26, x11
+
+    // Compare the candidate's name
+    add x9, x24, x9
+    ldr x10, [x19, #atom_slots]
+    ldr w27, [x10, x9, lsl #2]        // Atom index
+    ldr x10, [x19, #atom_entries]
+    ldr x10, [x10, x27, lsl #3]       // Record
+    ldr x11, [x10, #atom_record_length]
+    cmp x11, x21
+    b.ne atom_find_candidate
+    add x10, x10, #atom_record_name
+    mov x11, #0
+atom_find_compare:
+    cmp x11, x21
+    b.hs atom_find_found
+    ldrb w12, [x10, x11]
+    ldrb w13, [x20, x11]
+    cmp w12, w13
+    b.ne atom_find_candidate
+    add x11, x11, #1
+    b atom_find_compare
+
+atom_find_found:
+    lsl x0, x27, #TERM_IMM_SHIFT
+    orr x0, x0, #TERM_IMM_ATOM
+    b atom_find_return
+
+atom_find_misses:
+    // A bucket being published here may hold this very name. Inserts
+    // wait for it; a lookup answers as of now, before the publish
+    cbz x23, atom_find_settled
+    movi v2.16b, #ATOM_CTRL_BUSY
+    cmeq v2.16b, v0.16b, v2.16b
+    shrn v2.8b, v2.8h, #4
+    fmov x9, d2
+    cbz x9, atom_find_settled
+    yield
+    b atom_find_group
+
+atom_find_settled:
+    cmeq v2.16b, v0.16b, #0
+    shrn v2.8b, v2.8h, #4
+    fmov x26, d2
+    cbnz x26, atom_find_absent
+
+    // Group full of other names: next group
+    ldr x9, [x19, #atom_bucket_mask]
+    add x24, x24, #ATOM_GROUP_SIZE
+    and x24, x24, x9
+    b atom_find_group
+
+atom_find_absent:
+    cbz x23, atom_find_none
+
+    // Claim the first empty bucket: empty -> busy
+    rbit x9, x26
+    clz x9, x9
+    lsr x9, x9, #2
+    add x26, x24, x9                  // Bucket
+    add x27, x25, x26                 // Its control byte
+    mov w10, #ATOM_CTRL_BUSY
+atom_find_claim:
+    ldaxrb w11, [x27]
+    cbnz w11, atom_find_claim_lost
+    stxrb w12, w10, [x27]
+    cbnz w12, atom_find_claim
+    b atom_find_claimed
+
+atom_find_claim_lost:
+    clrex
+    b atom_find_group                 // Re-probe: it may be this name
+
+atom_find_claimed:
+    // Reserve the next index
+    ldr x14, [x19, #atom_capacity]
+    add x15, x19, #atom_next
+atom_find_reserve_index:
+    ldaxr x23, [x15]
+    cmp x23, x14
+    b.hs atom_find_release
+    add x10, x23, #1
+    stlxr w12, x10, [x15]
+    cbnz w12, atom_find_reserve_index
+
+    // Reserve the record's arena bytes
+    add x13, x21, #(atom_record_name + 7)
+    and x13, x13, #~7
+    ldr x14, [x19, #atom_arena_size]
+    add x15, x19, #atom_arena_cursor
+atom_find_reserve_bytes:
+    ldaxr x9, [x15]
+    add x10, x9, x13
+    cmp x10, x14
+    b.hi atom_find_unreserve
+    stlxr w12, x10, [x15]
+    cbnz w12, atom_find_reserve_bytes
+
+    // Write the record
+    ldr x10, [x19, #atom_base]
+    add x10, x10, x9                  // Record
+    str x21, [x10, #atom_record_length]
+    add x11, x10, #atom_record_name
+    mov x12, #0
+atom_find_copy:
+    cmp x12, x21
+    b.hs atom_find_publish
+    ldrb w13, [x20, x12]
+    strb w13, [x11, x12]
+    add x12, x12, #1
+    b atom_find_copy
+
+atom_find_publish:
+    ldr x11, [x19, #atom_entries]
+    str x10, [x11, x23, lsl #3]
+    ldr x11, [x19, #atom_slots]
+    str w23, [x11, x26, lsl #2]
+    stlrb w28, [x27]                  // Publish: record, entry and slot first
+    lsl x0, x23, #TERM_IMM_SHIFT
+    orr x0, x0, #TERM_IMM_ATOM
+    b atom_find_return
+
+atom_find_unreserve:
+    // Arena full: give the index back unless a later one has been
+    // taken, which leaves it reserved but unpublished (see _atom_name)
+    clrex
+    add x15, x19, #atom_next
+    add x10, x23, #1
+atom_find_unreserve_index:
+    ldaxr x11, [x15]
+    cmp x11, x10
+    b.ne atom_find_release
+    stlxr w12, x23, [x15]
+    cbnz w12, atom_find_unreserve_index
+
+atom_find_release:
+    clrex
+    stlrb wzr, [x27]                  // Give the bucket back
+
+atom_find_none:
+    mov x0, #TERM_NONE
+
+atom_find_return:
+    ldr x28, [sp], #16
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+atom_find_invalid:
+    mov x0, #TERM_NONE
+    ret
+
+// ------------------------------------------------------------
+// Atom Name
+// ------------------------------------------------------------
+// Name of an atom. The bytes are not NUL-terminated and stay valid
+// for the life of the table.
+//
+// Parameters:
+//   x0 (void*) - table: Atom table
+//   x1 (term_t) - atom: Atom term from this table
+//   x2 (uint64_t*) - length_out: Receives the name length (may be NULL)
+//
+// Returns:
+//   x0 (const char*) - name: The name, or NULL if the term is not an
+//                      atom of this table
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_atom_name:
+    cbz x0, atom_name_none
+    and x9, x1, #TERM_IMM_MASK
+    cmp x9, #TERM_IMM_ATOM
+    b.ne atom_name_none
+    lsr x9, x1, #TERM_IMM_SHIFT
+    add x10, x0, #atom_next
+    ldar x10, [x10]
+    cmp x9, x10
+    b.hs atom_name_none
+    ldr x10, [x0, #atom_entries]
+    ldr x10, [x10, x9, lsl #3]
+    cbz x10, atom_name_none           // Reserved, not yet published
+    cbz x2, atom_name_done
+    ldr x11, [x10, #atom_record_length]
+    str x11, [x2]
+atom_name_done:
+    add x0, x10, #atom_record_name
+    ret
+
+atom_name_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Atom Table Count
+// ------------------------------------------------------------
+// Number of atoms in the table, including @false, @true and the
+// compile-time atoms.
+//
+// Parameters:
+//   x0 (void*) - table: Atom table
+//
+// Returns:
+//   x0 (uint64_t) - count: Atoms, 0 if table is NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_atom_table_count:
+    cbz x0, atom_table_count_none
+    add x0, x0, #atom_next
+    ldar x0, [x0]
+    ret
+
+atom_table_count_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Atom Is Static
+// ------------------------------------------------------------
+// Whether an atom was interned at table creation, so its name is in
+// the read-only segment.
+//
+// Parameters:
+//   x0 (void*) - table: Atom table
+//   x1 (term_t) - atom: Atom term
+//
+// Returns:
+//   x0 (int) - static: 1 if pre-interned, 0 otherwise
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_atom_is_static:
+    cbz x0, atom_is_static_none
+    and x9, x1, #TERM_IMM_MASK
+    cmp x9, #TERM_IMM_ATOM
+    b.ne atom_is_static_none
+    lsr x9, x1, #TERM_IMM_SHIFT
+    ldr x10, [x0, #atom_static_count]
+    cmp x9, x10
+    cset x0, lo
+    ret
+
+atom_is_static_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Builtin Atom Names
+// ------------------------------------------------------------
+// Length-prefixed names of the atoms every table starts with, in
+// index order. Kept in the text section so it is reached with adr.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+atom_builtin_names:
+    .byte 5
+    .ascii "false"
+    .byte 4
+    .ascii "true"
+    .align 4
@@ -0,0 +1,1360 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// microbench.c — Microbenchmarks for the runtime primitives
+// ------------------------------------------------------------
+// Times each scheduler, messaging, work-stealing, process and timer
+// primitive with the virtual counter (CNTVCT_EL0 via clock_read_ticks).
+// The counter runs at tens of MHz, so each sample times a batch of
+// BATCH operations and reports the per-operation cost. Samples are
+// preceded by warmup batches that are not recorded. Per-sample setup
+// and teardown (filling or draining queues, recreating wheels) run
+// outside the timed region.
+//
+// The template interpreter is timed per opcode: each sample runs a
+// program of BATCH copies of one instruction (plus HALT), so the
+// per-operation figure is that opcode's handler and threaded dispatch.
+// The template suite (Map, Filter, Reduce over a BATCH-element list)
+// runs each template twice, interpreted and compiled by jit.s, so the
+// per-element figures compare native and interpreted speed directly.
+//
+// The dictionary suite replays a Rememberer's state updates: BATCH
+// messages each replace one key of a DICT_KEYS-key state, kept either
+// as a persistent HAMT (map.s) or as a naive map copied whole on every
+// update, and the same keys are read back from each.
+//
+// The ordered suite compares a B+ tree (btree.s, bulk loaded) with a
+// balanced binary search tree over the same ORDER_KEYS keys: point
+// lookups at scattered keys, and range scans that seek a key and read
+// the ORDER_SCAN pairs from it on, one scan per operation.
+//
+// The queue suite is a Doer's work queue with a QUEUE_BACKLOG-element
+// backlog: each operation pushes one element at the back and pops one
+// from the front, on a persistent finger tree and on a chunked deque
+// (finger.s). Indexing and split-then-concat run on a finger tree of
+// QUEUE_LONG elements, and indexing on a deque of as many.
+//
+// The set suite probes Swiss-table hash sets (set.s) of SET_SLOTS
+// slots at three load factors, a quarter, half and 7/8 full: lookups
+// of held keys, lookups of absent keys, and inserts of BATCH keys
+// removed before each sample, which refill the set to its load.
+//
+// The pipeline suite runs template chains (pipeline.s) over a
+// PIPE_ELEMENTS-element list, each compiled fused into one loop and
+// unfused as one pass per stage: Map, Filter, Reduce, and Map, FindIn
+// with its match halfway through the list. A sample is one run over
+// the list, so per-operation figures and heap words are per element.
+//
+// Reports median and p99 per-operation time and throughput for every
+// primitive, and for primitives that allocate on a process heap the
+// heap words each operation takes, as a table or (with --json) as
+// machine-readable JSON for comparing against a stored baseline.
+//
+// Usage: microbench_exe [--samples N] [--warmup N] [--json]
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// External assembly functions
+extern uint64_t clock_read_ticks(void);
+extern uint64_t clock_read_frequency(void);
+extern int clock_init(void* clock);
+extern uint64_t clock_ticks_to_ns(void* clock, uint64_t ticks);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern int scheduler_state_destroy(void* scheduler_states);
+extern void scheduler_init(void* scheduler_states, uint64_t core_id);
+extern int scheduler_enqueue_process(void* scheduler_states, uint64_t core_id, void* process, uint64_t priority);
+extern void* scheduler_dequeue_process(void* queue);
+extern void* scheduler_schedule(void* scheduler_states, uint64_t core_id);
+extern void process_save_context(void* pcb);
+extern void process_restore_context(void* pcb);
+extern void process_set_message_queue(void* pcb, void* message_queue);
+extern void* allocate_pcb(void);
+extern uint64_t free_pcb(void* pcb);
+extern int message_queue_init(void* queue_ptr, uint32_t size);
+extern int send_message(void* sender_pcb, void* receiver_pcb, uint64_t message_data);
+extern uint64_t receive_message(void* receiver_pcb);
+extern uint64_t try_receive_message(void* receiver_pcb);
+extern int ws_deque_init(void* deque_ptr, uint32_t size);
+extern int ws_deque_push_bottom(void* deque_ptr, void* process);
+extern void* ws_deque_pop_bottom(void* deque_ptr);
+extern void* ws_deque_pop_top(void* deque_ptr);
+extern uint64_t get_system_ticks(void);
+extern int timer_wheel_init(void* scheduler_states, uint64_t core_id);
+extern int timer_wheel_destroy(void* scheduler_states, uint64_t core_id);
+extern uint64_t timer_arm(void* scheduler_states, uint64_t core_id, void* pcb,
+                          uint64_t expiry_ticks, void* callback, uint64_t argument);
+extern int cancel_timer(uint64_t timer_id);
+extern void* interp_load(const uint32_t* code, uint64_t count, const uint64_t* literals, uint64_t literal_count);
+extern int interp_frame_init(void* frame, void* program, void* pcb);
+extern int interp_set_register(void* frame, uint64_t index, uint64_t term);
+extern uint64_t interp_run(void* scheduler_states, uint64_t core_id, void* frame);
+extern int jit_compile(void* program, uint64_t first, uint64_t count);
+extern int scheduler_set_reduction_count_with_state(void* scheduler_states, uint64_t core_id, uint64_t count);
+extern uint64_t term_make_int(int64_t value);
+extern uint64_t term_tuple(void* pcb, uint64_t arity);
+extern uint64_t term_cons(void* pcb, uint64_t head, uint64_t tail);
+extern uint64_t map_put(void* pcb, uint64_t map, uint64_t key, uint64_t value);
+extern uint64_t map_get(uint64_t map, uint64_t key);
+extern uint64_t map_from_list(void* pcb, uint64_t list);
+extern void* btree_create(uint64_t capacity);
+extern int btree_load(void* tree, const int64_t* keys, const uint64_t* values, uint64_t count);
+extern int btree_lookup(void* tree, int64_t key, uint64_t* value_out);
+extern int btree_seek(void* cursor, void* tree, int64_t key);
+extern int btree_next(void* cursor, uint64_t* key_out, uint64_t* value_out);
+extern uint64_t finger_push_back(void* pcb, uint64_t tree, uint64_t element);
+extern uint64_t finger_pop_front(void* pcb, uint64_t tree, uint64_t* rest_out);
+extern uint64_t finger_concat(void* pcb, uint64_t left, uint64_t right);
+extern uint64_t finger_split(void* pcb, uint64_t tree, uint64_t index, uint64_t* right_out);
+extern uint64_t finger_index(uint64_t tree, uint64_t index);
+extern uint64_t deque_new(void* pcb);
+extern int deque_push_back(void* pcb, uint64_t deque, uint64_t element);
+extern uint64_t deque_pop_front(uint64_t deque);
+extern uint64_t deque_index(uint64_t deque, uint64_t index);
+extern void* set_create(uint64_t max_keys);
+extern int set_insert(void* set, uint64_t key);
+extern int set_contains(void* set, uint64_t key);
+extern int set_remove(void* set, uint64_t key);
+extern int set_reserve(void* set, uint64_t keys);
+extern uint64_t set_capacity(void* set);
+extern void* pipeline_load(const void* stages, uint64_t count, const uint64_t* literals, uint64_t literal_count, int fused);
+
+// Operations per timed sample
+#define BATCH 256
+
+// Mailbox and deque capacity (power of two, at least BATCH)
+#define QUEUE_CAPACITY 512
+
+#define DEFAULT_SAMPLES 200
+#define DEFAULT_WARMUP 20
+#define MAX_SAMPLES 100000
+
+// Runtime layout, exported by the assembly that owns it
+extern const uint64_t CLOCK_SIZE_CONST;
+extern const uint64_t MSG_QUEUE_SIZE_CONST;
+extern const uint64_t WS_DEQUE_SIZE_CONST;
+extern const uint64_t SCHEDULER_QUEUES_OFFSET_CONST;
+extern const uint64_t PRIORITY_QUEUE_SIZE_CONST;
+extern const uint64_t INTERP_FRAME_SIZE_CONST;
+extern const uint64_t PCB_SIZE_CONST;
+extern const uint64_t PCB_HEAP_POINTER_OFFSET_CONST;
+extern const uint64_t PCB_HEAP_LIMIT_OFFSET_CONST;
+extern const uint64_t BTREE_CURSOR_SIZE_CONST;
+
+#define PRIORITY_NORMAL 2
+
+// Far enough ahead that armed timers never fire during a sample
+#define TIMER_HORIZON_TICKS (1ULL << 30)
+
+// Interpreter opcodes and terms (match config.inc)
+#define INTERP_OP_HALT 0
+#define INTERP_OP_MOVE 1
+#define INTERP_OP_LOADK 2
+#define INTERP_OP_LOADI 3
+#define INTERP_OP_ADD 4
+#define INTERP_OP_MUL 6
+#define INTERP_OP_JMP 8
+#define INTERP_OP_JLT 11
+#define INTERP_OP_JGE 12
+#define INTERP_OP_NEXT 13
+#define INTERP_OP_CONS 14
+#define INTERP_OP_REVERSE 15
+#define INTERP_OP_GETEL 17
+#define INTERP_OP_CALL 20
+#define INTERP_OP_RET 21
+#define INTERP_WORD(op, a, b, c) ((uint32_t)(op) | (uint32_t)(a) << 8 | (uint32_t)(b) << 12 | (uint32_t)(c) << 16)
+#define TERM_NIL 0x14
+#define TERM_TAG_BOXED 1
+#define TERM_HEADER_ARITY_SHIFT 8
+
+// Interpreter heap: the input list and tuple, then a CONS batch
+#define INTERP_HEAP_WORDS (8 * BATCH)
+
+// Rememberer state: keys, and a heap for a batch of whole copies
+#define DICT_KEYS 64
+#define DICT_HEAP_WORDS (BATCH * (2 * DICT_KEYS + 2) + 16 * DICT_KEYS)
+
+// Ordered lookups: keys 0, 2, 4, ... in both trees; pairs per scan
+#define ORDER_KEYS 65536
+#define ORDER_SCAN 16
+
+// Work queues: backlog of the FIFO pair, elements of the long sequences,
+// and a heap for a batch of splits and concatenations
+#define QUEUE_BACKLOG 64
+#define QUEUE_LONG 4096
+#define QUEUE_HEAP_WORDS (BATCH * 640 + QUEUE_LONG * 48)
+
+// Set suite: one set per load factor, all of SET_SLOTS slots
+#define SET_SLOTS 4096
+enum {
+    SET_BENCH_QUARTER,
+    SET_BENCH_HALF,
+    SET_BENCH_SEVEN_EIGHTHS,
+    SET_BENCH_LOADS
+};
+static const uint64_t set_bench_keys[SET_BENCH_LOADS] = { SET_SLOTS / 4, SET_SLOTS / 2, SET_SLOTS / 8 * 7 };
+
+// Pipeline suite: input elements, and a heap for the input and the
+// unfused passes' lists (match config.inc for the stage kinds)
+#define PIPE_ELEMENTS (1 << 20)
+#define PIPE_HEAP_WORDS (10 * PIPE_ELEMENTS)
+#define PIPELINE_STAGE_MAP 0
+#define PIPELINE_STAGE_FILTER 1
+#define PIPELINE_STAGE_FINDIN 3
+#define PIPELINE_STAGE_REDUCE 4
+enum {
+    PIPE_BENCH_REDUCE,
+    PIPE_BENCH_FINDIN,
+    PIPE_BENCH_COUNT
+};
+#define PIPE_UNFUSED 0
+#define PIPE_FUSED 1
+
+// Benchmarked opcodes; each program is BATCH copies of one
+// instruction over r0 = list, r1 = 1, r2 = 2, r3 = a pair, r4 = []
+enum {
+    INTERP_BENCH_MOVE,
+    INTERP_BENCH_ADD,
+    INTERP_BENCH_JLT,
+    INTERP_BENCH_NEXT,
+    INTERP_BENCH_CONS,
+    INTERP_BENCH_GETEL,
+    INTERP_BENCH_COUNT
+};
+
+// Benchmarked templates over r0 = list, each loaded twice
+enum {
+    TEMPLATE_BENCH_MAP,
+    TEMPLATE_BENCH_FILTER,
+    TEMPLATE_BENCH_REDUCE,
+    TEMPLATE_BENCH_COUNT
+};
+#define TEMPLATE_INTERPRETED 0
+#define TEMPLATE_NATIVE 1
+
+// Balanced binary search tree node, for the ordered suite
+typedef struct bst_node {
+    int64_t key;
+    uint64_t value;
+    struct bst_node* left;
+    struct bst_node* right;
+} bst_node;
+
+typedef struct {
+    void* states;
+    void* normal_queue;
+    void* pcbs[BATCH];
+    void* spawned[BATCH];
+    void* sender;
+    void* receiver;
+    void* mailbox;
+    void* deque;
+    uint64_t timers[BATCH];
+    uint64_t expiry;
+    void* interp_programs[INTERP_BENCH_COUNT];
+    void* template_programs[TEMPLATE_BENCH_COUNT][2];
+    void* interp_frame;
+    void* interp_pcb;
+    uint64_t interp_heap[INTERP_HEAP_WORDS];
+    uint64_t* interp_heap_mark;
+    uint64_t interp_list;
+    uint64_t interp_tuple;
+    void* dict_pcb;
+    uint64_t dict_heap[DICT_HEAP_WORDS];
+    uint64_t* dict_heap_mark;
+    uint64_t dict_keys[BATCH];        // Key each message updates
+    uint64_t dict_values[BATCH];
+    uint64_t dict_hamt;               // Initial states
+    uint64_t dict_copied;
+    uint64_t dict_state;              // Current state
+    uint64_t dict_sink;               // Keeps lookups live
+    void* order_btree;
+    bst_node* order_bst;              // Root; nodes in one array
+    int64_t order_probes[BATCH];      // Key each lookup or scan starts at
+    void* order_cursor;
+    uint64_t order_sink;
+    void* queue_pcb;
+    uint64_t queue_heap[QUEUE_HEAP_WORDS];
+    uint64_t* queue_heap_mark;
+    uint64_t queue_finger;            // Initial backlog
+    uint64_t queue_state;             // Current backlog
+    uint64_t queue_deque;             // Backlog, changed in place
+    uint64_t queue_long_finger;
+    uint64_t queue_long_deque;
+    uint64_t queue_probes[BATCH];     // Index each lookup or split uses
+    uint64_t queue_sink;
+    void* set_tables[SET_BENCH_LOADS];
+    uint64_t set_hits[SET_BENCH_LOADS][BATCH]; // Held keys, scattered
+    uint64_t set_misses[BATCH];       // Keys no set holds
+    int set_load;                     // Set the current sample uses
+    uint64_t set_sink;
+    void* pipe_programs[PIPE_BENCH_COUNT][2];
+    void* pipe_pcb;
+    uint64_t* pipe_heap;
+    uint64_t* pipe_heap_mark;
+    uint64_t pipe_list;               // 0, 1, ..., PIPE_ELEMENTS - 1
+    void* alloc_pcb;                  // Heap to report words per op from, or NULL
+    uint64_t sample_ops;              // Operations per sample, BATCH unless setup says
+} bench_context;
+
+typedef void (*bench_step)(bench_context* ctx);
+
+typedef struct {
+    const char* name;
+    bench_step setup;     // Untimed, before each sample
+    bench_step run;       // Timed, performs BATCH (or sample_ops) operations
+    bench_step teardown;  // Untimed, after each sample
+} bench_primitive;
+
+// ------------------------------------------------------------
+// Shared setup and teardown steps
+// ------------------------------------------------------------
+static void fill_run_queue(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        scheduler_enqueue_process(ctx->states, 0, ctx->pcbs[i], PRIORITY_NORMAL);
+    }
+}
+
+static void drain_run_queue(bench_context* ctx) {
+    while (scheduler_dequeue_process(ctx->normal_queue) != NULL) {
+    }
+}
+
+static void fill_mailbox(bench_context* ctx) {
+    for (uint64_t i = 0; i < BATCH; i++) {
+        send_message(ctx->sender, ctx->receiver, i + 1);
+    }
+}
+
+static void drain_mailbox(bench_context* ctx) {
+    while (try_receive_message(ctx->receiver) != 0) {
+    }
+}
+
+static void fill_deque(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        ws_deque_push_bottom(ctx->deque, ctx->pcbs[i]);
+    }
+}
+
+static void drain_deque(bench_context* ctx) {
+    while (ws_deque_pop_bottom(ctx->deque) != NULL) {
+    }
+}
+
+static void fresh_wheel(bench_context* ctx) {
+    timer_wheel_init(ctx->states, 0);
+    ctx->expiry = get_system_ticks() + TIMER_HORIZON_TICKS;
+}
+
+static void arm_timers(bench_context* ctx) {
+    fresh_wheel(ctx);
+    for (int i = 0; i < BATCH; i++) {
+        ctx->timers[i] = timer_arm(ctx->states, 0, NULL, ctx->expiry, NULL, 0);
+    }
+}
+
+static void drop_wheel(bench_context* ctx) {
+    timer_wheel_destroy(ctx->states, 0);
+}
+
+static void spawn_batch(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        ctx->spawned[i] = allocate_pcb();
+        scheduler_enqueue_process(ctx->states, 0, ctx->spawned[i], PRIORITY_NORMAL);
+    }
+}
+
+static void reap_batch(bench_context* ctx) {
+    void* pcb;
+    while ((pcb = scheduler_dequeue_process(ctx->normal_queue)) != NULL) {
+        free_pcb(pcb);
+    }
+}
+
+// Restart one opcode's program with fresh registers, heap and budget
+static void interp_reset(bench_context* ctx, int op) {
+    uint8_t* pcb = (uint8_t*)ctx->interp_pcb;
+    *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST) = ctx->interp_heap_mark;
+    interp_frame_init(ctx->interp_frame, ctx->interp_programs[op], pcb);
+    interp_set_register(ctx->interp_frame, 0, ctx->interp_list);
+    interp_set_register(ctx->interp_frame, 1, term_make_int(1));
+    interp_set_register(ctx->interp_frame, 2, term_make_int(2));
+    interp_set_register(ctx->interp_frame, 3, ctx->interp_tuple);
+    interp_set_register(ctx->interp_frame, 4, TERM_NIL);
+    scheduler_set_reduction_count_with_state(ctx->states, 0, 2 * BATCH);
+}
+
+static void interp_reset_move(bench_context* ctx) {
+    interp_reset(ctx, INTERP_BENCH_MOVE);
+}
+
+static void interp_reset_add(bench_context* ctx) {
+    interp_reset(ctx, INTERP_BENCH_ADD);
+}
+
+static void interp_reset_jlt(bench_context* ctx) {
+    interp_reset(ctx, INTERP_BENCH_JLT);
+}
+
+static void interp_reset_next(bench_context* ctx) {
+    interp_reset(ctx, INTERP_BENCH_NEXT);
+}
+
+static void interp_reset_cons(bench_context* ctx) {
+    interp_reset(ctx, INTERP_BENCH_CONS);
+}
+
+static void interp_reset_getel(bench_context* ctx) {
+    interp_reset(ctx, INTERP_BENCH_GETEL);
+}
+
+// Back to the initial state with the update heap empty
+static void dict_reset(bench_context* ctx, uint64_t state) {
+    uint8_t* pcb = (uint8_t*)ctx->dict_pcb;
+    *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST) = ctx->dict_heap_mark;
+    ctx->dict_state = state;
+    ctx->alloc_pcb = ctx->dict_pcb;
+}
+
+static void dict_reset_hamt(bench_context* ctx) {
+    dict_reset(ctx, ctx->dict_hamt);
+}
+
+static void dict_reset_copied(bench_context* ctx) {
+    dict_reset(ctx, ctx->dict_copied);
+}
+
+// Back to the initial backlog with the queue heap empty
+static void queue_reset(bench_context* ctx) {
+    uint8_t* pcb = (uint8_t*)ctx->queue_pcb;
+    *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST) = ctx->queue_heap_mark;
+    ctx->queue_state = ctx->queue_finger;
+    ctx->alloc_pcb = ctx->queue_pcb;
+}
+
+// Pick the set for a sample; insert samples first take out the keys
+// they put back
+static void set_select(bench_context* ctx, int load, int for_insert) {
+    ctx->set_load = load;
+    if (for_insert) {
+        for (int i = 0; i < BATCH; i++) {
+            set_remove(ctx->set_tables[load], ctx->set_hits[load][i]);
+        }
+    }
+}
+
+static void set_select_quarter(bench_context* ctx) {
+    set_select(ctx, SET_BENCH_QUARTER, 0);
+}
+
+static void set_select_half(bench_context* ctx) {
+    set_select(ctx, SET_BENCH_HALF, 0);
+}
+
+static void set_select_seven_eighths(bench_context* ctx) {
+    set_select(ctx, SET_BENCH_SEVEN_EIGHTHS, 0);
+}
+
+static void set_drain_quarter(bench_context* ctx) {
+    set_select(ctx, SET_BENCH_QUARTER, 1);
+}
+
+static void set_drain_half(bench_context* ctx) {
+    set_select(ctx, SET_BENCH_HALF, 1);
+}
+
+static void set_drain_seven_eighths(bench_context* ctx) {
+    set_select(ctx, SET_BENCH_SEVEN_EIGHTHS, 1);
+}
+
+// Naive copied map: a tuple {K1, V1, ..., Kn, Vn} copied whole on
+// every update; every key the benchmark updates is present
+static uint64_t copied_put(void* pcb, uint64_t map, uint64_t key, uint64_t value) {
+    uint64_t* old = (uint64_t*)(map - TERM_TAG_BOXED);
+    uint64_t words = old[0] >> TERM_HEADER_ARITY_SHIFT;
+    uint64_t copy = term_tuple(pcb, words);
+    uint64_t* body = (uint64_t*)(copy - TERM_TAG_BOXED);
+    memcpy(body + 1, old + 1, words * sizeof(uint64_t));
+    for (uint64_t i = 1; i < words; i += 2) {
+        if (body[i] == key) {
+            body[i + 1] = value;
+            break;
+        }
+    }
+    return copy;
+}
+
+static uint64_t copied_get(uint64_t map, uint64_t key) {
+    uint64_t* body = (uint64_t*)(map - TERM_TAG_BOXED);
+    uint64_t words = body[0] >> TERM_HEADER_ARITY_SHIFT;
+    for (uint64_t i = 1; i < words; i += 2) {
+        if (body[i] == key) {
+            return body[i + 1];
+        }
+    }
+    return TERM_NIL;
+}
+
+// Lay keys[lo, hi) out as a balanced tree from nodes[*next] on
+static bst_node* bst_build(bst_node* nodes, uint64_t* next, const int64_t* keys,
+                           const uint64_t* values, int64_t lo, int64_t hi) {
+    if (lo >= hi) {
+        return NULL;
+    }
+    int64_t mid = lo + (hi - lo) / 2;
+    bst_node* node = &nodes[(*next)++];
+    node->key = keys[mid];
+    node->value = values[mid];
+    node->left = bst_build(nodes, next, keys, values, lo, mid);
+    node->right = bst_build(nodes, next, keys, values, mid + 1, hi);
+    return node;
+}
+
+static uint64_t bst_lookup(const bst_node* node, int64_t key) {
+    while (node != NULL && node->key != key) {
+        node = key < node->key ? node->left : node->right;
+    }
+    return node != NULL ? node->value : 0;
+}
+
+// Sum the values of the count pairs from the first key at or above
+// low, walking in order with a stack of pending ancestors
+static uint64_t bst_scan(const bst_node* node, int64_t low, int count) {
+    const bst_node* stack[64];
+    int top = 0;
+    uint64_t sum = 0;
+    while (node != NULL) {
+        if (node->key >= low) {
+            stack[top++] = node;
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    while (top > 0 && count > 0) {
+        node = stack[--top];
+        sum += node->value;
+        count--;
+        for (node = node->right; node != NULL; node = node->left) {
+            stack[top++] = node;
+        }
+    }
+    return sum;
+}
+
+// Restart a template on the input list; the budget covers every
+// instruction and REVERSE's per-element charge
+static void template_reset(bench_context* ctx, int template, int native) {
+    uint8_t* pcb = (uint8_t*)ctx->interp_pcb;
+    *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST) = ctx->interp_heap_mark;
+    interp_frame_init(ctx->interp_frame, ctx->template_programs[template][native], pcb);
+    interp_set_register(ctx->interp_frame, 0, ctx->interp_list);
+    scheduler_set_reduction_count_with_state(ctx->states, 0, 16 * BATCH);
+}
+
+static void template_reset_map(bench_context* ctx) {
+    template_reset(ctx, TEMPLATE_BENCH_MAP, TEMPLATE_INTERPRETED);
+}
+
+static void template_reset_map_native(bench_context* ctx) {
+    template_reset(ctx, TEMPLATE_BENCH_MAP, TEMPLATE_NATIVE);
+}
+
+static void template_reset_filter(bench_context* ctx) {
+    template_reset(ctx, TEMPLATE_BENCH_FILTER, TEMPLATE_INTERPRETED);
+}
+
+static void template_reset_filter_native(bench_context* ctx) {
+    template_reset(ctx, TEMPLATE_BENCH_FILTER, TEMPLATE_NATIVE);
+}
+
+static void template_reset_reduce(bench_context* ctx) {
+    template_reset(ctx, TEMPLATE_BENCH_REDUCE, TEMPLATE_INTERPRETED);
+}
+
+static void template_reset_reduce_native(bench_context* ctx) {
+    template_reset(ctx, TEMPLATE_BENCH_REDUCE, TEMPLATE_NATIVE);
+}
+
+// Restart a pipeline on the whole input, with the heap and budget for
+// its longest form; each element counts as one operation
+static void pipe_reset(bench_context* ctx, int chain, int fused) {
+    uint8_t* pcb = (uint8_t*)ctx->pipe_pcb;
+    *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST) = ctx->pipe_heap_mark;
+    interp_frame_init(ctx->interp_frame, ctx->pipe_programs[chain][fused], pcb);
+    interp_set_register(ctx->interp_frame, 0, ctx->pipe_list);
+    interp_set_register(ctx->interp_frame, 1, term_make_int(0));
+    scheduler_set_reduction_count_with_state(ctx->states, 0, 32 * (uint64_t)PIPE_ELEMENTS);
+    ctx->alloc_pcb = pcb;
+    ctx->sample_ops = PIPE_ELEMENTS;
+}
+
+static void pipe_reset_reduce_fused(bench_context* ctx) {
+    pipe_reset(ctx, PIPE_BENCH_REDUCE, PIPE_FUSED);
+}
+
+static void pipe_reset_reduce_unfused(bench_context* ctx) {
+    pipe_reset(ctx, PIPE_BENCH_REDUCE, PIPE_UNFUSED);
+}
+
+static void pipe_reset_findin_fused(bench_context* ctx) {
+    pipe_reset(ctx, PIPE_BENCH_FINDIN, PIPE_FUSED);
+}
+
+static void pipe_reset_findin_unfused(bench_context* ctx) {
+    pipe_reset(ctx, PIPE_BENCH_FINDIN, PIPE_UNFUSED);
+}
+
+// ------------------------------------------------------------
+// Timed operations (BATCH each)
+// ------------------------------------------------------------
+static void run_enqueue(bench_context* ctx) {
+    fill_run_queue(ctx);
+}
+
+static void run_dequeue(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        scheduler_dequeue_process(ctx->normal_queue);
+    }
+}
+
+static void run_schedule(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        scheduler_schedule(ctx->states, 0);
+    }
+}
+
+static void run_context_switch(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        process_save_context(ctx->pcbs[i]);
+        process_restore_context(ctx->pcbs[(i + 1) % BATCH]);
+    }
+}
+
+static void run_send(bench_context* ctx) {
+    fill_mailbox(ctx);
+}
+
+static void run_receive(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        receive_message(ctx->receiver);
+    }
+}
+
+static void run_deque_push(bench_context* ctx) {
+    fill_deque(ctx);
+}
+
+static void run_deque_pop(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        ws_deque_pop_bottom(ctx->deque);
+    }
+}
+
+static void run_steal(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        ws_deque_pop_top(ctx->deque);
+    }
+}
+
+static void run_spawn(bench_context* ctx) {
+    spawn_batch(ctx);
+}
+
+static void run_exit(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        free_pcb(scheduler_schedule(ctx->states, 0));
+    }
+}
+
+static void run_timer_arm(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        ctx->timers[i] = timer_arm(ctx->states, 0, NULL, ctx->expiry, NULL, 0);
+    }
+}
+
+static void run_timer_cancel(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        cancel_timer(ctx->timers[i]);
+    }
+}
+
+static void run_interp(bench_context* ctx) {
+    interp_run(ctx->states, 0, ctx->interp_frame);
+}
+
+static void run_dict_put_hamt(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        ctx->dict_state = map_put(ctx->dict_pcb, ctx->dict_state, ctx->dict_keys[i], ctx->dict_values[i]);
+    }
+}
+
+static void run_dict_put_copied(bench_context* ctx) {
+    for (int i = 0; i < BATCH; i++) {
+        ctx->dict_state = copied_put(ctx->dict_pcb, ctx->dict_state, ctx->dict_keys[i], ctx->dict_values[i]);
+    }
+}
+
+static void run_dict_get_hamt(bench_context* ctx) {
+    uint64_t sink = 0;
+    for (int i = 0; i < BATCH; i++) {
+        sink += map_get(ctx->dict_state, ctx->dict_keys[i]);
+    }
+    ctx->dict_sink = sink;
+}
+
+static void run_dict_get_copied(bench_context* ctx) {
+    uint64_t sink = 0;
+    for (int i = 0; i < BATCH; i++) {
+        sink += copied_get(ctx->dict_state, ctx->dict_keys[i]);
+    }
+    ctx->dict_sink = sink;
+}
+
+static void run_btree_lookup(bench_context* ctx) {
+    uint64_t sink = 0, value = 0;
+    for (int i = 0; i < BATCH; i++) {
+        btree_lookup(ctx->order_btree, ctx->order_probes[i], &value);
+        sink += value;
+    }
+    ctx->order_sink = sink;
+}
+
+static void run_bst_lookup(bench_context* ctx) {
+    uint64_t sink = 0;
+    for (int i = 0; i < BATCH; i++) {
+        sink += bst_lookup(ctx->order_bst, ctx->order_probes[i]);
+    }
+    ctx->order_sink = sink;
+}
+
+static void run_btree_scan(bench_context* ctx) {
+    uint64_t sink = 0, value = 0;
+    for (int i = 0; i < BATCH; i++) {
+        btree_seek(ctx->order_cursor, ctx->order_btree, ctx->order_probes[i]);
+        for (int j = 0; j < ORDER_SCAN && btree_next(ctx->order_cursor, NULL, &value); j++) {
+            sink += value;
+        }
+    }
+    ctx->order_sink = sink;
+}
+
+static void run_bst_scan(bench_context* ctx) {
+    uint64_t sink = 0;
+    for (int i = 0; i < BATCH; i++) {
+        sink += bst_scan(ctx->order_bst, ctx->order_probes[i], ORDER_SCAN);
+    }
+    ctx->order_sink = sink;
+}
+
+static void run_queue_finger(bench_context* ctx) {
+    uint64_t state = ctx->queue_state, sink = 0;
+    for (int i = 0; i < BATCH; i++) {
+        state = finger_push_back(ctx->queue_pcb, state, term_make_int(i));
+        sink += finger_pop_front(ctx->queue_pcb, state, &state);
+    }
+    ctx->queue_state = state;
+    ctx->queue_sink = sink;
+}
+
+static void run_queue_deque(bench_context* ctx) {
+    uint64_t sink = 0;
+    for (int i = 0; i < BATCH; i++) {
+        deque_push_back(ctx->queue_pcb, ctx->queue_deque, term_make_int(i));
+        sink += deque_pop_front(ctx->queue_deque);
+    }
+    ctx->queue_sink = sink;
+}
+
+static void run_index_finger(bench_context* ctx) {
+    uint64_t sink = 0;
+    for (int i = 0; i < BATCH; i++) {
+        sink += finger_index(ctx->queue_long_finger, ctx->queue_probes[i]);
+    }
+    ctx->queue_sink = sink;
+}
+
+static void run_index_deque(bench_context* ctx) {
+    uint64_t sink = 0;
+    for (int i = 0; i < BATCH; i++) {
+        sink += deque_index(ctx->queue_long_deque, ctx->queue_probes[i]);
+    }
+    ctx->queue_sink = sink;
+}
+
+static void run_split_finger(bench_context* ctx) {
+    uint64_t sink = 0, right = TERM_NIL;
+    for (int i = 0; i < BATCH; i++) {
+        uint64_t left = finger_split(ctx->queue_pcb, ctx->queue_long_finger, ctx->queue_probes[i], &right);
+        sink += finger_concat(ctx->queue_pcb, left, right);
+    }
+    ctx->queue_sink = sink;
+}
+
+static void run_set_hit(bench_context* ctx) {
+    void* set = ctx->set_tables[ctx->set_load];
+    const uint64_t* keys = ctx->set_hits[ctx->set_load];
+    uint64_t sink = 0;
+    for (int i = 0; i < BATCH; i++) {
+        sink += (uint64_t)set_contains(set, keys[i]);
+    }
+    ctx->set_sink = sink;
+}
+
+static void run_set_miss(bench_context* ctx) {
+    void* set = ctx->set_tables[ctx->set_load];
+    uint64_t sink = 0;
+    for (int i = 0; i < BATCH; i++) {
+        sink += (uint64_t)set_contains(set, ctx->set_misses[i]);
+    }
+    ctx->set_sink = sink;
+}
+
+static void run_set_insert(bench_context* ctx) {
+    void* set = ctx->set_tables[ctx->set_load];
+    const uint64_t* keys = ctx->set_hits[ctx->set_load];
+    uint64_t sink = 0;
+    for (int i = 0; i < BATCH; i++) {
+        sink += (uint64_t)set_insert(set, keys[i]);
+    }
+    ctx->set_sink = sink;
+}
+
+// Spawn is PCB allocation plus enqueue and exit is dispatch plus PCB
+// release: actly_spawn/actly_exit need a running process to charge
+// reductions to, which a standalone benchmark does not have.
+static const bench_primitive primitives[] = {
+    { "enqueue",        NULL,           run_enqueue,        drain_run_queue },
+    { "dequeue",        fill_run_queue, run_dequeue,        NULL },
+    { "schedule",       fill_run_queue, run_schedule,       NULL },
+    { "context_switch", NULL,           run_context_switch, NULL },
+    { "send",           NULL,           run_send,           drain_mailbox },
+    { "receive",        fill_mailbox,   run_receive,        NULL },
+    { "deque_push",     NULL,           run_deque_push,     drain_deque },
+    { "deque_pop",      fill_deque,     run_deque_pop,      NULL },
+    { "steal",          fill_deque,     run_steal,          NULL },
+    { "spawn",          NULL,           run_spawn,          reap_batch },
+    { "exit",           spawn_batch,    run_exit,           NULL },
+    { "timer_arm",      fresh_wheel,    run_timer_arm,      drop_wheel },
+    { "timer_cancel",   arm_timers,     run_timer_cancel,   drop_wheel },
+    { "interp_move",    interp_reset_move,  run_interp,     NULL },
+    { "interp_add",     interp_reset_add,   run_interp,     NULL },
+    { "interp_jlt",     interp_reset_jlt,   run_interp,     NULL },
+    { "interp_next",    interp_reset_next,  run_interp,     NULL },
+    { "interp_cons",    interp_reset_cons,  run_interp,     NULL },
+    { "interp_getel",   interp_reset_getel, run_interp,     NULL },
+    { "map_interp",     template_reset_map,           run_interp, NULL },
+    { "map_native",     template_reset_map_native,    run_interp, NULL },
+    { "filter_interp",  template_reset_filter,        run_interp, NULL },
+    { "filter_native",  template_reset_filter_native, run_interp, NULL },
+    { "reduce_interp",  template_reset_reduce,        run_interp, NULL },
+    { "reduce_native",  template_reset_reduce_native, run_interp, NULL },
+    { "dict_put_hamt",   dict_reset_hamt,   run_dict_put_hamt,   NULL },
+    { "dict_put_copied", dict_reset_copied, run_dict_put_copied, NULL },
+    { "dict_get_hamt",   dict_reset_hamt,   run_dict_get_hamt,   NULL },
+    { "dict_get_copied", dict_reset_copied, run_dict_get_copied, NULL },
+    { "btree_lookup",   NULL,           run_btree_lookup,   NULL },
+    { "bst_lookup",     NULL,           run_bst_lookup,     NULL },
+    { "btree_scan",     NULL,           run_btree_scan,     NULL },
+    { "bst_scan",       NULL,           run_bst_scan,       NULL },
+    { "queue_finger",   queue_reset,    run_queue_finger,   NULL },
+    { "queue_deque",    queue_reset,    run_queue_deque,    NULL },
+    { "index_finger",   queue_reset,    run_index_finger,   NULL },
+    { "index_deque",    queue_reset,    run_index_deque,    NULL },
+    { "split_finger",   queue_reset,    run_split_finger,   NULL },
+    { "set_hit_25",     set_select_quarter,       run_set_hit,    NULL },
+    { "set_hit_50",     set_select_half,          run_set_hit,    NULL },
+    { "set_hit_87",     set_select_seven_eighths, run_set_hit,    NULL },
+    { "set_miss_25",    set_select_quarter,       run_set_miss,   NULL },
+    { "set_miss_50",    set_select_half,          run_set_miss,   NULL },
+    { "set_miss_87",    set_select_seven_eighths, run_set_miss,   NULL },
+    { "set_insert_25",  set_drain_quarter,        run_set_insert, NULL },
+    { "set_insert_50",  set_drain_half,           run_set_insert, NULL },
+    { "set_insert_87",  set_drain_seven_eighths,  run_set_insert, NULL },
+    { "fused_reduce",   pipe_reset_reduce_fused,   run_interp, NULL },
+    { "unfused_reduce", pipe_reset_reduce_unfused, run_interp, NULL },
+    { "fused_findin",   pipe_reset_findin_fused,   run_interp, NULL },
+    { "unfused_findin", pipe_reset_findin_unfused, run_interp, NULL },
+};
+
+#define PRIMITIVE_COUNT (sizeof(primitives) / sizeof(primitives[0]))
+
+typedef struct {
+    double median_ns;
+    double p99_ns;
+    double ops_per_sec;
+    double words_per_op;              // Heap words, or -1 if none is watched
+} bench_result;
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Heap pointer of the PCB a setup step asked to watch, or 0
+static uint64_t alloc_heap_pointer(const bench_context* ctx) {
+    if (ctx->alloc_pcb == NULL) {
+        return 0;
+    }
+    return *(uint64_t*)((uint8_t*)ctx->alloc_pcb + PCB_HEAP_POINTER_OFFSET_CONST);
+}
+
+// ------------------------------------------------------------
+// Measure one primitive
+// ------------------------------------------------------------
+static bench_result measure(const bench_primitive* p, bench_context* ctx, void* clock,
+                            int warmup, int samples, double* per_op_ns) {
+    uint64_t heap_bytes = 0;
+    for (int i = 0; i < warmup + samples; i++) {
+        ctx->alloc_pcb = NULL;
+        ctx->sample_ops = BATCH;
+        if (p->setup) {
+            p->setup(ctx);
+        }
+        uint64_t heap_start = alloc_heap_pointer(ctx);
+        uint64_t start = clock_read_ticks();
+        p->run(ctx);
+        uint64_t end = clock_read_ticks();
+        uint64_t heap_end = alloc_heap_pointer(ctx);
+        if (p->teardown) {
+            p->teardown(ctx);
+        }
+        if (i >= warmup) {
+            per_op_ns[i - warmup] = (double)clock_ticks_to_ns(clock, end - start) / (double)ctx->sample_ops;
+            heap_bytes += heap_end - heap_start;
+        }
+    }
+
+    double total = 0.0;
+    for (int i = 0; i < samples; i++) {
+        total += per_op_ns[i];
+    }
+    qsort(per_op_ns, (size_t)samples, sizeof(double), compare_double);
+    int p99_index = (samples * 99) / 100;
+    if (p99_index >= samples) {
+        p99_index = samples - 1;
+    }
+
+    bench_result result;
+    result.median_ns = per_op_ns[samples / 2];
+    result.p99_ns = per_op_ns[p99_index];
+    result.ops_per_sec = total > 0.0 ? 1e9 * samples / total : 0.0;
+    result.words_per_op = ctx->alloc_pcb == NULL ? -1.0 : (double)heap_bytes / 8.0 / ((double)samples * (double)ctx->sample_ops);
+    return result;
+}
+
+// Map doubles through a CALLed function, Filter keeps X > 2, Reduce sums
+static const uint32_t template_map[] = {
+    INTERP_WORD(INTERP_OP_LOADI, 3, 0, 2),
+    INTERP_WORD(INTERP_OP_NEXT, 0, 2, 3),
+    INTERP_WORD(INTERP_OP_CALL, 0, 0, 4),
+    INTERP_WORD(INTERP_OP_CONS, 1, 2, 1),
+    INTERP_WORD(INTERP_OP_JMP, 0, 0, (uint16_t)-4),
+    INTERP_WORD(INTERP_OP_REVERSE, 1, 1, 0),
+    INTERP_WORD(INTERP_OP_HALT, 1, 0, 0),
+    INTERP_WORD(INTERP_OP_MUL, 2, 2, 3),
+    INTERP_WORD(INTERP_OP_RET, 0, 0, 0),
+};
+
+static const uint32_t template_filter[] = {
+    INTERP_WORD(INTERP_OP_LOADI, 3, 0, 2),
+    INTERP_WORD(INTERP_OP_NEXT, 0, 2, 3),
+    INTERP_WORD(INTERP_OP_JGE, 3, 2, (uint16_t)-2),
+    INTERP_WORD(INTERP_OP_CONS, 1, 2, 1),
+    INTERP_WORD(INTERP_OP_JMP, 0, 0, (uint16_t)-4),
+    INTERP_WORD(INTERP_OP_REVERSE, 1, 1, 0),
+    INTERP_WORD(INTERP_OP_HALT, 1, 0, 0),
+};
+
+static const uint32_t template_reduce[] = {
+    INTERP_WORD(INTERP_OP_LOADI, 1, 0, 0),
+    INTERP_WORD(INTERP_OP_NEXT, 0, 2, 2),
+    INTERP_WORD(INTERP_OP_ADD, 1, 1, 2),
+    INTERP_WORD(INTERP_OP_JMP, 0, 0, (uint16_t)-3),
+    INTERP_WORD(INTERP_OP_HALT, 1, 0, 0),
+};
+
+// Load each template twice and compile the second copy
+static int template_context_init(bench_context* ctx) {
+    static const struct {
+        const uint32_t* code;
+        uint64_t count;
+    } templates[TEMPLATE_BENCH_COUNT] = {
+        { template_map, sizeof(template_map) / sizeof(uint32_t) },
+        { template_filter, sizeof(template_filter) / sizeof(uint32_t) },
+        { template_reduce, sizeof(template_reduce) / sizeof(uint32_t) },
+    };
+    for (int t = 0; t < TEMPLATE_BENCH_COUNT; t++) {
+        for (int native = 0; native < 2; native++) {
+            void* program = interp_load(templates[t].code, templates[t].count, NULL, 0);
+            if (program == NULL || (native && !jit_compile(program, 0, templates[t].count))) {
+                return 0;
+            }
+            ctx->template_programs[t][native] = program;
+        }
+    }
+    return 1;
+}
+
+// One program per benchmarked opcode, and the terms they read
+static int interp_context_init(bench_context* ctx) {
+    static const uint32_t words[INTERP_BENCH_COUNT] = {
+        INTERP_WORD(INTERP_OP_MOVE, 5, 1, 0),
+        INTERP_WORD(INTERP_OP_ADD, 5, 1, 2),
+        INTERP_WORD(INTERP_OP_JLT, 1, 2, 0),   // Taken, to the next instruction
+        INTERP_WORD(INTERP_OP_NEXT, 0, 5, 0),
+        INTERP_WORD(INTERP_OP_CONS, 4, 1, 4),
+        INTERP_WORD(INTERP_OP_GETEL, 5, 3, 1),
+    };
+    uint32_t code[BATCH + 1];
+    for (int op = 0; op < INTERP_BENCH_COUNT; op++) {
+        for (int i = 0; i < BATCH; i++) {
+            code[i] = words[op];
+        }
+        code[BATCH] = INTERP_WORD(INTERP_OP_HALT, 5, 0, 0);
+        ctx->interp_programs[op] = interp_load(code, BATCH + 1, NULL, 0);
+        if (ctx->interp_programs[op] == NULL) {
+            return 0;
+        }
+    }
+
+    uint8_t* pcb = (uint8_t*)ctx->interp_pcb;
+    *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST) = ctx->interp_heap;
+    *(uint64_t**)(pcb + PCB_HEAP_LIMIT_OFFSET_CONST) = ctx->interp_heap + INTERP_HEAP_WORDS;
+    ctx->interp_list = TERM_NIL;
+    for (int i = 0; i < BATCH; i++) {
+        ctx->interp_list = term_cons(pcb, term_make_int(i), ctx->interp_list);
+    }
+    ctx->interp_tuple = term_tuple(pcb, 2);
+    ctx->interp_heap_mark = *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST);
+    return template_context_init(ctx);
+}
+
+// Both initial states hold keys 0..DICT_KEYS-1; messages update them
+// in a scattered order
+static int dict_context_init(bench_context* ctx) {
+    uint8_t* pcb = (uint8_t*)ctx->dict_pcb;
+    *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST) = ctx->dict_heap;
+    *(uint64_t**)(pcb + PCB_HEAP_LIMIT_OFFSET_CONST) = ctx->dict_heap + DICT_HEAP_WORDS;
+
+    uint64_t pairs = TERM_NIL;
+    ctx->dict_copied = term_tuple(pcb, 2 * DICT_KEYS);
+    uint64_t* body = (uint64_t*)(ctx->dict_copied - TERM_TAG_BOXED);
+    for (int k = 0; k < DICT_KEYS; k++) {
+        uint64_t pair = term_tuple(pcb, 2);
+        uint64_t* elements = (uint64_t*)(pair - TERM_TAG_BOXED);
+        elements[1] = term_make_int(k);
+        elements[2] = term_make_int(0);
+        pairs = term_cons(pcb, pair, pairs);
+        body[1 + 2 * k] = elements[1];
+        body[2 + 2 * k] = elements[2];
+    }
+    ctx->dict_hamt = map_from_list(pcb, pairs);
+    if (map_get(ctx->dict_hamt, term_make_int(DICT_KEYS - 1)) != term_make_int(0)) {
+        return 0;
+    }
+    for (int i = 0; i < BATCH; i++) {
+        ctx->dict_keys[i] = term_make_int((i * 37) % DICT_KEYS);
+        ctx->dict_values[i] = term_make_int(i + 1);
+    }
+    ctx->dict_heap_mark = *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST);
+    return 1;
+}
+
+// Both trees over keys 0, 2, ..., 2 * (ORDER_KEYS - 1); probes are
+// scattered keys
+static int order_context_init(bench_context* ctx) {
+    int64_t* keys = malloc(ORDER_KEYS * sizeof(int64_t));
+    uint64_t* values = malloc(ORDER_KEYS * sizeof(uint64_t));
+    bst_node* nodes = malloc(ORDER_KEYS * sizeof(bst_node));
+    if (keys == NULL || values == NULL || nodes == NULL) {
+        return 0;
+    }
+    for (int64_t i = 0; i < ORDER_KEYS; i++) {
+        keys[i] = 2 * i;
+        values[i] = (uint64_t)i;
+    }
+    ctx->order_btree = btree_create(ORDER_KEYS);
+    if (ctx->order_btree == NULL || !btree_load(ctx->order_btree, keys, values, ORDER_KEYS)) {
+        return 0;
+    }
+    uint64_t next = 0;
+    ctx->order_bst = bst_build(nodes, &next, keys, values, 0, ORDER_KEYS);
+    for (int i = 0; i < BATCH; i++) {
+        ctx->order_probes[i] = 2 * (((int64_t)i * 7919) % ORDER_KEYS);
+    }
+    free(keys);
+    free(values);
+    return 1;
+}
+
+// The backlog starts as QUEUE_BACKLOG elements in both forms; the long
+// sequences hold 0..QUEUE_LONG-1 and are probed at scattered indices
+static int queue_context_init(bench_context* ctx) {
+    uint8_t* pcb = (uint8_t*)ctx->queue_pcb;
+    *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST) = ctx->queue_heap;
+    *(uint64_t**)(pcb + PCB_HEAP_LIMIT_OFFSET_CONST) = ctx->queue_heap + QUEUE_HEAP_WORDS;
+
+    ctx->queue_deque = deque_new(pcb);
+    ctx->queue_long_deque = deque_new(pcb);
+    ctx->queue_finger = TERM_NIL;
+    ctx->queue_long_finger = TERM_NIL;
+    for (int64_t i = 0; i < QUEUE_LONG; i++) {
+        uint64_t element = term_make_int(i);
+        if (i < QUEUE_BACKLOG) {
+            ctx->queue_finger = finger_push_back(pcb, ctx->queue_finger, element);
+            deque_push_back(pcb, ctx->queue_deque, element);
+        }
+        ctx->queue_long_finger = finger_push_back(pcb, ctx->queue_long_finger, element);
+        deque_push_back(pcb, ctx->queue_long_deque, element);
+    }
+    if (finger_index(ctx->queue_long_finger, QUEUE_LONG - 1) != term_make_int(QUEUE_LONG - 1) ||
+        deque_index(ctx->queue_long_deque, QUEUE_LONG - 1) != term_make_int(QUEUE_LONG - 1) ||
+        finger_index(ctx->queue_finger, QUEUE_BACKLOG - 1) != term_make_int(QUEUE_BACKLOG - 1)) {
+        return 0;
+    }
+    for (int i = 0; i < BATCH; i++) {
+        ctx->queue_probes[i] = (uint64_t)(((int64_t)i * 7919) % QUEUE_LONG);
+    }
+    // Cycle the deque into its steady state, where emptied chunks are
+    // reused and samples allocate nothing past the mark
+    for (int64_t i = 0; i < QUEUE_LONG; i++) {
+        deque_push_back(pcb, ctx->queue_deque, term_make_int(i));
+        deque_pop_front(ctx->queue_deque);
+    }
+    ctx->queue_heap_mark = *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST);
+    return 1;
+}
+
+// Set at each load holds the even integers 0, 2, ...; probes are
+// scattered held keys and odd integers
+static int set_context_init(bench_context* ctx) {
+    for (int load = 0; load < SET_BENCH_LOADS; load++) {
+        uint64_t keys = set_bench_keys[load];
+        void* set = set_create(SET_SLOTS / 8 * 7);
+        if (set == NULL || !set_reserve(set, SET_SLOTS / 8 * 7)) {
+            return 0;
+        }
+        for (uint64_t k = 0; k < keys; k++) {
+            set_insert(set, term_make_int((int64_t)(2 * k)));
+        }
+        if (set_capacity(set) != SET_SLOTS) {
+            return 0;
+        }
+        ctx->set_tables[load] = set;
+        for (int i = 0; i < BATCH; i++) {
+            ctx->set_hits[load][i] = term_make_int((int64_t)(2 * (((uint64_t)i * 7919) % keys)));
+        }
+    }
+    for (int i = 0; i < BATCH; i++) {
+        ctx->set_misses[i] = term_make_int((int64_t)(2 * (((uint64_t)i * 7919) % SET_SLOTS) + 1));
+    }
+    return 1;
+}
+
+// Map doubles, Filter keeps and FindIn takes values of at least
+// PIPE_ELEMENTS (literal 0), so half the input passes and the first
+// match is its middle element; Reduce sums
+static const uint32_t pipe_double[] = {
+    INTERP_WORD(INTERP_OP_LOADI, 8, 0, 2),
+    INTERP_WORD(INTERP_OP_MUL, 2, 2, 8),
+    INTERP_WORD(INTERP_OP_RET, 0, 0, 0),
+};
+
+static const uint32_t pipe_at_least[] = {
+    INTERP_WORD(INTERP_OP_LOADI, 3, 0, 0),
+    INTERP_WORD(INTERP_OP_LOADK, 8, 0, 0),
+    INTERP_WORD(INTERP_OP_JLT, 2, 8, 1),
+    INTERP_WORD(INTERP_OP_LOADI, 3, 0, 1),
+    INTERP_WORD(INTERP_OP_RET, 0, 0, 0),
+};
+
+static const uint32_t pipe_sum[] = {
+    INTERP_WORD(INTERP_OP_ADD, 1, 1, 2),
+    INTERP_WORD(INTERP_OP_RET, 0, 0, 0),
+};
+
+// Each chain compiled both ways, over one input list on its own heap
+static int pipe_context_init(bench_context* ctx) {
+    static const struct {
+        uint64_t kind;
+        const uint32_t* body;
+        uint64_t body_count;
+    } chains[PIPE_BENCH_COUNT][3] = {
+        {
+            { PIPELINE_STAGE_MAP, pipe_double, sizeof(pipe_double) / sizeof(uint32_t) },
+            { PIPELINE_STAGE_FILTER, pipe_at_least, sizeof(pipe_at_least) / sizeof(uint32_t) },
+            { PIPELINE_STAGE_REDUCE, pipe_sum, sizeof(pipe_sum) / sizeof(uint32_t) },
+        },
+        {
+            { PIPELINE_STAGE_MAP, pipe_double, sizeof(pipe_double) / sizeof(uint32_t) },
+            { PIPELINE_STAGE_FINDIN, pipe_at_least, sizeof(pipe_at_least) / sizeof(uint32_t) },
+        },
+    };
+    static const uint64_t chain_stages[PIPE_BENCH_COUNT] = { 3, 2 };
+    uint64_t threshold = term_make_int(PIPE_ELEMENTS);
+    for (int c = 0; c < PIPE_BENCH_COUNT; c++) {
+        for (int fused = 0; fused < 2; fused++) {
+            ctx->pipe_programs[c][fused] = pipeline_load(chains[c], chain_stages[c], &threshold, 1, fused);
+            if (ctx->pipe_programs[c][fused] == NULL) {
+                return 0;
+            }
+        }
+    }
+
+    ctx->pipe_heap = malloc(sizeof(uint64_t) * PIPE_HEAP_WORDS);
+    if (ctx->pipe_heap == NULL) {
+        return 0;
+    }
+    uint8_t* pcb = (uint8_t*)ctx->pipe_pcb;
+    *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST) = ctx->pipe_heap;
+    *(uint64_t**)(pcb + PCB_HEAP_LIMIT_OFFSET_CONST) = ctx->pipe_heap + PIPE_HEAP_WORDS;
+    ctx->pipe_list = TERM_NIL;
+    for (int64_t i = PIPE_ELEMENTS - 1; i >= 0; i--) {
+        ctx->pipe_list = term_cons(pcb, term_make_int(i), ctx->pipe_list);
+    }
+    ctx->pipe_heap_mark = *(uint64_t**)(pcb + PCB_HEAP_POINTER_OFFSET_CONST);
+    return 1;
+}
+
+static int context_init(bench_context* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->states = scheduler_state_init(1);
+    if (ctx->states == NULL) {
+        return 0;
+    }
+    scheduler_init(ctx->states, 0);
+    ctx->normal_queue = (uint8_t*)ctx->states + SCHEDULER_QUEUES_OFFSET_CONST +
+                        PRIORITY_NORMAL * PRIORITY_QUEUE_SIZE_CONST;
+
+    // Runtime structures the benchmarks own, sized as the runtime says
+    ctx->mailbox = calloc(1, MSG_QUEUE_SIZE_CONST);
+    ctx->deque = calloc(1, WS_DEQUE_SIZE_CONST);
+    ctx->interp_frame = calloc(1, INTERP_FRAME_SIZE_CONST);
+    ctx->interp_pcb = calloc(1, PCB_SIZE_CONST);
+    ctx->dict_pcb = calloc(1, PCB_SIZE_CONST);
+    ctx->order_cursor = calloc(1, BTREE_CURSOR_SIZE_CONST);
+    ctx->queue_pcb = calloc(1, PCB_SIZE_CONST);
+    ctx->pipe_pcb = calloc(1, PCB_SIZE_CONST);
+    if (ctx->mailbox == NULL || ctx->deque == NULL || ctx->interp_frame == NULL || ctx->interp_pcb == NULL ||
+        ctx->dict_pcb == NULL || ctx->order_cursor == NULL || ctx->queue_pcb == NULL || ctx->pipe_pcb == NULL) {
+        return 0;
+    }
+
+    for (int i = 0; i < BATCH; i++) {
+        ctx->pcbs[i] = allocate_pcb();
+        if (ctx->pcbs[i] == NULL) {
+            return 0;
+        }
+    }
+    ctx->sender = ctx->pcbs[0];
+    ctx->receiver = ctx->pcbs[1];
+    if (!message_queue_init(ctx->mailbox, QUEUE_CAPACITY)) {
+        return 0;
+    }
+    process_set_message_queue(ctx->receiver, ctx->mailbox);
+    if (!interp_context_init(ctx) || !dict_context_init(ctx) || !order_context_init(ctx) ||
+        !queue_context_init(ctx) || !set_context_init(ctx) || !pipe_context_init(ctx)) {
+        return 0;
+    }
+    return ws_deque_init(ctx->deque, QUEUE_CAPACITY);
+}
+
+int main(int argc, char** argv) {
+    int samples = DEFAULT_SAMPLES;
+    int warmup = DEFAULT_WARMUP;
+    int json = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = 1;
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            warmup = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--samples N] [--warmup N] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (samples < 1 || samples > MAX_SAMPLES || warmup < 0) {
+        fprintf(stderr, "samples must be 1-%d and warmup non-negative\n", MAX_SAMPLES);
+        return 1;
+    }
+
+    void* clock = malloc(CLOCK_SIZE_CONST);
+    if (clock == NULL || !clock_init(clock)) {
+        fprintf(stderr, "clock setup failed\n");
+        return 1;
+    }
+    static bench_context ctx;
+    if (!context_init(&ctx)) {
+        fprintf(stderr, "benchmark setup failed\n");
+        return 1;
+    }
+    double* per_op_ns = malloc(sizeof(double) * (size_t)samples);
+    if (per_op_ns == NULL) {
+        return 1;
+    }
+
+    if (json) {
+        printf("{\"benchmark\":\"actly_microbench\",\"counter_hz\":%llu,\"batch\":%d,"
+               "\"samples\":%d,\"warmup\":%d,\"results\":[",
+               (unsigned long long)clock_read_frequency(), BATCH, samples, warmup);
+    } else {
+        printf("=== MICROBENCHMARKS (%d samples x %d ops, %d warmup) ===\n", samples, BATCH, warmup);
+        printf("%-16s %12s %12s %14s %12s\n", "primitive", "median_ns", "p99_ns", "ops_per_sec", "words_per_op");
+    }
+    for (size_t i = 0; i < PRIMITIVE_COUNT; i++) {
+        bench_result r = measure(&primitives[i], &ctx, clock, warmup, samples, per_op_ns);
+        if (json) {
+            printf("%s{\"name\":\"%s\",\"median_ns\":%.2f,\"p99_ns\":%.2f,\"ops_per_sec\":%.0f",
+                   i == 0 ? "" : ",", primitives[i].name, r.median_ns, r.p99_ns, r.ops_per_sec);
+            if (r.words_per_op >= 0.0) {
+                printf(",\"words_per_op\":%.2f", r.words_per_op);
+            }
+            printf("}");
+        } else if (r.words_per_op >= 0.0) {
+            printf("%-16s %12.2f %12.2f %14.0f %12.2f\n", primitives[i].name, r.median_ns, r.p99_ns,
+                   r.ops_per_sec, r.words_per_op);
+        } else {
+            printf("%-16s %12.2f %12.2f %14.0f %12s\n", primitives[i].name, r.median_ns, r.p99_ns,
+                   r.ops_per_sec, "-");
+        }
+    }
+    if (json) {
+        printf("]}\n");
+    }
+
+    free(per_op_ns);
+    free(clock);
+    return 0;
+}
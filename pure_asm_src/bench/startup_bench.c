@@ -0,0 +1,210 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// startup_bench.c — Startup benchmark for the hosted runtime
+// ------------------------------------------------------------
+// Measures time from exec to the first process running. The parent
+// reads the counter and spawns this program again as a child; the
+// child starts a hosted runtime with one scheduler per online CPU and
+// an initial process, waits for scheduler 0 to dispatch it and reports
+// the elapsed ticks together with the runtime's per-phase startup
+// breakdown. CNTVCT_EL0 is shared by all cores and processes, so the
+// parent's and child's readings are directly comparable.
+//
+// Usage: startup_bench_exe [runs]
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+// External assembly functions
+extern uint64_t clock_read_ticks(void);
+extern int clock_init(void* clock);
+extern uint64_t clock_ticks_to_ns(void* clock, uint64_t ticks);
+extern void* host_runtime_start_with_process(uint64_t scheduler_count, void* initial_process);
+extern void* host_runtime_states(void* runtime);
+extern uint64_t host_runtime_startup_ticks(void* runtime, uint64_t phase);
+extern int host_runtime_stop(void* runtime);
+extern int host_runtime_join(void* runtime);
+extern void* scheduler_get_current_process_with_state(void* scheduler_states, uint64_t core_id);
+extern void* allocate_pcb(void);
+extern uint64_t free_pcb(void* pcb);
+extern const uint64_t CLOCK_SIZE_CONST;
+
+// Startup phases (match host.s)
+#define HOST_PHASE_STATES  0
+#define HOST_PHASE_THREADS 1
+#define HOST_PHASE_ONLINE  2
+
+#define MAX_SCHEDULERS 128
+#define DEFAULT_RUNS 25
+#define MAX_RUNS 1000
+
+// One measurement per run, in ticks
+#define FIELD_EXEC_TO_FIRST 0
+#define FIELD_STATES 1
+#define FIELD_THREADS 2
+#define FIELD_ONLINE 3
+#define FIELD_COUNT 4
+
+static const char* field_names[FIELD_COUNT] = {
+    "exec_to_first_process", "states_reserved", "threads_created", "schedulers_online"
+};
+
+// ------------------------------------------------------------
+// Child: start the runtime and time the first dispatch
+// ------------------------------------------------------------
+static int run_child(uint64_t exec_tick) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    uint64_t schedulers = online < 1 ? 1 : (uint64_t)online;
+    if (schedulers > MAX_SCHEDULERS) {
+        schedulers = MAX_SCHEDULERS;
+    }
+
+    void* pcb = allocate_pcb();
+    void* runtime = host_runtime_start_with_process(schedulers, pcb);
+    if (runtime == NULL) {
+        return 1;
+    }
+    void* states = host_runtime_states(runtime);
+    while (scheduler_get_current_process_with_state(states, 0) != pcb) {
+        // wait for the first dispatch
+    }
+    uint64_t first_tick = clock_read_ticks();
+
+    while (host_runtime_startup_ticks(runtime, HOST_PHASE_ONLINE) == 0) {
+        // wait for the last scheduler to come online
+    }
+    printf("%llu %llu %llu %llu\n",
+           (unsigned long long)(first_tick - exec_tick),
+           (unsigned long long)host_runtime_startup_ticks(runtime, HOST_PHASE_STATES),
+           (unsigned long long)host_runtime_startup_ticks(runtime, HOST_PHASE_THREADS),
+           (unsigned long long)host_runtime_startup_ticks(runtime, HOST_PHASE_ONLINE));
+    fflush(stdout);
+
+    host_runtime_stop(runtime);
+    host_runtime_join(runtime);
+    free_pcb(pcb);
+    return 0;
+}
+
+// ------------------------------------------------------------
+// Parent: spawn one child and collect its measurement
+// ------------------------------------------------------------
+static int run_once(const char* self, uint64_t sample[FIELD_COUNT]) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return 0;
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, fds[0]);
+
+    char tick_arg[32];
+    char* argv[] = { (char*)self, "--child", tick_arg, NULL };
+    pid_t pid;
+    uint64_t exec_tick = clock_read_ticks();
+    snprintf(tick_arg, sizeof(tick_arg), "%llu", (unsigned long long)exec_tick);
+    int spawned = posix_spawn(&pid, self, &actions, NULL, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+    if (spawned != 0) {
+        close(fds[0]);
+        return 0;
+    }
+
+    FILE* out = fdopen(fds[0], "r");
+    unsigned long long values[FIELD_COUNT];
+    int fields = fscanf(out, "%llu %llu %llu %llu", &values[0], &values[1], &values[2], &values[3]);
+    fclose(out);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (fields != FIELD_COUNT || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return 0;
+    }
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        sample[i] = values[i];
+    }
+    return 1;
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && strcmp(argv[1], "--child") == 0) {
+        return run_child(strtoull(argv[2], NULL, 10));
+    }
+
+    int runs = argc > 1 ? atoi(argv[1]) : DEFAULT_RUNS;
+    if (runs < 1 || runs > MAX_RUNS) {
+        fprintf(stderr, "usage: %s [runs 1-%d]\n", argv[0], MAX_RUNS);
+        return 1;
+    }
+
+    void* clock = malloc(CLOCK_SIZE_CONST);
+    if (clock == NULL || !clock_init(clock)) {
+        fprintf(stderr, "clock setup failed\n");
+        return 1;
+    }
+
+    static uint64_t samples[FIELD_COUNT][MAX_RUNS];
+    for (int run = 0; run < runs; run++) {
+        uint64_t sample[FIELD_COUNT];
+        if (!run_once(argv[0], sample)) {
+            fprintf(stderr, "startup run %d failed\n", run);
+            return 1;
+        }
+        for (int i = 0; i < FIELD_COUNT; i++) {
+            samples[i][run] = sample[i];
+        }
+    }
+
+    printf("=== STARTUP BENCHMARK (%d runs) ===\n", runs);
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        qsort(samples[i], (size_t)runs, sizeof(uint64_t), compare_u64);
+        printf("startup.%s_ns min=%llu median=%llu max=%llu\n", field_names[i],
+               (unsigned long long)clock_ticks_to_ns(clock, samples[i][0]),
+               (unsigned long long)clock_ticks_to_ns(clock, samples[i][runs / 2]),
+               (unsigned long long)clock_ticks_to_ns(clock, samples[i][runs - 1]));
+    }
+    free(clock);
+    return 0;
+}
@@ -0,0 +1,233 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// trace_dump.c — Trace ring to Chrome/Perfetto JSON converter
+// ------------------------------------------------------------
+// Copies each scheduler's trace ring out with trace_read and writes
+// one Chrome trace-event document: a metadata record naming each core's
+// track, an "X" slice for every schedule-in/schedule-out pair (args:
+// pid, priority, exit state) and an "i" instant for every other event
+// (args: pid, arg). A slice still open when the ring was read is closed
+// at that core's last event. PC samples can also be written in folded-
+// stack form (one root frame per process) for per-actor flame graphs.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdlib.h>
+
+#include "trace_dump.h"
+
+// Largest ring trace_init accepts (TRACE_RING_MAX_EVENTS)
+#define TRACE_RING_MAX_EVENTS (1u << 20)
+
+static const char* event_name(uint32_t event) {
+    switch (event) {
+    case TRACE_EVENT_SCHED_IN: return "sched_in";
+    case TRACE_EVENT_SCHED_OUT: return "sched_out";
+    case TRACE_EVENT_YIELD: return "yield";
+    case TRACE_EVENT_PREEMPT: return "preempt";
+    case TRACE_EVENT_STEAL: return "steal";
+    case TRACE_EVENT_MIGRATE: return "migrate";
+    case TRACE_EVENT_SEND: return "send";
+    case TRACE_EVENT_RECEIVE: return "receive";
+    case TRACE_EVENT_BLOCK: return "block";
+    case TRACE_EVENT_WAKE: return "wake";
+    case TRACE_EVENT_GC_START: return "gc_start";
+    case TRACE_EVENT_GC_END: return "gc_end";
+    case TRACE_EVENT_PC_SAMPLE: return "pc_sample";
+    default: return "unknown";
+    }
+}
+
+static const char* class_name(uint32_t event) {
+    static const char* names[] = {"schedule", "yield", "migrate", "message", "block", "gc", "sample"};
+    uint32_t cls = event >> 8;
+    return cls < sizeof(names) / sizeof(names[0]) ? names[cls] : "unknown";
+}
+
+static double micros(uint64_t ticks, uint64_t origin, uint64_t counter_hz) {
+    return (double)(ticks - origin) * 1e6 / (double)counter_hz;
+}
+
+static void write_slice(FILE* out, const trace_record* in, uint64_t end, uint64_t state,
+                        uint64_t origin, uint64_t counter_hz) {
+    fprintf(out, ",\n{\"name\":\"pid %llu\",\"cat\":\"schedule\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,"
+                 "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"pid\":%llu,\"priority\":%llu,\"state\":%llu}}",
+            (unsigned long long)in->pid, in->core, micros(in->timestamp, origin, counter_hz),
+            micros(end, in->timestamp, counter_hz), (unsigned long long)in->pid,
+            (unsigned long long)in->arg, (unsigned long long)state);
+}
+
+// Copy every ring out; rings[c] holds counts[c] events, oldest first
+static int copy_rings(void* scheduler_states, uint64_t cores, trace_record*** rings_out,
+                      uint64_t** counts_out) {
+    trace_record** rings = calloc(cores ? cores : 1, sizeof(trace_record*));
+    uint64_t* counts = calloc(cores ? cores : 1, sizeof(uint64_t));
+    int ok = rings != NULL && counts != NULL;
+    for (uint64_t c = 0; ok && c < cores; c++) {
+        uint64_t available = trace_count(scheduler_states, c);
+        if (available > TRACE_RING_MAX_EVENTS) {
+            available = TRACE_RING_MAX_EVENTS;
+        }
+        if (available == 0) {
+            continue;
+        }
+        rings[c] = malloc(available * sizeof(trace_record));
+        if (rings[c] == NULL) {
+            ok = 0;
+            break;
+        }
+        counts[c] = trace_read(scheduler_states, c, rings[c], available);
+    }
+    *rings_out = rings;
+    *counts_out = counts;
+    return ok;
+}
+
+static void free_rings(trace_record** rings, uint64_t* counts, uint64_t cores) {
+    for (uint64_t c = 0; rings != NULL && c < cores; c++) {
+        free(rings[c]);
+    }
+    free(rings);
+    free(counts);
+}
+
+int trace_dump_json(FILE* out, void* scheduler_states, uint64_t cores, uint64_t counter_hz) {
+    if (out == NULL || scheduler_states == NULL || counter_hz == 0) {
+        return 0;
+    }
+    trace_record** rings;
+    uint64_t* counts;
+    int ok = copy_rings(scheduler_states, cores, &rings, &counts);
+
+    // All tracks share one time origin
+    uint64_t origin = UINT64_MAX;
+    for (uint64_t c = 0; ok && c < cores; c++) {
+        if (counts[c] && rings[c][0].timestamp < origin) {
+            origin = rings[c][0].timestamp;
+        }
+    }
+
+    if (ok) {
+        fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                     "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"actly\"}}");
+        for (uint64_t c = 0; c < cores; c++) {
+            fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%llu,"
+                         "\"args\":{\"name\":\"scheduler %llu\"}}",
+                    (unsigned long long)c, (unsigned long long)c);
+        }
+        for (uint64_t c = 0; c < cores; c++) {
+            const trace_record* running = NULL;
+            for (uint64_t i = 0; i < counts[c]; i++) {
+                const trace_record* e = &rings[c][i];
+                if (e->event == TRACE_EVENT_SCHED_IN) {
+                    if (running != NULL) {
+                        write_slice(out, running, e->timestamp, 0, origin, counter_hz);
+                    }
+                    running = e;
+                } else if (e->event == TRACE_EVENT_SCHED_OUT) {
+                    // A ring that wrapped may start with an unmatched out
+                    if (running != NULL && running->pid == e->pid) {
+                        write_slice(out, running, e->timestamp, e->arg, origin, counter_hz);
+                    }
+                    running = NULL;
+                } else {
+                    fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,"
+                                 "\"tid\":%u,\"ts\":%.3f,\"args\":{\"pid\":%llu,\"arg\":%llu}}",
+                            event_name(e->event), class_name(e->event), e->core,
+                            micros(e->timestamp, origin, counter_hz), (unsigned long long)e->pid,
+                            (unsigned long long)e->arg);
+                }
+            }
+            if (running != NULL) {
+                write_slice(out, running, rings[c][counts[c] - 1].timestamp, 0, origin, counter_hz);
+            }
+        }
+        fprintf(out, "\n]}\n");
+        ok = !ferror(out);
+    }
+
+    free_rings(rings, counts, cores);
+    return ok;
+}
+
+typedef struct {
+    uint64_t pid;
+    uint64_t pc;
+} pc_sample;
+
+static int compare_samples(const void* a, const void* b) {
+    const pc_sample* x = a;
+    const pc_sample* y = b;
+    if (x->pid != y->pid) {
+        return (x->pid > y->pid) - (x->pid < y->pid);
+    }
+    return (x->pc > y->pc) - (x->pc < y->pc);
+}
+
+int trace_dump_folded(FILE* out, void* scheduler_states, uint64_t cores) {
+    if (out == NULL || scheduler_states == NULL) {
+        return 0;
+    }
+    trace_record** rings;
+    uint64_t* counts;
+    int ok = copy_rings(scheduler_states, cores, &rings, &counts);
+
+    uint64_t total = 0;
+    for (uint64_t c = 0; ok && c < cores; c++) {
+        total += counts[c];
+    }
+    pc_sample* samples = ok ? malloc((total ? total : 1) * sizeof(pc_sample)) : NULL;
+    ok = samples != NULL;
+
+    if (ok) {
+        // Group identical (process, PC) pairs and print one line per group
+        uint64_t n = 0;
+        for (uint64_t c = 0; c < cores; c++) {
+            for (uint64_t i = 0; i < counts[c]; i++) {
+                if (rings[c][i].event == TRACE_EVENT_PC_SAMPLE) {
+                    samples[n].pid = rings[c][i].pid;
+                    samples[n].pc = rings[c][i].arg;
+                    n++;
+                }
+            }
+        }
+        qsort(samples, n, sizeof(pc_sample), compare_samples);
+        for (uint64_t i = 0; i < n;) {
+            uint64_t j = i;
+            while (j < n && samples[j].pid == samples[i].pid && samples[j].pc == samples[i].pc) {
+                j++;
+            }
+            fprintf(out, "pid %llu;0x%llx %llu\n", (unsigned long long)samples[i].pid,
+                    (unsigned long long)samples[i].pc, (unsigned long long)(j - i));
+            i = j;
+        }
+        ok = !ferror(out);
+    }
+
+    free(samples);
+    free_rings(rings, counts, cores);
+    return ok;
+}
@@ -0,0 +1,96 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// trace_dump.h — Trace ring to Chrome/Perfetto JSON converter
+// ------------------------------------------------------------
+// Reads every scheduler's trace ring (trace.s) and writes the events as
+// Chrome trace-event JSON, loadable in Perfetto or chrome://tracing.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#ifndef TRACE_DUMP_H
+#define TRACE_DUMP_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Trace classes (bit numbers in a scheduler's trace mask, match config.inc)
+#define TRACE_CLASS_SCHEDULE 0
+#define TRACE_CLASS_YIELD 1
+#define TRACE_CLASS_MIGRATE 2
+#define TRACE_CLASS_MESSAGE 3
+#define TRACE_CLASS_BLOCK 4
+#define TRACE_CLASS_GC 5
+#define TRACE_CLASS_SAMPLE 6
+#define TRACE_CLASS_ALL 0x7F
+
+// Trace events (class in bits 8 and up, match config.inc)
+#define TRACE_EVENT_SCHED_IN 0x000
+#define TRACE_EVENT_SCHED_OUT 0x001
+#define TRACE_EVENT_YIELD 0x100
+#define TRACE_EVENT_PREEMPT 0x101
+#define TRACE_EVENT_STEAL 0x200
+#define TRACE_EVENT_MIGRATE 0x201
+#define TRACE_EVENT_SEND 0x300
+#define TRACE_EVENT_RECEIVE 0x301
+#define TRACE_EVENT_BLOCK 0x400
+#define TRACE_EVENT_WAKE 0x401
+#define TRACE_EVENT_GC_START 0x500
+#define TRACE_EVENT_GC_END 0x501
+#define TRACE_EVENT_PC_SAMPLE 0x600
+
+// One ring entry as copied out by trace_read (TRACE_EVENT_SIZE_CONST bytes)
+typedef struct {
+    uint64_t timestamp;  // CNTVCT_EL0 ticks
+    uint32_t event;      // TRACE_EVENT_*
+    uint32_t core;       // recording scheduler
+    uint64_t pid;        // process, or 0
+    uint64_t arg;        // event-specific argument
+} trace_record;
+
+// Trace ring API (trace.s)
+extern int trace_init(void* scheduler_states, uint64_t core_id, uint64_t capacity);
+extern int trace_destroy(void* scheduler_states, uint64_t core_id);
+extern int trace_set_mask(void* scheduler_states, uint64_t core_id, uint64_t mask);
+extern uint64_t trace_get_mask(void* scheduler_states, uint64_t core_id);
+extern int trace_event(void* scheduler_states, uint64_t core_id, uint64_t event, uint64_t pid, uint64_t arg);
+extern uint64_t trace_count(void* scheduler_states, uint64_t core_id);
+extern uint64_t trace_read(void* scheduler_states, uint64_t core_id, void* buffer, uint64_t max_events);
+extern int trace_set_sample_period(void* scheduler_states, uint64_t core_id, uint64_t period);
+
+// Write the rings of cores 0..cores-1 to out as Chrome trace JSON.
+// Schedule in/out pairs become per-core slices, everything else an
+// instant event. Timestamps are microseconds from the earliest event,
+// converted with counter_hz (clock_read_frequency). Returns 1 on
+// success, 0 on allocation failure or a write error.
+int trace_dump_json(FILE* out, void* scheduler_states, uint64_t cores, uint64_t counter_hz);
+
+// Write the PC_SAMPLE events of cores 0..cores-1 to out in folded-stack
+// form, one "pid N;0xPC count" line per distinct process and PC, for
+// flamegraph.pl, speedscope or Perfetto. Returns 1 on success, 0 on
+// allocation failure or a write error.
+int trace_dump_folded(FILE* out, void* scheduler_states, uint64_t cores);
+
+#endif
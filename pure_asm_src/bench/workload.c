@@ -0,0 +1,1188 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// workload.c — Actor workload generator
+// ------------------------------------------------------------
+// Drives whole-system actor workloads through the runtime's run
+// queues, mailboxes and work stealing, as opposed to the per-primitive
+// costs measured by microbench.c. Supported shapes:
+//
+//   ring      - one token passed around N processes for M hops
+//   skynet    - 10-ary spawn tree down to N leaves (N a power of ten),
+//               leaf numbers summed back up to the root
+//   fanin     - N-1 producers sending M messages to one aggregator
+//   fanout    - one broadcaster sending M messages across N-1 receivers
+//   pipeline  - M items flowing through an N-stage chain
+//   random    - tokens forwarded over a random graph (out-degree 4)
+//               until M hops have been taken
+//
+// Actors are PCBs on the scheduler run queues. Every logical scheduler
+// is stepped round-robin from this thread: schedule one process, let it
+// drain its mailbox or emit messages for up to one reduction budget,
+// then either yield (re-enqueue) or wait until a message arrives. A
+// scheduler whose queues are empty steals from the busiest other
+// scheduler. Run queues and mailboxes are owned by a single scheduler,
+// so interleaving on one thread keeps the workload deterministic for a
+// given seed while still exercising placement, stealing and migration.
+//
+// Messages carry a pointer to a pooled record holding the send tick and
+// an optional payload that the receiver copies out, so the configured
+// message size is paid on every delivery. Full mailboxes apply
+// backpressure: the sender parks the message and yields until it fits.
+//
+// Reports throughput, delivery latency percentiles (reservoir sampled),
+// spawns, per-scheduler dispatch counts, steals and migrations, as a
+// table or (with --json) as one JSON object. With --trace every
+// scheduler records into a trace ring of --trace-events entries (the
+// newest are kept), sends and receives included, and the rings are
+// written to FILE as Chrome/Perfetto JSON after the run. With --top K
+// every message created or received costs the actor one reduction, and the K
+// processes with the most reductions, CPU time and dispatches are
+// reported from their PCB profiles. With --perf (Linux) each scheduler
+// counts cycles, instructions, cache and branch misses split into the
+// dispatch, steal and message phases of its steps, and the totals from
+// the stats snapshot are reported per phase. With --simulate the
+// schedulers run under the deterministic simulator (sim.s): the seed
+// also drives which scheduler steps next, each step is one runtime
+// main-loop pass on virtual time, and the schedule's digest and the
+// virtual ticks taken are reported, so policy changes can be compared
+// on exactly the same interleaving.
+//
+// Usage: workload_exe [--shape NAME] [--processes N] [--messages M]
+//                     [--message-size BYTES] [--schedulers S]
+//                     [--seed N] [--json] [--trace FILE]
+//                     [--trace-events N] [--top K] [--perf] [--simulate]
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trace_dump.h"
+
+// External assembly functions
+extern uint64_t clock_read_ticks(void);
+extern uint64_t clock_read_frequency(void);
+extern int clock_init(void* clock);
+extern uint64_t clock_ticks_to_ns(void* clock, uint64_t ticks);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern int scheduler_state_destroy(void* scheduler_states);
+extern void scheduler_init(void* scheduler_states, uint64_t core_id);
+extern int scheduler_enqueue_process(void* scheduler_states, uint64_t core_id, void* process, uint64_t priority);
+extern void* scheduler_schedule(void* scheduler_states, uint64_t core_id);
+extern void* scheduler_deschedule(void* scheduler_states, uint64_t core_id);
+extern void scheduler_decrement_reductions_with_state(void* scheduler_states, uint64_t core_id);
+extern uint64_t scheduler_refresh_now(void* scheduler_states, uint64_t core_id);
+extern void* steal_process(void* scheduler_states, uint64_t thief_core, uint64_t victim_core);
+extern uint32_t get_scheduler_load(void* scheduler_states, uint64_t core_id);
+extern void process_set_message_queue(void* pcb, void* message_queue);
+extern int message_queue_init_buffer(void* queue_ptr, uint32_t size, void* buffer);
+extern int send_message(void* sender_pcb, void* receiver_pcb, uint64_t message_data);
+extern uint64_t try_receive_message(void* receiver_pcb);
+extern uint64_t profile_get(void* pcb, uint64_t metric);
+extern uint64_t profile_top_k(void** pcbs, uint64_t count, uint64_t metric, uint64_t k, void** out);
+extern int perf_open(void* scheduler_states, uint64_t core_id);
+extern int perf_close(void* scheduler_states, uint64_t core_id);
+extern uint64_t perf_enter_phase(void* scheduler_states, uint64_t core_id, uint64_t phase);
+extern uint64_t stats_snapshot_size(uint64_t cores);
+extern int stats_snapshot(void* scheduler_states, uint64_t cores, void* out);
+extern void* sim_create(void* scheduler_states, uint64_t cores, uint64_t seed, uint64_t log_capacity);
+extern int sim_destroy(void* sim);
+extern void* sim_step(void* sim, uint64_t* core_out);
+extern uint64_t sim_advance_idle(void* sim);
+extern uint64_t sim_now(void* sim);
+extern uint64_t sim_digest(void* sim);
+
+// Runtime layout, exported by the assembly that owns it
+extern const uint64_t CLOCK_SIZE_CONST;
+extern const uint64_t PCB_SIZE_CONST;
+extern const uint64_t PCB_PID_OFFSET_CONST;
+extern const uint64_t PCB_SCHEDULER_ID_OFFSET_CONST;
+extern const uint64_t SCHEDULER_SIZE_CONST;
+extern const uint64_t SCHEDULER_TOTAL_SCHEDULED_OFFSET_CONST;
+extern const uint64_t SCHEDULER_TOTAL_MIGRATIONS_OFFSET_CONST;
+extern const uint64_t SCHEDULER_TOTAL_STEALS_OFFSET_CONST;
+extern const uint64_t MSG_QUEUE_SIZE_CONST;
+extern const uint64_t MSG_SLOT_SIZE_CONST;
+extern const uint64_t MAX_CORES_CONST;
+extern const uint64_t STATS_HEADER_SIZE_CONST;
+extern const uint64_t STATS_ROW_PERF_OFFSET_CONST;
+
+#define PRIORITY_NORMAL 2
+
+// Messages handled or sent per time slice (DEFAULT_REDUCTIONS)
+#define REDUCTIONS 2000
+
+// Don't steal from a scheduler with fewer runnable processes
+// (MIN_STEAL_QUEUE_SIZE, weighted as NORMAL priority load)
+#define MIN_STEAL_LOAD (2 * PRIORITY_NORMAL)
+
+#define SKYNET_FANOUT 10
+#define RANDOM_DEGREE 4
+#define MAX_RANDOM_TOKENS 255
+
+// Mailbox capacities; none of these can fill up in their shape except
+// the streaming ones, which rely on sender backpressure
+#define RING_MAILBOX 4
+#define SKYNET_MAILBOX 16
+#define STREAM_MAILBOX 64
+#define RANDOM_MAILBOX 256
+#define AGGREGATOR_MAILBOX 1024
+
+#define MAX_LATENCY_SAMPLES (1u << 20)
+#define RECORD_CHUNK 4096
+#define ARENA_CHUNK (1u << 20)
+#define DEFAULT_MESSAGES 1000000ULL
+#define DEFAULT_MESSAGE_SIZE 64
+#define DEFAULT_TRACE_EVENTS 65536
+
+// Profiling metrics reported by --top (match config.inc)
+#define PROFILE_METRIC_REDUCTIONS 0
+#define PROFILE_METRIC_CPU_TICKS 1
+#define PROFILE_METRIC_DISPATCHES 2
+
+// Hardware counter phases and events (match config.inc)
+#define PERF_PHASE_DISPATCH 0
+#define PERF_PHASE_STEAL 1
+#define PERF_PHASE_MESSAGE 2
+#define PERF_PHASE_COUNT 5
+#define PERF_PHASE_NONE 0xFF
+#define PERF_EVENT_COUNT 5
+
+// Simulation (match config.inc); only the digest is reported, so the
+// decision log is kept at its smallest
+#define SIM_EPOCH 0x10000000
+#define SIM_LOG_EVENTS 64
+
+typedef enum {
+    SHAPE_RING,
+    SHAPE_SKYNET,
+    SHAPE_FANIN,
+    SHAPE_FANOUT,
+    SHAPE_PIPELINE,
+    SHAPE_RANDOM
+} workload_shape;
+
+typedef struct {
+    const char* name;
+    workload_shape shape;
+    uint64_t default_processes;
+} shape_info;
+
+static const shape_info shapes[] = {
+    { "ring", SHAPE_RING, 1000 },
+    { "skynet", SHAPE_SKYNET, 1000000 },
+    { "fanin", SHAPE_FANIN, 1000 },
+    { "fanout", SHAPE_FANOUT, 1000 },
+    { "pipeline", SHAPE_PIPELINE, 16 },
+    { "random", SHAPE_RANDOM, 10000 },
+};
+
+#define SHAPE_COUNT (sizeof(shapes) / sizeof(shapes[0]))
+
+typedef struct message_record {
+    struct message_record* next_free;
+    uint64_t send_tick;
+    uint64_t value;
+    uint8_t payload[];
+} message_record;
+
+typedef struct {
+    uint8_t* pcb;
+    void* mailbox;             // message queue, followed by its slots
+    uint64_t value;            // skynet number or sum; ring/random unused
+    uint64_t remaining;        // replies awaited or messages still to emit
+    uint64_t cursor;           // fan-out receiver or skynet "children spawned"
+    message_record* out;       // message waiting for mailbox space
+    uint32_t out_target;
+    uint32_t parent;           // skynet parent, ring/pipeline successor
+    uint32_t level;            // skynet depth
+    uint32_t queued;           // on a run queue
+} actor;
+
+typedef struct arena_chunk {
+    struct arena_chunk* next;
+    size_t used;
+    uint8_t data[];
+} arena_chunk;
+
+typedef struct {
+    const shape_info* shape;
+    uint64_t processes;
+    uint64_t messages;
+    uint64_t message_size;
+    uint64_t schedulers;
+    uint64_t seed;
+    int json;
+    const char* trace_path;
+    uint64_t trace_events;
+    uint64_t top;
+    int perf;
+    int simulate;
+} workload_config;
+
+typedef struct {
+    workload_config config;
+    void* states;
+    void* sim;
+    actor* actors;
+    uint8_t* pcb_pool;
+    uint32_t* edges;
+    uint64_t actor_count;
+    uint64_t actor_capacity;
+    uint64_t skynet_depth;
+    arena_chunk* arena;
+    message_record* free_records;
+    size_t record_bytes;
+    uint8_t* scratch;
+    uint64_t rng;
+    uint64_t spawns;
+    uint64_t delivered;
+    uint64_t hops_remaining;
+    uint64_t result;
+    uint64_t expected;
+    uint64_t* latency;
+    uint64_t latency_count;
+    uint64_t latency_seen;
+    uint64_t running_core;
+    int counting;
+} workload;
+
+// ------------------------------------------------------------
+// Allocation helpers
+// ------------------------------------------------------------
+static uint64_t next_random(workload* w) {
+    // xorshift64*: deterministic for a given --seed
+    w->rng ^= w->rng >> 12;
+    w->rng ^= w->rng << 25;
+    w->rng ^= w->rng >> 27;
+    return w->rng * 2685821657736338717ULL;
+}
+
+static void* arena_alloc(workload* w, size_t bytes) {
+    bytes = (bytes + 15) & ~(size_t)15;
+    if (w->arena == NULL || w->arena->used + bytes > ARENA_CHUNK) {
+        size_t size = bytes > ARENA_CHUNK ? bytes : ARENA_CHUNK;
+        arena_chunk* chunk = malloc(sizeof(arena_chunk) + size);
+        if (chunk == NULL) {
+            return NULL;
+        }
+        chunk->next = w->arena;
+        chunk->used = 0;
+        w->arena = chunk;
+    }
+    void* result = w->arena->data + w->arena->used;
+    w->arena->used += bytes;
+    return result;
+}
+
+static message_record* record_alloc(workload* w) {
+    if (w->free_records == NULL) {
+        uint8_t* block = arena_alloc(w, w->record_bytes * RECORD_CHUNK);
+        if (block == NULL) {
+            return NULL;
+        }
+        for (int i = 0; i < RECORD_CHUNK; i++) {
+            message_record* r = (message_record*)(block + (size_t)i * w->record_bytes);
+            r->next_free = w->free_records;
+            w->free_records = r;
+        }
+    }
+    message_record* r = w->free_records;
+    w->free_records = r->next_free;
+    return r;
+}
+
+static void record_free(workload* w, message_record* r) {
+    r->next_free = w->free_records;
+    w->free_records = r;
+}
+
+// ------------------------------------------------------------
+// Process helpers
+// ------------------------------------------------------------
+// Message timestamps: virtual time under --simulate
+static uint64_t now_ticks(workload* w) {
+    return w->sim != NULL ? sim_now(w->sim) : clock_read_ticks();
+}
+
+static actor* actor_of(workload* w, void* pcb) {
+    return &w->actors[((uint8_t*)pcb - w->pcb_pool) / PCB_SIZE_CONST];
+}
+
+static void make_runnable(workload* w, actor* a) {
+    if (!a->queued) {
+        a->queued = 1;
+        uint64_t core = *(uint64_t*)(a->pcb + PCB_SCHEDULER_ID_OFFSET_CONST);
+        scheduler_enqueue_process(w->states, core, a->pcb, PRIORITY_NORMAL);
+    }
+}
+
+static actor* spawn_actor(workload* w, uint64_t core, uint32_t mailbox_capacity) {
+    if (w->actor_count >= w->actor_capacity) {
+        return NULL;
+    }
+    uint64_t id = w->actor_count++;
+    actor* a = &w->actors[id];
+    memset(a, 0, sizeof(*a));
+    a->pcb = w->pcb_pool + id * PCB_SIZE_CONST;
+    memset(a->pcb, 0, PCB_SIZE_CONST);
+    *(uint64_t*)(a->pcb + PCB_PID_OFFSET_CONST) = id + 1;
+    *(uint64_t*)(a->pcb + PCB_SCHEDULER_ID_OFFSET_CONST) = core;
+    if (mailbox_capacity) {
+        a->mailbox = arena_alloc(w, MSG_QUEUE_SIZE_CONST + (size_t)mailbox_capacity * MSG_SLOT_SIZE_CONST);
+        if (a->mailbox == NULL ||
+            !message_queue_init_buffer(a->mailbox, mailbox_capacity, (uint8_t*)a->mailbox + MSG_QUEUE_SIZE_CONST)) {
+            return NULL;
+        }
+        process_set_message_queue(a->pcb, a->mailbox);
+    }
+    w->spawns++;
+    return a;
+}
+
+// ------------------------------------------------------------
+// Messaging helpers
+// ------------------------------------------------------------
+// Record a message event on the scheduler the actor runs on. send_message
+// has no scheduler context, so the driver traces it here.
+static void trace_message(workload* w, actor* a, uint64_t event, uint64_t arg) {
+    if (w->config.trace_path != NULL) {
+        uint64_t core = *(uint64_t*)(a->pcb + PCB_SCHEDULER_ID_OFFSET_CONST);
+        trace_event(w->states, core, event, *(uint64_t*)(a->pcb + PCB_PID_OFFSET_CONST), arg);
+    }
+}
+
+// With --top, each message created or received costs the running actor
+// one reduction (one step of its REDUCTIONS budget), so its PCB profile
+// reflects the work done
+static void charge_reduction(workload* w) {
+    if (w->config.top) {
+        scheduler_decrement_reductions_with_state(w->states, w->running_core);
+    }
+}
+
+static message_record* make_message(workload* w, uint64_t value) {
+    charge_reduction(w);
+    message_record* r = record_alloc(w);
+    if (r != NULL) {
+        r->value = value;
+        if (w->config.message_size) {
+            memset(r->payload, (int)(value & 0xff), w->config.message_size);
+        }
+    }
+    return r;
+}
+
+// Post a stamped record; on a full mailbox park it on the sender and
+// return 0 so the sender yields and retries on its next time slice
+static int post(workload* w, actor* from, uint32_t to, message_record* r) {
+    actor* target = &w->actors[to];
+    if (!send_message(from->pcb, target->pcb, (uint64_t)(uintptr_t)r)) {
+        from->out = r;
+        from->out_target = to;
+        return 0;
+    }
+    trace_message(w, from, TRACE_EVENT_SEND, *(uint64_t*)(target->pcb + PCB_PID_OFFSET_CONST));
+    make_runnable(w, target);
+    return 1;
+}
+
+// Latency runs from the first send attempt, so it includes backpressure
+static int deliver(workload* w, actor* from, uint32_t to, message_record* r) {
+    if (r == NULL) {
+        return 0;
+    }
+    r->send_tick = now_ticks(w);
+    return post(w, from, to, r);
+}
+
+static void record_latency(workload* w, uint64_t ticks) {
+    w->latency_seen++;
+    if (w->latency_count < MAX_LATENCY_SAMPLES) {
+        w->latency[w->latency_count++] = ticks;
+    } else {
+        // Reservoir sampling keeps a uniform sample of every delivery
+        uint64_t slot = next_random(w) % w->latency_seen;
+        if (slot < MAX_LATENCY_SAMPLES) {
+            w->latency[slot] = ticks;
+        }
+    }
+}
+
+static message_record* receive(workload* w, actor* a) {
+    message_record* r = (message_record*)(uintptr_t)try_receive_message(a->pcb);
+    if (r != NULL) {
+        trace_message(w, a, TRACE_EVENT_RECEIVE, (uint64_t)(uintptr_t)r);
+        charge_reduction(w);
+        record_latency(w, now_ticks(w) - r->send_tick);
+        if (w->config.message_size) {
+            memcpy(w->scratch, r->payload, w->config.message_size);
+        }
+        w->delivered++;
+    }
+    return r;
+}
+
+// ------------------------------------------------------------
+// Actor behaviours (one time slice each; return 1 to yield)
+// ------------------------------------------------------------
+static int run_ring(workload* w, actor* a) {
+    for (int budget = REDUCTIONS; budget > 0; budget--) {
+        message_record* r = receive(w, a);
+        if (r == NULL) {
+            return 0;
+        }
+        if (r->value > 1) {
+            r->value--;
+            if (!deliver(w, a, a->parent, r)) {
+                return 1;
+            }
+        } else {
+            w->result = w->delivered;
+            record_free(w, r);
+        }
+    }
+    return 1;
+}
+
+static int run_skynet(workload* w, actor* a) {
+    uint32_t id = (uint32_t)(a - w->actors);
+    if (a->level == w->skynet_depth) {
+        // Leaf: report its number to the parent once and exit
+        if (a->cursor) {
+            return 0;
+        }
+        a->cursor = 1;
+        message_record* r = make_message(w, a->value);
+        return r != NULL && !deliver(w, a, a->parent, r);
+    }
+    if (!a->cursor) {
+        uint64_t span = 1;
+        for (uint64_t l = a->level + 1; l < w->skynet_depth; l++) {
+            span *= SKYNET_FANOUT;
+        }
+        uint64_t core = *(uint64_t*)(a->pcb + PCB_SCHEDULER_ID_OFFSET_CONST);
+        int leaves = a->level + 1 == w->skynet_depth;
+        for (uint64_t i = 0; i < SKYNET_FANOUT; i++) {
+            actor* child = spawn_actor(w, core, leaves ? 0 : SKYNET_MAILBOX);
+            if (child == NULL) {
+                return 0;
+            }
+            child->parent = id;
+            child->level = a->level + 1;
+            child->value = a->value + i * span;
+            make_runnable(w, child);
+        }
+        a->cursor = 1;
+        a->remaining = SKYNET_FANOUT;
+        a->value = 0;
+        return 0;
+    }
+    message_record* r;
+    while ((r = receive(w, a)) != NULL) {
+        a->value += r->value;
+        record_free(w, r);
+        if (--a->remaining == 0) {
+            if (id == 0) {
+                w->result = a->value;
+                return 0;
+            }
+            message_record* sum = make_message(w, a->value);
+            return sum != NULL && !deliver(w, a, a->parent, sum);
+        }
+    }
+    return 0;
+}
+
+static int run_sink(workload* w, actor* a) {
+    for (int budget = REDUCTIONS; budget > 0; budget--) {
+        message_record* r = receive(w, a);
+        if (r == NULL) {
+            return 0;
+        }
+        w->result++;
+        record_free(w, r);
+    }
+    return 1;
+}
+
+static int run_producer(workload* w, actor* a) {
+    for (int budget = REDUCTIONS; budget > 0 && a->remaining; budget--) {
+        message_record* r = make_message(w, a->remaining);
+        if (r == NULL) {
+            return 0;
+        }
+        a->remaining--;
+        if (!deliver(w, a, a->parent, r)) {
+            return 1;
+        }
+    }
+    return a->remaining != 0;
+}
+
+static int run_broadcaster(workload* w, actor* a) {
+    uint64_t receivers = w->config.processes - 1;
+    for (int budget = REDUCTIONS; budget > 0 && a->remaining; budget--) {
+        message_record* r = make_message(w, a->remaining);
+        if (r == NULL) {
+            return 0;
+        }
+        uint32_t to = (uint32_t)(1 + a->cursor);
+        a->cursor = (a->cursor + 1) % receivers;
+        a->remaining--;
+        if (!deliver(w, a, to, r)) {
+            return 1;
+        }
+    }
+    return a->remaining != 0;
+}
+
+static int run_stage(workload* w, actor* a) {
+    for (int budget = REDUCTIONS; budget > 0; budget--) {
+        message_record* r = receive(w, a);
+        if (r == NULL) {
+            return 0;
+        }
+        if (!deliver(w, a, a->parent, r)) {
+            return 1;
+        }
+    }
+    return 1;
+}
+
+static int run_random(workload* w, actor* a) {
+    uint32_t id = (uint32_t)(a - w->actors);
+    for (int budget = REDUCTIONS; budget > 0; budget--) {
+        message_record* r = receive(w, a);
+        if (r == NULL) {
+            return 0;
+        }
+        if (w->hops_remaining == 0) {
+            w->result++;
+            record_free(w, r);
+            continue;
+        }
+        w->hops_remaining--;
+        uint32_t to = w->edges[(uint64_t)id * RANDOM_DEGREE + next_random(w) % RANDOM_DEGREE];
+        if (!deliver(w, a, to, r)) {
+            return 1;
+        }
+    }
+    return 1;
+}
+
+static int run_actor(workload* w, actor* a) {
+    // A parked message goes first; keep yielding until it fits
+    if (a->out != NULL) {
+        message_record* r = a->out;
+        a->out = NULL;
+        if (!post(w, a, a->out_target, r)) {
+            return 1;
+        }
+    }
+    uint32_t id = (uint32_t)(a - w->actors);
+    switch (w->config.shape->shape) {
+    case SHAPE_RING:
+        return run_ring(w, a);
+    case SHAPE_SKYNET:
+        return run_skynet(w, a);
+    case SHAPE_FANIN:
+        return id == 0 ? run_sink(w, a) : run_producer(w, a);
+    case SHAPE_FANOUT:
+        return id == 0 ? run_broadcaster(w, a) : run_sink(w, a);
+    case SHAPE_PIPELINE:
+        if (id == 0) {
+            return run_producer(w, a);
+        }
+        return id + 1 == w->config.processes ? run_sink(w, a) : run_stage(w, a);
+    case SHAPE_RANDOM:
+        return run_random(w, a);
+    }
+    return 0;
+}
+
+// ------------------------------------------------------------
+// Workload setup
+// ------------------------------------------------------------
+static int setup_shape(workload* w) {
+    uint64_t n = w->config.processes;
+    uint64_t m = w->config.messages;
+    uint64_t s = w->config.schedulers;
+    actor* a;
+
+    switch (w->config.shape->shape) {
+    case SHAPE_RING:
+        for (uint64_t i = 0; i < n; i++) {
+            if ((a = spawn_actor(w, i % s, RING_MAILBOX)) == NULL) {
+                return 0;
+            }
+            a->parent = (uint32_t)((i + 1) % n);
+        }
+        w->expected = m;
+        return deliver(w, &w->actors[0], 0, make_message(w, m));
+
+    case SHAPE_SKYNET:
+        if ((a = spawn_actor(w, 0, SKYNET_MAILBOX)) == NULL) {
+            return 0;
+        }
+        make_runnable(w, a);
+        w->expected = n * (n - 1) / 2;
+        return 1;
+
+    case SHAPE_FANIN:
+    case SHAPE_FANOUT:
+    case SHAPE_PIPELINE:
+        for (uint64_t i = 0; i < n; i++) {
+            int emitter = (i == 0) != (w->config.shape->shape == SHAPE_FANIN);
+            uint32_t capacity = emitter ? 0 : STREAM_MAILBOX;
+            if (w->config.shape->shape == SHAPE_FANIN && i == 0) {
+                capacity = AGGREGATOR_MAILBOX;
+            }
+            if ((a = spawn_actor(w, i % s, capacity)) == NULL) {
+                return 0;
+            }
+        }
+        if (w->config.shape->shape == SHAPE_FANIN) {
+            for (uint64_t i = 1; i < n; i++) {
+                w->actors[i].remaining = m / (n - 1) + (i <= m % (n - 1));
+                make_runnable(w, &w->actors[i]);
+            }
+        } else {
+            w->actors[0].remaining = m;
+            for (uint64_t i = 0; i + 1 < n; i++) {
+                w->actors[i].parent = (uint32_t)(i + 1);
+            }
+            make_runnable(w, &w->actors[0]);
+        }
+        w->expected = m;
+        return 1;
+
+    case SHAPE_RANDOM:
+        w->edges = malloc(sizeof(uint32_t) * n * RANDOM_DEGREE);
+        if (w->edges == NULL) {
+            return 0;
+        }
+        for (uint64_t i = 0; i < n; i++) {
+            if ((a = spawn_actor(w, i % s, RANDOM_MAILBOX)) == NULL) {
+                return 0;
+            }
+            for (int e = 0; e < RANDOM_DEGREE; e++) {
+                w->edges[i * RANDOM_DEGREE + e] = (uint32_t)(next_random(w) % n);
+            }
+        }
+        // Fewer tokens than a mailbox holds, so a cycle of full
+        // mailboxes (and therefore deadlock) is impossible
+        uint64_t tokens = n < MAX_RANDOM_TOKENS ? n : MAX_RANDOM_TOKENS;
+        if (tokens > m) {
+            tokens = m;
+        }
+        w->hops_remaining = m - tokens;
+        w->expected = tokens;
+        for (uint64_t t = 0; t < tokens; t++) {
+            uint32_t to = (uint32_t)(next_random(w) % n);
+            if (!deliver(w, &w->actors[to], to, make_message(w, t + 1))) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+    return 0;
+}
+
+static int workload_init(workload* w, const workload_config* config) {
+    memset(w, 0, sizeof(*w));
+    w->config = *config;
+    w->rng = config->seed ? config->seed : 1;
+    w->actor_capacity = config->processes;
+
+    if (config->shape->shape == SHAPE_SKYNET) {
+        // processes counts leaves; the tree adds the internal nodes
+        uint64_t leaves = 1;
+        while (leaves < config->processes) {
+            leaves *= SKYNET_FANOUT;
+            w->skynet_depth++;
+            w->actor_capacity += leaves / SKYNET_FANOUT;
+        }
+        if (leaves != config->processes || w->skynet_depth == 0) {
+            fprintf(stderr, "skynet needs a power of ten processes (>= 10)\n");
+            return 0;
+        }
+    }
+
+    w->record_bytes = (sizeof(message_record) + config->message_size + 15) & ~(size_t)15;
+    w->states = scheduler_state_init(config->schedulers);
+    w->actors = malloc(sizeof(actor) * w->actor_capacity);
+    w->pcb_pool = calloc(w->actor_capacity, PCB_SIZE_CONST);
+    w->latency = malloc(sizeof(uint64_t) * MAX_LATENCY_SAMPLES);
+    w->scratch = malloc(config->message_size + 1);
+    if (w->states == NULL || w->actors == NULL || w->pcb_pool == NULL ||
+        w->latency == NULL || w->scratch == NULL) {
+        return 0;
+    }
+    for (uint64_t s = 0; s < config->schedulers; s++) {
+        scheduler_init(w->states, s);
+        scheduler_refresh_now(w->states, s);
+        if (config->trace_path != NULL &&
+            (!trace_init(w->states, s, config->trace_events) ||
+             !trace_set_mask(w->states, s, TRACE_CLASS_ALL))) {
+            fprintf(stderr, "--trace-events must be a power of two from 64 to 1048576\n");
+            return 0;
+        }
+    }
+    // Before any message is stamped, so every timestamp is virtual
+    if (config->simulate) {
+        w->sim = sim_create(w->states, config->schedulers, w->rng, SIM_LOG_EVENTS);
+        if (w->sim == NULL) {
+            return 0;
+        }
+    }
+    // Counters are per thread and every scheduler steps on this one;
+    // each counts only between its own phase boundaries
+    w->counting = config->perf;
+    for (uint64_t s = 0; w->counting && s < config->schedulers; s++) {
+        if (!perf_open(w->states, s)) {
+            fprintf(stderr, "perf counters unavailable; running without --perf\n");
+            w->counting = 0;
+        }
+    }
+    return setup_shape(w);
+}
+
+// Phase boundary for scheduler s when counting
+static void enter_phase(workload* w, uint64_t s, uint64_t phase) {
+    if (w->counting) {
+        perf_enter_phase(w->states, s, phase);
+    }
+}
+
+static void workload_destroy(workload* w) {
+    while (w->arena != NULL) {
+        arena_chunk* next = w->arena->next;
+        free(w->arena);
+        w->arena = next;
+    }
+    if (w->states != NULL) {
+        for (uint64_t s = 0; w->config.trace_path != NULL && s < w->config.schedulers; s++) {
+            trace_destroy(w->states, s);
+        }
+        for (uint64_t s = 0; w->config.perf && s < w->config.schedulers; s++) {
+            perf_close(w->states, s);
+        }
+        sim_destroy(w->sim);
+        scheduler_state_destroy(w->states);
+    }
+    free(w->edges);
+    free(w->actors);
+    free(w->pcb_pool);
+    free(w->latency);
+    free(w->scratch);
+}
+
+// ------------------------------------------------------------
+// Scheduling loop
+// ------------------------------------------------------------
+static void* steal_for(workload* w, uint64_t thief) {
+    uint64_t victim = thief;
+    uint32_t busiest = MIN_STEAL_LOAD - 1;
+    for (uint64_t s = 0; s < w->config.schedulers; s++) {
+        uint32_t load = get_scheduler_load(w->states, s);
+        if (s != thief && load > busiest) {
+            busiest = load;
+            victim = s;
+        }
+    }
+    if (victim == thief) {
+        return NULL;
+    }
+    scheduler_refresh_now(w->states, thief);
+    return steal_process(w->states, thief, victim);
+}
+
+// Run a dispatched or stolen process for one slice on scheduler s
+static void run_slice(workload* w, uint64_t s, void* pcb) {
+    actor* a = actor_of(w, pcb);
+    a->queued = 0;
+    w->running_core = s;
+    enter_phase(w, s, PERF_PHASE_MESSAGE);
+    int again = run_actor(w, a);
+    // Off the core before the next scheduler steps, so the slice
+    // charged to its profile is this one only
+    enter_phase(w, s, PERF_PHASE_DISPATCH);
+    scheduler_deschedule(w->states, s);
+    if (again) {
+        make_runnable(w, a);
+    }
+    enter_phase(w, s, PERF_PHASE_NONE);
+}
+
+static void workload_run(workload* w) {
+    int progressed = 1;
+    while (progressed) {
+        progressed = 0;
+        for (uint64_t s = 0; s < w->config.schedulers; s++) {
+            enter_phase(w, s, PERF_PHASE_DISPATCH);
+            void* pcb = scheduler_schedule(w->states, s);
+            if (pcb == NULL) {
+                enter_phase(w, s, PERF_PHASE_STEAL);
+                pcb = steal_for(w, s);
+            }
+            if (pcb == NULL) {
+                enter_phase(w, s, PERF_PHASE_NONE);
+                continue;
+            }
+            progressed = 1;
+            run_slice(w, s, pcb);
+        }
+    }
+}
+
+// Under --simulate the simulator picks the scheduler for every step
+// and the runtime's own pass dispatches or steals. The run ends when
+// no scheduler has work and no timer is left to wait for.
+static void workload_simulate(workload* w) {
+    for (;;) {
+        uint64_t s = 0;
+        void* pcb = sim_step(w->sim, &s);
+        if (pcb != NULL) {
+            run_slice(w, s, pcb);
+            continue;
+        }
+        uint64_t load = 0;
+        for (uint64_t c = 0; c < w->config.schedulers; c++) {
+            load += get_scheduler_load(w->states, c);
+        }
+        if (load == 0 && sim_advance_idle(w->sim) == 0) {
+            return;
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// Reporting
+// ------------------------------------------------------------
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t percentile_ns(workload* w, void* clock, int permille) {
+    if (w->latency_count == 0) {
+        return 0;
+    }
+    uint64_t index = (w->latency_count * (uint64_t)permille) / 1000;
+    if (index >= w->latency_count) {
+        index = w->latency_count - 1;
+    }
+    return clock_ticks_to_ns(clock, w->latency[index]);
+}
+
+static uint64_t scheduler_counter(workload* w, uint64_t core, uint64_t offset) {
+    return *(uint64_t*)((uint8_t*)w->states + core * SCHEDULER_SIZE_CONST + offset);
+}
+
+// Top-K processes by each profiled metric (CPU time in ns)
+static const struct {
+    const char* name;
+    uint64_t metric;
+} top_metrics[] = {
+    {"reductions", PROFILE_METRIC_REDUCTIONS},
+    {"cpu_ns", PROFILE_METRIC_CPU_TICKS},
+    {"dispatches", PROFILE_METRIC_DISPATCHES},
+};
+
+static void report_top(workload* w, void* clock) {
+    void** pcbs = malloc(sizeof(void*) * w->actor_count);
+    void** top = malloc(sizeof(void*) * w->config.top);
+    if (pcbs == NULL || top == NULL) {
+        free(pcbs);
+        free(top);
+        return;
+    }
+    for (uint64_t i = 0; i < w->actor_count; i++) {
+        pcbs[i] = w->actors[i].pcb;
+    }
+    if (w->config.json) {
+        printf(",\"top\":{");
+    }
+    for (size_t m = 0; m < sizeof(top_metrics) / sizeof(top_metrics[0]); m++) {
+        uint64_t metric = top_metrics[m].metric;
+        uint64_t found = profile_top_k(pcbs, w->actor_count, metric, w->config.top, top);
+        if (w->config.json) {
+            printf("%s\"%s\":[", m == 0 ? "" : ",", top_metrics[m].name);
+        }
+        for (uint64_t i = 0; i < found; i++) {
+            uint64_t value = profile_get(top[i], metric);
+            if (metric == PROFILE_METRIC_CPU_TICKS) {
+                value = clock_ticks_to_ns(clock, value);
+            }
+            uint64_t pid = *(uint64_t*)((uint8_t*)top[i] + PCB_PID_OFFSET_CONST);
+            if (w->config.json) {
+                printf("%s{\"pid\":%llu,\"value\":%llu}", i == 0 ? "" : ",",
+                       (unsigned long long)pid, (unsigned long long)value);
+            } else {
+                printf("top_%-10s[%2llu] pid %-8llu %12llu\n", top_metrics[m].name, (unsigned long long)i,
+                       (unsigned long long)pid, (unsigned long long)value);
+            }
+        }
+        if (w->config.json) {
+            printf("]");
+        }
+    }
+    if (w->config.json) {
+        printf("}");
+    }
+    free(pcbs);
+    free(top);
+}
+
+// Hardware events per phase, summed over the schedulers (totals row)
+static const char* const perf_phase_names[PERF_PHASE_COUNT] = {"dispatch", "steal", "message", "gc", "timer"};
+static const char* const perf_event_names[PERF_EVENT_COUNT] = {"cycles", "instructions", "l1d_misses", "llc_misses",
+                                                               "branch_misses"};
+
+static void report_perf(workload* w) {
+    uint8_t* snapshot = malloc(stats_snapshot_size(w->config.schedulers));
+    if (snapshot == NULL || !stats_snapshot(w->states, w->config.schedulers, snapshot)) {
+        free(snapshot);
+        return;
+    }
+    const uint64_t* totals = (const uint64_t*)(snapshot + STATS_HEADER_SIZE_CONST + STATS_ROW_PERF_OFFSET_CONST);
+    if (w->config.json) {
+        printf(",\"perf\":{");
+    }
+    for (int phase = 0; phase < PERF_PHASE_COUNT; phase++) {
+        if (w->config.json) {
+            printf("%s\"%s\":{", phase == 0 ? "" : ",", perf_phase_names[phase]);
+        } else {
+            printf("perf_%-9s", perf_phase_names[phase]);
+        }
+        for (int event = 0; event < PERF_EVENT_COUNT; event++) {
+            unsigned long long value = totals[phase * PERF_EVENT_COUNT + event];
+            if (w->config.json) {
+                printf("%s\"%s\":%llu", event == 0 ? "" : ",", perf_event_names[event], value);
+            } else {
+                printf(" %s %llu", perf_event_names[event], value);
+            }
+        }
+        printf(w->config.json ? "}" : "\n");
+    }
+    if (w->config.json) {
+        printf("}");
+    }
+    free(snapshot);
+}
+
+static void report(workload* w, void* clock, uint64_t elapsed_ticks, int verified) {
+    uint64_t elapsed_ns = clock_ticks_to_ns(clock, elapsed_ticks);
+    double seconds = elapsed_ns / 1e9;
+    double throughput = seconds > 0.0 ? w->delivered / seconds : 0.0;
+    uint64_t steals = 0;
+    uint64_t migrations = 0;
+    for (uint64_t s = 0; s < w->config.schedulers; s++) {
+        steals += scheduler_counter(w, s, SCHEDULER_TOTAL_STEALS_OFFSET_CONST);
+        migrations += scheduler_counter(w, s, SCHEDULER_TOTAL_MIGRATIONS_OFFSET_CONST);
+    }
+    qsort(w->latency, w->latency_count, sizeof(uint64_t), compare_u64);
+    uint64_t p50 = percentile_ns(w, clock, 500);
+    uint64_t p90 = percentile_ns(w, clock, 900);
+    uint64_t p99 = percentile_ns(w, clock, 990);
+    uint64_t p999 = percentile_ns(w, clock, 999);
+    uint64_t max = w->latency_count ? clock_ticks_to_ns(clock, w->latency[w->latency_count - 1]) : 0;
+
+    if (w->config.json) {
+        printf("{\"benchmark\":\"actly_workload\",\"shape\":\"%s\",\"processes\":%llu,"
+               "\"messages\":%llu,\"message_size\":%llu,\"schedulers\":%llu,\"seed\":%llu,"
+               "\"elapsed_ns\":%llu,\"delivered\":%llu,\"spawns\":%llu,\"messages_per_sec\":%.0f,"
+               "\"latency_ns\":{\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p999\":%llu,\"max\":%llu},"
+               "\"steals\":%llu,\"migrations\":%llu,\"verified\":%s,\"scheduled\":[",
+               w->config.shape->name, (unsigned long long)w->config.processes,
+               (unsigned long long)w->config.messages, (unsigned long long)w->config.message_size,
+               (unsigned long long)w->config.schedulers, (unsigned long long)w->config.seed,
+               (unsigned long long)elapsed_ns, (unsigned long long)w->delivered,
+               (unsigned long long)w->spawns, throughput,
+               (unsigned long long)p50, (unsigned long long)p90, (unsigned long long)p99,
+               (unsigned long long)p999, (unsigned long long)max,
+               (unsigned long long)steals, (unsigned long long)migrations, verified ? "true" : "false");
+        for (uint64_t s = 0; s < w->config.schedulers; s++) {
+            printf("%s%llu", s == 0 ? "" : ",",
+                   (unsigned long long)scheduler_counter(w, s, SCHEDULER_TOTAL_SCHEDULED_OFFSET_CONST));
+        }
+        printf("]");
+        if (w->config.top) {
+            report_top(w, clock);
+        }
+        if (w->counting) {
+            report_perf(w);
+        }
+        if (w->sim != NULL) {
+            printf(",\"simulated\":{\"virtual_ticks\":%llu,\"digest\":\"%016llx\"}",
+                   (unsigned long long)(sim_now(w->sim) - SIM_EPOCH), (unsigned long long)sim_digest(w->sim));
+        }
+        printf("}\n");
+        return;
+    }
+
+    printf("=== WORKLOAD %s (%llu processes, %llu schedulers, %llu-byte messages) ===\n",
+           w->config.shape->name, (unsigned long long)w->config.processes,
+           (unsigned long long)w->config.schedulers, (unsigned long long)w->config.message_size);
+    printf("elapsed_ms        %12.3f\n", elapsed_ns / 1e6);
+    printf("delivered         %12llu\n", (unsigned long long)w->delivered);
+    printf("spawns            %12llu\n", (unsigned long long)w->spawns);
+    printf("messages_per_sec  %12.0f\n", throughput);
+    printf("latency_p50_ns    %12llu\n", (unsigned long long)p50);
+    printf("latency_p90_ns    %12llu\n", (unsigned long long)p90);
+    printf("latency_p99_ns    %12llu\n", (unsigned long long)p99);
+    printf("latency_p999_ns   %12llu\n", (unsigned long long)p999);
+    printf("latency_max_ns    %12llu\n", (unsigned long long)max);
+    printf("steals            %12llu\n", (unsigned long long)steals);
+    printf("migrations        %12llu\n", (unsigned long long)migrations);
+    for (uint64_t s = 0; s < w->config.schedulers; s++) {
+        printf("scheduled[%3llu]    %12llu\n", (unsigned long long)s,
+               (unsigned long long)scheduler_counter(w, s, SCHEDULER_TOTAL_SCHEDULED_OFFSET_CONST));
+    }
+    printf("verified          %12s\n", verified ? "yes" : "NO");
+    if (w->sim != NULL) {
+        printf("virtual_ticks     %12llu\n", (unsigned long long)(sim_now(w->sim) - SIM_EPOCH));
+        printf("schedule_digest   %016llx\n", (unsigned long long)sim_digest(w->sim));
+    }
+    if (w->config.top) {
+        report_top(w, clock);
+    }
+    if (w->counting) {
+        report_perf(w);
+    }
+}
+
+static int usage(const char* program) {
+    fprintf(stderr, "usage: %s [--shape ring|skynet|fanin|fanout|pipeline|random] [--processes N]\n"
+                    "       [--messages M] [--message-size BYTES] [--schedulers S] [--seed N] [--json]\n"
+                    "       [--trace FILE] [--trace-events N] [--top K] [--perf] [--simulate]\n",
+            program);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    workload_config config;
+    memset(&config, 0, sizeof(config));
+    config.shape = &shapes[0];
+    config.messages = DEFAULT_MESSAGES;
+    config.message_size = DEFAULT_MESSAGE_SIZE;
+    config.schedulers = 4;
+    config.seed = 1;
+    config.trace_events = DEFAULT_TRACE_EVENTS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            config.json = 1;
+        } else if (strcmp(argv[i], "--perf") == 0) {
+            config.perf = 1;
+        } else if (strcmp(argv[i], "--simulate") == 0) {
+            config.simulate = 1;
+        } else if (i + 1 >= argc) {
+            return usage(argv[0]);
+        } else if (strcmp(argv[i], "--shape") == 0) {
+            const char* name = argv[++i];
+            config.shape = NULL;
+            for (size_t s = 0; s < SHAPE_COUNT; s++) {
+                if (strcmp(name, shapes[s].name) == 0) {
+                    config.shape = &shapes[s];
+                }
+            }
+            if (config.shape == NULL) {
+                return usage(argv[0]);
+            }
+        } else if (strcmp(argv[i], "--processes") == 0) {
+            config.processes = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--messages") == 0) {
+            config.messages = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--message-size") == 0) {
+            config.message_size = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--schedulers") == 0) {
+            config.schedulers = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            config.seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--trace") == 0) {
+            config.trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--trace-events") == 0) {
+            config.trace_events = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--top") == 0) {
+            config.top = strtoull(argv[++i], NULL, 10);
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    if (config.processes == 0) {
+        config.processes = config.shape->default_processes;
+    }
+    if (config.processes < 2 || config.processes > UINT32_MAX || config.messages == 0 ||
+        config.schedulers == 0 || config.schedulers > MAX_CORES_CONST || config.message_size > (1u << 20)) {
+        fprintf(stderr, "need 2+ processes, 1+ messages, 1-%llu schedulers and messages up to 1MiB\n",
+                (unsigned long long)MAX_CORES_CONST);
+        return 1;
+    }
+
+    void* clock = malloc(CLOCK_SIZE_CONST);
+    if (clock == NULL || !clock_init(clock)) {
+        fprintf(stderr, "clock setup failed\n");
+        free(clock);
+        return 1;
+    }
+    static workload w;
+    uint64_t start = clock_read_ticks();
+    if (!workload_init(&w, &config)) {
+        fprintf(stderr, "workload setup failed\n");
+        workload_destroy(&w);
+        free(clock);
+        return 1;
+    }
+    if (w.sim != NULL) {
+        workload_simulate(&w);
+    } else {
+        workload_run(&w);
+    }
+    uint64_t elapsed = clock_read_ticks() - start;
+
+    int verified = w.result == w.expected;
+    report(&w, clock, elapsed, verified);
+    int traced = 1;
+    if (config.trace_path != NULL) {
+        FILE* out = fopen(config.trace_path, "w");
+        traced = out != NULL && trace_dump_json(out, w.states, config.schedulers, clock_read_frequency());
+        if (out != NULL && fclose(out) != 0) {
+            traced = 0;
+        }
+        if (!traced) {
+            fprintf(stderr, "could not write trace to %s\n", config.trace_path);
+        }
+    }
+    workload_destroy(&w);
+    free(clock);
+    return verified && traced ? 0 : 1;
+}
@@ -42,6 +42,9 @@
     .text
     .align 4
 
+// Include configuration constants
+    .include "config.inc"
+
 // Define constants (matching scheduler.s and config.inc)
 .equ MAX_CORES, 128
 .equ PRIORITY_LEVELS, 4
@@ -58,42 +61,39 @@
 .equ BIF_YIELD_COST, 1
 .equ MAX_BLOCKING_TIME, 10000
 
-// Define structure offsets (matching scheduler.s)
-.equ scheduler_current_reductions, 112
-.equ scheduler_total_yields, 128
-.equ scheduler_total_blocks, 224
-.equ scheduler_total_wakes, 232
-.equ scheduler_waiting_receive, 152
-.equ scheduler_waiting_timer, 176
-.equ scheduler_waiting_io, 200
-.equ scheduler_queues, 8
-.equ queue_count, 16
-    .equ queue_head, 0
-    .equ queue_tail, 8
-    .equ scheduler_size, 248
-    .equ queue_size, 24
-    
+// Scheduler state offsets (shared with scheduler.s)
+    .include "scheduler_state.inc"
+
     // Message structure offsets
     .equ message_pattern, 0
     .equ message_next, 8
 
-// Define PCB offsets (matching process.s)
-.equ pcb_state, 32
-.equ pcb_priority, 40
-.equ pcb_next, 0
-.equ pcb_prev, 8
-.equ pcb_blocking_reason, 432
-.equ pcb_blocking_data, 440
-.equ pcb_wake_time, 448
-.equ pcb_message_pattern, 456
-.equ pcb_message_queue, 368
+    // Mailbox ring offsets (matching communication.s)
+    .equ msg_queue_head, 0
+    .equ msg_queue_messages, 16
+    .equ msg_queue_size, 24
+    .equ msg_queue_mask, 32
+    .equ msg_sender, 0
+    .equ msg_data, 8
+    .equ msg_timestamp, 16
+    .equ msg_size, 24
+
+// PCB offsets (shared with process.s)
+    .include "pcb.inc"
 
 // External function declarations (macOS linker requirements)
 .extern _scheduler_get_current_process
 .extern _scheduler_enqueue_process
+.extern _scheduler_inject_process
+.extern _scheduler_wake
 .extern _scheduler_schedule
 .extern _process_save_context
 .extern _process_restore_context
+.extern _scheduler_get_cached_now
+.extern _timer_arm
+.extern _cancel_timer
+.extern _trace_record
+.extern _match_run
 
 // ------------------------------------------------------------
 // Blocking Function Exports
@@ -133,7 +133,9 @@
     .global _process_block
     .global _process_wake
     .global _process_block_on_receive
+    .global _process_block_on_receive_match
     .global _process_block_on_timer
+    .global _process_cancel_timeout
     .global _process_block_on_io
     .global _process_check_timer_wakeups
 
@@ -142,6 +144,7 @@
 // ------------------------------------------------------------
 // Generic blocking function that moves a process to WAITING state
 // and adds it to the appropriate waiting queue based on reason.
+// The block is counted in the PCB's per-reason profile counters.
 //
 // Parameters:
 //   x0 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
@@ -239,6 +242,22 @@ block_continue:
     add x26, x26, #1
     str x26, [x23, #scheduler_total_blocks]
 
+    // Profile: per-process block count for this reason
+    add x24, x21, #pcb_block_counts
+    ldr w26, [x24, x22, lsl #2]
+    add w26, w26, #1
+    str w26, [x24, x22, lsl #2]
+
+    // Trace: blocked, with the reason
+    ldr w26, [x23, #scheduler_trace_mask]
+    tbz w26, #TRACE_CLASS_BLOCK, block_trace_done
+    mov x0, x23
+    mov x1, #TRACE_EVENT_BLOCK
+    ldr x2, [x21, #pcb_pid]
+    mov x3, x22
+    bl _trace_record
+block_trace_done:
+
     // Schedule next process
     mov x0, x19  // scheduler_states pointer
     mov x1, x28  // core_id (preserved in x28)
@@ -339,20 +358,26 @@ add_to_queue_done:
 // Process Wake Function
 // ------------------------------------------------------------
 // Wake a blocked process and return it to READY state.
-// This is the counterpart to _process_block.
+// This is the counterpart to _process_block. The WAITING -> READY
+// transition is claimed atomically, so when several wakers race only
+// one succeeds. A process homed on the calling scheduler is enqueued
+// and the scheduler woken if it is parked; one homed elsewhere
+// (pcb_scheduler_id) is handed over with _scheduler_inject_process,
+// as that scheduler's run queues belong to its own thread.
 //
 // Parameters:
-//   x0 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
-//   x1 (void*) - pcb: Process Control Block pointer
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Calling core ID (0 to MAX_CORES-1)
+//   x2 (void*) - pcb: Process Control Block pointer
 //
 // Returns:
 //   x0 (int) - success: 1 on success, 0 on failure
 //
 // Complexity: O(1) - Constant time wake operation
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 // Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16, x17, x18, x19, x20, x21, x22, x23, x24, x25, x26, x27, x28, x29, x30
 //
@@ -404,6 +429,9 @@ wake_remove_from_receive_queue:
 
 wake_remove_from_timer_queue:
     add x25, x23, #scheduler_waiting_timer
+    // Disarm the timeout (fails harmlessly if it is what woke us)
+    mov x0, x21
+    bl _process_cancel_timeout
     // mov x20, x21  // Move PCB pointer to x20 (expected by _remove_from_waiting_queue)
     // bl _remove_from_waiting_queue
     b wake_continue
@@ -415,9 +443,15 @@ wake_remove_from_io_queue:
     b wake_continue
 
 wake_continue:
-    // Set process state to READY
+    // Claim WAITING -> READY; a concurrent waker that got here first wins
+    add x0, x21, #pcb_state
     mov x26, #PROCESS_STATE_READY
-    str x26, [x21, #pcb_state]
+wake_claim_retry:
+    ldaxr x1, [x0]
+    cmp x1, #PROCESS_STATE_WAITING
+    b.ne wake_claim_lost
+    stlxr w2, x26, [x0]
+    cbnz w2, wake_claim_retry
 
     // Reset reduction counter to default
     mov x27, #DEFAULT_REDUCTIONS
@@ -426,22 +460,46 @@ wake_continue:
     // Clear blocking reason
     str xzr, [x21, #pcb_blocking_reason]
 
-    // Get process priority and enqueue to ready queue
-    ldr x28, [x21, #pcb_priority]
+    // Get process priority and return it to its home scheduler
+    ldr x27, [x21, #pcb_priority]
+    ldr x1, [x21, #pcb_scheduler_id]
+    cmp x1, x20
+    b.eq wake_enqueue_local
+    cmp x1, #MAX_CORES
+    b.hs wake_enqueue_local
+
+    // Homed on another scheduler: inject (which wakes it)
+    mov x0, x19  // scheduler_states
+    mov x2, x21  // pcb
+    mov x3, x27  // priority
+    bl _scheduler_inject_process
+    b wake_enqueued
+
+wake_enqueue_local:
     mov x0, x19  // scheduler_states
     mov x1, x20  // core_id
     mov x2, x21  // pcb
-    mov x3, x28  // priority
+    mov x3, x27  // priority
     bl _scheduler_enqueue_process
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_wake
 
+wake_enqueued:
     // Increment scheduler wake statistics
-    ldr x29, [x23, #scheduler_total_wakes]
-    add x29, x29, #1
-    str x29, [x23, #scheduler_total_wakes]
-
-    // If scheduler idle, signal scheduler (use SEV)
-    // Note: In a real system, this would wake idle cores
-    // For now, just return success
+    ldr x22, [x23, #scheduler_total_wakes]
+    add x22, x22, #1
+    str x22, [x23, #scheduler_total_wakes]
+
+    // Trace: woken, with the reason it had blocked on
+    ldr w26, [x23, #scheduler_trace_mask]
+    tbz w26, #TRACE_CLASS_BLOCK, wake_trace_done
+    mov x0, x23
+    mov x1, #TRACE_EVENT_WAKE
+    ldr x2, [x21, #pcb_pid]
+    mov x3, x24
+    bl _trace_record
+wake_trace_done:
     mov x0, #1  // Return 1 = success
     ldp x27, x30, [sp], #16
     ldp x25, x26, [sp], #16
@@ -468,6 +526,8 @@ wake_invalid_pcb:
     ldp x19, x20, [sp], #16
     ret
 
+wake_claim_lost:
+    clrex
 wake_invalid_state:
     mov x0, #0  // Return 0 = failure
     ldp x27, x30, [sp], #16
@@ -610,6 +670,18 @@ receive_pattern_match:
     mov x0, x23  // message_queue
     mov x1, x24  // message
     bl _remove_message_from_queue
+
+    // Trace: message received
+    mov x26, #scheduler_size
+    madd x26, x20, x26, x19  // x26 = scheduler state address
+    ldr w25, [x26, #scheduler_trace_mask]
+    tbz w25, #TRACE_CLASS_MESSAGE, receive_trace_done
+    mov x0, x26
+    mov x1, #TRACE_EVENT_RECEIVE
+    ldr x2, [x21, #pcb_pid]
+    mov x3, x24
+    bl _trace_record
+receive_trace_done:
     
     // Return message to caller
     mov x0, x24
@@ -655,11 +727,163 @@ receive_invalid_pcb:
     ldp x19, x20, [sp], #16
     ret
 
+// ------------------------------------------------------------
+// Process Block on Receive Match Function
+// ------------------------------------------------------------
+// Selective receive with a compiled matcher (match.s): take the
+// oldest message in the mailbox ring (communication.s) whose term
+// matches one of the matcher's clauses, or block on receive if none
+// does. The scan runs from head and stops at the first slot a sender
+// has reserved but not yet published. Taking a message past head
+// shifts the older messages up one slot, so head still only ever
+// advances and the ring stays safe for concurrent senders.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//   x2 (void*) - pcb: Process Control Block pointer
+//   x3 (void*) - matcher: Compiled matcher from _match_compile
+//   x4 (uint64_t*) - clause_out: Receives the matching clause index
+//                    (may be NULL)
+//
+// Returns:
+//   x0 (term_t) - message: Message term removed from the mailbox, or
+//                0 if the process blocked (the matcher is stored in
+//                pcb_message_pattern) or the arguments are invalid
+//
+// Complexity: O(m) matcher runs where m is number of messages in queue
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_process_block_on_receive_match:
+    cmp x1, #MAX_CORES
+    b.hs receive_match_invalid
+    cbz x2, receive_match_invalid
+    cbz x3, receive_match_invalid
+
+    // Save callee-saved registers
+    stp x19, x20, [sp, #-16]!
+    stp x21, x22, [sp, #-16]!
+    stp x23, x24, [sp, #-16]!
+    stp x25, x26, [sp, #-16]!
+    stp x27, x30, [sp, #-16]!
+
+    mov x19, x0  // scheduler_states
+    mov x20, x1  // core_id
+    mov x21, x2  // pcb
+    mov x22, x3  // matcher
+    mov x25, x4  // clause_out
+
+    ldr x23, [x21, #pcb_message_queue]
+    cbz x23, receive_match_block
+    ldr x24, [x23, #msg_queue_messages]
+    cbz x24, receive_match_block
+    ldr x26, [x23, #msg_queue_head]  // head is consumer-private
+    mov x27, x26                     // scan cursor
+
+receive_match_iterate:
+    // At most one lap of the ring
+    ldr x9, [x23, #msg_queue_size]
+    sub x10, x27, x26
+    cmp x10, x9
+    b.hs receive_match_block
+
+    // Published data word of messages[cursor]; 0 ends the scan
+    ldr x9, [x23, #msg_queue_mask]
+    and x9, x27, x9
+    mov x10, #msg_size
+    madd x9, x9, x10, x24
+    add x9, x9, #msg_data
+    ldar x1, [x9]
+    cbz x1, receive_match_block
+
+    mov x0, x22
+    bl _match_run
+    mov x9, #MATCH_NO_CLAUSE
+    cmp x0, x9
+    b.ne receive_match_found
+    add x27, x27, #1
+    b receive_match_iterate
+
+receive_match_found:
+    cbz x25, receive_match_take
+    str x0, [x25]
+receive_match_take:
+    ldr x9, [x23, #msg_queue_mask]
+    mov x10, #msg_size
+    and x11, x27, x9
+    madd x11, x11, x10, x24          // x11 = &messages[cursor]
+    ldr x12, [x11, #msg_data]        // x12 = taken message term
+
+    // Shift messages[head .. cursor-1] up one slot, newest first
+receive_match_compact:
+    cmp x27, x26
+    b.eq receive_match_release
+    sub x13, x27, #1
+    and x14, x13, x9
+    madd x14, x14, x10, x24          // x14 = &messages[cursor - 1]
+    ldp x15, x16, [x14, #msg_sender]
+    ldr x17, [x14, #msg_timestamp]
+    stp x15, x16, [x11, #msg_sender]
+    str x17, [x11, #msg_timestamp]
+    mov x11, x14
+    mov x27, x13
+    b receive_match_compact
+
+receive_match_release:
+    // Free the head slot, then release head (as _try_receive_message)
+    str xzr, [x11, #msg_data]
+    add x26, x26, #1
+    add x13, x23, #msg_queue_head
+    stlr x26, [x13]
+    mov x27, x12
+
+    // Trace: message received
+    mov x9, #scheduler_size
+    madd x9, x20, x9, x19
+    ldr w10, [x9, #scheduler_trace_mask]
+    tbz w10, #TRACE_CLASS_MESSAGE, receive_match_done
+    mov x0, x9
+    mov x1, #TRACE_EVENT_RECEIVE
+    ldr x2, [x21, #pcb_pid]
+    mov x3, x27
+    bl _trace_record
+receive_match_done:
+    mov x0, x27
+    ldp x27, x30, [sp], #16
+    ldp x25, x26, [sp], #16
+    ldp x23, x24, [sp], #16
+    ldp x21, x22, [sp], #16
+    ldp x19, x20, [sp], #16
+    ret
+
+receive_match_block:
+    str x22, [x21, #pcb_message_pattern]  // Matcher for later matching
+    mov x0, x19  // scheduler_states
+    mov x1, x20  // core_id
+    mov x2, x21  // pcb
+    mov x3, #REASON_RECEIVE  // reason
+    bl _process_block
+    mov x0, #0  // Return 0 (process blocked)
+    ldp x27, x30, [sp], #16
+    ldp x25, x26, [sp], #16
+    ldp x23, x24, [sp], #16
+    ldp x21, x22, [sp], #16
+    ldp x19, x20, [sp], #16
+    ret
+
+receive_match_invalid:
+    mov x0, #0
+    ret
+
 // ------------------------------------------------------------
 // Process Block on Timer Function
 // ------------------------------------------------------------
 // Block process with timeout using system timer.
-// Uses ARM Generic Timer (CNTPCT_EL0) for absolute wake time.
+// Wake time is absolute, based on the scheduler's cached clock
+// (CNTVCT_EL0 ticks, see _scheduler_get_cached_now).
 //
 // Parameters:
 //   x0 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
@@ -703,8 +927,11 @@ _process_block_on_timer:
     cmp x22, x24
     b.gt timer_invalid_timeout
 
-    // Read system timer (CNTPCT_EL0)
-    mrs x23, CNTPCT_EL0
+    // Read this scheduler's coarse clock
+    mov x0, x19  // scheduler_states
+    mov x1, x20  // core_id
+    bl _scheduler_get_cached_now
+    mov x23, x0
 
     // Calculate wake time (current + timeout)
     add x24, x23, x22
@@ -712,6 +939,24 @@ _process_block_on_timer:
     // Store wake time in PCB
     str x24, [x21, #pcb_wake_time]
 
+    // Arm a wake-up on this core's timer wheel when one is present;
+    // without a wheel the waiting_timer queue scan still applies
+    str xzr, [x21, #pcb_blocking_data]  // No timer yet
+    mov x25, #scheduler_size
+    madd x25, x20, x25, x19
+    ldr x25, [x25, #scheduler_timer_wheel]
+    cbz x25, timer_block_no_wheel
+    mov x0, x19  // scheduler_states
+    mov x1, x20  // core_id
+    mov x2, x21  // pcb (NULL callback = wake pcb)
+    mov x3, x24  // expiry
+    mov x4, xzr  // callback
+    mov x5, xzr  // argument
+    bl _timer_arm
+    str x0, [x21, #pcb_blocking_data]  // Timer ID for cancellation
+
+timer_block_no_wheel:
+
     // Block process with timer reason
     mov x0, x19  // scheduler_states
     mov x1, x20  // core_id
@@ -754,6 +999,43 @@ timer_invalid_timeout:
     ldp x19, x20, [sp], #16
     ret
 
+// ------------------------------------------------------------
+// Process Cancel Timeout Function
+// ------------------------------------------------------------
+// Cancel the timer _process_block_on_timer armed for a process, if
+// the process is blocked on REASON_TIMER. _process_wake calls this
+// whichever way the process is woken, and _actly_exit before the PCB
+// goes away, so a leftover timeout can neither wake the process out
+// of a later block nor touch a dead PCB.
+//
+// Parameters:
+//   x0 (void*) - pcb: Process Control Block pointer
+//
+// Returns:
+//   x0 (int) - cancelled: 1 if an armed timer was cancelled, 0 otherwise
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x1, x2, x3, x4, x5
+//
+_process_cancel_timeout:
+    cbz x0, cancel_timeout_none
+    ldr x1, [x0, #pcb_blocking_reason]
+    cmp x1, #REASON_TIMER
+    b.ne cancel_timeout_none
+    ldr x1, [x0, #pcb_blocking_data]
+    str xzr, [x0, #pcb_blocking_data]
+    mov x0, x1
+    b _cancel_timer                   // Tail call; a 0 ID returns 0
+
+cancel_timeout_none:
+    mov x0, #0
+    ret
+
 // ------------------------------------------------------------
 // Process Block on I/O Function
 // ------------------------------------------------------------
@@ -859,12 +1141,12 @@ _process_check_timer_wakeups:
     stp x21, x22, [sp, #-16]!
     stp x23, x24, [sp, #-16]!
     stp x25, x26, [sp, #-16]!
-    stp x27, x30, [sp], #16
+    stp x27, x30, [sp, #-16]!
 
     // x0 = scheduler_states, x1 = core_id
     mov x19, x0  // Save scheduler_states pointer
     mov x20, x1  // Save core_id
-    mov x21, #0  // woken_count = 0
+    mov x22, #0  // woken_count = 0
 
     // Validate core ID
     cmp x20, #MAX_CORES
@@ -872,15 +1154,18 @@ _process_check_timer_wakeups:
 
     // Get scheduler state
     // x19 already contains scheduler_states pointer
-    mov x22, #scheduler_size
-    mul x22, x20, x22
-    add x21, x19, x22  // x21 = scheduler state address
+    mov x21, #scheduler_size
+    mul x21, x20, x21
+    add x21, x19, x21  // x21 = scheduler state address
 
     // Get timer waiting queue
     add x23, x21, #scheduler_waiting_timer
 
-    // Read current system timer
-    mrs x24, CNTPCT_EL0
+    // Read this scheduler's coarse clock
+    mov x0, x19  // scheduler_states
+    mov x1, x20  // core_id
+    bl _scheduler_get_cached_now
+    mov x24, x0
 
     // Check if timer queue is empty
     ldr w25, [x23, #queue_count]
@@ -894,9 +1179,9 @@ timer_check_loop:
     cbz x26, timer_check_done  // No more processes
 
     // Load process wake time
-    ldr x28, [x26, #pcb_wake_time]
-    cmp x28, x24
-    b.le timer_check_wake_process
+    ldr x2, [x26, #pcb_wake_time]
+    cmp x2, x24
+    b.ls timer_check_wake_process
 
     // Process not expired, move to next
     ldr x26, [x26, #pcb_next]
@@ -906,21 +1191,23 @@ timer_check_loop:
     b timer_check_done
 
 timer_check_wake_process:
-    // Process expired, wake it up
-    mov x0, x19  // core_id
-    mov x1, x26  // pcb
+    // Process expired, wake it up (waking relinks pcb_next, read it first)
+    ldr x23, [x26, #pcb_next]
+    mov x0, x19  // scheduler_states
+    mov x1, x20  // core_id
+    mov x2, x26  // pcb
     bl _process_wake
-    add x20, x20, #1  // Increment woken_count
+    add x22, x22, x0  // Count successful wakes
 
     // Move to next process
-    ldr x26, [x26, #pcb_next]
+    mov x26, x23
     add x27, x27, #1
     cmp x27, x25
     b.lt timer_check_loop
 
 timer_check_done:
     // Return woken count
-    mov x0, x21
+    mov x0, x22
     ldp x27, x30, [sp], #16
     ldp x25, x26, [sp], #16
     ldp x23, x24, [sp], #16
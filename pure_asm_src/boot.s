@@ -34,14 +34,23 @@
 //   - Error handling for initialization failures
 //   - Integration of timer, affinity, scheduler, and communication systems
 //
-// Version: 0.10
+// Every core, primary or secondary, ends in _scheduler_core_start,
+// the same per-core init and main-loop path the hosted runtime
+// (host.s) uses for its scheduler threads. Subsystems are initialized
+// lazily: timer wheels on a core's first timer, message queues and
+// deques on first use, and scheduler state pages on first touch, so
+// boot does only the work the online cores need.
+//
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 
     .section .text
     .align 4
 
+    .equ MAX_CORES, 128
+
 // ------------------------------------------------------------
 // Boot Entry Point
 // ------------------------------------------------------------
@@ -57,41 +66,32 @@ _start:
     // Initialize primary core (core 0)
     mov x19, #0  // core_id
 
-    // Phase 1: Initialize timer system
-    bl _timer_init
-    cbz x0, boot_timer_init_failed
-
-    // Phase 2: Initialize Apple Silicon optimizations
+    // Phase 1: Initialize Apple Silicon optimizations
     bl _optimize_for_apple_silicon
     cbz x0, boot_apple_silicon_init_failed
 
-    // Phase 3: Initialize scheduler system
-    mov x0, x19  // core_id
-    bl _scheduler_init
+    // Phase 2: Reserve scheduler states for all cores (pages are only
+    // materialized for cores that come online)
+    mov x0, #MAX_CORES
+    bl _scheduler_state_init
     cbz x0, boot_scheduler_init_failed
+    mov x20, x0  // scheduler_states
 
-    // Phase 4: Initialize communication system
-    bl _timer_init  // Use existing timer_init for now
-    cbz x0, boot_communication_init_failed
+    // Timers, communication and load balancing initialize on first
+    // use; secondary cores are released with scheduler_states (x20)
+    // as their context argument
 
-    // Phase 5: Initialize load balancing
-    bl _timer_init  // Use existing timer_init for now
-    cbz x0, boot_load_balancer_init_failed
+    // Per-core init and main loop for core 0
+    mov x0, x20
+    mov x1, x19
+    mov x2, xzr  // no initial process
+    bl _scheduler_core_start
 
-    // All subsystems initialized successfully
+    // Only reached after a stop request
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
-    
-    // Enter main scheduler loop
-    bl _scheduler_main_loop
-    
-    // Should never reach here
     b _runtime_halt
 
-boot_timer_init_failed:
-    mov x0, #1  // Error code 1: Timer init failed
-    b boot_error_handler
-
 boot_apple_silicon_init_failed:
     mov x0, #2  // Error code 2: Apple Silicon init failed
     b boot_error_handler
@@ -100,14 +100,6 @@ boot_scheduler_init_failed:
     mov x0, #3  // Error code 3: Scheduler init failed
     b boot_error_handler
 
-boot_communication_init_failed:
-    mov x0, #4  // Error code 4: Communication init failed
-    b boot_error_handler
-
-boot_load_balancer_init_failed:
-    mov x0, #5  // Error code 5: Load balancer init failed
-    b boot_error_handler
-
 boot_error_handler:
     // Log error and halt system
     ldp x20, x21, [sp], #16
@@ -118,7 +110,8 @@ boot_error_handler:
 // Secondary Core Entry Point
 // ------------------------------------------------------------
 // This is the entry point for secondary cores. Each core
-// initializes its own scheduler instance.
+// initializes its own scheduler instance. The primary core passes the
+// shared scheduler states as the context argument (x0).
 //
     .global _secondary_core_start
 _secondary_core_start:
@@ -126,45 +119,29 @@ _secondary_core_start:
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
 
+    mov x20, x0  // scheduler_states
+    cbz x20, secondary_boot_scheduler_init_failed
+
     // Get core ID
     mrs x0, mpidr_el1
     and x19, x0, #0xFF  // core_id
-    
-    // Phase 1: Initialize timer system (per-core)
-    bl _timer_init
-    cbz x0, secondary_boot_timer_init_failed
 
-    // Phase 2: Initialize scheduler for this core
-    mov x0, x19  // core_id
-    bl _scheduler_init
+    // Per-core init and main loop (shared with hosted scheduler threads)
+    mov x0, x20
+    mov x1, x19
+    mov x2, xzr  // no initial process
+    bl _scheduler_core_start
     cbz x0, secondary_boot_scheduler_init_failed
 
-    // Phase 3: Initialize communication for this core
-    bl _timer_init  // Use existing timer_init for now
-    cbz x0, secondary_boot_communication_init_failed
-
-    // All subsystems initialized successfully
+    // Only reached after a stop request
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
-    
-    // Enter scheduler loop
-    bl _scheduler_main_loop
-    
-    // Should never reach here
     b _runtime_halt
 
-secondary_boot_timer_init_failed:
-    mov x0, #1  // Error code 1: Timer init failed
-    b secondary_boot_error_handler
-
 secondary_boot_scheduler_init_failed:
     mov x0, #3  // Error code 3: Scheduler init failed
     b secondary_boot_error_handler
 
-secondary_boot_communication_init_failed:
-    mov x0, #4  // Error code 4: Communication init failed
-    b secondary_boot_error_handler
-
 secondary_boot_error_handler:
     // Log error and halt system
     ldp x20, x21, [sp], #16
@@ -0,0 +1,1717 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// ------------------------------------------------------------
+// btree.s — Cache-Line B+ Trees
+// ------------------------------------------------------------
+// Ordered maps from 64-bit signed keys for lookups and range scans.
+// Every node is BTREE_NODE_SIZE bytes, two cache lines, aligned to a
+// line:
+//
+//   line 0: header, meta (count << 4 | leaf << 3), 14 sorted keys
+//   line 1: 16 slots: a leaf's values, or a branch's count + 1 children
+//
+// A search reads the keys of a node with four NEON loads and compares
+// all of them against the key at once; the lanes that compare true
+// are summed into the rank, so no node is binary searched and only one
+// word of the second line is touched per level. Unused keys hold
+// BTREE_KEY_PAD and the rank is clamped to the count, so any key works.
+// A branch routes a key to the child after the separators at or below
+// it; a separator is the smallest key of the subtree to its right.
+//
+// Nodes carry a TERM_KIND_BTREE header and plain-term bodies, and the
+// same code runs two kinds of tree:
+//   - Off-heap trees (_btree_*) own one mapping of nodes, take raw
+//     keys and values and update in place.
+//   - Persistent trees (_pbtree_*) live on a process heap with small
+//     integer keys and term values. An insert copies the path from the
+//     root to the leaf and shares every other node with the previous
+//     version, which stays valid. The heap walk (term.s) steps over the
+//     filler tuple placed in front of a node to align it.
+//
+// A full node splits in two, the left keeping BTREE_SPLIT slots, so
+// every node but the root stays at least half full. Bulk loads spread
+// sorted input evenly over the fewest leaves and build each level of
+// branches in one pass. Cursors keep the path from the root, so they
+// need no sibling links and work on shared persistent nodes.
+//
+// The file provides:
+//   - Off-heap trees: create, insert, lookup, bulk load and count
+//   - Persistent trees: new, put, get, bulk build from a list and size
+//   - Range cursors over either kind
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// Include the PCB layout
+    .include "pcb.inc"
+
+// External C library functions for memory management
+    .extern _mmap
+    .extern _munmap
+
+// ------------------------------------------------------------
+// B+ Tree Function Exports
+// ------------------------------------------------------------
+// Export the B+ tree functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _btree_create
+    .global _btree_destroy
+    .global _btree_insert
+    .global _btree_lookup
+    .global _btree_load
+    .global _btree_count
+    .global _btree_seek
+    .global _btree_next
+    .global _pbtree_new
+    .global _pbtree_get
+    .global _pbtree_put
+    .global _pbtree_from_list
+    .global _pbtree_size
+    .global _pbtree_seek
+    .global _BTREE_CURSOR_SIZE_CONST
+
+// ------------------------------------------------------------
+// Off-Heap Tree Layout
+// ------------------------------------------------------------
+// One mapping: this header in the first node-sized block, then the
+// nodes, handed out in order and never freed.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ btree_root, 0                // Root node (8 bytes)
+    .equ btree_count, 8               // Keys held (8 bytes)
+    .equ btree_next, 16               // Next free node (8 bytes)
+    .equ btree_end, 24                // End of the mapping (8 bytes)
+    .equ btree_length, 32             // Mapping length for munmap (8 bytes)
+    .equ btree_nodes, BTREE_NODE_SIZE // First node
+
+    .equ btree_leaf_bit, 3            // tbnz bit of BTREE_META_LEAF
+    .equ btree_header, ((BTREE_NODE_WORDS - 1) << TERM_HEADER_ARITY_SHIFT)
+    .equ btree_path_size, (BTREE_MAX_DEPTH * 16) // (node, index) per level
+    .equ btree_pair_header, ((2 << TERM_HEADER_ARITY_SHIFT) | TERM_HEADER_TUPLE)
+    .equ btree_min_key, 0x8000000000000000 // Smallest key (and small integer)
+
+// ------------------------------------------------------------
+// Macros
+// ------------------------------------------------------------
+
+// Save and restore the callee-saved registers the updates use
+.macro BTREE_SAVE
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    stp x26, x27, [sp, #-16]!
+    stp x28, x29, [sp, #-16]!
+.endm
+
+.macro BTREE_RESTORE
+    ldp x28, x29, [sp], #16
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+.endm
+
+// Branch to \fail unless \term is a persistent tree
+.macro BTREE_CHECK term, scratch, fail
+    tbz \term, #TERM_BIT_BOXED, \fail
+    ldur \scratch, [\term, #-TERM_TAG_BOXED]
+    and \scratch, \scratch, #0xFF
+    cmp \scratch, #TERM_HEADER_BTREE
+    b.ne \fail
+.endm
+
+// \dst = keys held by \node
+.macro BTREE_COUNT dst, node
+    ldr \dst, [\node, #BTREE_META_OFFSET]
+    lsr \dst, \dst, #BTREE_META_COUNT_SHIFT
+.endm
+
+// \dst = keys of \node for which "key \cond node key" holds, where the
+// key is in both lanes of v16: cond gt counts the keys below it, ge
+// the keys at or below it. \count receives the node's count.
+// Clobbers v0-v6.
+.macro BTREE_RANK dst, node, cond, count
+    ldp q0, q1, [\node, #BTREE_KEYS_OFFSET]
+    ldp q2, q3, [\node, #(BTREE_KEYS_OFFSET + 32)]
+    ldp q4, q5, [\node, #(BTREE_KEYS_OFFSET + 64)]
+    ldr q6, [\node, #(BTREE_KEYS_OFFSET + 96)]
+    cm\cond v0.2d, v16.2d, v0.2d
+    cm\cond v1.2d, v16.2d, v1.2d
+    cm\cond v2.2d, v16.2d, v2.2d
+    cm\cond v3.2d, v16.2d, v3.2d
+    cm\cond v4.2d, v16.2d, v4.2d
+    cm\cond v5.2d, v16.2d, v5.2d
+    cm\cond v6.2d, v16.2d, v6.2d
+    add v0.2d, v0.2d, v1.2d           // True lanes are -1: sum them
+    add v2.2d, v2.2d, v3.2d
+    add v4.2d, v4.2d, v5.2d
+    add v0.2d, v0.2d, v6.2d
+    add v2.2d, v2.2d, v4.2d
+    add v0.2d, v0.2d, v2.2d
+    addp d0, v0.2d
+    fmov \dst, d0
+    neg \dst, \dst
+    BTREE_COUNT \count, \node
+    cmp \dst, \count                  // Padding counts only past the keys
+    csel \dst, \dst, \count, lo
+.endm
+
+// Copy \words words from \src to \dst, advancing both (\words ends at 0)
+.macro BTREE_COPY dst, src, words, scratch
+1:
+    cbz \words, 2f
+    ldr \scratch, [\src], #8
+    str \scratch, [\dst], #8
+    sub \words, \words, #1
+    b 1b
+2:
+.endm
+
+// ------------------------------------------------------------
+// B+ Tree Create
+// ------------------------------------------------------------
+// Map an off-heap tree with room for at least capacity keys, holding
+// none. Nodes are at least half full, so capacity / 6 nodes plus one
+// path's worth cover it.
+//
+// Parameters:
+//   x0 (uint64_t) - capacity: Keys, 1 to BTREE_MAX_CAPACITY
+//
+// Returns:
+//   x0 (void*) - tree: The tree, or NULL if capacity is out of range or
+//                mmap fails
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_btree_create:
+    cbz x0, btree_create_invalid
+    mov x1, #BTREE_MAX_CAPACITY
+    cmp x0, x1
+    b.hi btree_create_invalid
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x1, #6
+    udiv x19, x0, x1
+    add x19, x19, #(BTREE_MAX_DEPTH + 2) // Nodes, plus the header block
+    lsl x19, x19, #BTREE_NODE_SHIFT   // Mapping length
+
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, x19                       // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq btree_create_failed
+    mov x20, x0
+
+    // Header, then an empty leaf as the root (the mapping is zeroed)
+    add x0, x20, #btree_nodes
+    str x0, [x20, #btree_root]
+    add x1, x0, #BTREE_NODE_SIZE
+    str x1, [x20, #btree_next]
+    add x1, x20, x19
+    str x1, [x20, #btree_end]
+    str x19, [x20, #btree_length]
+    mov x2, #0
+    mov x4, #0
+    mov x5, #BTREE_META_LEAF
+    bl btree_fill
+    mov x0, x20
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+btree_create_failed:
+    mov x0, #0
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+btree_create_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Destroy
+// ------------------------------------------------------------
+// Unmap an off-heap tree. Cursors on it must not be used again.
+//
+// Parameters:
+//   x0 (void*) - tree: Off-heap tree
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if tree is NULL or munmap fails
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_btree_destroy:
+    cbz x0, btree_destroy_invalid
+    stp x29, x30, [sp, #-16]!
+    ldr x1, [x0, #btree_length]
+    bl _munmap
+    cmp x0, #0
+    cset x0, eq
+    ldp x29, x30, [sp], #16
+    ret
+
+btree_destroy_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Insert
+// ------------------------------------------------------------
+// Bind key to value in place, replacing the value of a key already
+// held. Full nodes on the way split bottom up; a split root adds a
+// level.
+//
+// Parameters:
+//   x0 (void*) - tree: Off-heap tree
+//   x1 (int64_t) - key: Any key
+//   x2 (uint64_t) - value: Any value
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if tree is NULL or out of nodes
+//              (the tree is unchanged)
+//
+// Complexity: O(log n)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_btree_insert:
+    cbz x0, btree_insert_invalid
+    BTREE_SAVE
+    sub sp, sp, #btree_path_size
+    mov x19, x0                       // Tree
+    mov x20, x1                       // Key
+    mov x21, x2                       // Value
+    ldr x0, [x19, #btree_root]
+    mov x2, sp
+    bl btree_descend
+    mov x22, x0                       // Levels
+
+    // A key already held takes the new value where it is
+    sub x9, x22, #1
+    add x9, sp, x9, lsl #4
+    ldp x10, x11, [x9]                // Leaf, keys below the key
+    BTREE_COUNT x12, x10
+    cmp x11, x12
+    b.hs btree_insert_new
+    add x12, x10, #BTREE_KEYS_OFFSET
+    ldr x12, [x12, x11, lsl #3]
+    cmp x12, x20
+    b.ne btree_insert_new
+    add x10, x10, #BTREE_SLOTS_OFFSET
+    str x21, [x10, x11, lsl #3]
+    b btree_insert_done
+
+btree_insert_new:
+    mov x0, sp
+    mov x1, x22
+    bl btree_splits
+    cmp x22, #BTREE_MAX_DEPTH
+    b.lo btree_insert_room
+    cmp x0, x22
+    b.hi btree_insert_failed          // The root may not split again
+btree_insert_room:
+    ldr x4, [x19, #btree_next]
+    ldr x9, [x19, #btree_end]
+    sub x9, x9, x4
+    cmp x0, x9, lsr #BTREE_NODE_SHIFT
+    b.hi btree_insert_failed
+    mov x0, sp
+    mov x1, x22
+    mov x2, x20
+    mov x3, x21
+    bl btree_grow
+    str x0, [x19, #btree_root]
+    str x1, [x19, #btree_next]
+    ldr x9, [x19, #btree_count]
+    add x9, x9, #1
+    str x9, [x19, #btree_count]
+
+btree_insert_done:
+    mov x0, #1
+    add sp, sp, #btree_path_size
+    BTREE_RESTORE
+    ret
+
+btree_insert_failed:
+    mov x0, #0
+    add sp, sp, #btree_path_size
+    BTREE_RESTORE
+    ret
+
+btree_insert_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Lookup
+// ------------------------------------------------------------
+// Find the value bound to a key.
+//
+// Parameters:
+//   x0 (void*) - tree: Off-heap tree
+//   x1 (int64_t) - key: Any key
+//   x2 (uint64_t*) - value_out: Receives the value (may be NULL)
+//
+// Returns:
+//   x0 (int) - found: 1 if the key is held, 0 if not or tree is NULL
+//
+// Complexity: O(log n), one NEON rank per level
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_btree_lookup:
+    cbz x0, btree_lookup_absent
+    stp x29, x30, [sp, #-16]!
+    mov x7, x2
+    ldr x0, [x0, #btree_root]
+    bl btree_find
+    ldp x29, x30, [sp], #16
+    cbz x0, btree_lookup_absent
+    cbz x7, btree_lookup_found
+    ldr x1, [x0]
+    str x1, [x7]
+btree_lookup_found:
+    mov x0, #1
+    ret
+
+btree_lookup_absent:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Load
+// ------------------------------------------------------------
+// Replace an off-heap tree's contents with sorted pairs, built bottom
+// up without a single split. Cursors on the old contents must not be
+// used again.
+//
+// Parameters:
+//   x0 (void*) - tree: Off-heap tree
+//   x1 (const int64_t*) - keys: Strictly ascending keys
+//   x2 (const uint64_t*) - values: Value of each key
+//   x3 (uint64_t) - count: Pairs (keys and values may be NULL if 0)
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if tree is NULL, the keys are
+//              not strictly ascending or the pairs do not fit (the tree
+//              is unchanged)
+//
+// Complexity: O(n)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_btree_load:
+    cbz x0, btree_load_invalid
+    cbz x3, btree_load_checked
+    cbz x1, btree_load_invalid
+    cbz x2, btree_load_invalid
+    mov x9, #BTREE_MAX_CAPACITY
+    cmp x3, x9
+    b.hi btree_load_invalid
+    mov x9, #1                        // Keys must ascend
+    ldr x10, [x1]
+btree_load_order:
+    cmp x9, x3
+    b.hs btree_load_checked
+    ldr x11, [x1, x9, lsl #3]
+    cmp x11, x10
+    b.le btree_load_invalid
+    mov x10, x11
+    add x9, x9, #1
+    b btree_load_order
+
+btree_load_checked:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    mov x19, x0
+    mov x20, x1
+    mov x21, x2
+    mov x22, x3
+    mov x0, x3
+    bl btree_build_nodes
+    ldr x9, [x19, #btree_end]
+    sub x9, x9, x19
+    lsr x9, x9, #BTREE_NODE_SHIFT
+    sub x9, x9, #1                    // Nodes after the header block
+    cmp x0, x9
+    b.hi btree_load_failed
+    mov x0, x20
+    mov x1, x21
+    mov x2, x22
+    add x3, x19, #btree_nodes
+    bl btree_build
+    str x0, [x19, #btree_root]
+    str x1, [x19, #btree_next]
+    str x22, [x19, #btree_count]
+    mov x0, #1
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+btree_load_failed:
+    mov x0, #0
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+btree_load_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Count
+// ------------------------------------------------------------
+// Keys held by an off-heap tree.
+//
+// Parameters:
+//   x0 (void*) - tree: Off-heap tree
+//
+// Returns:
+//   x0 (uint64_t) - count: Keys held, or 0 if tree is NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_btree_count:
+    cbz x0, btree_count_invalid
+    ldr x0, [x0, #btree_count]
+btree_count_invalid:
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Seek
+// ------------------------------------------------------------
+// Position a cursor before the first key at or above key of an
+// off-heap tree. Inserting or loading invalidates the cursor.
+//
+// Parameters:
+//   x0 (void*) - cursor: BTREE_CURSOR_SIZE bytes
+//   x1 (void*) - tree: Off-heap tree
+//   x2 (int64_t) - key: Lower bound
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if cursor or tree is NULL
+//
+// Complexity: O(log n)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_btree_seek:
+    cbz x0, btree_seek_invalid
+    cbz x1, btree_seek_invalid
+    ldr x1, [x1, #btree_root]
+    b btree_seek_root
+
+btree_seek_invalid:
+    mov x0, #0
+    ret
+
+// Shared tail: x0 cursor, x1 root node, x2 key
+btree_seek_root:
+    stp x29, x30, [sp, #-16]!
+    mov x7, x0
+    mov x0, x1
+    mov x1, x2
+    add x2, x7, #8
+    bl btree_descend
+    str x0, [x7]
+    mov x0, #1
+    ldp x29, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Next
+// ------------------------------------------------------------
+// Step a cursor of either kind of tree: the next key in order and its
+// value. A range scan seeks its low key and steps until a key passes
+// its high key.
+//
+// Parameters:
+//   x0 (void*) - cursor: Cursor placed by _btree_seek or _pbtree_seek
+//   x1 (uint64_t*) - key_out: Receives the key (may be NULL)
+//   x2 (uint64_t*) - value_out: Receives the value (may be NULL)
+//
+// Returns:
+//   x0 (int) - more: 1 if a pair was read, 0 past the last key
+//
+// Complexity: O(1) amortized; O(log n) when leaving a leaf
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_btree_next:
+    cbz x0, btree_next_end
+    ldr x5, [x0]                      // Levels
+    cbz x5, btree_next_end
+    add x4, x0, #8                    // Path
+    sub x5, x5, #1                    // Leaf level
+
+btree_next_leaf:
+    add x6, x4, x5, lsl #4
+    ldp x7, x8, [x6]                  // Leaf, next key
+    BTREE_COUNT x9, x7
+    cmp x8, x9
+    b.hs btree_next_climb
+    add x9, x8, #1
+    str x9, [x6, #8]
+    cbz x1, btree_next_value
+    add x9, x7, #BTREE_KEYS_OFFSET
+    ldr x9, [x9, x8, lsl #3]
+    str x9, [x1]
+btree_next_value:
+    cbz x2, btree_next_read
+    add x9, x7, #BTREE_SLOTS_OFFSET
+    ldr x9, [x9, x8, lsl #3]
+    str x9, [x2]
+btree_next_read:
+    mov x0, #1
+    ret
+
+    // Leaf done: move up to the nearest branch with a child left
+btree_next_climb:
+    mov x10, x5
+btree_next_up:
+    cbz x10, btree_next_end
+    sub x10, x10, #1
+    add x6, x4, x10, lsl #4
+    ldp x7, x8, [x6]                  // Branch, child
+    BTREE_COUNT x9, x7
+    cmp x8, x9
+    b.hs btree_next_up
+    add x8, x8, #1
+    str x8, [x6, #8]
+
+    // Then down the leftmost edge of that child
+btree_next_down:
+    add x9, x7, #BTREE_SLOTS_OFFSET
+    ldr x7, [x9, x8, lsl #3]
+    sub x7, x7, #TERM_TAG_BOXED
+    add x10, x10, #1
+    add x6, x4, x10, lsl #4
+    mov x8, #0
+    stp x7, xzr, [x6]
+    cmp x10, x5
+    b.lo btree_next_down
+    b btree_next_leaf
+
+btree_next_end:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Persistent B+ Tree New
+// ------------------------------------------------------------
+// Allocate an empty persistent tree: a root leaf with no keys.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//
+// Returns:
+//   x0 (term_t) - tree: Empty tree, or TERM_NONE if the heap is full
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_pbtree_new:
+    stp x29, x30, [sp, #-16]!
+    mov x1, #1
+    bl btree_reserve
+    cbz x0, pbtree_new_failed
+    mov x2, #0
+    mov x4, #0
+    mov x5, #BTREE_META_LEAF
+    bl btree_fill
+    orr x0, x0, #TERM_TAG_BOXED
+    ldp x29, x30, [sp], #16
+    ret
+
+pbtree_new_failed:
+    mov x0, #TERM_NONE
+    ldp x29, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Persistent B+ Tree Get
+// ------------------------------------------------------------
+// Find the value bound to a key.
+//
+// Parameters:
+//   x0 (term_t) - tree: Persistent tree
+//   x1 (term_t) - key: Small integer
+//
+// Returns:
+//   x0 (term_t) - value: Value stored for the key, or TERM_NONE if the
+//                 key is absent or an argument is invalid
+//
+// Complexity: O(log n), one NEON rank per level
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_pbtree_get:
+    BTREE_CHECK x0, x2, pbtree_get_absent
+    tst x1, #TERM_TAG_MASK
+    b.ne pbtree_get_absent
+    stp x29, x30, [sp, #-16]!
+    sub x0, x0, #TERM_TAG_BOXED
+    bl btree_find
+    ldp x29, x30, [sp], #16
+    cbz x0, pbtree_get_absent
+    ldr x0, [x0]
+    ret
+
+pbtree_get_absent:
+    mov x0, #TERM_NONE
+    ret
+
+// ------------------------------------------------------------
+// Persistent B+ Tree Put
+// ------------------------------------------------------------
+// A new version of a tree with key bound to value. The nodes on the
+// path to the key's leaf are copied, with any splits, in one heap
+// allocation; every other node is shared with tree, which is not
+// changed. Putting the value a key already has returns tree itself.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - tree: Persistent tree
+//   x2 (term_t) - key: Small integer
+//   x3 (term_t) - value: Any term but TERM_NONE
+//
+// Returns:
+//   x0 (term_t) - tree: Updated tree, or TERM_NONE if the heap is full
+//                 or an argument is invalid
+//
+// Complexity: O(log n) time and heap words
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_pbtree_put:
+    BTREE_CHECK x1, x9, pbtree_put_invalid
+    tst x2, #TERM_TAG_MASK
+    b.ne pbtree_put_invalid
+    cmp x3, #TERM_NONE
+    b.eq pbtree_put_invalid
+    BTREE_SAVE
+    sub sp, sp, #btree_path_size
+    mov x19, x0                       // PCB
+    mov x20, x1                       // Tree
+    mov x21, x2                       // Key
+    mov x22, x3                       // Value
+    sub x0, x20, #TERM_TAG_BOXED
+    mov x1, x21
+    mov x2, sp
+    bl btree_descend
+    mov x23, x0                       // Levels
+
+    // A key already held: copy the path and replace its value
+    mov x24, #0                       // 1 if the key is held
+    mov x25, #0                       // Nodes beyond the path
+    sub x9, x23, #1
+    add x9, sp, x9, lsl #4
+    ldp x10, x11, [x9]                // Leaf, keys below the key
+    BTREE_COUNT x12, x10
+    cmp x11, x12
+    b.hs pbtree_put_new
+    add x12, x10, #BTREE_KEYS_OFFSET
+    ldr x12, [x12, x11, lsl #3]
+    cmp x12, x21
+    b.ne pbtree_put_new
+    add x12, x10, #BTREE_SLOTS_OFFSET
+    ldr x12, [x12, x11, lsl #3]
+    cmp x12, x22
+    b.eq pbtree_put_unchanged
+    mov x24, #1
+    b pbtree_put_reserve
+
+pbtree_put_new:
+    mov x0, sp
+    mov x1, x23
+    bl btree_splits
+    mov x25, x0
+    cmp x23, #BTREE_MAX_DEPTH
+    b.lo pbtree_put_reserve
+    cmp x25, x23
+    b.hi pbtree_put_failed            // The root may not split again
+
+pbtree_put_reserve:
+    mov x0, x19
+    add x1, x23, x25
+    bl btree_reserve
+    cbz x0, pbtree_put_failed
+    mov x26, x0                       // Next node
+
+    // Copy the path, linking each copy into its parent's copy
+    mov x27, #0
+pbtree_put_copy:
+    cmp x27, x23
+    b.hs pbtree_put_copied
+    add x28, sp, x27, lsl #4
+    mov x0, x26
+    ldr x1, [x28]
+    bl btree_clone
+    str x26, [x28]
+    cbz x27, pbtree_put_copy_next
+    ldp x9, x10, [x28, #-16]          // Parent copy, child
+    add x9, x9, #BTREE_SLOTS_OFFSET
+    orr x11, x26, #TERM_TAG_BOXED
+    str x11, [x9, x10, lsl #3]
+pbtree_put_copy_next:
+    add x26, x26, #BTREE_NODE_SIZE
+    add x27, x27, #1
+    b pbtree_put_copy
+
+pbtree_put_copied:
+    cbz x24, pbtree_put_insert
+    sub x9, x23, #1
+    add x9, sp, x9, lsl #4
+    ldp x10, x11, [x9]
+    add x10, x10, #BTREE_SLOTS_OFFSET
+    str x22, [x10, x11, lsl #3]
+    ldr x0, [sp]
+    b pbtree_put_done
+
+pbtree_put_insert:
+    mov x0, sp
+    mov x1, x23
+    mov x2, x21
+    mov x3, x22
+    mov x4, x26
+    bl btree_grow
+
+pbtree_put_done:
+    orr x0, x0, #TERM_TAG_BOXED
+    add sp, sp, #btree_path_size
+    BTREE_RESTORE
+    ret
+
+pbtree_put_unchanged:
+    mov x0, x20
+    add sp, sp, #btree_path_size
+    BTREE_RESTORE
+    ret
+
+pbtree_put_failed:
+    mov x0, #TERM_NONE
+    add sp, sp, #btree_path_size
+    BTREE_RESTORE
+    ret
+
+pbtree_put_invalid:
+    mov x0, #TERM_NONE
+    ret
+
+// ------------------------------------------------------------
+// Persistent B+ Tree From List
+// ------------------------------------------------------------
+// Build a persistent tree from a list of {Key, Value} tuples sorted by
+// key, all nodes in one heap allocation.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - list: Proper list of 2-tuples whose small integer
+//                 keys strictly ascend
+//
+// Returns:
+//   x0 (term_t) - tree: The tree, or TERM_NONE if the list is malformed
+//                 or out of order, or the heap is full
+//
+// Complexity: O(n)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_pbtree_from_list:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0                       // PCB
+    mov x20, x1                       // List
+
+    // Check the list, counting pairs
+    mov x21, #0
+    mov x3, x1
+    mov x12, #btree_pair_header
+pbtree_from_list_check:
+    cmp x3, #TERM_NIL
+    b.eq pbtree_from_list_checked
+    tbz x3, #TERM_BIT_LIST, pbtree_from_list_failed
+    ldur x4, [x3, #-TERM_TAG_LIST]    // {Key, Value}
+    tbz x4, #TERM_BIT_BOXED, pbtree_from_list_failed
+    ldur x5, [x4, #-TERM_TAG_BOXED]
+    cmp x5, x12
+    b.ne pbtree_from_list_failed
+    ldur x5, [x4, #(8 - TERM_TAG_BOXED)]
+    tst x5, #TERM_TAG_MASK
+    b.ne pbtree_from_list_failed
+    cbz x21, pbtree_from_list_first
+    cmp x5, x6
+    b.le pbtree_from_list_failed      // Keys must ascend
+pbtree_from_list_first:
+    mov x6, x5
+    add x21, x21, #1
+    ldur x3, [x3, #(8 - TERM_TAG_LIST)]
+    b pbtree_from_list_check
+
+pbtree_from_list_checked:
+    mov x9, #BTREE_MAX_CAPACITY
+    cmp x21, x9
+    b.hi pbtree_from_list_failed
+    mov x0, x21
+    bl btree_build_nodes
+    mov x1, x0
+    mov x0, x19
+    bl btree_reserve
+    cbz x0, pbtree_from_list_failed
+    mov x3, x0
+    mov x0, x20
+    mov x1, #0                        // Pairs come from the list
+    mov x2, x21
+    bl btree_build
+    orr x0, x0, #TERM_TAG_BOXED
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+pbtree_from_list_failed:
+    mov x0, #TERM_NONE
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Persistent B+ Tree Size
+// ------------------------------------------------------------
+// Count the keys of a persistent tree by stepping a cursor over them.
+//
+// Parameters:
+//   x0 (term_t) - tree: Persistent tree
+//
+// Returns:
+//   x0 (uint64_t) - size: Keys, or 0 if tree is not a persistent tree
+//
+// Complexity: O(n)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_pbtree_size:
+    BTREE_CHECK x0, x9, pbtree_size_invalid
+    stp x19, x30, [sp, #-16]!
+    sub sp, sp, #(BTREE_CURSOR_SIZE + 8)
+    sub x1, x0, #TERM_TAG_BOXED
+    mov x0, sp
+    mov x2, #btree_min_key
+    bl btree_seek_root
+    mov x19, #0
+pbtree_size_step:
+    mov x0, sp
+    mov x1, #0
+    mov x2, #0
+    bl _btree_next
+    cbz x0, pbtree_size_done
+    add x19, x19, #1
+    b pbtree_size_step
+
+pbtree_size_done:
+    mov x0, x19
+    add sp, sp, #(BTREE_CURSOR_SIZE + 8)
+    ldp x19, x30, [sp], #16
+    ret
+
+pbtree_size_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Persistent B+ Tree Seek
+// ------------------------------------------------------------
+// Position a cursor before the first key at or above key of a
+// persistent tree. The version the cursor reads never changes, so it
+// stays valid across puts.
+//
+// Parameters:
+//   x0 (void*) - cursor: BTREE_CURSOR_SIZE bytes
+//   x1 (term_t) - tree: Persistent tree
+//   x2 (term_t) - key: Small integer lower bound
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if cursor is NULL or an
+//              argument is invalid
+//
+// Complexity: O(log n)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_pbtree_seek:
+    cbz x0, pbtree_seek_invalid
+    BTREE_CHECK x1, x9, pbtree_seek_invalid
+    tst x2, #TERM_TAG_MASK
+    b.ne pbtree_seek_invalid
+    sub x1, x1, #TERM_TAG_BOXED
+    b btree_seek_root
+
+pbtree_seek_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Find (internal)
+// ------------------------------------------------------------
+// Find the slot holding a key's value.
+//
+// Parameters:
+//   x0 (uint64_t*) - node: Root node
+//   x1 (uint64_t) - key: Key
+//
+// Returns:
+//   x0 (uint64_t*) - slot: The key's value slot, or NULL if absent
+//
+// Clobbers: x2-x4, v0-v6, v16
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+btree_find:
+    dup v16.2d, x1
+btree_find_level:
+    ldr x2, [x0, #BTREE_META_OFFSET]
+    tbnz x2, #btree_leaf_bit, btree_find_leaf
+    BTREE_RANK x3, x0, ge, x2
+    add x2, x0, #BTREE_SLOTS_OFFSET
+    ldr x0, [x2, x3, lsl #3]
+    sub x0, x0, #TERM_TAG_BOXED
+    b btree_find_level
+
+btree_find_leaf:
+    BTREE_RANK x3, x0, gt, x2
+    cmp x3, x2
+    b.hs btree_find_absent
+    add x4, x0, #BTREE_KEYS_OFFSET
+    ldr x4, [x4, x3, lsl #3]
+    cmp x4, x1
+    b.ne btree_find_absent
+    add x0, x0, #BTREE_SLOTS_OFFSET
+    add x0, x0, x3, lsl #3
+    ret
+
+btree_find_absent:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Descend (internal)
+// ------------------------------------------------------------
+// Walk from the root to the leaf where a key is or would go, recording
+// (node, child) for each branch and (leaf, keys below the key) last.
+//
+// Parameters:
+//   x0 (uint64_t*) - node: Root node
+//   x1 (uint64_t) - key: Key
+//   x2 (uint64_t*) - path: BTREE_MAX_DEPTH entries of 16 bytes
+//
+// Returns:
+//   x0 (uint64_t) - levels: Entries written
+//
+// Clobbers: x3-x6, v0-v6, v16
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+btree_descend:
+    dup v16.2d, x1
+    mov x3, x0                        // Node
+    mov x4, x2                        // Next entry
+btree_descend_level:
+    ldr x5, [x3, #BTREE_META_OFFSET]
+    tbnz x5, #btree_leaf_bit, btree_descend_leaf
+    BTREE_RANK x6, x3, ge, x5
+    stp x3, x6, [x4], #16
+    add x5, x3, #BTREE_SLOTS_OFFSET
+    ldr x3, [x5, x6, lsl #3]
+    sub x3, x3, #TERM_TAG_BOXED
+    b btree_descend_level
+
+btree_descend_leaf:
+    BTREE_RANK x6, x3, gt, x5
+    stp x3, x6, [x4], #16
+    sub x0, x4, x2
+    lsr x0, x0, #4
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Splits (internal)
+// ------------------------------------------------------------
+// Nodes an insert of a new key along a path adds: one per full node
+// from the leaf up, and a new root if every node on the path is full.
+//
+// Parameters:
+//   x0 (uint64_t*) - path: Path from btree_descend
+//   x1 (uint64_t) - levels: Its entries
+//
+// Returns:
+//   x0 (uint64_t) - nodes: New nodes, levels + 1 if the root splits
+//
+// Clobbers: x2-x4
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+btree_splits:
+    mov x2, x1                        // Level below the one checked
+    mov x3, #0
+btree_splits_level:
+    cbz x2, btree_splits_root
+    sub x2, x2, #1
+    add x4, x0, x2, lsl #4
+    ldr x4, [x4]
+    BTREE_COUNT x4, x4
+    cmp x4, #BTREE_KEYS
+    b.lo btree_splits_done
+    add x3, x3, #1
+    b btree_splits_level
+
+btree_splits_root:
+    add x3, x3, #1
+btree_splits_done:
+    mov x0, x3
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Grow (internal)
+// ------------------------------------------------------------
+// Insert a new key at the leaf of a path, in place, splitting full
+// nodes bottom up. The nodes needed (btree_splits) must be free from
+// next onwards.
+//
+// Parameters:
+//   x0 (uint64_t*) - path: Path from btree_descend
+//   x1 (uint64_t) - levels: Its entries
+//   x2 (uint64_t) - key: New key
+//   x3 (uint64_t) - value: Its value
+//   x4 (uint64_t*) - next: First free node
+//
+// Returns:
+//   x0 (uint64_t*) - root: Root node, new if the root split
+//   x1 (uint64_t*) - next: Past the nodes used
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+btree_grow:
+    BTREE_SAVE
+    mov x19, x0                       // Path
+    sub x20, x1, #1                   // Level
+    mov x21, x2                       // Key to place
+    mov x22, x3                       // Slot to place
+    mov x23, x4                       // Next node
+    add x9, x19, x20, lsl #4
+    ldp x24, x25, [x9]                // Node, key index
+    mov x26, x25                      // Slot index: leaves pair them
+
+btree_grow_level:
+    BTREE_COUNT x9, x24
+    cmp x9, #BTREE_KEYS
+    b.hs btree_grow_split
+    mov x0, x24
+    mov x1, x25
+    mov x2, x21
+    mov x3, x26
+    mov x4, x22
+    bl btree_place
+    ldr x0, [x19]                     // Root unchanged
+    b btree_grow_done
+
+btree_grow_split:
+    mov x0, x24
+    mov x1, x25
+    mov x2, x21
+    mov x3, x26
+    mov x4, x22
+    mov x5, x23
+    bl btree_split
+    mov x21, x0                       // Separator goes up
+    orr x22, x23, #TERM_TAG_BOXED     // Beside the split node
+    add x23, x23, #BTREE_NODE_SIZE
+    cbz x20, btree_grow_root
+    sub x20, x20, #1
+    add x9, x19, x20, lsl #4
+    ldp x24, x25, [x9]                // Parent, child split
+    add x26, x25, #1
+    b btree_grow_level
+
+    // The root split: a new root over both halves
+btree_grow_root:
+    sub sp, sp, #32
+    str x21, [sp]
+    orr x9, x24, #TERM_TAG_BOXED
+    stp x9, x22, [sp, #16]
+    mov x0, x23
+    mov x1, sp
+    mov x2, #1
+    add x3, sp, #16
+    mov x4, #2
+    mov x5, #0
+    bl btree_fill
+    add sp, sp, #32
+    mov x0, x23
+    add x23, x23, #BTREE_NODE_SIZE
+
+btree_grow_done:
+    mov x1, x23
+    BTREE_RESTORE
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Place (internal)
+// ------------------------------------------------------------
+// Insert a key and a slot into a node with room, moving the keys and
+// slots above them up one.
+//
+// Parameters:
+//   x0 (uint64_t*) - node: Node with fewer than BTREE_KEYS keys
+//   x1 (uint64_t) - key_index: Where the key goes
+//   x2 (uint64_t) - key: Key
+//   x3 (uint64_t) - slot_index: Where the slot goes
+//   x4 (uint64_t) - slot: Value or child
+//
+// Clobbers: x5-x9
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+btree_place:
+    ldr x5, [x0, #BTREE_META_OFFSET]
+    lsr x6, x5, #BTREE_META_COUNT_SHIFT // Keys before
+    add x9, x5, #(1 << BTREE_META_COUNT_SHIFT)
+    str x9, [x0, #BTREE_META_OFFSET]
+    add x7, x0, #BTREE_KEYS_OFFSET
+    mov x8, x6
+btree_place_keys:
+    cmp x8, x1
+    b.ls btree_place_key
+    sub x8, x8, #1
+    ldr x9, [x7, x8, lsl #3]
+    add x8, x8, #1
+    str x9, [x7, x8, lsl #3]
+    sub x8, x8, #1
+    b btree_place_keys
+
+btree_place_key:
+    str x2, [x7, x1, lsl #3]
+    tbnz x5, #btree_leaf_bit, btree_place_slots
+    add x6, x6, #1                    // Branches have a child more
+btree_place_slots:
+    add x7, x0, #BTREE_SLOTS_OFFSET
+btree_place_slot_loop:
+    cmp x6, x3
+    b.ls btree_place_slot
+    sub x6, x6, #1
+    ldr x9, [x7, x6, lsl #3]
+    add x6, x6, #1
+    str x9, [x7, x6, lsl #3]
+    sub x6, x6, #1
+    b btree_place_slot_loop
+
+btree_place_slot:
+    str x4, [x7, x3, lsl #3]
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Split (internal)
+// ------------------------------------------------------------
+// Insert a key and a slot into a full node, then split the result:
+// the node keeps the first BTREE_SPLIT slots and a new node the rest.
+// A leaf's separator is the new node's first key and stays there; a
+// branch's is the key between the halves and moves up.
+//
+// Parameters:
+//   x0 (uint64_t*) - node: Full node
+//   x1 (uint64_t) - key_index: Where the key goes
+//   x2 (uint64_t) - key: Key
+//   x3 (uint64_t) - slot_index: Where the slot goes
+//   x4 (uint64_t) - slot: Value or child
+//   x5 (uint64_t*) - right: Free node for the upper half
+//
+// Returns:
+//   x0 (uint64_t) - separator: Key for the parent
+//
+// Clobbers: x1-x15
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+btree_split:
+    stp x29, x30, [sp, #-16]!
+    sub sp, sp, #BTREE_NODE_SIZE      // Merged keys, then merged slots
+    mov x12, x0                       // Left
+    mov x13, x5                       // Right
+    ldr x14, [x0, #BTREE_META_OFFSET]
+    and x14, x14, #BTREE_META_LEAF
+    lsr x15, x14, #btree_leaf_bit     // 1 for leaves
+
+    // BTREE_KEYS + 1 keys
+    add x6, x0, #BTREE_KEYS_OFFSET
+    mov x7, sp
+    mov x8, x1
+    BTREE_COPY x7, x6, x8, x9
+    str x2, [x7], #8
+    mov x8, #BTREE_KEYS
+    sub x8, x8, x1
+    BTREE_COPY x7, x6, x8, x9
+
+    // BTREE_KEYS + 1 values, or BTREE_KEYS + 2 children
+    add x6, x0, #BTREE_SLOTS_OFFSET
+    add x7, sp, #BTREE_SLOTS_OFFSET
+    mov x8, x3
+    BTREE_COPY x7, x6, x8, x9
+    str x4, [x7], #8
+    mov x8, #(BTREE_KEYS + 1)
+    sub x8, x8, x15
+    sub x8, x8, x3
+    BTREE_COPY x7, x6, x8, x9
+
+    // Left: BTREE_SPLIT slots, and a key fewer unless a leaf
+    mov x0, x12
+    mov x1, sp
+    add x2, x15, #(BTREE_SPLIT - 1)
+    add x3, sp, #BTREE_SLOTS_OFFSET
+    mov x4, #BTREE_SPLIT
+    mov x5, x14
+    bl btree_fill
+
+    // Right: the keys and slots from BTREE_SPLIT on
+    mov x0, x13
+    add x1, sp, #(BTREE_SPLIT * 8)
+    mov x2, #(BTREE_KEYS + 1 - BTREE_SPLIT)
+    add x3, sp, #(BTREE_SLOTS_OFFSET + BTREE_SPLIT * 8)
+    mov x4, #(BTREE_KEYS + 2 - BTREE_SPLIT)
+    sub x4, x4, x15
+    mov x5, x14
+    bl btree_fill
+
+    add x9, x15, #(BTREE_SPLIT - 1)
+    ldr x0, [sp, x9, lsl #3]
+    add sp, sp, #BTREE_NODE_SIZE
+    ldp x29, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Fill (internal)
+// ------------------------------------------------------------
+// Write a whole node: header, meta, keys then padding, slots then
+// TERM_NIL.
+//
+// Parameters:
+//   x0 (uint64_t*) - node: Node
+//   x1 (const uint64_t*) - keys: Keys
+//   x2 (uint64_t) - key_count: Keys, at most BTREE_KEYS
+//   x3 (const uint64_t*) - slots: Values or children
+//   x4 (uint64_t) - slot_count: Slots, at most BTREE_SLOTS
+//   x5 (uint64_t) - leaf: BTREE_META_LEAF for a leaf, else 0
+//
+// Clobbers: x1-x9
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+btree_fill:
+    mov x6, #btree_header
+    add x6, x6, #TERM_HEADER_BTREE
+    orr x7, x5, x2, lsl #BTREE_META_COUNT_SHIFT
+    stp x6, x7, [x0]
+    add x6, x0, #BTREE_KEYS_OFFSET
+    mov x7, #BTREE_KEYS
+    sub x7, x7, x2
+    BTREE_COPY x6, x1, x2, x8
+    mov x8, #BTREE_KEY_PAD
+btree_fill_keys:
+    cbz x7, btree_fill_slots
+    str x8, [x6], #8
+    sub x7, x7, #1
+    b btree_fill_keys
+
+btree_fill_slots:
+    mov x7, #BTREE_SLOTS
+    sub x7, x7, x4
+    BTREE_COPY x6, x3, x4, x8
+    mov x8, #TERM_NIL
+btree_fill_nil:
+    cbz x7, btree_fill_done
+    str x8, [x6], #8
+    sub x7, x7, #1
+    b btree_fill_nil
+
+btree_fill_done:
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Clone (internal)
+// ------------------------------------------------------------
+// Copy a node, 32 bytes per load and store.
+//
+// Parameters:
+//   x0 (uint64_t*) - destination: Free node
+//   x1 (const uint64_t*) - source: Node
+//
+// Clobbers: v0, v1
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+btree_clone:
+    ldp q0, q1, [x1]
+    stp q0, q1, [x0]
+    ldp q0, q1, [x1, #32]
+    stp q0, q1, [x0, #32]
+    ldp q0, q1, [x1, #64]
+    stp q0, q1, [x0, #64]
+    ldp q0, q1, [x1, #96]
+    stp q0, q1, [x0, #96]
+    ldp q0, q1, [x1, #128]
+    stp q0, q1, [x0, #128]
+    ldp q0, q1, [x1, #160]
+    stp q0, q1, [x0, #160]
+    ldp q0, q1, [x1, #192]
+    stp q0, q1, [x0, #192]
+    ldp q0, q1, [x1, #224]
+    stp q0, q1, [x0, #224]
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Reserve (internal)
+// ------------------------------------------------------------
+// Allocate line-aligned nodes from a PCB heap. Words skipped to reach
+// the line become a tuple of TERM_NIL, so the heap stays walkable.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (uint64_t) - nodes: Nodes to allocate
+//
+// Returns:
+//   x0 (uint64_t*) - node: First node, or NULL if pcb is NULL or the
+//                    heap is full (nothing is written)
+//
+// Clobbers: x1-x7
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+btree_reserve:
+    cbz x0, btree_reserve_failed
+    lsr x2, x1, #(TERM_MAX_WORDS_SHIFT - BTREE_NODE_SHIFT + 3)
+    cbnz x2, btree_reserve_failed
+    ldr x2, [x0, #pcb_heap_pointer]
+    add x3, x2, #(CACHE_LINE_SIZE - 1)
+    and x3, x3, #~(CACHE_LINE_SIZE - 1)
+    ldr x4, [x0, #pcb_heap_limit]
+    add x5, x3, x1, lsl #BTREE_NODE_SHIFT
+    cmp x5, x4
+    b.hi btree_reserve_failed
+    str x5, [x0, #pcb_heap_pointer]
+    subs x6, x3, x2
+    b.eq btree_reserve_done
+    lsr x6, x6, #3
+    sub x6, x6, #1                    // Filler arity
+    lsl x7, x6, #TERM_HEADER_ARITY_SHIFT
+    orr x7, x7, #TERM_HEADER_TUPLE
+    str x7, [x2], #8
+    mov x7, #TERM_NIL
+btree_reserve_filler:
+    cbz x6, btree_reserve_done
+    str x7, [x2], #8
+    sub x6, x6, #1
+    b btree_reserve_filler
+
+btree_reserve_done:
+    mov x0, x3
+    ret
+
+btree_reserve_failed:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Build Nodes (internal)
+// ------------------------------------------------------------
+// Nodes a bulk build of n pairs takes: the fewest leaves that hold
+// them, then the fewest branches over each level.
+//
+// Parameters:
+//   x0 (uint64_t) - count: Pairs
+//
+// Returns:
+//   x0 (uint64_t) - nodes: Nodes in all levels
+//
+// Clobbers: x1-x3
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+btree_build_nodes:
+    add x1, x0, #(BTREE_KEYS - 1)
+    mov x2, #BTREE_KEYS
+    udiv x1, x1, x2                   // Leaves
+    cmp x1, #0
+    csinc x1, x1, xzr, ne             // An empty tree is one leaf
+    mov x0, x1
+    mov x2, #(BTREE_KEYS + 1)
+btree_build_nodes_level:
+    cmp x1, #1
+    b.ls btree_build_nodes_done
+    add x1, x1, #BTREE_KEYS
+    udiv x1, x1, x2
+    add x0, x0, x1
+    b btree_build_nodes_level
+
+btree_build_nodes_done:
+    ret
+
+// ------------------------------------------------------------
+// B+ Tree Build (internal)
+// ------------------------------------------------------------
+// Lay out a tree over sorted pairs: node i of the m nodes of a level
+// takes items i * n / m to (i + 1) * n / m of the n below it, so every
+// node but a lone root is at least half full. Each level's nodes are
+// consecutive, and a branch's separators are the smallest keys of its
+// children past the first.
+//
+// Parameters:
+//   x0 (const uint64_t*) - keys: Keys, or a checked list of {K, V}
+//   x1 (const uint64_t*) - values: Values, or NULL to read the list
+//   x2 (uint64_t) - count: Pairs, at most BTREE_MAX_CAPACITY
+//   x3 (uint64_t*) - next: First of btree_build_nodes free nodes
+//
+// Returns:
+//   x0 (uint64_t*) - root: Root node
+//   x1 (uint64_t*) - next: Past the nodes used
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+btree_build:
+    BTREE_SAVE
+    sub sp, sp, #BTREE_NODE_SIZE      // Gathered keys, then slots
+    mov x19, x0                       // Keys or list
+    mov x20, x1                       // Values
+    mov x21, x2                       // Items in the level below
+    mov x22, x3                       // Next node
+    mov x25, x3                       // First node of the level
+    add x23, x2, #(BTREE_KEYS - 1)
+    mov x9, #BTREE_KEYS
+    udiv x23, x23, x9                 // Nodes in the level
+    cmp x23, #0
+    csinc x23, x23, xzr, ne
+    mov x24, #0                       // Node index
+
+btree_build_leaf:
+    cmp x24, x23
+    b.hs btree_build_branches
+    mul x9, x24, x21
+    udiv x26, x9, x23                 // First item
+    add x24, x24, #1
+    mul x9, x24, x21
+    udiv x27, x9, x23
+    sub x27, x27, x26                 // Items
+    cbz x20, btree_build_leaf_list
+    add x1, x19, x26, lsl #3
+    add x3, x20, x26, lsl #3
+    b btree_build_leaf_fill
+
+btree_build_leaf_list:
+    mov x9, #0
+    add x10, sp, #BTREE_SLOTS_OFFSET
+btree_build_leaf_gather:
+    cmp x9, x27
+    b.hs btree_build_leaf_gathered
+    ldur x11, [x19, #-TERM_TAG_LIST]  // {Key, Value}
+    ldur x12, [x11, #(8 - TERM_TAG_BOXED)]
+    str x12, [sp, x9, lsl #3]
+    ldur x12, [x11, #(16 - TERM_TAG_BOXED)]
+    str x12, [x10, x9, lsl #3]
+    ldur x19, [x19, #(8 - TERM_TAG_LIST)]
+    add x9, x9, #1
+    b btree_build_leaf_gather
+
+btree_build_leaf_gathered:
+    mov x1, sp
+    mov x3, x10
+btree_build_leaf_fill:
+    mov x0, x22
+    mov x2, x27
+    mov x4, x27
+    mov x5, #BTREE_META_LEAF
+    bl btree_fill
+    add x22, x22, #BTREE_NODE_SIZE
+    b btree_build_leaf
+
+    // Levels of branches until one node is left
+btree_build_branches:
+    mov x21, x23
+btree_build_level:
+    cmp x21, #1
+    b.ls btree_build_done
+    add x23, x21, #BTREE_KEYS
+    mov x9, #(BTREE_KEYS + 1)
+    udiv x23, x23, x9
+    mov x28, x22                      // This level's first node
+    mov x24, #0
+
+btree_build_branch:
+    cmp x24, x23
+    b.hs btree_build_level_done
+    mul x9, x24, x21
+    udiv x26, x9, x23                 // First child
+    add x24, x24, #1
+    mul x9, x24, x21
+    udiv x27, x9, x23
+    sub x27, x27, x26                 // Children
+    add x10, x25, x26, lsl #BTREE_NODE_SHIFT
+    mov x9, #0
+btree_build_child:
+    cmp x9, x27
+    b.hs btree_build_branch_fill
+    orr x11, x10, #TERM_TAG_BOXED
+    add x12, sp, #BTREE_SLOTS_OFFSET
+    str x11, [x12, x9, lsl #3]
+    cbz x9, btree_build_child_next
+    mov x11, x10                      // Separator: leftmost leaf's first key
+btree_build_child_min:
+    ldr x12, [x11, #BTREE_META_OFFSET]
+    tbnz x12, #btree_leaf_bit, btree_build_child_key
+    ldr x11, [x11, #BTREE_SLOTS_OFFSET]
+    sub x11, x11, #TERM_TAG_BOXED
+    b btree_build_child_min
+btree_build_child_key:
+    ldr x12, [x11, #BTREE_KEYS_OFFSET]
+    sub x13, x9, #1
+    str x12, [sp, x13, lsl #3]
+btree_build_child_next:
+    add x10, x10, #BTREE_NODE_SIZE
+    add x9, x9, #1
+    b btree_build_child
+
+btree_build_branch_fill:
+    mov x0, x22
+    mov x1, sp
+    sub x2, x27, #1
+    add x3, sp, #BTREE_SLOTS_OFFSET
+    mov x4, x27
+    mov x5, #0
+    bl btree_fill
+    add x22, x22, #BTREE_NODE_SIZE
+    b btree_build_branch
+
+btree_build_level_done:
+    mov x25, x28
+    mov x21, x23
+    b btree_build_level
+
+btree_build_done:
+    mov x0, x25
+    mov x1, x22
+    add sp, sp, #BTREE_NODE_SIZE
+    BTREE_RESTORE
+    ret
+
+// ------------------------------------------------------------
+// Constant Definitions for C Code
+// ------------------------------------------------------------
+    .data
+    .align 3
+
+_BTREE_CURSOR_SIZE_CONST:
+    .quad BTREE_CURSOR_SIZE
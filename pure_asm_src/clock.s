@@ -0,0 +1,325 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// clock.s — Monotonic Clock from the ARM Generic Timer
+// ------------------------------------------------------------
+// Single monotonic time source for the runtime. Reads the virtual
+// counter (CNTVCT_EL0), which is readable from EL0 on both macOS and
+// Linux, and calibrates it against the counter frequency (CNTFRQ_EL0).
+// All timer, timeout and instrumentation code measures time in
+// counter ticks; conversion to nanoseconds uses a multiplier and
+// shift precomputed once at calibration so the hot path is a single
+// 64x64->128 multiply with no division.
+//
+// The calibration lives in a caller-provided clock structure (no
+// globals). Per-scheduler coarse time is cached in the scheduler
+// state by scheduler.s (_scheduler_refresh_now).
+//
+// The file provides:
+//   - Raw counter and frequency reads
+//   - Clock calibration (multiplier/shift computation)
+//   - Tick to nanosecond and nanosecond to tick conversion
+//   - Nanoseconds elapsed since calibration
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// ------------------------------------------------------------
+// Clock Function Exports
+// ------------------------------------------------------------
+// Export the clock functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _clock_read_ticks
+    .global _clock_read_frequency
+    .global _clock_init
+    .global _clock_ticks_to_ns
+    .global _clock_ns_to_ticks
+    .global _clock_now_ns
+    .global _clock_get_frequency
+    .global _CLOCK_SIZE
+    .global _CLOCK_SIZE_CONST
+
+// ------------------------------------------------------------
+// Clock Structure Layout
+// ------------------------------------------------------------
+// Calibration data for one clock instance. ns = (ticks * mult) >> shift
+// and ticks = (ns * ns_mult) >> shift.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ clock_frequency, 0           // Counter frequency in Hz (8 bytes)
+    .equ clock_mult, 8                // Tick->ns multiplier (8 bytes)
+    .equ clock_shift, 16              // Shared shift for both directions (8 bytes)
+    .equ clock_ns_mult, 24            // ns->tick multiplier (8 bytes)
+    .equ clock_epoch, 32              // Counter value at calibration (8 bytes)
+    .equ clock_size, 40               // Total clock structure size
+
+    .equ CLOCK_SHIFT, 32              // Fixed-point fraction bits
+    .equ NS_PER_SECOND, 1000000000
+    .equ CLOCK_FALLBACK_FREQUENCY, 24000000  // Apple Silicon counter rate
+
+// ------------------------------------------------------------
+// Read Counter Ticks
+// ------------------------------------------------------------
+// Read the virtual counter. The isb keeps the read from being
+// speculated ahead of earlier instructions so measured intervals
+// are not shortened.
+//
+// Parameters:
+//   None
+//
+// Returns:
+//   x0 (uint64_t) - ticks: Current CNTVCT_EL0 value
+//
+// Complexity: O(1) - Single system register read
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_clock_read_ticks:
+    isb
+    mrs x0, CNTVCT_EL0
+    ret
+
+// ------------------------------------------------------------
+// Read Counter Frequency
+// ------------------------------------------------------------
+// Read the counter frequency programmed by firmware.
+//
+// Parameters:
+//   None
+//
+// Returns:
+//   x0 (uint64_t) - frequency: CNTFRQ_EL0 value in Hz
+//
+// Complexity: O(1) - Single system register read
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_clock_read_frequency:
+    mrs x0, CNTFRQ_EL0
+    ret
+
+// ------------------------------------------------------------
+// Clock Initialization
+// ------------------------------------------------------------
+// Calibrate a clock structure against CNTFRQ_EL0. Computes the
+// tick->ns and ns->tick multipliers for a fixed 32-bit shift and
+// records the current counter value as the clock epoch. Falls back to
+// the Apple Silicon 24MHz rate if firmware left CNTFRQ_EL0 at zero.
+//
+// Parameters:
+//   x0 (void*) - clock: Pointer to clock structure (clock_size bytes)
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 on failure
+//
+// Complexity: O(1) - Two divisions at calibration time only
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_clock_init:
+    cbz x0, clock_init_failed
+
+    // Read frequency (fall back if firmware did not program it)
+    mrs x1, CNTFRQ_EL0
+    cbnz x1, clock_init_have_frequency
+    movz x1, #(CLOCK_FALLBACK_FREQUENCY & 0xFFFF)
+    movk x1, #(CLOCK_FALLBACK_FREQUENCY >> 16), lsl #16
+
+clock_init_have_frequency:
+    str x1, [x0, #clock_frequency]
+    mov x2, #CLOCK_SHIFT
+    str x2, [x0, #clock_shift]
+
+    // mult = ((NS_PER_SECOND << 32) + frequency / 2) / frequency
+    movz x3, #(NS_PER_SECOND & 0xFFFF)
+    movk x3, #(NS_PER_SECOND >> 16), lsl #16
+    lsl x4, x3, #CLOCK_SHIFT
+    add x4, x4, x1, lsr #1
+    udiv x4, x4, x1
+    str x4, [x0, #clock_mult]
+
+    // ns_mult = ((frequency << 32) + NS_PER_SECOND / 2) / NS_PER_SECOND
+    lsl x4, x1, #CLOCK_SHIFT
+    add x4, x4, x3, lsr #1
+    udiv x4, x4, x3
+    str x4, [x0, #clock_ns_mult]
+
+    // Record epoch
+    isb
+    mrs x4, CNTVCT_EL0
+    str x4, [x0, #clock_epoch]
+
+    mov x0, #1
+    ret
+
+clock_init_failed:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Ticks to Nanoseconds
+// ------------------------------------------------------------
+// Convert a tick count to nanoseconds: (ticks * mult) >> shift,
+// computed on the full 128-bit product so long intervals do not
+// overflow.
+//
+// Parameters:
+//   x0 (void*) - clock: Calibrated clock structure
+//   x1 (uint64_t) - ticks: Tick count to convert
+//
+// Returns:
+//   x0 (uint64_t) - ns: Equivalent nanoseconds
+//
+// Complexity: O(1) - One multiply, no division
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_clock_ticks_to_ns:
+    ldr x2, [x0, #clock_mult]
+    ldr x3, [x0, #clock_shift]
+    mul x4, x1, x2                    // low 64 bits
+    umulh x5, x1, x2                  // high 64 bits
+    lsr x4, x4, x3
+    mov x6, #64
+    sub x6, x6, x3
+    lsl x5, x5, x6
+    orr x0, x4, x5
+    ret
+
+// ------------------------------------------------------------
+// Nanoseconds to Ticks
+// ------------------------------------------------------------
+// Convert nanoseconds to counter ticks: (ns * ns_mult) >> shift.
+// Used to turn user-facing timeouts into wheel deadlines.
+//
+// Parameters:
+//   x0 (void*) - clock: Calibrated clock structure
+//   x1 (uint64_t) - ns: Nanoseconds to convert
+//
+// Returns:
+//   x0 (uint64_t) - ticks: Equivalent tick count
+//
+// Complexity: O(1) - One multiply, no division
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_clock_ns_to_ticks:
+    ldr x2, [x0, #clock_ns_mult]
+    ldr x3, [x0, #clock_shift]
+    mul x4, x1, x2
+    umulh x5, x1, x2
+    lsr x4, x4, x3
+    mov x6, #64
+    sub x6, x6, x3
+    lsl x5, x5, x6
+    orr x0, x4, x5
+    ret
+
+// ------------------------------------------------------------
+// Now in Nanoseconds
+// ------------------------------------------------------------
+// Nanoseconds elapsed since the clock was calibrated.
+//
+// Parameters:
+//   x0 (void*) - clock: Calibrated clock structure
+//
+// Returns:
+//   x0 (uint64_t) - ns: Nanoseconds since clock_init
+//
+// Complexity: O(1) - Counter read plus one multiply
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_clock_now_ns:
+    isb
+    mrs x1, CNTVCT_EL0
+    ldr x2, [x0, #clock_epoch]
+    sub x1, x1, x2
+    b _clock_ticks_to_ns
+
+// ------------------------------------------------------------
+// Get Clock Frequency
+// ------------------------------------------------------------
+// Return the calibrated counter frequency.
+//
+// Parameters:
+//   x0 (void*) - clock: Calibrated clock structure
+//
+// Returns:
+//   x0 (uint64_t) - frequency: Counter frequency in Hz, 0 if clock is NULL
+//
+// Complexity: O(1) - Single load
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_clock_get_frequency:
+    cbz x0, clock_get_frequency_done
+    ldr x0, [x0, #clock_frequency]
+clock_get_frequency_done:
+    ret
+
+// ------------------------------------------------------------
+// Constant Definitions for C Code
+// ------------------------------------------------------------
+    .data
+    .align 3
+
+_CLOCK_SIZE:
+    .quad clock_size
+
+_CLOCK_SIZE_CONST:
+    .quad clock_size
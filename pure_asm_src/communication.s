@@ -62,6 +62,7 @@
 // Last Modified: 2025-01-19
 //
     .global _message_queue_init
+    .global _message_queue_init_buffer
     .global _send_message
     .global _receive_message
     .global _try_receive_message
@@ -70,6 +71,8 @@
     .global _message_queue_full
     .global _wake_receiver
     .global _block_on_receive
+    .global _MSG_QUEUE_SIZE_CONST
+    .global _MSG_SLOT_SIZE_CONST
 
 // ------------------------------------------------------------
 // Message Queue Data Structure Layout
@@ -89,6 +92,7 @@
     .equ msg_queue_mask, 32             // Size mask for circular buffer (8 bytes) - changed from 4 bytes
     .equ msg_queue_blocked, 40          // Blocked receiver flag (8 bytes)
     .equ msg_queue_waiting_process, 48  // Waiting process pointer (8 bytes) - changed from offset 40
+    .equ msg_queue_cas_retries, 56      // Lost slot reservations by senders (8 bytes)
     .equ msg_queue_size_bytes, 64       // Total structure size
 
 // ------------------------------------------------------------
@@ -128,6 +132,7 @@ _message_queue_init:
     // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
 
     // Validate parameters
     cbz x0, init_failed  // Check queue pointer
@@ -156,7 +161,7 @@ _message_queue_init:
     mov x0, xzr        // addr = NULL (let system choose)
     mov x1, x21        // length = size * 24
     mov x2, #3         // prot = PROT_READ | PROT_WRITE
-    mov x3, #0x1002    // flags = MAP_PRIVATE | MAP_ANON (macOS)
+    mov x3, #MMAP_PRIVATE_ANON  // flags = MAP_PRIVATE | MAP_ANON
     mov x4, #-1        // fd = -1 (not a file mapping)
     mov x5, xzr        // offset = 0
     bl _mmap           // Call C library mmap function
@@ -175,6 +180,7 @@ _message_queue_init:
     str x21, [x19, #msg_queue_mask]        // mask = size - 1 (64-bit)
     str xzr, [x19, #msg_queue_blocked]     // blocked = 0
     str xzr, [x19, #msg_queue_waiting_process] // waiting_process = NULL
+    str xzr, [x19, #msg_queue_cas_retries]     // cas_retries = 0
 
     // Clear the message array
     mov x21, x20        // Number of elements to clear
@@ -188,141 +194,169 @@ clear_array_loop:
 
     // Return success
     mov x0, #1
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
 init_failed:
     mov x0, #0
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
+// ------------------------------------------------------------
+// Message Queue Initialization Over a Caller Buffer
+// ------------------------------------------------------------
+// Initialize a message queue whose message array lives in storage
+// supplied by the caller (size * 24 bytes, 8-byte aligned) instead of
+// a private mmap. Lets callers that create many small mailboxes carve
+// them from one pooled allocation. The data word of every slot is
+// cleared, since a zero data word marks a slot as free.
+//
+// Parameters:
+//   x0 (void*) - queue_ptr: Pointer to queue structure
+//   x1 (uint32_t) - size: Maximum number of messages in queue
+//   x2 (void*) - buffer: Message array storage (size * 24 bytes)
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 on failure
+//
+// Complexity: O(n) where n is size (slot clearing)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_message_queue_init_buffer:
+    // Validate parameters
+    cbz x0, init_buffer_failed  // Check queue pointer
+    cbz x2, init_buffer_failed  // Check buffer
+
+    // Validate size is a power of 2 between 2 and 1024
+    mov w1, w1
+    sub x3, x1, #1
+    tst x1, x3
+    b.ne init_buffer_failed
+    cmp x1, #2
+    b.lt init_buffer_failed
+    cmp x1, #1024
+    b.gt init_buffer_failed
+
+    // Initialize queue structure
+    str xzr, [x0, #msg_queue_head]
+    str xzr, [x0, #msg_queue_tail]
+    str x2, [x0, #msg_queue_messages]
+    str x1, [x0, #msg_queue_size]
+    str x3, [x0, #msg_queue_mask]
+    str xzr, [x0, #msg_queue_blocked]
+    str xzr, [x0, #msg_queue_waiting_process]
+    str xzr, [x0, #msg_queue_cas_retries]
+
+    // Clear every slot's data word
+    add x4, x2, #msg_data
+init_buffer_clear:
+    str xzr, [x4], #msg_size
+    subs x1, x1, #1
+    b.ne init_buffer_clear
+
+    mov x0, #1
+    ret
+
+init_buffer_failed:
+    mov x0, #0
+    ret
+
 // ------------------------------------------------------------
 // Send Message
 // ------------------------------------------------------------
 // Send a message to a receiver's message queue.
 // This is a non-blocking operation that may fail if the queue is full.
+// Safe for any number of concurrent senders. A sender reserves a slot
+// by advancing tail with an exclusive store, fills it, and publishes
+// it with a release store of the data word; the receiver treats a zero
+// data word as "not yet written". Message data 0 is therefore reserved
+// (it is also what the receive calls return for "no message"). Lost
+// reservations are counted in cas_retries.
 //
 // Parameters:
 //   x0 (void*) - sender_pcb: Sender process pointer
 //   x1 (void*) - receiver_pcb: Receiver process pointer
-//   x2 (uint64_t) - message_data: Message data to send
+//   x2 (uint64_t) - message_data: Message data to send (non-zero)
 //
 // Returns:
 //   x0 (int) - success: 1 on success, 0 on failure
 //
-// Complexity: O(1) - Constant time operation
+// Complexity: O(1) - Constant time operation, retries only under contention
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 _send_message:
-    // Save callee-saved registers (save ALL registers we use)
-    stp x19, x30, [sp, #-16]!
-    stp x20, x21, [sp, #-16]!
-    stp x22, x23, [sp, #-16]!
-    stp x24, x25, [sp, #-16]!
-    stp x26, x27, [sp, #-16]!
-    
-    // Add stack guard to detect overflow (use smaller constant)
-    mov x27, #0x123
-    stp x27, x27, [sp, #-16]!
-
     // Validate parameters
     cbz x0, send_failed  // Check sender PCB
     cbz x1, send_failed  // Check receiver PCB
-
-    // Save parameters
-    mov x19, x0  // sender_pcb
-    mov x20, x1  // receiver_pcb
-    mov x21, x2  // message_data
+    cbz x2, send_failed  // 0 means "no message" to the receiver
 
     // Get receiver's message queue (at offset 368 in real PCB)
-    ldr x22, [x20, #368]  // receiver's message queue
-    cbz x22, send_failed  // Check if queue exists
-
-    // Check if queue is full
-    mov x0, x22  // Pass queue pointer to _message_queue_full
-    bl _message_queue_full
-    cbnz x0, send_failed  // If FULL, go to send_failed (FIXED!)
-
-    // Get current tail pointer
-    ldr x23, [x22, #msg_queue_tail]
-    
-    // Get message array pointer
-    ldr x24, [x22, #msg_queue_messages]
-    cbz x24, send_failed  // Check if array is allocated
-
-    // Calculate index with mask
-    ldr x25, [x22, #msg_queue_mask]  // Load 64-bit mask field
-    and x26, x23, x25  // index = tail & mask
-
-    // Store message in array (24 bytes per message)
-    mov x27, #24                 // Message size = 24 bytes
-    mul x27, x26, x27           // x27 = index * 24
-    add x27, x24, x27           // x27 = array + (index * 24)
-    str x19, [x27, #0]          // messages[index].sender = sender_pcb
-    str x21, [x27, #8]          // messages[index].data = message_data
-    str xzr, [x27, #16]         // messages[index].timestamp = 0 (simplified)
-
-    // Memory barrier to ensure store is visible
-    dmb sy
-
-    // Update tail pointer (increment actual pointer, not masked)
-    add x23, x23, #1
-    str x23, [x22, #msg_queue_tail]
-
-    // Wake up blocked receiver if any
-    ldr x27, [x22, #msg_queue_blocked]
-    cbz x27, send_done  // No blocked receiver
-
-    // Wake up the receiver (simplified - just clear blocked flag)
-    str xzr, [x22, #msg_queue_blocked]
-    str xzr, [x22, #msg_queue_waiting_process]
+    ldr x3, [x1, #368]
+    cbz x3, send_failed
+    ldr x4, [x3, #msg_queue_messages]
+    cbz x4, send_failed
+    ldr x5, [x3, #msg_queue_size]
+    add x6, x3, #msg_queue_tail
+    add x7, x3, #msg_queue_head
+
+send_reserve:
+    // Reserve slot tail, unless the queue is full
+    ldar x9, [x7]
+    ldaxr x8, [x6]
+    sub x10, x8, x9
+    cmp x10, x5
+    b.hs send_full
+    add x10, x8, #1
+    stxr w11, x10, [x6]
+    cbz w11, send_reserved
+
+    // Another sender won the slot (or the store failed spuriously)
+    add x12, x3, #msg_queue_cas_retries
+send_count_retry:
+    ldxr x13, [x12]
+    add x13, x13, #1
+    stxr w14, x13, [x12]
+    cbnz w14, send_count_retry
+    b send_reserve
+
+send_reserved:
+    // Fill the slot, then publish it through the data word
+    ldr x10, [x3, #msg_queue_mask]
+    and x10, x8, x10
+    mov x11, #msg_size
+    madd x10, x10, x11, x4           // x10 = &messages[tail & mask]
+    str x0, [x10, #msg_sender]
+    str xzr, [x10, #msg_timestamp]
+    add x11, x10, #msg_data
+    stlr x2, [x11]
+
+    // Wake up blocked receiver if any. The fence pairs with the one in
+    // _receive_message so either the receiver sees this message or this
+    // sender sees the receiver's blocked flag.
+    dmb ish
+    ldr x11, [x3, #msg_queue_blocked]
+    cbz x11, send_done
+    str xzr, [x3, #msg_queue_blocked]
+    str xzr, [x3, #msg_queue_waiting_process]
 
 send_done:
-    // Check stack guard before return
-    ldp x27, x28, [sp], #16
-    cmp x27, #0x123
-    b.ne stack_corruption_detected_send
-    cmp x28, #0x123
-    b.ne stack_corruption_detected_send
-    
-    // Return success
     mov x0, #1
-    ldp x26, x27, [sp], #16
-    ldp x24, x25, [sp], #16
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
     ret
 
+send_full:
+    clrex
 send_failed:
-    // Check stack guard before return
-    ldp x27, x28, [sp], #16
-    cmp x27, #0x123
-    b.ne stack_corruption_detected_send
-    cmp x28, #0x123
-    b.ne stack_corruption_detected_send
-    
-    mov x0, #0
-    ldp x26, x27, [sp], #16
-    ldp x24, x25, [sp], #16
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
-    ret
-
-stack_corruption_detected_send:
-    // Stack corruption detected - return error
     mov x0, #0
-    ldp x26, x27, [sp], #16
-    ldp x24, x25, [sp], #16
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
     ret
 
 // ------------------------------------------------------------
@@ -330,6 +364,9 @@ stack_corruption_detected_send:
 // ------------------------------------------------------------
 // Receive a message from the process's message queue.
 // This is a blocking operation that will wait if no messages are available.
+// Only the owning process may receive. When the queue is empty the
+// blocked flag is raised, fenced, and the head slot checked once more
+// so a message published concurrently is not missed.
 //
 // Parameters:
 //   x0 (void*) - receiver_pcb: Receiver process pointer
@@ -339,65 +376,37 @@ stack_corruption_detected_send:
 //
 // Complexity: O(1) - Constant time operation
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 _receive_message:
-    // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
 
     // Validate parameters
     cbz x0, receive_failed  // Check receiver PCB
-
-    // Save parameters
-    mov x19, x0  // receiver_pcb
-
-    // Get receiver's message queue (at offset 368 in real PCB)
+    mov x19, x0
     ldr x20, [x19, #368]  // receiver's message queue
-    cbz x20, receive_failed  // Check if queue exists
+    cbz x20, receive_failed
 
-    // Check if queue is empty
-    mov x0, x20  // Pass queue pointer to _message_queue_empty
-    bl _message_queue_empty
-    cbnz x0, receive_blocked  // Queue is empty, block
-
-    // Get current head pointer
-    ldr x21, [x20, #msg_queue_head]
-    
-    // Get message array pointer
-    ldr x22, [x20, #msg_queue_messages]
-    cbz x22, receive_failed  // Check if array is allocated
-
-    // Calculate index with mask
-    ldr x23, [x20, #msg_queue_mask]  // Load 64-bit mask field
-    and x24, x21, x23  // index = head & mask
-
-    // Load message from array (24 bytes per message)
-    mov x25, #24                 // Message size = 24 bytes
-    mul x25, x24, x25           // x25 = index * 24
-    add x25, x22, x25           // x25 = array + (index * 24)
-    ldr x26, [x25, #8]         // message_data = messages[index].data
-
-    // Update head pointer (increment actual pointer, not masked)
-    add x21, x21, #1
-    str x21, [x20, #msg_queue_head]
-
-    // Return message data
-    mov x0, x26
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
-    ret
+    bl _try_receive_message
+    cbnz x0, receive_done
 
-receive_blocked:
-    // Block the receiver
+    // Empty: announce we are blocking, then look again
     mov x1, #1
     str x1, [x20, #msg_queue_blocked]
     str x19, [x20, #msg_queue_waiting_process]
-    
-    // Return 0 to indicate blocking
-    mov x0, #0
+    dmb ish
+    mov x0, x19
+    bl _try_receive_message
+    cbz x0, receive_done
+
+    // A sender raced us; stay runnable
+    str xzr, [x20, #msg_queue_blocked]
+    str xzr, [x20, #msg_queue_waiting_process]
+
+receive_done:
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
@@ -413,6 +422,10 @@ receive_failed:
 // ------------------------------------------------------------
 // Try to receive a message from the process's message queue.
 // This is a non-blocking operation that returns immediately.
+// Only the owning process may receive. The head slot's data word is
+// read with acquire; zero means empty or still being written by a
+// sender that has reserved it. The slot is cleared before head is
+// released, so a sender that wraps onto it sees it free.
 //
 // Parameters:
 //   x0 (void*) - receiver_pcb: Receiver process pointer
@@ -422,115 +435,41 @@ receive_failed:
 //
 // Complexity: O(1) - Constant time operation
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
+//
+// Clobbers: x1, x2, x3, x4, x5
 //
 _try_receive_message:
-    // Save callee-saved registers (save ALL registers we use)
-    stp x19, x30, [sp, #-16]!
-    stp x20, x21, [sp, #-16]!
-    stp x22, x23, [sp, #-16]!
-    stp x24, x25, [sp, #-16]!
-    stp x26, x27, [sp, #-16]!
-    
-    // Add stack guard to detect overflow (use smaller constant)
-    mov x27, #0x123
-    stp x27, x27, [sp, #-16]!
-
     // Validate parameters
-    cbz x0, try_receive_failed  // Check receiver PCB
-
-    // Save parameters
-    mov x19, x0  // receiver_pcb
-
-    // Get receiver's message queue (at offset 368 in real PCB)
-    ldr x20, [x19, #368]  // receiver's message queue
-    cbz x20, try_receive_failed  // Check if queue exists
-
-    // Check if queue is empty
-    mov x0, x20  // Pass queue pointer to _message_queue_empty
-    bl _message_queue_empty
-    cbnz x0, try_receive_empty  // Queue is empty
-
-    // Get current head pointer
-    ldr x21, [x20, #msg_queue_head]
-    
-    // Get message array pointer
-    ldr x22, [x20, #msg_queue_messages]
-    cbz x22, try_receive_failed  // Check if array is allocated
-
-    // Calculate index with mask
-    ldr x23, [x20, #msg_queue_mask]  // Load 64-bit mask field
-    and x24, x21, x23  // index = head & mask
-
-    // Load message from array (24 bytes per message)
-    mov x25, #24                 // Message size = 24 bytes
-    mul x25, x24, x25           // x25 = index * 24
-    add x25, x22, x25           // x25 = array + (index * 24)
-    ldr x26, [x25, #8]         // message_data = messages[index].data
-
-    // Update head pointer (increment actual pointer, not masked)
-    add x21, x21, #1
-    str x21, [x20, #msg_queue_head]
-
-    // Check stack guard before return
-    ldp x27, x28, [sp], #16
-    cmp x27, #0x123
-    b.ne stack_corruption_detected
-    cmp x28, #0x123
-    b.ne stack_corruption_detected
-
-    // Return message data
-    mov x0, x26
-    ldp x26, x27, [sp], #16
-    ldp x24, x25, [sp], #16
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
+    cbz x0, try_receive_done  // Check receiver PCB
+    ldr x1, [x0, #368]        // receiver's message queue
+    cbz x1, try_receive_empty
+    ldr x2, [x1, #msg_queue_messages]
+    cbz x2, try_receive_empty
+
+    // Locate the head slot (head is consumer-private)
+    ldr x3, [x1, #msg_queue_head]
+    ldr x4, [x1, #msg_queue_mask]
+    and x4, x3, x4
+    mov x5, #msg_size
+    madd x4, x4, x5, x2
+    add x4, x4, #msg_data
+    ldar x0, [x4]
+    cbz x0, try_receive_done    // Empty, or reserved but not yet published
+
+    // Free the slot, then release head
+    str xzr, [x4]
+    add x3, x3, #1
+    add x5, x1, #msg_queue_head
+    stlr x3, [x5]
+
+try_receive_done:
     ret
 
 try_receive_empty:
-    // Check stack guard before return
-    ldp x27, x28, [sp], #16
-    cmp x27, #0x123
-    b.ne stack_corruption_detected
-    cmp x28, #0x123
-    b.ne stack_corruption_detected
-    
-    // Queue is empty, return 0
-    mov x0, #0
-    ldp x26, x27, [sp], #16
-    ldp x24, x25, [sp], #16
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
-    ret
-
-try_receive_failed:
-    // Check stack guard before return
-    ldp x27, x28, [sp], #16
-    cmp x27, #0x123
-    b.ne stack_corruption_detected
-    cmp x28, #0x123
-    b.ne stack_corruption_detected
-    
     mov x0, #0
-    ldp x26, x27, [sp], #16
-    ldp x24, x25, [sp], #16
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
-    ret
-
-stack_corruption_detected:
-    // Stack corruption detected - return error
-    mov x0, #0
-    ldp x26, x27, [sp], #16
-    ldp x24, x25, [sp], #16
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
     ret
 
 // ------------------------------------------------------------
@@ -727,3 +666,15 @@ block_failed:
 
 // Import required functions from other modules
     .extern _mmap
+
+// ------------------------------------------------------------
+// Constant Definitions for C Code
+// ------------------------------------------------------------
+    .data
+    .align 3
+
+_MSG_QUEUE_SIZE_CONST:
+    .quad msg_queue_size_bytes
+
+_MSG_SLOT_SIZE_CONST:
+    .quad msg_size
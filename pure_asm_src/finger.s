@@ -0,0 +1,2069 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// ------------------------------------------------------------
+// finger.s — Finger Trees and Chunked Deques
+// ------------------------------------------------------------
+// Sequences for work queues and event buffers, in two forms.
+//
+// Finger trees are persistent 2-3 finger trees (Hinze and Paterson)
+// on a process heap, annotated with their size. A tree is [] (empty),
+// a single element, or a deep tree: a prefix and a suffix digit of one
+// to four elements around a middle tree whose elements are nodes of
+// two or three elements from the level above. Every object is a boxed
+// TERM_KIND_FINGER term whose first body word is a small integer meta
+//
+//   measure << 16 | suffix << 12 | prefix << 8 | shape << 3
+//
+// followed by its elements (a deep tree: the middle, then the prefix
+// and suffix elements). The measure counts the elements below, so
+// indexing and splitting descend by size in O(log n). Pushing and
+// popping at either end touch only the digits except when one is full
+// or empty, which is O(1) amortized; concatenation merges the two
+// spines in O(log min(m, n)). Updates copy what they change and share
+// the rest with the previous version, which stays valid.
+//
+// An update may allocate several objects. It marks the heap pointer on
+// entry; a full heap resets it to the mark and unwinds to the entry, so
+// a failed update leaves neither a partial tree nor used heap words.
+//
+// Chunked deques are the fast path for a process's own queues. A deque
+// is a mutable TERM_KIND_DEQUE object over a ring of DEQUE_CHUNK_SLOTS
+// element chunks: pushes and pops at either end store into a chunk in
+// place and allocate only when the ring needs a new chunk, and the last
+// chunk to empty is kept as a spare for the next, so a queue that holds
+// a steady backlog allocates nothing. A full ring doubles its chunk
+// directory without moving elements. A deque is not persistent: it
+// belongs to one process and is changed in place.
+//
+// Both forms are ordinary boxed terms whose bodies are plain terms, so
+// term.s sizes, copies, compares and walks them like tuples.
+//
+// The file provides:
+//   - Finger trees: push and pop at both ends, concatenate, split,
+//     index and size
+//   - Chunked deques: new, push and pop at both ends, index and size
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// Include the PCB layout
+    .include "pcb.inc"
+
+// ------------------------------------------------------------
+// Finger Tree Function Exports
+// ------------------------------------------------------------
+// Export the finger tree and deque functions to make them callable
+// from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _finger_push_front
+    .global _finger_push_back
+    .global _finger_pop_front
+    .global _finger_pop_back
+    .global _finger_concat
+    .global _finger_split
+    .global _finger_index
+    .global _finger_size
+    .global _deque_new
+    .global _deque_push_front
+    .global _deque_push_back
+    .global _deque_pop_front
+    .global _deque_pop_back
+    .global _deque_index
+    .global _deque_size
+
+    // Finger tree objects (untagged offsets)
+    .equ finger_meta, 8               // Meta word
+    .equ finger_elements, 16          // Single or node: the elements
+    .equ finger_middle, 16            // Deep: the middle tree
+    .equ finger_digits, 24            // Deep: prefix, then suffix
+    .equ finger_suffix_full, (finger_digits + FINGER_MAX_DIGIT * 8)
+
+    // Update frame below the saved registers: the heap mark, then the
+    // public function's out-parameter
+    .equ finger_frame_mark, 0
+    .equ finger_frame_out, 8
+
+    // Deque object (untagged offsets), body words are terms
+    .equ deque_count, 8               // Elements, a small integer
+    .equ deque_head, 16               // Ring position of the first, a small integer
+    .equ deque_directory, 24          // Tuple of chunks ([] where unused)
+    .equ deque_spare, 32              // Emptied chunk kept for reuse, or []
+    .equ deque_words, 5               // Header and body
+    .equ deque_header, ((4 << TERM_HEADER_ARITY_SHIFT) | TERM_HEADER_DEQUE)
+    .equ deque_chunk_header, ((DEQUE_CHUNK_SLOTS << TERM_HEADER_ARITY_SHIFT) | TERM_HEADER_TUPLE)
+    .equ deque_slot_mask, (DEQUE_CHUNK_SLOTS - 1)
+
+// ------------------------------------------------------------
+// Macros
+// ------------------------------------------------------------
+
+// Save and restore the callee-saved registers the updates use
+.macro FINGER_SAVE
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    stp x26, x27, [sp, #-16]!
+    stp x28, x29, [sp, #-16]!
+.endm
+
+.macro FINGER_RESTORE
+    ldp x28, x29, [sp], #16
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+.endm
+
+// Begin an update on the heap of the PCB in x0: mark the heap and keep
+// the PCB in x27 and the update frame in x28 until finger_leave. The
+// routines below the entry never change x27 or x28. Clobbers x9.
+.macro FINGER_ENTER
+    FINGER_SAVE
+    ldr x9, [x0, #pcb_heap_pointer]
+    stp x9, xzr, [sp, #-16]!
+    mov x28, sp
+    mov x27, x0
+.endm
+
+// Branch to \fail unless \term is [] or a finger tree
+.macro FINGER_CHECK term, scratch, fail
+    cmp \term, #TERM_NIL
+    b.eq 7f
+    tbz \term, #TERM_BIT_BOXED, \fail
+    ldur \scratch, [\term, #-TERM_TAG_BOXED]
+    and \scratch, \scratch, #0xFF
+    cmp \scratch, #TERM_HEADER_FINGER
+    b.ne \fail
+    ldur \scratch, [\term, #(finger_meta - TERM_TAG_BOXED)]
+    ubfx \scratch, \scratch, #FINGER_SHAPE_SHIFT, #FINGER_SHAPE_WIDTH
+    cmp \scratch, #FINGER_SHAPE_NODE
+    b.eq \fail
+7:
+.endm
+
+// \dst = elements under the element \x of a tree at depth \depth: 1
+// for the caller's own elements (depth 0), a node's measure below
+.macro FINGER_MEASURE dst, x, depth
+    mov \dst, #1
+    cbz \depth, 8f
+    ldur \dst, [\x, #(finger_meta - TERM_TAG_BOXED)]
+    lsr \dst, \dst, #FINGER_MEASURE_SHIFT
+8:
+.endm
+
+// \dst = elements in the tree \tree, which may be []
+.macro FINGER_SIZE dst, tree
+    mov \dst, #0
+    cmp \tree, #TERM_NIL
+    b.eq 9f
+    ldur \dst, [\tree, #(finger_meta - TERM_TAG_BOXED)]
+    lsr \dst, \dst, #FINGER_MEASURE_SHIFT
+9:
+.endm
+
+// Copy \count words from \src to \dst, advancing both; \count ends 0
+.macro FINGER_COPY dst, src, count, scratch
+    cbz \count, 6f
+5:
+    ldr \scratch, [\src], #8
+    str \scratch, [\dst], #8
+    subs \count, \count, #1
+    b.ne 5b
+6:
+.endm
+
+// Branch to \fail unless \term is a deque
+.macro DEQUE_CHECK term, scratch, fail
+    tbz \term, #TERM_BIT_BOXED, \fail
+    ldur \scratch, [\term, #-TERM_TAG_BOXED]
+    and \scratch, \scratch, #0xFF
+    cmp \scratch, #TERM_HEADER_DEQUE
+    b.ne \fail
+.endm
+
+// Load the deque \deque: x9 = deque, x10 = count, x11 = head position,
+// x12 = chunk directory, x13 = ring mask (ring slots - 1), untagged
+.macro DEQUE_LOAD deque
+    sub x9, \deque, #TERM_TAG_BOXED
+    ldp x10, x11, [x9, #deque_count]
+    lsr x10, x10, #TERM_INT_SHIFT
+    lsr x11, x11, #TERM_INT_SHIFT
+    ldr x12, [x9, #deque_directory]
+    sub x12, x12, #TERM_TAG_BOXED
+    ldr x13, [x12]
+    lsr x13, x13, #TERM_HEADER_ARITY_SHIFT
+    lsl x13, x13, #DEQUE_CHUNK_SHIFT
+    sub x13, x13, #1
+.endm
+
+// Drop chunk \index from the directory \dir of the deque \deque (both
+// untagged), keeping it as the spare if there is none. Its slots are
+// all [] already. Clobbers x1-x3.
+.macro DEQUE_RELEASE deque, dir, index
+    add x1, \dir, #8
+    ldr x2, [x1, \index, lsl #3]
+    mov x3, #TERM_NIL
+    str x3, [x1, \index, lsl #3]
+    ldr x1, [\deque, #deque_spare]
+    cmp x1, #TERM_NIL
+    b.ne 4f
+    str x2, [\deque, #deque_spare]
+4:
+.endm
+
+// ------------------------------------------------------------
+// Finger Tree Push Front
+// ------------------------------------------------------------
+// A new version of a tree with an element added before its first.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - tree: Finger tree or []
+//   x2 (term_t) - element: Any term but TERM_NONE
+//
+// Returns:
+//   x0 (term_t) - tree: Updated tree, or TERM_NONE if the heap is full
+//                 or an argument is invalid
+//
+// Complexity: O(1) amortized, O(log n) worst case
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_finger_push_front:
+    cbz x0, finger_invalid
+    cmp x2, #TERM_NONE
+    b.eq finger_invalid
+    FINGER_CHECK x1, x9, finger_invalid
+    FINGER_ENTER
+    mov x0, x1
+    mov x1, x2
+    mov x2, #0
+    bl finger_cons
+    b finger_leave
+
+// ------------------------------------------------------------
+// Finger Tree Push Back
+// ------------------------------------------------------------
+// A new version of a tree with an element added after its last.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - tree: Finger tree or []
+//   x2 (term_t) - element: Any term but TERM_NONE
+//
+// Returns:
+//   x0 (term_t) - tree: Updated tree, or TERM_NONE if the heap is full
+//                 or an argument is invalid
+//
+// Complexity: O(1) amortized, O(log n) worst case
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_finger_push_back:
+    cbz x0, finger_invalid
+    cmp x2, #TERM_NONE
+    b.eq finger_invalid
+    FINGER_CHECK x1, x9, finger_invalid
+    FINGER_ENTER
+    mov x0, x1
+    mov x1, x2
+    mov x2, #0
+    bl finger_snoc
+    b finger_leave
+
+// ------------------------------------------------------------
+// Finger Tree Pop Front
+// ------------------------------------------------------------
+// Take the first element of a tree. The tree is not changed; the rest
+// is a new version without the element.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - tree: Finger tree or []
+//   x2 (term_t*) - rest_out: Receives the rest of the tree (may be NULL)
+//
+// Returns:
+//   x0 (term_t) - element: First element, or TERM_NONE if the tree is
+//                 empty, the heap is full or an argument is invalid
+//
+// Complexity: O(1) amortized, O(log n) worst case
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_finger_pop_front:
+    cbz x0, finger_invalid
+    cmp x1, #TERM_NIL
+    b.eq finger_invalid
+    FINGER_CHECK x1, x9, finger_invalid
+    FINGER_ENTER
+    str x2, [x28, #finger_frame_out]
+    mov x0, x1
+    mov x1, #0
+    bl finger_uncons
+    b finger_leave_pair
+
+// ------------------------------------------------------------
+// Finger Tree Pop Back
+// ------------------------------------------------------------
+// Take the last element of a tree. The tree is not changed; the rest
+// is a new version without the element.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - tree: Finger tree or []
+//   x2 (term_t*) - rest_out: Receives the rest of the tree (may be NULL)
+//
+// Returns:
+//   x0 (term_t) - element: Last element, or TERM_NONE if the tree is
+//                 empty, the heap is full or an argument is invalid
+//
+// Complexity: O(1) amortized, O(log n) worst case
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_finger_pop_back:
+    cbz x0, finger_invalid
+    cmp x1, #TERM_NIL
+    b.eq finger_invalid
+    FINGER_CHECK x1, x9, finger_invalid
+    FINGER_ENTER
+    str x2, [x28, #finger_frame_out]
+    mov x0, x1
+    mov x1, #0
+    bl finger_unsnoc
+    b finger_leave_pair
+
+// ------------------------------------------------------------
+// Finger Tree Concat
+// ------------------------------------------------------------
+// A tree of the elements of left followed by those of right. Both are
+// shared, not changed: only the spines where they meet are rebuilt.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - left: Finger tree or []
+//   x2 (term_t) - right: Finger tree or []
+//
+// Returns:
+//   x0 (term_t) - tree: Joined tree, or TERM_NONE if the heap is full
+//                 or an argument is invalid
+//
+// Complexity: O(log min(m, n))
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_finger_concat:
+    cbz x0, finger_invalid
+    FINGER_CHECK x1, x9, finger_invalid
+    FINGER_CHECK x2, x9, finger_invalid
+    FINGER_ENTER
+    mov x0, x1
+    mov x1, x2
+    mov x2, #0                        // No elements between
+    mov x3, #0
+    mov x4, #0
+    bl finger_app3
+    b finger_leave
+
+// ------------------------------------------------------------
+// Finger Tree Split
+// ------------------------------------------------------------
+// Split a tree before an index: the left part holds the elements below
+// it and the right part the rest. An index at or past the size leaves
+// the right part []. The tree is not changed.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - tree: Finger tree or []
+//   x2 (uint64_t) - index: Elements to keep on the left
+//   x3 (term_t*) - right_out: Receives the right part (may be NULL)
+//
+// Returns:
+//   x0 (term_t) - left: Left part, or TERM_NONE if the heap is full or
+//                 an argument is invalid
+//
+// Complexity: O(log min(i, n - i))
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_finger_split:
+    cbz x0, finger_invalid
+    FINGER_CHECK x1, x9, finger_invalid
+    FINGER_SIZE x10, x1
+    cmp x2, x10
+    b.hs finger_split_whole
+    cbz x2, finger_split_none
+    FINGER_ENTER
+    str x3, [x28, #finger_frame_out]
+    mov x0, x1
+    mov x1, x2
+    mov x2, #0
+    bl finger_split_tree
+    mov x19, x0                       // Left
+    mov x0, x2
+    mov x2, #0
+    bl finger_cons                    // Right, from the element split at
+    mov x1, x0
+    mov x0, x19
+    b finger_leave_pair
+
+finger_split_whole:
+    cbz x3, finger_split_whole_done
+    mov x9, #TERM_NIL
+    str x9, [x3]
+finger_split_whole_done:
+    mov x0, x1
+    ret
+
+finger_split_none:
+    cbz x3, finger_split_none_done
+    str x1, [x3]
+finger_split_none_done:
+    mov x0, #TERM_NIL
+    ret
+
+// Shared tails of the updates: finger_leave returns x0 from an update;
+// finger_leave_pair also stores x1 through the frame's out-parameter.
+// finger_fail runs when the heap is full, from any depth: it drops the
+// frames below the entry, resets the heap to its mark and returns
+// TERM_NONE without storing anything.
+finger_leave_pair:
+    ldr x9, [x28, #finger_frame_out]
+    cbz x9, finger_leave
+    str x1, [x9]
+finger_leave:
+    add sp, sp, #16
+    FINGER_RESTORE
+    ret
+
+finger_fail:
+    mov sp, x28
+    ldr x9, [sp, #finger_frame_mark]
+    str x9, [x27, #pcb_heap_pointer]
+    mov x0, #TERM_NONE
+    b finger_leave
+
+finger_invalid:
+    mov x0, #TERM_NONE
+    ret
+
+// ------------------------------------------------------------
+// Finger Tree Index
+// ------------------------------------------------------------
+// The element at an index, found by descending on the measures: the
+// digits of each level are scanned, then the middle, then the nodes
+// down to the element. Nothing is allocated.
+//
+// Parameters:
+//   x0 (term_t) - tree: Finger tree or []
+//   x1 (uint64_t) - index: Position from the front
+//
+// Returns:
+//   x0 (term_t) - element: The element, or TERM_NONE if index is out of
+//                 range or tree is not a finger tree
+//
+// Complexity: O(log min(i, n - i))
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_finger_index:
+    FINGER_CHECK x0, x9, finger_invalid
+    FINGER_SIZE x9, x0
+    cmp x1, x9
+    b.hs finger_invalid               // Also catches []
+    str x30, [sp, #-16]!
+    mov x4, x0                        // Tree
+    mov x3, x1                        // Index within it
+    mov x5, #0                        // Depth
+finger_index_tree:
+    sub x6, x4, #TERM_TAG_BOXED
+    ldr x7, [x6, #finger_meta]
+    ubfx x8, x7, #FINGER_SHAPE_SHIFT, #FINGER_SHAPE_WIDTH
+    cmp x8, #FINGER_SHAPE_SINGLE
+    b.ne finger_index_deep
+    ldr x4, [x6, #finger_elements]
+    b finger_index_element
+
+finger_index_deep:
+    add x12, x6, #finger_digits       // Prefix
+    mov x0, x12
+    ubfx x1, x7, #FINGER_PREFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    mov x2, x5
+    bl finger_scan
+    cmp x0, x1
+    b.lo finger_index_digit
+    add x12, x12, x1, lsl #3          // Suffix
+    ldr x8, [x6, #finger_middle]
+    FINGER_SIZE x9, x8
+    cmp x3, x9
+    b.hs finger_index_suffix
+    mov x4, x8                        // Down into the middle
+    add x5, x5, #1
+    b finger_index_tree
+
+finger_index_suffix:
+    sub x3, x3, x9
+    mov x0, x12
+    ubfx x1, x7, #FINGER_SUFFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    mov x2, x5
+    bl finger_scan
+finger_index_digit:
+    ldr x4, [x12, x0, lsl #3]
+
+    // x4 is an element at depth x5: descend its nodes
+finger_index_element:
+    cbz x5, finger_index_done
+    sub x6, x4, #TERM_TAG_BOXED
+    ldr x1, [x6]
+    lsr x1, x1, #TERM_HEADER_ARITY_SHIFT
+    sub x1, x1, #1                    // Children
+    add x12, x6, #finger_elements
+    mov x0, x12
+    sub x5, x5, #1
+    mov x2, x5
+    bl finger_scan
+    ldr x4, [x12, x0, lsl #3]
+    b finger_index_element
+
+finger_index_done:
+    mov x0, x4
+    ldr x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Tree Size
+// ------------------------------------------------------------
+// The number of elements in a tree, read from its measure.
+//
+// Parameters:
+//   x0 (term_t) - tree: Finger tree or []
+//
+// Returns:
+//   x0 (uint64_t) - size: Elements, or 0 if tree is not a finger tree
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_finger_size:
+    FINGER_CHECK x0, x9, finger_size_invalid
+    FINGER_SIZE x1, x0
+    mov x0, x1
+    ret
+
+finger_size_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Finger Cons (internal)
+// ------------------------------------------------------------
+// Add an element before the first of a tree. A full prefix keeps its
+// first element and pushes the other three, as a node, onto the front
+// of the middle.
+//
+// Parameters:
+//   x0 (term_t) - tree: Tree or []
+//   x1 (term_t) - element: Element of the tree's depth
+//   x2 (uint64_t) - depth: Depth of the tree (0 for the caller's)
+//
+// Returns:
+//   x0 (term_t) - tree: New tree
+//
+// Clobbers: x1-x5, x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_cons:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    sub sp, sp, #48                   // Digit buffer
+    mov x19, x0
+    mov x21, x2
+    str x1, [sp]                      // The new first element
+    cmp x19, #TERM_NIL
+    b.ne finger_cons_tree
+    mov x0, sp
+    mov x1, #1
+    mov x3, #FINGER_SHAPE_SINGLE
+    bl finger_pack
+    b finger_cons_done
+
+finger_cons_tree:
+    sub x22, x19, #TERM_TAG_BOXED
+    ldr x9, [x22, #finger_meta]
+    ubfx x10, x9, #FINGER_SHAPE_SHIFT, #FINGER_SHAPE_WIDTH
+    cmp x10, #FINGER_SHAPE_SINGLE
+    b.ne finger_cons_deep
+    mov x0, sp                        // [element], [], [single's]
+    mov x1, #1
+    mov x2, #TERM_NIL
+    add x3, x22, #finger_elements
+    mov x4, #1
+    mov x5, x21
+    bl finger_deep
+    b finger_cons_done
+
+finger_cons_deep:
+    ubfx x1, x9, #FINGER_PREFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    ubfx x4, x9, #FINGER_SUFFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    add x3, x22, #finger_digits
+    cmp x1, #FINGER_MAX_DIGIT
+    b.eq finger_cons_full
+    add x10, sp, #8                   // [element] ++ prefix
+    mov x11, x1
+    FINGER_COPY x10, x3, x11, x12     // Leaves x3 at the suffix
+    add x1, x1, #1
+    mov x0, sp
+    ldr x2, [x22, #finger_middle]
+    mov x5, x21
+    bl finger_deep
+    b finger_cons_done
+
+finger_cons_full:
+    ldr x9, [x3]                      // Prefix a b c d: keep [element, a]
+    str x9, [sp, #8]
+    mov x23, x4
+    add x0, x3, #8
+    mov x1, #3
+    mov x2, x21
+    mov x3, #FINGER_SHAPE_NODE
+    bl finger_pack                    // node(b, c, d)
+    mov x1, x0
+    ldr x0, [x22, #finger_middle]
+    add x2, x21, #1
+    bl finger_cons
+    mov x2, x0
+    mov x0, sp
+    mov x1, #2
+    add x3, x22, #finger_suffix_full
+    mov x4, x23
+    mov x5, x21
+    bl finger_deep
+
+finger_cons_done:
+    add sp, sp, #48
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Snoc (internal)
+// ------------------------------------------------------------
+// Add an element after the last of a tree. A full suffix keeps its
+// last element and pushes the other three, as a node, onto the back of
+// the middle.
+//
+// Parameters:
+//   x0 (term_t) - tree: Tree or []
+//   x1 (term_t) - element: Element of the tree's depth
+//   x2 (uint64_t) - depth: Depth of the tree (0 for the caller's)
+//
+// Returns:
+//   x0 (term_t) - tree: New tree
+//
+// Clobbers: x1-x5, x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_snoc:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    sub sp, sp, #48                   // Digit buffer
+    mov x19, x0
+    mov x20, x1
+    mov x21, x2
+    cmp x19, #TERM_NIL
+    b.ne finger_snoc_tree
+    str x20, [sp]
+    mov x0, sp
+    mov x1, #1
+    mov x3, #FINGER_SHAPE_SINGLE
+    bl finger_pack
+    b finger_snoc_done
+
+finger_snoc_tree:
+    sub x22, x19, #TERM_TAG_BOXED
+    ldr x9, [x22, #finger_meta]
+    ubfx x10, x9, #FINGER_SHAPE_SHIFT, #FINGER_SHAPE_WIDTH
+    cmp x10, #FINGER_SHAPE_SINGLE
+    b.ne finger_snoc_deep
+    str x20, [sp]
+    add x0, x22, #finger_elements     // [single's], [], [element]
+    mov x1, #1
+    mov x2, #TERM_NIL
+    mov x3, sp
+    mov x4, #1
+    mov x5, x21
+    bl finger_deep
+    b finger_snoc_done
+
+finger_snoc_deep:
+    ubfx x1, x9, #FINGER_PREFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    ubfx x4, x9, #FINGER_SUFFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    add x0, x22, #finger_digits
+    add x3, x0, x1, lsl #3            // Suffix
+    cmp x4, #FINGER_MAX_DIGIT
+    b.eq finger_snoc_full
+    mov x10, sp                       // Suffix ++ [element]
+    mov x11, x4
+    FINGER_COPY x10, x3, x11, x12
+    str x20, [x10]
+    add x4, x4, #1
+    mov x3, sp
+    ldr x2, [x22, #finger_middle]
+    mov x5, x21
+    bl finger_deep
+    b finger_snoc_done
+
+finger_snoc_full:
+    ldr x9, [x3, #24]                 // Suffix a b c d: keep [d, element]
+    stp x9, x20, [sp]
+    mov x23, x1
+    mov x0, x3
+    mov x1, #3
+    mov x2, x21
+    mov x3, #FINGER_SHAPE_NODE
+    bl finger_pack                    // node(a, b, c)
+    mov x1, x0
+    ldr x0, [x22, #finger_middle]
+    add x2, x21, #1
+    bl finger_snoc
+    mov x2, x0
+    add x0, x22, #finger_digits
+    mov x1, x23
+    mov x3, sp
+    mov x4, #2
+    mov x5, x21
+    bl finger_deep
+
+finger_snoc_done:
+    add sp, sp, #48
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Uncons (internal)
+// ------------------------------------------------------------
+// Split a non-empty tree into its first element and the rest.
+//
+// Parameters:
+//   x0 (term_t) - tree: Non-empty tree
+//   x1 (uint64_t) - depth: Depth of the tree
+//
+// Returns:
+//   x0 (term_t) - element: First element
+//   x1 (term_t) - rest: The other elements
+//
+// Clobbers: x2-x5, x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_uncons:
+    stp x19, x30, [sp, #-16]!
+    sub x9, x0, #TERM_TAG_BOXED
+    ldr x10, [x9, #finger_meta]
+    ubfx x11, x10, #FINGER_SHAPE_SHIFT, #FINGER_SHAPE_WIDTH
+    cmp x11, #FINGER_SHAPE_SINGLE
+    b.ne finger_uncons_deep
+    ldr x0, [x9, #finger_elements]
+    mov x1, #TERM_NIL
+    b finger_uncons_done
+
+finger_uncons_deep:
+    ldr x19, [x9, #finger_digits]     // First of the prefix
+    mov x5, x1
+    ubfx x1, x10, #FINGER_PREFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    ubfx x4, x10, #FINGER_SUFFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    add x0, x9, #finger_digits
+    add x3, x0, x1, lsl #3
+    add x0, x0, #8
+    sub x1, x1, #1
+    ldr x2, [x9, #finger_middle]
+    bl finger_deep_l
+    mov x1, x0
+    mov x0, x19
+
+finger_uncons_done:
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Unsnoc (internal)
+// ------------------------------------------------------------
+// Split a non-empty tree into its last element and the rest.
+//
+// Parameters:
+//   x0 (term_t) - tree: Non-empty tree
+//   x1 (uint64_t) - depth: Depth of the tree
+//
+// Returns:
+//   x0 (term_t) - element: Last element
+//   x1 (term_t) - rest: The other elements
+//
+// Clobbers: x2-x5, x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_unsnoc:
+    stp x19, x30, [sp, #-16]!
+    sub x9, x0, #TERM_TAG_BOXED
+    ldr x10, [x9, #finger_meta]
+    ubfx x11, x10, #FINGER_SHAPE_SHIFT, #FINGER_SHAPE_WIDTH
+    cmp x11, #FINGER_SHAPE_SINGLE
+    b.ne finger_unsnoc_deep
+    ldr x0, [x9, #finger_elements]
+    mov x1, #TERM_NIL
+    b finger_unsnoc_done
+
+finger_unsnoc_deep:
+    mov x5, x1
+    ubfx x1, x10, #FINGER_PREFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    ubfx x4, x10, #FINGER_SUFFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    add x0, x9, #finger_digits
+    add x3, x0, x1, lsl #3
+    sub x4, x4, #1
+    ldr x19, [x3, x4, lsl #3]         // Last of the suffix
+    ldr x2, [x9, #finger_middle]
+    bl finger_deep_r
+    mov x1, x0
+    mov x0, x19
+
+finger_unsnoc_done:
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Deep Left (internal)
+// ------------------------------------------------------------
+// Build a deep tree whose prefix may be empty. An empty prefix takes
+// the children of the middle's first node, or, with no middle, the
+// suffix becomes the whole tree.
+//
+// Parameters:
+//   x0 (term_t*) - prefix: Prefix elements
+//   x1 (uint64_t) - prefix_count: 0 to 4
+//   x2 (term_t) - middle: Middle tree or []
+//   x3 (term_t*) - suffix: Suffix elements
+//   x4 (uint64_t) - suffix_count: 1 to 4
+//   x5 (uint64_t) - depth: Depth of the tree
+//
+// Returns:
+//   x0 (term_t) - tree: New tree
+//
+// Clobbers: x1-x5, x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_deep_l:
+    cbnz x1, finger_deep
+    cmp x2, #TERM_NIL
+    b.ne finger_deep_l_borrow
+    mov x0, x3
+    mov x1, x4
+    mov x2, x5
+    b finger_digit_tree
+
+finger_deep_l_borrow:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x3
+    mov x20, x4
+    mov x21, x5
+    mov x0, x2
+    add x1, x5, #1
+    bl finger_uncons
+    mov x2, x1
+    sub x9, x0, #TERM_TAG_BOXED
+    ldr x1, [x9]
+    lsr x1, x1, #TERM_HEADER_ARITY_SHIFT
+    sub x1, x1, #1                    // The node's children
+    add x0, x9, #finger_elements
+    mov x3, x19
+    mov x4, x20
+    mov x5, x21
+    bl finger_deep
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Deep Right (internal)
+// ------------------------------------------------------------
+// Build a deep tree whose suffix may be empty. An empty suffix takes
+// the children of the middle's last node, or, with no middle, the
+// prefix becomes the whole tree.
+//
+// Parameters:
+//   x0 (term_t*) - prefix: Prefix elements
+//   x1 (uint64_t) - prefix_count: 1 to 4
+//   x2 (term_t) - middle: Middle tree or []
+//   x3 (term_t*) - suffix: Suffix elements
+//   x4 (uint64_t) - suffix_count: 0 to 4
+//   x5 (uint64_t) - depth: Depth of the tree
+//
+// Returns:
+//   x0 (term_t) - tree: New tree
+//
+// Clobbers: x1-x5, x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_deep_r:
+    cbnz x4, finger_deep
+    cmp x2, #TERM_NIL
+    b.ne finger_deep_r_borrow
+    mov x2, x5
+    b finger_digit_tree
+
+finger_deep_r_borrow:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0
+    mov x20, x1
+    mov x21, x5
+    mov x0, x2
+    add x1, x5, #1
+    bl finger_unsnoc
+    mov x2, x1
+    sub x9, x0, #TERM_TAG_BOXED
+    ldr x4, [x9]
+    lsr x4, x4, #TERM_HEADER_ARITY_SHIFT
+    sub x4, x4, #1                    // The node's children
+    add x3, x9, #finger_elements
+    mov x0, x19
+    mov x1, x20
+    mov x5, x21
+    bl finger_deep
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Digit Tree (internal)
+// ------------------------------------------------------------
+// Build a tree of up to four elements: [], a single, or a deep tree
+// with the elements split between its digits and no middle.
+//
+// Parameters:
+//   x0 (term_t*) - elements: Elements
+//   x1 (uint64_t) - count: 0 to 4
+//   x2 (uint64_t) - depth: Depth of the tree
+//
+// Returns:
+//   x0 (term_t) - tree: New tree
+//
+// Clobbers: x1-x5, x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_digit_tree:
+    cbz x1, finger_digit_tree_empty
+    cmp x1, #1
+    b.ne finger_digit_tree_deep
+    mov x3, #FINGER_SHAPE_SINGLE
+    b finger_pack
+
+finger_digit_tree_deep:
+    mov x5, x2
+    lsr x4, x1, #1                    // Suffix: the smaller half
+    sub x1, x1, x4
+    add x3, x0, x1, lsl #3
+    mov x2, #TERM_NIL
+    b finger_deep
+
+finger_digit_tree_empty:
+    mov x0, #TERM_NIL
+    ret
+
+// ------------------------------------------------------------
+// Finger App3 (internal)
+// ------------------------------------------------------------
+// Join two trees with up to four elements between them. Where both
+// are deep, the inner digits and the elements between are regrouped
+// into nodes and joined, one level down, between the two middles.
+//
+// Parameters:
+//   x0 (term_t) - left: Tree or []
+//   x1 (term_t) - right: Tree or []
+//   x2 (term_t*) - between: Elements between the trees
+//   x3 (uint64_t) - between_count: 0 to 4
+//   x4 (uint64_t) - depth: Depth of the trees
+//
+// Returns:
+//   x0 (term_t) - tree: Joined tree
+//
+// Clobbers: x1-x5, x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ finger_app3_nodes, 96        // After 12 words of regrouped elements
+    .equ finger_app3_frame, 128       // And 4 nodes
+
+finger_app3:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    sub sp, sp, #finger_app3_frame
+    mov x19, x0
+    mov x20, x1
+    mov x21, x2
+    mov x22, x3
+    mov x23, x4
+    cmp x19, #TERM_NIL
+    b.eq finger_app3_front
+    cmp x20, #TERM_NIL
+    b.eq finger_app3_back
+    sub x24, x19, #TERM_TAG_BOXED
+    sub x25, x20, #TERM_TAG_BOXED
+    ldr x9, [x24, #finger_meta]
+    ubfx x11, x9, #FINGER_SHAPE_SHIFT, #FINGER_SHAPE_WIDTH
+    cmp x11, #FINGER_SHAPE_SINGLE
+    b.eq finger_app3_left_single
+    ldr x10, [x25, #finger_meta]
+    ubfx x11, x10, #FINGER_SHAPE_SHIFT, #FINGER_SHAPE_WIDTH
+    cmp x11, #FINGER_SHAPE_SINGLE
+    b.eq finger_app3_right_single
+
+    // Both deep: left suffix ++ between ++ right prefix, as nodes
+    mov x11, sp
+    ubfx x12, x9, #FINGER_PREFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    ubfx x13, x9, #FINGER_SUFFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    add x14, x24, #finger_digits
+    add x14, x14, x12, lsl #3
+    FINGER_COPY x11, x14, x13, x12
+    mov x14, x21
+    mov x13, x22
+    FINGER_COPY x11, x14, x13, x12
+    ubfx x13, x10, #FINGER_PREFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    add x14, x25, #finger_digits
+    FINGER_COPY x11, x14, x13, x12
+    mov x0, sp
+    sub x1, x11, x0
+    lsr x1, x1, #3
+    mov x2, x23
+    add x3, sp, #finger_app3_nodes
+    bl finger_nodes
+    mov x3, x0
+    ldr x0, [x24, #finger_middle]
+    ldr x1, [x25, #finger_middle]
+    add x2, sp, #finger_app3_nodes
+    add x4, x23, #1
+    bl finger_app3
+    mov x2, x0                        // Joined middle
+    ldr x9, [x24, #finger_meta]
+    ldr x10, [x25, #finger_meta]
+    add x0, x24, #finger_digits
+    ubfx x1, x9, #FINGER_PREFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    ubfx x11, x10, #FINGER_PREFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    ubfx x4, x10, #FINGER_SUFFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    add x3, x25, #finger_digits
+    add x3, x3, x11, lsl #3
+    mov x5, x23
+    bl finger_deep
+    b finger_app3_done
+
+finger_app3_front:
+    mov x0, x20                       // Push the elements onto right, last first
+finger_app3_front_next:
+    cbz x22, finger_app3_done
+    sub x22, x22, #1
+    ldr x1, [x21, x22, lsl #3]
+    mov x2, x23
+    bl finger_cons
+    b finger_app3_front_next
+
+finger_app3_back:
+    mov x0, x19                       // Push the elements onto left, first first
+    mov x24, #0
+finger_app3_back_next:
+    cmp x24, x22
+    b.hs finger_app3_done
+    ldr x1, [x21, x24, lsl #3]
+    add x24, x24, #1
+    mov x2, x23
+    bl finger_snoc
+    b finger_app3_back_next
+
+finger_app3_left_single:
+    mov x0, #TERM_NIL                 // x ++ rest: join rest, then push x
+    mov x1, x20
+    mov x2, x21
+    mov x3, x22
+    mov x4, x23
+    bl finger_app3
+    ldr x1, [x24, #finger_elements]
+    mov x2, x23
+    bl finger_cons
+    b finger_app3_done
+
+finger_app3_right_single:
+    mov x0, x19                       // rest ++ x: join rest, then push x
+    mov x1, #TERM_NIL
+    mov x2, x21
+    mov x3, x22
+    mov x4, x23
+    bl finger_app3
+    ldr x1, [x25, #finger_elements]
+    mov x2, x23
+    bl finger_snoc
+
+finger_app3_done:
+    add sp, sp, #finger_app3_frame
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Nodes (internal)
+// ------------------------------------------------------------
+// Regroup 2 to 12 elements into nodes of three, using nodes of two
+// only where three would leave one element over.
+//
+// Parameters:
+//   x0 (term_t*) - elements: Elements
+//   x1 (uint64_t) - count: 2 to 12
+//   x2 (uint64_t) - depth: Depth of the elements
+//   x3 (term_t*) - nodes_out: Receives the nodes (4 at most)
+//
+// Returns:
+//   x0 (uint64_t) - nodes: Nodes written
+//
+// Clobbers: x1-x3, x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_nodes:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    mov x19, x0
+    mov x20, x1
+    mov x21, x2
+    mov x22, x3
+    mov x23, #0
+finger_nodes_next:
+    mov x1, #3
+    cmp x20, #2
+    b.eq finger_nodes_pair
+    cmp x20, #4
+    b.ne finger_nodes_take
+finger_nodes_pair:
+    mov x1, #2
+finger_nodes_take:
+    mov x0, x19
+    add x19, x19, x1, lsl #3
+    sub x20, x20, x1
+    mov x2, x21
+    mov x3, #FINGER_SHAPE_NODE
+    bl finger_pack
+    str x0, [x22, x23, lsl #3]
+    add x23, x23, #1
+    cbnz x20, finger_nodes_next
+    mov x0, x23
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Split Tree (internal)
+// ------------------------------------------------------------
+// Split a non-empty tree around the element holding an index: the
+// elements before it, the element, and the elements after it. An index
+// in the middle splits the middle one level down, then the node found
+// there.
+//
+// Parameters:
+//   x0 (term_t) - tree: Non-empty tree
+//   x1 (uint64_t) - index: Below the tree's measure
+//   x2 (uint64_t) - depth: Depth of the tree
+//
+// Returns:
+//   x0 (term_t) - left: Elements before
+//   x1 (term_t) - element: Element holding the index
+//   x2 (term_t) - right: Elements after
+//
+// Clobbers: x3-x5, x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_split_tree:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    stp x26, x27, [sp, #-16]!
+    sub x19, x0, #TERM_TAG_BOXED
+    mov x20, x1
+    mov x21, x2
+    ldr x9, [x19, #finger_meta]
+    ubfx x10, x9, #FINGER_SHAPE_SHIFT, #FINGER_SHAPE_WIDTH
+    cmp x10, #FINGER_SHAPE_SINGLE
+    b.ne finger_split_tree_deep
+    mov x0, #TERM_NIL
+    ldr x1, [x19, #finger_elements]
+    mov x2, #TERM_NIL
+    b finger_split_tree_done
+
+finger_split_tree_deep:
+    ubfx x22, x9, #FINGER_PREFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    ubfx x23, x9, #FINGER_SUFFIX_SHIFT, #FINGER_DIGIT_WIDTH
+    add x0, x19, #finger_digits
+    mov x1, x22
+    mov x2, x21
+    mov x3, x20
+    bl finger_scan
+    cmp x0, x22
+    b.hs finger_split_tree_past_prefix
+
+    // In the prefix at k: digit_tree(prefix[..k]), element,
+    // deep_l(prefix[k+1..], middle, suffix)
+    mov x24, x0
+    add x9, x19, #finger_digits
+    ldr x25, [x9, x24, lsl #3]
+    add x0, x9, x24, lsl #3
+    add x0, x0, #8
+    sub x1, x22, x24
+    sub x1, x1, #1
+    ldr x2, [x19, #finger_middle]
+    add x3, x9, x22, lsl #3
+    mov x4, x23
+    mov x5, x21
+    bl finger_deep_l
+    mov x23, x0
+    add x0, x19, #finger_digits
+    mov x1, x24
+    mov x2, x21
+    bl finger_digit_tree
+    mov x1, x25
+    mov x2, x23
+    b finger_split_tree_done
+
+finger_split_tree_past_prefix:
+    mov x20, x3
+    ldr x24, [x19, #finger_middle]
+    FINGER_SIZE x9, x24
+    cmp x20, x9
+    b.hs finger_split_tree_suffix
+
+    // In the middle: split it, then the node found there at k:
+    // deep_r(prefix, left middle, node[..k]), node[k],
+    // deep_l(node[k+1..], right middle, suffix)
+    mov x0, x24
+    mov x1, x20
+    add x2, x21, #1
+    bl finger_split_tree
+    mov x24, x0
+    mov x25, x2
+    mov x26, x1
+    FINGER_SIZE x9, x24
+    sub x3, x20, x9
+    sub x9, x26, #TERM_TAG_BOXED
+    ldr x1, [x9]
+    lsr x1, x1, #TERM_HEADER_ARITY_SHIFT
+    sub x1, x1, #1
+    add x0, x9, #finger_elements
+    mov x2, x21
+    bl finger_scan
+    mov x20, x0
+    add x0, x19, #finger_digits
+    mov x1, x22
+    mov x2, x24
+    add x3, x26, #(finger_elements - TERM_TAG_BOXED)
+    mov x4, x20
+    mov x5, x21
+    bl finger_deep_r
+    mov x24, x0
+    sub x9, x26, #TERM_TAG_BOXED
+    ldr x1, [x9]
+    lsr x1, x1, #TERM_HEADER_ARITY_SHIFT
+    sub x1, x1, #2
+    sub x1, x1, x20
+    add x9, x9, #finger_elements
+    add x0, x9, x20, lsl #3
+    add x0, x0, #8
+    mov x2, x25
+    add x3, x19, #finger_digits
+    add x3, x3, x22, lsl #3
+    mov x4, x23
+    mov x5, x21
+    bl finger_deep_l
+    mov x2, x0
+    add x9, x26, #(finger_elements - TERM_TAG_BOXED)
+    ldr x1, [x9, x20, lsl #3]
+    mov x0, x24
+    b finger_split_tree_done
+
+    // In the suffix at k: deep_r(prefix, middle, suffix[..k]),
+    // element, digit_tree(suffix[k+1..])
+finger_split_tree_suffix:
+    sub x3, x20, x9
+    add x0, x19, #finger_digits
+    add x0, x0, x22, lsl #3
+    mov x1, x23
+    mov x2, x21
+    bl finger_scan
+    mov x20, x0
+    add x0, x19, #finger_digits
+    mov x1, x22
+    mov x2, x24
+    add x3, x0, x22, lsl #3
+    mov x4, x20
+    mov x5, x21
+    bl finger_deep_r
+    mov x24, x0
+    add x9, x19, #finger_digits
+    add x9, x9, x22, lsl #3
+    ldr x25, [x9, x20, lsl #3]
+    add x0, x9, x20, lsl #3
+    add x0, x0, #8
+    sub x1, x23, x20
+    sub x1, x1, #1
+    mov x2, x21
+    bl finger_digit_tree
+    mov x2, x0
+    mov x1, x25
+    mov x0, x24
+
+finger_split_tree_done:
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Scan (internal)
+// ------------------------------------------------------------
+// Find the element of a digit or node holding an index.
+//
+// Parameters:
+//   x0 (term_t*) - elements: Elements
+//   x1 (uint64_t) - count: Elements to scan
+//   x2 (uint64_t) - depth: Depth of the elements
+//   x3 (uint64_t) - index: Index from the first element
+//
+// Returns:
+//   x0 (uint64_t) - position: The element holding the index, or count
+//                  if they all lie below it
+//   x3 (uint64_t) - index: Index from the start of that element
+//
+// Clobbers: x9-x11
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_scan:
+    mov x9, #0
+finger_scan_next:
+    cmp x9, x1
+    b.hs finger_scan_done
+    ldr x10, [x0, x9, lsl #3]
+    FINGER_MEASURE x11, x10, x2
+    cmp x3, x11
+    b.lo finger_scan_done
+    sub x3, x3, x11
+    add x9, x9, #1
+    b finger_scan_next
+
+finger_scan_done:
+    mov x0, x9
+    ret
+
+// ------------------------------------------------------------
+// Finger Deep (internal)
+// ------------------------------------------------------------
+// Allocate a deep tree, summing the measures of its parts.
+//
+// Parameters:
+//   x0 (term_t*) - prefix: Prefix elements
+//   x1 (uint64_t) - prefix_count: 1 to 4
+//   x2 (term_t) - middle: Middle tree or []
+//   x3 (term_t*) - suffix: Suffix elements
+//   x4 (uint64_t) - suffix_count: 1 to 4
+//   x5 (uint64_t) - depth: Depth of the tree
+//
+// Returns:
+//   x0 (term_t) - tree: New deep tree
+//
+// Clobbers: x3, x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_deep:
+    str x30, [sp, #-16]!
+    add x9, x1, x4
+    add x9, x9, #3                    // Header, meta and middle
+    bl finger_alloc
+    add x10, x1, x4
+    add x10, x10, #2
+    lsl x10, x10, #TERM_HEADER_ARITY_SHIFT
+    add x10, x10, #TERM_HEADER_FINGER
+    str x10, [x9]
+    str x2, [x9, #finger_middle]
+    FINGER_SIZE x12, x2
+    add x13, x9, #finger_digits
+    mov x14, x1
+finger_deep_prefix:
+    ldr x10, [x0], #8
+    str x10, [x13], #8
+    FINGER_MEASURE x11, x10, x5
+    add x12, x12, x11
+    subs x14, x14, #1
+    b.ne finger_deep_prefix
+    mov x14, x4
+finger_deep_suffix:
+    ldr x10, [x3], #8
+    str x10, [x13], #8
+    FINGER_MEASURE x11, x10, x5
+    add x12, x12, x11
+    subs x14, x14, #1
+    b.ne finger_deep_suffix
+    lsl x12, x12, #FINGER_MEASURE_SHIFT
+    orr x12, x12, x4, lsl #FINGER_SUFFIX_SHIFT
+    orr x12, x12, x1, lsl #FINGER_PREFIX_SHIFT
+    orr x12, x12, #(FINGER_SHAPE_DEEP << FINGER_SHAPE_SHIFT)
+    str x12, [x9, #finger_meta]
+    add x0, x9, #TERM_TAG_BOXED
+    ldr x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Pack (internal)
+// ------------------------------------------------------------
+// Allocate a single or a node, summing the measures of its elements.
+//
+// Parameters:
+//   x0 (term_t*) - elements: Elements
+//   x1 (uint64_t) - count: 1 for a single, 2 or 3 for a node
+//   x2 (uint64_t) - depth: Depth of the elements
+//   x3 (uint64_t) - shape: FINGER_SHAPE_SINGLE or FINGER_SHAPE_NODE
+//
+// Returns:
+//   x0 (term_t) - object: New single or node
+//
+// Clobbers: x9-x14
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_pack:
+    str x30, [sp, #-16]!
+    add x9, x1, #2                    // Header and meta
+    bl finger_alloc
+    add x10, x1, #1
+    lsl x10, x10, #TERM_HEADER_ARITY_SHIFT
+    add x10, x10, #TERM_HEADER_FINGER
+    str x10, [x9]
+    mov x12, #0
+    add x13, x9, #finger_elements
+    mov x14, x1
+finger_pack_element:
+    ldr x10, [x0], #8
+    str x10, [x13], #8
+    FINGER_MEASURE x11, x10, x2
+    add x12, x12, x11
+    subs x14, x14, #1
+    b.ne finger_pack_element
+    lsl x12, x12, #FINGER_MEASURE_SHIFT
+    orr x12, x12, x3, lsl #FINGER_SHAPE_SHIFT
+    str x12, [x9, #finger_meta]
+    add x0, x9, #TERM_TAG_BOXED
+    ldr x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Finger Alloc (internal)
+// ------------------------------------------------------------
+// Bump-allocate words from the heap of the update's PCB (x27). A full
+// heap does not return: it unwinds the update through finger_fail.
+//
+// Parameters:
+//   x9 (uint64_t) - words: Words to allocate
+//
+// Returns:
+//   x9 (uint64_t*) - object: Word-aligned memory
+//
+// Clobbers: x10, x11
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+finger_alloc:
+    ldr x10, [x27, #pcb_heap_pointer]
+    ldr x11, [x27, #pcb_heap_limit]
+    add x9, x10, x9, lsl #3
+    cmp x9, x11
+    b.hi finger_fail
+    str x9, [x27, #pcb_heap_pointer]
+    mov x9, x10
+    ret
+
+// ------------------------------------------------------------
+// Deque New
+// ------------------------------------------------------------
+// An empty chunked deque with a ring of DEQUE_MIN_CHUNKS chunks, none
+// of them allocated yet.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//
+// Returns:
+//   x0 (term_t) - deque: New deque, or TERM_NONE if the heap is full or
+//                 pcb is NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_deque_new:
+    cbz x0, deque_new_failed
+    ldr x2, [x0, #pcb_heap_pointer]
+    ldr x3, [x0, #pcb_heap_limit]
+    add x4, x2, #((deque_words + 1 + DEQUE_MIN_CHUNKS) * 8)
+    cmp x4, x3
+    b.hi deque_new_failed
+    str x4, [x0, #pcb_heap_pointer]
+    mov x5, #deque_header
+    str x5, [x2]
+    stp xzr, xzr, [x2, #deque_count]  // No elements, head at 0
+    add x6, x2, #(deque_words * 8)    // Directory follows
+    add x7, x6, #TERM_TAG_BOXED
+    mov x8, #TERM_NIL
+    stp x7, x8, [x2, #deque_directory]
+    mov x5, #((DEQUE_MIN_CHUNKS << TERM_HEADER_ARITY_SHIFT) | TERM_HEADER_TUPLE)
+    str x5, [x6], #8
+    mov x5, #DEQUE_MIN_CHUNKS
+deque_new_chunk:
+    str x8, [x6], #8
+    subs x5, x5, #1
+    b.ne deque_new_chunk
+    add x0, x2, #TERM_TAG_BOXED
+    ret
+
+deque_new_failed:
+    mov x0, #TERM_NONE
+    ret
+
+// ------------------------------------------------------------
+// Deque Push Back
+// ------------------------------------------------------------
+// Add an element after the last of a deque, in place. A new chunk is
+// taken from the spare, or allocated, only when the element starts
+// one; the ring doubles first if that chunk is the head's.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - deque: Deque
+//   x2 (term_t) - element: Any term but TERM_NONE
+//
+// Returns:
+//   x0 (uint64_t) - status: 1 if pushed, 0 if the heap is full or an
+//                   argument is invalid (the deque is unchanged)
+//
+// Complexity: O(1) amortized
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_deque_push_back:
+    cbz x0, deque_push_invalid
+    cmp x2, #TERM_NONE
+    b.eq deque_push_invalid
+    DEQUE_CHECK x1, x9, deque_push_invalid
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0
+    mov x20, x1
+    mov x21, x2
+deque_push_back_load:
+    DEQUE_LOAD x20
+    add x14, x11, x10
+    and x14, x14, x13                 // Position after the last
+    cbz x10, deque_push_back_chunk
+    tst x14, #deque_slot_mask
+    b.ne deque_push_back_chunk
+    eor x15, x14, x11
+    lsr x15, x15, #DEQUE_CHUNK_SHIFT
+    cbnz x15, deque_push_back_chunk   // The next chunk is not the head's
+    mov x0, x19
+    mov x1, x20
+    bl deque_grow
+    cbz x0, deque_push_done
+    b deque_push_back_load
+
+deque_push_back_chunk:
+    mov x0, x19
+    mov x1, x20
+    mov x2, x14
+    bl deque_chunk
+    cbz x0, deque_push_done
+    and x15, x14, #deque_slot_mask
+    add x0, x0, #8
+    str x21, [x0, x15, lsl #3]
+    ldr x10, [x9, #deque_count]
+    add x10, x10, #(1 << TERM_INT_SHIFT)
+    str x10, [x9, #deque_count]
+    mov x0, #1
+
+deque_push_done:
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+deque_push_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Deque Push Front
+// ------------------------------------------------------------
+// Add an element before the first of a deque, in place. A new chunk is
+// taken from the spare, or allocated, only when the element starts
+// one; the ring doubles first if that chunk is the last element's.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - deque: Deque
+//   x2 (term_t) - element: Any term but TERM_NONE
+//
+// Returns:
+//   x0 (uint64_t) - status: 1 if pushed, 0 if the heap is full or an
+//                   argument is invalid (the deque is unchanged)
+//
+// Complexity: O(1) amortized
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_deque_push_front:
+    cbz x0, deque_push_invalid
+    cmp x2, #TERM_NONE
+    b.eq deque_push_invalid
+    DEQUE_CHECK x1, x9, deque_push_invalid
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0
+    mov x20, x1
+    mov x21, x2
+deque_push_front_load:
+    DEQUE_LOAD x20
+    sub x14, x11, #1
+    and x14, x14, x13                 // Position before the first
+    cbz x10, deque_push_front_chunk
+    and x15, x14, #deque_slot_mask
+    cmp x15, #deque_slot_mask
+    b.ne deque_push_front_chunk
+    add x15, x11, x10
+    sub x15, x15, #1
+    and x15, x15, x13                 // Last element's position
+    eor x15, x15, x14
+    lsr x15, x15, #DEQUE_CHUNK_SHIFT
+    cbnz x15, deque_push_front_chunk  // The next chunk is not the last's
+    mov x0, x19
+    mov x1, x20
+    bl deque_grow
+    cbz x0, deque_push_done
+    b deque_push_front_load
+
+deque_push_front_chunk:
+    mov x0, x19
+    mov x1, x20
+    mov x2, x14
+    bl deque_chunk
+    cbz x0, deque_push_done
+    and x15, x14, #deque_slot_mask
+    add x0, x0, #8
+    str x21, [x0, x15, lsl #3]
+    ldr x10, [x9, #deque_count]
+    add x10, x10, #(1 << TERM_INT_SHIFT)
+    lsl x14, x14, #TERM_INT_SHIFT
+    stp x10, x14, [x9, #deque_count]
+    mov x0, #1
+    b deque_push_done
+
+// ------------------------------------------------------------
+// Deque Pop Front
+// ------------------------------------------------------------
+// Take the first element of a deque, in place. A chunk left empty is
+// dropped from the ring and kept as the spare if there is none.
+//
+// Parameters:
+//   x0 (term_t) - deque: Deque
+//
+// Returns:
+//   x0 (term_t) - element: First element, or TERM_NONE if the deque is
+//                 empty or not a deque
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_deque_pop_front:
+    DEQUE_CHECK x0, x9, deque_pop_empty
+    DEQUE_LOAD x0
+    cbz x10, deque_pop_empty
+    lsr x14, x11, #DEQUE_CHUNK_SHIFT
+    add x15, x12, #8
+    ldr x15, [x15, x14, lsl #3]
+    add x15, x15, #(8 - TERM_TAG_BOXED)
+    and x1, x11, #deque_slot_mask
+    ldr x0, [x15, x1, lsl #3]
+    mov x2, #TERM_NIL
+    str x2, [x15, x1, lsl #3]
+    add x11, x11, #1
+    and x11, x11, x13
+    sub x10, x10, #1
+    lsl x1, x10, #TERM_INT_SHIFT
+    lsl x2, x11, #TERM_INT_SHIFT
+    stp x1, x2, [x9, #deque_count]
+    cbz x10, deque_pop_front_release
+    tst x11, #deque_slot_mask
+    b.ne deque_pop_done
+deque_pop_front_release:
+    DEQUE_RELEASE x9, x12, x14
+deque_pop_done:
+    ret
+
+deque_pop_empty:
+    mov x0, #TERM_NONE
+    ret
+
+// ------------------------------------------------------------
+// Deque Pop Back
+// ------------------------------------------------------------
+// Take the last element of a deque, in place. A chunk left empty is
+// dropped from the ring and kept as the spare if there is none.
+//
+// Parameters:
+//   x0 (term_t) - deque: Deque
+//
+// Returns:
+//   x0 (term_t) - element: Last element, or TERM_NONE if the deque is
+//                 empty or not a deque
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_deque_pop_back:
+    DEQUE_CHECK x0, x9, deque_pop_empty
+    DEQUE_LOAD x0
+    cbz x10, deque_pop_empty
+    add x11, x11, x10
+    sub x11, x11, #1
+    and x11, x11, x13                 // Last element's position
+    lsr x14, x11, #DEQUE_CHUNK_SHIFT
+    add x15, x12, #8
+    ldr x15, [x15, x14, lsl #3]
+    add x15, x15, #(8 - TERM_TAG_BOXED)
+    and x1, x11, #deque_slot_mask
+    ldr x0, [x15, x1, lsl #3]
+    mov x2, #TERM_NIL
+    str x2, [x15, x1, lsl #3]
+    sub x10, x10, #1
+    lsl x2, x10, #TERM_INT_SHIFT
+    str x2, [x9, #deque_count]
+    cbz x10, deque_pop_back_release
+    cbnz x1, deque_pop_done           // Not its chunk's first slot
+deque_pop_back_release:
+    DEQUE_RELEASE x9, x12, x14
+    ret
+
+// ------------------------------------------------------------
+// Deque Index
+// ------------------------------------------------------------
+// The element at an index, read from its chunk.
+//
+// Parameters:
+//   x0 (term_t) - deque: Deque
+//   x1 (uint64_t) - index: Position from the front
+//
+// Returns:
+//   x0 (term_t) - element: The element, or TERM_NONE if index is out of
+//                 range or deque is not a deque
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_deque_index:
+    DEQUE_CHECK x0, x9, deque_pop_empty
+    DEQUE_LOAD x0
+    cmp x1, x10
+    b.hs deque_pop_empty
+    add x11, x11, x1
+    and x11, x11, x13
+    lsr x14, x11, #DEQUE_CHUNK_SHIFT
+    add x15, x12, #8
+    ldr x15, [x15, x14, lsl #3]
+    add x15, x15, #(8 - TERM_TAG_BOXED)
+    and x1, x11, #deque_slot_mask
+    ldr x0, [x15, x1, lsl #3]
+    ret
+
+// ------------------------------------------------------------
+// Deque Size
+// ------------------------------------------------------------
+// The number of elements in a deque.
+//
+// Parameters:
+//   x0 (term_t) - deque: Deque
+//
+// Returns:
+//   x0 (uint64_t) - size: Elements, or 0 if deque is not a deque
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_deque_size:
+    DEQUE_CHECK x0, x9, deque_size_invalid
+    ldur x0, [x0, #(deque_count - TERM_TAG_BOXED)]
+    lsr x0, x0, #TERM_INT_SHIFT
+    ret
+
+deque_size_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Deque Chunk (internal)
+// ------------------------------------------------------------
+// The chunk holding a ring position, installing the spare or a new
+// chunk of [] slots if there is none there yet.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - deque: Deque
+//   x2 (uint64_t) - position: Ring position
+//
+// Returns:
+//   x0 (uint64_t*) - chunk: The chunk (untagged), or NULL if the heap
+//                    is full
+//
+// Clobbers: x1-x8
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+deque_chunk:
+    sub x3, x1, #TERM_TAG_BOXED
+    ldr x4, [x3, #deque_directory]
+    add x4, x4, #(8 - TERM_TAG_BOXED) // Directory slots
+    lsr x5, x2, #DEQUE_CHUNK_SHIFT
+    ldr x6, [x4, x5, lsl #3]
+    cmp x6, #TERM_NIL
+    b.eq deque_chunk_install
+    sub x0, x6, #TERM_TAG_BOXED
+    ret
+
+deque_chunk_install:
+    ldr x6, [x3, #deque_spare]
+    cmp x6, #TERM_NIL
+    b.eq deque_chunk_allocate
+    mov x7, #TERM_NIL
+    str x7, [x3, #deque_spare]
+    str x6, [x4, x5, lsl #3]
+    sub x0, x6, #TERM_TAG_BOXED
+    ret
+
+deque_chunk_allocate:
+    ldr x6, [x0, #pcb_heap_pointer]
+    ldr x7, [x0, #pcb_heap_limit]
+    add x8, x6, #((DEQUE_CHUNK_SLOTS + 1) * 8)
+    cmp x8, x7
+    b.hi deque_chunk_failed
+    str x8, [x0, #pcb_heap_pointer]
+    mov x7, #deque_chunk_header
+    str x7, [x6]
+    mov x7, #TERM_NIL
+    add x8, x6, #8
+    mov x0, #DEQUE_CHUNK_SLOTS
+deque_chunk_clear:
+    str x7, [x8], #8
+    subs x0, x0, #1
+    b.ne deque_chunk_clear
+    add x7, x6, #TERM_TAG_BOXED
+    str x7, [x4, x5, lsl #3]
+    mov x0, x6
+    ret
+
+deque_chunk_failed:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Deque Grow (internal)
+// ------------------------------------------------------------
+// Double a full ring. The chunks keep their elements and are listed in
+// the new directory in order from the head's, so the head moves to
+// its slot in the first chunk and no element is copied.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - deque: Deque whose every chunk is in use
+//
+// Returns:
+//   x0 (uint64_t) - status: 1 if grown, 0 if the heap is full
+//
+// Clobbers: x1-x15
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+deque_grow:
+    sub x3, x1, #TERM_TAG_BOXED
+    ldr x4, [x3, #deque_directory]
+    add x4, x4, #(8 - TERM_TAG_BOXED) // Old directory slots
+    ldur x5, [x4, #-8]
+    lsr x5, x5, #TERM_HEADER_ARITY_SHIFT // Chunks
+    lsl x6, x5, #1
+    ldr x8, [x0, #pcb_heap_pointer]
+    ldr x7, [x0, #pcb_heap_limit]
+    add x9, x8, x6, lsl #3
+    add x9, x9, #8
+    cmp x9, x7
+    b.hi deque_grow_failed
+    str x9, [x0, #pcb_heap_pointer]
+    lsl x10, x6, #TERM_HEADER_ARITY_SHIFT
+    add x10, x10, #TERM_HEADER_TUPLE
+    str x10, [x8]
+    ldr x11, [x3, #deque_head]
+    lsr x11, x11, #TERM_INT_SHIFT
+    lsr x12, x11, #DEQUE_CHUNK_SHIFT  // Head's chunk
+    sub x13, x5, #1
+    add x14, x8, #8
+    mov x15, #0
+deque_grow_copy:
+    add x9, x12, x15
+    and x9, x9, x13
+    ldr x10, [x4, x9, lsl #3]
+    str x10, [x14], #8
+    add x15, x15, #1
+    cmp x15, x5
+    b.lo deque_grow_copy
+    mov x10, #TERM_NIL
+deque_grow_clear:
+    str x10, [x14], #8
+    add x15, x15, #1
+    cmp x15, x6
+    b.lo deque_grow_clear
+    add x8, x8, #TERM_TAG_BOXED
+    str x8, [x3, #deque_directory]
+    and x11, x11, #deque_slot_mask
+    lsl x11, x11, #TERM_INT_SHIFT
+    str x11, [x3, #deque_head]
+    mov x0, #1
+    ret
+
+deque_grow_failed:
+    mov x0, #0
+    ret
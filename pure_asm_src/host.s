@@ -0,0 +1,549 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// host.s — Hosted Multithreaded Runtime
+// ------------------------------------------------------------
+// Runs N schedulers concurrently inside an ordinary process, one
+// pthread per scheduler, on Linux/AArch64 (including qemu-user) and
+// macOS. Each thread enters _scheduler_core_start, the same per-core
+// init and main-loop path that bare-metal secondary cores take in
+// boot.s, so hosted runs exercise the real scheduler code.
+//
+// All runtime bookkeeping lives in a runtime structure returned to the
+// caller (no globals). For Linux, assemble with --defsym ACTLY_LINUX=1
+// and strip the leading underscore from symbols (see the Makefile's
+// linux target).
+//
+// Startup is lazy (see _scheduler_core_start): only the requested
+// schedulers are brought up and each one maps nothing until first use.
+// The runtime records a per-phase startup breakdown in counter ticks.
+//
+// The file provides:
+//   - Runtime start with one scheduler thread per core
+//   - Optional initial process queued on scheduler 0
+//   - Per-phase startup timing
+//   - Access to the shared scheduler states
+//   - Cooperative stop and join with teardown
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// ------------------------------------------------------------
+// Host Runtime Function Exports
+// ------------------------------------------------------------
+// Export the host runtime functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _host_runtime_start
+    .global _host_runtime_start_with_process
+    .global _host_runtime_startup_ticks
+    .global _host_runtime_states
+    .global _host_runtime_scheduler_count
+    .global _host_runtime_stop
+    .global _host_runtime_join
+    .global _HOST_RUNTIME_SIZE
+    .global _HOST_RUNTIME_SIZE_CONST
+
+// ------------------------------------------------------------
+// Host Runtime Structure Layout
+// ------------------------------------------------------------
+// One runtime per hosted scheduler set. Each scheduler thread gets a
+// start block {scheduler_states, core_id, initial_process, online_tick}
+// as its argument. Startup timestamps are raw CNTVCT_EL0 values.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ runtime_states, 0            // Scheduler states array (8 bytes)
+    .equ runtime_count, 8             // Number of schedulers (8 bytes)
+    .equ runtime_started, 16          // Threads successfully created (8 bytes)
+    .equ runtime_begin_tick, 24       // Tick at entry to start (8 bytes)
+    .equ runtime_states_tick, 32      // Tick after states were reserved (8 bytes)
+    .equ runtime_threads_tick, 40     // Tick after all threads were created (8 bytes)
+    .equ runtime_threads, 48          // pthread_t per scheduler (MAX_CORES * 8 bytes)
+    .equ runtime_args, 1072           // Start blocks (MAX_CORES * 32 bytes)
+    .equ runtime_size, 5168           // Total runtime structure size
+
+    .equ start_block_states, 0
+    .equ start_block_core, 8
+    .equ start_block_initial, 16
+    .equ start_block_online_tick, 24  // Written by the scheduler thread
+    .equ start_block_size, 32
+
+// Startup phases for _host_runtime_startup_ticks
+    .equ HOST_PHASE_STATES, 0         // Scheduler states reserved
+    .equ HOST_PHASE_THREADS, 1        // All scheduler threads created
+    .equ HOST_PHASE_ONLINE, 2         // Every scheduler entered its start path
+
+// ------------------------------------------------------------
+// Host Runtime Start
+// ------------------------------------------------------------
+// Allocate scheduler states for num_schedulers cores and start one
+// pthread per scheduler. Each thread initializes its own scheduler
+// state and then runs the main loop. If any thread cannot be created,
+// the ones already running are stopped and joined and the start fails.
+//
+// Parameters:
+//   x0 (uint64_t) - num_schedulers: Number of schedulers (1 to MAX_CORES)
+//
+// Returns:
+//   x0 (void*) - runtime: Runtime handle, or NULL on failure
+//
+// Complexity: O(n) where n is num_schedulers
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_host_runtime_start:
+    mov x1, xzr
+    b _host_runtime_start_with_process
+
+// ------------------------------------------------------------
+// Host Runtime Start With Process
+// ------------------------------------------------------------
+// Start the runtime like _host_runtime_start and have scheduler 0
+// queue initial_process at NORMAL priority before entering its main
+// loop, so the first dispatch needs no cross-thread enqueue.
+//
+// Parameters:
+//   x0 (uint64_t) - num_schedulers: Number of schedulers (1 to MAX_CORES)
+//   x1 (void*) - initial_process: PCB to run first, or NULL
+//
+// Returns:
+//   x0 (void*) - runtime: Runtime handle, or NULL on failure
+//
+// Complexity: O(n) where n is num_schedulers
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_host_runtime_start_with_process:
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+
+    isb
+    mrs x24, CNTVCT_EL0  // begin tick
+
+    // Validate parameters
+    cbz x0, host_start_invalid
+    cmp x0, #MAX_CORES
+    b.hi host_start_invalid
+    mov x20, x0  // num_schedulers
+    mov x23, x1  // initial_process
+
+    // Allocate the runtime structure
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, #runtime_size             // length = runtime_size bytes
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq host_start_invalid
+    mov x19, x0  // runtime
+    str x20, [x19, #runtime_count]
+    str xzr, [x19, #runtime_started]
+    str x24, [x19, #runtime_begin_tick]
+
+    // Shared scheduler states
+    mov x0, x20
+    bl _scheduler_state_init
+    cbz x0, host_start_free_runtime
+    str x0, [x19, #runtime_states]
+    isb
+    mrs x0, CNTVCT_EL0
+    str x0, [x19, #runtime_states_tick]
+
+    // One thread per scheduler
+    mov x21, #0  // core_id
+host_start_thread:
+    cmp x21, x20
+    b.hs host_start_done
+    add x22, x19, #runtime_args
+    add x22, x22, x21, lsl #5         // start block
+    ldr x0, [x19, #runtime_states]
+    stp x0, x21, [x22, #start_block_states]
+    cmp x21, #0
+    csel x0, x23, xzr, eq             // initial process goes to scheduler 0
+    stp x0, xzr, [x22, #start_block_initial]
+
+    add x0, x19, #runtime_threads
+    add x0, x0, x21, lsl #3           // &threads[core_id]
+    mov x1, xzr                       // default attributes
+    adr x2, _host_scheduler_thread
+    mov x3, x22
+    bl _pthread_create
+    cbnz x0, host_start_thread_failed
+
+    add x21, x21, #1
+    str x21, [x19, #runtime_started]
+    b host_start_thread
+
+host_start_done:
+    isb
+    mrs x0, CNTVCT_EL0
+    str x0, [x19, #runtime_threads_tick]
+    mov x0, x19
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+host_start_thread_failed:
+    // Unwind: stop and join what is running, then release everything
+    mov x0, x19
+    bl _host_runtime_stop
+    mov x0, x19
+    bl _host_runtime_join
+    mov x0, #0
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+host_start_free_runtime:
+    mov x0, x19
+    mov x1, #runtime_size
+    bl _munmap
+
+host_start_invalid:
+    mov x0, #0
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Host Scheduler Thread (internal)
+// ------------------------------------------------------------
+// pthread entry point for one scheduler. Stamps the block's online
+// tick before handing the thread to the scheduler.
+//
+// Parameters:
+//   x0 (void*) - start_block: Start block for this scheduler
+//
+// Returns:
+//   x0 (void*) - result: Always NULL
+//
+// Complexity: Runs until the scheduler is stopped
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_host_scheduler_thread:
+    stp x29, x30, [sp, #-16]!
+    mov x29, sp
+    isb
+    mrs x1, CNTVCT_EL0
+    add x2, x0, #start_block_online_tick
+    stlr x1, [x2]
+    ldr x2, [x0, #start_block_initial]
+    ldp x0, x1, [x0, #start_block_states]
+    bl _scheduler_core_start
+    mov x0, #0
+    ldp x29, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Host Runtime States
+// ------------------------------------------------------------
+// Return the scheduler states array shared by the runtime's threads,
+// for reading statistics and handing processes to a scheduler with
+// _scheduler_inject_process, the only enqueue safe from this thread.
+//
+// Parameters:
+//   x0 (void*) - runtime: Runtime handle
+//
+// Returns:
+//   x0 (void*) - scheduler_states: States array, or NULL if runtime is NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_host_runtime_states:
+    cbz x0, host_states_done
+    ldr x0, [x0, #runtime_states]
+host_states_done:
+    ret
+
+// ------------------------------------------------------------
+// Host Runtime Scheduler Count
+// ------------------------------------------------------------
+// Return the number of schedulers the runtime was started with.
+//
+// Parameters:
+//   x0 (void*) - runtime: Runtime handle
+//
+// Returns:
+//   x0 (uint64_t) - count: Scheduler count, or 0 if runtime is NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_host_runtime_scheduler_count:
+    cbz x0, host_count_done
+    ldr x0, [x0, #runtime_count]
+host_count_done:
+    ret
+
+// ------------------------------------------------------------
+// Host Runtime Startup Ticks
+// ------------------------------------------------------------
+// Report how long a startup phase took to complete, measured from
+// entry to _host_runtime_start, in counter ticks (convert with
+// _clock_ticks_to_ns).
+//
+// Parameters:
+//   x0 (void*) - runtime: Runtime handle
+//   x1 (uint64_t) - phase: HOST_PHASE_STATES (0), HOST_PHASE_THREADS (1)
+//                  or HOST_PHASE_ONLINE (2)
+//
+// Returns:
+//   x0 (uint64_t) - ticks: Ticks from start to the end of the phase, or
+//                  0 if the phase has not completed or arguments are invalid
+//
+// Complexity: O(n) for HOST_PHASE_ONLINE, O(1) otherwise
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_host_runtime_startup_ticks:
+    cbz x0, host_startup_none
+    ldr x2, [x0, #runtime_begin_tick]
+    cmp x1, #HOST_PHASE_STATES
+    b.eq host_startup_states
+    cmp x1, #HOST_PHASE_THREADS
+    b.eq host_startup_threads
+    cmp x1, #HOST_PHASE_ONLINE
+    b.ne host_startup_none
+
+    // Latest online tick; every started scheduler must have stamped one
+    ldr x3, [x0, #runtime_count]
+    ldr x4, [x0, #runtime_started]
+    cmp x4, x3
+    b.lo host_startup_none
+    add x5, x0, #runtime_args
+    add x5, x5, #start_block_online_tick
+    mov x6, #0  // latest
+host_startup_online_loop:
+    cbz x3, host_startup_online_done
+    ldar x7, [x5]
+    cbz x7, host_startup_none
+    cmp x7, x6
+    csel x6, x7, x6, hi
+    add x5, x5, #start_block_size
+    sub x3, x3, #1
+    b host_startup_online_loop
+host_startup_online_done:
+    sub x0, x6, x2
+    ret
+
+host_startup_states:
+    ldr x3, [x0, #runtime_states_tick]
+    sub x0, x3, x2
+    ret
+
+host_startup_threads:
+    ldr x3, [x0, #runtime_threads_tick]
+    cbz x3, host_startup_none
+    sub x0, x3, x2
+    ret
+
+host_startup_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Host Runtime Stop
+// ------------------------------------------------------------
+// Ask every scheduler to leave its main loop, waking sleeping ones.
+// Does not wait; use _host_runtime_join for that.
+//
+// Parameters:
+//   x0 (void*) - runtime: Runtime handle
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if runtime is NULL
+//
+// Complexity: O(n) where n is the scheduler count
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_host_runtime_stop:
+    cbz x0, host_stop_invalid
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+
+    mov x19, x0
+    ldr x20, [x19, #runtime_count]
+    mov x21, #0
+host_stop_loop:
+    cmp x21, x20
+    b.hs host_stop_done
+    ldr x0, [x19, #runtime_states]
+    mov x1, x21
+    bl _scheduler_request_stop
+    add x21, x21, #1
+    b host_stop_loop
+
+host_stop_done:
+    mov x0, #1
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+host_stop_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Host Runtime Join
+// ------------------------------------------------------------
+// Wait for every started scheduler thread to exit, then destroy the
+// timer wheels, any perf counters, the scheduler states and the
+// runtime itself. Call after _host_runtime_stop; the handle is invalid
+// afterwards.
+//
+// Parameters:
+//   x0 (void*) - runtime: Runtime handle
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if runtime is NULL
+//
+// Complexity: O(n) plus the time for threads to stop
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_host_runtime_join:
+    cbz x0, host_join_invalid
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+
+    mov x19, x0
+    ldr x20, [x19, #runtime_started]
+    mov x21, #0
+host_join_loop:
+    cmp x21, x20
+    b.hs host_join_teardown
+    add x0, x19, #runtime_threads
+    ldr x0, [x0, x21, lsl #3]
+    mov x1, xzr
+    bl _pthread_join
+    add x21, x21, #1
+    b host_join_loop
+
+host_join_teardown:
+    // Wheels and counters first (nodes may have moved between wheels),
+    // then states
+    ldr x20, [x19, #runtime_count]
+    mov x21, #0
+host_join_wheels:
+    cmp x21, x20
+    b.hs host_join_states
+    ldr x0, [x19, #runtime_states]
+    mov x1, x21
+    bl _timer_wheel_destroy
+    ldr x0, [x19, #runtime_states]
+    mov x1, x21
+    bl _perf_close
+    add x21, x21, #1
+    b host_join_wheels
+
+host_join_states:
+    ldr x0, [x19, #runtime_states]
+    bl _scheduler_state_destroy
+
+    mov x0, x19
+    mov x1, #runtime_size
+    bl _munmap
+
+    mov x0, #1
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+host_join_invalid:
+    mov x0, #0
+    ret
+
+// Import required functions from other modules
+    .extern _mmap
+    .extern _munmap
+    .extern _pthread_create
+    .extern _pthread_join
+    .extern _scheduler_state_init
+    .extern _scheduler_state_destroy
+    .extern _scheduler_core_start
+    .extern _scheduler_request_stop
+    .extern _timer_wheel_destroy
+    .extern _perf_close
+
+// ------------------------------------------------------------
+// Constant Definitions for C Code
+// ------------------------------------------------------------
+    .data
+    .align 3
+
+_HOST_RUNTIME_SIZE:
+    .quad runtime_size
+
+_HOST_RUNTIME_SIZE_CONST:
+    .quad runtime_size
@@ -0,0 +1,573 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// idle.s — Tickless Idle for Schedulers
+// ------------------------------------------------------------
+// Lets a scheduler with nothing to run park until its next timer
+// deadline or until another core hands it work, instead of spinning
+// in the main loop. The deadline comes from the scheduler's timer
+// wheel (_timer_wheel_next_deadline), so timers keep their precision
+// and an idle node uses close to no CPU.
+//
+// Each scheduler state holds a 32-bit idle word. The sleeper stores
+// IDLE_SLEEPING, re-checks for work and then waits on the word; a
+// waker clears it and signals. Both sides put a full barrier between
+// publishing and checking, so a wakeup cannot be lost.
+//
+// The wait primitive depends on the platform, selected when assembling:
+//   --defsym ACTLY_BARE_METAL=1 - wfe with a CNTV compare-value event
+//   --defsym ACTLY_LINUX=1      - futex with a relative timeout
+//   (default, macOS)            - __ulock_wait with a microsecond timeout
+//
+// The file provides:
+//   - Idle sleep until the next timer deadline
+//   - Remote wakeup of a sleeping scheduler
+//   - Per-platform wait and wake primitives
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// ------------------------------------------------------------
+// Idle Function Exports
+// ------------------------------------------------------------
+// Export the idle functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _scheduler_idle_sleep
+    .global _scheduler_wake
+    .global _scheduler_is_sleeping
+
+// ------------------------------------------------------------
+// Offsets Used Here
+// ------------------------------------------------------------
+// Scheduler state offsets (shared with scheduler.s) and the timer wheel
+// inbox offset (matching timer.s).
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .include "scheduler_state.inc"
+    .equ wheel_inbox, 128
+
+    // Platform wait/wake constants
+    .equ FUTEX_WAIT_PRIVATE, 128
+    .equ FUTEX_WAKE_PRIVATE, 129
+    .equ SYS_FUTEX, 98
+    .equ UL_COMPARE_AND_WAIT_NO_ERRNO, 0x01000001
+    .equ NS_PER_SECOND, 1000000000
+    .equ US_PER_SECOND, 1000000
+    .equ IDLE_FALLBACK_FREQUENCY, 24000000
+
+// ------------------------------------------------------------
+// Scheduler Idle Sleep
+// ------------------------------------------------------------
+// Park an idle scheduler until its earliest timer deadline (expiry
+// plus slack) or until _scheduler_wake is called for it. Returns
+// without sleeping if work is already queued, a process or timer
+// handed over by another thread is waiting in an inbox, a stop has
+// been requested, or the deadline has passed. Spurious returns are
+// harmless; the main loop simply runs another iteration. A scheduler under virtual time (sim.s) never
+// sleeps: the simulator advances the clock to the next deadline.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Calling core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (int) - slept: 1 if the scheduler waited, 0 if it did not
+//
+// Complexity: O(1) plus the time asleep
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_scheduler_idle_sleep:
+    cbz x0, idle_sleep_invalid
+    cmp x1, #MAX_CORES
+    b.hs idle_sleep_invalid
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0               // scheduler state address
+    ldr w3, [x2, #scheduler_flags]
+    tbnz w3, #SCHEDULER_FLAG_VIRTUAL_TIME, idle_sleep_invalid
+
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+
+    mov x19, x2
+
+    // Earliest must-fire-by time on this core's wheel
+    bl _timer_wheel_next_deadline
+    mov x20, x0
+
+    // Announce the sleep, then look for work once more
+    add x21, x19, #scheduler_idle_word
+    mov w0, #IDLE_SLEEPING
+    str w0, [x21]
+    dmb ish
+
+    mov x0, x19
+    bl _idle_has_work
+    cbnz x0, idle_sleep_abort
+    isb
+    mrs x0, CNTVCT_EL0
+    cmp x0, x20
+    b.hs idle_sleep_abort
+
+    mov x0, x21
+    mov x1, x20
+    bl _idle_platform_wait
+    mov x0, #1
+    b idle_sleep_done
+
+idle_sleep_abort:
+    mov x0, #0
+
+idle_sleep_done:
+    stlr wzr, [x21]
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+idle_sleep_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Scheduler Wake
+// ------------------------------------------------------------
+// Wake a scheduler parked in _scheduler_idle_sleep. Call after
+// publishing work for that scheduler (injecting a process or pushing
+// a timer to its wheel inbox). Cheap when the target is awake: one
+// barrier and one load.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Scheduler to wake (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (int) - woken: 1 if the scheduler was sleeping, 0 otherwise
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_scheduler_wake:
+    cbz x0, scheduler_wake_none
+    cmp x1, #MAX_CORES
+    b.hs scheduler_wake_none
+
+    mov x2, #scheduler_size
+    madd x0, x1, x2, x0
+    add x0, x0, #scheduler_idle_word
+
+    // Publish the caller's work before reading the idle word
+    dmb ish
+scheduler_wake_swap:
+    ldaxr w1, [x0]
+    cmp w1, #IDLE_SLEEPING
+    b.ne scheduler_wake_clear
+    stlxr w2, wzr, [x0]
+    cbnz w2, scheduler_wake_swap
+    b _idle_platform_wake
+
+scheduler_wake_clear:
+    clrex
+scheduler_wake_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Scheduler Is Sleeping
+// ------------------------------------------------------------
+// Report whether a scheduler is currently parked.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (int) - sleeping: 1 if parked, 0 otherwise
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_scheduler_is_sleeping:
+    cbz x0, scheduler_is_sleeping_no
+    cmp x1, #MAX_CORES
+    b.hs scheduler_is_sleeping_no
+    mov x2, #scheduler_size
+    madd x0, x1, x2, x0
+    add x0, x0, #scheduler_idle_word
+    ldar w0, [x0]
+    cmp w0, #IDLE_SLEEPING
+    cset x0, eq
+    ret
+scheduler_is_sleeping_no:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Idle Has Work (internal)
+// ------------------------------------------------------------
+// Check whether a scheduler has anything to do: a pending stop
+// request, a non-empty run queue, processes injected by other threads
+// or timers waiting in its wheel inbox.
+//
+// Parameters:
+//   x0 (void*) - state: Scheduler state address
+//
+// Returns:
+//   x0 (int) - has_work: 1 if work is pending, 0 otherwise
+//
+// Complexity: O(NUM_PRIORITIES)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_idle_has_work:
+    ldr w1, [x0, #scheduler_stop_requested]
+    cbnz w1, idle_has_work_yes
+    add x1, x0, #scheduler_queues
+    mov x2, #NUM_PRIORITIES
+idle_has_work_queue:
+    ldr w3, [x1, #queue_count]
+    cbnz w3, idle_has_work_yes
+    add x1, x1, #queue_size
+    subs x2, x2, #1
+    b.ne idle_has_work_queue
+
+    ldr x1, [x0, #scheduler_inbox]
+    cbnz x1, idle_has_work_yes
+
+    ldr x1, [x0, #scheduler_timer_wheel]
+    cbz x1, idle_has_work_no
+    ldr x1, [x1, #wheel_inbox]
+    cbnz x1, idle_has_work_yes
+
+idle_has_work_no:
+    mov x0, #0
+    ret
+idle_has_work_yes:
+    mov x0, #1
+    ret
+
+.ifdef ACTLY_BARE_METAL
+// ------------------------------------------------------------
+// Idle Platform Wait (internal, bare metal)
+// ------------------------------------------------------------
+// Program the virtual timer compare value to the deadline and wait
+// for events. The timer firing, a sev from the waker, or the waker's
+// store clearing our exclusive monitor on the idle word each end the
+// wfe; the loop then re-checks the word and the counter.
+//
+// Parameters:
+//   x0 (uint32_t*) - word: Idle word
+//   x1 (uint64_t) - deadline: Absolute counter value, UINT64_MAX for none
+//
+// Returns:
+//   None
+//
+// Complexity: O(1) plus the time asleep
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_idle_platform_wait:
+    cmn x1, #1
+    b.eq idle_wait_loop
+    msr CNTV_CVAL_EL0, x1
+    mov x2, #1                        // ENABLE, interrupt not masked
+    msr CNTV_CTL_EL0, x2
+    isb
+
+idle_wait_loop:
+    ldaxr w2, [x0]                    // arm the monitor on the idle word
+    cmp w2, #IDLE_SLEEPING
+    b.ne idle_wait_done
+    isb
+    mrs x3, CNTVCT_EL0
+    cmp x3, x1
+    b.hs idle_wait_done
+    wfe
+    b idle_wait_loop
+
+idle_wait_done:
+    clrex
+    msr CNTV_CTL_EL0, xzr
+    isb
+    ret
+
+// ------------------------------------------------------------
+// Idle Platform Wake (internal, bare metal)
+// ------------------------------------------------------------
+// Signal an event to all cores waiting in wfe.
+//
+// Parameters:
+//   x0 (uint32_t*) - word: Idle word (already cleared)
+//
+// Returns:
+//   x0 (int) - woken: Always 1
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_idle_platform_wake:
+    dsb ish
+    sev
+    mov x0, #1
+    ret
+
+.else
+.ifdef ACTLY_LINUX
+// ------------------------------------------------------------
+// Idle Platform Wait (internal, Linux)
+// ------------------------------------------------------------
+// futex(word, FUTEX_WAIT_PRIVATE, IDLE_SLEEPING, timeout). The kernel
+// returns at once if the word no longer holds IDLE_SLEEPING. The
+// relative timeout is rounded up so the scheduler never wakes before
+// the deadline.
+//
+// Parameters:
+//   x0 (uint32_t*) - word: Idle word
+//   x1 (uint64_t) - deadline: Absolute counter value, UINT64_MAX for none
+//
+// Returns:
+//   None
+//
+// Complexity: O(1) plus the time asleep
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_idle_platform_wait:
+    stp x29, x30, [sp, #-32]!
+    mov x29, sp
+    mov x9, x0
+
+    mov x3, xzr                       // no timeout
+    cmn x1, #1
+    b.eq idle_wait_call
+
+    // ticks until the deadline
+    isb
+    mrs x2, CNTVCT_EL0
+    subs x2, x1, x2
+    b.ls idle_wait_return
+    mrs x3, CNTFRQ_EL0
+    cbnz x3, idle_wait_have_frequency
+    movz x3, #(IDLE_FALLBACK_FREQUENCY & 0xFFFF)
+    movk x3, #(IDLE_FALLBACK_FREQUENCY >> 16), lsl #16
+idle_wait_have_frequency:
+    // tv_sec = ticks / freq, tv_nsec = ceil((ticks % freq) * 1e9 / freq)
+    udiv x4, x2, x3
+    msub x5, x4, x3, x2
+    movz x6, #(NS_PER_SECOND & 0xFFFF)
+    movk x6, #(NS_PER_SECOND >> 16), lsl #16
+    mul x5, x5, x6
+    add x5, x5, x3
+    sub x5, x5, #1
+    udiv x5, x5, x3
+    cmp x5, x6
+    b.lo idle_wait_store_timeout
+    add x4, x4, #1
+    sub x5, x5, x6
+idle_wait_store_timeout:
+    stp x4, x5, [sp, #16]
+    add x3, sp, #16
+
+idle_wait_call:
+    mov x0, x9
+    mov x1, #FUTEX_WAIT_PRIVATE
+    mov w2, #IDLE_SLEEPING
+    mov x4, xzr
+    mov x5, xzr
+    mov x8, #SYS_FUTEX
+    svc #0
+
+idle_wait_return:
+    ldp x29, x30, [sp], #32
+    ret
+
+// ------------------------------------------------------------
+// Idle Platform Wake (internal, Linux)
+// ------------------------------------------------------------
+// futex(word, FUTEX_WAKE_PRIVATE, 1).
+//
+// Parameters:
+//   x0 (uint32_t*) - word: Idle word (already cleared)
+//
+// Returns:
+//   x0 (int) - woken: Always 1
+//
+// Complexity: O(1) - One system call
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_idle_platform_wake:
+    mov x1, #FUTEX_WAKE_PRIVATE
+    mov x2, #1
+    mov x8, #SYS_FUTEX
+    svc #0
+    mov x0, #1
+    ret
+
+.else
+// ------------------------------------------------------------
+// Idle Platform Wait (internal, macOS)
+// ------------------------------------------------------------
+// __ulock_wait(UL_COMPARE_AND_WAIT | ULF_NO_ERRNO, word, IDLE_SLEEPING,
+// timeout_us), the primitive behind libc++ atomic waits. Returns at
+// once if the word no longer holds IDLE_SLEEPING. The timeout is
+// rounded up to whole microseconds and capped at UINT32_MAX; a zero
+// timeout means wait forever.
+//
+// Parameters:
+//   x0 (uint32_t*) - word: Idle word
+//   x1 (uint64_t) - deadline: Absolute counter value, UINT64_MAX for none
+//
+// Returns:
+//   None
+//
+// Complexity: O(1) plus the time asleep
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_idle_platform_wait:
+    stp x29, x30, [sp, #-16]!
+    mov x29, sp
+    mov x9, x0
+
+    mov x3, xzr                       // wait forever
+    cmn x1, #1
+    b.eq idle_wait_call
+
+    // ticks until the deadline
+    isb
+    mrs x2, CNTVCT_EL0
+    subs x2, x1, x2
+    b.ls idle_wait_return
+    mrs x3, CNTFRQ_EL0
+    cbnz x3, idle_wait_have_frequency
+    movz x3, #(IDLE_FALLBACK_FREQUENCY & 0xFFFF)
+    movk x3, #(IDLE_FALLBACK_FREQUENCY >> 16), lsl #16
+idle_wait_have_frequency:
+    // us = (ticks / freq) * 1e6 + ceil((ticks % freq) * 1e6 / freq)
+    udiv x4, x2, x3
+    msub x5, x4, x3, x2
+    movz x6, #(US_PER_SECOND & 0xFFFF)
+    movk x6, #(US_PER_SECOND >> 16), lsl #16
+    mul x5, x5, x6
+    add x5, x5, x3
+    sub x5, x5, #1
+    udiv x5, x5, x3
+    mov x7, #0xFFFFFFFF
+    mov x8, #4295                     // whole seconds past UINT32_MAX us
+    cmp x4, x8
+    b.hs idle_wait_cap
+    madd x3, x4, x6, x5
+    cmp x3, x7
+    b.ls idle_wait_call
+idle_wait_cap:
+    mov x3, x7
+
+idle_wait_call:
+    movz x0, #(UL_COMPARE_AND_WAIT_NO_ERRNO & 0xFFFF)
+    movk x0, #(UL_COMPARE_AND_WAIT_NO_ERRNO >> 16), lsl #16
+    mov x1, x9
+    mov w2, #IDLE_SLEEPING
+    bl ___ulock_wait
+
+idle_wait_return:
+    ldp x29, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Idle Platform Wake (internal, macOS)
+// ------------------------------------------------------------
+// __ulock_wake(UL_COMPARE_AND_WAIT | ULF_NO_ERRNO, word, 0).
+//
+// Parameters:
+//   x0 (uint32_t*) - word: Idle word (already cleared)
+//
+// Returns:
+//   x0 (int) - woken: Always 1
+//
+// Complexity: O(1) - One system call
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_idle_platform_wake:
+    stp x29, x30, [sp, #-16]!
+    mov x29, sp
+    mov x1, x0
+    movz x0, #(UL_COMPARE_AND_WAIT_NO_ERRNO & 0xFFFF)
+    movk x0, #(UL_COMPARE_AND_WAIT_NO_ERRNO >> 16), lsl #16
+    mov x2, xzr
+    bl ___ulock_wake
+    mov x0, #1
+    ldp x29, x30, [sp], #16
+    ret
+
+    .extern ___ulock_wait
+    .extern ___ulock_wake
+.endif
+.endif
+
+// Import required functions from other modules
+    .extern _timer_wheel_next_deadline
@@ -0,0 +1,1146 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// interp.s — Behavior Template Interpreter
+// ------------------------------------------------------------
+// Runs behavior templates (Map, Filter, Reduce, For Each, State
+// Update, Message) compiled to a compact bytecode inside a process.
+//
+// Bytecode is one 32-bit word per instruction (see INTERP_OP_* in
+// config.inc) over sixteen term registers. Loading a program checks
+// every instruction once and translates it to direct-threaded code:
+// a 16-byte slot per instruction holding the handler address and the
+// operands pre-decoded to register byte offsets, jump byte deltas and
+// tagged immediates. Each handler ends by charging one reduction,
+// loading the next slot and branching to its handler, so dispatch is
+// one load pair and one indirect branch with no central loop.
+//
+// Handlers live in a table of fixed INTERP_HANDLER_SIZE slots, so
+// the loader finds a handler by opcode without an address table in
+// text (Mach-O has no text relocations). Longer operations branch to
+// out-of-line code that dispatches the same way.
+//
+// Hot instructions can be compiled to native code with jit.s, which
+// patches their slots to enter it; native code keeps the same frame,
+// registers and reduction accounting, and leaves through the entry
+// points recorded in the program header, so one run moves freely
+// between interpreted and native instructions.
+//
+// Reductions come from the scheduler's current budget for the core,
+// the count _scheduler_decrement_reductions manages. Every instruction
+// boundary is a safe point: all interpreter state lives in the frame,
+// so when the budget runs out interp_run saves the pc and returns
+// INTERP_YIELD, and the next interp_run carries on. Lists and tuples
+// are built on the process heap with term.s.
+//
+// The templates map onto the bytecode as:
+//   - For Each: a NEXT loop around a CALL or SEND
+//   - Map: a NEXT loop consing each result, then REVERSE
+//   - Filter: a NEXT loop with a conditional jump around the CONS,
+//     testing with MEMBER where the test is a Set (set.s)
+//   - Reduce: a NEXT loop folding into an accumulator register
+//   - State Update: UPDATE on the state tuple
+//   - Message: SEND
+//
+// The file provides:
+//   - Bytecode validation and translation to threaded code
+//   - Process-bound interpreter frames
+//   - The threaded interpreter with reduction accounting
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// Include the PCB layout
+    .include "pcb.inc"
+
+// External term functions
+    .extern _term_cons
+    .extern _term_tuple
+
+// External set functions
+    .extern _set_contains
+
+// External C library functions for memory management
+    .extern _mmap
+    .extern _munmap
+
+// ------------------------------------------------------------
+// Interpreter Function Exports
+// ------------------------------------------------------------
+// Export the interpreter functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _interp_load
+    .global _interp_program_destroy
+    .global _interp_frame_init
+    .global _interp_set_register
+    .global _interp_get_register
+    .global _interp_set_send
+    .global _interp_run
+    .global _interp_result
+    .global _interp_pc
+    .global _INTERP_FRAME_SIZE_CONST
+
+// ------------------------------------------------------------
+// Scheduler Structure Offsets (shared with scheduler.s)
+// ------------------------------------------------------------
+    .include "scheduler_state.inc"
+
+// ------------------------------------------------------------
+// Program and Frame Layout
+// ------------------------------------------------------------
+// A program is one mapping: a 96-byte header, the threaded code
+// (count slots plus a final slot that catches running off the end)
+// and the literals. The header also lists the native code mappings
+// compiled for the program and the entry points native code leaves
+// through (jit.s reads these). A frame is INTERP_FRAME_SIZE bytes of caller
+// memory: fields, the registers and the CALL return stack.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ interp_program_length, 0     // Mapping length for munmap (8 bytes)
+    .equ interp_program_count, 8      // Instructions (8 bytes)
+    .equ interp_program_literal_count, 16 // Literals (8 bytes)
+    .equ interp_program_literals, 24  // Literal array (8 bytes)
+    .equ interp_program_code, 32      // Threaded code (8 bytes)
+    .equ interp_program_native, 40    // Native mappings, linked by jit.s (8 bytes)
+    .equ interp_program_handlers, 48  // Handler table (8 bytes)
+    .equ interp_program_dispatch, 56  // Charge and enter the slot at x20 (8 bytes)
+    .equ interp_program_yield, 64     // Yield before the slot at x20 (8 bytes)
+    .equ interp_program_badarg, 72    // Fail the slot before x20 (8 bytes)
+    .equ interp_program_heap_full, 80 // Heap full in the slot before x20 (8 bytes)
+    .equ interp_program_tuple, 88     // _term_tuple (8 bytes)
+    .equ interp_program_header_size, 96
+
+    .equ interp_frame_program, 0      // Loaded program (8 bytes)
+    .equ interp_frame_pcb, 8          // Process whose heap is used (8 bytes)
+    .equ interp_frame_pc, 16          // Next instruction index (8 bytes)
+    .equ interp_frame_depth, 24       // Active CALLs (8 bytes)
+    .equ interp_frame_send, 32        // int send(arg, pid, msg), or NULL (8 bytes)
+    .equ interp_frame_send_argument, 40 // First send argument (8 bytes)
+    .equ interp_frame_result, 48      // HALT result, TERM_NONE before (8 bytes)
+    .equ interp_frame_scheduler, 56   // Scheduler state during a run (8 bytes)
+    .equ interp_frame_registers, 64   // INTERP_REGISTERS terms (128 bytes)
+    .equ interp_frame_stack, 192      // INTERP_MAX_DEPTH return slots (256 bytes)
+
+    // Handler slot that enters native code at the operand address
+    .equ INTERP_NATIVE_SLOT, INTERP_OP_COUNT + 1
+
+    // Threaded code slot: handler address, then the operand word with
+    // A * 8 in bits 0-15, B * 8 in bits 16-31 and the third operand
+    // (C * 8, a jump byte delta, a literal byte offset, a tagged
+    // integer or an element index) in bits 32-63
+    .equ INTERP_SLOT_SIZE, 16
+    .equ INTERP_HANDLER_SHIFT, 7
+    .equ INTERP_HANDLER_SIZE, 128
+
+    // How the loader turns K (or C) into the third operand
+    .equ INTERP_CLASS_NONE, 0         // Unused
+    .equ INTERP_CLASS_REG, 1          // Register C
+    .equ INTERP_CLASS_JUMP, 2         // Signed instruction delta
+    .equ INTERP_CLASS_LITERAL, 3      // Literal index
+    .equ INTERP_CLASS_INT, 4          // Signed small integer
+    .equ INTERP_CLASS_INDEX, 5        // Unsigned index or arity
+
+// ------------------------------------------------------------
+// Dispatch Macros
+// ------------------------------------------------------------
+// INTERP_DISPATCH charges one reduction and enters the next handler
+// with its operand word in x10, or leaves with INTERP_YIELD (the pc
+// still on that instruction) once the budget is spent. The operand
+// macros extract A and B byte offsets, the unsigned third operand and
+// the signed third operand.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+.macro INTERP_DISPATCH
+    subs x22, x22, #1
+    b.mi interp_yield
+    ldp x9, x10, [x20], #INTERP_SLOT_SIZE
+    br x9
+.endm
+
+.macro INTERP_A reg
+    and \reg, x10, #0xFFFF
+.endm
+
+.macro INTERP_B reg
+    ubfx \reg, x10, #16, #16
+.endm
+
+.macro INTERP_C reg
+    lsr \reg, x10, #32
+.endm
+
+.macro INTERP_K reg
+    asr \reg, x10, #32
+.endm
+
+.macro INTERP_HANDLER op
+    .org interp_handlers + ((\op) << INTERP_HANDLER_SHIFT)
+.endm
+
+// Leave the arity word of tuple \term in \header, or fail with
+// INTERP_BADARG if it is not a tuple or \index is out of range
+.macro INTERP_TUPLE_CHECK term, index, header, scratch
+    and \scratch, \term, #TERM_TAG_MASK
+    cmp \scratch, #TERM_TAG_BOXED
+    b.ne interp_badarg
+    ldur \header, [\term, #-TERM_TAG_BOXED]
+    and \scratch, \header, #0xFF
+    cmp \scratch, #TERM_HEADER_TUPLE
+    b.ne interp_badarg
+    cmp \index, \header, lsr #TERM_HEADER_ARITY_SHIFT
+    b.hs interp_badarg
+.endm
+
+// ------------------------------------------------------------
+// Interpreter Load
+// ------------------------------------------------------------
+// Check a bytecode program and translate it to threaded code.
+// Every jump must land on an instruction of the program and every
+// LOADK must name a literal; registers are always in range. Literals
+// are copied, but boxed literals are referenced and must outlive the
+// program.
+//
+// Parameters:
+//   x0 (const uint32_t*) - code: Bytecode
+//   x1 (uint64_t) - count: Instructions, 1 to INTERP_MAX_CODE
+//   x2 (const term_t*) - literals: Literal terms, or NULL if none
+//   x3 (uint64_t) - literal_count: Literals, up to INTERP_MAX_LITERALS
+//
+// Returns:
+//   x0 (void*) - program: Loaded program, or NULL on invalid bytecode
+//                or arguments, or a failed mapping
+//
+// Complexity: O(count + literal_count)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_interp_load:
+    cbz x0, interp_load_invalid
+    cbz x1, interp_load_invalid
+    cmp x1, #INTERP_MAX_CODE
+    b.hi interp_load_invalid
+    cmp x3, #INTERP_MAX_LITERALS
+    b.hi interp_load_invalid
+    cbz x3, interp_load_args_ok
+    cbz x2, interp_load_invalid
+interp_load_args_ok:
+    stp x29, x30, [sp, #-16]!
+    mov x29, sp
+    stp x19, x20, [sp, #-16]!
+    stp x21, x22, [sp, #-16]!
+    stp x23, x24, [sp, #-16]!
+    stp x25, x26, [sp, #-16]!
+    stp x27, x28, [sp, #-16]!
+
+    mov x19, x0                       // Bytecode
+    mov x20, x1                       // count
+    mov x21, x2                       // Caller's literals
+    mov x22, x3                       // literal_count
+
+    // Header, count + 1 slots, then the literals
+    add x23, x20, #1
+    lsl x23, x23, #4
+    add x23, x23, #interp_program_header_size
+    add x23, x23, x22, lsl #3         // Mapping length
+
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, x23                       // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq interp_load_failed
+    mov x24, x0
+
+    str x23, [x24, #interp_program_length]
+    str x20, [x24, #interp_program_count]
+    str x22, [x24, #interp_program_literal_count]
+    add x25, x24, #interp_program_header_size
+    str x25, [x24, #interp_program_code]
+    add x9, x20, #1
+    add x9, x25, x9, lsl #4           // Literals follow the code
+    str x9, [x24, #interp_program_literals]
+    str xzr, [x24, #interp_program_native]
+
+    // Entry points for native code
+    adr x10, interp_handlers
+    adr x11, interp_dispatch
+    stp x10, x11, [x24, #interp_program_handlers]
+    adr x10, interp_yield
+    adr x11, interp_badarg
+    stp x10, x11, [x24, #interp_program_yield]
+    adr x10, interp_heap_full
+    adr x11, interp_native_tuple
+    stp x10, x11, [x24, #interp_program_heap_full]
+
+    // Copy the literals
+    mov x10, #0
+interp_load_literals:
+    cmp x10, x22
+    b.hs interp_load_literals_done
+    ldr x11, [x21, x10, lsl #3]
+    str x11, [x9, x10, lsl #3]
+    add x10, x10, #1
+    b interp_load_literals
+interp_load_literals_done:
+
+    // Translate each instruction
+    adr x26, interp_handlers
+    adr x27, interp_op_classes
+    mov x28, #0                       // Instruction index
+interp_load_next:
+    ldr w9, [x19, x28, lsl #2]
+    and w10, w9, #0xFF                // Opcode
+    cmp w10, #INTERP_OP_COUNT
+    b.hs interp_load_bad_code
+    add x11, x26, x10, lsl #INTERP_HANDLER_SHIFT
+    ubfx x12, x9, #8, #4
+    lsl x12, x12, #3                  // A * 8
+    ubfx x13, x9, #12, #4
+    orr x12, x12, x13, lsl #19        // B * 8 in bits 16-31
+    ldrb w14, [x27, x10]
+
+    cmp w14, #INTERP_CLASS_REG
+    b.eq interp_load_reg
+    cmp w14, #INTERP_CLASS_JUMP
+    b.eq interp_load_jump
+    cmp w14, #INTERP_CLASS_LITERAL
+    b.eq interp_load_literal
+    cmp w14, #INTERP_CLASS_INT
+    b.eq interp_load_int
+    cmp w14, #INTERP_CLASS_INDEX
+    b.eq interp_load_index
+    mov x15, #0
+    b interp_load_store
+
+interp_load_reg:
+    ubfx x15, x9, #16, #4
+    lsl x15, x15, #3
+    b interp_load_store
+
+interp_load_jump:
+    sbfx x15, x9, #16, #16
+    add x13, x28, #1
+    add x13, x13, x15                 // Target instruction
+    cmp x13, x20
+    b.hs interp_load_bad_code         // Negative targets wrap high
+    lsl x15, x15, #4
+    b interp_load_store
+
+interp_load_literal:
+    ubfx x15, x9, #16, #16
+    cmp x15, x22
+    b.hs interp_load_bad_code
+    lsl x15, x15, #3
+    b interp_load_store
+
+interp_load_int:
+    sbfx x15, x9, #16, #16
+    lsl x15, x15, #TERM_INT_SHIFT
+    b interp_load_store
+
+interp_load_index:
+    ubfx x15, x9, #16, #16
+
+interp_load_store:
+    orr x12, x12, x15, lsl #32
+    add x13, x25, x28, lsl #4
+    stp x11, x12, [x13]
+    add x28, x28, #1
+    cmp x28, x20
+    b.lo interp_load_next
+
+    // Final slot: running off the end is an error
+    add x11, x26, #(INTERP_OP_COUNT << INTERP_HANDLER_SHIFT)
+    add x13, x25, x28, lsl #4
+    stp x11, xzr, [x13]
+
+    mov x0, x24
+    b interp_load_return
+
+interp_load_bad_code:
+    mov x0, x24
+    mov x1, x23
+    bl _munmap
+
+interp_load_failed:
+    mov x0, #0
+
+interp_load_return:
+    ldp x27, x28, [sp], #16
+    ldp x25, x26, [sp], #16
+    ldp x23, x24, [sp], #16
+    ldp x21, x22, [sp], #16
+    ldp x19, x20, [sp], #16
+    ldp x29, x30, [sp], #16
+    ret
+
+interp_load_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Interpreter Program Destroy
+// ------------------------------------------------------------
+// Unmap a program and any native code compiled for it. No frame may
+// still be running it.
+//
+// Parameters:
+//   x0 (void*) - program: Loaded program
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if program is NULL or munmap
+//              fails
+//
+// Complexity: O(native mappings)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_interp_program_destroy:
+    cbz x0, interp_program_destroy_invalid
+    stp x29, x30, [sp, #-16]!
+    stp x19, x20, [sp, #-16]!
+    mov x19, x0
+    ldr x20, [x19, #interp_program_native]
+interp_program_destroy_native:
+    cbz x20, interp_program_destroy_code
+    mov x0, x20
+    ldp x1, x20, [x20]                // Length, next (see jit.s)
+    bl _munmap
+    b interp_program_destroy_native
+interp_program_destroy_code:
+    mov x0, x19
+    ldr x1, [x19, #interp_program_length]
+    bl _munmap
+    cmp x0, #0
+    cset x0, eq
+    ldp x19, x20, [sp], #16
+    ldp x29, x30, [sp], #16
+    ret
+
+interp_program_destroy_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Interpreter Frame Init
+// ------------------------------------------------------------
+// Prepare a frame to run a program from its first instruction for a
+// process. Registers start as TERM_NIL; no send function is set.
+//
+// Parameters:
+//   x0 (void*) - frame: INTERP_FRAME_SIZE bytes, 8-byte aligned
+//   x1 (void*) - program: Loaded program
+//   x2 (void*) - pcb: Process whose heap holds built terms
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if any argument is NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_interp_frame_init:
+    cbz x0, interp_frame_init_invalid
+    cbz x1, interp_frame_init_invalid
+    cbz x2, interp_frame_init_invalid
+    stp x1, x2, [x0, #interp_frame_program]
+    stp xzr, xzr, [x0, #interp_frame_pc]
+    stp xzr, xzr, [x0, #interp_frame_send]
+    mov x9, #TERM_NONE
+    stp x9, xzr, [x0, #interp_frame_result]
+    mov x9, #TERM_NIL
+    add x10, x0, #interp_frame_registers
+    mov x11, #INTERP_REGISTERS
+interp_frame_init_registers:
+    str x9, [x10], #8
+    subs x11, x11, #1
+    b.ne interp_frame_init_registers
+    mov x0, #1
+    ret
+
+interp_frame_init_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Interpreter Set / Get Register
+// ------------------------------------------------------------
+// Pass arguments in and read values out between runs.
+//
+// Parameters:
+//   x0 (void*) - frame: Initialised frame
+//   x1 (uint64_t) - index: Register, below INTERP_REGISTERS
+//   x2 (term_t) - term: Value to store (set only)
+//
+// Returns:
+//   x0 - set: 1 on success, 0 on invalid arguments;
+//        get: the register, or TERM_NONE on invalid arguments
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_interp_set_register:
+    cbz x0, interp_set_register_invalid
+    cmp x1, #INTERP_REGISTERS
+    b.hs interp_set_register_invalid
+    add x9, x0, #interp_frame_registers
+    str x2, [x9, x1, lsl #3]
+    mov x0, #1
+    ret
+
+interp_set_register_invalid:
+    mov x0, #0
+    ret
+
+_interp_get_register:
+    cbz x0, interp_get_register_invalid
+    cmp x1, #INTERP_REGISTERS
+    b.hs interp_get_register_invalid
+    add x9, x0, #interp_frame_registers
+    ldr x0, [x9, x1, lsl #3]
+    ret
+
+interp_get_register_invalid:
+    mov x0, #TERM_NONE
+    ret
+
+// ------------------------------------------------------------
+// Interpreter Set Send
+// ------------------------------------------------------------
+// Set the function SEND calls as send(argument, pid, message). It
+// returns non-zero once the message is delivered; 0 makes the SEND
+// fail with INTERP_BADARG. Without a function every SEND fails.
+//
+// Parameters:
+//   x0 (void*) - frame: Initialised frame
+//   x1 (void*) - send: Send function, or NULL
+//   x2 (void*) - argument: First argument for send
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if frame is NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_interp_set_send:
+    cbz x0, interp_set_send_invalid
+    stp x1, x2, [x0, #interp_frame_send]
+    mov x0, #1
+    ret
+
+interp_set_send_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Interpreter Result / PC
+// ------------------------------------------------------------
+// The term HALT returned, and the index of the instruction the frame
+// will run next (or stopped on, after anything but INTERP_YIELD).
+//
+// Parameters:
+//   x0 (void*) - frame: Initialised frame
+//
+// Returns:
+//   x0 - result: HALT's term, or TERM_NONE before HALT or for NULL;
+//        pc: instruction index, 0 for NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_interp_result:
+    cbz x0, interp_result_invalid
+    ldr x0, [x0, #interp_frame_result]
+    ret
+
+interp_result_invalid:
+    mov x0, #TERM_NONE
+    ret
+
+_interp_pc:
+    cbz x0, interp_pc_invalid
+    ldr x0, [x0, #interp_frame_pc]
+interp_pc_invalid:
+    ret
+
+// ------------------------------------------------------------
+// Interpreter Run
+// ------------------------------------------------------------
+// Run a frame from its saved pc until HALT, an error, or the core's
+// reduction budget runs out. Each instruction costs one reduction
+// (REVERSE costs one more per element). The remaining budget is
+// written back to the scheduler state, so the scheduler charges the
+// process as it does native code.
+//
+// While running: x19 frame, x20 next slot, x21 registers, x22
+// budget, x23 literals, x24 pcb, x26 code, x27 call depth, x28
+// program; x25 is scratch across calls. Native code keeps the same
+// assignment.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Scheduler states
+//   x1 (uint64_t) - core_id: Core whose budget is charged
+//   x2 (void*) - frame: Initialised frame
+//
+// Returns:
+//   x0 (uint64_t) - status: INTERP_DONE (result in the frame),
+//                   INTERP_YIELD (resume with another run; the pc is
+//                   the next instruction), INTERP_HEAP_FULL (the pc is
+//                   the allocating instruction, which runs again on
+//                   resume) or INTERP_BADARG (the pc is the failing
+//                   instruction; also for invalid arguments)
+//
+// Complexity: O(instructions run)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_interp_run:
+    cbz x0, interp_run_invalid
+    cbz x2, interp_run_invalid
+    cmp x1, #MAX_CORES
+    b.hs interp_run_invalid
+    stp x29, x30, [sp, #-16]!
+    mov x29, sp
+    stp x19, x20, [sp, #-16]!
+    stp x21, x22, [sp, #-16]!
+    stp x23, x24, [sp, #-16]!
+    stp x25, x26, [sp, #-16]!
+    stp x27, x28, [sp, #-16]!
+
+    mov x19, x2
+    mov x9, #scheduler_size
+    madd x9, x1, x9, x0               // Scheduler state
+    str x9, [x19, #interp_frame_scheduler]
+    ldr x22, [x9, #scheduler_current_reductions]
+    ldr x28, [x19, #interp_frame_program]
+    ldr x23, [x28, #interp_program_literals]
+    ldr x26, [x28, #interp_program_code]
+    ldr x24, [x19, #interp_frame_pcb]
+    add x21, x19, #interp_frame_registers
+    ldr x27, [x19, #interp_frame_depth]
+    ldr x9, [x19, #interp_frame_pc]
+    add x20, x26, x9, lsl #4
+    INTERP_DISPATCH
+
+interp_run_invalid:
+    mov x0, #INTERP_BADARG
+    ret
+
+// Charge and enter the slot at x20 (native code leaving to a slot)
+interp_dispatch:
+    INTERP_DISPATCH
+
+// Native code calls BIFs through the program header
+interp_native_tuple:
+    b _term_tuple
+
+// Budget spent before the instruction at x20
+interp_yield:
+    mov x22, #0
+    mov x0, #INTERP_YIELD
+    b interp_exit
+
+// The instruction just fetched could not allocate; refund its charge
+interp_heap_full:
+    sub x20, x20, #INTERP_SLOT_SIZE
+    add x22, x22, #1
+    mov x0, #INTERP_HEAP_FULL
+    b interp_exit
+
+interp_badarg:
+    sub x20, x20, #INTERP_SLOT_SIZE
+    mov x0, #INTERP_BADARG
+
+interp_exit:
+    sub x9, x20, x26
+    lsr x9, x9, #4
+    str x9, [x19, #interp_frame_pc]
+    str x27, [x19, #interp_frame_depth]
+    cmp x22, #0
+    csel x22, x22, xzr, gt            // REVERSE may overdraw
+    ldr x9, [x19, #interp_frame_scheduler]
+    str x22, [x9, #scheduler_current_reductions]
+    ldp x27, x28, [sp], #16
+    ldp x25, x26, [sp], #16
+    ldp x23, x24, [sp], #16
+    ldp x21, x22, [sp], #16
+    ldp x19, x20, [sp], #16
+    ldp x29, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Instruction Handlers
+// ------------------------------------------------------------
+// One INTERP_HANDLER_SIZE slot per opcode, in opcode order, then the
+// slot for running off the end and the slot that enters native code.
+// Each is entered with the operand word
+// in x10 and x20 already past its own slot.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .align INTERP_HANDLER_SHIFT
+interp_handlers:
+
+INTERP_HANDLER INTERP_OP_HALT
+    INTERP_A x11
+    ldr x12, [x21, x11]
+    str x12, [x19, #interp_frame_result]
+    sub x20, x20, #INTERP_SLOT_SIZE   // Stay on HALT
+    mov x0, #INTERP_DONE
+    b interp_exit
+
+INTERP_HANDLER INTERP_OP_MOVE
+    INTERP_A x11
+    INTERP_B x12
+    ldr x13, [x21, x12]
+    str x13, [x21, x11]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_LOADK
+    INTERP_A x11
+    INTERP_C x12
+    ldr x13, [x23, x12]
+    str x13, [x21, x11]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_LOADI
+    INTERP_A x11
+    INTERP_K x12                      // Already tagged
+    str x12, [x21, x11]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_ADD
+    INTERP_A x11
+    INTERP_B x12
+    INTERP_C x13
+    ldr x12, [x21, x12]
+    ldr x13, [x21, x13]
+    orr x14, x12, x13
+    tst x14, #TERM_TAG_MASK
+    b.ne interp_badarg                // Not both integers
+    adds x12, x12, x13
+    b.vs interp_badarg
+    str x12, [x21, x11]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_SUB
+    INTERP_A x11
+    INTERP_B x12
+    INTERP_C x13
+    ldr x12, [x21, x12]
+    ldr x13, [x21, x13]
+    orr x14, x12, x13
+    tst x14, #TERM_TAG_MASK
+    b.ne interp_badarg
+    subs x12, x12, x13
+    b.vs interp_badarg
+    str x12, [x21, x11]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_MUL
+    INTERP_A x11
+    INTERP_B x12
+    INTERP_C x13
+    ldr x12, [x21, x12]
+    ldr x13, [x21, x13]
+    orr x14, x12, x13
+    tst x14, #TERM_TAG_MASK
+    b.ne interp_badarg
+    asr x13, x13, #TERM_INT_SHIFT
+    mul x14, x12, x13
+    smulh x15, x12, x13
+    cmp x15, x14, asr #63
+    b.ne interp_badarg                // Overflow
+    str x14, [x21, x11]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_ADDI
+    INTERP_A x11
+    INTERP_B x12
+    INTERP_K x13
+    ldr x12, [x21, x12]
+    tst x12, #TERM_TAG_MASK
+    b.ne interp_badarg
+    adds x12, x12, x13
+    b.vs interp_badarg
+    str x12, [x21, x11]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_JMP
+    INTERP_K x13
+    add x20, x20, x13
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_JEQ
+    INTERP_A x11
+    INTERP_B x12
+    INTERP_K x13
+    ldr x11, [x21, x11]
+    ldr x12, [x21, x12]
+    cmp x11, x12
+    csel x13, x13, xzr, eq
+    add x20, x20, x13
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_JNE
+    INTERP_A x11
+    INTERP_B x12
+    INTERP_K x13
+    ldr x11, [x21, x11]
+    ldr x12, [x21, x12]
+    cmp x11, x12
+    csel x13, x13, xzr, ne
+    add x20, x20, x13
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_JLT
+    INTERP_A x11
+    INTERP_B x12
+    INTERP_K x13
+    ldr x11, [x21, x11]
+    ldr x12, [x21, x12]
+    orr x14, x11, x12
+    tst x14, #TERM_TAG_MASK
+    b.ne interp_badarg
+    cmp x11, x12
+    csel x13, x13, xzr, lt
+    add x20, x20, x13
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_JGE
+    INTERP_A x11
+    INTERP_B x12
+    INTERP_K x13
+    ldr x11, [x21, x11]
+    ldr x12, [x21, x12]
+    orr x14, x11, x12
+    tst x14, #TERM_TAG_MASK
+    b.ne interp_badarg
+    cmp x11, x12
+    csel x13, x13, xzr, ge
+    add x20, x20, x13
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_NEXT
+    INTERP_A x11
+    INTERP_B x12
+    INTERP_K x13
+    ldr x14, [x21, x11]
+    cmp x14, #TERM_NIL
+    b.eq interp_next_end
+    and x15, x14, #TERM_TAG_MASK
+    cmp x15, #TERM_TAG_LIST
+    b.ne interp_badarg                // Not a proper list
+    sub x14, x14, #TERM_TAG_LIST
+    ldp x15, x16, [x14]
+    str x15, [x21, x12]
+    str x16, [x21, x11]
+    INTERP_DISPATCH
+interp_next_end:
+    add x20, x20, x13
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_CONS
+    INTERP_B x12
+    INTERP_C x13
+    mov x0, x24
+    ldr x1, [x21, x12]
+    ldr x2, [x21, x13]
+    bl _term_cons
+    cmp x0, #TERM_NONE
+    b.eq interp_heap_full
+    ldur x10, [x20, #-8]              // Operands, lost to the call
+    INTERP_A x11
+    str x0, [x21, x11]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_REVERSE
+    b interp_reverse
+
+INTERP_HANDLER INTERP_OP_TUPLE
+    mov x0, x24
+    INTERP_C x1
+    bl _term_tuple
+    cmp x0, #TERM_NONE
+    b.eq interp_heap_full
+    ldur x10, [x20, #-8]
+    INTERP_A x11
+    str x0, [x21, x11]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_GETEL
+    INTERP_B x12
+    INTERP_C x13
+    ldr x14, [x21, x12]
+    INTERP_TUPLE_CHECK x14, x13, x15, x16
+    add x14, x14, x13, lsl #3
+    ldur x15, [x14, #(8 - TERM_TAG_BOXED)]
+    INTERP_A x11
+    str x15, [x21, x11]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_SETEL
+    INTERP_A x11
+    INTERP_C x13
+    ldr x14, [x21, x11]
+    INTERP_TUPLE_CHECK x14, x13, x15, x16
+    INTERP_B x12
+    ldr x15, [x21, x12]
+    add x14, x14, x13, lsl #3
+    stur x15, [x14, #(8 - TERM_TAG_BOXED)]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_UPDATE
+    b interp_update
+
+INTERP_HANDLER INTERP_OP_CALL
+    cmp x27, #INTERP_MAX_DEPTH
+    b.hs interp_badarg
+    add x9, x19, #interp_frame_stack
+    sub x11, x20, x26
+    lsr x11, x11, #4                  // Return index, shared with native code
+    str x11, [x9, x27, lsl #3]
+    add x27, x27, #1
+    INTERP_K x13
+    add x20, x20, x13
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_RET
+    cbz x27, interp_badarg
+    sub x27, x27, #1
+    add x9, x19, #interp_frame_stack
+    ldr x11, [x9, x27, lsl #3]
+    add x20, x26, x11, lsl #4
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_SEND
+    ldr x9, [x19, #interp_frame_send]
+    cbz x9, interp_badarg
+    INTERP_A x11
+    INTERP_B x12
+    ldr x0, [x19, #interp_frame_send_argument]
+    ldr x1, [x21, x11]
+    ldr x2, [x21, x12]
+    blr x9
+    cbz w0, interp_badarg
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_MEMBER
+    INTERP_C x13
+    ldr x14, [x21, x13]
+    tbz x14, #TERM_BIT_BOXED, interp_badarg
+    ldur x15, [x14, #-TERM_TAG_BOXED]
+    cmp x15, #((1 << TERM_HEADER_ARITY_SHIFT) | TERM_HEADER_SET)
+    b.ne interp_badarg                // Not a set handle
+    INTERP_B x12
+    ldur x0, [x14, #(8 - TERM_TAG_BOXED)]
+    ldr x1, [x21, x12]
+    str x10, [sp, #-16]!              // Operands; a native slot's word is its code
+    bl _set_contains
+    ldr x10, [sp], #16
+    INTERP_A x11
+    lsl x0, x0, #TERM_INT_SHIFT
+    str x0, [x21, x11]
+    INTERP_DISPATCH
+
+INTERP_HANDLER INTERP_OP_COUNT
+    b interp_badarg                   // Ran off the end
+
+INTERP_HANDLER INTERP_NATIVE_SLOT
+    br x10                            // Compiled; already charged
+
+    .org interp_handlers + ((INTERP_NATIVE_SLOT + 1) << INTERP_HANDLER_SHIFT)
+
+// ------------------------------------------------------------
+// Out-of-line Handlers
+// ------------------------------------------------------------
+// REVERSE A, B checks B is a proper list while counting it, takes
+// all its cells from the process heap at once and charges one
+// reduction per element. UPDATE A, B, K copies tuple A (in x25) and replaces one
+// element, leaving the original untouched for anyone sharing it.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+interp_reverse:
+    INTERP_B x12
+    ldr x13, [x21, x12]
+    mov x14, x13
+    mov x15, #0                       // Elements
+interp_reverse_count:
+    cmp x14, #TERM_NIL
+    b.eq interp_reverse_alloc
+    and x9, x14, #TERM_TAG_MASK
+    cmp x9, #TERM_TAG_LIST
+    b.ne interp_badarg
+    ldur x14, [x14, #(8 - TERM_TAG_LIST)]
+    add x15, x15, #1
+    b interp_reverse_count
+interp_reverse_alloc:
+    ldr x9, [x24, #pcb_heap_pointer]
+    add x9, x9, #(HEAP_ALIGNMENT - 1)
+    and x9, x9, #~(HEAP_ALIGNMENT - 1)
+    ldr x11, [x24, #pcb_heap_limit]
+    add x16, x9, x15, lsl #4          // Two words per cell
+    cmp x16, x11
+    b.hi interp_heap_full
+    str x16, [x24, #pcb_heap_pointer]
+    sub x22, x22, x15
+    mov x16, #TERM_NIL
+interp_reverse_build:
+    cmp x13, #TERM_NIL
+    b.eq interp_reverse_done
+    ldur x11, [x13, #-TERM_TAG_LIST]
+    ldur x13, [x13, #(8 - TERM_TAG_LIST)]
+    stp x11, x16, [x9]
+    orr x16, x9, #TERM_TAG_LIST
+    add x9, x9, #16
+    b interp_reverse_build
+interp_reverse_done:
+    INTERP_A x11
+    str x16, [x21, x11]
+    INTERP_DISPATCH
+
+interp_update:
+    INTERP_A x11
+    INTERP_C x13
+    ldr x25, [x21, x11]
+    INTERP_TUPLE_CHECK x25, x13, x15, x16
+    mov x0, x24
+    lsr x1, x15, #TERM_HEADER_ARITY_SHIFT
+    str x10, [sp, #-16]!              // Operands; a native slot's word is its code
+    bl _term_tuple
+    ldr x10, [sp], #16
+    cmp x0, #TERM_NONE
+    b.eq interp_heap_full
+
+    ldur x9, [x25, #-TERM_TAG_BOXED]
+    lsr x9, x9, #TERM_HEADER_ARITY_SHIFT
+    add x12, x25, #(8 - TERM_TAG_BOXED)
+    add x13, x0, #(8 - TERM_TAG_BOXED)
+interp_update_copy:
+    ldr x14, [x12], #8
+    str x14, [x13], #8
+    subs x9, x9, #1                   // Arity is at least 1 here
+    b.ne interp_update_copy
+
+    INTERP_A x11
+    INTERP_B x12
+    INTERP_C x13
+    ldr x14, [x21, x12]
+    add x15, x0, x13, lsl #3
+    stur x14, [x15, #(8 - TERM_TAG_BOXED)]
+    str x0, [x21, x11]
+    INTERP_DISPATCH
+
+// ------------------------------------------------------------
+// Operand Classes
+// ------------------------------------------------------------
+// INTERP_CLASS_* for each opcode, read by the loader.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+interp_op_classes:
+    .byte INTERP_CLASS_NONE           // HALT
+    .byte INTERP_CLASS_NONE           // MOVE
+    .byte INTERP_CLASS_LITERAL        // LOADK
+    .byte INTERP_CLASS_INT            // LOADI
+    .byte INTERP_CLASS_REG            // ADD
+    .byte INTERP_CLASS_REG            // SUB
+    .byte INTERP_CLASS_REG            // MUL
+    .byte INTERP_CLASS_INT            // ADDI
+    .byte INTERP_CLASS_JUMP           // JMP
+    .byte INTERP_CLASS_JUMP           // JEQ
+    .byte INTERP_CLASS_JUMP           // JNE
+    .byte INTERP_CLASS_JUMP           // JLT
+    .byte INTERP_CLASS_JUMP           // JGE
+    .byte INTERP_CLASS_JUMP           // NEXT
+    .byte INTERP_CLASS_REG            // CONS
+    .byte INTERP_CLASS_NONE           // REVERSE
+    .byte INTERP_CLASS_INDEX          // TUPLE
+    .byte INTERP_CLASS_INDEX          // GETEL
+    .byte INTERP_CLASS_INDEX          // SETEL
+    .byte INTERP_CLASS_INDEX          // UPDATE
+    .byte INTERP_CLASS_JUMP           // CALL
+    .byte INTERP_CLASS_NONE           // RET
+    .byte INTERP_CLASS_NONE           // SEND
+    .byte INTERP_CLASS_REG            // MEMBER
+    .align 2
+
+// ------------------------------------------------------------
+// Constant Definitions for C Code
+// ------------------------------------------------------------
+    .data
+    .align 3
+
+_INTERP_FRAME_SIZE_CONST:
+    .quad INTERP_FRAME_SIZE
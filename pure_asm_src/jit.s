@@ -0,0 +1,1056 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// jit.s — Native Code for Behavior Templates
+// ------------------------------------------------------------
+// Compiles a range of a loaded template program (interp.s) to AArch64
+// code in its own mapping, written while the pages are read-write and
+// then made read-execute with mprotect, so no page is ever writable
+// and executable at once.
+//
+// Native code is a drop-in for the threaded code it replaces. It runs
+// inside _interp_run with the interpreter's register assignment (x19
+// frame, x21 registers, x22 budget, x23 literals, x24 pcb, x26 code,
+// x27 call depth, x28 program) and every instruction still starts
+// with its own reduction check:
+//
+//     subs x22, x22, #1
+//     b.mi <yield at this instruction>
+//
+// Operands are constants in the code, so registers are plain loads
+// and stores at fixed offsets, branches inside the range are direct,
+// CONS bumps the process heap inline and TUPLE and SEND call their
+// functions directly. REVERSE, UPDATE, MEMBER, HALT and far LOADKs run
+// the interpreter's own handler.
+//
+// Compiling patches each slot of the range to the interpreter's
+// native-entry handler with the instruction's native address, so
+// interpreted code enters native code through ordinary dispatch, and
+// native code leaves to any slot outside its range (a jump, RET, the
+// end of the range, a yield or an error) through the entry points in
+// the program header with x20 on that slot. Return addresses on the
+// CALL stack are instruction indices in both, so a process can mix
+// interpreted and native functions, and a frame stopped in one
+// resumes in the other with the same pc, depth and reductions.
+//
+// Generation takes two passes over the range: the first sizes every
+// instruction and records its offset, the second writes the code with
+// all branch targets known. Failure paths go to per-instruction stubs
+// after the main code, so the fast path falls straight through.
+//
+// For Linux, assemble with --defsym ACTLY_LINUX=1 (caches are cleaned
+// by address; macOS uses sys_icache_invalidate).
+//
+// The file provides:
+//   - Compilation of instruction ranges to executable pages
+//   - Slot patching so interpreted and native code call each other
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// Include the PCB layout
+    .include "pcb.inc"
+
+// External C library functions for memory management
+    .extern _mmap
+    .extern _munmap
+    .extern _mprotect
+.ifndef ACTLY_LINUX
+    .extern _sys_icache_invalidate
+.endif
+
+// ------------------------------------------------------------
+// JIT Function Exports
+// ------------------------------------------------------------
+// Export the JIT functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _jit_compile
+    .global _jit_is_native
+
+// ------------------------------------------------------------
+// Program, Frame and PCB Offsets (matching interp.s and process.s)
+// ------------------------------------------------------------
+    .equ interp_program_count, 8
+    .equ interp_program_code, 32
+    .equ interp_program_native, 40
+    .equ interp_program_handlers, 48
+    .equ interp_program_dispatch, 56
+    .equ interp_program_yield, 64
+    .equ interp_program_badarg, 72
+    .equ interp_program_heap_full, 80
+    .equ interp_program_tuple, 88
+
+    .equ interp_frame_send, 32
+    .equ interp_frame_send_argument, 40
+    .equ interp_frame_stack, 192
+
+    .equ INTERP_HANDLER_SHIFT, 7
+    .equ INTERP_NATIVE_SLOT, INTERP_OP_COUNT + 1
+
+// ------------------------------------------------------------
+// Native Mapping Layout
+// ------------------------------------------------------------
+// One mapping per compiled range, linked from the program header and
+// unmapped by _interp_program_destroy: a 32-byte header, the code
+// offset of each instruction (32 bits each, padded to 16 bytes), then
+// the code. Every instruction is bounded by JIT_INSTRUCTION_WORDS
+// words of main code and stubs, so the mapping is sized before
+// generating.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ jit_native_length, 0         // Mapping length for munmap (8 bytes)
+    .equ jit_native_next, 8           // Next mapping of the program (8 bytes)
+    .equ jit_native_first, 16         // First instruction compiled (8 bytes)
+    .equ jit_native_count, 24         // Instructions compiled (8 bytes)
+    .equ jit_native_header_size, 32
+
+    .equ JIT_INSTRUCTION_WORDS, 40    // Main code and stubs per instruction
+    .equ JIT_TAIL_WORDS, 4            // Leaving past the end of the range
+    .equ JIT_ENTRY_OFFSET, 8          // Entry from dispatch skips the check
+    .equ PROT_READ_EXEC, 5            // PROT_READ | PROT_EXEC
+
+    // Condition codes for b.cond
+    .equ JIT_EQ, 0x0
+    .equ JIT_NE, 0x1
+    .equ JIT_HS, 0x2
+    .equ JIT_LO, 0x3
+    .equ JIT_MI, 0x4
+    .equ JIT_VS, 0x6
+    .equ JIT_HI, 0x8
+    .equ JIT_GE, 0xA
+    .equ JIT_LT, 0xB
+
+// ------------------------------------------------------------
+// Instruction Encodings
+// ------------------------------------------------------------
+// Words the generator emits. Loads and stores of term registers and
+// literals take their byte offset ORed in as (offset / 8) << 10;
+// moves take imm16 << 5, the halfword << 21 and the register.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ JIT_LDR, 0xF9400000          // ldr xT, [xN, #imm12 * 8]
+    .equ JIT_STR, 0xF9000000          // str xT, [xN, #imm12 * 8]
+    .equ JIT_MOVZ, 0xD2800000         // movz xD, #imm16, lsl #hw
+    .equ JIT_MOVN, 0x92800000         // movn xD, #imm16, lsl #hw
+    .equ JIT_MOVK, 0xF2800000         // movk xD, #imm16, lsl #hw
+    .equ JIT_B, 0x14000000            // b imm26
+    .equ JIT_BCOND, 0x54000000        // b.cond imm19
+
+    // Term registers (x21) and literals (x23)
+    .equ JIT_LDR_X1_REG, JIT_LDR | (21 << 5) | 1
+    .equ JIT_LDR_X2_REG, JIT_LDR | (21 << 5) | 2
+    .equ JIT_LDR_X9_REG, JIT_LDR | (21 << 5) | 9
+    .equ JIT_LDR_X11_REG, JIT_LDR | (21 << 5) | 11
+    .equ JIT_LDR_X12_REG, JIT_LDR | (21 << 5) | 12
+    .equ JIT_LDR_X13_REG, JIT_LDR | (21 << 5) | 13
+    .equ JIT_LDR_X14_REG, JIT_LDR | (21 << 5) | 14
+    .equ JIT_LDR_X16_REG, JIT_LDR | (21 << 5) | 16
+    .equ JIT_STR_X0_REG, JIT_STR | (21 << 5) | 0
+    .equ JIT_STR_X9_REG, JIT_STR | (21 << 5) | 9
+    .equ JIT_STR_X12_REG, JIT_STR | (21 << 5) | 12
+    .equ JIT_STR_X14_REG, JIT_STR | (21 << 5) | 14
+    .equ JIT_STR_X15_REG, JIT_STR | (21 << 5) | 15
+    .equ JIT_STR_X16_REG, JIT_STR | (21 << 5) | 16
+    .equ JIT_LDR_X9_LITERAL, JIT_LDR | (23 << 5) | 9
+
+    // Program header (x28), frame (x19) and pcb (x24) fields
+    .equ JIT_LDR_X16_PROGRAM, JIT_LDR | (28 << 5) | 16
+    .equ JIT_LDR_X16_HANDLERS, JIT_LDR_X16_PROGRAM | ((interp_program_handlers / 8) << 10)
+    .equ JIT_LDR_X16_DISPATCH, JIT_LDR_X16_PROGRAM | ((interp_program_dispatch / 8) << 10)
+    .equ JIT_LDR_X16_TUPLE, JIT_LDR_X16_PROGRAM | ((interp_program_tuple / 8) << 10)
+    .equ JIT_LDR_X9_SEND, JIT_LDR | ((interp_frame_send / 8) << 10) | (19 << 5) | 9
+    .equ JIT_LDR_X0_SEND_ARGUMENT, JIT_LDR | ((interp_frame_send_argument / 8) << 10) | (19 << 5) | 0
+    .equ JIT_ADD_X9_STACK, 0x91000269 | (interp_frame_stack << 10) // add x9, x19, #stack
+    .equ JIT_LDR_X9_HEAP_POINTER, JIT_LDR | ((pcb_heap_pointer / 8) << 10) | (24 << 5) | 9
+    .equ JIT_LDR_X11_HEAP_LIMIT, JIT_LDR | ((pcb_heap_limit / 8) << 10) | (24 << 5) | 11
+    .equ JIT_STR_X12_HEAP_POINTER, JIT_STR | ((pcb_heap_pointer / 8) << 10) | (24 << 5) | 12
+
+    // Reduction check and leaving to a slot
+    .equ JIT_SUBS_X22_ONE, 0xF10006D6 // subs x22, x22, #1
+    .equ JIT_ADD_X20_X26_HIGH, 0x91400354 // add x20, x26, #imm12, lsl #12
+    .equ JIT_ADD_X20_X20, 0x91000294  // add x20, x20, #imm12
+    .equ JIT_ADD_X16_X16, 0x91000210  // add x16, x16, #imm12
+    .equ JIT_BR_X16, 0xD61F0200       // br x16
+    .equ JIT_BLR_X16, 0xD63F0200      // blr x16
+    .equ JIT_BLR_X9, 0xD63F0120       // blr x9
+
+    // Arithmetic and comparison
+    .equ JIT_ORR_X14_X12_X13, 0xAA0D018E // orr x14, x12, x13
+    .equ JIT_ORR_X14_X11_X12, 0xAA0C016E // orr x14, x11, x12
+    .equ JIT_TST_X14_TAG, 0xF24009DF  // tst x14, #TERM_TAG_MASK
+    .equ JIT_TST_X12_TAG, 0xF240099F  // tst x12, #TERM_TAG_MASK
+    .equ JIT_ADDS_X12_X12_X13, 0xAB0D018C // adds x12, x12, x13
+    .equ JIT_SUBS_X12_X12_X13, 0xEB0D018C // subs x12, x12, x13
+    .equ JIT_ASR_X13_INT, 0x9343FDAD  // asr x13, x13, #TERM_INT_SHIFT
+    .equ JIT_MUL_X14_X12_X13, 0x9B0D7D8E // mul x14, x12, x13
+    .equ JIT_SMULH_X15_X12_X13, 0x9B4D7D8F // smulh x15, x12, x13
+    .equ JIT_CMP_X15_X14_SIGN, 0xEB8EFDFF // cmp x15, x14, asr #63
+    .equ JIT_CMP_X11_X12, 0xEB0C017F  // cmp x11, x12
+
+    // Lists
+    .equ JIT_CMP_X14_NIL, 0xF10001DF | (TERM_NIL << 10) // cmp x14, #TERM_NIL
+    .equ JIT_AND_X15_X14_TAG, 0x924009CF // and x15, x14, #TERM_TAG_MASK
+    .equ JIT_CMP_X15_LIST, 0xF10001FF | (TERM_TAG_LIST << 10) // cmp x15, #TERM_TAG_LIST
+    .equ JIT_LDUR_X15_HEAD, 0xF85FE1CF // ldur x15, [x14, #-TERM_TAG_LIST]
+    .equ JIT_LDUR_X16_TAIL, 0xF84061D0 // ldur x16, [x14, #(8 - TERM_TAG_LIST)]
+    .equ JIT_ADD_X9_ALIGN, 0x91001D29 // add x9, x9, #(HEAP_ALIGNMENT - 1)
+    .equ JIT_AND_X9_ALIGN, 0x927DF129 // and x9, x9, #~(HEAP_ALIGNMENT - 1)
+    .equ JIT_ADD_X12_X9_CELL, 0x9100412C // add x12, x9, #16
+    .equ JIT_CMP_X12_X11, 0xEB0B019F  // cmp x12, x11
+    .equ JIT_STP_X13_X14_X9, 0xA900392D // stp x13, x14, [x9]
+    .equ JIT_ORR_X9_LIST, 0xB27F0129  // orr x9, x9, #TERM_TAG_LIST
+
+    // Tuples
+    .equ JIT_MOV_X0_X24, 0xAA1803E0   // mov x0, x24
+    .equ JIT_CMP_X0_NONE, 0xF100001F | (TERM_NONE << 10) // cmp x0, #TERM_NONE
+    .equ JIT_CMP_X15_BOXED, 0xF10001FF | (TERM_TAG_BOXED << 10) // cmp x15, #TERM_TAG_BOXED
+    .equ JIT_LDUR_X15_HEADER, 0xF85FF1CF // ldur x15, [x14, #-TERM_TAG_BOXED]
+    .equ JIT_AND_X16_X15_BYTE, 0x92401DF0 // and x16, x15, #0xFF
+    .equ JIT_CMP_X16_TUPLE, 0xF100021F | (TERM_HEADER_TUPLE << 10) // cmp x16, #TERM_HEADER_TUPLE
+    .equ JIT_CMP_X15_X17, 0xEB1101FF  // cmp x15, x17
+    .equ JIT_LDR_X15_X14_X17, 0xF87169CF // ldr x15, [x14, x17]
+    .equ JIT_STR_X16_X14_X17, 0xF83169D0 // str x16, [x14, x17]
+
+    // CALL, RET and SEND
+    .equ JIT_CMP_X27_DEPTH, 0xF100037F | (INTERP_MAX_DEPTH << 10) // cmp x27, #INTERP_MAX_DEPTH
+    .equ JIT_CMP_X27_ZERO, 0xF100037F // cmp x27, #0
+    .equ JIT_STR_X10_RETURN, 0xF83B792A // str x10, [x9, x27, lsl #3]
+    .equ JIT_LDR_X10_RETURN, 0xF87B792A // ldr x10, [x9, x27, lsl #3]
+    .equ JIT_ADD_X27_ONE, 0x9100077B  // add x27, x27, #1
+    .equ JIT_SUB_X27_ONE, 0xD100077B  // sub x27, x27, #1
+    .equ JIT_ADD_X20_RETURN, 0x8B0A1354 // add x20, x26, x10, lsl #4
+    .equ JIT_CMP_X9_ZERO, 0xF100013F  // cmp x9, #0
+    .equ JIT_CMP_W0_ZERO, 0x7100001F  // cmp w0, #0
+
+// ------------------------------------------------------------
+// Emission Macros
+// ------------------------------------------------------------
+// The generator keeps x22 as the code base (0 while sizing) and x23
+// as the byte offset of the next word. JIT_EMIT stores w0 there;
+// JIT_WORD emits a constant; JIT_OFFSET emits a load or store with a
+// term register or literal byte offset (a multiple of 8 below 32768)
+// from \offset. JIT_FAIL_IF and JIT_HEAP_IF branch on \cond to the
+// instruction's INTERP_BADARG or INTERP_HEAP_FULL stub.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+.macro JIT_EMIT
+    cbz x22, 1f
+    str w0, [x22, x23]
+1:
+    add x23, x23, #4
+.endm
+
+.macro JIT_LOAD_WORD value
+    movz w0, #((\value) & 0xFFFF)
+    movk w0, #(((\value) >> 16) & 0xFFFF), lsl #16
+.endm
+
+.macro JIT_WORD value
+    JIT_LOAD_WORD \value
+    JIT_EMIT
+.endm
+
+.macro JIT_OFFSET value, offset
+    JIT_LOAD_WORD \value
+    orr w0, w0, \offset, lsl #7       // (offset / 8) << 10
+    JIT_EMIT
+.endm
+
+.macro JIT_FAIL_IF cond
+    bl jit_badarg_stub
+    mov x1, #\cond
+    bl jit_branch_if
+.endm
+
+.macro JIT_HEAP_IF cond
+    bl jit_heap_full_stub
+    mov x1, #\cond
+    bl jit_branch_if
+.endm
+
+// Emit x20 = code + \index * 16 (clobbers x0, x5, x6)
+.macro JIT_SET_SLOT index
+    lsl x6, \index, #4
+    lsr x5, x6, #12
+    JIT_LOAD_WORD JIT_ADD_X20_X26_HIGH
+    orr w0, w0, w5, lsl #10
+    JIT_EMIT
+    and x5, x6, #0xFFF
+    JIT_LOAD_WORD JIT_ADD_X20_X20
+    orr w0, w0, w5, lsl #10
+    JIT_EMIT
+.endm
+
+// ------------------------------------------------------------
+// JIT Compile
+// ------------------------------------------------------------
+// Compile instructions [first, first + count) of a loaded program to
+// native code and switch their slots to it. Ranges may be compiled
+// one at a time (a hot function, a loop) but may not overlap a range
+// already compiled. No frame may be running the program meanwhile;
+// frames stopped on any pc carry on in native code on their next run.
+//
+// Parameters:
+//   x0 (void*) - program: Program from _interp_load
+//   x1 (uint64_t) - first: First instruction
+//   x2 (uint64_t) - count: Instructions, 1 to JIT_MAX_INSTRUCTIONS
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if the range is empty, too
+//              long, past the program or already compiled, or a
+//              mapping or mprotect failed
+//
+// Complexity: O(count)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_jit_compile:
+    cbz x0, jit_compile_invalid
+    cbz x2, jit_compile_invalid
+    cmp x2, #JIT_MAX_INSTRUCTIONS
+    b.hi jit_compile_invalid
+    ldr x9, [x0, #interp_program_count]
+    cmp x1, x9
+    b.hs jit_compile_invalid
+    sub x9, x9, x1
+    cmp x2, x9
+    b.hi jit_compile_invalid
+
+    // Every slot must still hold an interpreter handler
+    ldr x9, [x0, #interp_program_code]
+    ldr x10, [x0, #interp_program_handlers]
+    add x9, x9, x1, lsl #4
+    mov x11, x2
+jit_compile_check:
+    ldr x12, [x9], #16
+    sub x12, x12, x10
+    cmp x12, #(INTERP_OP_COUNT << INTERP_HANDLER_SHIFT)
+    b.hs jit_compile_invalid
+    subs x11, x11, #1
+    b.ne jit_compile_check
+
+    stp x29, x30, [sp, #-16]!
+    mov x29, sp
+    stp x19, x20, [sp, #-16]!
+    stp x21, x22, [sp, #-16]!
+    stp x23, x24, [sp, #-16]!
+    stp x25, x26, [sp, #-16]!
+    stp x27, x28, [sp, #-16]!
+
+    mov x19, x0                       // Program
+    mov x20, x1                       // first
+    mov x21, x2                       // count
+    ldr x26, [x19, #interp_program_code]
+
+    // Header, offsets, then the code bound
+    lsl x9, x21, #2
+    add x9, x9, #15
+    and x9, x9, #~15
+    add x9, x9, #jit_native_header_size
+    mov x10, #JIT_INSTRUCTION_WORDS
+    mul x10, x21, x10
+    add x10, x10, #JIT_TAIL_WORDS
+    add x24, x9, x10, lsl #2          // Mapping length (x24 until generation)
+
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, x24                       // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq jit_compile_failed
+    mov x27, x0
+    str x24, [x27, #jit_native_length]
+    ldr x9, [x19, #interp_program_native]
+    str x9, [x27, #jit_native_next]
+    stp x20, x21, [x27, #jit_native_first]
+    add x28, x27, #jit_native_header_size // Offsets
+
+    // Pass 1 sizes the code and records instruction offsets
+    mov x22, #0
+    mov x23, #0
+    mov x24, #0
+    bl jit_generate
+
+    // Pass 2 writes it, stubs after the main code
+    mov x24, x23
+    mov x23, #0
+    lsl x9, x21, #2
+    add x9, x9, #15
+    and x9, x9, #~15
+    add x22, x28, x9                  // Code base
+    bl jit_generate
+
+    ldr x0, [x27, #jit_native_length]
+    add x9, x22, x24
+    add x10, x27, x0
+    cmp x9, x10
+    b.hi jit_compile_unmap            // Over the bound; never expected
+
+    mov x0, x27
+    ldr x1, [x27, #jit_native_length]
+    mov x2, #PROT_READ_EXEC
+    bl _mprotect
+    cbnz x0, jit_compile_unmap
+
+    mov x0, x22
+    mov x1, x24
+    bl jit_flush
+    str x27, [x19, #interp_program_native]
+
+    // Enter through the native-entry handler from now on
+    ldr x9, [x19, #interp_program_handlers]
+    add x9, x9, #(INTERP_NATIVE_SLOT << INTERP_HANDLER_SHIFT)
+    add x10, x26, x20, lsl #4
+    mov x11, #0
+jit_compile_patch:
+    ldr w12, [x28, x11, lsl #2]
+    add x12, x22, x12
+    add x12, x12, #JIT_ENTRY_OFFSET
+    stp x9, x12, [x10], #16
+    add x11, x11, #1
+    cmp x11, x21
+    b.lo jit_compile_patch
+
+    mov x0, #1
+    b jit_compile_return
+
+jit_compile_unmap:
+    mov x0, x27
+    ldr x1, [x27, #jit_native_length]
+    bl _munmap
+
+jit_compile_failed:
+    mov x0, #0
+
+jit_compile_return:
+    ldp x27, x28, [sp], #16
+    ldp x25, x26, [sp], #16
+    ldp x23, x24, [sp], #16
+    ldp x21, x22, [sp], #16
+    ldp x19, x20, [sp], #16
+    ldp x29, x30, [sp], #16
+    ret
+
+jit_compile_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// JIT Is Native
+// ------------------------------------------------------------
+// Whether an instruction of a program runs as native code.
+//
+// Parameters:
+//   x0 (void*) - program: Program from _interp_load
+//   x1 (uint64_t) - index: Instruction
+//
+// Returns:
+//   x0 (int) - native: 1 if compiled, 0 if interpreted or invalid
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_jit_is_native:
+    cbz x0, jit_is_native_no
+    ldr x9, [x0, #interp_program_count]
+    cmp x1, x9
+    b.hs jit_is_native_no
+    ldr x9, [x0, #interp_program_code]
+    lsl x10, x1, #4
+    ldr x9, [x9, x10]
+    ldr x10, [x0, #interp_program_handlers]
+    add x10, x10, #(INTERP_NATIVE_SLOT << INTERP_HANDLER_SHIFT)
+    cmp x9, x10
+    cset x0, eq
+    ret
+
+jit_is_native_no:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// JIT Generate (internal)
+// ------------------------------------------------------------
+// One pass over the range. Each instruction starts at the offset
+// recorded for it with the reduction check, then its body; the
+// interpreter enters JIT_ENTRY_OFFSET past the check, having charged
+// the reduction itself.
+//
+// Generator registers: x19 program, x20 first, x21 count, x22 code
+// base or 0, x23 main offset, x24 stub offset, x25 instruction, x26
+// threaded code, x28 offsets. Per instruction: x9 opcode, x10 operand
+// word, x11 A * 8, x12 B * 8, x13 third operand, x14 the same signed,
+// x15 and x16 the INTERP_BADARG and INTERP_HEAP_FULL stubs (-1 until
+// needed), x17 free across emission helpers, which clobber x0-x8.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+jit_generate:
+    stp x29, x30, [sp, #-16]!
+    mov x25, x20
+jit_generate_next:
+    sub x0, x25, x20
+    cmp x0, x21
+    b.hs jit_generate_tail
+    str w23, [x28, x0, lsl #2]
+    mov x15, #-1
+    mov x16, #-1
+
+    // Reduction check
+    mov x0, x25
+    mov x1, #interp_program_yield
+    bl jit_stub
+    mov x17, x0
+    JIT_WORD JIT_SUBS_X22_ONE
+    mov x0, x17
+    mov x1, #JIT_MI
+    bl jit_branch_if
+
+    add x0, x26, x25, lsl #4
+    ldp x9, x10, [x0]
+    ldr x0, [x19, #interp_program_handlers]
+    sub x9, x9, x0
+    lsr x9, x9, #INTERP_HANDLER_SHIFT // Opcode
+    and x11, x10, #0xFFFF
+    ubfx x12, x10, #16, #16
+    lsr x13, x10, #32
+    asr x14, x10, #32
+    adr x0, jit_ops
+    add x0, x0, x9, lsl #2
+    br x0
+
+jit_generate_done:
+    add x25, x25, #1
+    b jit_generate_next
+
+jit_generate_tail:
+    add x0, x20, x21
+    bl jit_jump
+    ldp x29, x30, [sp], #16
+    ret
+
+// Opcode table, one branch per INTERP_OP_*
+jit_ops:
+    b jit_op_interpret                // HALT
+    b jit_op_move
+    b jit_op_loadk
+    b jit_op_loadi
+    b jit_op_add
+    b jit_op_sub
+    b jit_op_mul
+    b jit_op_addi
+    b jit_op_jmp
+    b jit_op_jeq
+    b jit_op_jne
+    b jit_op_jlt
+    b jit_op_jge
+    b jit_op_next
+    b jit_op_cons
+    b jit_op_interpret                // REVERSE
+    b jit_op_tuple
+    b jit_op_getel
+    b jit_op_setel
+    b jit_op_interpret                // UPDATE
+    b jit_op_call
+    b jit_op_ret
+    b jit_op_send
+    b jit_op_interpret                // MEMBER
+
+// ------------------------------------------------------------
+// Opcode Emitters (internal)
+// ------------------------------------------------------------
+// Native bodies matching the interpreter handlers in interp.s, with
+// generated code using x9-x17 and x0-x2 as scratch.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+jit_op_move:
+    JIT_OFFSET JIT_LDR_X9_REG, w12
+    JIT_OFFSET JIT_STR_X9_REG, w11
+    b jit_generate_done
+
+jit_op_loadk:
+    cmp x13, #(8 << 12)
+    b.hs jit_op_interpret             // Past the scaled offset range
+    JIT_OFFSET JIT_LDR_X9_LITERAL, w13
+    JIT_OFFSET JIT_STR_X9_REG, w11
+    b jit_generate_done
+
+jit_op_loadi:
+    mov x0, x14
+    mov x1, #9
+    bl jit_move_immediate
+    JIT_OFFSET JIT_STR_X9_REG, w11
+    b jit_generate_done
+
+jit_op_add:
+    JIT_OFFSET JIT_LDR_X12_REG, w12
+    JIT_OFFSET JIT_LDR_X13_REG, w13
+    JIT_WORD JIT_ORR_X14_X12_X13
+    JIT_WORD JIT_TST_X14_TAG
+    JIT_FAIL_IF JIT_NE
+    JIT_WORD JIT_ADDS_X12_X12_X13
+    JIT_FAIL_IF JIT_VS
+    JIT_OFFSET JIT_STR_X12_REG, w11
+    b jit_generate_done
+
+jit_op_sub:
+    JIT_OFFSET JIT_LDR_X12_REG, w12
+    JIT_OFFSET JIT_LDR_X13_REG, w13
+    JIT_WORD JIT_ORR_X14_X12_X13
+    JIT_WORD JIT_TST_X14_TAG
+    JIT_FAIL_IF JIT_NE
+    JIT_WORD JIT_SUBS_X12_X12_X13
+    JIT_FAIL_IF JIT_VS
+    JIT_OFFSET JIT_STR_X12_REG, w11
+    b jit_generate_done
+
+jit_op_mul:
+    JIT_OFFSET JIT_LDR_X12_REG, w12
+    JIT_OFFSET JIT_LDR_X13_REG, w13
+    JIT_WORD JIT_ORR_X14_X12_X13
+    JIT_WORD JIT_TST_X14_TAG
+    JIT_FAIL_IF JIT_NE
+    JIT_WORD JIT_ASR_X13_INT
+    JIT_WORD JIT_MUL_X14_X12_X13
+    JIT_WORD JIT_SMULH_X15_X12_X13
+    JIT_WORD JIT_CMP_X15_X14_SIGN
+    JIT_FAIL_IF JIT_NE                // Overflow
+    JIT_OFFSET JIT_STR_X14_REG, w11
+    b jit_generate_done
+
+jit_op_addi:
+    JIT_OFFSET JIT_LDR_X12_REG, w12
+    JIT_WORD JIT_TST_X12_TAG
+    JIT_FAIL_IF JIT_NE
+    mov x0, x14
+    mov x1, #13
+    bl jit_move_immediate
+    JIT_WORD JIT_ADDS_X12_X12_X13
+    JIT_FAIL_IF JIT_VS
+    JIT_OFFSET JIT_STR_X12_REG, w11
+    b jit_generate_done
+
+jit_op_jmp:
+    add x0, x25, #1
+    add x0, x0, x14, asr #4           // Target instruction
+    bl jit_jump
+    b jit_generate_done
+
+jit_op_jeq:
+    mov x17, #JIT_EQ
+    b jit_op_compare
+
+jit_op_jne:
+    mov x17, #JIT_NE
+
+jit_op_compare:
+    JIT_OFFSET JIT_LDR_X11_REG, w11
+    JIT_OFFSET JIT_LDR_X12_REG, w12
+    JIT_WORD JIT_CMP_X11_X12
+    add x0, x25, #1
+    add x0, x0, x14, asr #4
+    mov x1, x17
+    bl jit_jump_if
+    b jit_generate_done
+
+jit_op_jlt:
+    mov x17, #JIT_LT
+    b jit_op_compare_integers
+
+jit_op_jge:
+    mov x17, #JIT_GE
+
+jit_op_compare_integers:
+    JIT_OFFSET JIT_LDR_X11_REG, w11
+    JIT_OFFSET JIT_LDR_X12_REG, w12
+    JIT_WORD JIT_ORR_X14_X11_X12
+    JIT_WORD JIT_TST_X14_TAG
+    JIT_FAIL_IF JIT_NE
+    JIT_WORD JIT_CMP_X11_X12
+    add x0, x25, #1
+    add x0, x0, x14, asr #4
+    mov x1, x17
+    bl jit_jump_if
+    b jit_generate_done
+
+jit_op_next:
+    JIT_OFFSET JIT_LDR_X14_REG, w11
+    JIT_WORD JIT_CMP_X14_NIL
+    add x0, x25, #1
+    add x0, x0, x14, asr #4
+    mov x1, #JIT_EQ
+    bl jit_jump_if
+    JIT_WORD JIT_AND_X15_X14_TAG
+    JIT_WORD JIT_CMP_X15_LIST
+    JIT_FAIL_IF JIT_NE                // Not a proper list
+    JIT_WORD JIT_LDUR_X15_HEAD
+    JIT_WORD JIT_LDUR_X16_TAIL
+    JIT_OFFSET JIT_STR_X15_REG, w12
+    JIT_OFFSET JIT_STR_X16_REG, w11
+    b jit_generate_done
+
+jit_op_cons:
+    JIT_WORD JIT_LDR_X9_HEAP_POINTER
+    JIT_WORD JIT_ADD_X9_ALIGN
+    JIT_WORD JIT_AND_X9_ALIGN
+    JIT_WORD JIT_LDR_X11_HEAP_LIMIT
+    JIT_WORD JIT_ADD_X12_X9_CELL
+    JIT_WORD JIT_CMP_X12_X11
+    JIT_HEAP_IF JIT_HI
+    JIT_WORD JIT_STR_X12_HEAP_POINTER
+    JIT_OFFSET JIT_LDR_X13_REG, w12
+    JIT_OFFSET JIT_LDR_X14_REG, w13
+    JIT_WORD JIT_STP_X13_X14_X9
+    JIT_WORD JIT_ORR_X9_LIST
+    JIT_OFFSET JIT_STR_X9_REG, w11
+    b jit_generate_done
+
+jit_op_tuple:
+    JIT_WORD JIT_MOV_X0_X24
+    mov x0, x13
+    mov x1, #1
+    bl jit_move_immediate
+    JIT_WORD JIT_LDR_X16_TUPLE
+    JIT_WORD JIT_BLR_X16
+    JIT_WORD JIT_CMP_X0_NONE
+    JIT_HEAP_IF JIT_EQ
+    JIT_OFFSET JIT_STR_X0_REG, w11
+    b jit_generate_done
+
+jit_op_getel:
+    JIT_OFFSET JIT_LDR_X14_REG, w12
+    bl jit_tuple_check
+    JIT_WORD JIT_LDR_X15_X14_X17
+    JIT_OFFSET JIT_STR_X15_REG, w11
+    b jit_generate_done
+
+jit_op_setel:
+    JIT_OFFSET JIT_LDR_X14_REG, w11
+    bl jit_tuple_check
+    JIT_OFFSET JIT_LDR_X16_REG, w12
+    JIT_WORD JIT_STR_X16_X14_X17
+    b jit_generate_done
+
+jit_op_call:
+    JIT_WORD JIT_CMP_X27_DEPTH
+    JIT_FAIL_IF JIT_HS
+    JIT_WORD JIT_ADD_X9_STACK
+    add x0, x25, #1                   // Return index
+    mov x1, #10
+    bl jit_move_immediate
+    JIT_WORD JIT_STR_X10_RETURN
+    JIT_WORD JIT_ADD_X27_ONE
+    add x0, x25, #1
+    add x0, x0, x14, asr #4
+    bl jit_jump
+    b jit_generate_done
+
+jit_op_ret:
+    JIT_WORD JIT_CMP_X27_ZERO
+    JIT_FAIL_IF JIT_EQ
+    JIT_WORD JIT_SUB_X27_ONE
+    JIT_WORD JIT_ADD_X9_STACK
+    JIT_WORD JIT_LDR_X10_RETURN
+    JIT_WORD JIT_ADD_X20_RETURN
+    JIT_WORD JIT_LDR_X16_DISPATCH
+    JIT_WORD JIT_BR_X16
+    b jit_generate_done
+
+jit_op_send:
+    JIT_WORD JIT_LDR_X9_SEND
+    JIT_WORD JIT_CMP_X9_ZERO
+    JIT_FAIL_IF JIT_EQ
+    JIT_WORD JIT_LDR_X0_SEND_ARGUMENT
+    JIT_OFFSET JIT_LDR_X1_REG, w11
+    JIT_OFFSET JIT_LDR_X2_REG, w12
+    JIT_WORD JIT_BLR_X9
+    JIT_WORD JIT_CMP_W0_ZERO
+    JIT_FAIL_IF JIT_EQ
+    b jit_generate_done
+
+// Run the interpreter's handler with the original operand word; it
+// dispatches to the next slot as usual
+jit_op_interpret:
+    mov x0, x10
+    mov x1, #10
+    bl jit_move_immediate
+    add x4, x25, #1
+    JIT_SET_SLOT x4
+    JIT_WORD JIT_LDR_X16_HANDLERS
+    JIT_LOAD_WORD JIT_ADD_X16_X16
+    lsl x5, x9, #INTERP_HANDLER_SHIFT
+    orr w0, w0, w5, lsl #10
+    JIT_EMIT
+    JIT_WORD JIT_BR_X16
+    b jit_generate_done
+
+// ------------------------------------------------------------
+// Emission Helpers (internal)
+// ------------------------------------------------------------
+// jit_tuple_check emits the tuple and index check on x14 for element
+// x13, leaving its byte offset from the term in x17 of the generated
+// code. jit_move_immediate emits a movz or movn and movks of x0 into
+// register x1. jit_branch and jit_branch_if emit branches to code
+// offset x0 (jit_branch_if on condition x1). jit_jump and jit_jump_if
+// do the same for instruction x0, directly inside the range and
+// through the dispatch entry outside it. jit_stub emits a stub that
+// leaves to slot x0 through the program header entry at offset x1 and
+// returns its offset; jit_badarg_stub and jit_heap_full_stub return
+// the current instruction's stubs, emitting them on first use.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+jit_tuple_check:
+    stp x29, x30, [sp, #-16]!
+    JIT_WORD JIT_AND_X15_X14_TAG
+    JIT_WORD JIT_CMP_X15_BOXED
+    JIT_FAIL_IF JIT_NE
+    JIT_WORD JIT_LDUR_X15_HEADER
+    JIT_WORD JIT_AND_X16_X15_BYTE
+    JIT_WORD JIT_CMP_X16_TUPLE
+    JIT_FAIL_IF JIT_NE
+    add x0, x13, #1
+    lsl x0, x0, #TERM_HEADER_ARITY_SHIFT // Smallest header with the index
+    mov x1, #17
+    bl jit_move_immediate
+    JIT_WORD JIT_CMP_X15_X17
+    JIT_FAIL_IF JIT_LO
+    lsl x0, x13, #3
+    add x0, x0, #(8 - TERM_TAG_BOXED)
+    mov x1, #17
+    bl jit_move_immediate
+    ldp x29, x30, [sp], #16
+    ret
+
+jit_move_immediate:
+    mov x2, x0
+    tbnz x2, #63, jit_move_immediate_negative
+    and x4, x2, #0xFFFF
+    JIT_LOAD_WORD JIT_MOVZ
+    mov x7, #0                        // Halfwords movz leaves
+    b jit_move_immediate_first
+jit_move_immediate_negative:
+    mvn x4, x2
+    and x4, x4, #0xFFFF
+    JIT_LOAD_WORD JIT_MOVN
+    mov x7, #0xFFFF                   // Halfwords movn leaves
+jit_move_immediate_first:
+    orr w0, w0, w4, lsl #5
+    orr w0, w0, w1
+    JIT_EMIT
+    mov x3, #1
+jit_move_immediate_next:
+    lsl x6, x3, #4
+    lsr x4, x2, x6
+    and x4, x4, #0xFFFF
+    cmp x4, x7
+    b.eq jit_move_immediate_skip
+    JIT_LOAD_WORD JIT_MOVK
+    orr w0, w0, w4, lsl #5
+    orr w0, w0, w3, lsl #21
+    orr w0, w0, w1
+    JIT_EMIT
+jit_move_immediate_skip:
+    add x3, x3, #1
+    cmp x3, #4
+    b.lo jit_move_immediate_next
+    ret
+
+jit_branch:
+    sub x2, x0, x23
+    asr x2, x2, #2
+    and x2, x2, #0x3FFFFFF
+    JIT_LOAD_WORD JIT_B
+    orr w0, w0, w2
+    JIT_EMIT
+    ret
+
+jit_branch_if:
+    sub x2, x0, x23
+    asr x2, x2, #2
+    and x2, x2, #0x7FFFF
+    JIT_LOAD_WORD JIT_BCOND
+    orr w0, w0, w2, lsl #5
+    orr w0, w0, w1
+    JIT_EMIT
+    ret
+
+jit_jump:
+    sub x2, x0, x20
+    cmp x2, x21
+    b.hs jit_jump_leave
+    ldr w0, [x28, x2, lsl #2]         // Target's check (pass 2)
+    b jit_branch
+jit_jump_leave:
+    mov x4, x0
+    JIT_SET_SLOT x4
+    JIT_WORD JIT_LDR_X16_DISPATCH
+    JIT_WORD JIT_BR_X16
+    ret
+
+jit_jump_if:
+    sub x2, x0, x20
+    cmp x2, x21
+    b.hs jit_jump_if_leave
+    ldr w0, [x28, x2, lsl #2]
+    b jit_branch_if
+jit_jump_if_leave:
+    stp x1, x30, [sp, #-16]!
+    mov x1, #interp_program_dispatch
+    bl jit_stub
+    ldp x1, x30, [sp], #16
+    b jit_branch_if
+
+jit_badarg_stub:
+    cmn x15, #1
+    b.ne jit_badarg_stub_ready
+    stp x29, x30, [sp, #-16]!
+    add x0, x25, #1                   // interp_badarg steps back one slot
+    mov x1, #interp_program_badarg
+    bl jit_stub
+    mov x15, x0
+    ldp x29, x30, [sp], #16
+jit_badarg_stub_ready:
+    mov x0, x15
+    ret
+
+jit_heap_full_stub:
+    cmn x16, #1
+    b.ne jit_heap_full_stub_ready
+    stp x29, x30, [sp, #-16]!
+    add x0, x25, #1
+    mov x1, #interp_program_heap_full
+    bl jit_stub
+    mov x16, x0
+    ldp x29, x30, [sp], #16
+jit_heap_full_stub_ready:
+    mov x0, x16
+    ret
+
+jit_stub:
+    mov x8, x23                       // Emit at the stub offset
+    mov x23, x24
+    mov x2, x24
+    mov x4, x0
+    mov x3, x1
+    JIT_SET_SLOT x4
+    JIT_LOAD_WORD JIT_LDR_X16_PROGRAM
+    orr w0, w0, w3, lsl #7
+    JIT_EMIT
+    JIT_WORD JIT_BR_X16
+    mov x24, x23
+    mov x23, x8
+    mov x0, x2
+    ret
+
+// ------------------------------------------------------------
+// JIT Flush (internal)
+// ------------------------------------------------------------
+// Make freshly written code visible to instruction fetch: clean the
+// data cache and invalidate the instruction cache over the range.
+//
+// Parameters:
+//   x0 (void*) - start: First byte of code
+//   x1 (uint64_t) - length: Bytes of code
+//
+// Returns:
+//   None
+//
+// Complexity: O(length)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+jit_flush:
+.ifdef ACTLY_LINUX
+    add x1, x0, x1                    // End
+    mrs x2, ctr_el0
+    mov x3, #4
+    ubfx x4, x2, #16, #4              // DminLine, log2 words
+    lsl x4, x3, x4
+    sub x5, x4, #1
+    bic x6, x0, x5
+jit_flush_data:
+    dc cvau, x6
+    add x6, x6, x4
+    cmp x6, x1
+    b.lo jit_flush_data
+    dsb ish
+    and x4, x2, #0xF                  // IminLine, log2 words
+    lsl x4, x3, x4
+    sub x5, x4, #1
+    bic x6, x0, x5
+jit_flush_instruction:
+    ic ivau, x6
+    add x6, x6, x4
+    cmp x6, x1
+    b.lo jit_flush_instruction
+    dsb ish
+    isb
+    ret
+.else
+    b _sys_icache_invalidate
+.endif
@@ -74,9 +74,14 @@
     .global _select_victim_by_load
     .global _select_victim_locality
     .global _try_steal_work
+    .global _serve_steal_request
+    .global _steal_arrive
     .global _migrate_process
+    .global _steal_process
+    .global _WS_DEQUE_SIZE_CONST
 
-// No global data variables exported - all constants are in config.inc
+// No global data variables exported - constants are in config.inc,
+// and the deque size is exported as data for C code at the end
 
 // ------------------------------------------------------------
 // Work Stealing Deque Data Structure Layout
@@ -96,10 +101,17 @@
     .equ ws_deque_size, 24            // Maximum size (4 bytes)
     .equ ws_deque_mask, 28            // Size mask for circular buffer (4 bytes)
     .equ ws_deque_steal_count, 32    // Successful steals (8 bytes)
-    .equ ws_deque_steal_attempts, 40  // Total steal attempts (8 bytes)
+    .equ ws_deque_steal_attempts, 40  // Unused; see scheduler_steal_attempts (8 bytes)
     .equ ws_deque_local_pops, 48     // Local pop operations (8 bytes)
+    .equ ws_deque_cas_retries, 56    // Lost or spurious top CAS attempts (8 bytes)
     .equ ws_deque_size_bytes, 64     // Total structure size
 
+    // Scheduler state offsets (shared with scheduler.s)
+    .include "scheduler_state.inc"
+
+    // Process control block offsets
+    .include "pcb.inc"
+
 // No global data variables - all constants are defined in config.inc
 
 // ------------------------------------------------------------
@@ -127,6 +139,7 @@ _ws_deque_init:
     // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
 
     // Validate parameters
     cbz x0, init_failed  // Check deque pointer
@@ -171,7 +184,7 @@ no_previous_array:
     mov x0, xzr        // addr = NULL (let system choose)
     mov x1, x21        // length = size * 8
     mov x2, #3         // prot = PROT_READ | PROT_WRITE
-    mov x3, #0x1002    // flags = MAP_PRIVATE | MAP_ANON (macOS)
+    mov x3, #MMAP_PRIVATE_ANON  // flags = MAP_PRIVATE | MAP_ANON
     mov x4, #-1        // fd = -1 (not a file mapping)
     mov x5, xzr        // offset = 0
     bl _mmap           // Call C library mmap function
@@ -191,6 +204,7 @@ no_previous_array:
     str xzr, [x19, #ws_deque_steal_count] // steal_count = 0
     str xzr, [x19, #ws_deque_steal_attempts] // steal_attempts = 0
     str xzr, [x19, #ws_deque_local_pops] // local_pops = 0
+    str xzr, [x19, #ws_deque_cas_retries] // cas_retries = 0
 
     // Clear the process array
     mov x21, x20        // Number of elements to clear
@@ -204,12 +218,14 @@ clear_array_loop:
 
     // Return success
     mov x0, #1
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
 init_failed:
     mov x0, #0
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
@@ -219,66 +235,57 @@ init_failed:
 // ------------------------------------------------------------
 // Add a process to the bottom of the deque (local scheduler operation).
 // This is the fast path for local schedulers adding work to their queue.
+// Only the owning scheduler may push. The slot is written before
+// bottom is published with a release store, so a thief that observes
+// the new bottom also observes the process. Top is read with acquire
+// so a slot is never reused while a thief may still be reading it.
 //
 // Parameters:
 //   x0 (void*) - deque_ptr: Pointer to deque structure
 //   x1 (void*) - process: Process pointer to add
 //
 // Returns:
-//   x0 (int) - success: 1 on success, 0 on failure
+//   x0 (int) - success: 1 on success, 0 if NULL arguments or the deque is full
 //
 // Complexity: O(1) - Constant time operation
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-// Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16, x17, x18, x19, x20, x21, x22, x23, x24, x25, x26, x27, x28, x29, x30
+// Clobbers: x1, x2, x3, x4, x5, x6, x7
 //
 _ws_deque_push_bottom:
-    // Save callee-saved registers
-    stp x19, x30, [sp, #-16]!
-    stp x20, x21, [sp, #-16]!
-
     // Validate parameters
     cbz x0, push_failed  // Check deque pointer
     cbz x1, push_failed  // Check process pointer
+    ldr x6, [x0, #ws_deque_processes]
+    cbz x6, push_failed  // Check if array is allocated
+
+    // Refuse to overwrite slots thieves have not consumed yet
+    ldr x2, [x0, #ws_deque_bottom]    // Owner-private, plain load
+    add x3, x0, #ws_deque_top
+    ldar x3, [x3]
+    sub x4, x2, x3
+    ldr w5, [x0, #ws_deque_size]
+    cmp x4, x5
+    b.ge push_failed                  // Full
+
+    // Store process in array (index = bottom & mask)
+    ldr w7, [x0, #ws_deque_mask]
+    and x7, x2, x7
+    str x1, [x6, x7, lsl #3]
+
+    // Publish the slot, then the new bottom
+    add x2, x2, #1
+    add x3, x0, #ws_deque_bottom
+    stlr x2, [x3]
 
-    // Save parameters
-    mov x19, x0  // deque_ptr
-    mov x20, x1  // process
-
-    // Get current bottom pointer
-    ldr x21, [x19, #ws_deque_bottom]
-    
-    // Get process array pointer
-    ldr x23, [x19, #ws_deque_processes]
-    cbz x23, push_failed  // Check if array is allocated
-
-    // Calculate index with mask
-    ldr x22, [x19, #ws_deque_mask]
-    and x24, x21, x22  // index = bottom & mask
-
-    // Store process in array
-    str x20, [x23, x24, lsl #3]  // processes[index] = process
-
-    // Memory barrier to ensure store is visible
-    dmb sy
-
-    // Update bottom pointer (increment actual pointer, not masked)
-    add x21, x21, #1
-    str x21, [x19, #ws_deque_bottom]
-
-    // Return success
     mov x0, #1
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
     ret
 
 push_failed:
     mov x0, #0
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
     ret
 
 // ------------------------------------------------------------
@@ -286,6 +293,10 @@ push_failed:
 // ------------------------------------------------------------
 // Remove a process from the bottom of the deque (local scheduler operation).
 // This is the fast path for local schedulers getting work from their queue.
+// Chase-Lev owner pop: bottom is decremented and fenced before top is
+// read, so an owner and a thief can only contend for the last process.
+// That case is settled by a compare-and-swap on top; the loser gets
+// NULL. Failed and spurious exclusive stores are counted in cas_retries.
 //
 // Parameters:
 //   x0 (void*) - deque_ptr: Pointer to deque structure
@@ -295,68 +306,88 @@ push_failed:
 //
 // Complexity: O(1) - Constant time operation
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-// Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16, x17, x18, x19, x20, x21, x22, x23, x24, x25, x26, x27, x28, x29, x30
+// Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12
 //
 _ws_deque_pop_bottom:
-    // Save callee-saved registers
-    stp x19, x30, [sp, #-16]!
-    stp x20, x21, [sp, #-16]!
-
     // Validate parameters
     cbz x0, pop_bottom_failed  // Check deque pointer
+    ldr x9, [x0, #ws_deque_processes]
+    cbz x9, pop_bottom_failed  // Check if array is allocated
+
+    // Claim the bottom slot before looking at top (StoreLoad fence)
+    ldr x1, [x0, #ws_deque_bottom]
+    sub x1, x1, #1
+    str x1, [x0, #ws_deque_bottom]
+    dmb ish
+    ldr x2, [x0, #ws_deque_top]
+
+    // Empty if top > bottom (signed: bottom may be -1 here)
+    cmp x2, x1
+    b.gt pop_bottom_empty
+
+    // Load the candidate process
+    ldr w3, [x0, #ws_deque_mask]
+    and x3, x1, x3
+    ldr x4, [x9, x3, lsl #3]
+    cmp x2, x1
+    b.lt pop_bottom_taken              // More than one left: no race
+
+    // Last process: race the thieves for it
+    add x5, x0, #ws_deque_top
+    add x7, x2, #1
+pop_bottom_cas:
+    ldaxr x6, [x5]
+    cmp x6, x2
+    b.ne pop_bottom_lost
+    stlxr w8, x7, [x5]
+    cbz w8, pop_bottom_won
+    add x10, x0, #ws_deque_cas_retries
+pop_bottom_count_spurious:
+    ldxr x11, [x10]
+    add x11, x11, #1
+    stxr w12, x11, [x10]
+    cbnz w12, pop_bottom_count_spurious
+    b pop_bottom_cas
+
+pop_bottom_won:
+    // Deque is now empty: bottom = top
+    str x7, [x0, #ws_deque_bottom]
+    b pop_bottom_taken
+
+pop_bottom_lost:
+    // A thief took it first
+    clrex
+    str x7, [x0, #ws_deque_bottom]
+    add x10, x0, #ws_deque_cas_retries
+pop_bottom_count_lost:
+    ldxr x11, [x10]
+    add x11, x11, #1
+    stxr w12, x11, [x10]
+    cbnz w12, pop_bottom_count_lost
+    mov x0, #0
+    ret
 
-    // Save parameters
-    mov x19, x0  // deque_ptr
-
-    // Get current bottom and top pointers
-    ldr x20, [x19, #ws_deque_bottom]
-    ldr x21, [x19, #ws_deque_top]
-
-    // Check if deque is empty (bottom <= top)
-    cmp x20, x21
-    b.le pop_bottom_empty
-
-    // Decrement bottom pointer
-    sub x20, x20, #1
-    str x20, [x19, #ws_deque_bottom]
-
-    // Get process array pointer
-    ldr x23, [x19, #ws_deque_processes]
-    cbz x23, pop_bottom_failed  // Check if array is allocated
-
-    // Calculate index with mask
-    ldr x22, [x19, #ws_deque_mask]
-    and x24, x20, x22  // index = bottom & mask
-
-    // Load process from array
-    ldr x25, [x23, x24, lsl #3]  // process = processes[index]
-
-    // Increment local pops counter
-    ldr x26, [x19, #ws_deque_local_pops]
-    add x26, x26, #1
-    str x26, [x19, #ws_deque_local_pops]
-
-    // Return process
-    mov x0, x25
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
+pop_bottom_taken:
+    // Increment local pops counter (owner-only field)
+    ldr x5, [x0, #ws_deque_local_pops]
+    add x5, x5, #1
+    str x5, [x0, #ws_deque_local_pops]
+    mov x0, x4
     ret
 
 pop_bottom_empty:
-    // Deque is empty, return NULL
+    // Restore bottom and return NULL
+    add x1, x1, #1
+    str x1, [x0, #ws_deque_bottom]
     mov x0, #0
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
     ret
 
 pop_bottom_failed:
     mov x0, #0
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
     ret
 
 // ------------------------------------------------------------
@@ -364,6 +395,12 @@ pop_bottom_failed:
 // ------------------------------------------------------------
 // Remove a process from the top of the deque (remote scheduler operation).
 // This implements the work stealing mechanism using atomic operations.
+// Any number of thieves may call this concurrently with the owner.
+// Top is read, fenced, then bottom is read; the process is loaded and
+// top advanced with a compare-and-swap. Losing the race (to another
+// thief or the owner) or a spurious exclusive failure counts a retry
+// in cas_retries and re-examines the deque, so NULL means it was seen
+// empty. The steal counters are updated atomically.
 //
 // Parameters:
 //   x0 (void*) - deque_ptr: Pointer to deque structure
@@ -373,89 +410,74 @@ pop_bottom_failed:
 //
 // Complexity: O(1) - Constant time operation with retry logic
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-// Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16, x17, x18, x19, x20, x21, x22, x23, x24, x25, x26, x27, x28, x29, x30
+// Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12
 //
 _ws_deque_pop_top:
-    // Save callee-saved registers
-    stp x19, x30, [sp, #-16]!
-    stp x20, x21, [sp, #-16]!
-    stp x22, x23, [sp, #-16]!
-    stp x24, x25, [sp, #-16]!
-
     // Validate parameters
     cbz x0, pop_top_failed  // Check deque pointer
+    ldr x9, [x0, #ws_deque_processes]
+    cbz x9, pop_top_failed  // Check if array is allocated
 
-    // Save parameters
-    mov x19, x0  // deque_ptr
+    // Attempts are not counted here: an idle thief polling an empty
+    // deque would write the victim's line on every probe. The thief's
+    // scheduler counts them (scheduler_steal_attempts).
 
-    // Get process array pointer
-    ldr x20, [x19, #ws_deque_processes]
-    cbz x20, pop_top_failed  // Check if array is allocated
-
-    // Get mask for circular buffer
-    ldr x21, [x19, #ws_deque_mask]
-
-    // Increment steal attempts counter
-    ldr x22, [x19, #ws_deque_steal_attempts]
-    add x22, x22, #1
-    str x22, [x19, #ws_deque_steal_attempts]
+    add x5, x0, #ws_deque_top
+    add x6, x0, #ws_deque_bottom
 
 pop_top_retry:
-    // Load top pointer with exclusive access
-    add x26, x19, #ws_deque_top
-    ldxr x22, [x26]
-    ldr x23, [x19, #ws_deque_bottom]
+    // Read top before bottom (LoadLoad fence)
+    ldar x2, [x5]
+    dmb ish
+    ldar x1, [x6]
 
     // Check if deque is empty (top >= bottom)
-    cmp x22, x23
+    cmp x2, x1
     b.ge pop_top_empty
 
-    // Calculate new top pointer
-    add x24, x22, #1
-
-    // Calculate index with mask for array access
-    and x28, x22, x21  // index = top & mask
-
-    // Load process from array
-    ldr x25, [x20, x28, lsl #3]  // process = processes[index]
-
-    // Update top pointer atomically
-    stxr w27, x24, [x26]
-    cbnz w27, pop_top_retry  // Retry if store failed
-
-    // Successfully stole process
-    // Increment steal count
-    ldr x26, [x19, #ws_deque_steal_count]
-    add x26, x26, #1
-    str x26, [x19, #ws_deque_steal_count]
-
-    // Return process
-    mov x0, x25
-    ldp x24, x25, [sp], #16
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
+    // Load the candidate, then try to advance top past it
+    ldr w3, [x0, #ws_deque_mask]
+    and x3, x2, x3
+    ldr x4, [x9, x3, lsl #3]
+    add x7, x2, #1
+    ldaxr x1, [x5]
+    cmp x1, x2
+    b.ne pop_top_contended
+    stlxr w8, x7, [x5]
+    cbnz w8, pop_top_count_retry
+
+    // Successfully stole process: increment steal count
+    add x10, x0, #ws_deque_steal_count
+pop_top_count_steal:
+    ldxr x11, [x10]
+    add x11, x11, #1
+    stxr w12, x11, [x10]
+    cbnz w12, pop_top_count_steal
+    mov x0, x4
     ret
 
+pop_top_contended:
+    clrex
+pop_top_count_retry:
+    add x10, x0, #ws_deque_cas_retries
+pop_top_count_retry_loop:
+    ldxr x11, [x10]
+    add x11, x11, #1
+    stxr w12, x11, [x10]
+    cbnz w12, pop_top_count_retry_loop
+    b pop_top_retry
+
 pop_top_empty:
     // Deque is empty, return NULL
     mov x0, #0
-    ldp x24, x25, [sp], #16
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
     ret
 
 pop_top_failed:
     mov x0, #0
-    ldp x24, x25, [sp], #16
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
     ret
 
 // ------------------------------------------------------------
@@ -524,8 +546,11 @@ _ws_deque_size:
     ldr x1, [x0, #ws_deque_top]
     ldr x2, [x0, #ws_deque_bottom]
 
-    // Calculate size (bottom - top)
+    // Calculate size (bottom - top); a concurrent owner pop can leave
+    // bottom one below top for an instant, which reads as empty
     sub x0, x2, x1
+    cmp x0, #0
+    csel x0, x0, xzr, gt
     ret
 
 size_failed:
@@ -539,16 +564,17 @@ size_failed:
 // Load is weighted by priority: MAX=4, HIGH=3, NORMAL=2, LOW=1.
 //
 // Parameters:
-//   x0 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
 //
 // Returns:
-//   x0 (uint32_t) - load: Calculated load value
+//   x0 (uint32_t) - load: Calculated load value, or 0 for an invalid core
 //
 // Complexity: O(p) where p is number of priority levels (4)
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 // Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16, x17, x18, x19, x20, x21, x22, x23, x24, x25, x26, x27, x28, x29, x30
 //
@@ -556,6 +582,8 @@ _get_scheduler_load:
     // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
 
     // Validate core ID
     cmp x1, #MAX_CORES
@@ -566,7 +594,7 @@ _get_scheduler_load:
     mov x20, x1  // core_id
 
     // Calculate scheduler state address
-    mov x21, #248                    // scheduler_size = 248
+    mov x21, #scheduler_size
     mul x21, x20, x21
     add x20, x19, x21  // x20 = scheduler state address
 
@@ -575,37 +603,41 @@ _get_scheduler_load:
 
     // Calculate load for each priority level
     // MAX priority (weight = 4)
-    add x22, x20, #8                 // Queue array base (scheduler_queues = 8)
-    ldr w23, [x22, #16]             // MAX queue count (queue_count = 16)
+    add x22, x20, #scheduler_queues  // Queue array base
+    ldr w23, [x22, #queue_count]    // MAX queue count
     lsl x23, x23, #2                 // Multiply by 4
     add x21, x21, x23                // load += MAX_count * 4
 
     // HIGH priority (weight = 3)
-    add x22, x22, #24               // Move to HIGH queue (queue_size = 24)
-    ldr w23, [x22, #16]             // HIGH queue count (queue_count = 16)
+    add x22, x22, #queue_size       // Move to HIGH queue
+    ldr w23, [x22, #queue_count]    // HIGH queue count
     mov x24, #3
     mul x23, x23, x24               // Multiply by 3
     add x21, x21, x23               // load += HIGH_count * 3
 
     // NORMAL priority (weight = 2)
-    add x22, x22, #24               // Move to NORMAL queue (queue_size = 24)
-    ldr w23, [x22, #16]             // NORMAL queue count (queue_count = 16)
+    add x22, x22, #queue_size       // Move to NORMAL queue
+    ldr w23, [x22, #queue_count]    // NORMAL queue count
     lsl x23, x23, #1                // Multiply by 2
     add x21, x21, x23               // load += NORMAL_count * 2
 
     // LOW priority (weight = 1)
-    add x22, x22, #24               // Move to LOW queue (queue_size = 24)
-    ldr w23, [x22, #16]             // LOW queue count (queue_count = 16)
+    add x22, x22, #queue_size       // Move to LOW queue
+    ldr w23, [x22, #queue_count]    // LOW queue count
     add x21, x21, x23               // load += LOW_count * 1
 
     // Return load
     mov x0, x21
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
 get_load_invalid:
     mov x0, #0
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
@@ -613,19 +645,25 @@ get_load_invalid:
 // ------------------------------------------------------------
 // Find Busiest Scheduler
 // ------------------------------------------------------------
-// Find the scheduler with the highest load among all cores.
+// Find the scheduler with the highest load among the other schedulers
+// in the states array. The scan is bounded by scheduler_count (kept in
+// state 0 by _scheduler_state_init), so states that were never
+// allocated are not read. Remote queue counts are read without
+// synchronization, so the answer is a hint.
 //
 // Parameters:
-//   x0 (uint64_t) - current_core: Current core ID (excluded from search)
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - current_core: Current core ID (excluded from search)
 //
 // Returns:
-//   x0 (uint64_t) - busiest_core: Core ID with highest load, or current_core if none found
+//   x0 (uint64_t) - busiest_core: Core ID with highest load, current_core
+//                   if no other core has work, or 0 on invalid arguments
 //
 // Complexity: O(n) where n is number of cores
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 // Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16, x17, x18, x19, x20, x21, x22, x23, x24, x25, x26, x27, x28, x29, x30
 //
@@ -634,13 +672,22 @@ _find_busiest_scheduler:
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
     stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
 
-    // Validate current core ID
-    cmp x0, #MAX_CORES
+    // Validate parameters
+    cbz x0, find_busiest_invalid
+    cmp x1, #MAX_CORES
     b.ge find_busiest_invalid
 
-    // Save current core ID
-    mov x19, x0
+    // Save parameters
+    mov x24, x0  // scheduler_states pointer
+    mov x19, x1  // current core ID
+
+    // Cores to scan
+    ldr w25, [x24, #scheduler_count]
+    mov x0, #MAX_CORES
+    cmp x25, x0
+    csel x25, x0, x25, hi
 
     // Initialize search variables
     mov x20, #0        // best_core = 0
@@ -648,12 +695,16 @@ _find_busiest_scheduler:
     mov x22, #0        // core_index = 0
 
 find_busiest_loop:
+    cmp x22, x25
+    b.hs find_busiest_done
+
     // Skip current core
     cmp x22, x19
     b.eq find_busiest_next
 
     // Get load for this core
-    mov x0, x22
+    mov x0, x24
+    mov x1, x22
     bl _get_scheduler_load
     mov x23, x0  // current_load
 
@@ -668,14 +719,15 @@ find_busiest_loop:
 find_busiest_next:
     // Move to next core
     add x22, x22, #1
-    cmp x22, #MAX_CORES
-    b.lt find_busiest_loop
+    b find_busiest_loop
 
+find_busiest_done:
     // Check if we found a core with work
     cbz x21, find_busiest_no_work
 
     // Return best core
     mov x0, x20
+    ldp x24, x25, [sp], #16
     ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
@@ -684,6 +736,7 @@ find_busiest_next:
 find_busiest_no_work:
     // No work found, return current core
     mov x0, x19
+    ldp x24, x25, [sp], #16
     ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
@@ -691,6 +744,7 @@ find_busiest_no_work:
 
 find_busiest_invalid:
     mov x0, #0
+    ldp x24, x25, [sp], #16
     ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
@@ -699,64 +753,48 @@ find_busiest_invalid:
 // ------------------------------------------------------------
 // Is Steal Allowed
 // ------------------------------------------------------------
-// Check if work stealing is allowed from source to target core.
-// Considers migration limits, affinity constraints, and cooldown periods.
+// Check whether a process may move from the source core to the target
+// core: both cores must be valid and distinct, the process must have
+// migrated fewer than MAX_MIGRATIONS times and its affinity mask must
+// include the target. The migration cooldown depends on the caller's
+// clock and is checked by _serve_steal_request.
 //
 // Parameters:
 //   x0 (uint64_t) - source_core: Source core ID
 //   x1 (uint64_t) - target_core: Target core ID
+//   x2 (void*) - pcb: Process to move
 //
 // Returns:
 //   x0 (int) - allowed: 1 if allowed, 0 if not allowed
 //
 // Complexity: O(1) - Constant time operation
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
+//
+// Clobbers: x3, x4
 //
 _is_steal_allowed:
     // Validate parameters
     cmp x0, #MAX_CORES
-    b.ge steal_not_allowed
+    b.hs steal_not_allowed
     cmp x1, #MAX_CORES
-    b.ge steal_not_allowed
+    b.hs steal_not_allowed
+    cmp x0, x1
+    b.eq steal_not_allowed
+    cbz x2, steal_not_allowed
 
     // Check migration count limits
-    ldr x2, [x21, #392]  // pcb_migration_count = 392
-    mov x3, #MAX_MIGRATIONS
-    cmp x2, x3
-    b.ge steal_not_allowed
-    
+    ldr x3, [x2, #pcb_migration_count]
+    cmp x3, #MAX_MIGRATIONS
+    b.hs steal_not_allowed
+
     // Check affinity constraints
-    ldr x4, [x21, #384]  // pcb_affinity_mask = 384
-    mov x5, #1
-    lsl x5, x5, x1  // Create mask for target core
-    and x4, x4, x5
-    cbz x4, steal_not_allowed
-    
-    // Check cooldown period
-    ldr x6, [x21, #400]  // pcb_last_migration_time = 400
-    mrs x7, CNTPCT_EL0  // Current time
-    sub x8, x7, x6
-    mov x9, #1000  // MIGRATION_COOLDOWN_TICKS (simplified)
-    cmp x8, x9
-    b.lt steal_not_allowed
-    
-    // Check load imbalance threshold
-    mov x0, x1  // target_core
-    bl _get_scheduler_load
-    mov x10, x0  // target_load
-    
-    mov x0, x20  // current_core
-    bl _get_scheduler_load
-    mov x11, x0  // current_load
-    
-    sub x12, x10, x11  // load difference
-    mov x13, #LOAD_IMBALANCE_THRESHOLD
-    cmp x12, x13
-    b.lt steal_not_allowed
-    
+    ldr x4, [x2, #pcb_affinity_mask]
+    lsr x4, x4, x1      // Target core's bit
+    tbz x4, #0, steal_not_allowed
+
     mov x0, #1  // Allow steal
     ret
 
@@ -821,16 +859,17 @@ select_random_invalid:
 // Select victim core based on load (find the busiest core).
 //
 // Parameters:
-//   x0 (uint64_t) - current_core: Current core ID
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - current_core: Current core ID
 //
 // Returns:
 //   x0 (uint64_t) - victim_core: Victim core ID with highest load
 //
 // Complexity: O(n) where n is number of cores
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 _select_victim_by_load:
     // Use the existing find_busiest_scheduler function
@@ -843,100 +882,143 @@ _select_victim_by_load:
 // For now, this is a simplified implementation that falls back to load-based selection.
 //
 // Parameters:
-//   x0 (uint64_t) - current_core: Current core ID
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - current_core: Current core ID
 //
 // Returns:
-//   x0 (uint64_t) - victim_core: Locality-aware victim core ID
+//   x0 (uint64_t) - victim_core: Locality-aware victim core ID, or 0 on
+//                   invalid arguments
 //
 // Complexity: O(n) where n is number of cores
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 _select_victim_locality:
     // Save callee-saved registers
     stp x19, x20, [sp, #-16]!
     stp x21, x22, [sp, #-16]!
     stp x23, x24, [sp, #-16]!
-    stp x25, x30, [sp, #-16]!
-    
+    stp x25, x26, [sp, #-16]!
+    stp x27, x30, [sp, #-16]!
+
+    // Validate parameters
+    cbz x0, locality_invalid
+    cmp x1, #MAX_CORES
+    b.ge locality_invalid
+
+    mov x25, x0  // scheduler_states pointer
+    mov x19, x1  // Save current_core
+
+    // Cores to scan (see _find_busiest_scheduler)
+    ldr w26, [x25, #scheduler_count]
+    mov x0, #MAX_CORES
+    cmp x26, x0
+    csel x26, x0, x26, hi
+
     // Get current core's NUMA node
-    mov x19, x0  // Save current_core
+    mov x0, x19
     bl _get_numa_node
     mov x20, x0  // current_numa_node
-    
+
     // Try to find cores on same NUMA node
     mov x21, #0  // core_index
-    mov x22, #0  // best_local_core
+    mov x22, x19 // best_local_core (none yet)
     mov x23, #0  // best_local_load
-    
+
 locality_scan_cores:
-    cmp x21, #MAX_CORES
-    b.ge locality_check_found
-    
+    cmp x21, x26
+    b.hs locality_check_found
+
     // Skip current core
     cmp x21, x19
     b.eq locality_next_core
-    
+
     // Get core's NUMA node
     mov x0, x21
     bl _get_numa_node
     cmp x0, x20  // Compare with current NUMA node
     b.ne locality_next_core
-    
+
     // Get core's load
-    mov x0, x21
+    mov x0, x25
+    mov x1, x21
     bl _get_scheduler_load
     mov x24, x0  // core_load
-    
+
     // Check if this is better than current best
     cmp x24, x23
-    b.le locality_next_core
-    
+    b.ls locality_next_core
+
     // Update best local core
     mov x22, x21
     mov x23, x24
-    
+
 locality_next_core:
     add x21, x21, #1
     b locality_scan_cores
-    
+
 locality_check_found:
     // If we found a local core with work, use it
-    cbz x22, locality_fallback_to_load
+    cbz x23, locality_fallback_to_load
     mov x0, x22
-    ldp x25, x30, [sp], #16
+    ldp x27, x30, [sp], #16
+    ldp x25, x26, [sp], #16
     ldp x23, x24, [sp], #16
     ldp x21, x22, [sp], #16
     ldp x19, x20, [sp], #16
     ret
-    
+
 locality_fallback_to_load:
     // Fall back to load-based selection
-    ldp x25, x30, [sp], #16
+    mov x0, x25
+    mov x1, x19
+    ldp x27, x30, [sp], #16
+    ldp x25, x26, [sp], #16
     ldp x23, x24, [sp], #16
     ldp x21, x22, [sp], #16
     ldp x19, x20, [sp], #16
     b _select_victim_by_load
 
+locality_invalid:
+    mov x0, #0
+    ldp x27, x30, [sp], #16
+    ldp x25, x26, [sp], #16
+    ldp x23, x24, [sp], #16
+    ldp x21, x22, [sp], #16
+    ldp x19, x20, [sp], #16
+    ret
+
 // ------------------------------------------------------------
 // Try Steal Work
 // ------------------------------------------------------------
-// Attempt to steal work from another scheduler.
-// This is the main work stealing function called by idle schedulers.
+// Ask the busiest other scheduler for work. Called by an idle
+// scheduler on its own thread. Run queues belong to their scheduler,
+// so the thief never dequeues from the victim: it posts its core ID
+// in the victim's steal_request word and wakes the victim. The victim
+// answers at the end of its next pass (_serve_steal_request) by
+// handing the tail of a run queue over through the thief's timer
+// inbox, which wakes the thief. The thief's timer wheel is created
+// here so the hand-off always has an inbox to land in.
+//
+// Nothing is posted unless the victim's load exceeds the thief's by
+// more than LOAD_IMBALANCE_THRESHOLD, or while another request to the
+// same victim is pending. Each posted request counts one steal attempt
+// on the thief.
 //
 // Parameters:
-//   x0 (uint64_t) - current_core: Current core ID
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - current_core: Idle (thief) core ID
 //
 // Returns:
-//   x0 (void*) - stolen_process: Stolen process pointer, or NULL if no work stolen
+//   x0 (int) - requested: 1 if a request was posted, 0 otherwise
 //
 // Complexity: O(n) where n is number of cores (for victim selection)
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 // Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16, x17, x18, x19, x20, x21, x22, x23, x24, x25, x26, x27, x28, x29, x30
 //
@@ -946,9 +1028,10 @@ _try_steal_work:
     stp x20, x21, [sp, #-16]!
     stp x22, x23, [sp, #-16]!
 
-    // Validate current core ID
+    // Validate parameters
+    cbz x0, steal_work_failed
     cmp x1, #MAX_CORES
-    b.ge steal_work_failed
+    b.hs steal_work_failed
 
     // Save parameters
     mov x19, x0  // scheduler_states pointer
@@ -956,103 +1039,304 @@ _try_steal_work:
 
     // Check if work stealing is enabled
     mov x21, #WORK_STEAL_ENABLED
-    cbz x21, steal_work_disabled
+    cbz x21, steal_work_failed
 
     // Select victim using default strategy
-    mov x0, x19  // scheduler_states pointer
-    mov x1, x20  // current core ID
+    mov x0, x19
+    mov x1, x20
     bl _select_victim_by_load
     mov x21, x0  // victim_core
-
-    // Check if we found a valid victim
     cmp x21, x20
-    b.eq steal_work_no_victim
+    b.eq steal_work_failed
 
-    // Check if steal is allowed
-    mov x0, x19  // scheduler_states pointer
-    mov x1, x20  // source_core
-    mov x2, x21  // target_core
-    bl _is_steal_allowed
-    cbz x0, steal_work_not_allowed
+    // Only worth a request if the imbalance is large enough
+    mov x0, x19
+    mov x1, x21
+    bl _get_scheduler_load
+    mov x22, x0  // victim load
+    mov x0, x19
+    mov x1, x20
+    bl _get_scheduler_load
+    sub x22, x22, x0
+    cmp x22, #LOAD_IMBALANCE_THRESHOLD
+    b.le steal_work_failed
 
-    // Get victim's scheduler state
-    mov x0, x21  // victim_core
-    bl _get_scheduler_state
-    mov x22, x0  // victim_state
-    
-    // Try to steal from highest priority queue first
-    mov x23, #NUM_PRIORITIES
-    sub x23, x23, #1  // Start with highest priority
-    
-steal_try_priority:
-    // Get queue for this priority
-    mov x0, x22  // scheduler_state
-    mov x1, x21  // core_id
-    mov x2, x23  // priority
-    bl _get_priority_queue
-    
-    // Try to dequeue from this queue
-    mov x0, x22  // scheduler_state
-    mov x1, x21  // core_id
-    mov x2, x23  // priority
-    bl _scheduler_dequeue_process
-    mov x24, x0  // stolen_process
-    
-    cbz x24, steal_try_next_priority
-    
-    // Update migration count
-    ldr x25, [x24, #392]  // pcb_migration_count = 392
-    add x25, x25, #1
-    str x25, [x24, #392]  // pcb_migration_count = 392
-    
-    // Update last migration time
-    mrs x26, CNTPCT_EL0
-    str x26, [x24, #400]  // pcb_last_migration_time = 400
-    
-    // Update statistics
-    mov x0, x20  // current_core
-    bl _increment_steal_count
-    
-    mov x0, x24  // Return stolen process
+    // The hand-off arrives through this core's timer inbox
+    mov x0, x19
+    mov x1, x20
+    bl _timer_wheel_init
+    cbz x0, steal_work_failed
+
+    // Post the request unless one is already pending
+    mov x0, #scheduler_size
+    madd x22, x21, x0, x19  // victim state
+    add x0, x22, #scheduler_steal_request
+    add w1, w20, #1  // thief core + 1 (0 means no request)
+steal_work_post:
+    ldaxr w2, [x0]
+    cbnz w2, steal_work_busy
+    stlxr w3, w1, [x0]
+    cbnz w3, steal_work_post
+
+    // Count the attempt on the thief
+    mov x0, #scheduler_size
+    madd x23, x20, x0, x19
+    ldr x0, [x23, #scheduler_steal_attempts]
+    add x0, x0, #1
+    str x0, [x23, #scheduler_steal_attempts]
+
+    // Make sure the victim runs a pass to answer
+    mov x0, x19
+    mov x1, x21
+    bl _scheduler_wake
+
+    mov x0, #1
     ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
-    
-steal_try_next_priority:
-    sub x23, x23, #1
-    cmp x23, #0
-    b.ge steal_try_priority
-    
-    // No work found
+
+steal_work_busy:
+    clrex
+
+steal_work_failed:
     mov x0, #0
     ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
-steal_work_no_victim:
-    mov x0, #0
+// ------------------------------------------------------------
+// Serve Steal Request
+// ------------------------------------------------------------
+// Answer the steal request posted by _try_steal_work, if any. Runs on
+// the victim's own thread (from _check_load_balance at the end of each
+// pass), so taking a process from its run queues needs no locking. The
+// request is consumed whether or not it is granted.
+//
+// It is granted when this scheduler's load still exceeds the thief's
+// by more than LOAD_IMBALANCE_THRESHOLD and the tail of its
+// highest-priority non-empty queue may move (_is_steal_allowed, and
+// MIGRATION_COOLDOWN_TICKS since its last migration on this
+// scheduler's clock). That process is unlinked, re-homed to the thief
+// and armed as a due timer on this core's wheel with _steal_arrive as
+// the callback. The next tick forwards the timer to the thief's inbox
+// and wakes the thief (see _timer_dispatch), which queues the process.
+// If no timer node can be allocated the process is put back.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: This (victim) scheduler's core ID
+//
+// Returns:
+//   x0 (void*) - process: PCB handed to the thief, or NULL
+//
+// Complexity: O(n) where n is number of cores (for the load check)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_serve_steal_request:
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+
+    // Validate parameters
+    cbz x0, serve_steal_none
+    cmp x1, #MAX_CORES
+    b.hs serve_steal_none
+
+    mov x19, x0  // scheduler_states pointer
+    mov x20, x1  // core_id
+    mov x0, #scheduler_size
+    madd x21, x20, x0, x19  // this scheduler's state
+
+    // Take the request; only this core clears a posted request
+    add x0, x21, #scheduler_steal_request
+    ldar w22, [x0]
+    cbz w22, serve_steal_none
+    stlr wzr, [x0]
+    sub x22, x22, #1  // thief core
+    cmp x22, #MAX_CORES
+    b.hs serve_steal_none
+    cmp x22, x20
+    b.eq serve_steal_none
+
+    // Still imbalanced?
+    mov x0, x19
+    mov x1, x20
+    bl _get_scheduler_load
+    mov x23, x0  // own load
+    mov x0, x19
+    mov x1, x22
+    bl _get_scheduler_load
+    sub x23, x23, x0
+    cmp x23, #LOAD_IMBALANCE_THRESHOLD
+    b.le serve_steal_none
+
+    // Candidate: tail of the highest-priority non-empty queue
+    add x0, x21, #scheduler_queues
+    mov x23, #0      // priority
+serve_steal_scan:
+    ldr w1, [x0, #queue_count]
+    cbnz w1, serve_steal_candidate
+    add x0, x0, #queue_size
+    add x23, x23, #1
+    cmp x23, #NUM_PRIORITIES
+    b.lo serve_steal_scan
+    b serve_steal_none
+
+serve_steal_candidate:
+    mov x25, x0  // queue
+    ldr x24, [x25, #queue_tail]
+    mov x0, x20
+    mov x1, x22
+    mov x2, x24
+    bl _is_steal_allowed
+    cbz x0, serve_steal_none
+
+    // Cooldown on this scheduler's clock; never-migrated processes
+    // have no last migration time
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_get_cached_now
+    mov x21, x0  // now (the state address is no longer needed)
+    ldr x1, [x24, #pcb_migration_count]
+    cbz x1, serve_steal_take
+    ldr x1, [x24, #pcb_last_migration_time]
+    sub x1, x21, x1
+    movz x2, #(MIGRATION_COOLDOWN_TICKS & 0xFFFF)
+    movk x2, #(MIGRATION_COOLDOWN_TICKS >> 16), lsl #16
+    cmp x1, x2
+    b.lo serve_steal_none
+
+serve_steal_take:
+    mov x6, x25
+    bl steal_unlink_tail
+
+    // Re-home to the thief; the timer is forwarded on that basis
+    str x22, [x24, #pcb_scheduler_id]
+
+    // Hand over as a due timer on this core's wheel
+    mov x0, x19
+    mov x1, x20
+    mov x2, x24
+    mov x3, x21               // expiry = now
+    adr x4, _steal_arrive
+    orr x5, x23, x20, lsl #8  // victim core and priority
+    bl _timer_arm
+    cbz x0, serve_steal_put_back
+
+    mov x0, x24
+    ldp x24, x25, [sp], #16
     ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
-steal_work_not_allowed:
+serve_steal_put_back:
+    // No timer node: the process stays here, back at its queue's tail
+    str x20, [x24, #pcb_scheduler_id]
+    mov x0, x19
+    mov x1, x20
+    mov x2, x24
+    mov x3, x23
+    bl _scheduler_enqueue_process
+
+serve_steal_none:
     mov x0, #0
+    ldp x24, x25, [sp], #16
     ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
-steal_work_disabled:
-    mov x0, #0
+// ------------------------------------------------------------
+// Steal Arrive
+// ------------------------------------------------------------
+// Timer callback that completes a hand-off from _serve_steal_request
+// on the scheduler that receives the process (the thief, once its
+// timer inbox has taken the forwarded node). Re-homes the process to
+// this core, updates its migration count and time, counts the steal
+// and the migration on this scheduler, records a STEAL event when
+// TRACE_CLASS_MIGRATE is enabled and queues the process.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Receiving core ID
+//   x2 (void*) - pcb: Process handed over
+//   x3 (uint64_t) - argument: Victim core << 8 | priority
+//
+// Returns:
+//   x0 (int) - success: 1 if the process was queued, 0 otherwise
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_steal_arrive:
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+
+    // Validate parameters
+    cbz x0, steal_arrive_failed
+    cbz x2, steal_arrive_failed
+    cmp x1, #MAX_CORES
+    b.hs steal_arrive_failed
+
+    mov x19, x0  // scheduler_states pointer
+    mov x20, x1  // core_id
+    mov x21, x2  // pcb
+    mov x22, x3  // victim core and priority
+    mov x0, #scheduler_size
+    madd x23, x20, x0, x19  // this scheduler's state
+
+    // Re-home and update the migration record
+    str x20, [x21, #pcb_scheduler_id]
+    ldr x0, [x21, #pcb_migration_count]
+    add x0, x0, #1
+    str x0, [x21, #pcb_migration_count]
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_get_cached_now
+    str x0, [x21, #pcb_last_migration_time]
+
+    // Statistics, written by their own scheduler
+    ldr x0, [x23, #scheduler_total_steals]
+    add x0, x0, #1
+    str x0, [x23, #scheduler_total_steals]
+    ldr x0, [x23, #scheduler_total_migrations]
+    add x0, x0, #1
+    str x0, [x23, #scheduler_total_migrations]
+
+    // Trace: stolen from the victim, recorded on the thief
+    ldr w0, [x23, #scheduler_trace_mask]
+    tbz w0, #TRACE_CLASS_MIGRATE, steal_arrive_traced
+    mov x0, x23
+    mov x1, #TRACE_EVENT_STEAL
+    ldr x2, [x21, #pcb_pid]
+    lsr x3, x22, #8     // victim core
+    bl _trace_record
+steal_arrive_traced:
+
+    mov x0, x19
+    mov x1, x20
+    mov x2, x21
+    and x3, x22, #0xFF  // priority
+    bl _scheduler_enqueue_process
     ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
-steal_work_failed:
+steal_arrive_failed:
     mov x0, #0
     ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
@@ -1063,7 +1347,9 @@ steal_work_failed:
 // Migrate Process
 // ------------------------------------------------------------
 // Migrate a process from source core to target core.
-// Updates process affinity, migration count, and scheduler statistics.
+// Updates process affinity and migration count. Scheduler statistics
+// are single-writer, so they are left to the core that takes the
+// process (steal_process counts total_migrations on the thief).
 //
 // Parameters:
 //   x0 (void*) - process: Process pointer to migrate
@@ -1075,9 +1361,9 @@ steal_work_failed:
 //
 // Complexity: O(1) - Constant time operation
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 // Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16, x17, x18, x19, x20, x21, x22, x23, x24, x25, x26, x27, x28, x29, x30
 //
@@ -1085,6 +1371,9 @@ _migrate_process:
     // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    stp x26, x27, [sp, #-16]!
 
     // Validate parameters
     cbz x0, migrate_failed  // Check process pointer
@@ -1098,192 +1387,199 @@ _migrate_process:
     mov x20, x1  // source_core
     mov x21, x2  // target_core
 
-    // Update process scheduler ID
-    str x21, [x19, #24]              // pcb_scheduler_id = 24
+    // Update process scheduler ID. Pending timers stay on the source
+    // wheel and are forwarded to the target when they expire.
+    str x21, [x19, #pcb_scheduler_id]
 
     // Increment migration count
-    ldr x22, [x19, #392]             // pcb_migration_count = 392
+    ldr x22, [x19, #pcb_migration_count]
     add x22, x22, #1
-    str x22, [x19, #392]             // pcb_migration_count = 392
+    str x22, [x19, #pcb_migration_count]
 
     // Update last scheduled timestamp (use current time approximation)
     // In a real implementation, this would use a proper timestamp
     mov x23, #0  // Simplified timestamp
-    str x23, [x19, #376]             // pcb_last_scheduled = 376
-
-    // Update scheduler migration statistics
-    // Source scheduler: increment total_migrations
-    mov x24, x19  // scheduler_states pointer
-    mov x25, #248                    // scheduler_size = 248 (was 240)
-    mul x25, x20, x25
-    add x24, x24, x25
-    ldr x26, [x24, #136]             // scheduler_total_migrations = 136
-    add x26, x26, #1
-    str x26, [x24, #136]             // scheduler_total_migrations = 136
-
-    // Target scheduler: increment total_migrations
-    mov x24, x19  // scheduler_states pointer
-    mov x25, #248                    // scheduler_size = 248 (was 240)
-    mul x25, x21, x25
-    add x24, x24, x25
-    ldr x26, [x24, #136]             // scheduler_total_migrations = 136
-    add x26, x26, #1
-    str x26, [x24, #136]             // scheduler_total_migrations = 136
+    str x23, [x19, #pcb_last_scheduled]
 
     // Return success
     mov x0, #1
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
 migrate_failed:
     mov x0, #0
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
 // ------------------------------------------------------------
-// External Dependencies
+// Steal Process
 // ------------------------------------------------------------
-// ------------------------------------------------------------
-// Get NUMA Node Helper Function
-// ------------------------------------------------------------
-// Get the NUMA node ID for a given core.
-// This is a simplified implementation that assumes a single NUMA node.
+// Take one runnable process from a victim scheduler and hand it to the
+// thief. Scans the victim's run queues from MAX to LOW priority and
+// removes the tail of the first non-empty queue: the most recently
+// queued process is the one the victim would run last, so taking it
+// disturbs the victim's cache least. The stolen process is unlinked,
+// re-homed to the thief and has its migration count and timestamp
+// updated; the thief's total_steals and total_migrations are
+// incremented. Every valid call also counts one steal attempt on the
+// thief. The caller enqueues the process on the thief. Records
+// a STEAL event on the thief when TRACE_CLASS_MIGRATE is enabled.
+//
+// Run queues are owned by their scheduler, so the caller must hold
+// the victim's queues (or run both schedulers on one thread, as the
+// simulator does). Scheduler threads steal through _try_steal_work
+// and _serve_steal_request instead.
 //
 // Parameters:
-//   x0 (uint64_t) - core_id: Core ID to get NUMA node for
+//   x0 (void*) - scheduler_states: Scheduler states array
+//   x1 (uint64_t) - thief_core: Core receiving the process
+//   x2 (uint64_t) - victim_core: Core to take the process from
 //
 // Returns:
-//   x0 (uint64_t) - numa_node: NUMA node ID (0 for single node)
+//   x0 (void*) - process: Stolen PCB, or NULL if nothing could be stolen
 //
-// Complexity: O(1) - Constant time operation
+// Complexity: O(p) where p is number of priority levels (4)
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-_get_numa_node:
-    // Simplified implementation - assume single NUMA node
-    // In a full implementation, this would:
-    // - Read NUMA topology from system registers
-    // - Query ACPI tables for NUMA information
-    // - Return actual NUMA node ID
-    mov x0, #0  // Single NUMA node
-    ret
-
-// ------------------------------------------------------------
-// Increment Steal Count Helper Function
-// ------------------------------------------------------------
-// Increment the steal count for a scheduler core.
-//
-// Parameters:
-//   x0 (uint64_t) - core_id: Core ID to update
-//
-// Returns:
-//   None
+// Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10 (x11-x13 when tracing)
 //
-// Complexity: O(1) - Constant time operation
-//
-// Version: 0.10
-// Author: Lee Barney
-// Last Modified: 2025-01-19
-//
-_increment_steal_count:
-    // Save callee-saved registers
-    stp x19, x20, [sp, #-16]!
-    stp x21, x30, [sp, #-16]!
-    
-    // Validate core ID
-    cmp x0, #MAX_CORES
-    b.ge increment_steal_count_done
-    
-    // Get scheduler state for this core
-    mov x19, x0  // Save core_id
-    bl _get_scheduler_state
-    mov x20, x0  // scheduler_state
-    
-    // Increment steal count
-    ldr x21, [x20, #240]  // scheduler_total_steals = 240
-    add x21, x21, #1
-    str x21, [x20, #240]  // scheduler_total_steals = 240
-    
-increment_steal_count_done:
-    ldp x21, x30, [sp], #16
-    ldp x19, x20, [sp], #16
+_steal_process:
+    // Validate parameters
+    cbz x0, steal_process_none
+    cmp x1, #MAX_CORES
+    b.ge steal_process_none
+    cmp x2, #MAX_CORES
+    b.ge steal_process_none
+    cmp x1, x2
+    b.eq steal_process_none
+
+    // Thief and victim state addresses
+    mov x3, #scheduler_size
+    madd x4, x1, x3, x0               // x4 = thief state
+    madd x5, x2, x3, x0               // x5 = victim state
+
+    // Every valid call is an attempt, counted on the thief
+    ldr x9, [x4, #scheduler_steal_attempts]
+    add x9, x9, #1
+    str x9, [x4, #scheduler_steal_attempts]
+
+    // Find the highest-priority non-empty victim queue
+    add x6, x5, #scheduler_queues
+    mov x7, #NUM_PRIORITIES
+
+steal_process_scan:
+    ldr w8, [x6, #queue_count]
+    cbnz w8, steal_process_found
+    add x6, x6, #queue_size
+    subs x7, x7, #1
+    b.ne steal_process_scan
+
+steal_process_none:
+    mov x0, #0
     ret
 
-// Import required functions from other modules
-    .extern _mmap
-    .extern scheduler_size
-    .extern scheduler_queues
-    .extern queue_count
-    .extern pcb_scheduler_id
-    .extern pcb_migration_count
-    .extern pcb_last_scheduled
-    .extern scheduler_total_migrations
+steal_process_found:
+    str x30, [sp, #-16]!
+    bl steal_unlink_tail
+    ldr x30, [sp], #16
+
+    // Re-home the process to the thief
+    str x1, [x0, #pcb_scheduler_id]
+    ldr x9, [x0, #pcb_migration_count]
+    add x9, x9, #1
+    str x9, [x0, #pcb_migration_count]
+    ldr x9, [x4, #scheduler_cached_now]
+    str x9, [x0, #pcb_last_migration_time]
+
+    // Thief statistics
+    ldr x9, [x4, #scheduler_total_steals]
+    add x9, x9, #1
+    str x9, [x4, #240]
+    ldr x10, [x4, #scheduler_total_migrations]
+    add x10, x10, #1
+    str x10, [x4, #136]
+
+    // Trace: stolen from the victim, recorded on the thief
+    ldr w9, [x4, #scheduler_trace_mask]
+    tbz w9, #TRACE_CLASS_MIGRATE, steal_process_done
+    stp x0, x30, [sp, #-16]!
+    mov x3, x2                        // victim_core
+    ldr x2, [x0, #pcb_pid]
+    mov x0, x4
+    mov x1, #TRACE_EVENT_STEAL
+    bl _trace_record
+    ldp x0, x30, [sp], #16
+
+steal_process_done:
+    ret
 
 // ------------------------------------------------------------
-// Get Scheduler State Helper Function
+// Steal Unlink Tail (internal)
 // ------------------------------------------------------------
-// Get the scheduler state for a given core ID.
+// Unlink the tail of a non-empty run queue. prev links are maintained
+// for all but the head, so this is O(1). Only the queue's owner (or a
+// caller that holds it) may do this.
 //
 // Parameters:
-//   x0 (uint64_t) - core_id: Core ID to get state for
+//   x6 (void*) - queue: Run queue with at least one entry
 //
 // Returns:
-//   x0 (void*) - scheduler_state: Pointer to scheduler state
+//   x0 (void*) - process: Unlinked PCB
 //
-// Complexity: O(1) - Constant time operation
+// Complexity: O(1)
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
-//
-_get_scheduler_state:
-    // Save callee-saved registers
-    stp x19, x20, [sp, #-16]!
-    stp x21, x30, [sp, #-16]!
-
-    // Validate core ID
-    cmp x0, #MAX_CORES
-    b.ge get_scheduler_state_invalid
-
-    // Save core ID
-    mov x19, x0  // core_id
-
-    // Get global scheduler_states pointer (passed from caller)
-    // In a real implementation, this would be a global variable
-    // For now, we'll use a simplified approach
-    mov x20, #0x10000000  // Dummy scheduler states base address
-    mov x21, #248         // scheduler_size = 248
-    mul x21, x19, x21     // core_id * scheduler_size
-    add x20, x20, x21     // scheduler_states + offset
-
-    // Return scheduler state address
-    mov x0, x20
-    ldp x21, x30, [sp], #16
-    ldp x19, x20, [sp], #16
-    ret
-
-get_scheduler_state_invalid:
-    mov x0, #0
-    ldp x21, x30, [sp], #16
-    ldp x19, x20, [sp], #16
+// Last Modified: 2026-10-18
+//
+// Clobbers: x8, x9
+//
+steal_unlink_tail:
+    ldr w8, [x6, #queue_count]
+    ldr x0, [x6, #queue_tail]
+    cmp w8, #1
+    b.ne steal_unlink_tail_prev
+    str xzr, [x6, #0]                 // Last entry: head = NULL
+    str xzr, [x6, #8]                 // tail = NULL
+    b steal_unlink_tail_count
+
+steal_unlink_tail_prev:
+    ldr x9, [x0, #pcb_prev]
+    str xzr, [x9, #0]                 // new_tail->next = NULL
+    str x9, [x6, #8]                  // tail = new_tail
+
+steal_unlink_tail_count:
+    sub w8, w8, #1
+    str w8, [x6, #16]
+    str xzr, [x0, #pcb_next]
+    str xzr, [x0, #pcb_prev]
     ret
 
 // ------------------------------------------------------------
-// Get Priority Queue Helper Function
+// External Dependencies
+// ------------------------------------------------------------
 // ------------------------------------------------------------
-// Get the priority queue for a given scheduler state, core, and priority.
+// Get NUMA Node Helper Function
+// ------------------------------------------------------------
+// Get the NUMA node ID for a given core.
+// This is a simplified implementation that assumes a single NUMA node.
 //
 // Parameters:
-//   x0 (void*) - scheduler_state: Scheduler state pointer
-//   x1 (uint64_t) - core_id: Core ID
-//   x2 (uint32_t) - priority: Priority level
+//   x0 (uint64_t) - core_id: Core ID to get NUMA node for
 //
 // Returns:
-//   x0 (void*) - queue: Priority queue pointer
+//   x0 (uint64_t) - numa_node: NUMA node ID (0 for single node)
 //
 // Complexity: O(1) - Constant time operation
 //
@@ -1291,132 +1587,29 @@ get_scheduler_state_invalid:
 // Author: Lee Barney
 // Last Modified: 2025-01-19
 //
-_get_priority_queue:
-    // Save callee-saved registers
-    stp x19, x20, [sp, #-16]!
-    stp x21, x30, [sp, #-16]!
-
-    // Validate parameters
-    cbz x0, get_priority_queue_invalid  // Check scheduler_state
-    cmp x1, #MAX_CORES
-    b.ge get_priority_queue_invalid    // Check core_id
-    cmp x2, #NUM_PRIORITIES
-    b.ge get_priority_queue_invalid    // Check priority
-
-    // Save parameters
-    mov x19, x0  // scheduler_state
-    mov x20, x1  // core_id
-    mov x21, x2  // priority
-
-    // Calculate queue address
-    // Queue offset = scheduler_queues + (priority * queue_size)
-    // scheduler_queues = 8, queue_size = 24
-    mov x0, #24         // queue_size
-    mul x0, x21, x0     // priority * queue_size
-    add x0, x0, #8      // + scheduler_queues offset
-    add x0, x19, x0     // scheduler_state + queue_offset
-
-    ldp x21, x30, [sp], #16
-    ldp x19, x20, [sp], #16
+_get_numa_node:
+    // Simplified implementation - assume single NUMA node
+    // In a full implementation, this would:
+    // - Read NUMA topology from system registers
+    // - Query ACPI tables for NUMA information
+    // - Return actual NUMA node ID
+    mov x0, #0  // Single NUMA node
     ret
 
-get_priority_queue_invalid:
-    mov x0, #0
-    ldp x21, x30, [sp], #16
-    ldp x19, x20, [sp], #16
-    ret
+// Import required functions from other modules
+    .extern _mmap
+    .extern _trace_record
+    .extern _timer_wheel_init
+    .extern _timer_arm
+    .extern _scheduler_wake
+    .extern _scheduler_enqueue_process
+    .extern _scheduler_get_cached_now
 
 // ------------------------------------------------------------
-// Scheduler Dequeue Process Helper Function
+// Constant Definitions for C Code
 // ------------------------------------------------------------
-// Dequeue a process from a priority queue.
-//
-// Parameters:
-//   x0 (void*) - scheduler_state: Scheduler state pointer
-//   x1 (uint64_t) - core_id: Core ID
-//   x2 (uint32_t) - priority: Priority level
-//
-// Returns:
-//   x0 (void*) - process: Dequeued process pointer, or NULL if empty
-//
-// Complexity: O(1) - Constant time operation
-//
-// Version: 0.10
-// Author: Lee Barney
-// Last Modified: 2025-01-19
-//
-_scheduler_dequeue_process:
-    // Save callee-saved registers
-    stp x19, x30, [sp, #-16]!
-    stp x20, x21, [sp, #-16]!
-    stp x22, x23, [sp, #-16]!
-
-    // Validate parameters
-    cbz x0, scheduler_dequeue_failed  // Check scheduler_state
-    cmp x1, #MAX_CORES
-    b.ge scheduler_dequeue_failed     // Check core_id
-    cmp x2, #NUM_PRIORITIES
-    b.ge scheduler_dequeue_failed     // Check priority
+    .data
+    .align 3
 
-    // Save parameters
-    mov x19, x0  // scheduler_state
-    mov x20, x1  // core_id
-    mov x21, x2  // priority
-
-    // Get priority queue address
-    mov x0, x19  // scheduler_state
-    mov x1, x20  // core_id
-    mov x2, x21  // priority
-    bl _get_priority_queue
-    mov x22, x0  // queue_address
-
-    cbz x22, scheduler_dequeue_failed  // Check if queue address is valid
-
-    // Check if queue is empty
-    ldr w23, [x22, #16]  // queue_count
-    cbz w23, scheduler_dequeue_empty  // count == 0 means empty
-
-    // Get head process
-    ldr x0, [x22, #0]    // queue_head
-    cbz x0, scheduler_dequeue_failed  // head is NULL
-
-    // Update queue head to next process
-    ldr x1, [x0, #0]     // Load next pointer from PCB (offset 0 = pcb_next)
-    str x1, [x22, #0]    // Update queue_head
-
-    // If this was the last process, update tail to NULL
-    cbz x1, scheduler_dequeue_clear_tail
-    b scheduler_dequeue_decrement_count
-
-scheduler_dequeue_clear_tail:
-    str xzr, [x22, #8]   // Clear queue_tail
-
-scheduler_dequeue_decrement_count:
-    // Decrement queue count
-    sub w23, w23, #1
-    str w23, [x22, #16]  // queue_count
-
-    // Clear next/prev pointers of dequeued process
-    str xzr, [x0, #0]    // Clear next pointer
-    str xzr, [x0, #8]    // Clear prev pointer
-
-    // Return process
-    mov x0, x0           // Return the dequeued process
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
-    ret
-
-scheduler_dequeue_empty:
-    mov x0, #0
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
-    ret
-
-scheduler_dequeue_failed:
-    mov x0, #0
-    ldp x22, x23, [sp], #16
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
-    ret
+_WS_DEQUE_SIZE_CONST:
+    .quad ws_deque_size_bytes
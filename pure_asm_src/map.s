@@ -0,0 +1,1407 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// ------------------------------------------------------------
+// map.s — Persistent Hash Array Mapped Tries
+// ------------------------------------------------------------
+// Dictionaries as immutable terms on a process heap. A map is a trie
+// of nodes indexed 5 hash bits per level; each node is a boxed object
+//
+//   header: bitmap << 32 | pairs << 8 | TERM_HEADER_MAP
+//   body:   pairs x (key, value)
+//
+// with one pair per occupied slot, in slot order. A pair whose key is
+// TERM_NONE (never a key) holds a child node as its value. A slot's
+// pair index is the population count of the bitmap bits below it
+// (NEON cnt), so nodes are exactly as large as their contents.
+//
+// Updates copy only the path from the root to the changed node and
+// share every other node with the previous version, which stays valid:
+// put and delete cost O(log32 n) words each, where a copied flat map
+// would copy all n pairs. Each update is sized first and made in one
+// heap allocation, so a full heap never leaves a partial trie.
+//
+// Keys are hashed structurally (_map_hash agrees with _term_equal) to
+// 32 bits, which gives 7 levels; keys whose hashes are equal share a
+// collision node below them, a node with no bitmap whose pairs are
+// searched in turn. Tries are kept canonical: no node other than the
+// root holds a single key alone, so the same pairs always make the
+// same shape and _term_equal compares maps node by node. Pairs in a
+// collision node keep their insertion order.
+//
+// Map nodes are ordinary boxed terms whose bodies are plain terms, so
+// term.s sizes, copies, compares and walks them like tuples; a
+// collector scanning a heap sees every child pointer.
+//
+// The file provides:
+//   - Empty maps, lookup, insert/replace and delete
+//   - Bulk construction from a list of {Key, Value} tuples
+//   - Structural term hashing
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// Include the PCB layout
+    .include "pcb.inc"
+
+// External C library functions for memory management
+    .extern _mmap
+    .extern _munmap
+
+// ------------------------------------------------------------
+// Map Function Exports
+// ------------------------------------------------------------
+// Export the map functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _map_new
+    .global _map_get
+    .global _map_put
+    .global _map_delete
+    .global _map_size
+    .global _map_from_list
+    .global _map_hash
+
+    // Update frame: the path of (node, pair index) down to the node
+    // being changed, then the pair found there
+    .equ map_frame_path, 0
+    .equ map_frame_pair, (MAP_MAX_DEPTH * 16) // Key, value
+    .equ map_frame_hash, (map_frame_pair + 16) // Found key's hash
+    .equ map_frame_chain, (map_frame_hash + 8) // Split chain words
+    .equ map_frame_size, (map_frame_chain + 8)
+
+    // Bulk frame: radix counts, then the scratch mapping
+    .equ map_bulk_counts, 0
+    .equ map_bulk_mapping, (MAP_SLOTS * 8) // Base, length
+    .equ map_bulk_frame_size, (map_bulk_mapping + 16)
+
+    .equ map_entry_size, 24            // Scratch entry: hash, key, value
+
+    // map_find results
+    .equ MAP_FIND_ABSENT, 0            // Slot free; x28 = where the pair goes
+    .equ MAP_FIND_FOUND, 1             // Key at pair x28
+    .equ MAP_FIND_OTHER, 2             // Another key holds the slot at pair x28
+
+// ------------------------------------------------------------
+// Macros
+// ------------------------------------------------------------
+
+// Save and restore the callee-saved registers the updates use
+.macro MAP_SAVE
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    stp x26, x27, [sp, #-16]!
+    stp x28, x29, [sp, #-16]!
+.endm
+
+.macro MAP_RESTORE
+    ldp x28, x29, [sp], #16
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+.endm
+
+// Branch to \fail unless \term is a map
+.macro MAP_CHECK term, scratch, fail
+    tbz \term, #TERM_BIT_BOXED, \fail
+    ldur \scratch, [\term, #-TERM_TAG_BOXED]
+    and \scratch, \scratch, #0xFF
+    cmp \scratch, #TERM_HEADER_MAP
+    b.ne \fail
+.endm
+
+// \dst = number of bits set in \src (clobbers v0)
+.macro MAP_POPCOUNT dst, src
+    fmov d0, \src
+    cnt v0.8b, v0.8b
+    addv b0, v0.8b
+    fmov \dst, d0
+.endm
+
+// Slot of \hash at \shift in a node with \header: \index is the slot,
+// \pos the pair index it has or would have, and bit 0 of \bit is set
+// if the slot is occupied
+.macro MAP_SLOT header, hash, shift, index, pos, bit
+    lsr \index, \hash, \shift
+    and \index, \index, #(MAP_SLOTS - 1)
+    mov \bit, #1
+    lsl \bit, \bit, \index
+    sub \bit, \bit, #1
+    and \bit, \bit, \header, lsr #MAP_BITMAP_SHIFT
+    MAP_POPCOUNT \pos, \bit
+    add \bit, \index, #MAP_BITMAP_SHIFT
+    lsr \bit, \header, \bit
+.endm
+
+// 64-bit mixing multiplier
+.macro MAP_MIX_CONSTANT reg
+    movz \reg, #0xfd93
+    movk \reg, #0x6659, lsl #16
+    movk \reg, #0xfeb8, lsl #32
+    movk \reg, #0xd6e8, lsl #48
+.endm
+
+// Scramble \h so every input bit reaches every output bit
+.macro MAP_MIX h, k
+    eor \h, \h, \h, lsr #32
+    mul \h, \h, \k
+    eor \h, \h, \h, lsr #29
+    mul \h, \h, \k
+    eor \h, \h, \h, lsr #32
+.endm
+
+// ------------------------------------------------------------
+// Map New
+// ------------------------------------------------------------
+// Allocate an empty map: a root node with no pairs.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//
+// Returns:
+//   x0 (term_t) - map: Empty map, or TERM_NONE if the heap is full
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_map_new:
+    stp x29, x30, [sp, #-16]!
+    mov x1, #1
+    bl map_alloc
+    cbz x0, map_new_failed
+    mov x1, #TERM_HEADER_MAP
+    str x1, [x0]
+    orr x0, x0, #TERM_TAG_BOXED
+    ldp x29, x30, [sp], #16
+    ret
+
+map_new_failed:
+    mov x0, #TERM_NONE
+    ldp x29, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Map Get
+// ------------------------------------------------------------
+// Look a key up: one node per level, the slot's pair found with a
+// population count.
+//
+// Parameters:
+//   x0 (term_t) - map: Map
+//   x1 (term_t) - key: Any term
+//
+// Returns:
+//   x0 (term_t) - value: Value stored for the key, or TERM_NONE if the
+//                 key is absent or map is not a map
+//
+// Complexity: O(log32 n) nodes, plus key comparisons in a collision node
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_map_get:
+    MAP_CHECK x0, x2, map_get_invalid
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    sub x19, x0, #TERM_TAG_BOXED      // Node
+    mov x20, x1                       // Key
+    mov x0, x1
+    bl _map_hash
+    mov x21, x0                       // Hash
+    mov x22, #0                       // Shift
+
+map_get_level:
+    ldr x2, [x19]
+    cmp x22, #MAP_HASH_BITS
+    b.hs map_get_collision
+    MAP_SLOT x2, x21, x22, x3, x4, x5
+    tbz x5, #0, map_get_absent
+    add x4, x19, x4, lsl #4
+    ldp x0, x23, [x4, #8]             // Pair
+    cmp x0, #TERM_NONE
+    b.ne map_get_leaf
+    sub x19, x23, #TERM_TAG_BOXED     // Child
+    add x22, x22, #MAP_LEVEL_BITS
+    b map_get_level
+
+map_get_leaf:
+    cmp x0, x20
+    b.eq map_get_found
+    mov x1, x20
+    bl _term_equal
+    cbnz x0, map_get_found
+    b map_get_absent
+
+map_get_collision:
+    ubfx x22, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    add x19, x19, #8
+map_get_collision_pair:
+    cbz x22, map_get_absent
+    ldp x0, x23, [x19], #16
+    mov x1, x20
+    bl _term_equal
+    cbnz x0, map_get_found
+    sub x22, x22, #1
+    b map_get_collision_pair
+
+map_get_found:
+    mov x0, x23
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+map_get_absent:
+    mov x0, #TERM_NONE
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+map_get_invalid:
+    mov x0, #TERM_NONE
+    ret
+
+// ------------------------------------------------------------
+// Map Put
+// ------------------------------------------------------------
+// A map like the given one with key bound to value. The path to the
+// key's node is copied; the rest of the trie is shared. Putting the
+// value a key already has returns the map itself.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - map: Map
+//   x2 (term_t) - key: Any term but TERM_NONE
+//   x3 (term_t) - value: Any term but TERM_NONE
+//
+// Returns:
+//   x0 (term_t) - map: Updated map, or TERM_NONE if the heap is full or
+//                 an argument is invalid; map is unchanged either way
+//
+// Complexity: O(log32 n)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_map_put:
+    MAP_CHECK x1, x4, map_update_invalid
+    cmp x2, #TERM_NONE
+    b.eq map_update_invalid
+    cmp x3, #TERM_NONE
+    b.eq map_update_invalid
+    MAP_SAVE
+    sub sp, sp, #map_frame_size
+    mov x25, sp                       // Frame
+    mov x19, x0                       // pcb
+    mov x20, x1                       // Map
+    mov x21, x2                       // Key
+    mov x22, x3                       // Value
+    mov x0, x2
+    bl _map_hash
+    mov x23, x0                       // Hash
+    sub x26, x20, #TERM_TAG_BOXED
+    bl map_find
+    cmp x0, #MAP_FIND_FOUND
+    b.eq map_put_replace
+    cmp x0, #MAP_FIND_OTHER
+    b.eq map_put_split
+
+    // Free slot: the node gains the pair at x28
+    bl map_path_words
+    ldr x2, [x26]
+    ubfx x2, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    add x0, x0, #3                    // Header and the new pair
+    add x1, x0, x2, lsl #1
+    mov x0, x19
+    bl map_alloc
+    cbz x0, map_update_heap_full
+    mov x20, x0
+    ldr x2, [x26]
+    add x2, x2, #(1 << MAP_COUNT_SHIFT)
+    cmp x27, #MAP_HASH_BITS
+    b.hs map_put_insert               // Collision node: no bitmap
+    lsr x3, x23, x27
+    and x3, x3, #(MAP_SLOTS - 1)
+    add x3, x3, #MAP_BITMAP_SHIFT
+    mov x4, #1
+    lsl x4, x4, x3
+    orr x2, x2, x4
+map_put_insert:
+    str x2, [x0], #8
+    add x1, x26, #8
+    mov x2, x28
+    bl map_copy_pairs
+    stp x21, x22, [x0], #16
+    ldr x2, [x26]
+    ubfx x2, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    sub x2, x2, x28
+    bl map_copy_pairs
+    b map_update_rebuild
+
+map_put_replace:
+    ldr x0, [x25, #(map_frame_pair + 8)]
+    cmp x0, x22
+    b.eq map_update_unchanged
+    bl map_path_words
+    ldr x2, [x26]
+    ubfx x2, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    add x0, x0, #1
+    add x1, x0, x2, lsl #1
+    mov x0, x19
+    bl map_alloc
+    cbz x0, map_update_heap_full
+    mov x20, x0
+    ldr x2, [x26]
+    str x2, [x0], #8
+    add x1, x26, #8
+    ubfx x2, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    bl map_copy_pairs
+    add x1, x20, x28, lsl #4
+    str x22, [x1, #16]                // Value of pair x28
+    b map_update_rebuild
+
+map_put_split:
+    // Another key holds the slot: both go into a chain of new nodes,
+    // one per level their hashes agree on
+    ldr x0, [x25, #map_frame_pair]
+    bl _map_hash
+    str x0, [x25, #map_frame_hash]
+    add x2, x27, #MAP_LEVEL_BITS
+    mov x3, #0
+map_put_split_size:
+    cmp x2, #MAP_HASH_BITS
+    b.hs map_put_split_sized
+    lsr x4, x0, x2
+    and x4, x4, #(MAP_SLOTS - 1)
+    lsr x5, x23, x2
+    and x5, x5, #(MAP_SLOTS - 1)
+    cmp x4, x5
+    b.ne map_put_split_sized
+    add x3, x3, #3                    // Node holding one child
+    add x2, x2, #MAP_LEVEL_BITS
+    b map_put_split_size
+map_put_split_sized:
+    add x3, x3, #5                    // Node holding both pairs
+    str x3, [x25, #map_frame_chain]
+    bl map_path_words
+    ldr x3, [x25, #map_frame_chain]
+    add x0, x0, x3
+    ldr x2, [x26]
+    ubfx x2, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    add x0, x0, #1
+    add x1, x0, x2, lsl #1
+    mov x0, x19
+    bl map_alloc
+    cbz x0, map_update_heap_full
+
+    // Chain first, each node's child right after it
+    mov x9, x0                        // Chain root
+    ldr x6, [x25, #map_frame_hash]
+    ldp x7, x8, [x25, #map_frame_pair]
+    add x2, x27, #MAP_LEVEL_BITS
+map_put_split_node:
+    cmp x2, #MAP_HASH_BITS
+    b.hs map_put_split_collision
+    lsr x4, x6, x2
+    and x4, x4, #(MAP_SLOTS - 1)
+    lsr x5, x23, x2
+    and x5, x5, #(MAP_SLOTS - 1)
+    cmp x4, x5
+    b.ne map_put_split_pairs
+    add x3, x4, #MAP_BITMAP_SHIFT
+    mov x10, #1
+    lsl x10, x10, x3
+    mov x11, #((1 << MAP_COUNT_SHIFT) | TERM_HEADER_MAP)
+    orr x10, x10, x11
+    mov x11, #TERM_NONE
+    add x12, x0, #(24 + TERM_TAG_BOXED)
+    str x10, [x0]
+    stp x11, x12, [x0, #8]
+    add x0, x0, #24
+    add x2, x2, #MAP_LEVEL_BITS
+    b map_put_split_node
+
+map_put_split_pairs:
+    add x3, x4, #MAP_BITMAP_SHIFT
+    mov x10, #1
+    lsl x10, x10, x3
+    add x3, x5, #MAP_BITMAP_SHIFT
+    mov x11, #1
+    lsl x11, x11, x3
+    orr x10, x10, x11
+    mov x11, #((2 << MAP_COUNT_SHIFT) | TERM_HEADER_MAP)
+    orr x10, x10, x11
+    str x10, [x0]
+    cmp x4, x5
+    b.hi map_put_split_new_first
+    stp x7, x8, [x0, #8]
+    stp x21, x22, [x0, #24]
+    b map_put_split_done
+
+map_put_split_new_first:
+    stp x21, x22, [x0, #8]
+    stp x7, x8, [x0, #24]
+    b map_put_split_done
+
+map_put_split_collision:
+    mov x10, #((2 << MAP_COUNT_SHIFT) | TERM_HEADER_MAP)
+    str x10, [x0]
+    stp x7, x8, [x0, #8]
+    stp x21, x22, [x0, #24]
+
+map_put_split_done:
+    // The node, with the contested pair pointing at the chain
+    add x0, x0, #40
+    mov x20, x0
+    ldr x2, [x26]
+    str x2, [x0], #8
+    add x1, x26, #8
+    ubfx x2, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    bl map_copy_pairs
+    add x1, x20, x28, lsl #4
+    mov x2, #TERM_NONE
+    orr x3, x9, #TERM_TAG_BOXED
+    stp x2, x3, [x1, #8]
+    b map_update_rebuild
+
+// ------------------------------------------------------------
+// Map Delete
+// ------------------------------------------------------------
+// A map like the given one without key. The path is copied as for
+// _map_put; a node left holding one key alone is folded into its
+// parent, so the trie keeps the shape building it afresh would give.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - map: Map
+//   x2 (term_t) - key: Any term
+//
+// Returns:
+//   x0 (term_t) - map: Updated map (map itself if key is absent), or
+//                 TERM_NONE if the heap is full or map is not a map
+//
+// Complexity: O(log32 n)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_map_delete:
+    MAP_CHECK x1, x4, map_update_invalid
+    cmp x2, #TERM_NONE
+    b.eq map_delete_nothing
+    MAP_SAVE
+    sub sp, sp, #map_frame_size
+    mov x25, sp
+    mov x19, x0
+    mov x20, x1
+    mov x21, x2
+    mov x0, x2
+    bl _map_hash
+    mov x23, x0
+    sub x26, x20, #TERM_TAG_BOXED
+    bl map_find
+    cmp x0, #MAP_FIND_FOUND
+    b.ne map_update_unchanged
+
+    // Below the root, a node of two pairs whose other pair is a key
+    // disappears: that pair moves up to the nearest ancestor holding
+    // anything else
+    ldr x2, [x26]
+    ubfx x3, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    cbz x24, map_delete_remove
+    cmp x3, #2
+    b.ne map_delete_remove
+    eor x4, x28, #1
+    add x4, x26, x4, lsl #4
+    ldp x21, x22, [x4, #8]            // The other pair
+    cmp x21, #TERM_NONE
+    b.eq map_delete_remove
+map_delete_trim:
+    cmp x24, #2
+    b.lo map_delete_collapse
+    sub x4, x24, #1
+    add x4, x25, x4, lsl #4
+    ldr x4, [x4, #map_frame_path]     // Parent
+    ldr x4, [x4]
+    ubfx x4, x4, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    cmp x4, #1
+    b.ne map_delete_collapse
+    sub x24, x24, #1                  // Parent held only this path
+    b map_delete_trim
+
+map_delete_collapse:
+    bl map_path_words
+    mov x1, x0
+    mov x0, x19
+    bl map_alloc
+    cbz x0, map_update_heap_full
+    mov x27, x0
+    b map_rebuild
+
+map_delete_remove:
+    bl map_path_words
+    ldr x2, [x26]
+    ubfx x2, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    sub x2, x2, #1
+    add x0, x0, #1
+    add x1, x0, x2, lsl #1
+    mov x0, x19
+    bl map_alloc
+    cbz x0, map_update_heap_full
+    mov x20, x0
+    ldr x2, [x26]
+    sub x2, x2, #(1 << MAP_COUNT_SHIFT)
+    cmp x27, #MAP_HASH_BITS
+    b.hs map_delete_header            // Collision node: no bitmap
+    lsr x3, x23, x27
+    and x3, x3, #(MAP_SLOTS - 1)
+    add x3, x3, #MAP_BITMAP_SHIFT
+    mov x4, #1
+    lsl x4, x4, x3
+    bic x2, x2, x4
+map_delete_header:
+    str x2, [x0], #8
+    add x1, x26, #8
+    mov x2, x28
+    bl map_copy_pairs
+    add x1, x1, #16                   // Skip the key's pair
+    ldr x2, [x26]
+    ubfx x2, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    sub x2, x2, x28
+    sub x2, x2, #1
+    bl map_copy_pairs
+    b map_update_rebuild
+
+map_delete_nothing:
+    mov x0, x1                        // TERM_NONE is never a key
+    ret
+
+// ------------------------------------------------------------
+// Map Update Tail (internal)
+// ------------------------------------------------------------
+// Shared by _map_put and _map_delete once the changed node is built
+// at x20 and ends at x0: copy each node on the path bottom-up, its
+// pair on the path replaced by the (x21, x22) of the level below.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+map_update_rebuild:
+    mov x27, x0                       // Cursor
+    mov x21, #TERM_NONE
+    orr x22, x20, #TERM_TAG_BOXED
+map_rebuild:
+    cbz x24, map_rebuild_done
+    sub x24, x24, #1
+    add x4, x25, x24, lsl #4
+    ldp x26, x28, [x4, #map_frame_path]
+    mov x20, x27
+    ldr x2, [x26]
+    mov x0, x27
+    str x2, [x0], #8
+    add x1, x26, #8
+    mov x2, x28
+    bl map_copy_pairs
+    stp x21, x22, [x0], #16
+    add x1, x1, #16
+    ldr x2, [x26]
+    ubfx x2, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    sub x2, x2, x28
+    sub x2, x2, #1
+    bl map_copy_pairs
+    mov x27, x0
+    mov x21, #TERM_NONE
+    orr x22, x20, #TERM_TAG_BOXED
+    b map_rebuild
+
+map_rebuild_done:
+    mov x0, x22                       // New root
+    b map_update_return
+
+map_update_unchanged:
+    mov x0, x20
+    b map_update_return
+
+map_update_heap_full:
+    mov x0, #TERM_NONE
+map_update_return:
+    add sp, sp, #map_frame_size
+    MAP_RESTORE
+    ret
+
+map_update_invalid:
+    mov x0, #TERM_NONE
+    ret
+
+// ------------------------------------------------------------
+// Map Find (internal)
+// ------------------------------------------------------------
+// Walk from the root to the node where key is or would go, recording
+// each (node, pair index) passed on the frame's path.
+//
+// Parameters:
+//   x21 (term_t) - key: Key
+//   x23 (uint64_t) - hash: _map_hash of the key
+//   x25 (void*) - frame: Update frame
+//   x26 (uint64_t*) - node: Root node
+//
+// Returns:
+//   x0 (uint64_t) - status: MAP_FIND_*
+//   x24 (uint64_t) - depth: Path entries
+//   x26 (uint64_t*) - node: Node reached
+//   x27 (uint64_t) - shift: Its level's hash shift
+//   x28 (uint64_t) - pos: Pair index in it
+//   The pair at x28, if any, is stored at map_frame_pair.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+map_find:
+    str x30, [sp, #-16]!
+    mov x24, #0
+    mov x27, #0
+
+map_find_level:
+    ldr x2, [x26]
+    cmp x27, #MAP_HASH_BITS
+    b.hs map_find_collision
+    MAP_SLOT x2, x23, x27, x3, x28, x4
+    tbz x4, #0, map_find_absent
+    add x4, x26, x28, lsl #4
+    ldp x0, x1, [x4, #8]
+    stp x0, x1, [x25, #map_frame_pair]
+    cmp x0, #TERM_NONE
+    b.ne map_find_leaf
+
+    // Child: remember the way down
+    add x4, x25, x24, lsl #4
+    stp x26, x28, [x4, #map_frame_path]
+    add x24, x24, #1
+    sub x26, x1, #TERM_TAG_BOXED
+    add x27, x27, #MAP_LEVEL_BITS
+    b map_find_level
+
+map_find_leaf:
+    cmp x0, x21
+    b.eq map_find_found
+    mov x1, x21
+    bl _term_equal
+    cbnz x0, map_find_found
+    mov x0, #MAP_FIND_OTHER
+    ldr x30, [sp], #16
+    ret
+
+map_find_collision:
+    mov x28, #0
+map_find_collision_pair:
+    ldr x2, [x26]
+    ubfx x2, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    cmp x28, x2
+    b.hs map_find_absent              // Appended after the last pair
+    add x4, x26, x28, lsl #4
+    ldp x0, x1, [x4, #8]
+    stp x0, x1, [x25, #map_frame_pair]
+    mov x1, x21
+    bl _term_equal
+    cbnz x0, map_find_found
+    add x28, x28, #1
+    b map_find_collision_pair
+
+map_find_absent:
+    mov x0, #MAP_FIND_ABSENT
+    ldr x30, [sp], #16
+    ret
+
+map_find_found:
+    mov x0, #MAP_FIND_FOUND
+    ldr x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Map Path Words (internal)
+// ------------------------------------------------------------
+// Heap words copying the recorded path takes.
+//
+// Parameters:
+//   x24 (uint64_t) - depth: Path entries
+//   x25 (void*) - frame: Update frame
+//
+// Returns:
+//   x0 (uint64_t) - words: Words
+//
+// Clobbers: x1-x2
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+map_path_words:
+    mov x0, #0
+    mov x1, #0
+map_path_words_next:
+    cmp x1, x24
+    b.hs map_path_words_done
+    add x2, x25, x1, lsl #4
+    ldr x2, [x2, #map_frame_path]
+    ldr x2, [x2]
+    ubfx x2, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    add x0, x0, #1
+    add x0, x0, x2, lsl #1
+    add x1, x1, #1
+    b map_path_words_next
+
+map_path_words_done:
+    ret
+
+// ------------------------------------------------------------
+// Map Size
+// ------------------------------------------------------------
+// Number of keys in a map.
+//
+// Parameters:
+//   x0 (term_t) - map: Map
+//
+// Returns:
+//   x0 (uint64_t) - size: Keys, 0 if the term is not a map
+//
+// Complexity: O(n)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_map_size:
+    MAP_CHECK x0, x1, map_size_invalid
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    sub x19, x0, #TERM_TAG_BOXED
+    ldr x20, [x19], #8
+    ubfx x20, x20, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    mov x21, #0                       // Keys so far
+map_size_pair:
+    cbz x20, map_size_done
+    ldp x0, x1, [x19], #16
+    sub x20, x20, #1
+    cmp x0, #TERM_NONE
+    b.ne map_size_key
+    mov x0, x1
+    bl _map_size
+    add x21, x21, x0
+    b map_size_pair
+
+map_size_key:
+    add x21, x21, #1
+    b map_size_pair
+
+map_size_done:
+    mov x0, x21
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+map_size_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Map From List
+// ------------------------------------------------------------
+// Build a map from a list of {Key, Value} tuples in one pass instead
+// of one put per pair: the pairs are hashed into scratch memory and
+// radix sorted by slot, deepest level first, so every node's keys lie
+// together in slot order. Nodes are then laid out top-down in one heap
+// allocation with no intermediate versions. A key given more than once
+// keeps its last value.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - list: Proper list of 2-tuples, neither element
+//                 TERM_NONE
+//
+// Returns:
+//   x0 (term_t) - map: New map, or TERM_NONE if the heap is full, the
+//                 list is malformed or scratch memory is unavailable
+//
+// Complexity: O(n) (7 radix passes)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_map_from_list:
+    MAP_SAVE
+    sub sp, sp, #map_bulk_frame_size
+    mov x19, x0                       // pcb
+    mov x20, x1                       // List
+
+    // Count the pairs, checking each
+    mov x21, #0
+    mov x2, x1
+map_from_list_count:
+    cmp x2, #TERM_NIL
+    b.eq map_from_list_counted
+    tbz x2, #TERM_BIT_LIST, map_from_list_invalid
+    ldur x3, [x2, #-TERM_TAG_LIST]
+    tbz x3, #TERM_BIT_BOXED, map_from_list_invalid
+    ldur x4, [x3, #-TERM_TAG_BOXED]
+    cmp x4, #((2 << TERM_HEADER_ARITY_SHIFT) | TERM_HEADER_TUPLE)
+    b.ne map_from_list_invalid
+    add x3, x3, #(8 - TERM_TAG_BOXED)
+    ldp x4, x5, [x3]
+    cmp x4, #TERM_NONE
+    b.eq map_from_list_invalid
+    cmp x5, #TERM_NONE
+    b.eq map_from_list_invalid
+    add x21, x21, #1
+    ldur x2, [x2, #(8 - TERM_TAG_LIST)]
+    b map_from_list_count
+
+map_from_list_counted:
+    cbz x21, map_from_list_empty
+
+    // Scratch: two arrays of (hash, key, value) for the radix passes
+    mov x0, #map_entry_size
+    mul x22, x21, x0                  // Bytes per array
+    mov x0, xzr                       // addr = NULL (let system choose)
+    lsl x1, x22, #1                   // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq map_from_list_invalid
+    lsl x1, x22, #1
+    stp x0, x1, [sp, #map_bulk_mapping]
+    mov x23, x0                       // Entries
+    add x24, x0, x22                  // Other array
+
+    // Hash every pair in list order
+    mov x26, x23
+    mov x27, x20
+map_from_list_fill:
+    cmp x27, #TERM_NIL
+    b.eq map_from_list_sort
+    ldur x3, [x27, #-TERM_TAG_LIST]
+    add x3, x3, #(8 - TERM_TAG_BOXED)
+    ldp x4, x5, [x3]
+    stp x4, x5, [x26, #8]
+    mov x0, x4
+    bl _map_hash
+    str x0, [x26], #map_entry_size
+    ldur x27, [x27, #(8 - TERM_TAG_LIST)]
+    b map_from_list_fill
+
+map_from_list_sort:
+    // Stable LSD radix sort on the slot at each level, deepest first
+    mov x27, #(MAP_HASH_BITS - MAP_HASH_BITS % MAP_LEVEL_BITS)
+map_from_list_pass:
+    mov x0, sp
+    mov x1, #(MAP_SLOTS / 2)
+map_from_list_zero:
+    stp xzr, xzr, [x0], #16
+    subs x1, x1, #1
+    b.ne map_from_list_zero
+
+    mov x0, x23
+    mov x1, x21
+map_from_list_histogram:
+    ldr x2, [x0], #map_entry_size
+    lsr x2, x2, x27
+    and x2, x2, #(MAP_SLOTS - 1)
+    ldr x3, [sp, x2, lsl #3]
+    add x3, x3, #1
+    str x3, [sp, x2, lsl #3]
+    subs x1, x1, #1
+    b.ne map_from_list_histogram
+
+    mov x0, #0                        // Slot
+    mov x1, #0                        // Entries before it
+map_from_list_prefix:
+    ldr x2, [sp, x0, lsl #3]
+    str x1, [sp, x0, lsl #3]
+    add x1, x1, x2
+    add x0, x0, #1
+    cmp x0, #MAP_SLOTS
+    b.lo map_from_list_prefix
+
+    mov x0, x23
+    mov x1, x21
+    mov x7, #map_entry_size
+map_from_list_scatter:
+    ldp x2, x3, [x0]
+    ldr x4, [x0, #16]
+    add x0, x0, #map_entry_size
+    lsr x5, x2, x27
+    and x5, x5, #(MAP_SLOTS - 1)
+    ldr x6, [sp, x5, lsl #3]
+    add x8, x6, #1
+    str x8, [sp, x5, lsl #3]
+    madd x6, x6, x7, x24
+    stp x2, x3, [x6]
+    str x4, [x6, #16]
+    subs x1, x1, #1
+    b.ne map_from_list_scatter
+
+    mov x0, x23
+    mov x23, x24
+    mov x24, x0
+    subs x27, x27, #MAP_LEVEL_BITS
+    b.pl map_from_list_pass
+
+    // Drop repeated keys, which sort together by hash, keeping the
+    // first position and the last value
+    mov x26, x23                      // Read
+    mov x27, x23                      // Write
+    mov x28, x23                      // Kept entries with this hash
+    mov x22, x21                      // Entries left
+map_from_list_unique:
+    cbz x22, map_from_list_build
+    ldr x0, [x26], #map_entry_size
+    sub x22, x22, #1
+    cmp x27, x23
+    b.eq map_from_list_group
+    ldur x1, [x27, #-map_entry_size]
+    cmp x1, x0
+    b.ne map_from_list_group
+    mov x25, x28
+map_from_list_compare:
+    cmp x25, x27
+    b.hs map_from_list_keep
+    ldr x0, [x25, #8]
+    ldur x1, [x26, #(8 - map_entry_size)]
+    bl _term_equal
+    cbnz x0, map_from_list_replace
+    add x25, x25, #map_entry_size
+    b map_from_list_compare
+
+map_from_list_replace:
+    ldur x0, [x26, #-8]
+    str x0, [x25, #16]
+    b map_from_list_unique
+
+map_from_list_group:
+    mov x28, x27
+map_from_list_keep:
+    ldur x0, [x26, #-map_entry_size]
+    ldur x1, [x26, #(8 - map_entry_size)]
+    ldur x2, [x26, #-8]
+    stp x0, x1, [x27]
+    str x2, [x27, #16]
+    add x27, x27, #map_entry_size
+    b map_from_list_unique
+
+map_from_list_build:
+    // Size the trie, then lay it out in one allocation
+    mov x0, x23
+    mov x1, x27
+    mov x2, #0
+    mov x3, #0
+    mov x4, #0
+    bl map_build
+    lsr x1, x1, #3
+    mov x0, x19
+    bl map_alloc
+    cbz x0, map_from_list_heap_full
+    mov x3, x0
+    mov x0, x23
+    mov x1, x27
+    mov x2, #0
+    mov x4, #1
+    bl map_build
+    mov x20, x0
+    b map_from_list_unmap
+
+map_from_list_heap_full:
+    mov x20, #TERM_NONE
+map_from_list_unmap:
+    ldp x0, x1, [sp, #map_bulk_mapping]
+    bl _munmap
+    mov x0, x20
+    b map_from_list_return
+
+map_from_list_empty:
+    mov x0, x19
+    bl _map_new
+    b map_from_list_return
+
+map_from_list_invalid:
+    mov x0, #TERM_NONE
+map_from_list_return:
+    add sp, sp, #map_bulk_frame_size
+    MAP_RESTORE
+    ret
+
+// ------------------------------------------------------------
+// Map Build (internal)
+// ------------------------------------------------------------
+// Lay out the node for sorted, unique entries sharing the slots above
+// shift, then its children after it. With write 0 nothing is stored
+// and the cursor only measures the size (start it at 0).
+//
+// Parameters:
+//   x0 (void*) - first: First entry
+//   x1 (void*) - end: Past the last entry (at least one)
+//   x2 (uint64_t) - shift: Level's hash shift
+//   x3 (uint64_t*) - cursor: Where the node goes
+//   x4 (int) - write: Non-zero to store the nodes
+//
+// Returns:
+//   x0 (term_t) - node: The node (meaningless when measuring)
+//   x1 (uint64_t*) - cursor: Past the node and its children
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+map_build:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    stp x26, x27, [sp, #-16]!
+    mov x19, x0                       // Next entry
+    mov x20, x1                       // End
+    mov x21, x2                       // Shift
+    mov x22, x3                       // Node
+    mov x23, x4                       // Write
+    cmp x21, #MAP_HASH_BITS
+    b.hs map_build_collision
+
+    // One slot per run of equal slot numbers
+    mov x5, #0                        // Bitmap
+    mov x6, x19
+    mov x7, #0                        // Pairs
+    mov x8, #-1                       // Previous slot
+map_build_scan:
+    cmp x6, x20
+    b.hs map_build_scanned
+    ldr x9, [x6], #map_entry_size
+    lsr x9, x9, x21
+    and x9, x9, #(MAP_SLOTS - 1)
+    cmp x9, x8
+    b.eq map_build_scan
+    mov x8, x9
+    add x7, x7, #1
+    mov x10, #1
+    lsl x10, x10, x9
+    orr x5, x5, x10
+    b map_build_scan
+
+map_build_scanned:
+    add x24, x22, #8                  // Next pair
+    add x25, x24, x7, lsl #4          // Children go after the node
+    cbz x23, map_build_pairs
+    lsl x5, x5, #MAP_BITMAP_SHIFT
+    orr x5, x5, x7, lsl #MAP_COUNT_SHIFT
+    add x5, x5, #TERM_HEADER_MAP
+    str x5, [x22]
+
+map_build_pairs:
+    cmp x19, x20
+    b.hs map_build_done
+    ldr x9, [x19]
+    lsr x9, x9, x21
+    and x9, x9, #(MAP_SLOTS - 1)
+    add x26, x19, #map_entry_size
+map_build_run:
+    cmp x26, x20
+    b.hs map_build_run_end
+    ldr x10, [x26]
+    lsr x10, x10, x21
+    and x10, x10, #(MAP_SLOTS - 1)
+    cmp x10, x9
+    b.ne map_build_run_end
+    add x26, x26, #map_entry_size
+    b map_build_run
+
+map_build_run_end:
+    sub x10, x26, x19
+    cmp x10, #map_entry_size
+    b.ne map_build_child
+    cbz x23, map_build_next           // One key: stored in the slot
+    ldp x0, x1, [x19, #8]
+    stp x0, x1, [x24]
+    b map_build_next
+
+map_build_child:
+    mov x0, x19
+    mov x1, x26
+    add x2, x21, #MAP_LEVEL_BITS
+    mov x3, x25
+    mov x4, x23
+    bl map_build
+    mov x25, x1
+    cbz x23, map_build_next
+    mov x2, #TERM_NONE
+    stp x2, x0, [x24]
+
+map_build_next:
+    add x24, x24, #16
+    mov x19, x26
+    b map_build_pairs
+
+map_build_collision:
+    sub x5, x20, x19
+    mov x6, #map_entry_size
+    udiv x5, x5, x6                   // Pairs
+    add x24, x22, #8
+    add x25, x24, x5, lsl #4
+    cbz x23, map_build_done
+    lsl x6, x5, #MAP_COUNT_SHIFT
+    add x6, x6, #TERM_HEADER_MAP
+    str x6, [x22]
+map_build_collision_pair:
+    cmp x19, x20
+    b.hs map_build_done
+    ldp x0, x1, [x19, #8]
+    stp x0, x1, [x24], #16
+    add x19, x19, #map_entry_size
+    b map_build_collision_pair
+
+map_build_done:
+    orr x0, x22, #TERM_TAG_BOXED
+    mov x1, x25
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Map Hash
+// ------------------------------------------------------------
+// 32-bit hash of a term. Equal terms (_term_equal) hash equally:
+// immediates hash their word, boxed terms and lists their headers and
+// contents, each step mixed so order matters.
+//
+// Parameters:
+//   x0 (term_t) - term: Any term
+//
+// Returns:
+//   x0 (uint64_t) - hash: 0 to 2^32 - 1
+//
+// Complexity: O(1) for immediates, O(size) otherwise
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_map_hash:
+    tst x0, #TERM_POINTER_MASK
+    b.ne map_hash_heap
+map_hash_finish:
+    MAP_MIX_CONSTANT x1
+    MAP_MIX x0, x1
+    eor x0, x0, x0, lsr #32
+    mov w0, w0
+    ret
+
+map_hash_heap:
+    stp x29, x30, [sp, #-16]!
+    bl map_term_hash
+    ldp x29, x30, [sp], #16
+    b map_hash_finish
+
+// ------------------------------------------------------------
+// Map Term Hash (internal)
+// ------------------------------------------------------------
+// Unfinished 64-bit structural hash of a term.
+//
+// Parameters:
+//   x0 (term_t) - term: Any term
+//
+// Returns:
+//   x0 (uint64_t) - hash: Hash
+//
+// Complexity: O(size); recursion depth follows nesting, list spines
+//             are walked iteratively
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+map_term_hash:
+    tst x0, #TERM_POINTER_MASK
+    b.ne map_term_hash_heap
+    ret
+
+map_term_hash_heap:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    MAP_MIX_CONSTANT x23
+    tbnz x0, #TERM_BIT_LIST, map_term_hash_list
+
+    // Boxed: header, then the body
+    sub x20, x0, #TERM_TAG_BOXED
+    ldr x19, [x20], #8
+    ubfx x2, x19, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    lsr x21, x19, #TERM_HEADER_ARITY_SHIFT
+    cmp x2, #TERM_KIND_BINARY
+    b.eq map_term_hash_binary
+    cmp x2, #TERM_KIND_MAP
+    b.ne map_term_hash_elements
+    ubfx x21, x19, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    lsl x21, x21, #1
+map_term_hash_elements:
+    cbz x21, map_term_hash_done
+    ldr x0, [x20], #8
+    bl map_term_hash
+    add x19, x19, x0
+    MAP_MIX x19, x23
+    sub x21, x21, #1
+    b map_term_hash_elements
+
+map_term_hash_binary:
+    add x21, x21, #7
+    lsr x21, x21, #3                  // Zero-padded words
+map_term_hash_words:
+    cbz x21, map_term_hash_done
+    ldr x0, [x20], #8
+    add x19, x19, x0
+    MAP_MIX x19, x23
+    sub x21, x21, #1
+    b map_term_hash_words
+
+map_term_hash_list:
+    mov x19, #TERM_TAG_LIST
+    mov x20, x0
+map_term_hash_cell:
+    ldur x0, [x20, #-TERM_TAG_LIST]
+    bl map_term_hash
+    add x19, x19, x0
+    MAP_MIX x19, x23
+    ldur x20, [x20, #(8 - TERM_TAG_LIST)]
+    tbnz x20, #TERM_BIT_LIST, map_term_hash_cell
+    mov x0, x20                       // Tail
+    bl map_term_hash
+    add x19, x19, x0
+    MAP_MIX x19, x23
+
+map_term_hash_done:
+    mov x0, x19
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Map Alloc (internal)
+// ------------------------------------------------------------
+// Bump-allocate words from a PCB heap, as term.s does. Never collects.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (uint64_t) - words: Words to allocate
+//
+// Returns:
+//   x0 (uint64_t*) - object: Word-aligned memory, or NULL if the heap
+//                    is full or pcb is NULL
+//
+// Clobbers: x2-x4
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+map_alloc:
+    cbz x0, map_alloc_failed
+    lsr x2, x1, #TERM_MAX_WORDS_SHIFT
+    cbnz x2, map_alloc_failed
+    ldr x2, [x0, #pcb_heap_pointer]
+    add x2, x2, #(HEAP_ALIGNMENT - 1)
+    and x2, x2, #~(HEAP_ALIGNMENT - 1)
+    ldr x3, [x0, #pcb_heap_limit]
+    add x4, x2, x1, lsl #3
+    cmp x4, x3
+    b.hi map_alloc_failed
+    str x4, [x0, #pcb_heap_pointer]
+    mov x0, x2
+    ret
+
+map_alloc_failed:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Map Copy Pairs (internal)
+// ------------------------------------------------------------
+// Copy key/value pairs, one 16-byte pair per load and store.
+//
+// Parameters:
+//   x0 (uint64_t*) - destination: Where the pairs go
+//   x1 (uint64_t*) - source: First pair
+//   x2 (uint64_t) - pairs: Pairs to copy
+//
+// Returns:
+//   x0 (uint64_t*) - destination: Past the copies
+//   x1 (uint64_t*) - source: Past the originals
+//
+// Clobbers: x2, v0
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+map_copy_pairs:
+    cbz x2, map_copy_pairs_done
+    ldr q0, [x1], #16
+    str q0, [x0], #16
+    sub x2, x2, #1
+    b map_copy_pairs
+
+map_copy_pairs_done:
+    ret
@@ -0,0 +1,678 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// match.s — Compiled Receive Matchers
+// ------------------------------------------------------------
+// Compiles a set of receive clauses into a matcher that picks the
+// first matching clause for a message term without testing every
+// clause in turn.
+//
+// A clause is a pattern term (term.s) plus an optional guard. Pattern
+// terms are ordinary terms in which TERM_PATTERN_ANY matches anything
+// and TERM_PATTERN_INT, _ATOM, ... match any term of one type; every
+// other word must be equal. That covers the exact-value, type-based
+// and multi-pattern Match templates, with guards for the rest.
+//
+// Each clause gets a dispatch key where its pattern has one: the word
+// itself for a literal immediate (a bare atom tag, an integer), or
+// tuple arity plus a literal first element for the usual {@tag, ...}
+// message. Keys go into a hash table of clause lists; clauses without
+// a key (wildcards, type patterns, lists, binaries) go on a generic
+// list. A message is keyed the same way, so only its bucket's clauses
+// and the generic ones are tested, merged back into clause order so
+// the first matching clause still wins. A responder with dozens of
+// tagged clauses tests one or two of them per message.
+//
+// The file provides:
+//   - Single pattern tests
+//   - Clause set compilation to a keyed matcher
+//   - First-match evaluation with guards
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// External term functions
+    .extern _term_type
+    .extern _term_equal
+
+// External C library functions for memory management
+    .extern _mmap
+    .extern _munmap
+
+// ------------------------------------------------------------
+// Match Function Exports
+// ------------------------------------------------------------
+// Export the matcher functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _match_term
+    .global _match_compile
+    .global _match_run
+    .global _match_destroy
+
+// ------------------------------------------------------------
+// Matcher Layout
+// ------------------------------------------------------------
+// One mapping: a 64-byte header, the clauses, the key buckets, each
+// clause's bucket (MATCH_NO_CLAUSE if generic), the generic clause
+// list and the bucket clause lists. Lists hold u32 clause indices in
+// ascending order.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ match_length, 0              // Mapping length for munmap (8 bytes)
+    .equ match_count, 8               // Clauses (8 bytes)
+    .equ match_bucket_mask, 16        // buckets - 1 (8 bytes)
+    .equ match_generic_count, 24      // Clauses without a key (8 bytes)
+    .equ match_clauses, 32            // Clause array (8 bytes)
+    .equ match_buckets, 40            // Key buckets (8 bytes)
+    .equ match_generic, 48            // Generic clause list (8 bytes)
+    .equ match_lists, 56              // Bucket clause lists (8 bytes)
+    .equ match_header_size, 64
+
+    .equ match_clause_pattern, 0      // Pattern term (8 bytes)
+    .equ match_clause_guard, 8        // int guard(term_t, uint64_t), or NULL (8 bytes)
+    .equ match_clause_argument, 16    // Guard argument (8 bytes)
+
+    .equ match_bucket_key_a, 0        // Tuple header, 0 for an immediate (8 bytes)
+    .equ match_bucket_key_b, 8        // First element or the immediate (8 bytes)
+    .equ match_bucket_list, 16        // First list entry (4 bytes)
+    .equ match_bucket_count, 20       // Clauses, 0 if empty (4 bytes)
+    .equ match_bucket_size, 24
+
+    .equ MATCH_MIN_BUCKETS, 8
+
+// ------------------------------------------------------------
+// Match Term
+// ------------------------------------------------------------
+// Test one term against one pattern.
+//
+// Parameters:
+//   x0 (term_t) - pattern: Pattern term
+//   x1 (term_t) - term: Term to test
+//
+// Returns:
+//   x0 (int) - matched: 1 if the term matches, 0 otherwise
+//
+// Complexity: O(size of the pattern)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_match_term:
+    cmp x0, x1
+    b.eq match_term_leaf_yes
+    tst x0, #TERM_POINTER_MASK
+    b.ne match_term_structure
+
+    // Immediate pattern: only wildcards match a different word
+    and x2, x0, #TERM_IMM_MASK
+    cmp x2, #TERM_IMM_SPECIAL
+    b.ne match_term_leaf_no
+    cmp x0, #TERM_PATTERN_ANY
+    b.lo match_term_leaf_no
+    b.eq match_term_leaf_yes
+
+    // Type pattern
+    stp x0, x30, [sp, #-16]!
+    mov x0, x1
+    bl _term_type
+    ldp x2, x30, [sp], #16
+    lsr x2, x2, #TERM_IMM_SHIFT
+    sub x2, x2, #TERM_PATTERN_TYPE_BASE
+    cmp x0, x2
+    cset x0, eq
+    ret
+
+match_term_structure:
+    eor x2, x0, x1
+    tst x2, #TERM_TAG_MASK
+    b.ne match_term_leaf_no           // Term of another class
+    tbnz x0, #TERM_BIT_LIST, match_term_list
+
+    // Boxed: binaries compare whole, tuples element by element
+    ldur x2, [x0, #-TERM_TAG_BOXED]
+    ubfx x3, x2, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    cmp x3, #TERM_KIND_TUPLE
+    b.ne match_term_binary
+    ldur x3, [x1, #-TERM_TAG_BOXED]
+    cmp x2, x3
+    b.ne match_term_leaf_no           // Different kind or arity
+
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    sub x19, x0, #TERM_TAG_BOXED
+    sub x20, x1, #TERM_TAG_BOXED
+    lsr x21, x2, #TERM_HEADER_ARITY_SHIFT
+match_term_elements:
+    cbz x21, match_term_yes
+    ldr x0, [x19, #8]!
+    ldr x1, [x20, #8]!
+    bl _match_term
+    cbz x0, match_term_no
+    sub x21, x21, #1
+    b match_term_elements
+
+match_term_list:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0
+    mov x20, x1
+match_term_cell:
+    ldur x0, [x19, #-TERM_TAG_LIST]
+    ldur x1, [x20, #-TERM_TAG_LIST]
+    bl _match_term
+    cbz x0, match_term_no
+    ldur x19, [x19, #(8 - TERM_TAG_LIST)]
+    ldur x20, [x20, #(8 - TERM_TAG_LIST)]
+    and x2, x19, x20
+    tbnz x2, #TERM_BIT_LIST, match_term_cell // Both spines continue
+
+    // Pattern tail (a wildcard, [] or other) against the rest
+    mov x0, x19
+    mov x1, x20
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    b _match_term
+
+match_term_yes:
+    mov x0, #1
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+match_term_no:
+    mov x0, #0
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+match_term_binary:
+    b _term_equal                     // Tail call
+
+match_term_leaf_yes:
+    mov x0, #1
+    ret
+
+match_term_leaf_no:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Match Key (internal)
+// ------------------------------------------------------------
+// Dispatch key of a pattern or message: (0, word) for a literal
+// immediate, (header, first element) for a tuple whose first element
+// is a literal immediate, ([] for an empty tuple). Wildcards, lists,
+// binaries and other tuples have no key.
+//
+// Parameters:
+//   x0 (term_t) - term: Pattern or message
+//
+// Returns:
+//   x0 (uint64_t) - key_a: Tuple header or 0
+//   x1 (uint64_t) - key_b: Literal word
+//   x2 (int) - keyed: 1 if the term has a key, 0 otherwise
+//
+// Clobbers: x3-x5
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+match_key:
+    tst x0, #TERM_POINTER_MASK
+    b.ne match_key_pointer
+    and x3, x0, #TERM_IMM_MASK
+    cmp x3, #TERM_IMM_SPECIAL
+    b.ne match_key_immediate
+    cmp x0, #TERM_PATTERN_ANY
+    b.hs match_key_none
+match_key_immediate:
+    mov x1, x0
+    mov x0, #0
+    mov x2, #1
+    ret
+
+match_key_pointer:
+    tbz x0, #TERM_BIT_BOXED, match_key_none
+    ldur x3, [x0, #-TERM_TAG_BOXED]
+    ubfx x4, x3, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    cmp x4, #TERM_KIND_TUPLE
+    b.ne match_key_none
+    lsr x4, x3, #TERM_HEADER_ARITY_SHIFT
+    cbz x4, match_key_empty_tuple
+    ldur x1, [x0, #(8 - TERM_TAG_BOXED)]
+    tst x1, #TERM_POINTER_MASK
+    b.ne match_key_none
+    and x5, x1, #TERM_IMM_MASK
+    cmp x5, #TERM_IMM_SPECIAL
+    b.ne match_key_tuple
+    cmp x1, #TERM_PATTERN_ANY
+    b.hs match_key_none
+match_key_tuple:
+    mov x0, x3
+    mov x2, #1
+    ret
+
+match_key_empty_tuple:
+    mov x0, x3
+    mov x1, #TERM_NIL
+    mov x2, #1
+    ret
+
+match_key_none:
+    mov x2, #0
+    ret
+
+// ------------------------------------------------------------
+// Match Bucket Find (internal)
+// ------------------------------------------------------------
+// Probe the key buckets for a key.
+//
+// Parameters:
+//   x0 (uint64_t) - key_a: Key from match_key
+//   x1 (uint64_t) - key_b: Key from match_key
+//   x2 (void*) - matcher: Matcher
+//
+// Returns:
+//   x2 (void*) - bucket: The key's bucket, or the empty bucket where
+//                it would go (x0 and x1 are preserved)
+//
+// Clobbers: x3-x9
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+match_bucket_find:
+    movz x3, #0x7C15                  // 2^64 / golden ratio
+    movk x3, #0x7F4A, lsl #16
+    movk x3, #0x79B9, lsl #32
+    movk x3, #0x9E37, lsl #48
+    mul x4, x1, x3
+    eor x4, x4, x0
+    eor x4, x4, x4, lsr #29
+    mul x4, x4, x3
+    lsr x4, x4, #32
+    ldr x5, [x2, #match_bucket_mask]
+    ldr x6, [x2, #match_buckets]
+    mov x7, #match_bucket_size
+match_bucket_probe:
+    and x4, x4, x5
+    madd x3, x4, x7, x6
+    ldr w8, [x3, #match_bucket_count]
+    cbz w8, match_bucket_done
+    ldp x8, x9, [x3, #match_bucket_key_a]
+    cmp x8, x0
+    ccmp x9, x1, #0, eq
+    b.eq match_bucket_done
+    add x4, x4, #1
+    b match_bucket_probe
+
+match_bucket_done:
+    mov x2, x3
+    ret
+
+// ------------------------------------------------------------
+// Match Compile
+// ------------------------------------------------------------
+// Compile clauses into a matcher. The patterns are referenced, not
+// copied: they must stay live (and unchanged) while the matcher is
+// used, e.g. built once on the heap of the process that receives.
+//
+// Parameters:
+//   x0 (const void*) - clauses: count clauses of MATCH_CLAUSE_SIZE
+//                      bytes: pattern term, guard function
+//                      int guard(term_t message, uint64_t argument)
+//                      or NULL, guard argument
+//   x1 (uint64_t) - count: Clauses, 1 to MATCH_MAX_CLAUSES
+//
+// Returns:
+//   x0 (void*) - matcher: Compiled matcher, or NULL on invalid
+//                arguments or if the mapping fails
+//
+// Complexity: O(count) expected
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_match_compile:
+    cbz x0, match_compile_invalid
+    cbz x1, match_compile_invalid
+    mov x9, #MATCH_MAX_CLAUSES
+    cmp x1, x9
+    b.hi match_compile_invalid
+
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    stp x26, x27, [sp, #-16]!
+    str x28, [sp, #-16]!
+
+    mov x24, x0                       // Caller's clauses
+    mov x20, x1                       // count
+
+    // Buckets: smallest power of two >= 2 * count, at least 8
+    lsl x9, x20, #1
+    sub x9, x9, #1
+    clz x9, x9
+    mov x10, #64
+    sub x9, x10, x9
+    mov x23, #1
+    lsl x23, x23, x9
+    cmp x23, #MATCH_MIN_BUCKETS
+    mov x9, #MATCH_MIN_BUCKETS
+    csel x23, x23, x9, hs             // Buckets
+
+    // Header, clauses, buckets, then three u32 arrays of count
+    mov x9, #MATCH_CLAUSE_SIZE
+    mul x21, x20, x9
+    add x21, x21, #match_header_size
+    mov x9, #match_bucket_size
+    madd x21, x23, x9, x21
+    add x9, x20, x20, lsl #1
+    add x21, x21, x9, lsl #2          // Mapping length
+
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, x21                       // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq match_compile_failed
+    mov x19, x0
+
+    // Header (the mapping is zeroed)
+    str x21, [x19, #match_length]
+    str x20, [x19, #match_count]
+    sub x9, x23, #1
+    str x9, [x19, #match_bucket_mask]
+    add x9, x19, #match_header_size
+    str x9, [x19, #match_clauses]
+    mov x10, #MATCH_CLAUSE_SIZE
+    madd x22, x20, x10, x9            // Buckets
+    str x22, [x19, #match_buckets]
+    mov x10, #match_bucket_size
+    madd x25, x23, x10, x22           // Clause buckets
+    add x26, x25, x20, lsl #2         // Generic list
+    str x26, [x19, #match_generic]
+    add x27, x26, x20, lsl #2         // Bucket lists
+    str x27, [x19, #match_lists]
+
+    // Copy the clauses
+    ldr x9, [x19, #match_clauses]
+    mov x10, #MATCH_CLAUSE_SIZE
+    mul x10, x20, x10
+match_compile_copy:
+    ldr x11, [x24], #8
+    str x11, [x9], #8
+    subs x10, x10, #8
+    b.ne match_compile_copy
+
+    // Key every clause: count it in its bucket, or list it as generic
+    mov x21, #0
+    mov x28, #0                       // Generic clauses
+    ldr x24, [x19, #match_clauses]
+match_compile_key:
+    mov x9, #MATCH_CLAUSE_SIZE
+    mul x9, x21, x9
+    ldr x0, [x24, x9]
+    bl match_key
+    cbz x2, match_compile_generic
+    mov x2, x19
+    bl match_bucket_find
+    stp x0, x1, [x2, #match_bucket_key_a]
+    ldr w9, [x2, #match_bucket_count]
+    add w9, w9, #1
+    str w9, [x2, #match_bucket_count]
+    sub x9, x2, x22
+    mov x10, #match_bucket_size
+    udiv x9, x9, x10
+    str w9, [x25, x21, lsl #2]
+    b match_compile_next_key
+
+match_compile_generic:
+    mov w9, #MATCH_NO_CLAUSE
+    str w9, [x25, x21, lsl #2]
+    str w21, [x26, x28, lsl #2]
+    add x28, x28, #1
+
+match_compile_next_key:
+    add x21, x21, #1
+    cmp x21, x20
+    b.lo match_compile_key
+    str x28, [x19, #match_generic_count]
+
+    // Lay the lists out; counts restart as fill cursors
+    mov x9, #0                        // Bucket
+    mov x10, #0                       // List offset
+match_compile_offsets:
+    mov x11, #match_bucket_size
+    madd x11, x9, x11, x22
+    ldr w12, [x11, #match_bucket_count]
+    str w10, [x11, #match_bucket_list]
+    add x10, x10, x12
+    str wzr, [x11, #match_bucket_count]
+    add x9, x9, #1
+    cmp x9, x23
+    b.lo match_compile_offsets
+
+    // Fill in clause order, so every list is ascending
+    mov x21, #0
+match_compile_fill:
+    ldr w9, [x25, x21, lsl #2]
+    mov w10, #MATCH_NO_CLAUSE
+    cmp w9, w10
+    b.eq match_compile_fill_next
+    mov x11, #match_bucket_size
+    madd x11, x9, x11, x22
+    ldr w12, [x11, #match_bucket_list]
+    ldr w13, [x11, #match_bucket_count]
+    add w14, w12, w13
+    str w21, [x27, x14, lsl #2]
+    add w13, w13, #1
+    str w13, [x11, #match_bucket_count]
+match_compile_fill_next:
+    add x21, x21, #1
+    cmp x21, x20
+    b.lo match_compile_fill
+
+    mov x0, x19
+    b match_compile_return
+
+match_compile_failed:
+    mov x0, #0
+
+match_compile_return:
+    ldr x28, [sp], #16
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+match_compile_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Match Run
+// ------------------------------------------------------------
+// Find the first clause whose pattern matches a message and whose
+// guard (if any) accepts it. Only the clauses sharing the message's
+// key and the generic clauses are tested, in clause order.
+//
+// Parameters:
+//   x0 (void*) - matcher: Compiled matcher
+//   x1 (term_t) - message: Message term
+//
+// Returns:
+//   x0 (uint64_t) - clause: Index of the matching clause, or
+//                   MATCH_NO_CLAUSE
+//
+// Complexity: O(1) expected for keyed clauses, plus the generic ones
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_match_run:
+    cbz x0, match_run_invalid
+
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+
+    mov x19, x0                       // matcher
+    mov x20, x1                       // message
+    mov x22, #0                       // Keyed candidates left
+
+    mov x0, x1
+    bl match_key
+    cbz x2, match_run_lists
+    mov x2, x19
+    bl match_bucket_find
+    ldr w22, [x2, #match_bucket_count]
+    ldr w9, [x2, #match_bucket_list]
+    ldr x21, [x19, #match_lists]
+    add x21, x21, x9, lsl #2          // Keyed candidates
+
+match_run_lists:
+    ldr x23, [x19, #match_generic]
+    ldr x24, [x19, #match_generic_count]
+
+match_run_next:
+    // Merge the two ascending lists
+    cbz x22, match_run_take_generic
+    cbz x24, match_run_take_keyed
+    ldr w9, [x21]
+    ldr w10, [x23]
+    cmp w9, w10
+    b.hi match_run_take_generic
+match_run_take_keyed:
+    ldr w25, [x21], #4
+    sub x22, x22, #1
+    b match_run_test
+
+match_run_take_generic:
+    cbz x24, match_run_none
+    ldr w25, [x23], #4
+    sub x24, x24, #1
+
+match_run_test:
+    ldr x9, [x19, #match_clauses]
+    mov x10, #MATCH_CLAUSE_SIZE
+    madd x9, x25, x10, x9
+    ldr x0, [x9, #match_clause_pattern]
+    mov x1, x20
+    bl _match_term
+    cbz x0, match_run_next
+
+    ldr x9, [x19, #match_clauses]
+    mov x10, #MATCH_CLAUSE_SIZE
+    madd x9, x25, x10, x9
+    ldr x10, [x9, #match_clause_guard]
+    cbz x10, match_run_matched
+    mov x0, x20
+    ldr x1, [x9, #match_clause_argument]
+    blr x10
+    cbz x0, match_run_next
+
+match_run_matched:
+    mov x0, x25
+    b match_run_return
+
+match_run_none:
+    mov x0, #MATCH_NO_CLAUSE
+
+match_run_return:
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+match_run_invalid:
+    mov x0, #MATCH_NO_CLAUSE
+    ret
+
+// ------------------------------------------------------------
+// Match Destroy
+// ------------------------------------------------------------
+// Unmap a matcher.
+//
+// Parameters:
+//   x0 (void*) - matcher: Compiled matcher
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if matcher is NULL or munmap
+//              fails
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_match_destroy:
+    cbz x0, match_destroy_invalid
+    stp x29, x30, [sp, #-16]!
+    ldr x1, [x0, #match_length]
+    bl _munmap
+    cmp x0, #0
+    cset x0, eq
+    ldp x29, x30, [sp], #16
+    ret
+
+match_destroy_invalid:
+    mov x0, #0
+    ret
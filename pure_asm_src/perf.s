@@ -0,0 +1,567 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// perf.s — Hardware Performance Counters per Scheduler Phase
+// ------------------------------------------------------------
+// Counts cycles, instructions, L1D read misses, last-level cache read
+// misses and branch misses for each scheduler thread, split by the
+// runtime phase the thread was in: dispatch, stealing, message
+// passing, garbage collection or timer expiry.
+//
+// Counters come from perf_event_open on Linux and are opened as one
+// group (cycles leads) on the scheduler's own thread, counting user
+// space only. Each phase boundary reads the whole group with a single
+// read() and adds the deltas since the previous boundary to the phase
+// being left. Events the PMU does not offer are skipped; if even the
+// cycle counter cannot be opened the scheduler runs without counters.
+// On macOS there is no perf_event_open: requests fail and nothing is
+// counted.
+//
+// Each scheduler's counters live in a perf block referenced by its
+// scheduler state (scheduler_perf): 0 when off, 1 when requested but
+// not yet opened, otherwise the block. The totals are written only by
+// the owning scheduler and are read lock-free by stats_snapshot.
+//
+// For Linux, assemble with --defsym ACTLY_LINUX=1.
+//
+// The file provides:
+//   - Requesting and opening a scheduler's counter group
+//   - Phase switching with per-phase delta accounting
+//   - Per-phase totals and counter teardown
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// ------------------------------------------------------------
+// Perf Function Exports
+// ------------------------------------------------------------
+// Export the performance counter functions to make them callable from
+// C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _perf_request
+    .global _perf_open
+    .global _perf_close
+    .global _perf_phase
+    .global _perf_enter_phase
+    .global _perf_total
+
+// ------------------------------------------------------------
+// Perf Block Layout
+// ------------------------------------------------------------
+// One page per scheduler with counters. The group read buffer holds
+// the member count followed by one value per open member, in the order
+// the members were opened; perf_slots maps each PERF_EVENT_* to its
+// position there (0xFF if that event could not be opened).
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ perf_fds, 0                  // Event fds, -1 if not open (5 * 4 bytes)
+    .equ perf_slots, 20               // Read buffer slot per event (5 bytes)
+    .equ perf_members, 28             // Open group members (4 bytes)
+    .equ perf_phase, 32               // Current PERF_PHASE_* (8 bytes)
+    .equ perf_last, 40                // Values at the last boundary (5 * 8 bytes)
+    .equ perf_totals, PERF_TOTALS     // Phase-major totals (5 * 5 * 8 bytes)
+    .equ perf_buffer, 280             // Group read buffer (6 * 8 bytes)
+    .equ perf_attr, 384               // perf_event_attr scratch (128 bytes)
+    .equ perf_size, 4096              // Total perf block size
+
+    .equ PERF_BUFFER_SIZE, 48         // nr + one value per event
+    .equ PERF_OFF, 0                  // scheduler_perf: no counters
+    .equ PERF_REQUESTED, 1            // scheduler_perf: open on next loop pass
+
+    // perf_event_open (Linux AArch64)
+    .equ SYS_PERF_EVENT_OPEN, 241
+    .equ PERF_ATTR_SIZE, 64           // PERF_ATTR_SIZE_VER0
+    .equ PERF_ATTR_CONFIG, 8
+    .equ PERF_ATTR_READ_FORMAT, 32
+    .equ PERF_ATTR_FLAGS, 40
+    .equ PERF_FORMAT_GROUP, 8
+    .equ PERF_FLAGS_USER_ONLY, 0x60   // exclude_kernel | exclude_hv
+    .equ PERF_FLAG_FD_CLOEXEC, 8
+
+    // Scheduler state offsets (shared with scheduler.s)
+    .include "scheduler_state.inc"
+
+// ------------------------------------------------------------
+// Perf Request
+// ------------------------------------------------------------
+// Ask a scheduler to count hardware events. Counters belong to the
+// thread that opens them, so the scheduler opens them itself at the
+// start of its next main loop pass. Safe to call from any thread,
+// before or after the scheduler starts.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID of the scheduler
+//
+// Returns:
+//   x0 (int) - success: 1 if requested (or already counting), 0 on
+//              invalid arguments or a host without perf_event_open
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_perf_request:
+.ifdef ACTLY_LINUX
+    cbz x0, perf_request_invalid
+    cmp x1, #MAX_CORES
+    b.hs perf_request_invalid
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0
+    add x2, x2, #scheduler_perf
+    mov x3, #PERF_REQUESTED
+perf_request_retry:
+    ldaxr x4, [x2]
+    cbnz x4, perf_request_done        // Already requested or open
+    stlxr w5, x3, [x2]
+    cbnz w5, perf_request_retry
+    mov x0, #1
+    ret
+
+perf_request_done:
+    clrex
+    mov x0, #1
+    ret
+.endif
+
+perf_request_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Perf Open
+// ------------------------------------------------------------
+// Open a scheduler's counter group on the calling thread, which must
+// be the thread that runs the scheduler. The main loop calls this when
+// a request is pending; code that steps schedulers itself can call it
+// directly. Counting starts in PERF_PHASE_NONE.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID of the scheduler
+//
+// Returns:
+//   x0 (int) - success: 1 if counting (or already counting), 0 if the
+//              cycle counter could not be opened or the host has no
+//              perf_event_open; the request is cleared either way
+//
+// Complexity: O(PERF_EVENT_COUNT) system calls
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_perf_open:
+.ifdef ACTLY_LINUX
+    cbz x0, perf_open_invalid
+    cmp x1, #MAX_CORES
+    b.hs perf_open_invalid
+
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    mov x2, #scheduler_size
+    madd x19, x1, x2, x0              // x19 = scheduler state
+    ldr x0, [x19, #scheduler_perf]
+    cmp x0, #PERF_REQUESTED
+    b.hi perf_open_already
+
+    // Perf block
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, #perf_size                // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq perf_open_failed
+    mov x20, x0                       // x20 = perf block
+
+    mov w0, #-1
+    mov w1, #0xFF
+    mov x2, #0
+perf_open_clear:
+    add x3, x20, x2, lsl #2
+    str w0, [x3, #perf_fds]
+    add x3, x20, x2
+    strb w1, [x3, #perf_slots]
+    add x2, x2, #1
+    cmp x2, #PERF_EVENT_COUNT
+    b.lo perf_open_clear
+    mov x0, #PERF_PHASE_NONE
+    str x0, [x20, #perf_phase]
+
+    // Attributes shared by every member (the mapping is zeroed)
+    add x21, x20, #perf_attr
+    mov w0, #PERF_ATTR_SIZE
+    str w0, [x21, #4]
+    mov x0, #PERF_FORMAT_GROUP
+    str x0, [x21, #PERF_ATTR_READ_FORMAT]
+    mov x0, #PERF_FLAGS_USER_ONLY
+    str x0, [x21, #PERF_ATTR_FLAGS]
+
+    // Leader first, then the members that this PMU offers
+    mov x22, #0                       // event
+    mov w23, #-1                      // group fd
+perf_open_event:
+    cmp x22, #PERF_EVENT_COUNT
+    b.hs perf_open_started
+    adr x9, perf_event_table
+    add x9, x9, x22, lsl #3
+    ldp w0, w1, [x9]                  // type, config
+    str w0, [x21]
+    str x1, [x21, #PERF_ATTR_CONFIG]
+
+    mov x0, x21                       // attr
+    mov x1, #0                        // pid = calling thread
+    mov x2, #-1                       // cpu = any
+    sxtw x3, w23                      // group_fd
+    mov x4, #PERF_FLAG_FD_CLOEXEC
+    mov x8, #SYS_PERF_EVENT_OPEN
+    svc #0
+    tbnz x0, #63, perf_open_event_missing
+
+    add x3, x20, x22, lsl #2
+    str w0, [x3, #perf_fds]
+    ldr w1, [x20, #perf_members]
+    add x3, x20, x22
+    strb w1, [x3, #perf_slots]
+    add w1, w1, #1
+    str w1, [x20, #perf_members]
+    cmn w23, #1
+    csel w23, w0, w23, eq             // The first fd leads the group
+    add x22, x22, #1
+    b perf_open_event
+
+perf_open_event_missing:
+    cbz x22, perf_open_no_leader      // No cycle counter, no counting
+    add x22, x22, #1
+    b perf_open_event
+
+perf_open_started:
+    // Baseline values; nothing is attributed until a phase is entered
+    mov x0, x20
+    mov x1, #PERF_PHASE_NONE
+    bl _perf_phase
+    add x0, x19, #scheduler_perf
+    stlr x20, [x0]
+
+perf_open_already:
+    mov x0, #1
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+perf_open_no_leader:
+    mov x0, x20
+    mov x1, #perf_size
+    bl _munmap
+perf_open_failed:
+    str xzr, [x19, #scheduler_perf]
+    mov x0, #0
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+perf_open_invalid:
+    mov x0, #0
+    ret
+.else
+    cbz x0, perf_open_invalid
+    cmp x1, #MAX_CORES
+    b.hs perf_open_invalid
+    // No perf_event_open: drop any request so the loop stops asking
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0
+    str xzr, [x2, #scheduler_perf]
+perf_open_invalid:
+    mov x0, #0
+    ret
+.endif
+
+// ------------------------------------------------------------
+// Perf Close
+// ------------------------------------------------------------
+// Stop counting on a scheduler and release its counters. Call only
+// while the scheduler is not running and no snapshot is being taken,
+// as with trace_destroy.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID of the scheduler
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 on invalid arguments
+//
+// Complexity: O(PERF_EVENT_COUNT)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_perf_close:
+    cbz x0, perf_close_invalid
+    cmp x1, #MAX_CORES
+    b.hs perf_close_invalid
+
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0
+    ldr x19, [x2, #scheduler_perf]
+    str xzr, [x2, #scheduler_perf]
+    cmp x19, #PERF_REQUESTED
+    b.ls perf_close_done
+
+    mov x20, #0
+perf_close_fd:
+    add x0, x19, x20, lsl #2
+    ldr w0, [x0, #perf_fds]
+    tbnz w0, #31, perf_close_next
+    bl _close
+perf_close_next:
+    add x20, x20, #1
+    cmp x20, #PERF_EVENT_COUNT
+    b.lo perf_close_fd
+    mov x0, x19
+    mov x1, #perf_size
+    bl _munmap
+
+perf_close_done:
+    mov x0, #1
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+perf_close_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Perf Phase
+// ------------------------------------------------------------
+// Phase boundary on the owning scheduler's thread: read the group,
+// add each event's delta since the previous boundary to the phase
+// being left (nothing for PERF_PHASE_NONE) and enter `phase`. The main
+// loop calls this directly with the block from scheduler_perf once it
+// has checked that counters are open.
+//
+// Parameters:
+//   x0 (void*) - perf: Perf block from scheduler_perf
+//   x1 (uint64_t) - phase: PERF_PHASE_* to enter
+//
+// Returns:
+//   x0 (uint64_t) - previous: The phase that was left
+//
+// Complexity: O(PERF_EVENT_COUNT) plus one read() system call
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x0-x18 (calls read)
+//
+_perf_phase:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0                       // perf block
+    mov x20, x1                       // phase to enter
+    ldr x21, [x19, #perf_phase]       // phase being left
+
+.ifdef ACTLY_LINUX
+    ldr w0, [x19, #perf_fds]          // group leader
+    add x1, x19, #perf_buffer
+    mov x2, #PERF_BUFFER_SIZE
+    bl _read
+    cmp x0, #16                       // nr and at least the leader
+    b.lt perf_phase_switch
+
+    // Totals row for the phase being left, or none
+    mov x0, #PERF_EVENT_COUNT * 8
+    mul x0, x21, x0
+    add x0, x0, #perf_totals
+    add x0, x19, x0
+    cmp x21, #PERF_PHASE_COUNT
+    csel x0, xzr, x0, hs
+
+    mov x1, #0                        // event
+perf_phase_event:
+    add x2, x19, x1
+    ldrb w2, [x2, #perf_slots]
+    cmp w2, #0xFF
+    b.eq perf_phase_next
+    add x2, x19, x2, lsl #3
+    ldr x2, [x2, #perf_buffer + 8]    // value after nr
+    add x3, x19, x1, lsl #3
+    ldr x4, [x3, #perf_last]
+    str x2, [x3, #perf_last]
+    cbz x0, perf_phase_next
+    sub x2, x2, x4
+    ldr x4, [x0, x1, lsl #3]
+    add x4, x4, x2
+    str x4, [x0, x1, lsl #3]
+perf_phase_next:
+    add x1, x1, #1
+    cmp x1, #PERF_EVENT_COUNT
+    b.lo perf_phase_event
+.endif
+
+perf_phase_switch:
+    str x20, [x19, #perf_phase]
+    mov x0, x21
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Perf Enter Phase
+// ------------------------------------------------------------
+// Phase boundary for code that steps schedulers itself rather than
+// through the main loop. Must run on the thread that opened the
+// scheduler's counters.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID of the scheduler
+//   x2 (uint64_t) - phase: PERF_PHASE_* to enter
+//
+// Returns:
+//   x0 (uint64_t) - previous: The phase that was left, or
+//                   PERF_PHASE_NONE if the scheduler is not counting
+//
+// Complexity: O(PERF_EVENT_COUNT) plus one read() system call
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_perf_enter_phase:
+    cbz x0, perf_enter_phase_off
+    cmp x1, #MAX_CORES
+    b.hs perf_enter_phase_off
+    mov x3, #scheduler_size
+    madd x3, x1, x3, x0
+    ldr x0, [x3, #scheduler_perf]
+    cmp x0, #PERF_REQUESTED
+    b.ls perf_enter_phase_off
+    mov x1, x2
+    b _perf_phase
+
+perf_enter_phase_off:
+    mov x0, #PERF_PHASE_NONE
+    ret
+
+// ------------------------------------------------------------
+// Perf Total
+// ------------------------------------------------------------
+// One event's total for one phase of a scheduler. Safe to call from
+// any thread while the scheduler runs.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID of the scheduler
+//   x2 (uint64_t) - phase: PERF_PHASE_*
+//   x3 (uint64_t) - event: PERF_EVENT_*
+//
+// Returns:
+//   x0 (uint64_t) - total: Events counted, or 0 if not counting or invalid
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_perf_total:
+    cbz x0, perf_total_zero
+    cmp x1, #MAX_CORES
+    b.hs perf_total_zero
+    cmp x2, #PERF_PHASE_COUNT
+    b.hs perf_total_zero
+    cmp x3, #PERF_EVENT_COUNT
+    b.hs perf_total_zero
+    mov x4, #scheduler_size
+    madd x4, x1, x4, x0
+    add x4, x4, #scheduler_perf
+    ldar x4, [x4]
+    cmp x4, #PERF_REQUESTED
+    b.ls perf_total_zero
+    mov x5, #PERF_EVENT_COUNT
+    madd x2, x2, x5, x3
+    add x4, x4, #perf_totals
+    ldr x0, [x4, x2, lsl #3]
+    ret
+
+perf_total_zero:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Perf Event Table
+// ------------------------------------------------------------
+// perf_event_attr type and config for each PERF_EVENT_*, in order.
+// Cache events are PERF_TYPE_HW_CACHE with config
+// cache | (op << 8) | (result << 16): read misses here.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+perf_event_table:
+    .word 0, 0                        // HARDWARE, CPU_CYCLES
+    .word 0, 1                        // HARDWARE, INSTRUCTIONS
+    .word 3, 0x10000                  // HW_CACHE, L1D read miss
+    .word 3, 0x10002                  // HW_CACHE, LL read miss
+    .word 0, 5                        // HARDWARE, BRANCH_MISSES
+    .align 4
+
+// Import required functions from other modules
+    .extern _mmap
+    .extern _munmap
+    .extern _read
+    .extern _close
@@ -0,0 +1,492 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// ------------------------------------------------------------
+// pipeline.s — Fused Template Pipelines
+// ------------------------------------------------------------
+// Compiles a chain of behavior templates, such as "Change All, then
+// Pick From, then Combine" (Map, Filter, Reduce), to one interpreter
+// program. Stages are Map, Filter, Zip, FindIn and Reduce; FindIn and
+// Reduce end a chain, and a chain without either collects a list.
+//
+// Fused, the chain is one NEXT loop that pulls each input element
+// through every stage in turn: a Map CALLs its body on the element,
+// a Filter or FindIn CALLs its test and goes back for the next element
+// on integer 0, a Zip pairs the element with the next one of a second
+// list, and the element is then folded, returned or consed onto the
+// output. No intermediate list is built, so a Map, Filter, Reduce
+// chain allocates nothing at all, and FindIn returns at its first
+// match without mapping or testing the rest of the input.
+//
+// A test against a Set is a body that loads a set handle literal
+// (set.s) and tests the element with MEMBER, which leaves integer 1
+// or 0 in r3; the set is frozen and shared, so it is never copied or
+// rebuilt per run.
+//
+// Unfused, each stage is its own pass, as each template translates
+// on its own: a NEXT loop that conses the stage's output and reverses
+// it into the input of the next pass. Both forms take the same stage
+// bodies and registers and give the same result, which is what makes
+// them comparable.
+//
+// Generated code is ordinary bytecode: it yields at any instruction
+// when the reduction budget runs out, resumes from its frame, and can
+// be compiled to native code with jit.s like any other program.
+//
+// Registers:
+//   r0: input list          r1: accumulator, FindIn default or output
+//   r2: current element     r3: Filter and FindIn test results
+//   r4: list Zip pairs with r5-r7: the pipeline's own
+//   r8-r15: scratch for stage bodies
+//
+// The file provides:
+//   - Pipeline compilation, fused or one pass per stage
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// External interpreter functions
+    .extern _interp_load
+
+// External C library functions for memory management
+    .extern _mmap
+    .extern _munmap
+
+// ------------------------------------------------------------
+// Pipeline Function Exports
+// ------------------------------------------------------------
+// Export the pipeline functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _pipeline_load
+
+// ------------------------------------------------------------
+// Pipeline Layout
+// ------------------------------------------------------------
+// A stage is PIPELINE_STAGE_SIZE bytes of caller memory. Code is
+// generated into a scratch mapping of PIPELINE_MAX_CODE words followed
+// by the literals, the caller's and then [] for the pipeline's own
+// LOADKs, and handed to _interp_load.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ pipeline_stage_kind, 0       // PIPELINE_STAGE_* (8 bytes)
+    .equ pipeline_stage_body, 8       // Bytecode ending in RET (8 bytes)
+    .equ pipeline_stage_count, 16     // Body instructions (8 bytes)
+
+    .equ pipeline_reg_zip_element, 5  // Element Zip takes from r4
+    .equ pipeline_reg_pass, 6         // Output of an unfused pass
+    .equ pipeline_reg_false, 7        // Integer 0, what tests compare with
+    .equ pipeline_code_bytes, (PIPELINE_MAX_CODE * 4)
+    .equ pipeline_stage_code, 16      // Most instructions around one stage
+    .equ pipeline_calls, 64           // CALL site of each stage (stack bytes)
+
+// ------------------------------------------------------------
+// Emit Macros
+// ------------------------------------------------------------
+// Generated code goes to x20 at instruction index x21. PIPELINE_OP
+// emits an instruction with constant fields, PIPELINE_JUMP a jump
+// or NEXT to the instruction index in a register, PIPELINE_PATCH
+// points the forward jump at index \site at the next instruction, and
+// PIPELINE_LOADK_NIL loads [] (literal index x28). Each clobbers
+// x9-x10.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+.macro PIPELINE_OP op, a=0, b=0, k=0
+    movz w9, #(((\op) | ((\a) << 8) | ((\b) << 12)) & 0xFFFF)
+    movk w9, #((\k) & 0xFFFF), lsl #16
+    str w9, [x20, x21, lsl #2]
+    add x21, x21, #1
+.endm
+
+.macro PIPELINE_JUMP op, a, b, target
+    sub x9, \target, x21
+    sub x9, x9, #1                    // K counts from the next instruction
+    mov w10, #((\op) | ((\a) << 8) | ((\b) << 12))
+    bfi w10, w9, #16, #16
+    str w10, [x20, x21, lsl #2]
+    add x21, x21, #1
+.endm
+
+.macro PIPELINE_PATCH site
+    sub x9, x21, \site
+    sub x9, x9, #1
+    ldr w10, [x20, \site, lsl #2]
+    bfi w10, w9, #16, #16
+    str w10, [x20, \site, lsl #2]
+.endm
+
+.macro PIPELINE_LOADK_NIL a
+    mov w10, #(INTERP_OP_LOADK | ((\a) << 8))
+    bfi w10, w28, #16, #16
+    str w10, [x20, x21, lsl #2]
+    add x21, x21, #1
+.endm
+
+// ------------------------------------------------------------
+// Pipeline Load
+// ------------------------------------------------------------
+// Compile a chain of stages to a loaded interpreter program, fused
+// into one loop or as one pass per stage. Set r0 (and r4 for a Zip,
+// r1 for a Reduce or FindIn) before running it; the program halts
+// with the Reduce accumulator, the FindIn match (r1 if none matches),
+// or the list of elements that came through every stage.
+//
+// Bodies are called with CALL and run in the program like any other
+// code: they may use r8-r15, their own CALLs and the caller's literals,
+// and must leave r0 and r4-r7 alone. A Zip ends the chain's input
+// when its list runs out.
+//
+// Parameters:
+//   x0 (const void*) - stages: count stages of PIPELINE_STAGE_SIZE bytes
+//   x1 (uint64_t) - count: 1 to PIPELINE_MAX_STAGES
+//   x2 (const term_t*) - literals: Literals for the bodies' LOADKs, or
+//                        NULL if literal_count is 0
+//   x3 (uint64_t) - literal_count: Fewer than INTERP_MAX_LITERALS
+//   x4 (int) - fused: Non-zero for one loop, 0 for one pass per stage
+//
+// Returns:
+//   x0 (void*) - program: Program for interp_frame_init, or NULL for
+//                an unknown kind, a FindIn or Reduce before the last
+//                stage, two Zips, a missing body, too much code,
+//                invalid bodies or arguments, or a failed mapping
+//
+// Complexity: O(code + literal_count)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_pipeline_load:
+    cbz x0, pipeline_load_invalid
+    cbz x1, pipeline_load_invalid
+    cmp x1, #PIPELINE_MAX_STAGES
+    b.hi pipeline_load_invalid
+    mov x9, #(INTERP_MAX_LITERALS - 1)
+    cmp x3, x9
+    b.hi pipeline_load_invalid
+    cbz x3, pipeline_load_check
+    cbz x2, pipeline_load_invalid
+
+    // Every stage: a known kind, terminal kinds last, one Zip at most,
+    // and bodies that fit with the code around them
+pipeline_load_check:
+    mov x9, #0                        // Stage
+    mov x10, x0
+    mov x11, #0                       // Zips
+    mov x12, #0                       // Instructions
+pipeline_load_check_stage:
+    add x12, x12, #pipeline_stage_code
+    ldr x13, [x10, #pipeline_stage_kind]
+    cmp x13, #PIPELINE_STAGE_REDUCE
+    b.hi pipeline_load_invalid
+    cmp x13, #PIPELINE_STAGE_FINDIN
+    b.lo pipeline_load_check_inner
+    sub x14, x1, #1
+    cmp x9, x14
+    b.ne pipeline_load_invalid        // Ends the chain, so must be last
+pipeline_load_check_inner:
+    cmp x13, #PIPELINE_STAGE_ZIP
+    b.ne pipeline_load_check_body
+    add x11, x11, #1
+    cmp x11, #1
+    b.hi pipeline_load_invalid
+    b pipeline_load_check_next
+pipeline_load_check_body:
+    ldr x14, [x10, #pipeline_stage_body]
+    cbz x14, pipeline_load_invalid
+    ldr x14, [x10, #pipeline_stage_count]
+    cbz x14, pipeline_load_invalid
+    mov x15, #PIPELINE_MAX_CODE
+    cmp x14, x15
+    b.hi pipeline_load_invalid
+    add x12, x12, x14
+pipeline_load_check_next:
+    add x10, x10, #PIPELINE_STAGE_SIZE
+    add x9, x9, #1
+    cmp x9, x1
+    b.lo pipeline_load_check_stage
+    mov x15, #PIPELINE_MAX_CODE
+    cmp x12, x15
+    b.hi pipeline_load_invalid
+
+    stp x29, x30, [sp, #-16]!
+    mov x29, sp
+    stp x19, x20, [sp, #-16]!
+    stp x21, x22, [sp, #-16]!
+    stp x23, x24, [sp, #-16]!
+    stp x25, x26, [sp, #-16]!
+    stp x27, x28, [sp, #-16]!
+    sub sp, sp, #pipeline_calls
+
+    mov x19, x0                       // stages
+    mov x22, x1                       // count
+    mov x23, x4                       // fused
+    mov x24, x2                       // Caller's literals
+    mov x28, x3                       // literal_count, and the index of []
+
+    // Scratch: code, then the literals
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, #pipeline_code_bytes
+    add x1, x1, x28, lsl #3
+    add x1, x1, #8                    // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq pipeline_load_failed
+    mov x20, x0
+
+    add x9, x20, #pipeline_code_bytes
+    mov x10, #0
+pipeline_load_literals:
+    cmp x10, x28
+    b.hs pipeline_load_literals_done
+    ldr x11, [x24, x10, lsl #3]
+    str x11, [x9, x10, lsl #3]
+    add x10, x10, #1
+    b pipeline_load_literals
+pipeline_load_literals_done:
+    mov x11, #TERM_NIL
+    str x11, [x9, x10, lsl #3]
+
+    // Is the last stage a FindIn or a Reduce?
+    sub x9, x22, #1
+    mov x10, #PIPELINE_STAGE_SIZE
+    madd x9, x9, x10, x19
+    ldr x26, [x9, #pipeline_stage_kind] // Last kind
+
+    mov x21, #0                       // Instruction index
+    mov x27, #-1                      // Zip's NEXT, if any
+    PIPELINE_OP INTERP_OP_LOADI, pipeline_reg_false, 0, 0
+    cbz x23, pipeline_load_passes
+
+    // Fused: one loop over the input through every stage
+    cmp x26, #PIPELINE_STAGE_FINDIN
+    b.hs pipeline_load_fused_loop
+    PIPELINE_LOADK_NIL PIPELINE_REG_RESULT
+pipeline_load_fused_loop:
+    mov x25, x21                      // Loop head
+    PIPELINE_OP INTERP_OP_NEXT, PIPELINE_REG_INPUT, PIPELINE_REG_ELEMENT, 0
+    mov x24, #0
+pipeline_load_fused_stage:
+    bl pipeline_emit_stage
+    add x24, x24, #1
+    cmp x24, x22
+    b.lo pipeline_load_fused_stage
+    cmp x26, #PIPELINE_STAGE_FINDIN
+    b.eq pipeline_load_fused_end      // Ends in HALT
+    b.hi pipeline_load_fused_again
+    PIPELINE_OP INTERP_OP_CONS, PIPELINE_REG_RESULT, PIPELINE_REG_ELEMENT, PIPELINE_REG_RESULT
+pipeline_load_fused_again:
+    PIPELINE_JUMP INTERP_OP_JMP, 0, 0, x25
+pipeline_load_fused_end:
+    PIPELINE_PATCH x25
+    tbnz x27, #63, pipeline_load_fused_result
+    PIPELINE_PATCH x27
+pipeline_load_fused_result:
+    cmp x26, #PIPELINE_STAGE_FINDIN
+    b.hs pipeline_load_halt_result
+    PIPELINE_OP INTERP_OP_REVERSE, PIPELINE_REG_RESULT, PIPELINE_REG_RESULT, 0
+    b pipeline_load_halt_result
+
+    // Unfused: one pass per stage, each building its output list
+pipeline_load_passes:
+    mov x24, #0
+pipeline_load_pass:
+    sub x9, x22, #1
+    cmp x24, x9
+    b.ne pipeline_load_pass_list
+    cmp x26, #PIPELINE_STAGE_FINDIN
+    b.hs pipeline_load_pass_last
+pipeline_load_pass_list:
+    PIPELINE_LOADK_NIL pipeline_reg_pass
+    mov x25, x21
+    PIPELINE_OP INTERP_OP_NEXT, PIPELINE_REG_INPUT, PIPELINE_REG_ELEMENT, 0
+    mov x27, #-1
+    bl pipeline_emit_stage
+    PIPELINE_OP INTERP_OP_CONS, pipeline_reg_pass, PIPELINE_REG_ELEMENT, pipeline_reg_pass
+    PIPELINE_JUMP INTERP_OP_JMP, 0, 0, x25
+    PIPELINE_PATCH x25
+    tbnz x27, #63, pipeline_load_pass_done
+    PIPELINE_PATCH x27
+pipeline_load_pass_done:
+    PIPELINE_OP INTERP_OP_REVERSE, PIPELINE_REG_INPUT, pipeline_reg_pass, 0
+    add x24, x24, #1
+    cmp x24, x22
+    b.lo pipeline_load_pass
+    PIPELINE_OP INTERP_OP_HALT, PIPELINE_REG_INPUT, 0, 0
+    b pipeline_load_bodies
+
+pipeline_load_pass_last:
+    mov x25, x21
+    PIPELINE_OP INTERP_OP_NEXT, PIPELINE_REG_INPUT, PIPELINE_REG_ELEMENT, 0
+    mov x27, #-1
+    bl pipeline_emit_stage
+    cmp x26, #PIPELINE_STAGE_FINDIN
+    b.eq pipeline_load_pass_last_end
+    PIPELINE_JUMP INTERP_OP_JMP, 0, 0, x25
+pipeline_load_pass_last_end:
+    PIPELINE_PATCH x25
+    tbnz x27, #63, pipeline_load_halt_result
+    PIPELINE_PATCH x27
+
+pipeline_load_halt_result:
+    PIPELINE_OP INTERP_OP_HALT, PIPELINE_REG_RESULT, 0, 0
+
+    // Bodies after the loops; point each stage's CALL at its body
+pipeline_load_bodies:
+    mov x24, #0
+    mov x25, x19
+pipeline_load_body:
+    ldr x9, [x25, #pipeline_stage_kind]
+    cmp x9, #PIPELINE_STAGE_ZIP
+    b.eq pipeline_load_body_next
+    ldr x11, [sp, x24, lsl #3]        // CALL site
+    PIPELINE_PATCH x11
+    ldr x12, [x25, #pipeline_stage_body]
+    ldr x13, [x25, #pipeline_stage_count]
+pipeline_load_body_copy:
+    ldr w9, [x12], #4
+    str w9, [x20, x21, lsl #2]
+    add x21, x21, #1
+    subs x13, x13, #1
+    b.ne pipeline_load_body_copy
+pipeline_load_body_next:
+    add x25, x25, #PIPELINE_STAGE_SIZE
+    add x24, x24, #1
+    cmp x24, x22
+    b.lo pipeline_load_body
+
+    // Check, translate and load; the scratch goes either way
+    mov x0, x20
+    mov x1, x21
+    add x2, x20, #pipeline_code_bytes
+    add x3, x28, #1
+    bl _interp_load
+    mov x19, x0
+    mov x0, x20
+    mov x1, #pipeline_code_bytes
+    add x1, x1, x28, lsl #3
+    add x1, x1, #8
+    bl _munmap
+    mov x0, x19
+    b pipeline_load_return
+
+pipeline_load_failed:
+    mov x0, #0
+
+pipeline_load_return:
+    add sp, sp, #pipeline_calls
+    ldp x27, x28, [sp], #16
+    ldp x25, x26, [sp], #16
+    ldp x23, x24, [sp], #16
+    ldp x21, x22, [sp], #16
+    ldp x19, x20, [sp], #16
+    ldp x29, x30, [sp], #16
+    ret
+
+pipeline_load_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Pipeline Emit Stage (internal)
+// ------------------------------------------------------------
+// Emit stage x24's code for the element in r2, inside a loop whose
+// head (the input NEXT) is instruction x25:
+//   Map:    CALL body
+//   Filter: CALL body; JEQ r3, r7 -> head
+//   Zip:    NEXT r4, r5 -> end; TUPLE r3, 2; SETEL r3, r2, 0;
+//           SETEL r3, r5, 1; MOVE r2, r3
+//   FindIn: CALL body; JEQ r3, r7 -> head; HALT r2
+//   Reduce: CALL body
+// CALL sites go to the caller's stack array for patching once the
+// bodies are placed, and a Zip's NEXT to x27 for patching at the end
+// of the loop. Uses the registers of _pipeline_load.
+//
+// Parameters:
+//   x24 (uint64_t) - stage: Stage index
+//   x25 (uint64_t) - head: Loop head instruction
+//
+// Clobbers: x9-x11, x27 (for a Zip)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+pipeline_emit_stage:
+    mov x9, #PIPELINE_STAGE_SIZE
+    madd x11, x24, x9, x19
+    ldr x11, [x11, #pipeline_stage_kind]
+    cmp x11, #PIPELINE_STAGE_ZIP
+    b.eq pipeline_emit_zip
+    str x21, [sp, x24, lsl #3]
+    PIPELINE_OP INTERP_OP_CALL, 0, 0, 0
+    cmp x11, #PIPELINE_STAGE_FILTER
+    b.eq pipeline_emit_test
+    cmp x11, #PIPELINE_STAGE_FINDIN
+    b.eq pipeline_emit_test
+    ret                               // Map or Reduce
+
+pipeline_emit_test:
+    PIPELINE_JUMP INTERP_OP_JEQ, PIPELINE_REG_TEST, pipeline_reg_false, x25
+    cmp x11, #PIPELINE_STAGE_FINDIN
+    b.ne pipeline_emit_done
+    PIPELINE_OP INTERP_OP_HALT, PIPELINE_REG_ELEMENT, 0, 0
+pipeline_emit_done:
+    ret
+
+pipeline_emit_zip:
+    mov x27, x21
+    PIPELINE_OP INTERP_OP_NEXT, PIPELINE_REG_ZIP, pipeline_reg_zip_element, 0
+    PIPELINE_OP INTERP_OP_TUPLE, PIPELINE_REG_TEST, 0, 2
+    PIPELINE_OP INTERP_OP_SETEL, PIPELINE_REG_TEST, PIPELINE_REG_ELEMENT, 0
+    PIPELINE_OP INTERP_OP_SETEL, PIPELINE_REG_TEST, pipeline_reg_zip_element, 1
+    PIPELINE_OP INTERP_OP_MOVE, PIPELINE_REG_ELEMENT, PIPELINE_REG_TEST, 0
+    ret
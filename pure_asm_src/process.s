@@ -50,6 +50,8 @@
 // provides the same functionality while being compatible with macOS security policies.
     .extern _mmap
     .extern _munmap
+    .extern _trace_record
+    .extern _perf_phase
 
 // ------------------------------------------------------------
 // Process Control Block Function Exports
@@ -151,6 +153,10 @@
     .global _pcb_blocking_data_offset
     .global _pcb_wake_time_offset
     .global _pcb_message_pattern_offset
+    .global _pcb_total_reductions_offset
+    .global _pcb_cpu_ticks_offset
+    .global _pcb_dispatch_count_offset
+    .global _pcb_block_counts_offset
     .global _pcb_size_offset
 
 // ------------------------------------------------------------
@@ -174,6 +180,13 @@
     .equ STACK_POOL_SIZE, 256          // Number of stacks in pool
     .equ HEAP_POOL_SIZE, 1024          // Number of heap blocks in pool
 
+    // mmap flags, and the trace and perf constants used by
+    // process_collect_garbage
+    .include "config.inc"
+
+    // Scheduler state offsets (shared with scheduler.s)
+    .include "scheduler_state.inc"
+
 // ------------------------------------------------------------
 // Global Constant Symbol Exports
 // ------------------------------------------------------------
@@ -201,6 +214,11 @@
     .global _STACK_POOL_SIZE
     .global _HEAP_POOL_SIZE
     .global _PCB_SIZE
+    .global _PCB_SIZE_CONST
+    .global _PCB_PID_OFFSET_CONST
+    .global _PCB_SCHEDULER_ID_OFFSET_CONST
+    .global _PCB_HEAP_POINTER_OFFSET_CONST
+    .global _PCB_HEAP_LIMIT_OFFSET_CONST
     .global _PROCESS_STATE_CREATED
     .global _PROCESS_STATE_READY
     .global _PROCESS_STATE_RUNNING
@@ -323,48 +341,14 @@ PCB_SIZE:
 // ------------------------------------------------------------
 // Process Control Block Memory Layout Offset Definitions
 // ------------------------------------------------------------
-// Define byte offsets for accessing fields within the PCB structure.
-// These offsets are used throughout the assembly code to access
-// specific fields within the PCB memory layout. The offsets are
-// calculated based on the size and alignment of each field type.
+// Byte offsets for the fields of the PCB, shared with every file
+// that touches a PCB (pcb.inc).
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-    // PCB structure field offsets
-    .equ pcb_next, 0                   // Next pointer in queue (8 bytes)
-    .equ pcb_prev, 8                   // Previous pointer in queue (8 bytes)
-    .equ pcb_pid, 16                   // Process ID (8 bytes)
-    .equ pcb_scheduler_id, 24          // Scheduler ID (affinity) (8 bytes)
-    .equ pcb_state, 32                 // Process state (8 bytes)
-    .equ pcb_priority, 40              // Priority level (8 bytes)
-    .equ pcb_reduction_count, 48       // Reduction counter (8 bytes)
-    .equ pcb_registers, 56             // x0-x30 register save area (31 * 8 = 248 bytes)
-    .equ pcb_sp, 304                   // Stack pointer (8 bytes)
-    .equ pcb_lr, 312                   // Link register (8 bytes)
-    .equ pcb_pc, 320                   // Program counter (8 bytes)
-    .equ pcb_pstate, 328               // Processor state (8 bytes)
-    .equ pcb_stack_base, 336           // Stack base address (8 bytes)
-    .equ pcb_stack_size, 344           // Stack size (8 bytes)
-    .equ pcb_heap_base, 352            // Heap base address (8 bytes)
-    .equ pcb_heap_size, 360            // Heap size (8 bytes)
-    .equ pcb_message_queue, 368        // Message queue pointer (8 bytes)
-    .equ pcb_last_scheduled, 376       // Last scheduled timestamp (8 bytes)
-    .equ pcb_affinity_mask, 384        // CPU affinity mask (8 bytes)
-    .equ pcb_migration_count, 392      // Migration count (8 bytes)
-    .equ pcb_last_migration_time, 400   // Last migration timestamp (8 bytes)
-    .equ pcb_stack_pointer, 408        // Current stack pointer (bump allocator) (8 bytes)
-    .equ pcb_stack_limit, 416          // Stack limit (8 bytes)
-    .equ pcb_heap_pointer, 424         // Current heap pointer (bump allocator) (8 bytes)
-    .equ pcb_heap_limit, 432           // Heap limit (8 bytes)
-    .equ pcb_blocking_reason, 440      // Blocking reason code (8 bytes)
-    .equ pcb_blocking_data, 448         // Blocking-specific data (8 bytes)
-    .equ pcb_wake_time, 456            // Timer wake time (8 bytes)
-    .equ pcb_message_pattern, 464      // Receive pattern (8 bytes)
-    .equ pcb_size, 472                 // Total PCB size (8 bytes)
-    .equ pcb_padding, 464              // Padding to align to 512 bytes
-    .equ pcb_total_size, 512           // Total PCB size with padding
+    .include "pcb.inc"
 
 // ------------------------------------------------------------
 // Exported Offset Constant Mappings
@@ -410,8 +394,40 @@ PCB_SIZE:
     .equ _pcb_blocking_data_offset, pcb_blocking_data
     .equ _pcb_wake_time_offset, pcb_wake_time
     .equ _pcb_message_pattern_offset, pcb_message_pattern
+    .equ _pcb_total_reductions_offset, pcb_total_reductions
+    .equ _pcb_cpu_ticks_offset, pcb_cpu_ticks
+    .equ _pcb_dispatch_count_offset, pcb_dispatch_count
+    .equ _pcb_block_counts_offset, pcb_block_counts
     .equ _pcb_size_offset, pcb_size
 
+// ------------------------------------------------------------
+// Constant Definitions for C Code
+// ------------------------------------------------------------
+// PCB size and field offsets as data, taken from pcb.inc, for C code
+// that lays out or reads PCBs itself (the benchmarks).
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .data
+    .align 3
+
+_PCB_SIZE_CONST:
+    .quad pcb_size
+
+_PCB_PID_OFFSET_CONST:
+    .quad pcb_pid
+
+_PCB_SCHEDULER_ID_OFFSET_CONST:
+    .quad pcb_scheduler_id
+
+_PCB_HEAP_POINTER_OFFSET_CONST:
+    .quad pcb_heap_pointer
+
+_PCB_HEAP_LIMIT_OFFSET_CONST:
+    .quad pcb_heap_limit
+
 // ------------------------------------------------------------
 // Global Process Management Data Structures
 // ------------------------------------------------------------
@@ -628,7 +644,9 @@ create_success:
 // Destroy a process by freeing its PCB, stack, and heap memory
 // back to their respective pools. This function performs complete
 // cleanup of all process resources and should be called when a
-// process terminates or is forcefully destroyed.
+// process terminates or is forcefully destroyed. Timers holding the
+// PCB must be cancelled first (_process_cancel_timeout for a pending
+// timed block), as a timer firing later would write into the freed PCB.
 //
 // Parameters:
 //   x0 (void*) - pcb: Pointer to the PCB to destroy
@@ -1369,6 +1387,102 @@ gc_failed:
     ldp x19, x30, [sp], #16
     ret
 
+// ------------------------------------------------------------
+// process_collect_garbage — Collect a process's memory on a scheduler
+// ------------------------------------------------------------
+// Scheduler-side entry point for garbage collection. Runs
+// trigger_garbage_collection on the PCB and, when the GC trace class is
+// enabled on the core, brackets it with GC_START (heap bytes in use) and
+// GC_END (heap bytes reclaimed) events in the core's trace ring.
+// When the core counts hardware events (perf.s) the collection is
+// counted as the GC phase, then the interrupted phase resumes.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Base of the per-core scheduler states
+//   x1 (uint64_t) - core_id: Core the collection runs on
+//   x2 (void*) - pcb: Pointer to the PCB whose memory should be collected
+//
+// Returns:
+//   x0 (int) - success: 1 if GC ran, 0 if the PCB or core was invalid
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x0-x18
+    .global _process_collect_garbage
+_process_collect_garbage:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+
+    cbz x2, collect_garbage_failed
+    cmp x1, #MAX_CORES
+    b.hs collect_garbage_failed
+    mov x3, #scheduler_size
+    madd x19, x1, x3, x0  // this core's scheduler state
+    mov x20, x2  // pcb
+
+    // Heap bytes in use before collection
+    ldr x3, [x20, #pcb_heap_pointer]
+    ldr x4, [x20, #pcb_heap_base]
+    sub x21, x3, x4
+
+    mov x22, #-1  // phase to resume, or -1 when not counting
+    ldr x0, [x19, #scheduler_perf]
+    cmp x0, #1
+    b.ls collect_garbage_traced
+    mov x1, #PERF_PHASE_GC
+    bl _perf_phase
+    mov x22, x0
+
+collect_garbage_traced:
+    ldr w5, [x19, #scheduler_trace_mask]
+    tbz w5, #TRACE_CLASS_GC, collect_garbage_run
+    mov x0, x19
+    mov x1, #TRACE_EVENT_GC_START
+    ldr x2, [x20, #pcb_pid]
+    mov x3, x21
+    bl _trace_record
+
+collect_garbage_run:
+    mov x0, x20
+    bl _trigger_garbage_collection
+
+    ldr w5, [x19, #scheduler_trace_mask]
+    tbz w5, #TRACE_CLASS_GC, collect_garbage_done
+    // Reclaimed = in use before - in use after
+    ldr x3, [x20, #pcb_heap_pointer]
+    ldr x4, [x20, #pcb_heap_base]
+    sub x3, x3, x4
+    sub x3, x21, x3
+    mov x0, x19
+    mov x1, #TRACE_EVENT_GC_END
+    ldr x2, [x20, #pcb_pid]
+    bl _trace_record
+
+collect_garbage_done:
+    tbnz x22, #63, collect_garbage_counted
+    ldr x0, [x19, #scheduler_perf]
+    mov x1, x22
+    bl _perf_phase
+
+collect_garbage_counted:
+    mov x0, #1
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+collect_garbage_failed:
+    mov x0, #0
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
 
 // ------------------------------------------------------------
 // expand_memory_pool — Expand memory pool (BEAM-style with real mmap)
@@ -1453,7 +1567,7 @@ _expand_memory_pool:
     mov x0, xzr                      // addr = NULL (let system choose)
     mov x1, x24                      // length = total_bytes needed
     mov x2, #3                       // prot = PROT_READ | PROT_WRITE
-    mov x3, #0x1002                 // flags = MAP_PRIVATE | MAP_ANON (macOS)
+    mov x3, #MMAP_PRIVATE_ANON  // flags = MAP_PRIVATE | MAP_ANON
     mov x4, #-1                      // fd = -1 (not a file mapping)
     mov x5, xzr                      // offset = 0
     
@@ -1562,7 +1676,7 @@ expand_pool_mmap_failed:
     mov x0, xzr                      // addr = NULL
     mov x1, x24                      // length = smaller size
     mov x2, #3                       // prot = PROT_READ | PROT_WRITE
-    mov x3, #0x1002                 // flags = MAP_PRIVATE | MAP_ANON (macOS)
+    mov x3, #MMAP_PRIVATE_ANON  // flags = MAP_PRIVATE | MAP_ANON
     mov x4, #-1                      // fd = -1
     mov x5, xzr                      // offset = 0
     bl _mmap                         // Call mmap C library function (avoids macOS system call blocking)
@@ -1881,7 +1995,7 @@ _allocate_pcb:
     mov x0, xzr                      // addr = NULL (let system choose)
     mov x1, x19                      // length = 512 bytes
     mov x2, #3                       // prot = PROT_READ | PROT_WRITE
-    mov x3, #0x1002                 // flags = MAP_PRIVATE | MAP_ANON (macOS)
+    mov x3, #MMAP_PRIVATE_ANON  // flags = MAP_PRIVATE | MAP_ANON
     mov x4, #-1                      // fd = -1 (not a file mapping)
     mov x5, xzr                      // offset = 0
     bl _mmap                         // Call mmap C library function (avoids macOS system call blocking)
@@ -0,0 +1,273 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// profile.s — Per-Process CPU and Reduction Profiling
+// ------------------------------------------------------------
+// Answers "which actors eat the CPU". Every PCB accumulates, across
+// all of its slices:
+//
+//   pcb_total_reductions - reductions consumed (charged at switch-out)
+//   pcb_cpu_ticks        - CNTVCT_EL0 ticks between dispatch and switch-out
+//   pcb_dispatch_count   - times scheduled
+//   pcb_block_counts     - blocks per REASON_* (32-bit counters)
+//
+// The scheduler maintains these at context switch (_scheduler_schedule,
+// _scheduler_deschedule) and in _process_block; this file reads them.
+// There is no global process table, so queries take the caller's array
+// of PCB pointers. Sampled PCs for per-actor flame graphs come from
+// TRACE_CLASS_SAMPLE in trace.s.
+//
+// The file provides:
+//   - Reading one metric of one process
+//   - Resetting a process's counters
+//   - Top-K processes by any metric
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// ------------------------------------------------------------
+// Profile Function Exports
+// ------------------------------------------------------------
+// Export the profiling functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _profile_get
+    .global _profile_reset
+    .global _profile_top_k
+
+    // PCB profiling fields (pcb.inc): total_reductions, cpu_ticks and
+    // dispatch_count, then block_counts (4 * 4 bytes, indexed by REASON_*)
+    .include "pcb.inc"
+    .equ pcb_profile_end, pcb_size
+
+// ------------------------------------------------------------
+// Profile Get
+// ------------------------------------------------------------
+// Read one profiling metric of a process.
+//
+// Parameters:
+//   x0 (void*) - pcb: Process Control Block pointer
+//   x1 (uint64_t) - metric: PROFILE_METRIC_*
+//
+// Returns:
+//   x0 (uint64_t) - value: The metric, or 0 for a NULL PCB or unknown metric
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_profile_get:
+    cbz x0, profile_metric_none
+    // Fall through into profile_metric
+
+// ------------------------------------------------------------
+// Profile Metric (internal)
+// ------------------------------------------------------------
+// Metric lookup shared by _profile_get and _profile_top_k.
+// The three 64-bit counters are consecutive, so metrics 0-2 index
+// them directly; the block metrics index the per-reason counters.
+//
+// Parameters:
+//   x0 (void*) - pcb: Process Control Block pointer (non-NULL)
+//   x1 (uint64_t) - metric: PROFILE_METRIC_*
+//
+// Returns:
+//   x0 (uint64_t) - value: The metric, or 0 for an unknown metric
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x1-x6
+//
+profile_metric:
+    cmp x1, #PROFILE_METRIC_BLOCKS
+    b.lo profile_metric_counter
+    b.eq profile_metric_blocks
+    cmp x1, #PROFILE_METRIC_COUNT
+    b.hs profile_metric_none
+
+    // Blocks for one reason: metric - PROFILE_METRIC_BLOCKS = REASON_*
+    sub x1, x1, #PROFILE_METRIC_BLOCKS
+    add x2, x0, #pcb_block_counts
+    ldr w0, [x2, x1, lsl #2]
+    ret
+
+profile_metric_counter:
+    add x2, x0, #pcb_total_reductions
+    ldr x0, [x2, x1, lsl #3]
+    ret
+
+profile_metric_blocks:
+    // Every reason (the REASON_NONE slot stays zero)
+    add x2, x0, #pcb_block_counts
+    ldp w3, w4, [x2]
+    ldp w5, w6, [x2, #8]
+    add x3, x3, x4
+    add x5, x5, x6
+    add x0, x3, x5
+    ret
+
+profile_metric_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Profile Reset
+// ------------------------------------------------------------
+// Zero a process's profiling counters, e.g. to start a new
+// measurement window.
+//
+// Parameters:
+//   x0 (void*) - pcb: Process Control Block pointer
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 for a NULL PCB
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_profile_reset:
+    cbz x0, profile_metric_none
+    add x1, x0, #pcb_total_reductions
+    stp xzr, xzr, [x1]                // total_reductions, cpu_ticks
+    stp xzr, xzr, [x1, #16]           // dispatch_count, block_counts[0-1]
+    str xzr, [x1, #pcb_profile_end - pcb_total_reductions - 8] // block_counts[2-3]
+    mov x0, #1
+    ret
+
+// ------------------------------------------------------------
+// Profile Top K
+// ------------------------------------------------------------
+// Select the k processes with the largest value of one metric from
+// the caller's PCB array, largest first. NULL entries are skipped.
+// Ties keep array order. Insertion into the bounded result, so the
+// cost is O(n) for small k.
+//
+// Parameters:
+//   x0 (void**) - pcbs: Array of PCB pointers
+//   x1 (uint64_t) - count: Entries in pcbs
+//   x2 (uint64_t) - metric: PROFILE_METRIC_*
+//   x3 (uint64_t) - k: Results wanted
+//   x4 (void**) - out: Receives up to k PCB pointers
+//
+// Returns:
+//   x0 (uint64_t) - found: PCB pointers written to out (min(k, non-NULL
+//                   entries)), 0 on invalid arguments
+//
+// Complexity: O(n * k) worst case
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x1-x15
+//
+_profile_top_k:
+    cbz x0, profile_metric_none
+    cbz x3, profile_metric_none
+    cbz x4, profile_metric_none
+    cmp x2, #PROFILE_METRIC_COUNT
+    b.hs profile_metric_none
+
+    stp x19, x30, [sp, #-16]!
+    mov x9, x0   // pcbs
+    mov x10, x1  // count
+    mov x11, x2  // metric
+    mov x12, x3  // k
+    mov x13, x4  // out
+    mov x14, #0  // results so far
+    mov x15, #0  // next input index
+
+top_k_next:
+    cmp x15, x10
+    b.hs top_k_done
+    ldr x7, [x9, x15, lsl #3]  // candidate
+    add x15, x15, #1
+    cbz x7, top_k_next
+    mov x0, x7
+    mov x1, x11
+    bl profile_metric
+    mov x19, x0  // candidate value
+
+    // Room left: insert from the end. Full: it must beat the smallest,
+    // which it then replaces
+    mov x8, x14  // insertion slot
+    cmp x14, x12
+    b.lo top_k_shift
+    sub x8, x12, #1
+    ldr x0, [x13, x8, lsl #3]
+    mov x1, x11
+    bl profile_metric
+    cmp x19, x0
+    b.ls top_k_next
+
+top_k_shift:
+    // Move smaller results down one slot
+    cbz x8, top_k_place
+    sub x0, x8, #1
+    ldr x0, [x13, x0, lsl #3]
+    mov x1, x11
+    bl profile_metric
+    cmp x0, x19
+    b.hs top_k_place
+    sub x0, x8, #1
+    ldr x1, [x13, x0, lsl #3]
+    str x1, [x13, x8, lsl #3]
+    mov x8, x0
+    b top_k_shift
+
+top_k_place:
+    str x7, [x13, x8, lsl #3]
+    cmp x14, x12
+    b.hs top_k_next
+    add x14, x14, #1
+    b top_k_next
+
+top_k_done:
+    mov x0, x14
+    ldp x19, x30, [sp], #16
+    ret
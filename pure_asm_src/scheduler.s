@@ -43,8 +43,26 @@
     .text
     .align 4
 
+// Include configuration constants
+    .include "config.inc"
+
 // External work stealing functions from loadbalancer.s
     .extern _try_steal_work
+    .extern _serve_steal_request
+
+// External timer functions from timer.s
+    .extern _timer_wheel_tick
+
+// External idle functions from idle.s
+    .extern _scheduler_idle_sleep
+    .extern _scheduler_wake
+
+// External trace functions from trace.s
+    .extern _trace_record
+
+// External perf counter functions from perf.s
+    .extern _perf_open
+    .extern _perf_phase
 
 // External C library functions for memory management
 // Note: These C library functions are used instead of direct system calls
@@ -73,8 +91,10 @@
 //
     .global _scheduler_init
     .global _scheduler_schedule
+    .global _scheduler_deschedule
     .global _scheduler_idle
     .global _scheduler_enqueue_process
+    .global _scheduler_inject_process
     .global _scheduler_dequeue_process
     .global _scheduler_get_current_process
     .global _scheduler_set_current_process
@@ -88,6 +108,11 @@
     .global _scheduler_state_destroy
     .global _scheduler_get_current_process_with_state
     .global _scheduler_set_current_process_with_state
+    .global _scheduler_refresh_now
+    .global _scheduler_get_cached_now
+    .global _scheduler_run_pass
+    .global _scheduler_core_start
+    .global _scheduler_request_stop
 
 // Additional exports for compatibility with existing tests
     .global _MAX_CORES
@@ -105,6 +130,10 @@
     .global _NUM_PRIORITIES_CONST
     .global _PRIORITY_QUEUE_SIZE_CONST
     .global _SCHEDULER_SIZE_CONST
+    .global _SCHEDULER_QUEUES_OFFSET_CONST
+    .global _SCHEDULER_TOTAL_SCHEDULED_OFFSET_CONST
+    .global _SCHEDULER_TOTAL_MIGRATIONS_OFFSET_CONST
+    .global _SCHEDULER_TOTAL_STEALS_OFFSET_CONST
     // Work stealing constants
     .global _WORK_STEAL_ENABLED
     .global _MIN_STEAL_QUEUE_SIZE
@@ -141,6 +170,9 @@
     .equ PROCESS_STATE_SUSPENDED, 4      // Process temporarily suspended
     .equ PROCESS_STATE_TERMINATED, 5     // Process finished execution
 
+// PCB fields, including the profiling counters (shared with process.s)
+    .include "pcb.inc"
+
 // ------------------------------------------------------------
 // Global Symbol Definitions for C Compatibility
 // ------------------------------------------------------------
@@ -193,20 +225,32 @@ _PRIORITY_QUEUE_SIZE:
     .quad queue_size
 
 _SCHEDULER_SIZE:
-    .quad 248  // Updated scheduler size with waiting queues
+    .quad scheduler_size
 
 // Non-underscore versions for C compatibility (as data symbols)
 _MAX_CORES_CONST:
-    .quad 128  // MAX_CORES value
+    .quad MAX_CORES
 
 _NUM_PRIORITIES_CONST:
-    .quad 4    // PRIORITY_LEVELS value
+    .quad PRIORITY_LEVELS
 
 _PRIORITY_QUEUE_SIZE_CONST:
-    .quad 24   // queue_size value
+    .quad queue_size      // scheduler_state.inc
 
 _SCHEDULER_SIZE_CONST:
-    .quad 248  // Updated scheduler size with waiting queues
+    .quad scheduler_size  // scheduler_state.inc
+
+_SCHEDULER_QUEUES_OFFSET_CONST:
+    .quad scheduler_queues
+
+_SCHEDULER_TOTAL_SCHEDULED_OFFSET_CONST:
+    .quad scheduler_total_scheduled
+
+_SCHEDULER_TOTAL_MIGRATIONS_OFFSET_CONST:
+    .quad scheduler_total_migrations
+
+_SCHEDULER_TOTAL_STEALS_OFFSET_CONST:
+    .quad scheduler_total_steals
 
 // Work stealing constants
 _WORK_STEAL_ENABLED:
@@ -229,38 +273,16 @@ _scheduler_get_queue_length_compat:
 // ------------------------------------------------------------
 // Scheduler Data Structure Layout
 // ------------------------------------------------------------
-// Define the memory layout for the scheduler state structure.
 // Each core has its own scheduler instance with independent
-// priority queues and state management.
+// priority queues and state management. The layout is defined once in
+// scheduler_state.inc and shared with every file that touches a
+// scheduler state.
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-    // Priority queue structure offsets
-    .equ queue_head, 0                   // Head pointer (8 bytes)
-    .equ queue_tail, 8                   // Tail pointer (8 bytes)
-    .equ queue_count, 16                 // Process count (4 bytes)
-    .equ queue_padding, 20               // Padding to 8-byte alignment
-    .equ queue_size, 24                  // Total queue structure size
-
-    // Scheduler state structure offsets
-    .equ scheduler_core_id, 0            // Core ID (8 bytes)
-    .equ scheduler_queues, 8             // Priority queues array (4 * 24 = 96 bytes)
-    .equ scheduler_current_process, 104  // Current running process (8 bytes)
-    .equ scheduler_current_reductions, 112 // Current reduction count (8 bytes)
-    .equ scheduler_total_scheduled, 120  // Total processes scheduled (8 bytes)
-    .equ scheduler_total_yields, 128     // Total voluntary yields (8 bytes)
-    .equ scheduler_total_migrations, 136 // Total process migrations (8 bytes)
-    .equ scheduler_idle_count, 144       // Idle loop count (8 bytes)
-    .equ scheduler_waiting_receive, 152  // Receive waiting queue (24 bytes)
-    .equ scheduler_waiting_timer, 176    // Timer waiting queue (24 bytes)
-    .equ scheduler_waiting_io, 200       // I/O waiting queue (24 bytes)
-    .equ scheduler_total_blocks, 224     // Total blocks (8 bytes)
-    .equ scheduler_total_wakes, 232      // Total wakes (8 bytes)
-    .equ scheduler_total_steals, 240     // Total work steals (8 bytes)
-    .equ scheduler_padding, 248          // No padding needed
-    .equ scheduler_size, 248             // Total scheduler state size
+    .include "scheduler_state.inc"
 
 // ------------------------------------------------------------
 // Global Scheduler Data
@@ -316,6 +338,8 @@ _scheduler_init:
     // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
     
     // DEBUG: Add parameter validation
     cbz x0, scheduler_init_failed  // Check scheduler_states pointer
@@ -375,6 +399,9 @@ init_queue_loop:
     str xzr, [x21, #scheduler_idle_count]
     str xzr, [x21, #scheduler_total_blocks]
     str xzr, [x21, #scheduler_total_wakes]
+    str xzr, [x21, #scheduler_total_steals]
+    str xzr, [x21, #scheduler_steal_attempts]
+    str wzr, [x21, #scheduler_steal_request]
 
     // Initialize waiting queues
     // Receive waiting queue
@@ -398,11 +425,15 @@ init_queue_loop:
     // Core ID is now passed as parameter, no need to store globally
 
     // Return (void function)
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
 scheduler_init_failed:
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
@@ -418,6 +449,11 @@ scheduler_init_stack_error:
 // Select the next process to run from the highest priority non-empty queue.
 // Implements strict priority scheduling with round-robin within each priority level.
 // This is the core scheduling algorithm that determines which process runs next.
+// The previous current process is charged for its slice (see
+// scheduler_charge_current) and the selected one is stamped with the
+// dispatch time and its dispatch count incremented.
+// With TRACE_CLASS_SCHEDULE enabled, records SCHED_OUT for the previous
+// current process and SCHED_IN for the selected one.
 //
 // Parameters:
 //   x0 (void*) - scheduler_states: Pointer to scheduler states array
@@ -495,6 +531,31 @@ schedule_decrement_count:
     str xzr, [x25, #0]   // Clear next pointer
     str xzr, [x25, #8]   // Clear prev pointer
 
+    // Profile: charge the outgoing process, start the incoming one's clock
+    mov x0, x20
+    bl scheduler_charge_current
+    str x1, [x25, #pcb_last_scheduled]
+    ldr x26, [x25, #pcb_dispatch_count]
+    add x26, x26, #1
+    str x26, [x25, #pcb_dispatch_count]
+
+    // Trace: the previous process leaves the core, this one enters
+    ldr w26, [x20, #scheduler_trace_mask]
+    tbz w26, #TRACE_CLASS_SCHEDULE, schedule_trace_done
+    mov x0, x20
+    ldr x27, [x20, #scheduler_current_process]
+    cbz x27, schedule_trace_in
+    mov x1, #TRACE_EVENT_SCHED_OUT
+    ldr x2, [x27, #16]   // pcb_pid
+    ldr x3, [x27, #32]   // pcb_state
+    bl _trace_record
+schedule_trace_in:
+    mov x1, #TRACE_EVENT_SCHED_IN
+    ldr x2, [x25, #16]   // pcb_pid
+    mov x3, x21          // priority
+    bl _trace_record
+schedule_trace_done:
+
     // Set process state to RUNNING
     mov w26, #PROCESS_STATE_RUNNING
     str w26, [x25, #32]  // Set state (offset 32 = pcb_state)
@@ -502,9 +563,10 @@ schedule_decrement_count:
     // Set as current process
     str x25, [x20, #scheduler_current_process]
 
-    // Set reduction count to default
-    mov w26, #2000  // DEFAULT_REDUCTIONS
-    str w26, [x20, #scheduler_current_reductions]
+    // Set reduction count to default (full 64-bit field: the slice
+    // charge reads it back as DEFAULT_REDUCTIONS - remaining)
+    mov x26, #2000  // DEFAULT_REDUCTIONS
+    str x26, [x20, #scheduler_current_reductions]
 
     // Increment total scheduled count
     ldr x26, [x20, #scheduler_total_scheduled]
@@ -553,24 +615,145 @@ schedule_invalid_core:
     ldp x19, x20, [sp], #16
     ret
 
+// ------------------------------------------------------------
+// Scheduler Deschedule Function
+// ------------------------------------------------------------
+// Take the current process off the core without choosing another:
+// charge it for its slice, record SCHED_OUT when TRACE_CLASS_SCHEDULE
+// is enabled, and clear the current process. Call when the process has
+// finished its slice (yielded, blocked or exited) and the core may sit
+// idle or run other work, so idle time is not charged to it.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (void*) - process: The process taken off the core, or NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x1-x4, x9-x13
+//
+_scheduler_deschedule:
+    stp x19, x30, [sp, #-16]!
+
+    cmp x1, #MAX_CORES
+    b.hs deschedule_none
+    mov x2, #scheduler_size
+    madd x19, x1, x2, x0  // x19 = scheduler state address
+    ldr x2, [x19, #scheduler_current_process]
+    cbz x2, deschedule_none
+
+    mov x0, x19
+    bl scheduler_charge_current
+
+    ldr w3, [x19, #scheduler_trace_mask]
+    tbz w3, #TRACE_CLASS_SCHEDULE, deschedule_clear
+    mov x0, x19
+    mov x1, #TRACE_EVENT_SCHED_OUT
+    ldr x4, [x19, #scheduler_current_process]
+    ldr x2, [x4, #16]   // pcb_pid
+    ldr x3, [x4, #pcb_state]
+    bl _trace_record
+
+deschedule_clear:
+    ldr x0, [x19, #scheduler_current_process]
+    str xzr, [x19, #scheduler_current_process]
+    ldp x19, x30, [sp], #16
+    ret
+
+deschedule_none:
+    mov x0, #0
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Scheduler Charge Current (internal)
+// ------------------------------------------------------------
+// Charge the scheduler's current process for the slice that is ending:
+// counter ticks since it was dispatched go to pcb_cpu_ticks and the
+// reductions used from its DEFAULT_REDUCTIONS budget to
+// pcb_total_reductions. Terminated processes, and processes whose
+// dispatch stamp was reset (by migration), are not charged ticks.
+//
+// Parameters:
+//   x0 (void*) - scheduler_state: This scheduler's state (not the array)
+//
+// Under virtual time (sim.s) "now" is the scheduler's cached_now.
+//
+// Returns:
+//   x1 (uint64_t) - now: CNTVCT_EL0 ticks, to stamp the next process
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x2-x4
+//
+scheduler_charge_current:
+    ldr w2, [x0, #scheduler_flags]
+    tbnz w2, #SCHEDULER_FLAG_VIRTUAL_TIME, charge_current_virtual
+    mrs x1, cntvct_el0
+    b charge_current_process
+charge_current_virtual:
+    ldr x1, [x0, #scheduler_cached_now]
+charge_current_process:
+    ldr x2, [x0, #scheduler_current_process]
+    cbz x2, charge_current_done
+    ldr w3, [x2, #pcb_state]
+    cmp w3, #PROCESS_STATE_TERMINATED
+    b.eq charge_current_done
+
+    ldr x3, [x2, #pcb_last_scheduled]
+    cbz x3, charge_current_reductions
+    subs x3, x1, x3
+    b.lo charge_current_reductions
+    ldr x4, [x2, #pcb_cpu_ticks]
+    add x4, x4, x3
+    str x4, [x2, #pcb_cpu_ticks]
+
+charge_current_reductions:
+    // Budget minus what is left; nothing if the budget was raised
+    ldr x3, [x0, #scheduler_current_reductions]
+    mov x4, #2000  // DEFAULT_REDUCTIONS
+    subs x3, x4, x3
+    csel x3, x3, xzr, hs
+    ldr x4, [x2, #pcb_total_reductions]
+    add x4, x4, x3
+    str x4, [x2, #pcb_total_reductions]
+
+charge_current_done:
+    ret
+
 // ------------------------------------------------------------
 // Scheduler Idle Function
 // ------------------------------------------------------------
 // Handle idle core scenario when no processes are ready to run.
-// Attempts work stealing from other schedulers before going idle.
-// Implements Phase 4 work stealing load balancing.
+// Counts the idle pass and asks the busiest other scheduler for work
+// (_try_steal_work). Run queues belong to their scheduler, so nothing
+// is taken here: the victim hands a process over at the end of its
+// next pass and it arrives through this core's timer inbox, waking
+// this core if it has gone to sleep.
 //
 // Parameters:
-//   x0 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
 //
 // Returns:
-//   x0 (void*) - process: Stolen process pointer, or NULL if no work available
+//   x0 (void*) - process: Always NULL (stolen work arrives later)
 //
 // Complexity: O(n) where n is number of cores (for victim selection)
 //
-// Version: 0.11 (Phase 4 work stealing integration)
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 // Clobbers: x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16, x17, x18, x19, x20, x21, x22, x23, x24, x25, x26, x27, x28, x29, x30
 //
@@ -578,6 +761,7 @@ _scheduler_idle:
     // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
 
     // Save parameters
     mov x19, x0  // scheduler_states pointer
@@ -593,22 +777,13 @@ _scheduler_idle:
     add x22, x22, #1
     str x22, [x21, #scheduler_idle_count]
 
-    // Attempt work stealing
+    // Ask for work
     mov x0, x19  // Pass scheduler_states pointer
     mov x1, x20  // Pass core ID
     bl _try_steal_work
 
-    // Check if we stole work
-    cbz x0, idle_no_work
-
-    // Successfully stole work
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
-    ret
-
-idle_no_work:
-    // No work available, return NULL
     mov x0, #0
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
@@ -620,6 +795,9 @@ idle_no_work:
 // added to the tail of the queue for round-robin scheduling within
 // the priority level.
 //
+// The run queues are not locked, so only the scheduler's own thread
+// may call this. Other threads use _scheduler_inject_process.
+//
 // Parameters:
 //   x0 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
 //   x1 (void*) - process: Process pointer (PCB)
@@ -640,6 +818,8 @@ _scheduler_enqueue_process:
     // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
 
     // Validate parameters
     cbz x2, enqueue_failed  // Check process pointer (now in x2)
@@ -674,6 +854,7 @@ _scheduler_enqueue_process:
     // Queue is not empty, add to tail
     str x21, [x25, #0]   // Set next pointer of current tail (use process pointer from x21)
     str x25, [x21, #8]   // Set prev pointer of new process (use process pointer from x21)
+    str xzr, [x21, #0]   // Clear stale next pointer so dequeue sees the new tail
     str x21, [x24, #queue_tail]  // Update queue tail (use process pointer from x21)
     b enqueue_increment_count
 
@@ -692,16 +873,148 @@ enqueue_increment_count:
 
     // Return success
     mov x0, #1
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
 enqueue_failed:
     mov x0, #0
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
+// ------------------------------------------------------------
+// Scheduler Inject Process
+// ------------------------------------------------------------
+// Hand a process to a scheduler from any thread: another scheduler,
+// or a host thread spawning work. The process is pushed lock-free onto
+// the target's inbox and re-homed there; the target moves it to the
+// tail of its run queue at the start of its next pass
+// (_scheduler_drain_inbox) and is woken if it is asleep.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Target scheduler (0 to MAX_CORES-1)
+//   x2 (void*) - process: Process pointer (PCB), not in any queue
+//   x3 (uint32_t) - priority: Priority level (0=MAX, 1=HIGH, 2=NORMAL, 3=LOW)
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 on failure
+//
+// Complexity: O(1) expected, retries only under contention
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_scheduler_inject_process:
+    cbz x0, inject_failed
+    cmp x1, #MAX_CORES
+    b.hs inject_failed
+    cbz x2, inject_failed
+    cmp x3, #PRIORITY_LEVELS
+    b.hs inject_failed
+
+    // The drain enqueues at the PCB's priority; timers follow the home core
+    str x3, [x2, #pcb_priority]
+    str x1, [x2, #pcb_scheduler_id]
+
+    mov x4, #scheduler_size
+    madd x4, x1, x4, x0
+    add x4, x4, #scheduler_inbox
+inject_push_retry:
+    ldr x5, [x4]
+    str x5, [x2, #pcb_next]
+    ldaxr x6, [x4]
+    cmp x6, x5
+    b.ne inject_push_changed
+    stlxr w7, x2, [x4]                // release publishes the PCB fields
+    cbnz w7, inject_push_retry
+
+    stp x19, x30, [sp, #-16]!
+    bl _scheduler_wake
+    mov x0, #1
+    ldp x19, x30, [sp], #16
+    ret
+
+inject_push_changed:
+    clrex
+    b inject_push_retry
+
+inject_failed:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Scheduler Drain Inbox (internal)
+// ------------------------------------------------------------
+// Take every process other threads injected into this scheduler
+// (_scheduler_inject_process) and enqueue it at its priority, in the
+// order it was injected. An empty inbox costs one load.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID of the calling scheduler
+//
+// Returns:
+//   None
+//
+// Complexity: O(k) where k is the number of injected processes
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_scheduler_drain_inbox:
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0
+    add x2, x2, #scheduler_inbox
+    ldr x3, [x2]
+    cbz x3, drain_inbox_empty
+
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0  // scheduler_states pointer
+    mov x20, x1  // core_id
+
+    // Detach the whole stack in one exchange
+drain_inbox_swap:
+    ldaxr x21, [x2]
+    stlxr w3, xzr, [x2]
+    cbnz w3, drain_inbox_swap
+
+    // The stack is newest first; reverse it into injection order
+    mov x3, #0
+drain_inbox_reverse:
+    cbz x21, drain_inbox_enqueue
+    ldr x4, [x21, #pcb_next]
+    str x3, [x21, #pcb_next]
+    mov x3, x21
+    mov x21, x4
+    b drain_inbox_reverse
+
+drain_inbox_enqueue:
+    mov x21, x3
+drain_inbox_loop:
+    cbz x21, drain_inbox_done
+    mov x2, x21
+    ldr x21, [x21, #pcb_next]         // the enqueue relinks pcb_next
+    ldr x3, [x2, #pcb_priority]
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_enqueue_process
+    b drain_inbox_loop
+
+drain_inbox_done:
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+drain_inbox_empty:
+    ret
+
 // ------------------------------------------------------------
 // Scheduler Dequeue Process
 // ------------------------------------------------------------
@@ -1278,6 +1591,11 @@ get_priority_queue:
 // ------------------------------------------------------------
 
 // scheduler_state_init — Allocate and initialize scheduler states
+// Anonymous mappings are zero-filled on first touch, so the states are
+// not cleared here: only the pages of schedulers that actually come
+// online are ever materialized, which keeps startup independent of
+// max_cores. Only max_cores itself is written, to state 0's
+// scheduler_count, which bounds victim scans (loadbalancer.s).
 // Parameters:
 //   x0: max_cores
 // Returns:
@@ -1302,7 +1620,7 @@ _scheduler_state_init:
     mov x0, xzr                      // addr = NULL (let system choose)
     mov x1, x20                     // length
     mov x2, #3                       // prot = PROT_READ | PROT_WRITE
-    mov x3, #0x1002                 // flags = MAP_PRIVATE | MAP_ANON (macOS)
+    mov x3, #MMAP_PRIVATE_ANON  // flags = MAP_PRIVATE | MAP_ANON
     mov x4, #-1                      // fd = -1 (not a file mapping)
     mov x5, xzr                      // offset = 0
     bl _mmap                         // Call mmap C library function (avoids macOS system call blocking)
@@ -1311,25 +1629,10 @@ _scheduler_state_init:
     cmp x0, #-1                      // mmap returns -1 on failure
     b.eq scheduler_state_init_failed // Handle allocation failure
 
-    // Save the pointer
-    mov x21, x0
-
-    // Zero out the allocated memory
-    mov x22, #0        // Current offset
-    mov x23, x20       // Total size
+    // Victim scans read the count from state 0, which always exists
+    str w19, [x0, #scheduler_count]
 
-zero_memory_loop:
-    cmp x22, x23
-    b.ge zero_memory_done
-    
-    // Store zero to current position
-    str xzr, [x21, x22]
-    add x22, x22, #8   // Move to next 8-byte word
-    b zero_memory_loop
-
-zero_memory_done:
-    // Return the pointer
-    mov x0, x21
+    // Return the pointer (already zero-filled by mmap)
     b scheduler_state_init_done
 
 scheduler_state_init_failed:
@@ -1436,50 +1739,397 @@ scheduler_set_current_done_with_state:
     ret
 
 // ------------------------------------------------------------
-// Scheduler Main Loop
+// Scheduler Refresh Now
 // ------------------------------------------------------------
-// Main scheduler loop that integrates all subsystems.
-// Processes timers, messages, scheduling, and load balancing.
+// Read the monotonic clock (CNTVCT_EL0) and store it as this
+// scheduler's coarse "now". Called once per main-loop iteration so
+// hot paths (timer arming, steal cooldowns, accounting) can use a
+// plain load instead of a serializing counter read. Under virtual time
+// (sim.s) the counter is not read and the simulated time is returned.
 //
 // Parameters:
-//   None
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
 //
 // Returns:
-//   None (infinite loop)
+//   x0 (uint64_t) - now: Fresh tick count, or 0 on invalid arguments
 //
-// Complexity: O(1) per iteration
+// Complexity: O(1) - One counter read and one store
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-    .global _scheduler_main_loop
-_scheduler_main_loop:
+_scheduler_refresh_now:
+    cbz x0, scheduler_refresh_now_failed
+    cmp x1, #MAX_CORES
+    b.ge scheduler_refresh_now_failed
+
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0  // x2 = scheduler state address
+
+    ldr w3, [x2, #scheduler_flags]
+    tbnz w3, #SCHEDULER_FLAG_VIRTUAL_TIME, scheduler_refresh_now_virtual
+    isb
+    mrs x0, CNTVCT_EL0
+    str x0, [x2, #scheduler_cached_now]
+    ret
+
+scheduler_refresh_now_virtual:
+    ldr x0, [x2, #scheduler_cached_now]
+    ret
+
+scheduler_refresh_now_failed:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Scheduler Get Cached Now
+// ------------------------------------------------------------
+// Return this scheduler's coarse "now" in clock ticks. The value is
+// at most one main-loop iteration old. If the scheduler has never
+// refreshed (e.g. before the main loop starts) the clock is read and
+// cached so callers never observe time zero.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (uint64_t) - now: Cached tick count, or 0 on invalid arguments
+//
+// Complexity: O(1) - Single load on the fast path
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_scheduler_get_cached_now:
+    cbz x0, scheduler_refresh_now_failed
+    cmp x1, #MAX_CORES
+    b.ge scheduler_refresh_now_failed
+
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0  // x2 = scheduler state address
+
+    ldr x3, [x2, #scheduler_cached_now]
+    cbz x3, _scheduler_refresh_now
+    mov x0, x3
+    ret
+
+// ------------------------------------------------------------
+// Scheduler Run Pass
+// ------------------------------------------------------------
+// One pass of the main loop without the idle sleep: refresh the
+// per-scheduler clock, expire timers, take processes other threads
+// have injected, process messages, dispatch the next process or,
+// with nothing runnable, deschedule and ask another scheduler for
+// work, then answer any steal request posted to this scheduler
+// (_check_load_balance). The main loop repeats this and
+// sleeps after passes that found no work; the simulator (sim.s) calls
+// it directly under virtual time.
+//
+// When hardware counters are open (perf.s) each phase boundary reads
+// them, so events land in the timer, message, dispatch or steal
+// phase. Without counters each boundary costs one load and a branch.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID of the scheduler
+//
+// Returns:
+//   x0 (void*) - process: PCB dispatched, or NULL if the scheduler
+//                found no work
+//
+// Complexity: O(n) in the number of cores when stealing, O(1) otherwise
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_scheduler_run_pass:
     // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
 
-scheduler_main_loop_iteration:
-    // Phase 1: Process timers
-    bl _timer_tick
+    mov x19, x0  // scheduler_states pointer
+    mov x20, x1  // core_id
+    mov x0, #scheduler_size
+    madd x21, x20, x0, x19  // this core's scheduler state
+
+    // Phase 0: Refresh coarse clock for this pass
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_refresh_now
+
+    // Phase 1: Expire this core's timer wheel
+    ldr x0, [x21, #scheduler_perf]
+    cmp x0, #1
+    b.ls run_pass_timers
+    mov x1, #PERF_PHASE_TIMER
+    bl _perf_phase
+run_pass_timers:
+    mov x0, x19
+    mov x1, x20
+    bl _timer_wheel_tick
 
     // Phase 2: Process messages
+    ldr x0, [x21, #scheduler_perf]
+    cmp x0, #1
+    b.ls run_pass_messages
+    mov x1, #PERF_PHASE_MESSAGE
+    bl _perf_phase
+run_pass_messages:
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_drain_inbox
     bl _process_messages
 
     // Phase 3: Schedule next process
+    ldr x0, [x21, #scheduler_perf]
+    cmp x0, #1
+    b.ls run_pass_dispatch
+    mov x1, #PERF_PHASE_DISPATCH
+    bl _perf_phase
+run_pass_dispatch:
+    mov x0, x19
+    mov x1, x20
     bl _scheduler_schedule
-
+    mov x22, x0
+    cbnz x22, run_pass_balance
+
+    // Phase 3b: Nothing runnable; the last process has left the core
+    // (so idle time is not charged to it). Try to steal
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_deschedule
+    ldr x0, [x21, #scheduler_perf]
+    cmp x0, #1
+    b.ls run_pass_steal
+    mov x1, #PERF_PHASE_STEAL
+    bl _perf_phase
+run_pass_steal:
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_idle
+    mov x22, x0
+
+run_pass_balance:
     // Phase 4: Check load balancing (periodic)
+    ldr x0, [x21, #scheduler_perf]
+    cmp x0, #1
+    b.ls run_pass_rebalance
+    mov x1, #PERF_PHASE_STEAL
+    bl _perf_phase
+run_pass_rebalance:
+    mov x0, x19
+    mov x1, x20
     bl _check_load_balance
 
-    // Continue loop
+    mov x0, x22
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Scheduler Main Loop
+// ------------------------------------------------------------
+// Main scheduler loop that integrates all subsystems. Repeats
+// _scheduler_run_pass (clock, timers, messages, scheduling, stealing
+// and load balancing). When a pass finds nothing runnable and nothing
+// to steal, the scheduler sleeps until its next timer deadline or a
+// remote wakeup (tickless idle, see idle.s). Runs until
+// _scheduler_request_stop is called for this core.
+//
+// When hardware counters have been requested (perf_request) the loop
+// opens them on this thread before the next pass. Idle sleep is not
+// counted.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID of the scheduler running this loop
+//
+// Returns:
+//   None (returns only once a stop has been requested)
+//
+// Complexity: O(1) per iteration
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _scheduler_main_loop
+_scheduler_main_loop:
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+
+    mov x19, x0  // scheduler_states pointer
+    mov x20, x1  // core_id
+    mov x0, #scheduler_size
+    madd x21, x20, x0, x19  // this core's scheduler state
+
+scheduler_main_loop_iteration:
+    // Leave the loop once a stop has been requested
+    add x0, x21, #scheduler_stop_requested
+    ldar w0, [x0]
+    cbnz w0, scheduler_main_loop_exit
+
+    // Open requested hardware counters on this thread
+    ldr x0, [x21, #scheduler_perf]
+    cmp x0, #1
+    b.ne scheduler_main_loop_pass
+    mov x0, x19
+    mov x1, x20
+    bl _perf_open
+
+scheduler_main_loop_pass:
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_run_pass
+    cbnz x0, scheduler_main_loop_iteration
+
+    // No work: sleep until the next timer deadline or a remote wakeup
+    ldr x0, [x21, #scheduler_perf]
+    cmp x0, #1
+    b.ls scheduler_main_loop_sleep
+    mov x1, #PERF_PHASE_NONE
+    bl _perf_phase
+scheduler_main_loop_sleep:
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_idle_sleep
     b scheduler_main_loop_iteration
 
-    // Should never reach here
+scheduler_main_loop_exit:
+    // Nothing after the loop is counted
+    ldr x0, [x21, #scheduler_perf]
+    cmp x0, #1
+    b.ls scheduler_main_loop_done
+    mov x1, #PERF_PHASE_NONE
+    bl _perf_phase
+scheduler_main_loop_done:
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Scheduler Core Start
+// ------------------------------------------------------------
+// Per-core bring-up shared by every way of starting a scheduler:
+// bare-metal cores (boot.s) and host scheduler threads (host.s).
+// Initializes this core's scheduler state, optionally queues an
+// initial process, primes the cached clock, then runs the main loop
+// on the calling thread until a stop is requested.
+//
+// Nothing else is set up eagerly: the timer wheel is created by the
+// first _timer_arm on this core and the states' pages are faulted in
+// by the first touch, so bring-up cost is a few stores per scheduler.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//   x2 (void*) - initial_process: PCB queued at NORMAL priority before
+//                the loop starts, or NULL
+//
+// Returns:
+//   x0 (int) - success: 1 after a requested stop, 0 if initialization failed
+//
+// Complexity: O(1) setup, then runs until stopped
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_scheduler_core_start:
+    cbz x0, scheduler_core_start_invalid
+    cmp x1, #MAX_CORES
+    b.hs scheduler_core_start_invalid
+
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+
+    mov x19, x0  // scheduler_states pointer
+    mov x20, x1  // core_id
+    mov x21, x2  // initial_process
+
+    bl _scheduler_init
+
+    cbz x21, scheduler_core_start_run
+    mov x0, x19
+    mov x1, x20
+    mov x2, x21
+    mov x3, #2  // PRIORITY_NORMAL
+    bl _scheduler_enqueue_process
+    cbz x0, scheduler_core_start_failed
+
+scheduler_core_start_run:
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_refresh_now
+
+    mov x0, x19
+    mov x1, x20
+    bl _scheduler_main_loop
+
+    mov x0, #1
+    b scheduler_core_start_done
+
+scheduler_core_start_failed:
+    mov x0, #0
+
+scheduler_core_start_done:
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
+scheduler_core_start_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Scheduler Request Stop
+// ------------------------------------------------------------
+// Ask a scheduler's main loop to return at its next iteration, waking
+// it if it is asleep. Safe to call from any thread.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 on invalid parameters
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_scheduler_request_stop:
+    cbz x0, scheduler_request_stop_invalid
+    cmp x1, #MAX_CORES
+    b.hs scheduler_request_stop_invalid
+
+    stp x19, x30, [sp, #-16]!
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0
+    add x2, x2, #scheduler_stop_requested
+    mov w3, #1
+    stlr w3, [x2]
+
+    bl _scheduler_wake
+    mov x0, #1
+    ldp x19, x30, [sp], #16
+    ret
+
+scheduler_request_stop_invalid:
+    mov x0, #0
+    ret
+
 // ------------------------------------------------------------
 // Process Messages
 // ------------------------------------------------------------
@@ -1511,28 +2161,24 @@ _process_messages:
 // ------------------------------------------------------------
 // Check Load Balance
 // ------------------------------------------------------------
-// Periodic load balancing check.
+// Periodic load balancing check at the end of each pass: answer a
+// steal request another scheduler has posted here (see
+// _serve_steal_request in loadbalancer.s). Runs on this scheduler's
+// thread, which owns the run queues being taken from.
 //
 // Parameters:
-//   None
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID of the scheduler
 //
 // Returns:
-//   None
+//   x0 (void*) - process: PCB handed to another scheduler, or NULL
 //
-// Version: 0.10
+// Complexity: O(1) without a request, O(n) in the number of cores with one
+//
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 _check_load_balance:
-    // Save callee-saved registers
-    stp x19, x30, [sp, #-16]!
-
-    // Check load balance (simplified implementation)
-    // In a full implementation, this would:
-    // - Check if load balancing is needed
-    // - Trigger work stealing if necessary
-    // - Update load balancing statistics
-
-    ldp x19, x30, [sp], #16
-    ret
+    b _serve_steal_request
 
@@ -0,0 +1,941 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// ------------------------------------------------------------
+// set.s — Swiss-Table Hash Sets
+// ------------------------------------------------------------
+// Sets of 64-bit words for membership checks, such as the Set a
+// Filter or FindIn template tests each element against. Keys compare
+// as words, so immediate terms (integers, atoms, pids) are keys as
+// they are.
+//
+// A set is open-addressed: slots of keys, and one control byte per
+// slot, either SET_CTRL_EMPTY or, for a full slot, 7 bits of the key's
+// hash. Slots come in groups of SET_GROUP_SIZE. A probe loads a
+// group's control bytes with NEON, compares all 16 against the key's
+// byte at once (cmeq), and narrows the result to a 64-bit mask (shrn)
+// whose set nibbles are the only slots whose keys are read. The high
+// hash bits pick the home group; a key lives in the first group from
+// its home that had a free slot when it was added, so a probe stops at
+// the first group holding an empty byte.
+//
+// Sets hold at most 7/8 of their slots. Removal leaves no tombstones:
+// if the key's group still has an empty byte, no probe passes through
+// it and the slot simply empties; otherwise a key from a later group
+// whose probe passes the hole moves back into it, and so on until a
+// group with an empty byte ends the chain. Churn at a steady size
+// therefore never fills a set with dead slots or forces a rehash.
+//
+// A set owns one mapping, sized up front for its most keys but only
+// touched as far as its current capacity. Growing doubles the capacity
+// in place: every full byte is marked SET_CTRL_DELETED and each key is
+// moved to the first free slot of its new probe, swapping with keys
+// still to be placed, so no second table is ever needed and the set's
+// address never changes.
+//
+// A frozen set is made read-only with mprotect and can be shared by
+// any number of processes and schedulers, which look keys up without
+// locks. Copying a set, frozen or not, gives an independent mutable
+// one to derive new versions from.
+//
+// A frozen set reaches bytecode as a handle: a TERM_KIND_SET object on
+// a process heap whose one body word is the set's address. The address
+// is page-aligned, so term.s reads it as a small integer: copying a
+// handle copies the address, and two handles are equal only if they
+// name the same set. The interpreter's MEMBER tests a key against a
+// handle, which is how Filter and FindIn bodies check membership. A
+// set must outlive every handle and program that refers to it.
+//
+// The file provides:
+//   - Creation, copying, freezing and destruction
+//   - Insert, lookup and tombstone-free removal
+//   - In-place growth and reservation
+//   - Count and capacity queries
+//   - Handles to frozen sets as terms
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// Include the PCB layout
+    .include "pcb.inc"
+
+// External C library functions for memory management
+    .extern _mmap
+    .extern _munmap
+    .extern _mprotect
+
+// ------------------------------------------------------------
+// Set Function Exports
+// ------------------------------------------------------------
+// Export the set functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _set_create
+    .global _set_destroy
+    .global _set_insert
+    .global _set_contains
+    .global _set_remove
+    .global _set_reserve
+    .global _set_copy
+    .global _set_freeze
+    .global _set_count
+    .global _set_capacity
+    .global _set_term
+
+// ------------------------------------------------------------
+// Set Layout
+// ------------------------------------------------------------
+// One mapping: this 64-byte header, the control bytes for the most
+// slots the set may grow to, then the slots.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ set_count, 0                 // Keys held (8 bytes)
+    .equ set_capacity, 8              // Slots in use, a power of 2 (8 bytes)
+    .equ set_growth_left, 16          // Keys that fit before growing (8 bytes)
+    .equ set_max_capacity, 24         // Slots the mapping has room for (8 bytes)
+    .equ set_slots, 32                // First slot (8 bytes)
+    .equ set_length, 40               // Mapping length for munmap (8 bytes)
+    .equ set_frozen, 48               // Non-zero once read-only (8 bytes)
+    .equ set_controls, 64             // First control byte
+
+    .equ PROT_READ, 1
+    .equ set_term_header, ((1 << TERM_HEADER_ARITY_SHIFT) | TERM_HEADER_SET)
+    .equ set_term_words, 2            // Handle: header, then the set's address
+    .equ set_lane_bits, 0x8888888888888888 // One bit per byte of a shrn mask
+
+// ------------------------------------------------------------
+// Macros
+// ------------------------------------------------------------
+
+// \dst = the Fibonacci multiplier 2^64 / phi
+.macro SET_MULTIPLIER dst
+    movz \dst, #0x7C15
+    movk \dst, #0x7F4A, lsl #16
+    movk \dst, #0x79B9, lsl #32
+    movk \dst, #0x9E37, lsl #48
+.endm
+
+// \dst = hash of \key: high bits fold into the low ones, then one
+// multiply spreads them to the top, which picks the home group
+.macro SET_HASH dst, key, multiplier
+    eor \dst, \key, \key, lsr #29
+    mul \dst, \dst, \multiplier
+.endm
+
+// \dst = 4 mask bits per control byte of v0 that is free (negative:
+// empty, or deleted while growing). Clobbers v1.
+.macro SET_FREE_MASK dst
+    cmlt v1.16b, v0.16b, #0
+    shrn v1.8b, v1.8h, #4
+    fmov \dst, d1
+.endm
+
+// \dst = slot within its group of the lowest lane set in \mask
+.macro SET_LOWEST_LANE dst, mask
+    rbit \dst, \mask
+    clz \dst, \dst
+    lsr \dst, \dst, #2
+.endm
+
+// ------------------------------------------------------------
+// Set Create
+// ------------------------------------------------------------
+// Map an empty set with room to grow to at least max_keys keys. It
+// starts with SET_MIN_CAPACITY slots; pages past them are not touched
+// until the set grows into them.
+//
+// Parameters:
+//   x0 (uint64_t) - max_keys: Most keys, 1 to SET_MAX_KEYS
+//
+// Returns:
+//   x0 (void*) - set: The set, or NULL if max_keys is out of range or
+//              mmap fails
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_set_create:
+    cbz x0, set_create_invalid
+    mov x9, #SET_MAX_KEYS
+    cmp x0, x9
+    b.hi set_create_invalid
+
+    // Smallest power of 2 whose 7/8 holds max_keys
+    mov x9, #SET_MIN_CAPACITY
+set_create_size:
+    sub x10, x9, x9, lsr #3
+    cmp x10, x0
+    b.hs set_create_map
+    lsl x9, x9, #1
+    b set_create_size
+
+set_create_map:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x9                       // Most slots
+    add x20, x19, x19, lsl #3         // A control byte and a slot each
+    add x20, x20, #set_controls       // Mapping length
+
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, x20                       // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq set_create_failed
+
+    // Header (the mapping is zeroed), then one group of empty bytes
+    mov x9, #SET_MIN_CAPACITY
+    str x9, [x0, #set_capacity]
+    mov x9, #(SET_MIN_CAPACITY - SET_MIN_CAPACITY / 8)
+    str x9, [x0, #set_growth_left]
+    str x19, [x0, #set_max_capacity]
+    add x9, x0, #set_controls
+    add x10, x9, x19
+    str x10, [x0, #set_slots]
+    str x20, [x0, #set_length]
+    movi v0.16b, #SET_CTRL_EMPTY
+    str q0, [x9]
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+set_create_failed:
+    mov x0, #0
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+set_create_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Set Destroy
+// ------------------------------------------------------------
+// Unmap a set, frozen or not. No process may still be using it.
+//
+// Parameters:
+//   x0 (void*) - set: Set
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if set is NULL or munmap fails
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_set_destroy:
+    cbz x0, set_destroy_invalid
+    stp x29, x30, [sp, #-16]!
+    ldr x1, [x0, #set_length]
+    bl _munmap
+    cmp x0, #0
+    cset x0, eq
+    ldp x29, x30, [sp], #16
+    ret
+
+set_destroy_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Set Insert
+// ------------------------------------------------------------
+// Add key, growing the set in place first if it is 7/8 full.
+//
+// Parameters:
+//   x0 (void*) - set: Set
+//   x1 (uint64_t) - key: Any word
+//
+// Returns:
+//   x0 (int) - success: 1 if key is now held (added, or already
+//              there), 0 if set is NULL, frozen, or full at its most
+//              keys
+//
+// Complexity: O(1) expected; O(n) when it grows
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_set_insert:
+    cbz x0, set_insert_invalid
+    ldr x9, [x0, #set_frozen]
+    cbnz x9, set_insert_invalid
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0                       // set
+    mov x20, x1                       // key
+
+set_insert_probe:
+    mov x0, x19
+    mov x1, x20
+    bl set_find
+    tbz x2, #63, set_insert_held
+    ldr x9, [x19, #set_growth_left]
+    cbnz x9, set_insert_place
+    mov x0, x19
+    bl set_grow
+    cbnz x0, set_insert_probe         // Probe again at the new capacity
+    b set_insert_return
+
+set_insert_place:
+    // First empty slot of the group the probe stopped at
+    sub x9, x9, #1
+    str x9, [x19, #set_growth_left]
+    ldr x9, [x19, #set_count]
+    add x9, x9, #1
+    str x9, [x19, #set_count]
+    ldr x9, [x19, #set_slots]
+    str x20, [x9, x3, lsl #3]
+    add x9, x19, #set_controls
+    strb w4, [x9, x3]
+
+set_insert_held:
+    mov x0, #1
+
+set_insert_return:
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+set_insert_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Set Contains
+// ------------------------------------------------------------
+// Whether key is held. Takes no locks and writes nothing, so any
+// number of threads may look up in a frozen set at once.
+//
+// Parameters:
+//   x0 (void*) - set: Set
+//   x1 (uint64_t) - key: Any word
+//
+// Returns:
+//   x0 (int) - held: 1 if key is held, 0 if not or set is NULL
+//
+// Complexity: O(1) expected, one group per probe step
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_set_contains:
+    cbz x0, set_contains_invalid
+    stp x29, x30, [sp, #-16]!
+    bl set_find
+    cmn x2, #1
+    cset x0, ne
+    ldp x29, x30, [sp], #16
+    ret
+
+set_contains_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Set Remove
+// ------------------------------------------------------------
+// Remove key without leaving a tombstone. If the key's group has an
+// empty byte its slot empties. Otherwise the following groups are
+// scanned for a key whose home group is at or before the hole's; it
+// moves into the hole, leaving a hole in its own group, until a group
+// with an empty byte is reached and the last hole empties.
+//
+// Parameters:
+//   x0 (void*) - set: Set
+//   x1 (uint64_t) - key: Any word
+//
+// Returns:
+//   x0 (int) - removed: 1 if key was held, 0 if it was not or set is
+//              NULL or frozen
+//
+// Complexity: O(1) expected
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_set_remove:
+    cbz x0, set_remove_invalid
+    ldr x9, [x0, #set_frozen]
+    cbnz x9, set_remove_invalid
+    stp x19, x30, [sp, #-16]!
+    mov x19, x0
+    bl set_find
+    tbnz x2, #63, set_remove_absent   // x2 = the hole
+
+    ldr x9, [x19, #set_count]
+    sub x9, x9, #1
+    str x9, [x19, #set_count]
+    ldr x9, [x19, #set_growth_left]
+    add x9, x9, #1
+    str x9, [x19, #set_growth_left]
+
+    add x3, x19, #set_controls
+    ldr x4, [x19, #set_slots]
+    ldr x5, [x19, #set_capacity]
+    lsr x5, x5, #SET_GROUP_SHIFT      // Groups
+    sub x6, x5, #1                    // Group mask
+    SET_MULTIPLIER x7
+    lsr x8, x2, #SET_GROUP_SHIFT      // Hole's group
+
+    // A group with an empty byte ends every probe that reaches it
+    ldr q0, [x3, x8, lsl #4]
+    SET_FREE_MASK x9
+    cbnz x9, set_remove_empty
+    add x10, x8, #1
+    and x10, x10, x6                  // Group being scanned
+
+set_remove_scan:
+    ldr q0, [x3, x10, lsl #4]
+    SET_FREE_MASK x9
+    cmge v2.16b, v0.16b, #0
+    shrn v2.8b, v2.8h, #4
+    fmov x11, d2
+    and x11, x11, #set_lane_bits      // Full slots
+    sub x12, x10, x8
+    and x12, x12, x6                  // Groups from the hole to here
+
+set_remove_candidate:
+    cbz x11, set_remove_scanned
+    SET_LOWEST_LANE x13, x11
+    add x13, x13, x10, lsl #SET_GROUP_SHIFT
+    ldr x14, [x4, x13, lsl #3]
+    SET_HASH x15, x14, x7
+    umulh x15, x15, x5                // Its home group
+    sub x15, x10, x15
+    and x15, x15, x6                  // Groups from its home to here
+    cmp x15, x12
+    b.hs set_remove_move              // Its probe passes the hole
+    sub x15, x11, #1
+    and x11, x11, x15
+    b set_remove_candidate
+
+set_remove_move:
+    str x14, [x4, x2, lsl #3]
+    ldrb w15, [x3, x13]
+    strb w15, [x3, x2]
+    mov x2, x13
+    mov x8, x10
+
+set_remove_scanned:
+    cbnz x9, set_remove_empty
+    add x10, x10, #1
+    and x10, x10, x6
+    b set_remove_scan
+
+set_remove_empty:
+    mov w9, #SET_CTRL_EMPTY
+    strb w9, [x3, x2]
+    mov x0, #1
+    ldp x19, x30, [sp], #16
+    ret
+
+set_remove_absent:
+    mov x0, #0
+    ldp x19, x30, [sp], #16
+    ret
+
+set_remove_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Set Reserve
+// ------------------------------------------------------------
+// Grow in place until keys keys fit without growing again, so a
+// known number of inserts run without rehashing.
+//
+// Parameters:
+//   x0 (void*) - set: Set
+//   x1 (uint64_t) - keys: Keys to make room for
+//
+// Returns:
+//   x0 (int) - success: 1 on success (also when they already fit), 0
+//              if set is NULL or frozen, or keys is more than it can
+//              ever hold
+//
+// Complexity: O(n) per doubling
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_set_reserve:
+    cbz x0, set_reserve_invalid
+    ldr x9, [x0, #set_frozen]
+    cbnz x9, set_reserve_invalid
+    ldr x9, [x0, #set_max_capacity]
+    sub x9, x9, x9, lsr #3
+    cmp x1, x9
+    b.hi set_reserve_invalid
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0
+    mov x20, x1
+
+set_reserve_check:
+    ldr x9, [x19, #set_capacity]
+    sub x9, x9, x9, lsr #3
+    cmp x20, x9
+    b.ls set_reserve_done
+    mov x0, x19
+    bl set_grow
+    b set_reserve_check
+
+set_reserve_done:
+    mov x0, #1
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+set_reserve_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Set Copy
+// ------------------------------------------------------------
+// A new mutable set with the same keys, capacity and most keys. The
+// source may be frozen; the copy is not.
+//
+// Parameters:
+//   x0 (void*) - set: Set
+//
+// Returns:
+//   x0 (void*) - copy: The copy, or NULL if set is NULL or mmap fails
+//
+// Complexity: O(capacity)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_set_copy:
+    cbz x0, set_copy_invalid
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0
+
+    mov x0, xzr                       // addr = NULL (let system choose)
+    ldr x1, [x19, #set_length]        // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq set_copy_failed
+    mov x20, x0
+
+    // Header; set_frozen stays zero
+    ldp x9, x10, [x19, #set_count]
+    stp x9, x10, [x20, #set_count]
+    ldp x9, x11, [x19, #set_growth_left]
+    stp x9, x11, [x20, #set_growth_left]
+    ldr x9, [x19, #set_length]
+    str x9, [x20, #set_length]
+    add x12, x20, #set_controls
+    add x13, x12, x11
+    str x13, [x20, #set_slots]
+
+    // Control bytes, then slots, of the capacity in use
+    add x9, x19, #set_controls
+    mov x14, x10
+set_copy_controls:
+    ldr q0, [x9], #16
+    str q0, [x12], #16
+    subs x14, x14, #SET_GROUP_SIZE
+    b.ne set_copy_controls
+    ldr x9, [x19, #set_slots]
+    lsl x14, x10, #3
+set_copy_slots:
+    ldp q0, q1, [x9], #32
+    stp q0, q1, [x13], #32
+    subs x14, x14, #32
+    b.ne set_copy_slots
+
+    mov x0, x20
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+set_copy_failed:
+    mov x0, #0
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+set_copy_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Set Freeze
+// ------------------------------------------------------------
+// Make a set read-only so it can be shared between processes. Inserts,
+// removals and reserves on it fail from then on; lookups, copies and
+// destruction still work.
+//
+// Parameters:
+//   x0 (void*) - set: Set
+//
+// Returns:
+//   x0 (int) - success: 1 on success (also when already frozen), 0 if
+//              set is NULL or mprotect fails (the set stays mutable)
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_set_freeze:
+    cbz x0, set_freeze_invalid
+    ldr x9, [x0, #set_frozen]
+    cbnz x9, set_freeze_done
+    stp x19, x30, [sp, #-16]!
+    mov x19, x0
+    mov x9, #1
+    str x9, [x19, #set_frozen]        // Last write before the pages lock
+    ldr x1, [x19, #set_length]
+    mov x2, #PROT_READ
+    bl _mprotect
+    cbnz x0, set_freeze_failed
+    mov x0, #1
+    ldp x19, x30, [sp], #16
+    ret
+
+set_freeze_failed:
+    str xzr, [x19, #set_frozen]
+    mov x0, #0
+    ldp x19, x30, [sp], #16
+    ret
+
+set_freeze_done:
+    mov x0, #1
+    ret
+
+set_freeze_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Set Count
+// ------------------------------------------------------------
+// Keys held.
+//
+// Parameters:
+//   x0 (void*) - set: Set
+//
+// Returns:
+//   x0 (uint64_t) - count: Keys, or 0 if set is NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_set_count:
+    cbz x0, set_count_invalid
+    ldr x0, [x0, #set_count]
+set_count_invalid:
+    ret
+
+// ------------------------------------------------------------
+// Set Capacity
+// ------------------------------------------------------------
+// Slots in use; the set grows when its keys would pass 7/8 of them.
+//
+// Parameters:
+//   x0 (void*) - set: Set
+//
+// Returns:
+//   x0 (uint64_t) - capacity: Slots, or 0 if set is NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_set_capacity:
+    cbz x0, set_capacity_invalid
+    ldr x0, [x0, #set_capacity]
+set_capacity_invalid:
+    ret
+
+// ------------------------------------------------------------
+// Set Term
+// ------------------------------------------------------------
+// Box a frozen set as a term on a process heap, for a literal of a
+// program that tests membership with MEMBER. Only frozen sets are
+// boxed, so every holder of a handle sees the same keys.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (void*) - set: Frozen set
+//
+// Returns:
+//   x0 (term_t) - handle: A TERM_KIND_SET term, or TERM_NONE if the
+//                 heap is full, pcb or set is NULL, or set is not frozen
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_set_term:
+    cbz x0, set_term_invalid
+    cbz x1, set_term_invalid
+    ldr x9, [x1, #set_frozen]
+    cbz x9, set_term_invalid
+    ldr x2, [x0, #pcb_heap_pointer]
+    ldr x3, [x0, #pcb_heap_limit]
+    add x4, x2, #(set_term_words * 8)
+    cmp x4, x3
+    b.hi set_term_invalid
+    str x4, [x0, #pcb_heap_pointer]
+    mov x5, #set_term_header
+    stp x5, x1, [x2]
+    add x0, x2, #TERM_TAG_BOXED
+    ret
+
+set_term_invalid:
+    mov x0, #TERM_NONE
+    ret
+
+// ------------------------------------------------------------
+// Set Find (internal)
+// ------------------------------------------------------------
+// Probe for key group by group from its home group: tag matches are
+// compared against their slots, and the first group with an empty
+// byte ends the probe.
+//
+// Parameters:
+//   x0 (void*) - set: Set
+//   x1 (uint64_t) - key: Any word
+//
+// Returns:
+//   x2 (int64_t) - slot: The key's slot, or -1 if it is not held
+//   x3 (uint64_t) - free: If not held, the first empty slot of the
+//                   group the probe stopped at, where key belongs
+//   x4 (uint64_t) - tag: key's control byte
+//
+// Clobbers: x5-x14, v0, v1, v16
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+set_find:
+    SET_MULTIPLIER x5
+    SET_HASH x6, x1, x5
+    ldr x7, [x0, #set_capacity]
+    lsr x7, x7, #SET_GROUP_SHIFT      // Groups
+    umulh x8, x6, x7                  // Home group: the top hash bits
+    sub x7, x7, #1                    // Group mask
+    ubfx x4, x6, #SET_TAG_SHIFT, #7
+    dup v16.16b, w4
+    add x9, x0, #set_controls
+    ldr x10, [x0, #set_slots]
+
+set_find_group:
+    ldr q0, [x9, x8, lsl #4]
+    cmeq v1.16b, v0.16b, v16.16b
+    shrn v1.8b, v1.8h, #4             // 4 mask bits per control byte
+    fmov x11, d1
+    and x11, x11, #set_lane_bits
+
+set_find_candidate:
+    cbz x11, set_find_misses
+    SET_LOWEST_LANE x12, x11
+    add x12, x12, x8, lsl #SET_GROUP_SHIFT
+    ldr x13, [x10, x12, lsl #3]
+    cmp x13, x1
+    b.eq set_find_found
+    sub x13, x11, #1
+    and x11, x11, x13
+    b set_find_candidate
+
+set_find_found:
+    mov x2, x12
+    ret
+
+set_find_misses:
+    SET_FREE_MASK x11
+    cbnz x11, set_find_absent
+    add x8, x8, #1                    // Group full of other keys: next group
+    and x8, x8, x7
+    b set_find_group
+
+set_find_absent:
+    SET_LOWEST_LANE x12, x11
+    add x3, x12, x8, lsl #SET_GROUP_SHIFT
+    mov x2, #-1
+    ret
+
+// ------------------------------------------------------------
+// Set Grow (internal)
+// ------------------------------------------------------------
+// Double the capacity in place. Full bytes become SET_CTRL_DELETED
+// and the new half empties; then each deleted slot's key goes to the
+// first free slot of its new probe. If that is in its own group it
+// stays; an empty target takes it and its slot empties; a deleted
+// target swaps keys with it and the key swapped in is placed next. No
+// placed key's probe ever crosses a slot emptied later, since the probe
+// stopped at the first free slot.
+//
+// Parameters:
+//   x0 (void*) - set: Set
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if it is at its most slots
+//
+// Clobbers: x1-x15, v0, v1, v17, v18
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+set_grow:
+    ldr x1, [x0, #set_capacity]
+    ldr x2, [x0, #set_max_capacity]
+    cmp x1, x2
+    b.hs set_grow_full
+    add x3, x0, #set_controls
+    ldr x4, [x0, #set_slots]
+
+    // Full -> deleted, empty stays, 16 bytes at a time
+    movi v17.16b, #SET_CTRL_EMPTY
+    movi v18.16b, #SET_CTRL_DELETED
+    mov x5, #0
+set_grow_mark:
+    ldr q0, [x3, x5]
+    cmlt v1.16b, v0.16b, #0
+    bsl v1.16b, v17.16b, v18.16b
+    str q1, [x3, x5]
+    add x5, x5, #SET_GROUP_SIZE
+    cmp x5, x1
+    b.lo set_grow_mark
+    lsl x6, x1, #1                    // New capacity
+set_grow_clear:
+    str q17, [x3, x5]
+    add x5, x5, #SET_GROUP_SIZE
+    cmp x5, x6
+    b.lo set_grow_clear
+
+    str x6, [x0, #set_capacity]
+    sub x7, x6, x6, lsr #3
+    ldr x8, [x0, #set_count]
+    sub x7, x7, x8
+    str x7, [x0, #set_growth_left]
+    lsr x7, x6, #SET_GROUP_SHIFT      // Groups
+    sub x8, x7, #1                    // Group mask
+    SET_MULTIPLIER x9
+
+    mov x5, #0                        // Slot being rehashed
+set_grow_slot:
+    ldrb w10, [x3, x5]
+    cmp w10, #SET_CTRL_DELETED
+    b.ne set_grow_next
+    ldr x11, [x4, x5, lsl #3]
+    SET_HASH x12, x11, x9
+    umulh x13, x12, x7                // New home group
+    ubfx x12, x12, #SET_TAG_SHIFT, #7
+
+set_grow_probe:
+    ldr q0, [x3, x13, lsl #4]
+    SET_FREE_MASK x14
+    cbnz x14, set_grow_target
+    add x13, x13, #1
+    and x13, x13, x8
+    b set_grow_probe
+
+set_grow_target:
+    cmp x13, x5, lsr #SET_GROUP_SHIFT
+    b.eq set_grow_keep
+    SET_LOWEST_LANE x14, x14
+    add x14, x14, x13, lsl #SET_GROUP_SHIFT
+    ldrb w15, [x3, x14]
+    strb w12, [x3, x14]
+    cmp w15, #SET_CTRL_EMPTY
+    b.ne set_grow_swap
+    str x11, [x4, x14, lsl #3]
+    mov w10, #SET_CTRL_EMPTY
+    strb w10, [x3, x5]
+    b set_grow_next
+
+set_grow_swap:
+    ldr x15, [x4, x14, lsl #3]
+    str x11, [x4, x14, lsl #3]
+    str x15, [x4, x5, lsl #3]
+    b set_grow_slot                   // Still deleted: place the swapped key
+
+set_grow_keep:
+    strb w12, [x3, x5]
+
+set_grow_next:
+    add x5, x5, #1
+    cmp x5, x1
+    b.lo set_grow_slot
+    mov x0, #1
+    ret
+
+set_grow_full:
+    mov x0, #0
+    ret
@@ -0,0 +1,811 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// sim.s — Deterministic Simulation with Virtual Time
+// ------------------------------------------------------------
+// Runs every scheduler on the calling thread under a seeded
+// interleaver. Each step picks one scheduler (from a replay script,
+// otherwise from an xorshift64* generator), advances virtual time by
+// one quantum and runs one main-loop pass (_scheduler_run_pass) on it.
+// Every decision (dispatch, steal, idle pass, clock jump) is logged
+// and folded into a digest, so two runs agree exactly when their
+// digests do.
+//
+// Schedulers under simulation carry SCHEDULER_FLAG_VIRTUAL_TIME: their
+// cached_now is written only by the simulator, and the clock refresh,
+// slice accounting and trace timestamps read it instead of CNTVCT_EL0.
+// Idle sleep returns at once; _sim_advance_idle jumps the clock to the
+// next timer deadline instead. Virtual time starts at SIM_EPOCH (never
+// zero, which means "not refreshed yet" to the timer and steal code).
+//
+// The same seed and workload therefore replay the same schedule, so
+// policies (victim selection, reduction budgets, placement) can be
+// compared on identical inputs and a rare schedule, once logged, can
+// be fed back through _sim_set_script.
+//
+// The file provides:
+//   - Simulator creation over an existing scheduler states array
+//   - Seeded or scripted scheduler selection, one pass per step
+//   - Virtual clock advance, including jumps to the next timer
+//   - Decision log (oldest first) and schedule digest
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// External scheduler, load balancer and timer functions
+    .extern _scheduler_run_pass
+    .extern _get_scheduler_load
+    .extern _select_victim_by_load
+    .extern _timer_wheel_next_deadline
+
+// External C library functions for memory management
+    .extern _mmap
+    .extern _munmap
+
+// ------------------------------------------------------------
+// Simulation Function Exports
+// ------------------------------------------------------------
+// Export the simulation functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _sim_create
+    .global _sim_destroy
+    .global _sim_set_quantum
+    .global _sim_set_script
+    .global _sim_step
+    .global _sim_advance
+    .global _sim_advance_idle
+    .global _sim_now
+    .global _sim_log_read
+    .global _sim_digest
+
+// ------------------------------------------------------------
+// Simulator Layout
+// ------------------------------------------------------------
+// One mapping: a 128-byte header followed by a power-of-two ring of
+// SIM_EVENT_SIZE-byte log entries (the newest are kept).
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ sim_states, 0                // Scheduler states array (8 bytes)
+    .equ sim_cores, 8                 // Simulated schedulers (8 bytes)
+    .equ sim_rng, 16                  // xorshift64* state, never 0 (8 bytes)
+    .equ sim_now, 24                  // Virtual time in ticks (8 bytes)
+    .equ sim_quantum, 32              // Ticks each step advances (8 bytes)
+    .equ sim_steps, 40                // Steps taken (8 bytes)
+    .equ sim_log_mask, 48             // capacity - 1 (8 bytes)
+    .equ sim_log_head, 56             // Entries ever logged (8 bytes)
+    .equ sim_script, 64               // Replay script of core IDs, or NULL (8 bytes)
+    .equ sim_script_length, 72        // Script entries (8 bytes)
+    .equ sim_script_cursor, 80        // Next script entry (8 bytes)
+    .equ sim_digest, 88               // FNV-1a over every decision (8 bytes)
+    .equ sim_length, 96               // Mapping length for munmap (8 bytes)
+    .equ sim_entries, 128             // First log entry (header padded to 128)
+
+    .equ sim_event_now, 0             // Virtual time of the decision (8 bytes)
+    .equ sim_event_core, 8            // Scheduler, SIM_NO_CORE for clock jumps (4 bytes)
+    .equ sim_event_kind, 12           // SIM_EVENT_* (4 bytes)
+    .equ sim_event_pid, 16            // Process ID, 0 if none (8 bytes)
+    .equ sim_event_arg, 24            // Run-queue load, victim core or ticks (8 bytes)
+
+    .equ FNV_PRIME_LOW, 0x1b3         // 64-bit FNV prime 0x100000001b3
+    .equ FNV_PRIME_HIGH, 0x100
+
+    // Scheduler state offsets (shared with scheduler.s)
+    .include "scheduler_state.inc"
+
+    // PCB offsets (shared with process.s)
+    .include "pcb.inc"
+
+// ------------------------------------------------------------
+// Sim Create
+// ------------------------------------------------------------
+// Put schedulers 0 to cores-1 on virtual time at SIM_EPOCH and create
+// a simulator for them. Call before any timer wheel is created, so the
+// wheels start at the virtual epoch; wheels made afterwards
+// (_timer_wheel_init) pick it up from cached_now. The quantum starts
+// at SIM_DEFAULT_QUANTUM.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - cores: Schedulers to simulate (1 to MAX_CORES)
+//   x2 (uint64_t) - seed: Interleaver seed (0 is treated as 1)
+//   x3 (uint64_t) - log_capacity: Log entries kept, a power of two
+//                   from SIM_LOG_MIN_EVENTS to SIM_LOG_MAX_EVENTS
+//
+// Returns:
+//   x0 (void*) - sim: Simulator, or NULL on invalid arguments, if a
+//                scheduler already has a timer wheel, or if the
+//                mapping fails
+//
+// Complexity: O(cores)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_sim_create:
+    cbz x0, sim_create_invalid
+    cbz x1, sim_create_invalid
+    cmp x1, #MAX_CORES
+    b.hi sim_create_invalid
+    cmp x3, #SIM_LOG_MIN_EVENTS
+    b.lo sim_create_invalid
+    mov x4, #SIM_LOG_MAX_EVENTS
+    cmp x3, x4
+    b.hi sim_create_invalid
+    sub x4, x3, #1
+    tst x3, x4
+    b.ne sim_create_invalid
+
+    // Wheels created on real time would never see virtual time advance
+    mov x4, #0
+    mov x5, #scheduler_size
+sim_create_check:
+    madd x6, x4, x5, x0
+    ldr x6, [x6, #scheduler_timer_wheel]
+    cbnz x6, sim_create_invalid
+    add x4, x4, #1
+    cmp x4, x1
+    b.lo sim_create_check
+
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+
+    mov x19, x0                       // scheduler_states
+    mov x20, x1                       // cores
+    mov x21, x2                       // seed
+    mov x22, x3                       // log_capacity
+    lsl x23, x3, #SIM_EVENT_SHIFT
+    add x23, x23, #sim_entries        // mapping length
+
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, x23                       // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq sim_create_failed
+
+    // Header (the mapping is zeroed)
+    str x19, [x0, #sim_states]
+    str x20, [x0, #sim_cores]
+    cmp x21, #0
+    csinc x21, x21, xzr, ne           // xorshift must not start at 0
+    str x21, [x0, #sim_rng]
+    mov x1, #SIM_DEFAULT_QUANTUM
+    str x1, [x0, #sim_quantum]
+    sub x1, x22, #1
+    str x1, [x0, #sim_log_mask]
+    str x23, [x0, #sim_length]
+    movz x1, #0x2325                  // FNV-1a offset basis
+    movk x1, #0x8422, lsl #16
+    movk x1, #0x9ce4, lsl #32
+    movk x1, #0xcbf2, lsl #48
+    str x1, [x0, #sim_digest]
+    mov x1, #SIM_EPOCH
+    str x1, [x0, #sim_now]
+
+    // Every simulated scheduler reads the virtual clock from now on
+    mov x4, #0
+    mov x5, #scheduler_size
+sim_create_virtual:
+    madd x6, x4, x5, x19
+    ldr w7, [x6, #scheduler_flags]
+    orr w7, w7, #(1 << SCHEDULER_FLAG_VIRTUAL_TIME)
+    str w7, [x6, #scheduler_flags]
+    str x1, [x6, #scheduler_cached_now]
+    add x4, x4, #1
+    cmp x4, x20
+    b.lo sim_create_virtual
+
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+sim_create_failed:
+    mov x0, #0
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+sim_create_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Sim Destroy
+// ------------------------------------------------------------
+// Return the simulated schedulers to the real clock (their next
+// refresh reads CNTVCT_EL0) and free the simulator.
+//
+// Parameters:
+//   x0 (void*) - sim: Simulator from _sim_create
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if sim is NULL
+//
+// Complexity: O(cores)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_sim_destroy:
+    cbz x0, sim_destroy_invalid
+    stp x19, x30, [sp, #-16]!
+
+    ldr x1, [x0, #sim_states]
+    ldr x2, [x0, #sim_cores]
+    mov x3, #0
+    mov x4, #scheduler_size
+sim_destroy_real:
+    madd x5, x3, x4, x1
+    ldr w6, [x5, #scheduler_flags]
+    and w6, w6, #~(1 << SCHEDULER_FLAG_VIRTUAL_TIME)
+    str w6, [x5, #scheduler_flags]
+    add x3, x3, #1
+    cmp x3, x2
+    b.lo sim_destroy_real
+
+    ldr x1, [x0, #sim_length]
+    bl _munmap
+    mov x0, #1
+    ldp x19, x30, [sp], #16
+    ret
+
+sim_destroy_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Sim Set Quantum
+// ------------------------------------------------------------
+// Set how far virtual time advances on every step. Larger quanta
+// make timers expire after fewer steps.
+//
+// Parameters:
+//   x0 (void*) - sim: Simulator from _sim_create
+//   x1 (uint64_t) - ticks: Ticks per step (non-zero)
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 on invalid arguments
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_sim_set_quantum:
+    cbz x0, sim_set_invalid
+    cbz x1, sim_set_invalid
+    str x1, [x0, #sim_quantum]
+    mov x0, #1
+    ret
+
+sim_set_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Sim Set Script
+// ------------------------------------------------------------
+// Replay a schedule: the next count steps run the given cores in
+// order (IDs are taken modulo the simulated core count), after which
+// the seeded generator resumes. The script is read in place and must
+// outlive those steps. A NULL script (count 0) cancels replay.
+//
+// Parameters:
+//   x0 (void*) - sim: Simulator from _sim_create
+//   x1 (const uint8_t*) - cores: Core ID per step, or NULL
+//   x2 (uint64_t) - count: Script entries
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 on invalid arguments
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_sim_set_script:
+    cbz x0, sim_set_invalid
+    cbnz x1, sim_set_script_store
+    cbnz x2, sim_set_invalid
+sim_set_script_store:
+    str x1, [x0, #sim_script]
+    str x2, [x0, #sim_script_length]
+    str xzr, [x0, #sim_script_cursor]
+    mov x0, #1
+    ret
+
+// ------------------------------------------------------------
+// Sim Set Now (internal)
+// ------------------------------------------------------------
+// Set virtual time on the simulator and every simulated scheduler.
+//
+// Parameters:
+//   x0 (void*) - sim: Simulator
+//   x1 (uint64_t) - now: New virtual time
+//
+// Returns:
+//   None (x0, x1 preserved)
+//
+// Complexity: O(cores)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x2-x6
+//
+sim_set_now:
+    str x1, [x0, #sim_now]
+    ldr x2, [x0, #sim_states]
+    ldr x3, [x0, #sim_cores]
+    mov x4, #0
+    mov x5, #scheduler_size
+sim_set_now_core:
+    madd x6, x4, x5, x2
+    str x1, [x6, #scheduler_cached_now]
+    add x4, x4, #1
+    cmp x4, x3
+    b.lo sim_set_now_core
+    ret
+
+// ------------------------------------------------------------
+// Sim Log Record (internal)
+// ------------------------------------------------------------
+// Append a decision at the current virtual time and fold it into the
+// digest (FNV-1a over the entry's four words).
+//
+// Parameters:
+//   x0 (void*) - sim: Simulator
+//   x1 (uint64_t) - core: Scheduler, or SIM_NO_CORE
+//   x2 (uint64_t) - kind: SIM_EVENT_*
+//   x3 (uint64_t) - pid: Process ID, or 0
+//   x4 (uint64_t) - arg: Event-specific argument
+//
+// Returns:
+//   None (x0 preserved)
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x5-x9
+//
+sim_log_record:
+    ldr x5, [x0, #sim_log_head]
+    ldr x6, [x0, #sim_log_mask]
+    and x6, x5, x6
+    add x6, x0, x6, lsl #SIM_EVENT_SHIFT
+    add x6, x6, #sim_entries          // x6 = slot
+    add x5, x5, #1
+    str x5, [x0, #sim_log_head]
+
+    ldr x7, [x0, #sim_now]
+    mov w8, w1
+    orr x8, x8, x2, lsl #32           // core | kind << 32
+    stp x7, x8, [x6, #sim_event_now]
+    stp x3, x4, [x6, #sim_event_pid]
+
+    ldr x5, [x0, #sim_digest]
+    movz x9, #FNV_PRIME_LOW
+    movk x9, #FNV_PRIME_HIGH, lsl #32
+    eor x5, x5, x7
+    mul x5, x5, x9
+    eor x5, x5, x8
+    mul x5, x5, x9
+    eor x5, x5, x3
+    mul x5, x5, x9
+    eor x5, x5, x4
+    mul x5, x5, x9
+    str x5, [x0, #sim_digest]
+    ret
+
+// ------------------------------------------------------------
+// Sim Step
+// ------------------------------------------------------------
+// Take one scheduling step: pick a scheduler (next script entry, else
+// xorshift64* scaled to the core count), advance virtual time by the
+// quantum and run one main-loop pass on that scheduler. The pass
+// refreshes its clock, expires timers, dispatches and answers steal
+// requests. A dispatched process is current on the chosen scheduler;
+// the caller runs it, then deschedules and re-enqueues it. Processes
+// handed over between schedulers by the pass itself travel through
+// the timer inboxes, so they show up as later dispatches.
+//
+// If the pass finds no work it steals the way a scheduler thread does:
+// it posts a steal request to the busiest other scheduler
+// (_try_steal_work), that scheduler answers at the end of its next
+// pass and the process arrives through this scheduler's timer inbox,
+// to be dispatched by a later step. Steals therefore run under
+// virtual time with the victim policy scheduler threads use.
+//
+// The decision is logged as SIM_EVENT_DISPATCH (arg = the scheduler's
+// remaining load), SIM_EVENT_STEAL (the pass posted a request, arg =
+// victim core) or SIM_EVENT_IDLE.
+//
+// Parameters:
+//   x0 (void*) - sim: Simulator from _sim_create
+//   x1 (uint64_t*) - core_out: Receives the chosen core, or NULL
+//
+// Returns:
+//   x0 (void*) - process: PCB dispatched, or NULL if the chosen
+//                scheduler found no work (or sim is NULL)
+//
+// Complexity: O(cores) plus one scheduler pass
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_sim_step:
+    cbz x0, sim_step_invalid
+
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+
+    mov x19, x0                       // sim
+    mov x23, x1                       // core_out
+    ldr x20, [x19, #sim_states]
+
+    // Next scheduler: the replay script first, then the generator
+    ldr x2, [x19, #sim_script_cursor]
+    ldr x3, [x19, #sim_script_length]
+    ldr x4, [x19, #sim_cores]
+    cmp x2, x3
+    b.hs sim_step_random
+    ldr x5, [x19, #sim_script]
+    ldrb w21, [x5, x2]
+    add x2, x2, #1
+    str x2, [x19, #sim_script_cursor]
+    udiv x5, x21, x4
+    msub x21, x5, x4, x21             // core = entry % cores
+    b sim_step_picked
+
+sim_step_random:
+    ldr x5, [x19, #sim_rng]
+    eor x5, x5, x5, lsr #12
+    eor x5, x5, x5, lsl #25
+    eor x5, x5, x5, lsr #27
+    str x5, [x19, #sim_rng]
+    movz x6, #0xDD1D                  // xorshift64* multiplier
+    movk x6, #0x4F6C, lsl #16
+    movk x6, #0xF491, lsl #32
+    movk x6, #0x2545, lsl #48
+    mul x5, x5, x6
+    umulh x21, x5, x4                 // core = (r * cores) >> 64
+
+sim_step_picked:
+    cbz x23, sim_step_clock
+    str x21, [x23]
+
+sim_step_clock:
+    // One quantum passes on every scheduler
+    ldr x1, [x19, #sim_now]
+    ldr x2, [x19, #sim_quantum]
+    add x1, x1, x2
+    mov x0, x19
+    bl sim_set_now
+
+    // One main-loop pass on the chosen scheduler, noting its steal
+    // attempts so a request posted by the pass can be logged
+    mov x0, #scheduler_size
+    madd x22, x21, x0, x20            // x22 = scheduler state
+    ldr x24, [x22, #scheduler_steal_attempts]
+    mov x0, x20
+    mov x1, x21
+    bl _scheduler_run_pass
+    mov x25, x0
+    cbz x25, sim_step_idle
+
+    // Dispatched (stolen processes arrive as dispatches too)
+    mov x0, x20
+    mov x1, x21
+    bl _get_scheduler_load
+    mov x4, x0
+    mov x2, #SIM_EVENT_DISPATCH
+    ldr x3, [x25, #pcb_pid]
+    b sim_step_log
+
+sim_step_idle:
+    // Nothing runnable. A posted request went to the busiest other
+    // scheduler; the pass changed no other scheduler's run queues, so
+    // the same choice names the victim
+    mov x2, #SIM_EVENT_IDLE
+    mov x3, #0
+    mov x4, #0
+    ldr x0, [x22, #scheduler_steal_attempts]
+    cmp x0, x24
+    b.eq sim_step_log
+    mov x0, x20
+    mov x1, x21
+    bl _select_victim_by_load
+    mov x4, x0
+    mov x2, #SIM_EVENT_STEAL
+    mov x3, #0
+
+sim_step_log:
+    mov x0, x19
+    mov x1, x21
+    bl sim_log_record
+    ldr x1, [x19, #sim_steps]
+    add x1, x1, #1
+    str x1, [x19, #sim_steps]
+
+    mov x0, x25
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+sim_step_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Sim Advance
+// ------------------------------------------------------------
+// Move virtual time forward on every simulated scheduler without
+// running anything. Logged as SIM_EVENT_ADVANCE (arg = ticks).
+//
+// Parameters:
+//   x0 (void*) - sim: Simulator from _sim_create
+//   x1 (uint64_t) - ticks: Ticks to advance (0 leaves the clock)
+//
+// Returns:
+//   x0 (uint64_t) - now: Virtual time afterwards, or 0 if sim is NULL
+//
+// Complexity: O(cores)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_sim_advance:
+    cbz x0, sim_advance_invalid
+    cbz x1, sim_advance_now
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0
+    mov x20, x1
+
+    ldr x1, [x19, #sim_now]
+    add x1, x1, x20
+    bl sim_set_now
+    mov x0, x19
+    mov w1, #SIM_NO_CORE
+    mov x2, #SIM_EVENT_ADVANCE
+    mov x3, #0
+    mov x4, x20
+    bl sim_log_record
+
+    ldr x0, [x19, #sim_now]
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+sim_advance_now:
+    ldr x0, [x0, #sim_now]
+    ret
+
+sim_advance_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Sim Advance Idle
+// ------------------------------------------------------------
+// Jump virtual time to the earliest timer deadline on any simulated
+// scheduler, as the hosted runtime would by sleeping. Deadlines
+// already reached leave the clock where it is; the next steps fire
+// them.
+//
+// Parameters:
+//   x0 (void*) - sim: Simulator from _sim_create
+//
+// Returns:
+//   x0 (uint64_t) - now: Virtual time afterwards, or 0 if no timer is
+//                   armed (the simulation has nothing left to wait for)
+//                   or sim is NULL
+//
+// Complexity: O(cores)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_sim_advance_idle:
+    cbz x0, sim_advance_invalid
+
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+
+    mov x19, x0
+    ldr x20, [x19, #sim_states]
+    mov x21, #0                       // core
+    mov x22, #-1                      // earliest deadline
+sim_advance_idle_core:
+    mov x0, x20
+    mov x1, x21
+    bl _timer_wheel_next_deadline
+    cmp x0, x22
+    csel x22, x0, x22, lo
+    add x21, x21, #1
+    ldr x0, [x19, #sim_cores]
+    cmp x21, x0
+    b.lo sim_advance_idle_core
+
+    cmn x22, #1
+    b.eq sim_advance_idle_none
+    ldr x1, [x19, #sim_now]
+    subs x1, x22, x1
+    csel x1, x1, xzr, hi              // deadline passed: no jump
+    mov x0, x19
+    bl _sim_advance
+    b sim_advance_idle_done
+
+sim_advance_idle_none:
+    mov x0, #0
+
+sim_advance_idle_done:
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Sim Now
+// ------------------------------------------------------------
+// Current virtual time.
+//
+// Parameters:
+//   x0 (void*) - sim: Simulator from _sim_create
+//
+// Returns:
+//   x0 (uint64_t) - now: Virtual time in ticks, or 0 if sim is NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_sim_now:
+    cbz x0, sim_advance_invalid
+    ldr x0, [x0, #sim_now]
+    ret
+
+// ------------------------------------------------------------
+// Sim Log Read
+// ------------------------------------------------------------
+// Copy the logged decisions still in the ring, oldest first. Each
+// entry is SIM_EVENT_SIZE bytes: virtual time (u64), core (u32),
+// SIM_EVENT_* kind (u32), PID (u64) and argument (u64).
+//
+// Parameters:
+//   x0 (void*) - sim: Simulator from _sim_create
+//   x1 (void*) - out: Buffer for up to max entries
+//   x2 (uint64_t) - max: Entries the buffer holds
+//
+// Returns:
+//   x0 (uint64_t) - count: Entries copied, 0 on invalid arguments
+//
+// Complexity: O(count)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_sim_log_read:
+    cbz x0, sim_advance_invalid
+    cbz x1, sim_advance_invalid
+
+    ldr x3, [x0, #sim_log_head]
+    ldr x4, [x0, #sim_log_mask]
+    add x5, x4, #1                    // capacity
+    subs x6, x3, x5
+    csel x6, x6, xzr, hi              // oldest kept entry
+    sub x7, x3, x6                    // entries available
+    cmp x7, x2
+    csel x7, x7, x2, lo
+    mov x8, #0
+sim_log_read_entry:
+    cmp x8, x7
+    b.hs sim_log_read_done
+    add x9, x6, x8
+    and x9, x9, x4
+    add x9, x0, x9, lsl #SIM_EVENT_SHIFT
+    add x9, x9, #sim_entries
+    ldp x10, x11, [x9]
+    ldp x12, x13, [x9, #16]
+    add x9, x1, x8, lsl #SIM_EVENT_SHIFT
+    stp x10, x11, [x9]
+    stp x12, x13, [x9, #16]
+    add x8, x8, #1
+    b sim_log_read_entry
+
+sim_log_read_done:
+    mov x0, x7
+    ret
+
+// ------------------------------------------------------------
+// Sim Digest
+// ------------------------------------------------------------
+// Fingerprint of every decision logged so far, including those that
+// have left the log ring. Equal seeds, scripts and workloads give
+// equal digests; the first differing step changes it.
+//
+// Parameters:
+//   x0 (void*) - sim: Simulator from _sim_create
+//
+// Returns:
+//   x0 (uint64_t) - digest: 64-bit FNV-1a digest, or 0 if sim is NULL
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_sim_digest:
+    cbz x0, sim_advance_invalid
+    ldr x0, [x0, #sim_digest]
+    ret
@@ -0,0 +1,1112 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// stats.s — Scheduler Statistics Snapshot and Metrics Endpoint
+// ------------------------------------------------------------
+// Aggregates the per-scheduler statistics counters into one snapshot
+// and serves it in OpenMetrics text format on a local Unix socket.
+//
+// Every counter in the scheduler state has a single writer, its own
+// scheduler, and only ever grows. A reader therefore needs no locks:
+// each row is read, then read again until two passes agree (a double
+// collect). Because the counters are monotonic, two equal passes mean
+// all of the row's values held at the same moment. Rows are taken
+// per scheduler, so different rows may be from slightly different
+// moments. The totals row is summed from the rows in the snapshot.
+//
+// Readers only load from the scheduler states, so a scrape costs the
+// schedulers no more than a few shared cache-line reads.
+//
+// Schedulers counting hardware events (perf.s) also report their
+// per-phase event totals. Those are monotonic too but are copied once
+// per row after the double collect rather than compared.
+//
+// For Linux, assemble with --defsym ACTLY_LINUX=1 (socket address
+// layout and SIGPIPE suppression differ from macOS).
+//
+// The file provides:
+//   - Consistent per-scheduler counter snapshots with totals
+//   - Per-phase hardware event totals where perf counters are open
+//   - OpenMetrics text formatting of a snapshot
+//   - A Unix-socket metrics server on its own thread
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// ------------------------------------------------------------
+// Statistics Function Exports
+// ------------------------------------------------------------
+// Export the statistics functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _stats_snapshot_size
+    .global _stats_snapshot
+    .global _stats_format_openmetrics
+    .global _stats_server_start
+    .global _stats_server_stop
+    .global _STATS_HEADER_SIZE_CONST
+    .global _STATS_ROW_PERF_OFFSET_CONST
+
+// ------------------------------------------------------------
+// Statistics Structure Layout
+// ------------------------------------------------------------
+// The snapshot layout is in config.inc (STATS_*). The server is one
+// anonymous mapping holding its socket, thread, a snapshot sized for
+// MAX_CORES and the response text buffer.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ server_states, 0             // Scheduler states array (8 bytes)
+    .equ server_cores, 8              // Schedulers reported (8 bytes)
+    .equ server_listen_fd, 16         // Listening socket (4 bytes)
+    .equ server_stop, 20              // Non-zero asks the thread to exit (4 bytes)
+    .equ server_thread, 24            // pthread_t (8 bytes)
+    .equ server_addr, 32              // sockaddr_un (up to 112 bytes)
+    .equ server_snapshot, 256         // Snapshot for MAX_CORES (36144 bytes)
+    .equ server_text, 0x10000         // Response body
+    .equ server_text_size, 0x70000    // Room for every metric at MAX_CORES
+    .equ server_size, 0x80000         // Total server mapping size
+
+    .equ STATS_LISTEN_BACKLOG, 16
+    .equ STATS_REQUEST_MAX, 1024      // Request bytes read (and ignored)
+    .equ STATS_KIND_COUNTER, 0
+    .equ STATS_KIND_GAUGE, 1
+
+    // Scheduler state offsets (shared with scheduler.s)
+    .include "scheduler_state.inc"
+
+// ------------------------------------------------------------
+// Stats Snapshot Size
+// ------------------------------------------------------------
+// Bytes a snapshot of `cores` schedulers needs: the header, the
+// totals row and one row per scheduler.
+//
+// Parameters:
+//   x0 (uint64_t) - cores: Schedulers to include (1 to MAX_CORES)
+//
+// Returns:
+//   x0 (uint64_t) - size: Snapshot size in bytes, or 0 if cores is invalid
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_stats_snapshot_size:
+    cbz x0, stats_snapshot_size_invalid
+    cmp x0, #MAX_CORES
+    b.hi stats_snapshot_size_invalid
+    add x0, x0, #1
+    mov x1, #STATS_ROW_SIZE
+    mov x2, #STATS_HEADER_SIZE
+    madd x0, x0, x1, x2
+    ret
+
+stats_snapshot_size_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Stats Snapshot
+// ------------------------------------------------------------
+// Take a consistent snapshot of schedulers 0 to cores-1. Each row is
+// collected until two passes agree, up to STATS_COLLECT_ATTEMPTS
+// re-reads; a row that is still changing is kept from its last pass
+// and counted in STATS_UNSTABLE_ROWS. Safe to call from any thread
+// while the schedulers run.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - cores: Schedulers to include (1 to MAX_CORES)
+//   x2 (void*) - out: Buffer of stats_snapshot_size(cores) bytes
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 on invalid arguments
+//
+// Complexity: O(cores)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x1-x15
+//
+_stats_snapshot:
+    cbz x0, stats_snapshot_invalid
+    cbz x1, stats_snapshot_invalid
+    cmp x1, #MAX_CORES
+    b.hi stats_snapshot_invalid
+    cbz x2, stats_snapshot_invalid
+
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    mov x19, x0  // scheduler_states
+    mov x20, x1  // cores
+    mov x21, x2  // snapshot
+
+    str x20, [x21, #STATS_CORES]
+    isb
+    mrs x0, cntvct_el0
+    str x0, [x21, #STATS_TIMESTAMP]
+    str xzr, [x21, #STATS_UNSTABLE_ROWS]
+
+    // Totals start at zero
+    add x0, x21, #STATS_HEADER_SIZE
+    mov x1, #0
+stats_snapshot_clear_totals:
+    str xzr, [x0, x1]
+    add x1, x1, #8
+    cmp x1, #STATS_ROW_SIZE
+    b.lo stats_snapshot_clear_totals
+
+    mov x22, #0                       // core
+    add x23, x0, #STATS_ROW_SIZE      // row for core 0
+
+stats_snapshot_core:
+    cmp x22, x20
+    b.hs stats_snapshot_done
+    mov x0, #scheduler_size
+    madd x24, x22, x0, x19            // x24 = scheduler state
+
+    // First pass fills the row; later passes compare against it
+    mov x0, x24
+    mov x1, x23
+    bl stats_collect_row
+    mov x25, #STATS_COLLECT_ATTEMPTS
+
+stats_snapshot_recollect:
+    dmb ishld                         // The next pass reads after this one
+    mov x0, x24
+    mov x1, x23
+    bl stats_collect_row
+    cbnz x0, stats_snapshot_row_stable
+    subs x25, x25, #1
+    b.ne stats_snapshot_recollect
+    ldr x0, [x21, #STATS_UNSTABLE_ROWS]
+    add x0, x0, #1
+    str x0, [x21, #STATS_UNSTABLE_ROWS]
+
+stats_snapshot_row_stable:
+    // Run queue length is a gauge, read once
+    ldr w0, [x24, #scheduler_queues + queue_count]
+    ldr w1, [x24, #scheduler_queues + queue_size + queue_count]
+    ldr w2, [x24, #scheduler_queues + 2 * queue_size + queue_count]
+    ldr w3, [x24, #scheduler_queues + 3 * queue_size + queue_count]
+    add x0, x0, x1
+    add x2, x2, x3
+    add x0, x0, x2
+    str x0, [x23, #STATS_ROW_RUN_QUEUE]
+
+    // Hardware event totals, or zeros when not counting
+    add x0, x24, #scheduler_perf
+    ldar x0, [x0]
+    cmp x0, #1
+    cset x2, hi
+    str x2, [x23, #STATS_ROW_PERF_ENABLED]
+    add x0, x0, #PERF_TOTALS
+    add x1, x23, #STATS_ROW_PERF
+    mov x3, #0
+stats_snapshot_perf:
+    mov x4, #0
+    cbz x2, stats_snapshot_perf_store
+    ldr x4, [x0, x3]
+stats_snapshot_perf_store:
+    str x4, [x1, x3]
+    add x3, x3, #8
+    cmp x3, #PERF_PHASE_COUNT * PERF_EVENT_COUNT * 8
+    b.lo stats_snapshot_perf
+
+    // Add the row to the totals
+    add x0, x21, #STATS_HEADER_SIZE
+    mov x1, #0
+stats_snapshot_total:
+    ldr x2, [x23, x1]
+    ldr x3, [x0, x1]
+    add x3, x3, x2
+    str x3, [x0, x1]
+    add x1, x1, #8
+    cmp x1, #STATS_ROW_SIZE
+    b.lo stats_snapshot_total
+
+    add x22, x22, #1
+    add x23, x23, #STATS_ROW_SIZE
+    b stats_snapshot_core
+
+stats_snapshot_done:
+    mov x0, #1
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+stats_snapshot_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Stats Collect Row (internal)
+// ------------------------------------------------------------
+// Read one scheduler's counters into a snapshot row and report
+// whether the row already held exactly those values.
+//
+// Parameters:
+//   x0 (void*) - scheduler_state: One scheduler's state
+//   x1 (void*) - row: Snapshot row
+//
+// Returns:
+//   x0 (int) - unchanged: 1 if the previous pass read the same values
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x2-x15
+//
+stats_collect_row:
+    ldr x8, [x0, #scheduler_total_scheduled]
+    ldr x9, [x0, #scheduler_total_yields]
+    ldr x10, [x0, #scheduler_total_migrations]
+    ldr x11, [x0, #scheduler_total_steals]
+    ldr x12, [x0, #scheduler_steal_attempts]
+    ldr x13, [x0, #scheduler_total_blocks]
+    ldr x14, [x0, #scheduler_total_wakes]
+    ldr x15, [x0, #scheduler_idle_count]
+
+    ldp x2, x3, [x1, #STATS_ROW_SCHEDULED]
+    ldp x4, x5, [x1, #STATS_ROW_MIGRATIONS]
+    ldp x6, x7, [x1, #STATS_ROW_STEAL_ATTEMPTS]
+    cmp x2, x8
+    ccmp x3, x9, #0, eq
+    ccmp x4, x10, #0, eq
+    ccmp x5, x11, #0, eq
+    ldp x2, x3, [x1, #STATS_ROW_WAKES]
+    ccmp x6, x12, #0, eq
+    ccmp x7, x13, #0, eq
+    ccmp x2, x14, #0, eq
+    ccmp x3, x15, #0, eq
+    cset x0, eq
+
+    stp x8, x9, [x1, #STATS_ROW_SCHEDULED]
+    stp x10, x11, [x1, #STATS_ROW_MIGRATIONS]
+    stp x12, x13, [x1, #STATS_ROW_STEAL_ATTEMPTS]
+    stp x14, x15, [x1, #STATS_ROW_WAKES]
+    ret
+
+// ------------------------------------------------------------
+// Stats Format OpenMetrics
+// ------------------------------------------------------------
+// Write a snapshot as OpenMetrics text: a TYPE and HELP line per
+// metric family, one sample per scheduler labelled scheduler="N"
+// (counters carry the _total suffix), then "# EOF". When any scheduler
+// counts hardware events, actly_scheduler_perf_events_total follows
+// with one sample per scheduler, phase and event. The text is not
+// NUL-terminated.
+//
+// Parameters:
+//   x0 (void*) - snapshot: Snapshot from stats_snapshot
+//   x1 (char*) - buffer: Output buffer
+//   x2 (uint64_t) - capacity: Buffer size in bytes
+//
+// Returns:
+//   x0 (uint64_t) - length: Bytes written, or 0 if invalid or it did not fit
+//
+// Complexity: O(cores)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x1-x6
+//
+_stats_format_openmetrics:
+    cbz x0, stats_format_invalid
+    cbz x1, stats_format_invalid
+
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    stp x26, x27, [sp, #-16]!
+    stp x28, x29, [sp, #-16]!
+    mov x19, x0                       // snapshot
+    mov x20, x1                       // buffer start
+    mov x21, x1                       // cursor (0 once full)
+    add x22, x1, x2                   // buffer end
+    ldr x23, [x19, #STATS_CORES]
+    adr x24, stats_metric_table
+
+stats_format_family:
+    ldrb w25, [x24]                   // row offset, 0xFF ends the table
+    cmp w25, #0xFF
+    b.eq stats_format_perf
+    ldrb w26, [x24, #1]               // STATS_KIND_*
+    add x27, x24, #2                  // name
+    mov x2, x27
+    bl stats_skip_string
+    mov x28, x2                       // help
+    bl stats_skip_string
+    mov x24, x2                       // next record
+
+    // # TYPE name counter|gauge
+    mov x0, x21
+    mov x1, x22
+    adr x2, stats_text_type
+    bl stats_emit_string
+    mov x2, x27
+    bl stats_emit_string
+    adr x2, stats_text_counter
+    adr x3, stats_text_gauge
+    cmp w26, #STATS_KIND_COUNTER
+    csel x2, x2, x3, eq
+    bl stats_emit_string
+
+    // # HELP name text
+    adr x2, stats_text_help
+    bl stats_emit_string
+    mov x2, x27
+    bl stats_emit_string
+    adr x2, stats_text_space
+    bl stats_emit_string
+    mov x2, x28
+    bl stats_emit_string
+    adr x2, stats_text_newline
+    bl stats_emit_string
+    mov x21, x0
+
+    // One sample per scheduler
+    mov x28, #0                       // core
+stats_format_sample:
+    cmp x28, x23
+    b.hs stats_format_family
+    mov x0, x21
+    mov x1, x22
+    mov x2, x27
+    bl stats_emit_string
+    cmp w26, #STATS_KIND_COUNTER
+    b.ne stats_format_labels
+    adr x2, stats_text_total
+    bl stats_emit_string
+stats_format_labels:
+    adr x2, stats_text_label
+    bl stats_emit_string
+    mov x2, x28
+    bl stats_emit_decimal
+    adr x2, stats_text_label_end
+    bl stats_emit_string
+    add x3, x28, #1                   // row = first row after the totals
+    mov x4, #STATS_ROW_SIZE
+    mov x5, #STATS_HEADER_SIZE
+    madd x3, x3, x4, x5
+    add x3, x19, x3
+    ldr x2, [x3, x25]
+    bl stats_emit_decimal
+    adr x2, stats_text_newline
+    bl stats_emit_string
+    mov x21, x0
+    add x28, x28, #1
+    b stats_format_sample
+
+stats_format_perf:
+    // Hardware events, labelled by scheduler, phase and event
+    ldr x0, [x19, #STATS_HEADER_SIZE + STATS_ROW_PERF_ENABLED]
+    cbz x0, stats_format_eof
+    mov x0, x21
+    mov x1, x22
+    adr x2, stats_text_perf_family
+    bl stats_emit_string
+    mov x21, x0
+    mov x24, #0                       // core
+
+stats_format_perf_core:
+    cmp x24, x23
+    b.hs stats_format_eof
+    add x25, x24, #1                  // row = first row after the totals
+    mov x0, #STATS_ROW_SIZE
+    mov x1, #STATS_HEADER_SIZE
+    madd x25, x25, x0, x1
+    add x25, x19, x25
+    ldr x0, [x25, #STATS_ROW_PERF_ENABLED]
+    cbz x0, stats_format_perf_next_core
+    mov x26, #0                       // phase * PERF_EVENT_COUNT + event
+
+stats_format_perf_sample:
+    cmp x26, #PERF_PHASE_COUNT * PERF_EVENT_COUNT
+    b.hs stats_format_perf_next_core
+    mov x0, x21
+    mov x1, x22
+    adr x2, stats_text_perf_sample
+    bl stats_emit_string
+    mov x2, x24
+    bl stats_emit_decimal
+    adr x2, stats_text_perf_phase
+    bl stats_emit_string
+    mov x4, #PERF_EVENT_COUNT
+    udiv x27, x26, x4                 // phase
+    msub x28, x27, x4, x26            // event
+    adr x2, stats_perf_phase_names
+stats_format_perf_phase_name:
+    cbz x27, stats_format_perf_phase_found
+    bl stats_skip_string
+    sub x27, x27, #1
+    b stats_format_perf_phase_name
+stats_format_perf_phase_found:
+    bl stats_emit_string
+    adr x2, stats_text_perf_event
+    bl stats_emit_string
+    adr x2, stats_perf_event_names
+stats_format_perf_event_name:
+    cbz x28, stats_format_perf_event_found
+    bl stats_skip_string
+    sub x28, x28, #1
+    b stats_format_perf_event_name
+stats_format_perf_event_found:
+    bl stats_emit_string
+    adr x2, stats_text_label_end
+    bl stats_emit_string
+    add x2, x25, x26, lsl #3
+    ldr x2, [x2, #STATS_ROW_PERF]
+    bl stats_emit_decimal
+    adr x2, stats_text_newline
+    bl stats_emit_string
+    mov x21, x0
+    add x26, x26, #1
+    b stats_format_perf_sample
+
+stats_format_perf_next_core:
+    add x24, x24, #1
+    b stats_format_perf_core
+
+stats_format_eof:
+    mov x0, x21
+    mov x1, x22
+    adr x2, stats_text_eof
+    bl stats_emit_string
+    cbz x0, stats_format_full
+    sub x0, x0, x20
+    b stats_format_return
+
+stats_format_full:
+    mov x0, #0
+
+stats_format_return:
+    ldp x28, x29, [sp], #16
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+stats_format_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Stats Emit String (internal)
+// ------------------------------------------------------------
+// Append a NUL-terminated string at the cursor.
+//
+// Parameters:
+//   x0 (char*) - cursor: Next free byte, or 0 if the buffer is full
+//   x1 (char*) - end: One past the last usable byte (preserved)
+//   x2 (char*) - string: NUL-terminated string
+//
+// Returns:
+//   x0 (char*) - cursor: Advanced cursor, or 0 if it did not fit
+//
+// Complexity: O(n) in string length
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x2, x3
+//
+stats_emit_string:
+    cbz x0, stats_emit_string_done
+stats_emit_string_byte:
+    ldrb w3, [x2], #1
+    cbz w3, stats_emit_string_done
+    cmp x0, x1
+    b.hs stats_emit_string_full
+    strb w3, [x0], #1
+    b stats_emit_string_byte
+
+stats_emit_string_full:
+    mov x0, #0
+stats_emit_string_done:
+    ret
+
+// ------------------------------------------------------------
+// Stats Emit Decimal (internal)
+// ------------------------------------------------------------
+// Append an unsigned value in decimal at the cursor.
+//
+// Parameters:
+//   x0 (char*) - cursor: Next free byte, or 0 if the buffer is full
+//   x1 (char*) - end: One past the last usable byte (preserved)
+//   x2 (uint64_t) - value: Value to write
+//
+// Returns:
+//   x0 (char*) - cursor: Advanced cursor, or 0 if it did not fit
+//
+// Complexity: O(digits)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x2-x6
+//
+stats_emit_decimal:
+    cbz x0, stats_emit_decimal_return
+    sub sp, sp, #32                   // Digits are built backwards here
+    add x4, sp, #32
+    mov x6, #10
+stats_emit_decimal_digit:
+    udiv x5, x2, x6
+    msub x3, x5, x6, x2
+    add w3, w3, #48                   // '0'
+    strb w3, [x4, #-1]!
+    mov x2, x5
+    cbnz x2, stats_emit_decimal_digit
+
+    add x5, sp, #32
+stats_emit_decimal_copy:
+    cmp x4, x5
+    b.hs stats_emit_decimal_done
+    cmp x0, x1
+    b.hs stats_emit_decimal_full
+    ldrb w3, [x4], #1
+    strb w3, [x0], #1
+    b stats_emit_decimal_copy
+
+stats_emit_decimal_full:
+    mov x0, #0
+stats_emit_decimal_done:
+    add sp, sp, #32
+stats_emit_decimal_return:
+    ret
+
+// ------------------------------------------------------------
+// Stats Skip String (internal)
+// ------------------------------------------------------------
+// Step past a NUL-terminated string in the metric table.
+//
+// Parameters:
+//   x2 (char*) - string: Start of the string
+//
+// Returns:
+//   x2 (char*) - next: Byte after the string's NUL
+//
+// Complexity: O(n) in string length
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x3
+//
+stats_skip_string:
+    ldrb w3, [x2], #1
+    cbnz w3, stats_skip_string
+    ret
+
+// ------------------------------------------------------------
+// Stats Server Start
+// ------------------------------------------------------------
+// Serve the statistics of schedulers 0 to cores-1 on a Unix socket
+// at `path`. A thread accepts one connection at a time, takes a fresh
+// snapshot and answers with an HTTP/1.0 response carrying the
+// OpenMetrics text, so `curl --unix-socket` and scrapers that speak
+// HTTP over Unix sockets both work. The request itself is ignored.
+// The path must not exist yet; stats_server_stop removes it.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - cores: Schedulers to report (1 to MAX_CORES)
+//   x2 (const char*) - path: Socket path
+//
+// Returns:
+//   x0 (void*) - server: Server handle, or NULL on invalid arguments,
+//                a path that is too long or in use, or a socket error
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_stats_server_start:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+
+    cbz x0, stats_server_start_invalid
+    cbz x1, stats_server_start_invalid
+    cmp x1, #MAX_CORES
+    b.hi stats_server_start_invalid
+    cbz x2, stats_server_start_invalid
+    mov x19, x0  // scheduler_states
+    mov x20, x1  // cores
+    mov x21, x2  // path
+
+    // The path and its NUL must fit in sun_path
+    mov x3, #0
+stats_server_start_path_length:
+    ldrb w4, [x21, x3]
+    cbz w4, stats_server_start_path_checked
+    add x3, x3, #1
+    cmp x3, #SOCKADDR_UN_SIZE - SUN_PATH_OFFSET
+    b.lo stats_server_start_path_length
+    b stats_server_start_invalid
+stats_server_start_path_checked:
+    cbz x3, stats_server_start_invalid
+
+    // Server mapping
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, #server_size              // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq stats_server_start_invalid
+    mov x22, x0  // server
+    stp x19, x20, [x22, #server_states]
+    str wzr, [x22, #server_stop]
+
+    // Socket address
+    add x0, x22, #server_addr
+.ifdef ACTLY_LINUX
+    mov w1, #AF_UNIX
+    strh w1, [x0]
+.else
+    mov w1, #SOCKADDR_UN_SIZE
+    strb w1, [x0]
+    mov w1, #AF_UNIX
+    strb w1, [x0, #1]
+.endif
+    add x0, x0, #SUN_PATH_OFFSET
+stats_server_start_copy_path:
+    ldrb w1, [x21], #1
+    strb w1, [x0], #1
+    cbnz w1, stats_server_start_copy_path
+
+    // Listening socket
+    mov x0, #AF_UNIX
+    mov x1, #SOCK_STREAM
+    mov x2, #0
+    bl _socket
+    tbnz w0, #31, stats_server_start_unmap
+    str w0, [x22, #server_listen_fd]
+    mov w23, w0
+
+    mov w0, w23
+    add x1, x22, #server_addr
+    mov x2, #SOCKADDR_UN_SIZE
+    bl _bind
+    cbnz w0, stats_server_start_close
+
+    mov w0, w23
+    mov x1, #STATS_LISTEN_BACKLOG
+    bl _listen
+    cbnz w0, stats_server_start_unlink
+
+    add x0, x22, #server_thread
+    mov x1, xzr                       // default attributes
+    adr x2, stats_server_thread
+    mov x3, x22
+    bl _pthread_create
+    cbnz w0, stats_server_start_unlink
+
+    mov x0, x22
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+stats_server_start_unlink:
+    add x0, x22, #server_addr + SUN_PATH_OFFSET
+    bl _unlink
+stats_server_start_close:
+    mov w0, w23
+    bl _close
+stats_server_start_unmap:
+    mov x0, x22
+    mov x1, #server_size
+    bl _munmap
+stats_server_start_invalid:
+    mov x0, #0
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Stats Server Thread (internal)
+// ------------------------------------------------------------
+// pthread entry point for the metrics server: accept, snapshot,
+// format, respond, close, until stats_server_stop sets the stop flag.
+//
+// Parameters:
+//   x0 (void*) - server: Server handle
+//
+// Returns:
+//   x0 (void*) - result: Always NULL
+//
+// Complexity: Runs until the server is stopped
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+stats_server_thread:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0  // server
+
+stats_server_accept:
+    ldr w0, [x19, #server_listen_fd]
+    mov x1, xzr
+    mov x2, xzr
+    bl _accept
+    sxtw x20, w0                      // connection, or -1
+    add x1, x19, #server_stop
+    ldar w1, [x1]
+    cbnz w1, stats_server_exit
+    tbnz x20, #63, stats_server_accept
+
+.ifndef ACTLY_LINUX
+    // A client that hangs up early must not raise SIGPIPE
+    sub sp, sp, #16
+    mov w0, #1
+    str w0, [sp]
+    mov x0, x20
+    mov x1, #SOL_SOCKET
+    mov x2, #SO_NOSIGPIPE
+    mov x3, sp
+    mov x4, #4
+    bl _setsockopt
+    add sp, sp, #16
+.endif
+
+    // Read (and ignore) the request
+    mov x0, x20
+    add x1, x19, #server_text
+    mov x2, #STATS_REQUEST_MAX
+    bl _read
+
+    ldp x0, x1, [x19, #server_states]
+    add x2, x19, #server_snapshot
+    bl _stats_snapshot
+    add x0, x19, #server_snapshot
+    add x1, x19, #server_text
+    mov x2, #server_text_size
+    bl _stats_format_openmetrics
+    mov x21, x0  // body length
+
+    adr x2, stats_http_header
+    bl stats_skip_string
+    adr x1, stats_http_header
+    sub x2, x2, x1
+    sub x2, x2, #1                    // Header length without its NUL
+    mov x0, x20
+    bl stats_send_all
+    cbz x0, stats_server_close
+    mov x0, x20
+    add x1, x19, #server_text
+    mov x2, x21
+    bl stats_send_all
+
+stats_server_close:
+    mov x0, x20
+    bl _close
+    b stats_server_accept
+
+stats_server_exit:
+    tbnz x20, #63, stats_server_exited
+    mov x0, x20
+    bl _close
+stats_server_exited:
+    mov x0, #0
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Stats Send All (internal)
+// ------------------------------------------------------------
+// Send a whole buffer on a connected socket, retrying short sends.
+//
+// Parameters:
+//   x0 (int) - fd: Connected socket
+//   x1 (const void*) - buffer: Bytes to send
+//   x2 (uint64_t) - length: Byte count
+//
+// Returns:
+//   x0 (int) - success: 1 if every byte was sent, 0 on error
+//
+// Complexity: O(n) in length
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+stats_send_all:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0  // fd
+    mov x20, x1  // buffer
+    mov x21, x2  // remaining
+
+stats_send_all_loop:
+    cbz x21, stats_send_all_done
+    mov x0, x19
+    mov x1, x20
+    mov x2, x21
+    mov x3, #SEND_FLAGS
+    bl _send
+    cmp x0, #0
+    b.le stats_send_all_failed
+    add x20, x20, x0
+    sub x21, x21, x0
+    b stats_send_all_loop
+
+stats_send_all_done:
+    mov x0, #1
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+stats_send_all_failed:
+    mov x0, #0
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Stats Server Stop
+// ------------------------------------------------------------
+// Stop the metrics server: set the stop flag, wake the thread's
+// accept with a connection of its own, join the thread, then close
+// and remove the socket and release the server.
+//
+// Parameters:
+//   x0 (void*) - server: Handle from stats_server_start
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 for a NULL server
+//
+// Complexity: O(1), plus the wait for a response in progress
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_stats_server_stop:
+    cbz x0, stats_server_stop_invalid
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0  // server
+
+    mov w0, #1
+    add x1, x19, #server_stop
+    stlr w0, [x1]
+
+    // Wake the accept
+    mov x0, #AF_UNIX
+    mov x1, #SOCK_STREAM
+    mov x2, #0
+    bl _socket
+    sxtw x20, w0
+    tbnz x20, #63, stats_server_stop_join
+    mov x0, x20
+    add x1, x19, #server_addr
+    mov x2, #SOCKADDR_UN_SIZE
+    bl _connect
+    mov x0, x20
+    bl _close
+
+stats_server_stop_join:
+    ldr x0, [x19, #server_thread]
+    mov x1, xzr
+    bl _pthread_join
+    ldr w0, [x19, #server_listen_fd]
+    bl _close
+    add x0, x19, #server_addr + SUN_PATH_OFFSET
+    bl _unlink
+    mov x0, x19
+    mov x1, #server_size
+    bl _munmap
+
+    mov x0, #1
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+stats_server_stop_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Metric Table and Response Text
+// ------------------------------------------------------------
+// One record per metric family: snapshot row offset, STATS_KIND_*,
+// then the NUL-terminated name and help text. 0xFF ends the table.
+// Kept in the text section so it is reached with adr.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+stats_metric_table:
+    .byte STATS_ROW_SCHEDULED, STATS_KIND_COUNTER
+    .asciz "actly_scheduler_dispatches"
+    .asciz "Processes dispatched by the scheduler."
+    .byte STATS_ROW_YIELDS, STATS_KIND_COUNTER
+    .asciz "actly_scheduler_yields"
+    .asciz "Voluntary yields."
+    .byte STATS_ROW_MIGRATIONS, STATS_KIND_COUNTER
+    .asciz "actly_scheduler_migrations"
+    .asciz "Processes migrated to the scheduler."
+    .byte STATS_ROW_STEALS, STATS_KIND_COUNTER
+    .asciz "actly_scheduler_steals"
+    .asciz "Processes stolen by the scheduler."
+    .byte STATS_ROW_STEAL_ATTEMPTS, STATS_KIND_COUNTER
+    .asciz "actly_scheduler_steal_attempts"
+    .asciz "Steal attempts made by the scheduler."
+    .byte STATS_ROW_BLOCKS, STATS_KIND_COUNTER
+    .asciz "actly_scheduler_blocks"
+    .asciz "Processes blocked on receive, timer or I/O."
+    .byte STATS_ROW_WAKES, STATS_KIND_COUNTER
+    .asciz "actly_scheduler_wakes"
+    .asciz "Blocked processes woken."
+    .byte STATS_ROW_IDLE_LOOPS, STATS_KIND_COUNTER
+    .asciz "actly_scheduler_idle_loops"
+    .asciz "Main loop passes that found no work."
+    .byte STATS_ROW_RUN_QUEUE, STATS_KIND_GAUGE
+    .asciz "actly_scheduler_run_queue_length"
+    .asciz "Runnable processes queued."
+    .byte 0xFF
+
+// PERF_PHASE_* and PERF_EVENT_* label values, in order
+stats_perf_phase_names:
+    .asciz "dispatch"
+    .asciz "steal"
+    .asciz "message"
+    .asciz "gc"
+    .asciz "timer"
+stats_perf_event_names:
+    .asciz "cycles"
+    .asciz "instructions"
+    .asciz "l1d_misses"
+    .asciz "llc_misses"
+    .asciz "branch_misses"
+
+stats_text_type:
+    .asciz "# TYPE "
+stats_text_help:
+    .asciz "# HELP "
+stats_text_counter:
+    .asciz " counter\n"
+stats_text_gauge:
+    .asciz " gauge\n"
+stats_text_space:
+    .asciz " "
+stats_text_newline:
+    .asciz "\n"
+stats_text_total:
+    .asciz "_total"
+stats_text_label:
+    .asciz "{scheduler=\""
+stats_text_label_end:
+    .asciz "\"} "
+stats_text_perf_family:
+    .asciz "# TYPE actly_scheduler_perf_events counter\n# HELP actly_scheduler_perf_events Hardware events counted in each runtime phase.\n"
+stats_text_perf_sample:
+    .asciz "actly_scheduler_perf_events_total{scheduler=\""
+stats_text_perf_phase:
+    .asciz "\",phase=\""
+stats_text_perf_event:
+    .asciz "\",event=\""
+stats_text_eof:
+    .asciz "# EOF\n"
+stats_http_header:
+    .asciz "HTTP/1.0 200 OK\r\nContent-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\nConnection: close\r\n\r\n"
+    .align 4
+
+// Import required functions from other modules
+    .extern _mmap
+    .extern _munmap
+    .extern _socket
+    .extern _bind
+    .extern _listen
+    .extern _accept
+    .extern _connect
+    .extern _read
+    .extern _send
+    .extern _close
+    .extern _unlink
+    .extern _pthread_create
+    .extern _pthread_join
+.ifndef ACTLY_LINUX
+    .extern _setsockopt
+.endif
+
+// ------------------------------------------------------------
+// Constant Definitions for C Code
+// ------------------------------------------------------------
+    .data
+    .align 3
+
+_STATS_HEADER_SIZE_CONST:
+    .quad STATS_HEADER_SIZE
+
+_STATS_ROW_PERF_OFFSET_CONST:
+    .quad STATS_ROW_PERF
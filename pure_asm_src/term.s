@@ -0,0 +1,1155 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// term.s — Tagged-Word Terms on Process Heaps
+// ------------------------------------------------------------
+// The runtime's native value format. A term is one 64-bit word whose
+// low three bits say what it is; the primary tags are one-hot so every
+// class test is a single instruction:
+//
+//   xxx...000  small integer, value << 3       tst  x, #TERM_TAG_MASK
+//   xxx...001  boxed object, address + 1       tbnz x, #TERM_BIT_BOXED
+//   xxx...010  cons cell, address + 2          tbnz x, #TERM_BIT_LIST
+//   xxx...100  immediate (atom, pid, special)  tbnz x, #TERM_BIT_IMMEDIATE
+//
+// Immediates carry a subtag in bits 3-4 and their payload from bit 5:
+// atoms (index into the atom table; 0 is @false, 1 is @true), pids and
+// the specials [] (TERM_NIL) and TERM_NONE, which no constructor ever
+// produces as a value and which every function here returns on failure.
+// Small integers add and subtract without untagging.
+//
+// Boxed objects start with a header word (size << 8 | kind << 3 | 110)
+// followed by their body: a tuple's element terms, a binary's bytes
+// zero-padded to a word, a map node's key/value pairs (map.s keeps
+// the node's slot bitmap and pair count in its header, so the body is
+// plain terms), a B+ tree node's count, keys and slots (btree.s) or
+// a finger tree object or chunked deque (finger.s), or a frozen set's
+// address (set.s, page-aligned so it reads as a small integer), all of
+// which are sized like a tuple's elements. A cons cell is two bare
+// words (head, tail).
+// Header low bits 110 are never a valid term, so a heap region built
+// here can be walked object by object (_term_heap_next) by the
+// collector without any side tables.
+//
+// Objects are bump-allocated from the owning PCB's heap_pointer /
+// heap_limit. Allocation never triggers a collection (the collector
+// does not know a process's roots yet): constructors return TERM_NONE
+// when the heap is full. Terms never point between heaps, so
+// _term_copy sizes a term first and then copies it into another
+// process's heap in one allocation, the way a message body moves.
+//
+// The file provides:
+//   - Small integer, atom and pid immediates
+//   - Tuple, list and binary construction on a PCB heap
+//   - Type dispatch and element access
+//   - Map nodes in size, copy, equality and heap walks
+//   - Deep size, copy between heaps and structural equality
+//   - Linear heap walking
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// Include the PCB layout
+    .include "pcb.inc"
+
+// ------------------------------------------------------------
+// Term Function Exports
+// ------------------------------------------------------------
+// Export the term functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _term_make_int
+    .global _term_int_value
+    .global _term_make_atom
+    .global _term_atom_index
+    .global _term_make_pid
+    .global _term_pid_value
+    .global _term_type
+    .global _term_tuple
+    .global _term_tuple_arity
+    .global _term_element
+    .global _term_set_element
+    .global _term_cons
+    .global _term_head
+    .global _term_tail
+    .global _term_binary
+    .global _term_binary_size
+    .global _term_binary_data
+    .global _term_size
+    .global _term_copy
+    .global _term_equal
+    .global _term_heap_next
+
+// ------------------------------------------------------------
+// Term Make Int
+// ------------------------------------------------------------
+// Tag a signed integer as a small integer.
+//
+// Parameters:
+//   x0 (int64_t) - value: Integer, -2^60 to 2^60 - 1
+//
+// Returns:
+//   x0 (term_t) - term: Small integer, or TERM_NONE if out of range
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_make_int:
+    lsl x1, x0, #TERM_INT_SHIFT
+    asr x2, x1, #TERM_INT_SHIFT
+    cmp x2, x0                        // Lost bits: does not fit
+    b.ne term_return_none
+    mov x0, x1
+    ret
+
+// Shared failure return for the leaf functions
+term_return_none:
+    mov x0, #TERM_NONE
+    ret
+
+// ------------------------------------------------------------
+// Term Int Value
+// ------------------------------------------------------------
+// Untag a small integer. The term must be a small integer.
+//
+// Parameters:
+//   x0 (term_t) - term: Small integer
+//
+// Returns:
+//   x0 (int64_t) - value: Signed integer
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_int_value:
+    asr x0, x0, #TERM_INT_SHIFT
+    ret
+
+// ------------------------------------------------------------
+// Term Make Atom
+// ------------------------------------------------------------
+// Make an atom immediate from an atom table index.
+//
+// Parameters:
+//   x0 (uint64_t) - index: Atom index, below 2^59
+//
+// Returns:
+//   x0 (term_t) - term: Atom, or TERM_NONE if the index is too large
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_make_atom:
+    lsr x1, x0, #(64 - TERM_IMM_SHIFT)
+    cbnz x1, term_return_none
+    lsl x0, x0, #TERM_IMM_SHIFT
+    orr x0, x0, #TERM_IMM_ATOM
+    ret
+
+// ------------------------------------------------------------
+// Term Atom Index
+// ------------------------------------------------------------
+// Atom table index of an atom. The term must be an atom.
+//
+// Parameters:
+//   x0 (term_t) - term: Atom
+//
+// Returns:
+//   x0 (uint64_t) - index: Atom index
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_atom_index:
+    lsr x0, x0, #TERM_IMM_SHIFT
+    ret
+
+// ------------------------------------------------------------
+// Term Make Pid
+// ------------------------------------------------------------
+// Make a pid immediate from a process ID.
+//
+// Parameters:
+//   x0 (uint64_t) - pid: Process ID, below 2^59
+//
+// Returns:
+//   x0 (term_t) - term: Pid, or TERM_NONE if the ID is too large
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_make_pid:
+    lsr x1, x0, #(64 - TERM_IMM_SHIFT)
+    cbnz x1, term_return_none
+    lsl x0, x0, #TERM_IMM_SHIFT
+    orr x0, x0, #TERM_IMM_PID
+    ret
+
+// ------------------------------------------------------------
+// Term Pid Value
+// ------------------------------------------------------------
+// Process ID of a pid. The term must be a pid.
+//
+// Parameters:
+//   x0 (term_t) - term: Pid
+//
+// Returns:
+//   x0 (uint64_t) - pid: Process ID
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_pid_value:
+    lsr x0, x0, #TERM_IMM_SHIFT
+    ret
+
+// ------------------------------------------------------------
+// Term Type
+// ------------------------------------------------------------
+// Classify a term for dispatch. Code that only needs one class should
+// test the tag bits directly instead (see the file header).
+//
+// Parameters:
+//   x0 (term_t) - term: Any word
+//
+// Returns:
+//   x0 (uint64_t) - type: TERM_TYPE_*, TERM_TYPE_NONE for TERM_NONE and
+//                   for words that are not terms
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_type:
+    tst x0, #TERM_TAG_MASK
+    b.eq term_type_int
+    tbnz x0, #TERM_BIT_BOXED, term_type_boxed
+    tbnz x0, #TERM_BIT_LIST, term_type_list
+
+    // Immediates: subtag first, then the specials by value
+    and x1, x0, #TERM_IMM_MASK
+    cmp x1, #TERM_IMM_ATOM
+    b.eq term_type_atom
+    cmp x1, #TERM_IMM_PID
+    b.eq term_type_pid
+    cmp x0, #TERM_NIL
+    b.eq term_type_nil
+    mov x0, #TERM_TYPE_NONE
+    ret
+
+term_type_int:
+    mov x0, #TERM_TYPE_INT
+    ret
+
+term_type_atom:
+    mov x0, #TERM_TYPE_ATOM
+    ret
+
+term_type_pid:
+    mov x0, #TERM_TYPE_PID
+    ret
+
+term_type_nil:
+    mov x0, #TERM_TYPE_NIL
+    ret
+
+term_type_list:
+    mov x0, #TERM_TYPE_LIST
+    ret
+
+term_type_boxed:
+    ldur x1, [x0, #-TERM_TAG_BOXED]   // Header
+    ubfx x1, x1, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    cmp x1, #TERM_KIND_TUPLE
+    b.eq term_type_tuple
+    cmp x1, #TERM_KIND_BINARY
+    b.eq term_type_binary
+    cmp x1, #TERM_KIND_MAP
+    b.eq term_type_map
+    cmp x1, #TERM_KIND_BTREE
+    b.eq term_type_btree
+    cmp x1, #TERM_KIND_FINGER
+    b.eq term_type_finger
+    cmp x1, #TERM_KIND_DEQUE
+    b.eq term_type_deque
+    cmp x1, #TERM_KIND_SET
+    b.eq term_type_set
+    mov x0, #TERM_TYPE_NONE
+    ret
+
+term_type_tuple:
+    mov x0, #TERM_TYPE_TUPLE
+    ret
+
+term_type_binary:
+    mov x0, #TERM_TYPE_BINARY
+    ret
+
+term_type_map:
+    mov x0, #TERM_TYPE_MAP
+    ret
+
+term_type_btree:
+    mov x0, #TERM_TYPE_BTREE
+    ret
+
+term_type_finger:
+    mov x0, #TERM_TYPE_FINGER
+    ret
+
+term_type_deque:
+    mov x0, #TERM_TYPE_DEQUE
+    ret
+
+term_type_set:
+    mov x0, #TERM_TYPE_SET
+    ret
+
+// ------------------------------------------------------------
+// Term Alloc (internal)
+// ------------------------------------------------------------
+// Bump-allocate words from a PCB heap. Never collects.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (uint64_t) - words: Words to allocate
+//
+// Returns:
+//   x0 (uint64_t*) - object: Word-aligned memory, or NULL if the heap
+//                    is full or pcb is NULL
+//
+// Clobbers: x2-x4
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+term_alloc:
+    cbz x0, term_alloc_failed
+    lsr x2, x1, #TERM_MAX_WORDS_SHIFT
+    cbnz x2, term_alloc_failed
+    ldr x2, [x0, #pcb_heap_pointer]
+    add x2, x2, #(HEAP_ALIGNMENT - 1)
+    and x2, x2, #~(HEAP_ALIGNMENT - 1)
+    ldr x3, [x0, #pcb_heap_limit]
+    add x4, x2, x1, lsl #3
+    cmp x4, x3
+    b.hi term_alloc_failed
+    str x4, [x0, #pcb_heap_pointer]
+    mov x0, x2
+    ret
+
+term_alloc_failed:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Term Tuple
+// ------------------------------------------------------------
+// Allocate a tuple on a process heap with every element set to
+// TERM_NIL; fill it with _term_set_element before sharing it.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (uint64_t) - arity: Number of elements (0 allowed)
+//
+// Returns:
+//   x0 (term_t) - tuple: Boxed tuple, or TERM_NONE if the heap is full
+//
+// Complexity: O(arity)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_tuple:
+    stp x19, x30, [sp, #-16]!
+    mov x19, x1                       // arity
+    add x1, x1, #1                    // Header + elements
+    bl term_alloc
+    cbz x0, term_tuple_failed
+
+    lsl x2, x19, #TERM_HEADER_ARITY_SHIFT
+    orr x2, x2, #TERM_HEADER_TUPLE
+    str x2, [x0]
+    mov x2, #TERM_NIL
+    add x3, x0, #8
+term_tuple_fill:
+    cbz x19, term_tuple_done
+    str x2, [x3], #8
+    sub x19, x19, #1
+    b term_tuple_fill
+
+term_tuple_done:
+    orr x0, x0, #TERM_TAG_BOXED
+    ldp x19, x30, [sp], #16
+    ret
+
+term_tuple_failed:
+    mov x0, #TERM_NONE
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Term Tuple Arity
+// ------------------------------------------------------------
+// Number of elements in a tuple.
+//
+// Parameters:
+//   x0 (term_t) - term: Any term
+//
+// Returns:
+//   x0 (uint64_t) - arity: Elements, 0 if the term is not a tuple
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_tuple_arity:
+    tbz x0, #TERM_BIT_BOXED, term_tuple_arity_none
+    ldur x1, [x0, #-TERM_TAG_BOXED]
+    ubfx x2, x1, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    cmp x2, #TERM_KIND_TUPLE
+    b.ne term_tuple_arity_none
+    lsr x0, x1, #TERM_HEADER_ARITY_SHIFT
+    ret
+
+term_tuple_arity_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Term Element
+// ------------------------------------------------------------
+// Read a tuple element.
+//
+// Parameters:
+//   x0 (term_t) - tuple: Tuple term
+//   x1 (uint64_t) - index: Element index from 0
+//
+// Returns:
+//   x0 (term_t) - element: The element, or TERM_NONE if the term is not
+//                 a tuple or the index is out of range
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_element:
+    tbz x0, #TERM_BIT_BOXED, term_return_none
+    ldur x2, [x0, #-TERM_TAG_BOXED]
+    ubfx x3, x2, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    cmp x3, #TERM_KIND_TUPLE
+    b.ne term_return_none
+    cmp x1, x2, lsr #TERM_HEADER_ARITY_SHIFT
+    b.hs term_return_none
+    add x0, x0, x1, lsl #3
+    ldur x0, [x0, #(8 - TERM_TAG_BOXED)]
+    ret
+
+// ------------------------------------------------------------
+// Term Set Element
+// ------------------------------------------------------------
+// Write a tuple element while building a tuple. Terms are immutable
+// once another process or structure can see them.
+//
+// Parameters:
+//   x0 (term_t) - tuple: Tuple term
+//   x1 (uint64_t) - index: Element index from 0
+//   x2 (term_t) - value: Element term on the same heap, or an immediate
+//
+// Returns:
+//   x0 (int) - success: 1 if written, 0 if not a tuple or out of range
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_set_element:
+    tbz x0, #TERM_BIT_BOXED, term_set_element_failed
+    ldur x3, [x0, #-TERM_TAG_BOXED]
+    ubfx x4, x3, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    cmp x4, #TERM_KIND_TUPLE
+    b.ne term_set_element_failed
+    cmp x1, x3, lsr #TERM_HEADER_ARITY_SHIFT
+    b.hs term_set_element_failed
+    add x0, x0, x1, lsl #3
+    stur x2, [x0, #(8 - TERM_TAG_BOXED)]
+    mov x0, #1
+    ret
+
+term_set_element_failed:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Term Cons
+// ------------------------------------------------------------
+// Allocate a cons cell [head | tail] on a process heap. A proper list
+// ends in TERM_NIL.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (term_t) - head: Head term
+//   x2 (term_t) - tail: Tail term
+//
+// Returns:
+//   x0 (term_t) - list: List term, or TERM_NONE if the heap is full
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_cons:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x1
+    mov x20, x2
+    mov x1, #2
+    bl term_alloc
+    cbz x0, term_cons_failed
+    stp x19, x20, [x0]
+    orr x0, x0, #TERM_TAG_LIST
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+term_cons_failed:
+    mov x0, #TERM_NONE
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Term Head
+// ------------------------------------------------------------
+// Head of a cons cell.
+//
+// Parameters:
+//   x0 (term_t) - list: Any term
+//
+// Returns:
+//   x0 (term_t) - head: The head, or TERM_NONE if not a cons cell
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_head:
+    tbz x0, #TERM_BIT_LIST, term_return_none
+    ldur x0, [x0, #-TERM_TAG_LIST]
+    ret
+
+// ------------------------------------------------------------
+// Term Tail
+// ------------------------------------------------------------
+// Tail of a cons cell.
+//
+// Parameters:
+//   x0 (term_t) - list: Any term
+//
+// Returns:
+//   x0 (term_t) - tail: The tail, or TERM_NONE if not a cons cell
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_tail:
+    tbz x0, #TERM_BIT_LIST, term_return_none
+    ldur x0, [x0, #(8 - TERM_TAG_LIST)]
+    ret
+
+// ------------------------------------------------------------
+// Term Binary
+// ------------------------------------------------------------
+// Allocate a binary on a process heap and copy bytes into it. The
+// last word is zero-padded so binaries compare and copy by word.
+//
+// Parameters:
+//   x0 (void*) - pcb: Owning process
+//   x1 (const uint8_t*) - data: Bytes to copy (may be NULL if length is 0)
+//   x2 (uint64_t) - length: Byte count
+//
+// Returns:
+//   x0 (term_t) - binary: Boxed binary, or TERM_NONE if data is NULL
+//                 with a length or the heap is full
+//
+// Complexity: O(length)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_binary:
+    cbz x2, term_binary_start
+    cbz x1, term_return_none
+term_binary_start:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x1                       // data
+    mov x20, x2                       // length
+    add x21, x2, #7
+    lsr x21, x21, #3                  // Body words
+    add x1, x21, #1
+    bl term_alloc
+    cbz x0, term_binary_failed
+
+    lsl x2, x20, #TERM_HEADER_ARITY_SHIFT
+    orr x2, x2, #TERM_HEADER_BINARY
+    str x2, [x0]
+    cbz x21, term_binary_done
+    str xzr, [x0, x21, lsl #3]        // Zero the padding of the last word
+
+    // Whole words, then the remaining bytes
+    add x3, x0, #8
+    lsr x4, x20, #3
+term_binary_words:
+    cbz x4, term_binary_bytes_start
+    ldr x5, [x19], #8
+    str x5, [x3], #8
+    sub x4, x4, #1
+    b term_binary_words
+
+term_binary_bytes_start:
+    and x4, x20, #7
+term_binary_bytes:
+    cbz x4, term_binary_done
+    ldrb w5, [x19], #1
+    strb w5, [x3], #1
+    sub x4, x4, #1
+    b term_binary_bytes
+
+term_binary_done:
+    orr x0, x0, #TERM_TAG_BOXED
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+term_binary_failed:
+    mov x0, #TERM_NONE
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Term Binary Size
+// ------------------------------------------------------------
+// Byte length of a binary.
+//
+// Parameters:
+//   x0 (term_t) - term: Any term
+//
+// Returns:
+//   x0 (uint64_t) - length: Bytes, 0 if the term is not a binary
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_binary_size:
+    tbz x0, #TERM_BIT_BOXED, term_binary_size_none
+    ldur x1, [x0, #-TERM_TAG_BOXED]
+    ubfx x2, x1, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    cmp x2, #TERM_KIND_BINARY
+    b.ne term_binary_size_none
+    lsr x0, x1, #TERM_HEADER_ARITY_SHIFT
+    ret
+
+term_binary_size_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Term Binary Data
+// ------------------------------------------------------------
+// Address of a binary's bytes, valid while the term is live.
+//
+// Parameters:
+//   x0 (term_t) - term: Any term
+//
+// Returns:
+//   x0 (const uint8_t*) - data: The bytes, or NULL if not a binary
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_binary_data:
+    tbz x0, #TERM_BIT_BOXED, term_binary_data_none
+    ldur x1, [x0, #-TERM_TAG_BOXED]
+    ubfx x1, x1, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    cmp x1, #TERM_KIND_BINARY
+    b.ne term_binary_data_none
+    add x0, x0, #(8 - TERM_TAG_BOXED)
+    ret
+
+term_binary_data_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Term Size
+// ------------------------------------------------------------
+// Heap words a deep copy of a term needs: headers, bodies and cons
+// cells reachable from it. Immediates and small integers need none.
+// Shared subterms are counted once per path, as _term_copy copies them.
+//
+// Parameters:
+//   x0 (term_t) - term: Any term
+//
+// Returns:
+//   x0 (uint64_t) - words: Words needed
+//
+// Complexity: O(size); recursion depth follows tuple nesting, list
+//             spines are walked iteratively
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_size:
+    tst x0, #TERM_POINTER_MASK
+    b.ne term_size_heap
+    mov x0, #0
+    ret
+
+term_size_heap:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, #0                       // Words so far
+
+term_size_next:
+    tst x0, #TERM_POINTER_MASK
+    b.eq term_size_done
+    tbnz x0, #TERM_BIT_LIST, term_size_list
+
+    // Boxed: header plus body
+    ldur x1, [x0, #-TERM_TAG_BOXED]
+    lsr x2, x1, #TERM_HEADER_ARITY_SHIFT
+    ubfx x3, x1, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    add x19, x19, #1
+    cmp x3, #TERM_KIND_BINARY
+    b.ne term_size_terms
+    add x2, x2, #7
+    add x19, x19, x2, lsr #3
+    b term_size_done
+
+term_size_terms:
+    cmp x3, #TERM_KIND_MAP
+    b.ne term_size_tuple
+    ubfx x2, x1, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    lsl x2, x2, #1                    // Map node: two terms per pair
+term_size_tuple:
+    add x19, x19, x2
+    add x20, x0, #(8 - TERM_TAG_BOXED) // First element
+    mov x21, x2                       // Elements left
+term_size_elements:
+    cbz x21, term_size_done
+    ldr x0, [x20], #8
+    bl _term_size
+    add x19, x19, x0
+    sub x21, x21, #1
+    b term_size_elements
+
+term_size_list:
+    add x19, x19, #2
+    ldur x20, [x0, #(8 - TERM_TAG_LIST)] // Tail, walked next
+    ldur x0, [x0, #-TERM_TAG_LIST]
+    bl _term_size
+    add x19, x19, x0
+    mov x0, x20
+    b term_size_next
+
+term_size_done:
+    mov x0, x19
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Term Copy
+// ------------------------------------------------------------
+// Deep-copy a term into a process heap, e.g. a message body into the
+// receiver's heap. The whole copy is one allocation of _term_size
+// words, so a full heap leaves nothing half-copied. Immediates and
+// small integers are returned as they are.
+//
+// Parameters:
+//   x0 (void*) - pcb: Destination process
+//   x1 (term_t) - term: Term to copy
+//
+// Returns:
+//   x0 (term_t) - copy: Term on the destination heap, or TERM_NONE if
+//                 the heap is full
+//
+// Complexity: O(size)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_copy:
+    tst x1, #TERM_POINTER_MASK
+    b.ne term_copy_heap
+    mov x0, x1
+    ret
+
+term_copy_heap:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0                       // pcb
+    mov x20, x1                       // term
+    mov x0, x1
+    bl _term_size
+    mov x1, x0
+    mov x0, x19
+    bl term_alloc
+    cbz x0, term_copy_failed
+
+    mov x1, x0                        // Cursor
+    mov x0, x20
+    bl term_copy_into
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+term_copy_failed:
+    mov x0, #TERM_NONE
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Term Copy Into (internal)
+// ------------------------------------------------------------
+// Copy a term to memory already reserved by _term_copy.
+//
+// Parameters:
+//   x0 (term_t) - term: Term to copy
+//   x1 (uint64_t*) - cursor: Next free word of the reservation
+//
+// Returns:
+//   x0 (term_t) - copy: Copied term
+//   x1 (uint64_t*) - cursor: Advanced past the copy
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+term_copy_into:
+    tst x0, #TERM_POINTER_MASK
+    b.ne term_copy_into_heap
+    ret                               // Copied by value
+
+term_copy_into_heap:
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    tbnz x0, #TERM_BIT_LIST, term_copy_list
+
+    // Boxed: header first
+    sub x19, x0, #TERM_TAG_BOXED      // Source object
+    ldr x2, [x19]
+    str x2, [x1]
+    orr x20, x1, #TERM_TAG_BOXED      // Result
+    lsr x3, x2, #TERM_HEADER_ARITY_SHIFT
+    ubfx x4, x2, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    add x1, x1, #8
+    cmp x4, #TERM_KIND_BINARY
+    b.ne term_copy_terms
+
+    // Binary body is raw words
+    add x3, x3, #7
+    lsr x3, x3, #3
+    add x5, x19, #8
+term_copy_binary:
+    cbz x3, term_copy_boxed_done
+    ldr x6, [x5], #8
+    str x6, [x1], #8
+    sub x3, x3, #1
+    b term_copy_binary
+
+term_copy_terms:
+    cmp x4, #TERM_KIND_MAP
+    b.ne term_copy_tuple
+    ubfx x3, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    lsl x3, x3, #1                    // Map node: two terms per pair
+term_copy_tuple:
+    add x21, x19, #8                  // Source elements
+    mov x22, x1                       // Destination elements
+    mov x23, x3                       // Elements left
+    add x1, x1, x3, lsl #3            // Children go after the tuple
+term_copy_elements:
+    cbz x23, term_copy_boxed_done
+    ldr x0, [x21], #8
+    bl term_copy_into
+    str x0, [x22], #8
+    sub x23, x23, #1
+    b term_copy_elements
+
+term_copy_boxed_done:
+    mov x0, x20
+    b term_copy_return
+
+term_copy_list:
+    orr x20, x1, #TERM_TAG_LIST       // Result: first new cell
+    mov x21, x0                       // Source cell
+term_copy_cell:
+    mov x22, x1                       // New cell
+    add x1, x1, #16
+    ldur x23, [x21, #(8 - TERM_TAG_LIST)] // Source tail
+    ldur x0, [x21, #-TERM_TAG_LIST]
+    bl term_copy_into
+    str x0, [x22]
+    tbz x23, #TERM_BIT_LIST, term_copy_last_tail
+
+    // Spine continues: link to the next cell and walk on
+    orr x2, x1, #TERM_TAG_LIST
+    str x2, [x22, #8]
+    mov x21, x23
+    b term_copy_cell
+
+term_copy_last_tail:
+    mov x0, x23
+    bl term_copy_into
+    str x0, [x22, #8]
+    mov x0, x20
+
+term_copy_return:
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Term Equal
+// ------------------------------------------------------------
+// Structural equality: same immediate, or same shape and contents on
+// any heaps. Maps with the same pairs compare equal node by node, as
+// map.s keeps every trie in one canonical shape.
+//
+// Parameters:
+//   x0 (term_t) - a: First term
+//   x1 (term_t) - b: Second term
+//
+// Returns:
+//   x0 (int) - equal: 1 if equal, 0 otherwise
+//
+// Complexity: O(size of the smaller term)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_equal:
+    cmp x0, x1
+    b.eq term_equal_leaf_yes
+    eor x2, x0, x1
+    tst x2, #TERM_TAG_MASK
+    b.ne term_equal_leaf_no           // Different classes
+    tst x0, #TERM_POINTER_MASK
+    b.eq term_equal_leaf_no           // Different immediates
+
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0
+    mov x20, x1
+    tbnz x0, #TERM_BIT_LIST, term_equal_list
+
+    // Boxed: headers (kind and size) must match
+    sub x19, x19, #TERM_TAG_BOXED
+    sub x20, x20, #TERM_TAG_BOXED
+    ldr x2, [x19]
+    ldr x3, [x20]
+    cmp x2, x3
+    b.ne term_equal_no
+    lsr x21, x2, #TERM_HEADER_ARITY_SHIFT
+    ubfx x4, x2, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    cmp x4, #TERM_KIND_BINARY
+    b.ne term_equal_terms
+
+    // Binary bodies are zero-padded, so compare words
+    add x21, x21, #7
+    lsr x21, x21, #3
+term_equal_binary:
+    cbz x21, term_equal_yes
+    ldr x2, [x19, #8]!
+    ldr x3, [x20, #8]!
+    cmp x2, x3
+    b.ne term_equal_no
+    sub x21, x21, #1
+    b term_equal_binary
+
+term_equal_terms:
+    cmp x4, #TERM_KIND_MAP
+    b.ne term_equal_tuple
+    ubfx x21, x2, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    lsl x21, x21, #1                  // Map node: two terms per pair
+term_equal_tuple:
+    cbz x21, term_equal_yes
+    ldr x0, [x19, #8]!
+    ldr x1, [x20, #8]!
+    bl _term_equal
+    cbz x0, term_equal_no
+    sub x21, x21, #1
+    b term_equal_tuple
+
+term_equal_list:
+    ldur x0, [x19, #-TERM_TAG_LIST]
+    ldur x1, [x20, #-TERM_TAG_LIST]
+    bl _term_equal
+    cbz x0, term_equal_no
+    ldur x19, [x19, #(8 - TERM_TAG_LIST)]
+    ldur x20, [x20, #(8 - TERM_TAG_LIST)]
+    cmp x19, x20
+    b.eq term_equal_yes
+    and x2, x19, x20
+    tbnz x2, #TERM_BIT_LIST, term_equal_list // Both spines continue
+
+    // Tails of any other kind: compare them as a tail call
+    mov x0, x19
+    mov x1, x20
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    b _term_equal
+
+term_equal_yes:
+    mov x0, #1
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+term_equal_no:
+    mov x0, #0
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+term_equal_leaf_yes:
+    mov x0, #1
+    ret
+
+term_equal_leaf_no:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Term Heap Next
+// ------------------------------------------------------------
+// Step over one object in a heap region built by the functions here:
+// a header word starts a boxed object, anything else starts a cons
+// cell. Walking from heap_base to heap_pointer visits every object,
+// which is what a collector scanning for pointers needs.
+//
+// Parameters:
+//   x0 (uint64_t*) - object: First word of an object
+//
+// Returns:
+//   x0 (uint64_t*) - next: First word of the following object
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_term_heap_next:
+    ldr x1, [x0]
+    and x2, x1, #TERM_TAG_MASK
+    cmp x2, #TERM_TAG_HEADER
+    b.ne term_heap_next_cons
+    lsr x2, x1, #TERM_HEADER_ARITY_SHIFT
+    ubfx x3, x1, #TERM_HEADER_KIND_SHIFT, #TERM_HEADER_KIND_WIDTH
+    cmp x3, #TERM_KIND_BINARY
+    b.ne term_heap_next_terms
+    add x2, x2, #7
+    lsr x2, x2, #3                    // Body words
+    b term_heap_next_boxed
+
+term_heap_next_terms:
+    cmp x3, #TERM_KIND_MAP
+    b.ne term_heap_next_boxed
+    ubfx x2, x1, #MAP_COUNT_SHIFT, #MAP_COUNT_WIDTH
+    lsl x2, x2, #1                    // Map node: two terms per pair
+term_heap_next_boxed:
+    add x0, x0, #8
+    add x0, x0, x2, lsl #3
+    ret
+
+term_heap_next_cons:
+    add x0, x0, #16
+    ret
@@ -70,12 +70,20 @@ _process_create_fixed:
     mov x20, x1  // priority
     mov x21, x2  // scheduler_id
 
-    // Find available PCB in test pool
+    // Find available PCB in test pool (ELF relocations under ACTLY_LINUX)
+.ifdef ACTLY_LINUX
+    adrp x0, _test_process_pool
+    add x0, x0, :lo12:_test_process_pool
+
+    adrp x1, _test_process_pool_bitmap
+    add x1, x1, :lo12:_test_process_pool_bitmap
+.else
     adrp x0, _test_process_pool@PAGE
     add x0, x0, _test_process_pool@PAGEOFF
     
     adrp x1, _test_process_pool_bitmap@PAGE
     add x1, x1, _test_process_pool_bitmap@PAGEOFF
+.endif
     
     // Search for available PCB
     mov x2, #0  // PCB index
@@ -99,8 +107,13 @@ find_pcb_loop:
     add x0, x0, x4  // PCB address
     
     // Get next process ID
+.ifdef ACTLY_LINUX
+    adrp x1, _test_next_process_id
+    add x1, x1, :lo12:_test_next_process_id
+.else
     adrp x1, _test_next_process_id@PAGE
     add x1, x1, _test_next_process_id@PAGEOFF
+.endif
     ldr x2, [x1]
     cbz x2, init_test_process_id
     add x2, x2, #1
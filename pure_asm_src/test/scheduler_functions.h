@@ -30,6 +30,50 @@
 #define SCHEDULER_FUNCTIONS_H
 
 #include <stdint.h>
+#include <stdlib.h>
+
+// PCB field offsets (match pcb.inc)
+#define PCB_SIZE 512
+#define PCB_PID_OFFSET 16
+#define PCB_SCHEDULER_ID_OFFSET 24
+#define PCB_STATE_OFFSET 32
+#define PCB_HEAP_BASE_OFFSET 352
+#define PCB_MESSAGE_QUEUE_OFFSET 368
+#define PCB_AFFINITY_MASK_OFFSET 384
+#define PCB_MIGRATION_COUNT_OFFSET 392
+#define PCB_HEAP_POINTER_OFFSET 424
+#define PCB_HEAP_LIMIT_OFFSET 432
+#define PCB_BLOCKING_REASON_OFFSET 440
+#define PCB_BLOCKING_DATA_OFFSET 448
+#define PCB_MESSAGE_PATTERN_OFFSET 464
+#define PCB_TOTAL_REDUCTIONS_OFFSET 472
+#define PCB_BLOCK_COUNTS_OFFSET 496
+
+// A zeroed PCB whose heap is a fresh buffer of the given number of words.
+// Release it with test_pcb_free.
+static inline void* test_pcb_with_heap(uint64_t words) {
+    uint8_t* pcb = calloc(1, PCB_SIZE);
+    uint64_t* heap = calloc(words, sizeof(uint64_t));
+    *(uint64_t*)(pcb + PCB_HEAP_BASE_OFFSET) = (uint64_t)heap;
+    *(uint64_t*)(pcb + PCB_HEAP_POINTER_OFFSET) = (uint64_t)heap;
+    *(uint64_t*)(pcb + PCB_HEAP_LIMIT_OFFSET) = (uint64_t)(heap + words);
+    return pcb;
+}
+
+static inline void test_pcb_free(void* pcb) {
+    free(*(void**)((uint8_t*)pcb + PCB_HEAP_BASE_OFFSET));
+    free(pcb);
+}
+
+// Current heap pointer of a test PCB
+static inline uint64_t test_pcb_heap_pointer(void* pcb) {
+    return *(uint64_t*)((uint8_t*)pcb + PCB_HEAP_POINTER_OFFSET);
+}
+
+// Bytes allocated on a test PCB's heap so far
+static inline uint64_t test_pcb_heap_used(void* pcb) {
+    return test_pcb_heap_pointer(pcb) - *(uint64_t*)((uint8_t*)pcb + PCB_HEAP_BASE_OFFSET);
+}
 
 // Scheduler state management functions
 extern void* scheduler_state_init(uint64_t max_cores);
@@ -49,10 +93,12 @@ extern void* get_priority_queue(void* state, uint64_t priority);
 extern int scheduler_enqueue_process_with_state(void* scheduler_states, uint64_t core_id, void* process, uint64_t priority);
 extern void* scheduler_dequeue_process_with_state(void* scheduler_states, uint64_t core_id);
 extern uint64_t scheduler_get_queue_length_with_state(void* scheduler_states, uint64_t core_id, uint64_t priority);
+extern int scheduler_inject_process(void* scheduler_states, uint64_t core_id, void* process, uint64_t priority);
 
 // Scheduler scheduling functions
 extern void* scheduler_schedule(void* scheduler_states, uint64_t core_id);
 extern void scheduler_idle(void* scheduler_states, uint64_t core_id);
+extern void* scheduler_run_pass(void* scheduler_states, uint64_t core_id);
 
 // Additional scheduler functions without _with_state suffix
 extern void scheduler_set_current_process(void* scheduler_states, uint64_t core_id, void* process);
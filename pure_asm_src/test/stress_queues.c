@@ -0,0 +1,921 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// stress_queues.c — Multi-threaded stress and linearizability harness
+// ------------------------------------------------------------
+// Hammers every structure in the runtime that more than one core
+// touches concurrently, from real threads:
+//
+//   deque    - one owner pushing and popping the bottom of a work
+//              stealing deque while thieves pop the top
+//   mailbox  - many senders into one mailbox, one receiver draining it
+//   timer    - an owner firing one-shot timers (some forwarded through
+//              a second wheel's inbox) while other threads cancel them
+//
+// Every operation is recorded with counter ticks taken just before it
+// is invoked and just after it returns. After the run the histories
+// are checked for:
+//
+//   - exactly-once delivery (nothing lost, nothing duplicated)
+//   - the real-time ordering a linearizable implementation must show:
+//     a steal that completed before another take began returned a
+//     smaller (older) element; a send that completed before another
+//     began is received first; per-sender FIFO
+//
+// --history writes the raw histories (one JSON object per operation)
+// for an external linearizability checker. Contention is reported as a
+// side output: CAS retries recorded by the structures themselves and
+// the number of full or empty attempts that had to be repeated.
+//
+// Run queues are owned by a single scheduler and are not covered.
+//
+// Usage: stress_queues_exe [--scenario deque|mailbox|timer|all]
+//                          [--ops N] [--threads N] [--seed N]
+//                          [--history FILE]
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+// External assembly functions
+extern uint64_t clock_read_ticks(void);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern int scheduler_state_destroy(void* scheduler_states);
+extern int ws_deque_init(void* deque_ptr, uint32_t size);
+extern int ws_deque_push_bottom(void* deque_ptr, void* process);
+extern void* ws_deque_pop_bottom(void* deque_ptr);
+extern void* ws_deque_pop_top(void* deque_ptr);
+extern uint64_t ws_deque_size(void* deque_ptr);
+extern int message_queue_init(void* queue_ptr, uint32_t size);
+extern void process_set_message_queue(void* pcb, void* message_queue);
+extern int send_message(void* sender_pcb, void* receiver_pcb, uint64_t message_data);
+extern uint64_t try_receive_message(void* receiver_pcb);
+extern int timer_wheel_init(void* scheduler_states, uint64_t core_id);
+extern int timer_wheel_destroy(void* scheduler_states, uint64_t core_id);
+extern uint64_t timer_arm(void* scheduler_states, uint64_t core_id, void* pcb,
+                          uint64_t expiry_ticks, void* callback, uint64_t argument);
+extern int cancel_timer(uint64_t timer_id);
+extern uint64_t timer_wheel_process(void* scheduler_states, uint64_t core_id, uint64_t now);
+
+// Structure layout (match loadbalancer.s, communication.s, process.s)
+#define STRUCT_SIZE_BYTES 64
+#define WS_DEQUE_STEAL_COUNT_OFFSET 32
+#define WS_DEQUE_STEAL_ATTEMPTS_OFFSET 40
+#define WS_DEQUE_CAS_RETRIES_OFFSET 56
+#define MSG_QUEUE_CAS_RETRIES_OFFSET 56
+#define PCB_SIZE 512
+#define PCB_SCHEDULER_ID_OFFSET 24
+
+#define QUEUE_CAPACITY 1024
+#define TIMER_BATCH 1024
+#define WHEEL_TICK (1ULL << 14)  // TIMER_WHEEL_SHIFT
+#define MAX_THREADS 64
+#define DEFAULT_OPS 1000000ULL
+#define DEFAULT_THREADS 3
+
+// Empty or full results kept per thread; later ones are only counted
+#define MAX_RECORDED_MISSES (1u << 20)
+
+// Producer number lives above the sequence number in mailbox messages
+#define SENDER_SHIFT 40
+
+typedef enum {
+    OP_PUSH,
+    OP_POP,
+    OP_STEAL,
+    OP_SEND,
+    OP_RECEIVE,
+    OP_CANCEL,
+    OP_FIRE
+} op_kind;
+
+static const char* op_names[] = { "push", "pop", "steal", "send", "receive", "cancel", "fire" };
+
+typedef struct {
+    uint64_t value;      // Element, message or timer index; 0 = empty/failed
+    uint64_t invoke;
+    uint64_t response;
+    uint32_t op;
+    uint32_t thread;
+} history_entry;
+
+typedef struct {
+    history_entry* entries;
+    uint64_t count;
+    uint64_t capacity;
+    uint64_t misses;     // Empty/full results, recorded or not
+    uint64_t recorded_misses;
+} history;
+
+typedef struct {
+    uint64_t ops;
+    uint64_t threads;
+    uint64_t seed;
+    const char* history_path;
+} stress_config;
+
+typedef struct {
+    const char* name;
+    uint64_t operations;
+    uint64_t elapsed_ticks;
+    uint64_t lost;
+    uint64_t duplicated;
+    uint64_t order_violations;
+    uint64_t cas_retries;
+    uint64_t misses;
+} stress_result;
+
+// ------------------------------------------------------------
+// Shared helpers
+// ------------------------------------------------------------
+static int history_init(history* h, uint64_t capacity) {
+    memset(h, 0, sizeof(*h));
+    h->capacity = capacity + MAX_RECORDED_MISSES;
+    h->entries = malloc(sizeof(history_entry) * h->capacity);
+    return h->entries != NULL;
+}
+
+static void history_record(history* h, uint32_t thread, op_kind op, uint64_t value,
+                           uint64_t invoke, uint64_t response) {
+    if (value == 0) {
+        h->misses++;
+        if (h->recorded_misses >= MAX_RECORDED_MISSES) {
+            return;
+        }
+        h->recorded_misses++;
+    }
+    if (h->count < h->capacity) {
+        history_entry* e = &h->entries[h->count++];
+        e->value = value;
+        e->invoke = invoke;
+        e->response = response;
+        e->op = op;
+        e->thread = thread;
+    }
+}
+
+static void history_dump(FILE* out, const char* scenario, history* histories, uint64_t count) {
+    if (out == NULL) {
+        return;
+    }
+    for (uint64_t t = 0; t < count; t++) {
+        for (uint64_t i = 0; i < histories[t].count; i++) {
+            history_entry* e = &histories[t].entries[i];
+            fprintf(out, "{\"scenario\":\"%s\",\"thread\":%u,\"op\":\"%s\",\"value\":%llu,"
+                         "\"invoke\":%llu,\"response\":%llu}\n",
+                    scenario, e->thread, op_names[e->op], (unsigned long long)e->value,
+                    (unsigned long long)e->invoke, (unsigned long long)e->response);
+        }
+    }
+}
+
+static void history_free(history* histories, uint64_t count) {
+    for (uint64_t t = 0; t < count; t++) {
+        free(histories[t].entries);
+    }
+}
+
+static void spin_barrier(uint64_t* arrived, uint64_t parties) {
+    __atomic_fetch_add(arrived, 1, __ATOMIC_ACQ_REL);
+    while (__atomic_load_n(arrived, __ATOMIC_ACQUIRE) < parties) {
+        sched_yield();
+    }
+}
+
+static uint64_t next_random(uint64_t* state) {
+    // xorshift64*: deterministic per thread for a given --seed
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ULL;
+}
+
+typedef struct {
+    uint64_t key;        // Time the operation started or completed
+    uint64_t value;      // Ordering value that must increase
+} order_point;
+
+static int compare_order_point(const void* a, const void* b) {
+    const order_point* x = a;
+    const order_point* y = b;
+    return (x->key > y->key) - (x->key < y->key);
+}
+
+// Count operations B for which some operation A completed before B was
+// invoked yet A's ordering value is not below B's. completed holds
+// (response, value) for the A set; started holds (invoke, value) for B.
+static uint64_t count_order_violations(order_point* completed, uint64_t completed_count,
+                                       order_point* started, uint64_t started_count) {
+    qsort(completed, completed_count, sizeof(order_point), compare_order_point);
+    qsort(started, started_count, sizeof(order_point), compare_order_point);
+    uint64_t violations = 0;
+    uint64_t max_before = 0;
+    uint64_t c = 0;
+    for (uint64_t s = 0; s < started_count; s++) {
+        while (c < completed_count && completed[c].key < started[s].key) {
+            if (completed[c].value > max_before) {
+                max_before = completed[c].value;
+            }
+            c++;
+        }
+        if (c > 0 && max_before >= started[s].value) {
+            violations++;
+        }
+    }
+    return violations;
+}
+
+// ------------------------------------------------------------
+// Deque scenario: one owner, many thieves
+// ------------------------------------------------------------
+typedef struct {
+    uint64_t deque[STRUCT_SIZE_BYTES / 8];
+    uint64_t elements;
+    uint64_t thieves;
+    uint64_t seed;
+    uint64_t start;
+    uint64_t owner_done;
+    history* histories;  // [0] owner, [1..] thieves
+} deque_stress;
+
+typedef struct {
+    deque_stress* shared;
+    uint32_t thread;
+} deque_thread_arg;
+
+static void owner_pop(deque_stress* d, history* h) {
+    uint64_t invoke = clock_read_ticks();
+    uint64_t value = (uint64_t)(uintptr_t)ws_deque_pop_bottom(d->deque);
+    history_record(h, 0, OP_POP, value, invoke, clock_read_ticks());
+}
+
+static void* deque_owner(void* raw) {
+    deque_thread_arg* arg = raw;
+    deque_stress* d = arg->shared;
+    history* h = &d->histories[0];
+    uint64_t rng = d->seed;
+    spin_barrier(&d->start, d->thieves + 1);
+
+    for (uint64_t v = 1; v <= d->elements; v++) {
+        for (;;) {
+            uint64_t invoke = clock_read_ticks();
+            int pushed = ws_deque_push_bottom(d->deque, (void*)(uintptr_t)v);
+            uint64_t response = clock_read_ticks();
+            if (pushed) {
+                history_record(h, 0, OP_PUSH, v, invoke, response);
+                break;
+            }
+            // Full: make room the way a scheduler would, by running work
+            h->misses++;
+            owner_pop(d, h);
+        }
+        // Pop a third of the time so owner and thieves meet at the bottom
+        if (next_random(&rng) % 3 == 0) {
+            owner_pop(d, h);
+        }
+    }
+    // Drain what the thieves left
+    while (ws_deque_size(d->deque) > 0) {
+        owner_pop(d, h);
+    }
+    __atomic_store_n(&d->owner_done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void* deque_thief(void* raw) {
+    deque_thread_arg* arg = raw;
+    deque_stress* d = arg->shared;
+    history* h = &d->histories[arg->thread];
+    spin_barrier(&d->start, d->thieves + 1);
+
+    while (!__atomic_load_n(&d->owner_done, __ATOMIC_ACQUIRE)) {
+        uint64_t invoke = clock_read_ticks();
+        uint64_t value = (uint64_t)(uintptr_t)ws_deque_pop_top(d->deque);
+        history_record(h, arg->thread, OP_STEAL, value, invoke, clock_read_ticks());
+    }
+    return NULL;
+}
+
+static int run_deque(const stress_config* config, FILE* history_out, stress_result* result) {
+    deque_stress d;
+    memset(&d, 0, sizeof(d));
+    d.elements = config->ops;
+    d.thieves = config->threads;
+    d.seed = config->seed;
+    if (!ws_deque_init(d.deque, QUEUE_CAPACITY)) {
+        return 0;
+    }
+    uint64_t thread_count = d.thieves + 1;
+    d.histories = calloc(thread_count, sizeof(history));
+    if (d.histories == NULL) {
+        return 0;
+    }
+    // Owner records every push plus up to one pop per push
+    if (!history_init(&d.histories[0], d.elements * 2)) {
+        return 0;
+    }
+    for (uint64_t t = 1; t < thread_count; t++) {
+        if (!history_init(&d.histories[t], d.elements)) {
+            return 0;
+        }
+    }
+
+    pthread_t threads[MAX_THREADS + 1];
+    deque_thread_arg args[MAX_THREADS + 1];
+    uint64_t start = clock_read_ticks();
+    for (uint64_t t = 0; t < thread_count; t++) {
+        args[t].shared = &d;
+        args[t].thread = (uint32_t)t;
+        pthread_create(&threads[t], NULL, t == 0 ? deque_owner : deque_thief, &args[t]);
+    }
+    for (uint64_t t = 0; t < thread_count; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    result->elapsed_ticks = clock_read_ticks() - start;
+
+    // Exactly once, and never taken before it was pushed
+    uint8_t* taken = calloc(d.elements + 1, 1);
+    uint64_t* pushed_at = calloc(d.elements + 1, sizeof(uint64_t));
+    order_point* steals = malloc(sizeof(order_point) * (d.elements + 1));
+    order_point* takes = malloc(sizeof(order_point) * (d.elements + 1));
+    if (taken == NULL || pushed_at == NULL || steals == NULL || takes == NULL) {
+        return 0;
+    }
+    uint64_t steal_count = 0;
+    uint64_t take_count = 0;
+    for (uint64_t i = 0; i < d.histories[0].count; i++) {
+        history_entry* e = &d.histories[0].entries[i];
+        if (e->op == OP_PUSH) {
+            pushed_at[e->value] = e->invoke;
+        }
+    }
+    for (uint64_t t = 0; t < thread_count; t++) {
+        for (uint64_t i = 0; i < d.histories[t].count; i++) {
+            history_entry* e = &d.histories[t].entries[i];
+            if (e->op == OP_PUSH || e->value == 0) {
+                continue;
+            }
+            if (e->value > d.elements) {
+                result->order_violations++;
+                continue;
+            }
+            if (taken[e->value]++ > 0) {
+                result->duplicated++;
+                continue;
+            }
+            if (e->response < pushed_at[e->value]) {
+                result->order_violations++;
+            }
+            takes[take_count].key = e->invoke;
+            takes[take_count].value = e->value;
+            take_count++;
+            if (e->op == OP_STEAL) {
+                steals[steal_count].key = e->response;
+                steals[steal_count].value = e->value;
+                steal_count++;
+            }
+        }
+    }
+    for (uint64_t v = 1; v <= d.elements; v++) {
+        if (taken[v] == 0) {
+            result->lost++;
+        }
+    }
+    // A steal takes the oldest element present, so anything taken by an
+    // operation that started after the steal finished must be newer
+    result->order_violations += count_order_violations(steals, steal_count, takes, take_count);
+
+    result->name = "deque";
+    result->operations = 0;
+    for (uint64_t t = 0; t < thread_count; t++) {
+        result->operations += d.histories[t].count + d.histories[t].misses -
+                              d.histories[t].recorded_misses;
+        result->misses += d.histories[t].misses;
+    }
+    result->cas_retries = d.deque[WS_DEQUE_CAS_RETRIES_OFFSET / 8];
+    printf("deque: %llu steals of %llu attempts\n",
+           (unsigned long long)d.deque[WS_DEQUE_STEAL_COUNT_OFFSET / 8],
+           (unsigned long long)d.deque[WS_DEQUE_STEAL_ATTEMPTS_OFFSET / 8]);
+
+    history_dump(history_out, "deque", d.histories, thread_count);
+    free(taken);
+    free(pushed_at);
+    free(steals);
+    free(takes);
+    history_free(d.histories, thread_count);
+    free(d.histories);
+    return 1;
+}
+
+// ------------------------------------------------------------
+// Mailbox scenario: many senders, one receiver
+// ------------------------------------------------------------
+typedef struct {
+    uint64_t queue[STRUCT_SIZE_BYTES / 8];
+    uint8_t receiver[PCB_SIZE];
+    uint8_t* senders;        // One PCB per producer
+    uint64_t producers;
+    uint64_t per_producer;
+    uint64_t start;
+    history* histories;      // [0] receiver, [1..] producers
+} mailbox_stress;
+
+typedef struct {
+    mailbox_stress* shared;
+    uint32_t thread;
+} mailbox_thread_arg;
+
+static void* mailbox_producer(void* raw) {
+    mailbox_thread_arg* arg = raw;
+    mailbox_stress* m = arg->shared;
+    history* h = &m->histories[arg->thread];
+    void* sender = m->senders + (uint64_t)(arg->thread - 1) * PCB_SIZE;
+    spin_barrier(&m->start, m->producers + 1);
+
+    for (uint64_t seq = 1; seq <= m->per_producer; seq++) {
+        uint64_t message = ((uint64_t)arg->thread << SENDER_SHIFT) | seq;
+        for (;;) {
+            uint64_t invoke = clock_read_ticks();
+            int sent = send_message(sender, m->receiver, message);
+            uint64_t response = clock_read_ticks();
+            history_record(h, arg->thread, OP_SEND, sent ? message : 0, invoke, response);
+            if (sent) {
+                break;
+            }
+            sched_yield();  // Full: let the receiver catch up
+        }
+    }
+    return NULL;
+}
+
+static void* mailbox_receiver(void* raw) {
+    mailbox_thread_arg* arg = raw;
+    mailbox_stress* m = arg->shared;
+    history* h = &m->histories[0];
+    uint64_t expected = m->producers * m->per_producer;
+    spin_barrier(&m->start, m->producers + 1);
+
+    for (uint64_t received = 0; received < expected;) {
+        uint64_t invoke = clock_read_ticks();
+        uint64_t message = try_receive_message(m->receiver);
+        history_record(h, 0, OP_RECEIVE, message, invoke, clock_read_ticks());
+        if (message != 0) {
+            received++;
+        }
+    }
+    return NULL;
+}
+
+static int run_mailbox(const stress_config* config, FILE* history_out, stress_result* result) {
+    mailbox_stress m;
+    memset(&m, 0, sizeof(m));
+    m.producers = config->threads;
+    m.per_producer = config->ops / config->threads;
+    if (m.per_producer == 0) {
+        m.per_producer = 1;
+    }
+    if (!message_queue_init(m.queue, QUEUE_CAPACITY)) {
+        return 0;
+    }
+    process_set_message_queue(m.receiver, m.queue);
+    m.senders = calloc(m.producers, PCB_SIZE);
+    uint64_t thread_count = m.producers + 1;
+    m.histories = calloc(thread_count, sizeof(history));
+    if (m.senders == NULL || m.histories == NULL) {
+        return 0;
+    }
+    if (!history_init(&m.histories[0], m.producers * m.per_producer)) {
+        return 0;
+    }
+    for (uint64_t t = 1; t < thread_count; t++) {
+        if (!history_init(&m.histories[t], m.per_producer)) {
+            return 0;
+        }
+    }
+
+    pthread_t threads[MAX_THREADS + 1];
+    mailbox_thread_arg args[MAX_THREADS + 1];
+    uint64_t start = clock_read_ticks();
+    for (uint64_t t = 0; t < thread_count; t++) {
+        args[t].shared = &m;
+        args[t].thread = (uint32_t)t;
+        pthread_create(&threads[t], NULL, t == 0 ? mailbox_receiver : mailbox_producer, &args[t]);
+    }
+    for (uint64_t t = 0; t < thread_count; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    result->elapsed_ticks = clock_read_ticks() - start;
+
+    // Receive order of every message, indexed by (producer, seq)
+    uint64_t total = m.producers * m.per_producer;
+    uint64_t* received_at = calloc(total, sizeof(uint64_t));      // order + 1
+    uint64_t* receive_response = calloc(total, sizeof(uint64_t));
+    uint64_t* last_seq = calloc(thread_count, sizeof(uint64_t));
+    order_point* completed = malloc(sizeof(order_point) * total);
+    order_point* started = malloc(sizeof(order_point) * total);
+    if (received_at == NULL || receive_response == NULL || last_seq == NULL ||
+        completed == NULL || started == NULL) {
+        return 0;
+    }
+    uint64_t order = 0;
+    for (uint64_t i = 0; i < m.histories[0].count; i++) {
+        history_entry* e = &m.histories[0].entries[i];
+        if (e->value == 0) {
+            continue;
+        }
+        uint64_t producer = e->value >> SENDER_SHIFT;
+        uint64_t seq = e->value & ((1ULL << SENDER_SHIFT) - 1);
+        if (producer == 0 || producer > m.producers || seq == 0 || seq > m.per_producer) {
+            result->order_violations++;
+            continue;
+        }
+        uint64_t index = (producer - 1) * m.per_producer + (seq - 1);
+        if (received_at[index] != 0) {
+            result->duplicated++;
+            continue;
+        }
+        received_at[index] = ++order;
+        receive_response[index] = e->response;
+        // Per-sender FIFO
+        if (seq <= last_seq[producer]) {
+            result->order_violations++;
+        }
+        last_seq[producer] = seq;
+    }
+
+    uint64_t points = 0;
+    for (uint64_t t = 1; t < thread_count; t++) {
+        for (uint64_t i = 0; i < m.histories[t].count; i++) {
+            history_entry* e = &m.histories[t].entries[i];
+            if (e->value == 0) {
+                continue;
+            }
+            uint64_t index = (t - 1) * m.per_producer + ((e->value & ((1ULL << SENDER_SHIFT) - 1)) - 1);
+            if (received_at[index] == 0) {
+                result->lost++;
+                continue;
+            }
+            if (receive_response[index] < e->invoke) {
+                result->order_violations++;
+            }
+            completed[points].key = e->response;
+            completed[points].value = received_at[index];
+            started[points].key = e->invoke;
+            started[points].value = received_at[index];
+            points++;
+        }
+    }
+    // A send that finished before another began must be received first
+    result->order_violations += count_order_violations(completed, points, started, points);
+
+    result->name = "mailbox";
+    result->operations = 0;
+    for (uint64_t t = 0; t < thread_count; t++) {
+        result->operations += m.histories[t].count + m.histories[t].misses -
+                              m.histories[t].recorded_misses;
+        result->misses += m.histories[t].misses;
+    }
+    result->cas_retries = m.queue[MSG_QUEUE_CAS_RETRIES_OFFSET / 8];
+
+    history_dump(history_out, "mailbox", m.histories, thread_count);
+    free(received_at);
+    free(receive_response);
+    free(last_seq);
+    free(completed);
+    free(started);
+    free(m.senders);
+    history_free(m.histories, thread_count);
+    free(m.histories);
+    return 1;
+}
+
+// ------------------------------------------------------------
+// Timer scenario: fire on the owner (or a forwarded-to core)
+// while other threads cancel
+// ------------------------------------------------------------
+typedef struct {
+    uint64_t fired;
+    uint64_t cancelled;
+    uint64_t armed_at;
+    uint64_t fired_at;
+} timer_record;
+
+typedef struct {
+    void* states;
+    uint8_t local_pcb[PCB_SIZE];     // scheduler_id 0: fires on core 0
+    uint8_t remote_pcb[PCB_SIZE];    // scheduler_id 1: forwarded to core 1
+    timer_record* records;
+    uint64_t* ids;                   // Current batch's timer IDs
+    uint64_t timers;
+    uint64_t batches;
+    uint64_t cancellers;
+    uint64_t seed;
+    uint64_t published;              // Batches armed so far
+    uint64_t cancellers_done;        // Canceller batch completions
+    uint64_t resolved;               // Timers fired or cancelled
+    uint64_t stop;
+    uint64_t start;
+    history* histories;              // [0] owner, [1] core 1, [2..] cancellers
+} timer_stress;
+
+typedef struct {
+    timer_stress* shared;
+    uint32_t thread;
+} timer_thread_arg;
+
+// Timer callback: runs on whichever core owns the timer when it fires
+static void stress_timer_fired(void* states, uint64_t core_id, void* pcb, uint64_t argument) {
+    (void)states;
+    (void)core_id;
+    (void)pcb;
+    timer_record* record = (timer_record*)(uintptr_t)argument;
+    record->fired_at = clock_read_ticks();
+    __atomic_fetch_add(&record->fired, 1, __ATOMIC_RELAXED);
+}
+
+static uint64_t timer_resolved(timer_stress* s, uint64_t first, uint64_t count) {
+    uint64_t resolved = 0;
+    for (uint64_t i = first; i < first + count; i++) {
+        resolved += __atomic_load_n(&s->records[i].fired, __ATOMIC_RELAXED) +
+                    __atomic_load_n(&s->records[i].cancelled, __ATOMIC_RELAXED);
+    }
+    return resolved;
+}
+
+static void* timer_owner(void* raw) {
+    timer_thread_arg* arg = raw;
+    timer_stress* s = arg->shared;
+    spin_barrier(&s->start, s->cancellers + 2);
+
+    for (uint64_t b = 0; b < s->batches; b++) {
+        uint64_t first = b * TIMER_BATCH;
+        uint64_t now = clock_read_ticks();
+        for (uint64_t i = 0; i < TIMER_BATCH; i++) {
+            timer_record* record = &s->records[first + i];
+            // Odd timers belong to a process that has moved to core 1
+            void* pcb = (i & 1) ? s->remote_pcb : s->local_pcb;
+            record->armed_at = clock_read_ticks();
+            s->ids[i] = timer_arm(s->states, 0, pcb, now + WHEEL_TICK, stress_timer_fired,
+                                  (uint64_t)(uintptr_t)record);
+        }
+        __atomic_store_n(&s->published, b + 1, __ATOMIC_RELEASE);
+
+        // Fire until every timer in the batch is accounted for, then
+        // wait for the cancellers before their IDs are recycled
+        while (timer_resolved(s, first, TIMER_BATCH) < TIMER_BATCH) {
+            timer_wheel_process(s->states, 0, clock_read_ticks());
+        }
+        while (__atomic_load_n(&s->cancellers_done, __ATOMIC_ACQUIRE) < s->cancellers * (b + 1)) {
+            sched_yield();
+        }
+    }
+    __atomic_store_n(&s->stop, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void* timer_remote(void* raw) {
+    timer_thread_arg* arg = raw;
+    timer_stress* s = arg->shared;
+    spin_barrier(&s->start, s->cancellers + 2);
+
+    while (!__atomic_load_n(&s->stop, __ATOMIC_ACQUIRE)) {
+        timer_wheel_process(s->states, 1, clock_read_ticks());
+    }
+    return NULL;
+}
+
+static void* timer_canceller(void* raw) {
+    timer_thread_arg* arg = raw;
+    timer_stress* s = arg->shared;
+    history* h = &s->histories[arg->thread];
+    uint64_t rng = s->seed + arg->thread;
+    spin_barrier(&s->start, s->cancellers + 2);
+
+    for (uint64_t b = 0; b < s->batches; b++) {
+        while (__atomic_load_n(&s->published, __ATOMIC_ACQUIRE) <= b) {
+            sched_yield();
+        }
+        // Each canceller aims at half the batch; targets overlap
+        for (uint64_t n = 0; n < TIMER_BATCH / 2; n++) {
+            uint64_t i = next_random(&rng) % TIMER_BATCH;
+            uint64_t index = b * TIMER_BATCH + i;
+            uint64_t invoke = clock_read_ticks();
+            int cancelled = cancel_timer(s->ids[i]);
+            uint64_t response = clock_read_ticks();
+            if (cancelled) {
+                __atomic_fetch_add(&s->records[index].cancelled, 1, __ATOMIC_RELAXED);
+            }
+            history_record(h, arg->thread, OP_CANCEL, cancelled ? index + 1 : 0, invoke, response);
+        }
+        __atomic_fetch_add(&s->cancellers_done, 1, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+static int run_timer(const stress_config* config, FILE* history_out, stress_result* result) {
+    timer_stress s;
+    memset(&s, 0, sizeof(s));
+    s.batches = (config->ops + TIMER_BATCH - 1) / TIMER_BATCH;
+    s.timers = s.batches * TIMER_BATCH;
+    s.cancellers = config->threads;
+    s.seed = config->seed;
+    s.states = scheduler_state_init(2);
+    if (s.states == NULL || !timer_wheel_init(s.states, 0) || !timer_wheel_init(s.states, 1)) {
+        return 0;
+    }
+    *(uint64_t*)(s.local_pcb + PCB_SCHEDULER_ID_OFFSET) = 0;
+    *(uint64_t*)(s.remote_pcb + PCB_SCHEDULER_ID_OFFSET) = 1;
+    s.records = calloc(s.timers, sizeof(timer_record));
+    s.ids = calloc(TIMER_BATCH, sizeof(uint64_t));
+    uint64_t thread_count = s.cancellers + 2;
+    s.histories = calloc(thread_count, sizeof(history));
+    if (s.records == NULL || s.ids == NULL || s.histories == NULL) {
+        return 0;
+    }
+    for (uint64_t t = 2; t < thread_count; t++) {
+        if (!history_init(&s.histories[t], s.batches * (TIMER_BATCH / 2))) {
+            return 0;
+        }
+    }
+
+    pthread_t threads[MAX_THREADS + 2];
+    timer_thread_arg args[MAX_THREADS + 2];
+    uint64_t start = clock_read_ticks();
+    for (uint64_t t = 0; t < thread_count; t++) {
+        args[t].shared = &s;
+        args[t].thread = (uint32_t)t;
+        pthread_create(&threads[t], NULL,
+                       t == 0 ? timer_owner : (t == 1 ? timer_remote : timer_canceller),
+                       &args[t]);
+    }
+    for (uint64_t t = 0; t < thread_count; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    result->elapsed_ticks = clock_read_ticks() - start;
+
+    // Every timer either fired or was cancelled, never both, never twice.
+    // Fires are added to the owner (core 0) or core 1 history for --history.
+    if (!history_init(&s.histories[0], s.timers) || !history_init(&s.histories[1], s.timers)) {
+        return 0;
+    }
+    uint64_t fired = 0;
+    for (uint64_t i = 0; i < s.timers; i++) {
+        timer_record* record = &s.records[i];
+        uint64_t outcomes = record->fired + record->cancelled;
+        if (outcomes == 0) {
+            result->lost++;
+        } else if (outcomes > 1) {
+            result->duplicated++;
+        }
+        if (record->fired) {
+            fired++;
+            if (record->fired_at < record->armed_at) {
+                result->order_violations++;
+            }
+            history_record(&s.histories[i & 1], (uint32_t)(i & 1), OP_FIRE, i + 1,
+                           record->armed_at, record->fired_at);
+        }
+    }
+
+    result->name = "timer";
+    result->operations = s.timers;
+    for (uint64_t t = 2; t < thread_count; t++) {
+        result->operations += s.histories[t].count + s.histories[t].misses -
+                              s.histories[t].recorded_misses;
+        result->misses += s.histories[t].misses;
+    }
+    printf("timer: %llu fired, %llu cancelled\n", (unsigned long long)fired,
+           (unsigned long long)(s.timers - fired));
+
+    history_dump(history_out, "timer", s.histories, thread_count);
+    timer_wheel_destroy(s.states, 0);
+    timer_wheel_destroy(s.states, 1);
+    scheduler_state_destroy(s.states);
+    free(s.records);
+    free(s.ids);
+    history_free(s.histories, thread_count);
+    free(s.histories);
+    return 1;
+}
+
+// ------------------------------------------------------------
+// Driver
+// ------------------------------------------------------------
+static int report(const stress_result* r) {
+    int passed = r->lost == 0 && r->duplicated == 0 && r->order_violations == 0;
+    printf("%-8s %s  ops=%llu ticks=%llu lost=%llu duplicated=%llu order_violations=%llu "
+           "cas_retries=%llu retried_empty_or_full=%llu\n",
+           r->name, passed ? "PASS" : "FAIL",
+           (unsigned long long)r->operations, (unsigned long long)r->elapsed_ticks,
+           (unsigned long long)r->lost, (unsigned long long)r->duplicated,
+           (unsigned long long)r->order_violations, (unsigned long long)r->cas_retries,
+           (unsigned long long)r->misses);
+    return passed;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr, "usage: %s [--scenario deque|mailbox|timer|all] [--ops N] "
+                    "[--threads N] [--seed N] [--history FILE]\n", program);
+}
+
+int main(int argc, char** argv) {
+    stress_config config = { DEFAULT_OPS, DEFAULT_THREADS, 0x9E3779B97F4A7C15ULL, NULL };
+    const char* scenario = "all";
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 2;
+        }
+        if (strcmp(argv[i], "--scenario") == 0) {
+            scenario = argv[++i];
+        } else if (strcmp(argv[i], "--ops") == 0) {
+            config.ops = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            config.threads = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            config.seed = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--history") == 0) {
+            config.history_path = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (config.ops == 0 || config.threads == 0 || config.threads > MAX_THREADS ||
+        config.seed == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+    int all = strcmp(scenario, "all") == 0;
+    if (!all && strcmp(scenario, "deque") != 0 && strcmp(scenario, "mailbox") != 0 &&
+        strcmp(scenario, "timer") != 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    FILE* history_out = NULL;
+    if (config.history_path != NULL) {
+        history_out = fopen(config.history_path, "w");
+        if (history_out == NULL) {
+            perror(config.history_path);
+            return 2;
+        }
+    }
+
+    printf("stress: ops=%llu threads=%llu seed=%llu\n", (unsigned long long)config.ops,
+           (unsigned long long)config.threads, (unsigned long long)config.seed);
+    int failed = 0;
+    struct {
+        const char* name;
+        int (*run)(const stress_config*, FILE*, stress_result*);
+    } scenarios[] = { { "deque", run_deque }, { "mailbox", run_mailbox }, { "timer", run_timer } };
+
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        if (!all && strcmp(scenario, scenarios[i].name) != 0) {
+            continue;
+        }
+        stress_result result;
+        memset(&result, 0, sizeof(result));
+        if (!scenarios[i].run(&config, history_out, &result)) {
+            fprintf(stderr, "%s: setup failed\n", scenarios[i].name);
+            failed = 1;
+            continue;
+        }
+        if (!report(&result)) {
+            failed = 1;
+        }
+    }
+
+    if (history_out != NULL) {
+        fclose(history_out);
+    }
+    return failed ? 1 : 0;
+}
@@ -42,7 +42,7 @@
 extern void* scheduler_state_init(uint64_t max_cores);
 extern void scheduler_state_destroy(void* scheduler_states);
 extern int actly_yield(uint64_t core_id);
-extern uint64_t actly_spawn(uint64_t core_id, uint64_t entry_point, uint64_t priority, uint64_t stack_size, uint64_t heap_size);
+extern uint64_t actly_spawn(void* scheduler_states, uint64_t core_id, uint64_t entry_point, uint64_t priority, uint64_t stack_size, uint64_t heap_size);
 extern void actly_exit(uint64_t core_id, uint64_t exit_reason);
 extern int actly_bif_trap_check(void* scheduler_states, uint64_t core_id, uint64_t reduction_cost);
 
@@ -107,15 +107,16 @@ typedef struct {
     uint64_t last_scheduled; // Offset 376: Last scheduled timestamp (8 bytes)
     uint64_t affinity_mask; // Offset 384: CPU affinity mask (8 bytes)
     uint64_t migration_count; // Offset 392: Migration count (8 bytes)
-    uint64_t stack_pointer; // Offset 400: Current stack pointer (8 bytes)
-    uint64_t stack_limit; // Offset 408: Stack limit (8 bytes)
-    uint64_t heap_pointer; // Offset 416: Current heap pointer (8 bytes)
-    uint64_t heap_limit; // Offset 424: Heap limit (8 bytes)
-    uint64_t blocking_reason; // Offset 432: Blocking reason (8 bytes)
-    uint64_t blocking_data; // Offset 440: Blocking data (8 bytes)
-    uint64_t wake_time; // Offset 448: Timer wake time (8 bytes)
-    uint64_t message_pattern; // Offset 456: Receive pattern (8 bytes)
-    // Total size: 464 bytes
+    uint64_t last_migration_time; // Offset 400: Last migration timestamp (8 bytes)
+    uint64_t stack_pointer; // Offset 408: Current stack pointer (8 bytes)
+    uint64_t stack_limit; // Offset 416: Stack limit (8 bytes)
+    uint64_t heap_pointer; // Offset 424: Current heap pointer (8 bytes)
+    uint64_t heap_limit; // Offset 432: Heap limit (8 bytes)
+    uint64_t blocking_reason; // Offset 440: Blocking reason (8 bytes)
+    uint64_t blocking_data; // Offset 448: Blocking data (8 bytes)
+    uint64_t wake_time; // Offset 456: Timer wake time (8 bytes)
+    uint64_t message_pattern; // Offset 464: Receive pattern (8 bytes)
+    // Total size: 472 bytes
 } test_process_t;
 
 // Helper function to create a test process
@@ -216,28 +217,28 @@ void test_actly_spawn() {
     scheduler_set_reduction_count_with_state(scheduler_state, 0, 20);
     
     // Test actly spawn with valid parameters
-    uint64_t new_pid = actly_spawn(0, 0x1000, PRIORITY_NORMAL, 8192, 4096);
+    uint64_t new_pid = actly_spawn(scheduler_state, 0, 0x1000, PRIORITY_NORMAL, 8192, 4096);
     test_assert_not_zero(new_pid, "actly_spawn_success");
     
     // Test invalid core ID
-    new_pid = actly_spawn(128, 0x1000, PRIORITY_NORMAL, 8192, 4096);
+    new_pid = actly_spawn(scheduler_state, 128, 0x1000, PRIORITY_NORMAL, 8192, 4096);
     test_assert_zero(new_pid, "actly_spawn_invalid_core");
     
     // Test invalid priority
-    new_pid = actly_spawn(0, 0x1000, 99, 8192, 4096);
+    new_pid = actly_spawn(scheduler_state, 0, 0x1000, 99, 8192, 4096);
     test_assert_zero(new_pid, "actly_spawn_invalid_priority");
     
     // Test invalid stack size
-    new_pid = actly_spawn(0, 0x1000, PRIORITY_NORMAL, 100, 4096);
+    new_pid = actly_spawn(scheduler_state, 0, 0x1000, PRIORITY_NORMAL, 100, 4096);
     test_assert_zero(new_pid, "actly_spawn_invalid_stack_size");
     
     // Test invalid heap size
-    new_pid = actly_spawn(0, 0x1000, PRIORITY_NORMAL, 8192, 100);
+    new_pid = actly_spawn(scheduler_state, 0, 0x1000, PRIORITY_NORMAL, 8192, 100);
     test_assert_zero(new_pid, "actly_spawn_invalid_heap_size");
     
     // Test with insufficient reductions (should preempt)
     scheduler_set_reduction_count_with_state(scheduler_state, 0, 5); // Less than BIF_SPAWN_COST
-    new_pid = actly_spawn(0, 0x1000, PRIORITY_NORMAL, 8192, 4096);
+    new_pid = actly_spawn(scheduler_state, 0, 0x1000, PRIORITY_NORMAL, 8192, 4096);
     test_assert_zero(new_pid, "actly_spawn_insufficient_reductions");
     
     // Cleanup
@@ -425,7 +426,7 @@ void test_actly_bifs_spawn_yield_exit_lifecycle() {
     scheduler_set_reduction_count_with_state(scheduler_state, 0, 50);
     
     // Test spawn operation
-    uint64_t new_pid = actly_spawn(0, 0x1000, PRIORITY_NORMAL, 8192, 4096);
+    uint64_t new_pid = actly_spawn(scheduler_state, 0, 0x1000, PRIORITY_NORMAL, 8192, 4096);
     test_assert_not_zero(new_pid, "lifecycle_spawn");
     
     // Test yield operation
@@ -475,7 +476,7 @@ void test_multiple_processes_bifs() {
     scheduler_set_reduction_count_with_state(scheduler_state, 0, 50);
     
     // Test spawn from first process
-    uint64_t new_pid = actly_spawn(0, 0x1000, PRIORITY_NORMAL, 8192, 4096);
+    uint64_t new_pid = actly_spawn(scheduler_state, 0, 0x1000, PRIORITY_NORMAL, 8192, 4096);
     test_assert_not_zero(new_pid, "multi_process_spawn");
     
     // Test yield from first process
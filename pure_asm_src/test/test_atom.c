@@ -0,0 +1,315 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// test_atom.c — C test suite for the Atom Table
+// ------------------------------------------------------------
+// Tests atom.s: argument checks, the built-in and compile-time atoms,
+// intern and lookup, lookups past buckets still being published, a
+// full table and a full name arena, and several threads interning the
+// same names at once.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern void* atom_table_create(uint64_t capacity, const char** names, uint64_t count);
+extern int atom_table_destroy(void* table);
+extern uint64_t atom_intern(void* table, const char* name, uint64_t length);
+extern uint64_t atom_lookup(void* table, const char* name, uint64_t length);
+extern const char* atom_name(void* table, uint64_t atom, uint64_t* length_out);
+extern uint64_t atom_table_count(void* table);
+extern int atom_is_static(void* table, uint64_t atom);
+extern uint64_t term_make_atom(uint64_t index);
+extern uint64_t term_atom_index(uint64_t term);
+extern uint64_t term_make_int(int64_t value);
+
+// Atom and term constants (match config.inc)
+#define ATOM_BUILTIN_COUNT 2
+#define ATOM_MAX_LENGTH 255
+#define TERM_NONE 0x34
+#define TERM_FALSE 0x04
+#define TERM_TRUE 0x24
+
+// Atom table layout (match atom.s)
+#define ATOM_ARENA_CURSOR_OFFSET 40
+#define ATOM_CONTROLS_OFFSET 64
+#define ATOM_GROUP_SIZE 16
+#define ATOM_CTRL_EMPTY 0x00
+#define ATOM_CTRL_BUSY 0x01
+
+#define ATOM_TEST_THREADS 4
+#define ATOM_TEST_NAMES 500
+#define ATOM_TEST_CAPACITY 1024
+
+static uint64_t atom_test_intern(void* table, const char* name) {
+    return atom_intern(table, name, strlen(name));
+}
+
+static uint64_t atom_test_lookup(void* table, const char* name) {
+    return atom_lookup(table, name, strlen(name));
+}
+
+static void test_atom_arguments() {
+    printf("\n--- Testing atom table arguments ---\n");
+
+    const char* names[] = { "ok", NULL };
+    char long_name[ATOM_MAX_LENGTH + 2];
+    memset(long_name, 'a', sizeof(long_name) - 1);
+    long_name[sizeof(long_name) - 1] = '\0';
+    const char* long_names[] = { long_name };
+
+    test_assert_true(atom_table_create(8, NULL, 0) == NULL, "capacity below minimum");
+    test_assert_true(atom_table_create(100, NULL, 0) == NULL, "capacity not a power of two");
+    test_assert_true(atom_table_create(16, names, 15) == NULL, "too many compile-time atoms");
+    test_assert_true(atom_table_create(16, NULL, 1) == NULL, "names missing");
+    test_assert_true(atom_table_create(16, names, 2) == NULL, "NULL compile-time name");
+    test_assert_true(atom_table_create(16, long_names, 1) == NULL, "compile-time name too long");
+
+    void* table = atom_table_create(16, NULL, 0);
+    test_assert_true(table != NULL, "minimal table");
+    test_assert_equal(TERM_NONE, atom_intern(table, long_name, ATOM_MAX_LENGTH + 1), "intern name too long");
+    test_assert_equal(TERM_NONE, atom_intern(table, NULL, 3), "intern without a name");
+    test_assert_equal(TERM_NONE, atom_intern(NULL, "ok", 2), "intern without a table");
+    test_assert_true(atom_table_destroy(table), "destroy");
+    test_assert_true(!atom_table_destroy(NULL), "destroy NULL");
+}
+
+static void test_atom_static() {
+    printf("\n--- Testing built-in and compile-time atoms ---\n");
+
+    const char* names[] = { "cutIn", "result", "ok", "cutIn" };
+    void* table = atom_table_create(64, names, 4);
+    test_assert_true(table != NULL, "table with compile-time atoms");
+    test_assert_equal(ATOM_BUILTIN_COUNT + 3, atom_table_count(table), "repeated name interned once");
+
+    test_assert_equal(TERM_FALSE, atom_test_lookup(table, "false"), "@false is atom 0");
+    test_assert_equal(TERM_TRUE, atom_test_lookup(table, "true"), "@true is atom 1");
+    test_assert_equal(term_make_atom(2), atom_test_lookup(table, "cutIn"), "first compile-time atom");
+    test_assert_equal(term_make_atom(4), atom_test_lookup(table, "ok"), "compile-time atoms in order");
+    test_assert_true(atom_is_static(table, atom_test_lookup(table, "result")), "compile-time atom is static");
+    test_assert_true(atom_is_static(table, TERM_TRUE), "@true is static");
+
+    uint64_t length = 0;
+    const char* name = atom_name(table, term_make_atom(3), &length);
+    test_assert_equal(6, length, "static name length");
+    test_assert_true(name != NULL && memcmp(name, "result", 6) == 0, "static name bytes");
+
+    atom_table_destroy(table);
+}
+
+static void test_atom_intern_lookup() {
+    printf("\n--- Testing atom intern and lookup ---\n");
+
+    void* table = atom_table_create(64, NULL, 0);
+
+    test_assert_equal(TERM_NONE, atom_test_lookup(table, "missing"), "lookup does not add");
+    test_assert_equal(ATOM_BUILTIN_COUNT, atom_table_count(table), "count after lookup");
+
+    uint64_t reply = atom_test_intern(table, "reply");
+    test_assert_equal(ATOM_BUILTIN_COUNT, term_atom_index(reply), "new atom takes the next index");
+    test_assert_equal(reply, atom_test_intern(table, "reply"), "intern is idempotent");
+    test_assert_equal(reply, atom_test_lookup(table, "reply"), "lookup finds interned atom");
+    test_assert_true(!atom_is_static(table, reply), "dynamic atom is not static");
+    test_assert_true(atom_test_intern(table, "replies") != reply, "prefix names differ");
+
+    // Names that differ only in length or bytes stay distinct
+    uint64_t empty = atom_intern(table, NULL, 0);
+    test_assert_true(empty != TERM_NONE, "empty name");
+    test_assert_equal(empty, atom_intern(table, "", 0), "empty name interned once");
+    test_assert_true(atom_test_intern(table, "replz") != reply, "same length, different bytes");
+
+    uint64_t length = 0;
+    const char* name = atom_name(table, reply, &length);
+    test_assert_equal(5, length, "dynamic name length");
+    test_assert_true(name != NULL && memcmp(name, "reply", 5) == 0, "dynamic name bytes");
+    test_assert_true(atom_name(table, term_make_int(2), &length) == NULL, "name of a non-atom");
+    test_assert_true(atom_name(table, term_make_atom(60), NULL) == NULL, "name of an unused index");
+
+    atom_table_destroy(table);
+}
+
+static void test_atom_full() {
+    printf("\n--- Testing a full atom table ---\n");
+
+    void* table = atom_table_create(16, NULL, 0);
+    char name[16];
+    uint64_t added = 0;
+    for (int i = 0; i < 32; i++) {
+        snprintf(name, sizeof(name), "a%d", i);
+        if (atom_test_intern(table, name) == TERM_NONE) {
+            break;
+        }
+        added++;
+    }
+    test_assert_equal(16 - ATOM_BUILTIN_COUNT, added, "table holds capacity atoms");
+    test_assert_equal(16, atom_table_count(table), "count at capacity");
+    test_assert_equal(term_make_atom(ATOM_BUILTIN_COUNT), atom_test_intern(table, "a0"),
+                      "existing names still intern when full");
+    test_assert_equal(TERM_NONE, atom_test_lookup(table, "a99"), "lookup of a missing name when full");
+
+    // A refused name takes no arena bytes
+    uint64_t cursor = *(uint64_t*)((uint8_t*)table + ATOM_ARENA_CURSOR_OFFSET);
+    test_assert_equal(TERM_NONE, atom_test_intern(table, "a99"), "new names refused when full");
+    test_assert_equal(cursor, *(uint64_t*)((uint8_t*)table + ATOM_ARENA_CURSOR_OFFSET),
+                      "refused name leaves the arena");
+
+    atom_table_destroy(table);
+}
+
+static void test_atom_arena_full() {
+    printf("\n--- Testing a full name arena ---\n");
+
+    // 512 atoms budget 16K of names: 62 longest names, then 16 bytes
+    void* table = atom_table_create(512, NULL, 0);
+    char name[ATOM_MAX_LENGTH + 1];
+    memset(name, 'n', ATOM_MAX_LENGTH);
+    name[ATOM_MAX_LENGTH] = '\0';
+    uint64_t added = 0;
+    for (int i = 0; i < 100; i++) {
+        snprintf(name, sizeof(name), "%03d", i);
+        name[3] = 'n';
+        if (atom_intern(table, name, ATOM_MAX_LENGTH) == TERM_NONE) {
+            break;
+        }
+        added++;
+    }
+    test_assert_equal(62, added, "arena holds its budget of long names");
+    test_assert_equal(ATOM_BUILTIN_COUNT + added, atom_table_count(table), "refused name keeps no index");
+    test_assert_equal(term_make_atom(ATOM_BUILTIN_COUNT + added), atom_test_intern(table, "ok"),
+                      "short name takes the next index");
+
+    atom_table_destroy(table);
+}
+
+static void test_atom_lookup_busy() {
+    printf("\n--- Testing lookup past buckets being published ---\n");
+
+    // Mark the first empty bucket of every group as claimed by an
+    // insert that has not published yet
+    void* table = atom_table_create(16, NULL, 0);
+    uint8_t* controls = *(uint8_t**)((uint8_t*)table + ATOM_CONTROLS_OFFSET);
+    uint8_t* claimed[2] = { NULL, NULL };
+    for (int g = 0; g < 2; g++) {
+        for (int b = 0; b < ATOM_GROUP_SIZE; b++) {
+            if (controls[g * ATOM_GROUP_SIZE + b] == ATOM_CTRL_EMPTY) {
+                claimed[g] = &controls[g * ATOM_GROUP_SIZE + b];
+                *claimed[g] = ATOM_CTRL_BUSY;
+                break;
+            }
+        }
+    }
+
+    test_assert_equal(TERM_NONE, atom_test_lookup(table, "pending"), "lookup does not wait on a busy bucket");
+    test_assert_equal(TERM_FALSE, atom_test_lookup(table, "false"), "lookup finds published names past busy");
+
+    for (int g = 0; g < 2; g++) {
+        *claimed[g] = ATOM_CTRL_EMPTY;
+    }
+    test_assert_equal(term_make_atom(ATOM_BUILTIN_COUNT), atom_test_intern(table, "pending"),
+                      "intern once the buckets are released");
+
+    atom_table_destroy(table);
+}
+
+typedef struct {
+    void* table;
+    uint64_t offset;
+    uint64_t atoms[ATOM_TEST_NAMES];
+} atom_test_worker;
+
+static void atom_test_name(char* buffer, size_t size, uint64_t i) {
+    snprintf(buffer, size, "protocol_tag_%llu", (unsigned long long)i);
+}
+
+// Intern every name, starting at a different one in each thread
+static void* atom_test_interner(void* argument) {
+    atom_test_worker* worker = argument;
+    char name[32];
+    for (uint64_t n = 0; n < ATOM_TEST_NAMES; n++) {
+        uint64_t i = (n + worker->offset) % ATOM_TEST_NAMES;
+        atom_test_name(name, sizeof(name), i);
+        worker->atoms[i] = atom_test_intern(worker->table, name);
+    }
+    return NULL;
+}
+
+static void test_atom_concurrent() {
+    printf("\n--- Testing concurrent atom intern ---\n");
+
+    void* table = atom_table_create(ATOM_TEST_CAPACITY, NULL, 0);
+    atom_test_worker* workers = calloc(ATOM_TEST_THREADS, sizeof(atom_test_worker));
+    pthread_t threads[ATOM_TEST_THREADS];
+    for (int t = 0; t < ATOM_TEST_THREADS; t++) {
+        workers[t].table = table;
+        workers[t].offset = (uint64_t)t * (ATOM_TEST_NAMES / ATOM_TEST_THREADS);
+        pthread_create(&threads[t], NULL, atom_test_interner, &workers[t]);
+    }
+    for (int t = 0; t < ATOM_TEST_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    int agree = 1;
+    int named = 1;
+    char name[32];
+    for (uint64_t i = 0; i < ATOM_TEST_NAMES; i++) {
+        for (int t = 1; t < ATOM_TEST_THREADS; t++) {
+            agree &= workers[t].atoms[i] == workers[0].atoms[i];
+        }
+        atom_test_name(name, sizeof(name), i);
+        uint64_t length = 0;
+        const char* stored = atom_name(table, workers[0].atoms[i], &length);
+        named &= stored != NULL && length == strlen(name) && memcmp(stored, name, length) == 0;
+    }
+    test_assert_true(agree, "every thread got the same atom for each name");
+    test_assert_true(named, "every atom names its string");
+    test_assert_equal(ATOM_BUILTIN_COUNT + ATOM_TEST_NAMES, atom_table_count(table), "each name interned once");
+
+    free(workers);
+    atom_table_destroy(table);
+}
+
+void test_atom_main() {
+    printf("=== ATOM TABLE TEST SUITE ===\n");
+
+    test_atom_arguments();
+    test_atom_static();
+    test_atom_intern_lookup();
+    test_atom_lookup_busy();
+    test_atom_full();
+    test_atom_arena_full();
+    test_atom_concurrent();
+
+    printf("=== ATOM TABLE TEST SUITE COMPLETE ===\n");
+}
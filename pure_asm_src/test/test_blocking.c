@@ -41,6 +41,10 @@
 
 // External assembly functions (now included from scheduler_functions.h)
 extern uint64_t process_check_timer_wakeups(uint64_t core_id);
+extern int timer_wheel_init(void* scheduler_states, uint64_t core_id);
+extern int timer_wheel_destroy(void* scheduler_states, uint64_t core_id);
+extern uint64_t timer_wheel_process(void* scheduler_states, uint64_t core_id, uint64_t now);
+extern int cancel_timer(uint64_t timer_id);
 
 // External process functions
 extern void* process_create(uint64_t entry_point, uint64_t priority, uint64_t stack_size, uint64_t heap_size);
@@ -89,15 +93,16 @@ typedef struct {
     uint64_t last_scheduled; // Offset 376: Last scheduled timestamp (8 bytes)
     uint64_t affinity_mask; // Offset 384: CPU affinity mask (8 bytes)
     uint64_t migration_count; // Offset 392: Migration count (8 bytes)
-    uint64_t stack_pointer; // Offset 400: Current stack pointer (8 bytes)
-    uint64_t stack_limit; // Offset 408: Stack limit (8 bytes)
-    uint64_t heap_pointer; // Offset 416: Current heap pointer (8 bytes)
-    uint64_t heap_limit; // Offset 424: Heap limit (8 bytes)
-    uint64_t blocking_reason; // Offset 432: Blocking reason (8 bytes)
-    uint64_t blocking_data; // Offset 440: Blocking data (8 bytes)
-    uint64_t wake_time; // Offset 448: Timer wake time (8 bytes)
-    uint64_t message_pattern; // Offset 456: Receive pattern (8 bytes)
-    // Total size: 464 bytes
+    uint64_t last_migration_time; // Offset 400: Last migration timestamp (8 bytes)
+    uint64_t stack_pointer; // Offset 408: Current stack pointer (8 bytes)
+    uint64_t stack_limit; // Offset 416: Stack limit (8 bytes)
+    uint64_t heap_pointer; // Offset 424: Current heap pointer (8 bytes)
+    uint64_t heap_limit; // Offset 432: Heap limit (8 bytes)
+    uint64_t blocking_reason; // Offset 440: Blocking reason (8 bytes)
+    uint64_t blocking_data; // Offset 448: Blocking data (8 bytes)
+    uint64_t wake_time; // Offset 456: Timer wake time (8 bytes)
+    uint64_t message_pattern; // Offset 464: Receive pattern (8 bytes)
+    // Total size: 472 bytes
 } test_process_t;
 
 // Helper function to create a test process
@@ -168,7 +173,20 @@ void test_process_block_and_wake() {
     state = process_get_state(pcb);
     
     test_assert_equal(PROCESS_STATE_READY, state, "wake_state_change");
-    
+
+    // Blocking records its reason without touching the heap fields
+    // the term allocator bumps (pcb_heap_pointer, pcb_heap_limit)
+    test_process_t* fields = (test_process_t*)pcb;
+    fields->heap_pointer = fields->heap_base;
+    fields->heap_limit = fields->heap_base + fields->heap_size;
+    scheduler_set_current_process_with_state(scheduler_state, 0, pcb);
+    process_block(scheduler_state, 0, pcb, REASON_IO);
+    test_assert_equal(REASON_IO, fields->blocking_reason, "block_reason_in_pcb");
+    test_assert_equal(fields->heap_base, fields->heap_pointer, "block_keeps_heap_pointer");
+    test_assert_equal(fields->heap_base + fields->heap_size, fields->heap_limit, "block_keeps_heap_limit");
+    process_wake(scheduler_state, 0, pcb);
+    test_assert_equal(fields->heap_base + fields->heap_size, fields->heap_limit, "wake_keeps_heap_limit");
+
     // Test invalid core ID
     next_process = process_block(scheduler_state, 128, pcb, REASON_RECEIVE);
     test_assert_zero((uint64_t)next_process, "block_invalid_core");
@@ -294,6 +312,48 @@ void test_process_block_on_timer() {
     scheduler_state_destroy(scheduler_state);
 }
 
+// ------------------------------------------------------------
+// Test Timeout Cancellation on Wake
+// ------------------------------------------------------------
+void test_process_timeout_cancelled_on_wake() {
+    printf("\n--- Testing timeout cancellation on wake ---\n");
+
+    void* scheduler_state = scheduler_state_init(1);
+    scheduler_init(scheduler_state, 0);
+    timer_wheel_init(scheduler_state, 0);
+
+    test_process_t* pcb = create_blocking_test_process(1, PRIORITY_NORMAL, PROCESS_STATE_RUNNING);
+    scheduler_set_current_process_with_state(scheduler_state, 0, pcb);
+
+    test_assert_equal(1, process_block_on_timer(scheduler_state, 0, pcb, 1000), "timeout_block");
+    uint64_t timer = pcb->blocking_data;
+    test_assert_not_zero(timer, "timeout_timer_armed");
+    uint64_t expiry = pcb->wake_time;
+
+    // Woken early (by a message, say): the timeout is disarmed
+    test_assert_equal(1, process_wake(scheduler_state, 0, pcb), "timeout_early_wake");
+    test_assert_zero(pcb->blocking_data, "timeout_id_cleared");
+    test_assert_equal(0, cancel_timer(timer), "timeout_already_cancelled");
+
+    // The old timeout must not wake the process out of a later receive
+    scheduler_set_current_process_with_state(scheduler_state, 0, pcb);
+    process_block(scheduler_state, 0, pcb, REASON_RECEIVE);
+    test_assert_equal(0, timer_wheel_process(scheduler_state, 0, expiry + (1ULL << 16)), "stale_timeout_not_fired");
+    test_assert_equal(PROCESS_STATE_WAITING, process_get_state(pcb), "stale_timeout_no_wake");
+    test_assert_equal(REASON_RECEIVE, pcb->blocking_reason, "still_blocked_in_receive");
+
+    // A timeout that does expire still wakes its own block
+    process_wake(scheduler_state, 0, pcb);
+    scheduler_set_current_process_with_state(scheduler_state, 0, pcb);
+    test_assert_equal(1, process_block_on_timer(scheduler_state, 0, pcb, 1000), "timeout_block_again");
+    test_assert_equal(1, timer_wheel_process(scheduler_state, 0, pcb->wake_time + (1ULL << 16)), "timeout_fires");
+    test_assert_equal(PROCESS_STATE_READY, process_get_state(pcb), "timeout_wakes_process");
+
+    timer_wheel_destroy(scheduler_state, 0);
+    free(pcb);
+    scheduler_state_destroy(scheduler_state);
+}
+
 // ------------------------------------------------------------
 // Test Process Block on I/O Function
 // ------------------------------------------------------------
@@ -500,6 +560,41 @@ void test_block_wake_cycle() {
 // ------------------------------------------------------------
 // Main Test Function
 // ------------------------------------------------------------
+// ------------------------------------------------------------
+// Test Wake of a Process Homed on Another Scheduler
+// ------------------------------------------------------------
+void test_process_wake_remote() {
+    printf("\n--- Testing process_wake Across Schedulers ---\n");
+
+    void* scheduler_state = scheduler_state_init(2);
+    if (scheduler_state == NULL) {
+        printf("ERROR: Failed to create scheduler state\n");
+        return;
+    }
+    scheduler_init(scheduler_state, 0);
+    scheduler_init(scheduler_state, 1);
+
+    // Blocked on core 1
+    test_process_t* pcb = create_blocking_test_process(1, PRIORITY_NORMAL, PROCESS_STATE_RUNNING);
+    pcb->scheduler_id = 1;
+    scheduler_set_current_process_with_state(scheduler_state, 1, pcb);
+    process_block(scheduler_state, 1, pcb, REASON_RECEIVE);
+
+    // Woken from core 0: handed to core 1, not queued on core 0
+    test_assert_equal(1, process_wake(scheduler_state, 0, pcb), "wake_remote_success");
+    test_assert_equal(PROCESS_STATE_READY, pcb->state, "wake_remote_ready");
+    test_assert_zero(scheduler_get_queue_length_with_state(scheduler_state, 0, PRIORITY_NORMAL), "wake_remote_not_on_caller");
+
+    // A second waker finds it already woken
+    test_assert_equal(0, process_wake(scheduler_state, 0, pcb), "wake_remote_only_once");
+
+    // The home scheduler runs it on its next pass
+    test_assert_equal((uint64_t)pcb, (uint64_t)scheduler_run_pass(scheduler_state, 1), "wake_remote_dispatched_at_home");
+
+    free(pcb);
+    scheduler_state_destroy(scheduler_state);
+}
+
 // ------------------------------------------------------------
 // test_scheduler_enqueue_basic — Test basic scheduler_enqueue_process functionality
 // ------------------------------------------------------------
@@ -589,6 +684,8 @@ void test_blocking_main() {
     
     // Test timer-based blocking
     test_process_block_on_timer();
+    test_process_timeout_cancelled_on_wake();
+    test_process_wake_remote();
     
     // Test I/O blocking
     test_process_block_on_io();
@@ -0,0 +1,551 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// ------------------------------------------------------------
+// test_btree.c — C test suite for Cache-Line B+ Trees
+// ------------------------------------------------------------
+// Tests btree.s: off-heap insert, lookup and bulk load, the NEON key
+// rank at every position and at extreme keys, node size and line
+// alignment, range cursors, running out of nodes, and persistent
+// trees on a PCB heap: path copying, sharing between versions, bulk
+// builds from lists and nodes passing through term.s heap walks,
+// copies and equality.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern void* btree_create(uint64_t capacity);
+extern int btree_destroy(void* tree);
+extern int btree_insert(void* tree, int64_t key, uint64_t value);
+extern int btree_lookup(void* tree, int64_t key, uint64_t* value_out);
+extern int btree_load(void* tree, const int64_t* keys, const uint64_t* values, uint64_t count);
+extern uint64_t btree_count(void* tree);
+extern int btree_seek(void* cursor, void* tree, int64_t key);
+extern int btree_next(void* cursor, uint64_t* key_out, uint64_t* value_out);
+extern uint64_t pbtree_new(void* pcb);
+extern uint64_t pbtree_get(uint64_t tree, uint64_t key);
+extern uint64_t pbtree_put(void* pcb, uint64_t tree, uint64_t key, uint64_t value);
+extern uint64_t pbtree_from_list(void* pcb, uint64_t list);
+extern uint64_t pbtree_size(uint64_t tree);
+extern int pbtree_seek(void* cursor, uint64_t tree, uint64_t key);
+extern uint64_t term_make_int(int64_t value);
+extern uint64_t term_make_atom(uint64_t index);
+extern uint64_t term_type(uint64_t term);
+extern uint64_t term_tuple(void* pcb, uint64_t arity);
+extern int term_set_element(uint64_t tuple, uint64_t index, uint64_t value);
+extern uint64_t term_cons(void* pcb, uint64_t head, uint64_t tail);
+extern uint64_t term_size(uint64_t term);
+extern uint64_t term_copy(void* pcb, uint64_t term);
+extern int term_equal(uint64_t a, uint64_t b);
+extern uint64_t* term_heap_next(uint64_t* object);
+
+// Term constants (match config.inc)
+#define TERM_NIL 0x14
+#define TERM_NONE 0x34
+#define TERM_TYPE_BTREE 9
+
+// Node layout (match config.inc)
+#define BTREE_NODE_SIZE 256
+#define BTREE_KEYS 14
+#define BTREE_KEY_PAD 0x7FFFFFFFFFFFFFF8LL
+#define BTREE_CURSOR_SIZE 264
+#define CACHE_LINE_SIZE 128
+
+#define BTREE_TEST_HEAP_WORDS (1 << 21)
+#define BTREE_TEST_KEYS 20000
+#define BTREE_TEST_PERSISTENT_KEYS 5000
+
+// Cursor: levels, then (node, index) per level from the root
+typedef struct {
+    uint64_t words[BTREE_CURSOR_SIZE / 8];
+} btree_test_cursor_t;
+
+// The i-th of n keys in a scrambled order (7919 is prime to n)
+static int64_t btree_test_scrambled(int64_t i, int64_t n) {
+    return (i * 7919) % n;
+}
+
+// Step a cursor to its end; 1 if keys ascend and each value is key * 3
+static int btree_test_scan(btree_test_cursor_t* cursor, uint64_t* steps) {
+    uint64_t key, value, previous = 0;
+    int ordered = 1;
+    *steps = 0;
+    while (btree_next(cursor, &key, &value)) {
+        ordered &= *steps == 0 || (int64_t)key > (int64_t)previous;
+        ordered &= value == key * 3;
+        previous = key;
+        (*steps)++;
+    }
+    return ordered;
+}
+
+// [{0, 0}, {2, 20}, ...]: count pairs with even keys, built back to front
+static uint64_t btree_test_list(void* pcb, int64_t count) {
+    uint64_t list = TERM_NIL;
+    for (int64_t k = count - 1; k >= 0; k--) {
+        uint64_t pair = term_tuple(pcb, 2);
+        term_set_element(pair, 0, term_make_int(2 * k));
+        term_set_element(pair, 1, term_make_int(20 * k));
+        list = term_cons(pcb, pair, list);
+    }
+    return list;
+}
+
+static void test_btree_basics() {
+    printf("\n--- Testing off-heap B+ tree basics ---\n");
+
+    test_assert_true(btree_create(0) == NULL, "zero capacity rejected");
+    test_assert_true(btree_create(0x100000001ULL) == NULL, "capacity past the maximum rejected");
+
+    void* tree = btree_create(100);
+    uint64_t value = 0;
+    test_assert_true(tree != NULL, "tree created");
+    test_assert_equal(0, btree_count(tree), "new tree is empty");
+    test_assert_equal(0, btree_lookup(tree, 5, &value), "empty tree has no keys");
+
+    test_assert_equal(1, btree_insert(tree, 5, 50), "insert");
+    test_assert_equal(1, btree_lookup(tree, 5, &value), "lookup finds the key");
+    test_assert_equal(50, value, "lookup reads the value");
+    test_assert_equal(1, btree_lookup(tree, 5, NULL), "lookup without a value pointer");
+    test_assert_equal(0, btree_lookup(tree, 4, &value), "key below absent");
+    test_assert_equal(0, btree_lookup(tree, 6, &value), "key above absent");
+
+    test_assert_equal(1, btree_insert(tree, 5, 51), "insert an existing key");
+    btree_lookup(tree, 5, &value);
+    test_assert_equal(51, value, "insert replaces the value");
+    test_assert_equal(1, btree_count(tree), "replace keeps the count");
+
+    test_assert_equal(0, btree_insert(NULL, 1, 1), "insert into NULL");
+    test_assert_equal(0, btree_lookup(NULL, 1, &value), "lookup in NULL");
+    test_assert_equal(0, btree_count(NULL), "count of NULL");
+    test_assert_equal(0, btree_destroy(NULL), "destroy NULL");
+    test_assert_equal(1, btree_destroy(tree), "destroy");
+}
+
+static void test_btree_rank() {
+    printf("\n--- Testing NEON key rank ---\n");
+
+    // One full leaf: every key position, gaps and both ends
+    void* tree = btree_create(100);
+    for (int64_t k = 0; k < BTREE_KEYS; k++) {
+        btree_insert(tree, 10 * (BTREE_KEYS - k), (uint64_t)k);
+    }
+    int found = 1, absent = 1;
+    for (int64_t k = 1; k <= BTREE_KEYS; k++) {
+        uint64_t value = 0;
+        found &= btree_lookup(tree, 10 * k, &value) && value == (uint64_t)(BTREE_KEYS - k);
+        absent &= !btree_lookup(tree, 10 * k - 5, NULL);
+    }
+    absent &= !btree_lookup(tree, 10 * BTREE_KEYS + 5, NULL);
+    test_assert_true(found, "every position of a full leaf found");
+    test_assert_true(absent, "keys between and past them absent");
+
+    btree_test_cursor_t cursor;
+    btree_seek(&cursor, tree, -1000);
+    test_assert_equal(1, cursor.words[0], "one full leaf is one level");
+    uint64_t* leaf = (uint64_t*)cursor.words[1];
+    test_assert_equal(0, (uint64_t)leaf % CACHE_LINE_SIZE, "node starts a cache line");
+    test_assert_equal(BTREE_NODE_SIZE / 8 - 1, leaf[0] >> 8, "node body fills two lines");
+    btree_destroy(tree);
+
+    // Extreme keys, including the padding value itself
+    int64_t extremes[] = {INT64_MIN, -1, 0, 1, BTREE_KEY_PAD - 1, BTREE_KEY_PAD, INT64_MAX};
+    int count = (int)(sizeof(extremes) / sizeof(extremes[0]));
+    tree = btree_create(100);
+    for (int i = count - 1; i >= 0; i--) {
+        btree_insert(tree, extremes[i], (uint64_t)i);
+    }
+    int right = 1;
+    for (int i = 0; i < count; i++) {
+        uint64_t value = 99;
+        right &= btree_lookup(tree, extremes[i], &value) && value == (uint64_t)i;
+    }
+    test_assert_true(right, "extreme keys found");
+    test_assert_equal(0, btree_lookup(tree, INT64_MAX - 1, NULL), "key beside INT64_MAX absent");
+
+    btree_seek(&cursor, tree, INT64_MIN);
+    uint64_t key, value;
+    int ordered = 1;
+    for (int i = 0; i < count; i++) {
+        ordered &= btree_next(&cursor, &key, &value) && (int64_t)key == extremes[i] && value == (uint64_t)i;
+    }
+    ordered &= !btree_next(&cursor, &key, &value);
+    test_assert_true(ordered, "extreme keys scan in signed order");
+    btree_destroy(tree);
+}
+
+static void test_btree_many_keys() {
+    printf("\n--- Testing off-heap B+ tree with many keys ---\n");
+
+    void* tree = btree_create(BTREE_TEST_KEYS);
+    int inserted = 1;
+    for (int64_t i = 0; i < BTREE_TEST_KEYS; i++) {
+        int64_t k = btree_test_scrambled(i, BTREE_TEST_KEYS);
+        inserted &= btree_insert(tree, k, (uint64_t)k * 3);
+    }
+    test_assert_true(inserted, "capacity keys fit in any order");
+    test_assert_equal(BTREE_TEST_KEYS, btree_count(tree), "every key counted");
+
+    int found = 1;
+    for (int64_t k = 0; k < BTREE_TEST_KEYS; k++) {
+        uint64_t value = 0;
+        found &= btree_lookup(tree, k, &value) && value == (uint64_t)k * 3;
+    }
+    test_assert_true(found, "every key maps to its value");
+    test_assert_equal(0, btree_lookup(tree, -1, NULL), "key below the range absent");
+    test_assert_equal(0, btree_lookup(tree, BTREE_TEST_KEYS, NULL), "key past the range absent");
+
+    btree_test_cursor_t cursor;
+    uint64_t steps;
+    btree_seek(&cursor, tree, INT64_MIN);
+    test_assert_true(btree_test_scan(&cursor, &steps), "full scan ascends");
+    test_assert_equal(BTREE_TEST_KEYS, steps, "full scan visits every key");
+    test_assert_true(cursor.words[0] >= 3 && cursor.words[0] <= 6, "splits keep the tree shallow");
+
+    int aligned = 1;
+    for (uint64_t level = 0; level < cursor.words[0]; level++) {
+        aligned &= cursor.words[1 + 2 * level] % BTREE_NODE_SIZE == 0;
+    }
+    test_assert_true(aligned, "every node on a path is aligned");
+    btree_destroy(tree);
+}
+
+static void test_btree_ranges() {
+    printf("\n--- Testing range cursors ---\n");
+
+    // Even keys 0..1998
+    void* tree = btree_create(1000);
+    for (int64_t k = 0; k < 1000; k++) {
+        btree_insert(tree, 2 * k, (uint64_t)(6 * k));
+    }
+
+    btree_test_cursor_t cursor;
+    uint64_t key, value;
+    test_assert_equal(1, btree_seek(&cursor, tree, 500), "seek");
+    uint64_t steps = 0;
+    int right = 1;
+    while (btree_next(&cursor, &key, &value) && key <= 700) {
+        right &= key == 500 + 2 * steps && value == key * 3;
+        steps++;
+    }
+    test_assert_true(right, "range [500, 700] in order");
+    test_assert_equal(101, steps, "range [500, 700] holds 101 keys");
+
+    btree_seek(&cursor, tree, 501);
+    test_assert_true(btree_next(&cursor, &key, NULL) && key == 502, "seek between keys starts at the next");
+    btree_seek(&cursor, tree, -50);
+    test_assert_true(btree_next(&cursor, &key, NULL) && key == 0, "seek below the first key");
+    btree_seek(&cursor, tree, 1998);
+    test_assert_true(btree_next(&cursor, NULL, &value) && value == 5994, "seek to the last key");
+    test_assert_equal(0, btree_next(&cursor, &key, &value), "nothing after the last key");
+    test_assert_equal(0, btree_next(&cursor, &key, &value), "a finished cursor stays finished");
+    btree_seek(&cursor, tree, 1999);
+    test_assert_equal(0, btree_next(&cursor, &key, &value), "seek past the last key");
+
+    test_assert_equal(0, btree_seek(NULL, tree, 0), "seek without a cursor");
+    test_assert_equal(0, btree_seek(&cursor, NULL, 0), "seek without a tree");
+    test_assert_equal(0, btree_next(NULL, &key, &value), "next without a cursor");
+    btree_destroy(tree);
+
+    tree = btree_create(10);
+    btree_seek(&cursor, tree, 0);
+    test_assert_equal(0, btree_next(&cursor, &key, &value), "empty tree scans nothing");
+    btree_destroy(tree);
+}
+
+static void test_btree_load() {
+    printf("\n--- Testing bulk loading ---\n");
+
+    int64_t* keys = malloc(BTREE_TEST_KEYS * sizeof(int64_t));
+    uint64_t* values = malloc(BTREE_TEST_KEYS * sizeof(uint64_t));
+    for (int64_t i = 0; i < BTREE_TEST_KEYS; i++) {
+        keys[i] = 5 * i - 1000;
+        values[i] = (uint64_t)keys[i] * 3;
+    }
+
+    void* tree = btree_create(BTREE_TEST_KEYS);
+    btree_insert(tree, 7, 21);
+    test_assert_equal(1, btree_load(tree, keys, values, BTREE_TEST_KEYS), "load sorted pairs");
+    test_assert_equal(BTREE_TEST_KEYS, btree_count(tree), "load sets the count");
+    test_assert_equal(0, btree_lookup(tree, 7, NULL), "load replaces the contents");
+
+    int found = 1;
+    for (int64_t i = 0; i < BTREE_TEST_KEYS; i++) {
+        uint64_t value = 0;
+        found &= btree_lookup(tree, keys[i], &value) && value == values[i];
+        found &= !btree_lookup(tree, keys[i] + 1, NULL);
+    }
+    test_assert_true(found, "every loaded key found, none between");
+
+    btree_test_cursor_t cursor;
+    uint64_t steps;
+    btree_seek(&cursor, tree, INT64_MIN);
+    test_assert_true(btree_test_scan(&cursor, &steps), "loaded tree scans in order");
+    test_assert_equal(BTREE_TEST_KEYS, steps, "loaded tree scans every key");
+    // 20000 keys fill 1429 leaves, 96 branches, 7 and a root
+    test_assert_equal(4, cursor.words[0], "loaded tree has the fewest levels");
+
+    // Inserts after a load split the full leaves
+    test_assert_equal(1, btree_insert(tree, -998, 1), "insert after a load");
+    test_assert_equal(1, btree_lookup(tree, -998, NULL), "inserted key found after a load");
+    test_assert_equal(1, btree_lookup(tree, -995, NULL), "loaded key beside it kept");
+
+    // Rejected loads leave the tree as it was
+    keys[100] = keys[99];
+    test_assert_equal(0, btree_load(tree, keys, values, BTREE_TEST_KEYS), "duplicate keys rejected");
+    keys[100] = keys[98];
+    test_assert_equal(0, btree_load(tree, keys, values, BTREE_TEST_KEYS), "descending keys rejected");
+    test_assert_equal(BTREE_TEST_KEYS + 1, btree_count(tree), "rejected load keeps the tree");
+    keys[100] = 5 * 100 - 1000;
+    test_assert_equal(0, btree_load(tree, NULL, values, 3), "load without keys");
+    test_assert_equal(0, btree_load(NULL, keys, values, 3), "load into NULL");
+
+    void* small = btree_create(100);
+    test_assert_equal(0, btree_load(small, keys, values, BTREE_TEST_KEYS), "load past the capacity rejected");
+    test_assert_equal(1, btree_load(small, keys, values, 100), "load the capacity");
+    test_assert_equal(1, btree_load(small, NULL, NULL, 0), "load nothing");
+    test_assert_equal(0, btree_count(small), "empty load empties the tree");
+    test_assert_equal(1, btree_insert(small, 3, 9), "insert after an empty load");
+    btree_destroy(small);
+
+    btree_destroy(tree);
+    free(keys);
+    free(values);
+}
+
+static void test_btree_exhaustion() {
+    printf("\n--- Testing off-heap trees running out of nodes ---\n");
+
+    void* tree = btree_create(50);
+    int64_t k = 0;
+    while (btree_insert(tree, k, (uint64_t)k * 3)) {
+        k++;
+    }
+    test_assert_true(k >= 50, "at least capacity keys fit");
+    test_assert_equal((uint64_t)k, btree_count(tree), "failed insert leaves the count");
+    test_assert_equal(0, btree_lookup(tree, k, NULL), "failed insert stores nothing");
+    test_assert_equal(1, btree_insert(tree, 0, 1), "replacing needs no node");
+
+    btree_test_cursor_t cursor;
+    uint64_t steps;
+    btree_insert(tree, 0, 0);
+    btree_seek(&cursor, tree, 0);
+    test_assert_true(btree_test_scan(&cursor, &steps), "tree still ordered");
+    test_assert_equal((uint64_t)k, steps, "tree still whole");
+    btree_destroy(tree);
+}
+
+static void test_btree_persistent() {
+    printf("\n--- Testing persistent B+ trees ---\n");
+
+    void* pcb = test_pcb_with_heap(BTREE_TEST_HEAP_WORDS);
+    uint64_t empty = pbtree_new(pcb);
+    uint64_t one = term_make_int(1);
+    test_assert_equal(TERM_TYPE_BTREE, term_type(empty), "type of persistent tree");
+    test_assert_equal(0, pbtree_size(empty), "new tree is empty");
+    test_assert_equal(TERM_NONE, pbtree_get(empty, one), "empty tree has no keys");
+
+    uint64_t t1 = pbtree_put(pcb, empty, one, term_make_atom(5));
+    test_assert_equal(term_make_atom(5), pbtree_get(t1, one), "put then get");
+    test_assert_equal(TERM_NONE, pbtree_get(empty, one), "put leaves the old version");
+    uint64_t used = test_pcb_heap_pointer(pcb);
+    test_assert_equal(t1, pbtree_put(pcb, t1, one, term_make_atom(5)), "putting the same value returns the tree");
+    test_assert_equal(used, test_pcb_heap_pointer(pcb), "unchanged put allocates nothing");
+
+    test_assert_equal(TERM_NONE, pbtree_put(pcb, empty, term_make_atom(1), one), "atom keys rejected");
+    test_assert_equal(TERM_NONE, pbtree_put(pcb, empty, one, TERM_NONE), "TERM_NONE is not a value");
+    test_assert_equal(TERM_NONE, pbtree_put(pcb, term_tuple(pcb, 2), one, one), "put into a non-tree");
+    test_assert_equal(TERM_NONE, pbtree_get(term_make_int(3), one), "get from a non-tree");
+    test_assert_equal(0, pbtree_size(TERM_NIL), "size of a non-tree");
+    test_assert_equal(TERM_NONE, pbtree_new(NULL), "tree without a PCB");
+
+    // Many versions, each one put apart
+    uint64_t tree = empty;
+    for (int64_t i = 0; i < BTREE_TEST_PERSISTENT_KEYS; i++) {
+        int64_t k = btree_test_scrambled(i, BTREE_TEST_PERSISTENT_KEYS);
+        tree = pbtree_put(pcb, tree, term_make_int(k), term_make_int(3 * k));
+    }
+    test_assert_equal(BTREE_TEST_PERSISTENT_KEYS, pbtree_size(tree), "every key stored");
+    int found = 1;
+    for (int64_t k = 0; k < BTREE_TEST_PERSISTENT_KEYS; k++) {
+        found &= pbtree_get(tree, term_make_int(k)) == term_make_int(3 * k);
+    }
+    test_assert_true(found, "every key maps to its value");
+
+    uint64_t key = term_make_int(1234);
+    uint64_t start = test_pcb_heap_pointer(pcb);
+    uint64_t after = pbtree_put(pcb, tree, key, term_make_atom(9));
+    uint64_t words = (test_pcb_heap_pointer(pcb) - start) / 8;
+    test_assert_equal(term_make_atom(9), pbtree_get(after, key), "new version has the new value");
+    test_assert_equal(term_make_int(3702), pbtree_get(tree, key), "old version keeps the old value");
+    // A path of at most five nodes plus alignment; the whole tree is over 10000 words
+    test_assert_true(words <= 5 * 32 + 15, "update copies only the path");
+    test_assert_true(term_size(after) > 2 * BTREE_TEST_PERSISTENT_KEYS, "the whole tree is far larger");
+
+    // Root children off the updated path are shared, not copied
+    uint64_t* old_root = (uint64_t*)(tree - 1);
+    uint64_t* new_root = (uint64_t*)(after - 1);
+    uint64_t children = (old_root[1] >> 4) + 1;
+    uint64_t shared = 0;
+    for (uint64_t i = 0; i < children; i++) {
+        shared += old_root[16 + i] == new_root[16 + i];
+    }
+    test_assert_true(children > 1, "root is a branch");
+    test_assert_equal(children - 1, shared, "every other child is shared");
+
+    // A cursor on the old version is not disturbed by new versions
+    btree_test_cursor_t cursor;
+    uint64_t k, value;
+    test_assert_equal(1, pbtree_seek(&cursor, tree, term_make_int(1230)), "persistent seek");
+    pbtree_put(pcb, tree, term_make_int(1231), one);
+    int right = 1;
+    for (int64_t i = 1230; i < 1240; i++) {
+        right &= btree_next(&cursor, &k, &value) && k == term_make_int(i) && value == term_make_int(3 * i);
+    }
+    test_assert_true(right, "persistent cursor reads terms of its version");
+    test_assert_equal(0, pbtree_seek(&cursor, tree, term_make_atom(0)), "seek by an atom rejected");
+
+    test_pcb_free(pcb);
+}
+
+static void test_btree_from_list() {
+    printf("\n--- Testing persistent bulk builds ---\n");
+
+    void* pcb = test_pcb_with_heap(BTREE_TEST_HEAP_WORDS);
+    uint64_t list = btree_test_list(pcb, 3000);
+    uint64_t start = test_pcb_heap_pointer(pcb);
+    uint64_t tree = pbtree_from_list(pcb, list);
+    uint64_t nodes = (test_pcb_heap_pointer(pcb) - start) / BTREE_NODE_SIZE;
+    test_assert_equal(3000, pbtree_size(tree), "every pair stored");
+    // 3000 keys fill 215 leaves, 15 branches and a root
+    test_assert_equal(231, nodes, "one allocation of the fewest nodes");
+
+    int found = 1;
+    for (int64_t k = 0; k < 3000; k++) {
+        found &= pbtree_get(tree, term_make_int(2 * k)) == term_make_int(20 * k);
+        found &= pbtree_get(tree, term_make_int(2 * k + 1)) == TERM_NONE;
+    }
+    test_assert_true(found, "every key found, none between");
+
+    uint64_t grown = tree;
+    for (int64_t k = 0; k < 3000; k++) {
+        grown = pbtree_put(pcb, grown, term_make_int(2 * k + 1), term_make_int(20 * k));
+    }
+    test_assert_equal(6000, pbtree_size(grown), "puts after a build split full nodes");
+    test_assert_equal(3000, pbtree_size(tree), "the built version keeps its keys");
+
+    uint64_t none = pbtree_from_list(pcb, TERM_NIL);
+    test_assert_equal(0, pbtree_size(none), "empty list builds an empty tree");
+
+    uint64_t pair = term_tuple(pcb, 2);
+    term_set_element(pair, 0, term_make_int(-1));
+    term_set_element(pair, 1, term_make_int(5));
+    test_assert_equal(TERM_NONE, pbtree_from_list(pcb, term_cons(pcb, pair, term_cons(pcb, pair, TERM_NIL))),
+                      "repeated key rejected");
+    test_assert_true(pbtree_from_list(pcb, term_cons(pcb, pair, list)) != TERM_NONE, "smaller key first accepted");
+    uint64_t later = term_cons(pcb, pair, TERM_NIL);
+    test_assert_equal(TERM_NONE, pbtree_from_list(pcb, term_cons(pcb, term_make_int(0), later)),
+                      "non-tuple element rejected");
+    test_assert_equal(TERM_NONE, pbtree_from_list(pcb, term_cons(pcb, ((uint64_t*)(list - 2))[0], later)),
+                      "out of order rejected");
+    term_set_element(pair, 0, term_make_atom(2));
+    test_assert_equal(TERM_NONE, pbtree_from_list(pcb, term_cons(pcb, pair, TERM_NIL)), "atom key rejected");
+    test_assert_equal(TERM_NONE, pbtree_from_list(pcb, term_make_int(1)), "improper list rejected");
+    test_pcb_free(pcb);
+}
+
+static void test_btree_heap() {
+    printf("\n--- Testing persistent trees on process heaps ---\n");
+
+    void* pcb = test_pcb_with_heap(BTREE_TEST_HEAP_WORDS);
+    term_tuple(pcb, 1);                       // Put the heap off line alignment
+    uint64_t tree = pbtree_new(pcb);
+    for (int64_t k = 0; k < 500; k++) {
+        tree = pbtree_put(pcb, tree, term_make_int(k), term_make_int(3 * k));
+        term_tuple(pcb, (uint64_t)(k % 3));
+    }
+    test_assert_equal(0, (tree - 1) % CACHE_LINE_SIZE, "heap nodes start a cache line");
+
+    uint64_t* base = *(uint64_t**)((uint8_t*)pcb + PCB_HEAP_BASE_OFFSET);
+    uint64_t* object = base;
+    uint64_t* end = (uint64_t*)test_pcb_heap_pointer(pcb);
+    while (object < end) {
+        object = term_heap_next(object);
+    }
+    test_assert_true(object == end, "heap walk steps over nodes and alignment");
+
+    void* receiver = test_pcb_with_heap(BTREE_TEST_HEAP_WORDS);
+    uint64_t copy = term_copy(receiver, tree);
+    test_assert_true(term_equal(tree, copy), "copied tree is equal");
+    memset(base, 0, (size_t)((uint8_t*)end - (uint8_t*)base));
+    test_assert_equal(term_make_int(1497), pbtree_get(copy, term_make_int(499)), "copy stands alone");
+    test_assert_equal(500, pbtree_size(copy), "copy keeps every key");
+    test_pcb_free(pcb);
+    test_pcb_free(receiver);
+
+    // A full heap refuses the update and keeps no part of it
+    void* small = test_pcb_with_heap(2048);
+    uint64_t last = pbtree_new(small);
+    uint64_t mark = test_pcb_heap_pointer(small);
+    uint64_t grown = last;
+    int64_t k = 0;
+    while (grown != TERM_NONE) {
+        last = grown;
+        mark = test_pcb_heap_pointer(small);
+        grown = pbtree_put(small, last, term_make_int(k), term_make_int(3 * k));
+        k++;
+    }
+    test_assert_equal(mark, test_pcb_heap_pointer(small), "failed put leaves the heap as it was");
+    test_assert_equal((uint64_t)(k - 1), pbtree_size(last), "last good version intact");
+    test_pcb_free(small);
+}
+
+void test_btree_main() {
+    printf("=== B+ TREE TEST SUITE ===\n");
+
+    test_btree_basics();
+    test_btree_rank();
+    test_btree_many_keys();
+    test_btree_ranges();
+    test_btree_load();
+    test_btree_exhaustion();
+    test_btree_persistent();
+    test_btree_from_list();
+    test_btree_heap();
+
+    printf("=== B+ TREE TEST SUITE COMPLETE ===\n");
+}
@@ -0,0 +1,164 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// test_clock.c — C test suite for the Monotonic Clock
+// ------------------------------------------------------------
+// Tests the clock functions implemented in clock.s and the
+// per-scheduler cached clock in scheduler.s. This includes
+// calibration, tick/ns conversion, and cached "now" refresh.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern uint64_t clock_read_ticks(void);
+extern uint64_t clock_read_frequency(void);
+extern int clock_init(void* clock);
+extern uint64_t clock_ticks_to_ns(void* clock, uint64_t ticks);
+extern uint64_t clock_ns_to_ticks(void* clock, uint64_t ns);
+extern uint64_t clock_now_ns(void* clock);
+extern uint64_t clock_get_frequency(void* clock);
+extern uint64_t get_system_ticks(void);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern int scheduler_state_destroy(void* scheduler_states);
+extern uint64_t scheduler_refresh_now(void* scheduler_states, uint64_t core_id);
+extern uint64_t scheduler_get_cached_now(void* scheduler_states, uint64_t core_id);
+
+// External constants from assembly
+extern const uint64_t CLOCK_SIZE_CONST;
+
+// ------------------------------------------------------------
+// Test Clock Calibration
+// ------------------------------------------------------------
+void test_clock_calibration() {
+    printf("--- Testing Clock Calibration ---\n");
+
+    uint64_t clock[8] = {0};
+    test_assert_true(CLOCK_SIZE_CONST <= sizeof(clock), "clock_size_fits");
+
+    test_assert_equal(0, clock_init(NULL), "clock_init_null");
+    test_assert_equal(1, clock_init(clock), "clock_init_success");
+
+    uint64_t frequency = clock_get_frequency(clock);
+    test_assert_true(frequency > 0, "clock_frequency_non_zero");
+    if (clock_read_frequency() != 0) {
+        test_assert_equal(clock_read_frequency(), frequency, "clock_frequency_matches_cntfrq");
+    }
+}
+
+// ------------------------------------------------------------
+// Test Clock Conversion
+// ------------------------------------------------------------
+void test_clock_conversion() {
+    printf("--- Testing Clock Conversion ---\n");
+
+    uint64_t clock[8] = {0};
+    clock_init(clock);
+    uint64_t frequency = clock_get_frequency(clock);
+
+    // One second of ticks converts to one second of nanoseconds (within 1us)
+    uint64_t one_second = clock_ticks_to_ns(clock, frequency);
+    test_assert_true(one_second > 999999000ULL && one_second < 1000001000ULL,
+                     "clock_one_second_ticks_to_ns");
+
+    // One hour must not overflow the intermediate product
+    uint64_t one_hour = clock_ticks_to_ns(clock, frequency * 3600);
+    test_assert_true(one_hour / 1000000000ULL == 3600, "clock_one_hour_no_overflow");
+
+    // Round trip stays within one tick
+    uint64_t ticks = clock_ns_to_ticks(clock, 1000000000ULL);
+    test_assert_true(ticks + 1 >= frequency && ticks <= frequency + 1, "clock_ns_to_ticks_round_trip");
+
+    test_assert_equal(0, clock_ticks_to_ns(clock, 0), "clock_zero_ticks");
+}
+
+// ------------------------------------------------------------
+// Test Clock Monotonicity
+// ------------------------------------------------------------
+void test_clock_monotonic() {
+    printf("--- Testing Clock Monotonicity ---\n");
+
+    uint64_t clock[8] = {0};
+    clock_init(clock);
+
+    uint64_t t1 = clock_read_ticks();
+    uint64_t t2 = get_system_ticks();
+    uint64_t t3 = clock_read_ticks();
+    test_assert_true(t1 > 0, "clock_ticks_non_zero");
+    test_assert_true(t2 >= t1 && t3 >= t2, "clock_ticks_monotonic");
+
+    uint64_t n1 = clock_now_ns(clock);
+    uint64_t n2 = clock_now_ns(clock);
+    test_assert_true(n2 >= n1, "clock_now_ns_monotonic");
+}
+
+// ------------------------------------------------------------
+// Test Scheduler Cached Now
+// ------------------------------------------------------------
+void test_scheduler_cached_now() {
+    printf("--- Testing Scheduler Cached Now ---\n");
+
+    void* scheduler_states = scheduler_state_init(4);
+    test_assert_true(scheduler_states != NULL, "cached_now_setup");
+
+    // First read seeds the cache instead of returning zero
+    uint64_t seeded = scheduler_get_cached_now(scheduler_states, 1);
+    test_assert_true(seeded > 0, "cached_now_seeded");
+
+    // Cached value does not move until refreshed
+    uint64_t again = scheduler_get_cached_now(scheduler_states, 1);
+    test_assert_equal(seeded, again, "cached_now_stable");
+
+    uint64_t refreshed = scheduler_refresh_now(scheduler_states, 1);
+    test_assert_true(refreshed >= seeded, "cached_now_refresh_monotonic");
+    test_assert_equal(refreshed, scheduler_get_cached_now(scheduler_states, 1), "cached_now_after_refresh");
+
+    test_assert_equal(0, scheduler_refresh_now(NULL, 0), "cached_now_null_states");
+    test_assert_equal(0, scheduler_get_cached_now(scheduler_states, 128), "cached_now_invalid_core");
+
+    scheduler_state_destroy(scheduler_states);
+}
+
+// ------------------------------------------------------------
+// Main Clock Test Function
+// ------------------------------------------------------------
+void test_clock_main() {
+    printf("=== CLOCK TEST SUITE ===\n");
+
+    test_clock_calibration();
+    test_clock_conversion();
+    test_clock_monotonic();
+    test_scheduler_cached_now();
+
+    printf("=== CLOCK TEST SUITE COMPLETE ===\n");
+}
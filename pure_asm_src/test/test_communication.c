@@ -49,6 +49,7 @@ void test_assert_true(int condition, const char* test_name);
 
 // External assembly functions
 extern int message_queue_init(void* queue_ptr, uint32_t size);
+extern int message_queue_init_buffer(void* queue_ptr, uint32_t size, void* buffer);
 extern int send_message(void* sender_pcb, void* receiver_pcb, uint64_t message_data);
 extern uint64_t receive_message(void* receiver_pcb);
 extern uint64_t try_receive_message(void* receiver_pcb);
@@ -152,6 +153,45 @@ void test_message_queue_initialization() {
     free(queue);
 }
 
+// ------------------------------------------------------------
+// Test Message Queue Over a Caller Buffer
+// ------------------------------------------------------------
+void test_message_queue_init_buffer() {
+    printf("--- Testing Message Queue Initialization Over a Caller Buffer ---\n");
+
+    test_message_queue_t queue;
+    test_pcb_t sender;
+    test_pcb_t receiver;
+    uint64_t storage[4 * 3];  // 4 messages of 24 bytes
+
+    memset(&queue, 0xff, sizeof(queue));
+    memset(&sender, 0, sizeof(sender));
+    memset(&receiver, 0, sizeof(receiver));
+    memset(storage, 0xa5, sizeof(storage));
+
+    int result = message_queue_init_buffer(&queue, 4, storage);
+    test_assert_equal(1, result, "message_queue_init_buffer_valid");
+    test_assert_true(queue.messages == (void*)storage, "message_queue_init_buffer_uses_storage");
+    test_assert_equal(3, queue.mask, "message_queue_init_buffer_mask");
+    test_assert_equal(1, message_queue_empty(&queue), "message_queue_init_buffer_empty");
+
+    // Messages round-trip through the caller's storage
+    receiver.message_queue = &queue;
+    for (uint64_t i = 1; i <= 4; i++) {
+        send_message(&sender, &receiver, i);
+    }
+    test_assert_equal(1, message_queue_full(&queue), "message_queue_init_buffer_full");
+    test_assert_equal(0, send_message(&sender, &receiver, 5), "message_queue_init_buffer_send_when_full");
+    test_assert_equal(1, try_receive_message(&receiver), "message_queue_init_buffer_fifo_first");
+    test_assert_equal(2, try_receive_message(&receiver), "message_queue_init_buffer_fifo_second");
+
+    // Invalid parameters
+    test_assert_equal(0, message_queue_init_buffer(NULL, 4, storage), "message_queue_init_buffer_null_queue");
+    test_assert_equal(0, message_queue_init_buffer(&queue, 4, NULL), "message_queue_init_buffer_null_buffer");
+    test_assert_equal(0, message_queue_init_buffer(&queue, 3, storage), "message_queue_init_buffer_non_power_of_2");
+    test_assert_equal(0, message_queue_init_buffer(&queue, 2048, storage), "message_queue_init_buffer_too_large");
+}
+
 // ------------------------------------------------------------
 // Test Message Sending and Receiving
 // ------------------------------------------------------------
@@ -414,6 +454,10 @@ void test_communication_edge_cases() {
     result = send_message((void*)0x1, NULL, 0x123);
     test_assert_equal(0, result, "send_message_null_receiver");
     
+    // Zero is reserved: the receiver reads it as an empty slot
+    result = send_message((void*)0x1, (void*)0x1, 0);
+    test_assert_equal(0, result, "send_message_zero_data");
+    
     uint64_t received_data = try_receive_message(NULL);
     test_assert_equal(0, received_data, "try_receive_message_null_pcb");
     
@@ -450,6 +494,7 @@ void test_communication_main() {
     printf("=== INTER-CORE COMMUNICATION TEST SUITE ===\n");
     
     test_message_queue_initialization();
+    test_message_queue_init_buffer();
     test_message_sending_receiving();
     test_blocking_receive();
     test_queue_full_condition();
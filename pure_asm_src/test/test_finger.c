@@ -0,0 +1,434 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// ------------------------------------------------------------
+// test_finger.c — C test suite for Finger Trees and Chunked Deques
+// ------------------------------------------------------------
+// Tests finger.s: pushes and pops at both ends, indexing by size,
+// splits at every kind of position and concatenation, versions left
+// intact by updates, full heaps unwinding an update without a trace,
+// and chunked deques: both ends against a reference array, ring
+// growth, chunk reuse in a steady queue, and deque and tree objects
+// passing through term.s heap walks, copies and equality.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern uint64_t finger_push_front(void* pcb, uint64_t tree, uint64_t element);
+extern uint64_t finger_push_back(void* pcb, uint64_t tree, uint64_t element);
+extern uint64_t finger_pop_front(void* pcb, uint64_t tree, uint64_t* rest_out);
+extern uint64_t finger_pop_back(void* pcb, uint64_t tree, uint64_t* rest_out);
+extern uint64_t finger_concat(void* pcb, uint64_t left, uint64_t right);
+extern uint64_t finger_split(void* pcb, uint64_t tree, uint64_t index, uint64_t* right_out);
+extern uint64_t finger_index(uint64_t tree, uint64_t index);
+extern uint64_t finger_size(uint64_t tree);
+extern uint64_t deque_new(void* pcb);
+extern int deque_push_front(void* pcb, uint64_t deque, uint64_t element);
+extern int deque_push_back(void* pcb, uint64_t deque, uint64_t element);
+extern uint64_t deque_pop_front(uint64_t deque);
+extern uint64_t deque_pop_back(uint64_t deque);
+extern uint64_t deque_index(uint64_t deque, uint64_t index);
+extern uint64_t deque_size(uint64_t deque);
+extern uint64_t term_make_int(int64_t value);
+extern uint64_t term_make_atom(uint64_t index);
+extern uint64_t term_type(uint64_t term);
+extern uint64_t term_tuple(void* pcb, uint64_t arity);
+extern uint64_t term_copy(void* pcb, uint64_t term);
+extern int term_equal(uint64_t a, uint64_t b);
+extern uint64_t* term_heap_next(uint64_t* object);
+
+// Term constants (match config.inc)
+#define TERM_NIL 0x14
+#define TERM_NONE 0x34
+#define TERM_TYPE_NIL 3
+#define TERM_TYPE_FINGER 10
+#define TERM_TYPE_DEQUE 11
+#define DEQUE_CHUNK_SLOTS 32
+
+#define FINGER_TEST_HEAP_WORDS (1 << 22)
+#define FINGER_TEST_ELEMENTS 3000
+#define FINGER_TEST_DEQUE_OPS 200000
+
+// A tree of the integers first .. first + count - 1, pushed at the back
+static uint64_t finger_test_range(void* pcb, int64_t first, int64_t count) {
+    uint64_t tree = TERM_NIL;
+    for (int64_t i = 0; i < count; i++) {
+        tree = finger_push_back(pcb, tree, term_make_int(first + i));
+    }
+    return tree;
+}
+
+// 1 if tree holds exactly the integers first .. first + count - 1
+static int finger_test_holds(uint64_t tree, int64_t first, int64_t count) {
+    if (finger_size(tree) != (uint64_t)count) {
+        return 0;
+    }
+    for (int64_t i = 0; i < count; i++) {
+        if (finger_index(tree, (uint64_t)i) != term_make_int(first + i)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// 1 if every object from the heap base to the heap pointer is walked
+static int finger_test_walk(void* pcb) {
+    uint64_t* object = *(uint64_t**)((uint8_t*)pcb + PCB_HEAP_BASE_OFFSET);
+    uint64_t* end = (uint64_t*)test_pcb_heap_pointer(pcb);
+    while (object < end) {
+        object = term_heap_next(object);
+    }
+    return object == end;
+}
+
+static void test_finger_basics() {
+    printf("\n--- Testing finger tree basics ---\n");
+
+    void* pcb = test_pcb_with_heap(FINGER_TEST_HEAP_WORDS);
+    uint64_t one = term_make_int(1);
+    uint64_t rest = 0;
+    test_assert_equal(0, finger_size(TERM_NIL), "[] is the empty tree");
+    test_assert_equal(TERM_NONE, finger_index(TERM_NIL, 0), "empty tree has no elements");
+    test_assert_equal(TERM_NONE, finger_pop_front(pcb, TERM_NIL, &rest), "pop from the empty tree");
+
+    uint64_t t1 = finger_push_back(pcb, TERM_NIL, one);
+    test_assert_equal(TERM_TYPE_FINGER, term_type(t1), "type of finger tree");
+    test_assert_equal(1, finger_size(t1), "one element");
+    test_assert_equal(one, finger_index(t1, 0), "push then index");
+    test_assert_equal(one, finger_pop_back(pcb, t1, &rest), "pop the only element");
+    test_assert_equal(TERM_NIL, rest, "popping the only element leaves []");
+    test_assert_equal(TERM_TYPE_NIL, term_type(rest), "empty rest is []");
+
+    uint64_t t2 = finger_push_front(pcb, t1, term_make_atom(7));
+    test_assert_equal(term_make_atom(7), finger_index(t2, 0), "push front goes first");
+    test_assert_equal(one, finger_index(t2, 1), "old first moves up");
+    test_assert_equal(1, finger_size(t1), "push leaves the old version");
+    test_assert_equal(TERM_NONE, finger_index(t2, 2), "index past the end");
+    test_assert_equal(term_make_atom(7), finger_pop_front(pcb, t2, NULL), "pop without the rest");
+
+    test_assert_equal(TERM_NONE, finger_push_back(pcb, t1, TERM_NONE), "TERM_NONE is not an element");
+    test_assert_equal(TERM_NONE, finger_push_back(NULL, t1, one), "push without a PCB");
+    test_assert_equal(TERM_NONE, finger_push_back(pcb, term_tuple(pcb, 2), one), "push onto a non-tree");
+    test_assert_equal(TERM_NONE, finger_concat(pcb, t1, one), "concat with a non-tree");
+    test_assert_equal(TERM_NONE, finger_index(term_make_int(3), 0), "index into a non-tree");
+    test_assert_equal(0, finger_size(term_make_atom(2)), "size of a non-tree");
+
+    // The nodes a middle tree holds are not trees themselves
+    uint64_t big = finger_test_range(pcb, 0, 100);
+    uint64_t middle = ((uint64_t*)(big - 1))[2];
+    uint64_t node = finger_index(middle, 0);
+    test_assert_equal(TERM_TYPE_FINGER, term_type(node), "middle holds finger objects");
+    test_assert_equal(TERM_NONE, finger_push_back(pcb, node, one), "push onto a node rejected");
+    test_assert_equal(0, finger_size(node), "size of a node");
+
+    test_pcb_free(pcb);
+}
+
+static void test_finger_ends() {
+    printf("\n--- Testing finger tree ends ---\n");
+
+    void* pcb = test_pcb_with_heap(FINGER_TEST_HEAP_WORDS);
+    uint64_t back = finger_test_range(pcb, 0, FINGER_TEST_ELEMENTS);
+    test_assert_true(finger_test_holds(back, 0, FINGER_TEST_ELEMENTS), "pushes at the back keep order");
+
+    uint64_t front = TERM_NIL;
+    for (int64_t i = FINGER_TEST_ELEMENTS - 1; i >= 0; i--) {
+        front = finger_push_front(pcb, front, term_make_int(i));
+    }
+    test_assert_true(finger_test_holds(front, 0, FINGER_TEST_ELEMENTS), "pushes at the front keep order");
+    test_assert_true(term_equal(front, front), "tree equals itself");
+
+    // Pop everything from each end; the original stays whole
+    uint64_t tree = back;
+    int ordered = 1;
+    for (int64_t i = 0; i < FINGER_TEST_ELEMENTS; i++) {
+        uint64_t rest;
+        ordered &= finger_pop_front(pcb, tree, &rest) == term_make_int(i);
+        tree = rest;
+        if (i % 97 == 0) {
+            ordered &= finger_test_holds(tree, i + 1, FINGER_TEST_ELEMENTS - i - 1);
+        }
+    }
+    test_assert_true(ordered, "pops at the front return each element in order");
+    test_assert_equal(TERM_NIL, tree, "popping every element leaves []");
+
+    tree = front;
+    ordered = 1;
+    for (int64_t i = FINGER_TEST_ELEMENTS - 1; i >= 0; i--) {
+        uint64_t rest;
+        ordered &= finger_pop_back(pcb, tree, &rest) == term_make_int(i);
+        tree = rest;
+    }
+    test_assert_true(ordered, "pops at the back return each element in reverse");
+    test_assert_equal(TERM_NIL, tree, "popping every element from the back leaves []");
+    test_assert_true(finger_test_holds(back, 0, FINGER_TEST_ELEMENTS), "pops leave the old version");
+
+    // A queue: push at the back, pop at the front, with a growing backlog
+    uint64_t queue = TERM_NIL;
+    int64_t next = 0;
+    int64_t head = 0;
+    ordered = 1;
+    for (int64_t i = 0; i < 20000; i++) {
+        queue = finger_push_back(pcb, queue, term_make_int(next++));
+        if (i % 3 != 0) {
+            uint64_t rest;
+            ordered &= finger_pop_front(pcb, queue, &rest) == term_make_int(head++);
+            queue = rest;
+        }
+    }
+    test_assert_true(ordered, "queue pops in push order");
+    test_assert_true(finger_test_holds(queue, head, next - head), "queue holds its backlog");
+
+    // Amortized O(1): pushes allocate a few words each on average
+    uint64_t start = test_pcb_heap_pointer(pcb);
+    finger_test_range(pcb, 0, 10000);
+    uint64_t words = (test_pcb_heap_pointer(pcb) - start) / 8;
+    test_assert_true(words < 10000 * 16, "pushes allocate a bounded number of words");
+
+    test_pcb_free(pcb);
+}
+
+static void test_finger_split_concat() {
+    printf("\n--- Testing finger tree split and concat ---\n");
+
+    void* pcb = test_pcb_with_heap(FINGER_TEST_HEAP_WORDS);
+    uint64_t tree = finger_test_range(pcb, 0, FINGER_TEST_ELEMENTS);
+    int split = 1;
+    int joined = 1;
+    for (int64_t i = 0; i <= FINGER_TEST_ELEMENTS; i += 7) {
+        uint64_t right;
+        uint64_t left = finger_split(pcb, tree, (uint64_t)i, &right);
+        split &= finger_test_holds(left, 0, i);
+        split &= finger_test_holds(right, i, FINGER_TEST_ELEMENTS - i);
+        joined &= finger_test_holds(finger_concat(pcb, left, right), 0, FINGER_TEST_ELEMENTS);
+    }
+    test_assert_true(split, "split at every seventh index");
+    test_assert_true(joined, "concat of the parts is the whole");
+    test_assert_true(finger_test_holds(tree, 0, FINGER_TEST_ELEMENTS), "split leaves the tree");
+
+    uint64_t right;
+    test_assert_equal(TERM_NIL, finger_split(pcb, tree, 0, &right), "split at 0 keeps nothing on the left");
+    test_assert_equal(tree, right, "split at 0 leaves the tree on the right");
+    test_assert_equal(tree, finger_split(pcb, tree, FINGER_TEST_ELEMENTS + 5, &right), "split past the end");
+    test_assert_equal(TERM_NIL, right, "split past the end leaves [] on the right");
+    test_assert_equal(TERM_NIL, finger_split(pcb, TERM_NIL, 3, NULL), "split of []");
+
+    // Concat trees of every small size, which covers single and
+    // shallow trees on both sides
+    uint64_t all = TERM_NIL;
+    int64_t total = 0;
+    int whole = 1;
+    for (int64_t k = 1; k < 60; k++) {
+        all = finger_concat(pcb, all, finger_test_range(pcb, total, k));
+        total += k;
+        whole &= finger_test_holds(all, 0, total);
+    }
+    test_assert_true(whole, "concat of growing runs");
+    test_assert_equal(all, finger_concat(pcb, all, TERM_NIL), "concat with [] on the right");
+    test_assert_equal(all, finger_concat(pcb, TERM_NIL, all), "concat with [] on the left");
+
+    // Split is logarithmic: a split deep inside allocates little
+    uint64_t big = finger_test_range(pcb, 0, 100000);
+    uint64_t start = test_pcb_heap_pointer(pcb);
+    uint64_t left = finger_split(pcb, big, 54321, &right);
+    uint64_t words = (test_pcb_heap_pointer(pcb) - start) / 8;
+    test_assert_equal(term_make_int(54320), finger_index(left, 54320), "left part ends before the index");
+    test_assert_equal(term_make_int(54321), finger_index(right, 0), "right part starts at the index");
+    test_assert_true(words < 1000, "split copies only the spines");
+
+    test_pcb_free(pcb);
+}
+
+static void test_finger_heap() {
+    printf("\n--- Testing finger trees on process heaps ---\n");
+
+    void* pcb = test_pcb_with_heap(FINGER_TEST_HEAP_WORDS);
+    uint64_t tree = finger_test_range(pcb, 0, 500);
+    test_assert_true(finger_test_walk(pcb), "heap walk steps over tree objects");
+
+    void* receiver = test_pcb_with_heap(FINGER_TEST_HEAP_WORDS);
+    uint64_t copy = term_copy(receiver, tree);
+    test_assert_true(term_equal(tree, copy), "copied tree is equal");
+    uint64_t* base = *(uint64_t**)((uint8_t*)pcb + PCB_HEAP_BASE_OFFSET);
+    memset(base, 0, (size_t)(test_pcb_heap_pointer(pcb) - (uint64_t)base));
+    test_assert_true(finger_test_holds(copy, 0, 500), "copy stands alone");
+    test_pcb_free(pcb);
+    test_pcb_free(receiver);
+
+    // A full heap unwinds the update and keeps no part of it
+    void* small = test_pcb_with_heap(4096);
+    uint64_t last = TERM_NIL;
+    uint64_t grown = last;
+    uint64_t mark = 0;
+    int64_t k = 0;
+    while (grown != TERM_NONE) {
+        last = grown;
+        mark = test_pcb_heap_pointer(small);
+        grown = finger_push_front(small, last, term_make_int(-k));
+        k++;
+    }
+    test_assert_equal(mark, test_pcb_heap_pointer(small), "failed push leaves the heap as it was");
+    test_assert_true(finger_test_holds(last, -(k - 2), k - 1), "last good version intact");
+
+    // With no room at all, every update fails and stores nothing
+    mark = test_pcb_heap_pointer(small);
+    *(uint64_t*)((uint8_t*)small + PCB_HEAP_LIMIT_OFFSET) = mark;
+    uint64_t right = 0;
+    test_assert_equal(TERM_NONE, finger_split(small, last, (uint64_t)k / 2, &right), "split on a full heap fails");
+    test_assert_equal(0, right, "failed split stores nothing");
+    test_assert_equal(TERM_NONE, finger_concat(small, last, last), "concat on a full heap fails");
+    test_assert_equal(mark, test_pcb_heap_pointer(small), "failed updates leave the heap as it was");
+    test_pcb_free(small);
+}
+
+static void test_deque() {
+    printf("\n--- Testing chunked deques ---\n");
+
+    void* pcb = test_pcb_with_heap(FINGER_TEST_HEAP_WORDS);
+    uint64_t deque = deque_new(pcb);
+    uint64_t one = term_make_int(1);
+    test_assert_equal(TERM_TYPE_DEQUE, term_type(deque), "type of deque");
+    test_assert_equal(0, deque_size(deque), "new deque is empty");
+    test_assert_equal(TERM_NONE, deque_pop_front(deque), "pop front from an empty deque");
+    test_assert_equal(TERM_NONE, deque_pop_back(deque), "pop back from an empty deque");
+    test_assert_equal(0, deque_push_back(pcb, deque, TERM_NONE), "TERM_NONE is not an element");
+    test_assert_equal(0, deque_push_back(NULL, deque, one), "push without a PCB");
+    test_assert_equal(0, deque_push_back(pcb, term_tuple(pcb, 4), one), "push onto a non-deque");
+    test_assert_equal(TERM_NONE, deque_pop_front(TERM_NIL), "pop from a non-deque");
+    test_assert_equal(0, deque_size(one), "size of a non-deque");
+    test_assert_equal(TERM_NONE, deque_new(NULL), "deque without a PCB");
+
+    // Random operations at both ends against a reference array
+    uint64_t* reference = calloc(2 * FINGER_TEST_DEQUE_OPS + 2, sizeof(uint64_t));
+    int64_t low = FINGER_TEST_DEQUE_OPS + 1;
+    int64_t high = low;
+    int agree = 1;
+    uint32_t seed = 12345;
+    for (int64_t i = 0; i < FINGER_TEST_DEQUE_OPS && agree; i++) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t op = (seed >> 16) % 100;
+        uint64_t value = term_make_int(i);
+        if (op < 30) {
+            agree &= deque_push_back(pcb, deque, value);
+            reference[high++] = value;
+        } else if (op < 55) {
+            agree &= deque_push_front(pcb, deque, value);
+            reference[--low] = value;
+        } else if (op < 77) {
+            agree &= deque_pop_front(deque) == (low < high ? reference[low++] : TERM_NONE);
+        } else {
+            agree &= deque_pop_back(deque) == (low < high ? reference[--high] : TERM_NONE);
+        }
+        agree &= deque_size(deque) == (uint64_t)(high - low);
+        if (i % 9973 == 0) {
+            for (int64_t j = low; j < high; j++) {
+                agree &= deque_index(deque, (uint64_t)(j - low)) == reference[j];
+            }
+        }
+    }
+    test_assert_true(agree, "both ends agree with a reference array");
+    test_assert_equal(TERM_NONE, deque_index(deque, (uint64_t)(high - low)), "index past the end");
+    free(reference);
+
+    // Growth: one end only, past many ring doublings
+    uint64_t grown = deque_new(pcb);
+    int ordered = 1;
+    for (int64_t i = 0; i < 100000; i++) {
+        ordered &= deque_push_front(pcb, grown, term_make_int(i));
+    }
+    for (int64_t i = 0; i < 100000; i++) {
+        ordered &= deque_index(grown, (uint64_t)i) == term_make_int(99999 - i);
+    }
+    for (int64_t i = 0; i < 100000; i++) {
+        ordered &= deque_pop_back(grown) == term_make_int(i);
+    }
+    test_assert_true(ordered, "growing ring keeps order");
+    test_assert_equal(0, deque_size(grown), "emptied after growth");
+
+    // A steady queue reuses its chunks: no allocation at all
+    uint64_t queue = deque_new(pcb);
+    for (int64_t i = 0; i < 100; i++) {
+        deque_push_back(pcb, queue, term_make_int(i));
+    }
+    for (int64_t i = 100; i < 1000; i++) {
+        deque_push_back(pcb, queue, term_make_int(i));
+        deque_pop_front(queue);
+    }
+    uint64_t start = test_pcb_heap_pointer(pcb);
+    ordered = 1;
+    for (int64_t i = 1000; i < 101000; i++) {
+        deque_push_back(pcb, queue, term_make_int(i));
+        ordered &= deque_pop_front(queue) == term_make_int(i - 100);
+    }
+    test_assert_true(ordered, "steady queue pops in push order");
+    test_assert_equal(start, test_pcb_heap_pointer(pcb), "steady queue allocates nothing");
+
+    test_assert_true(finger_test_walk(pcb), "heap walk steps over deques and chunks");
+    void* receiver = test_pcb_with_heap(FINGER_TEST_HEAP_WORDS);
+    uint64_t copy = term_copy(receiver, queue);
+    test_assert_true(term_equal(queue, copy), "copied deque is equal");
+    test_assert_equal(deque_index(queue, 50), deque_index(copy, 50), "copy holds the same elements");
+    deque_pop_front(copy);
+    test_assert_equal(100, deque_size(queue), "copy changes alone");
+    test_pcb_free(receiver);
+    test_pcb_free(pcb);
+
+    // A full heap refuses the push and leaves the deque as it was
+    void* small = test_pcb_with_heap(512);
+    uint64_t full = deque_new(small);
+    int64_t pushed = 0;
+    while (deque_push_back(small, full, term_make_int(pushed))) {
+        pushed++;
+    }
+    test_assert_equal((uint64_t)pushed, deque_size(full), "failed push keeps the count");
+    test_assert_true(pushed >= DEQUE_CHUNK_SLOTS, "small heap fills chunks first");
+    test_assert_equal(term_make_int(pushed - 1), deque_pop_back(full), "last push kept");
+    test_pcb_free(small);
+}
+
+void test_finger_main() {
+    printf("=== FINGER TREE TEST SUITE ===\n");
+
+    test_finger_basics();
+    test_finger_ends();
+    test_finger_split_concat();
+    test_finger_heap();
+    test_deque();
+
+    printf("=== FINGER TREE TEST SUITE COMPLETE ===\n");
+}
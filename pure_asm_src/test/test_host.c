@@ -0,0 +1,162 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// test_host.c — C test suite for the Hosted Runtime
+// ------------------------------------------------------------
+// Tests the hosted runtime implemented in host.s: starting one
+// scheduler thread per core through the shared per-core start path,
+// the schedulers parking in tickless idle with no work, lazy startup
+// with an initial process and per-phase timing, and an orderly stop
+// and join.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern void* host_runtime_start(uint64_t scheduler_count);
+extern void* host_runtime_start_with_process(uint64_t scheduler_count, void* initial_process);
+extern uint64_t host_runtime_startup_ticks(void* runtime, uint64_t phase);
+extern void* host_runtime_states(void* runtime);
+extern uint64_t host_runtime_scheduler_count(void* runtime);
+extern int host_runtime_stop(void* runtime);
+extern int host_runtime_join(void* runtime);
+extern int scheduler_is_sleeping(void* scheduler_states, uint64_t core_id);
+extern void* scheduler_get_current_process_with_state(void* scheduler_states, uint64_t core_id);
+extern void* allocate_pcb(void);
+extern uint64_t free_pcb(void* pcb);
+
+// External constants from assembly
+extern const uint64_t SCHEDULER_SIZE_CONST;
+
+// Startup phases (match host.s)
+#define HOST_PHASE_STATES  0
+#define HOST_PHASE_THREADS 1
+#define HOST_PHASE_ONLINE  2
+
+// Per-core timer wheel pointer in the scheduler state
+#define TIMER_WHEEL_OFFSET 256
+
+// ------------------------------------------------------------
+// Test Hosted Runtime Guards
+// ------------------------------------------------------------
+void test_host_guards() {
+    printf("--- Testing Hosted Runtime Guards ---\n");
+
+    test_assert_true(host_runtime_start(0) == NULL, "host_start_zero_schedulers");
+    test_assert_true(host_runtime_start(129) == NULL, "host_start_too_many_schedulers");
+    test_assert_true(host_runtime_states(NULL) == NULL, "host_states_null_runtime");
+    test_assert_equal(0, host_runtime_scheduler_count(NULL), "host_count_null_runtime");
+    test_assert_equal(0, host_runtime_stop(NULL), "host_stop_null_runtime");
+    test_assert_equal(0, host_runtime_join(NULL), "host_join_null_runtime");
+    test_assert_equal(0, host_runtime_startup_ticks(NULL, HOST_PHASE_STATES), "host_startup_null_runtime");
+}
+
+// ------------------------------------------------------------
+// Test Hosted Runtime Lifecycle
+// ------------------------------------------------------------
+void test_host_lifecycle() {
+    printf("--- Testing Hosted Runtime Lifecycle ---\n");
+
+    void* runtime = host_runtime_start(2);
+    test_assert_true(runtime != NULL, "host_start_two_schedulers");
+    if (runtime == NULL) {
+        return;
+    }
+
+    void* states = host_runtime_states(runtime);
+    test_assert_true(states != NULL, "host_states_allocated");
+    test_assert_equal(2, host_runtime_scheduler_count(runtime), "host_scheduler_count");
+
+    // With no work both schedulers end up parked in tickless idle
+    while (!scheduler_is_sleeping(states, 0) || !scheduler_is_sleeping(states, 1)) {
+        // wait for the schedulers to park
+    }
+
+    test_assert_equal(1, host_runtime_stop(runtime), "host_stop");
+    test_assert_equal(1, host_runtime_join(runtime), "host_join");
+}
+
+// ------------------------------------------------------------
+// Test Lazy Startup
+// ------------------------------------------------------------
+void test_host_lazy_startup() {
+    printf("--- Testing Hosted Runtime Lazy Startup ---\n");
+
+    void* pcb = allocate_pcb();
+    void* runtime = host_runtime_start_with_process(2, pcb);
+    test_assert_true(runtime != NULL, "host_start_with_process");
+    if (runtime == NULL) {
+        free_pcb(pcb);
+        return;
+    }
+    void* states = host_runtime_states(runtime);
+
+    // Scheduler 0 dispatches the initial process
+    while (scheduler_get_current_process_with_state(states, 0) != pcb) {
+        // wait for the first dispatch
+    }
+
+    while (host_runtime_startup_ticks(runtime, HOST_PHASE_ONLINE) == 0) {
+        // wait for the last scheduler to come online
+    }
+    uint64_t states_ticks = host_runtime_startup_ticks(runtime, HOST_PHASE_STATES);
+    uint64_t threads_ticks = host_runtime_startup_ticks(runtime, HOST_PHASE_THREADS);
+    uint64_t online_ticks = host_runtime_startup_ticks(runtime, HOST_PHASE_ONLINE);
+    test_assert_true(states_ticks <= threads_ticks, "host_startup_states_before_threads");
+    test_assert_true(online_ticks > states_ticks, "host_startup_online_after_states");
+    test_assert_equal(0, host_runtime_startup_ticks(runtime, 3), "host_startup_invalid_phase");
+
+    // No timer was armed, so no wheel was created
+    for (uint64_t core = 0; core < 2; core++) {
+        void* wheel = *(void**)((uint8_t*)states + core * SCHEDULER_SIZE_CONST + TIMER_WHEEL_OFFSET);
+        test_assert_true(wheel == NULL, "host_startup_no_eager_wheel");
+    }
+
+    host_runtime_stop(runtime);
+    test_assert_equal(1, host_runtime_join(runtime), "host_join_after_first_process");
+    free_pcb(pcb);
+}
+
+// ------------------------------------------------------------
+// Main Hosted Runtime Test Function
+// ------------------------------------------------------------
+void test_host_main() {
+    printf("=== HOSTED RUNTIME TEST SUITE ===\n");
+
+    test_host_guards();
+    test_host_lifecycle();
+    test_host_lazy_startup();
+
+    printf("=== HOSTED RUNTIME TEST SUITE COMPLETE ===\n");
+}
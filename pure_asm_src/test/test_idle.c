@@ -0,0 +1,201 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// test_idle.c — C test suite for Tickless Idle
+// ------------------------------------------------------------
+// Tests the idle sleep and remote wakeup implemented in idle.s:
+// sleeping exactly until the next timer deadline, refusing to sleep
+// when work is pending, and being woken from another thread.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern int scheduler_idle_sleep(void* scheduler_states, uint64_t core_id);
+extern int scheduler_wake(void* scheduler_states, uint64_t core_id);
+extern int scheduler_is_sleeping(void* scheduler_states, uint64_t core_id);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern int scheduler_state_destroy(void* scheduler_states);
+extern uint64_t get_system_ticks(void);
+extern int timer_wheel_init(void* scheduler_states, uint64_t core_id);
+extern int timer_wheel_destroy(void* scheduler_states, uint64_t core_id);
+extern uint64_t timer_arm(void* scheduler_states, uint64_t core_id, void* pcb,
+                          uint64_t expiry_ticks, void* callback, uint64_t argument);
+extern int cancel_timer(uint64_t timer_id);
+extern uint64_t timer_wheel_next_deadline(void* scheduler_states, uint64_t core_id);
+extern void scheduler_init(void* scheduler_states, uint64_t core_id);
+extern int scheduler_inject_process(void* scheduler_states, uint64_t core_id, void* process, uint64_t priority);
+extern void* scheduler_run_pass(void* scheduler_states, uint64_t core_id);
+
+// External constants from assembly
+extern const uint64_t SCHEDULER_SIZE_CONST;
+
+// Wheel slot granularity (matches TIMER_WHEEL_SHIFT)
+#define WHEEL_TICK (1ULL << 14)
+
+// Priority queue count field (scheduler_queues + queue_count)
+#define QUEUE_COUNT_OFFSET (8 + 16)
+
+// PCB size and home core field (match pcb.inc)
+#define PCB_SIZE 512
+#define PCB_SCHEDULER_ID_OFFSET 24
+
+// ------------------------------------------------------------
+// Test Idle Sleep Guards
+// ------------------------------------------------------------
+void test_idle_guards() {
+    printf("--- Testing Idle Sleep Guards ---\n");
+
+    test_assert_equal(0, scheduler_idle_sleep(NULL, 0), "idle_sleep_null_states");
+    test_assert_equal(0, scheduler_wake(NULL, 0), "idle_wake_null_states");
+
+    void* states = scheduler_state_init(2);
+    test_assert_equal(0, scheduler_idle_sleep(states, 128), "idle_sleep_invalid_core");
+    test_assert_equal(0, scheduler_is_sleeping(states, 0), "idle_not_sleeping_initially");
+    test_assert_equal(0, scheduler_wake(states, 0), "idle_wake_awake_scheduler");
+
+    // Runnable work: never sleep
+    uint32_t* count = (uint32_t*)((uint8_t*)states + SCHEDULER_SIZE_CONST + QUEUE_COUNT_OFFSET);
+    *count = 1;
+    test_assert_equal(0, scheduler_idle_sleep(states, 1), "idle_no_sleep_with_work");
+    test_assert_equal(0, scheduler_is_sleeping(states, 1), "idle_word_cleared_after_abort");
+    *count = 0;
+
+    // A timer already due: never sleep
+    timer_wheel_init(states, 0);
+    uint64_t timer = timer_arm(states, 0, NULL, get_system_ticks(), NULL, 0);
+    test_assert_equal(0, scheduler_idle_sleep(states, 0), "idle_no_sleep_past_deadline");
+    cancel_timer(timer);
+
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Idle Sleep Until Deadline
+// ------------------------------------------------------------
+void test_idle_deadline() {
+    printf("--- Testing Idle Sleep Until Deadline ---\n");
+
+    void* states = scheduler_state_init(1);
+    timer_wheel_init(states, 0);
+
+    uint64_t expiry = get_system_ticks() + 2 * WHEEL_TICK;
+    timer_arm(states, 0, NULL, expiry, NULL, 0);
+    uint64_t deadline = timer_wheel_next_deadline(states, 0);
+    test_assert_equal(expiry, deadline, "idle_deadline_from_wheel");
+
+    test_assert_equal(1, scheduler_idle_sleep(states, 0), "idle_slept");
+    test_assert_true(get_system_ticks() >= deadline, "idle_woke_not_before_deadline");
+    test_assert_equal(0, scheduler_is_sleeping(states, 0), "idle_awake_after_deadline");
+
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Remote Wakeup
+// ------------------------------------------------------------
+static void* idle_sleeper(void* states) {
+    // No wheel and no work: sleeps until woken
+    scheduler_idle_sleep(states, 1);
+    return NULL;
+}
+
+void test_idle_remote_wake() {
+    printf("--- Testing Idle Remote Wakeup ---\n");
+
+    void* states = scheduler_state_init(2);
+    pthread_t thread;
+    test_assert_equal(0, pthread_create(&thread, NULL, idle_sleeper, states), "idle_sleeper_started");
+
+    while (!scheduler_is_sleeping(states, 1)) {
+        // wait for the sleeper to park
+    }
+    test_assert_equal(1, scheduler_wake(states, 1), "idle_remote_wake");
+    pthread_join(thread, NULL);
+    test_assert_equal(0, scheduler_is_sleeping(states, 1), "idle_remote_woken");
+
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Cross-Thread Inject
+// ------------------------------------------------------------
+void test_idle_inject() {
+    printf("--- Testing Cross-Thread Inject ---\n");
+
+    void* states = scheduler_state_init(2);
+    scheduler_init(states, 1);
+    uint8_t* pcb = calloc(1, PCB_SIZE);
+
+    test_assert_equal(0, scheduler_inject_process(NULL, 1, pcb, 2), "inject_null_states");
+    test_assert_equal(0, scheduler_inject_process(states, 128, pcb, 2), "inject_invalid_core");
+    test_assert_equal(0, scheduler_inject_process(states, 1, NULL, 2), "inject_null_process");
+    test_assert_equal(0, scheduler_inject_process(states, 1, pcb, 4), "inject_invalid_priority");
+
+    // Injecting from this thread wakes the sleeping scheduler
+    pthread_t thread;
+    test_assert_equal(0, pthread_create(&thread, NULL, idle_sleeper, states), "inject_sleeper_started");
+    while (!scheduler_is_sleeping(states, 1)) {
+        // wait for the sleeper to park
+    }
+    test_assert_equal(1, scheduler_inject_process(states, 1, pcb, 0), "inject_process");
+    pthread_join(thread, NULL);
+    test_assert_equal(0, scheduler_is_sleeping(states, 1), "inject_woke_scheduler");
+    test_assert_equal(1, *(uint64_t*)(pcb + PCB_SCHEDULER_ID_OFFSET), "inject_rehomes");
+
+    // Waiting in the inbox counts as work; the next pass runs it
+    uint32_t* count = (uint32_t*)((uint8_t*)states + SCHEDULER_SIZE_CONST + QUEUE_COUNT_OFFSET);
+    test_assert_equal(0, *count, "inject_not_queued_before_pass");
+    test_assert_equal(0, scheduler_idle_sleep(states, 1), "inject_no_sleep_with_inbox");
+    test_assert_equal((uint64_t)pcb, (uint64_t)scheduler_run_pass(states, 1), "inject_drained_and_dispatched");
+
+    free(pcb);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Main Idle Test Function
+// ------------------------------------------------------------
+void test_idle_main() {
+    printf("=== TICKLESS IDLE TEST SUITE ===\n");
+
+    test_idle_guards();
+    test_idle_deadline();
+    test_idle_remote_wake();
+    test_idle_inject();
+
+    printf("=== TICKLESS IDLE TEST SUITE COMPLETE ===\n");
+}
@@ -121,15 +121,16 @@ typedef struct {
     uint64_t last_scheduled; // Offset 376: Last scheduled timestamp (8 bytes)
     uint64_t affinity_mask; // Offset 384: CPU affinity mask (8 bytes)
     uint64_t migration_count; // Offset 392: Migration count (8 bytes)
-    uint64_t stack_pointer; // Offset 400: Current stack pointer (8 bytes)
-    uint64_t stack_limit; // Offset 408: Stack limit (8 bytes)
-    uint64_t heap_pointer; // Offset 416: Current heap pointer (8 bytes)
-    uint64_t heap_limit; // Offset 424: Heap limit (8 bytes)
-    uint64_t blocking_reason; // Offset 432: Blocking reason (8 bytes)
-    uint64_t blocking_data; // Offset 440: Blocking data (8 bytes)
-    uint64_t wake_time; // Offset 448: Timer wake time (8 bytes)
-    uint64_t message_pattern; // Offset 456: Receive pattern (8 bytes)
-    // Total size: 464 bytes
+    uint64_t last_migration_time; // Offset 400: Last migration timestamp (8 bytes)
+    uint64_t stack_pointer; // Offset 408: Current stack pointer (8 bytes)
+    uint64_t stack_limit; // Offset 416: Stack limit (8 bytes)
+    uint64_t heap_pointer; // Offset 424: Current heap pointer (8 bytes)
+    uint64_t heap_limit; // Offset 432: Heap limit (8 bytes)
+    uint64_t blocking_reason; // Offset 440: Blocking reason (8 bytes)
+    uint64_t blocking_data; // Offset 448: Blocking data (8 bytes)
+    uint64_t wake_time; // Offset 456: Timer wake time (8 bytes)
+    uint64_t message_pattern; // Offset 464: Receive pattern (8 bytes)
+    // Total size: 472 bytes
 } test_process_t;
 
 // Helper function to create a test process
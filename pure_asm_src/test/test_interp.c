@@ -0,0 +1,513 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// test_interp.c — C test suite for the Behavior Template Interpreter
+// ------------------------------------------------------------
+// Tests interp.s: bytecode validation, arithmetic, the Map, Filter,
+// Reduce, For Each, State Update and Message templates, Filter against
+// a set with MEMBER, reduction charging with yield and resume, a full
+// heap, and runtime errors.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern void* interp_load(const uint32_t* code, uint64_t count, const uint64_t* literals, uint64_t literal_count);
+extern int interp_program_destroy(void* program);
+extern int interp_frame_init(void* frame, void* program, void* pcb);
+extern int interp_set_register(void* frame, uint64_t index, uint64_t term);
+extern uint64_t interp_get_register(void* frame, uint64_t index);
+extern int interp_set_send(void* frame, int (*send)(void*, uint64_t, uint64_t), void* argument);
+extern uint64_t interp_run(void* scheduler_states, uint64_t core_id, void* frame);
+extern uint64_t interp_result(void* frame);
+extern uint64_t interp_pc(void* frame);
+extern uint64_t term_make_int(int64_t value);
+extern int64_t term_int_value(uint64_t term);
+extern uint64_t term_make_atom(uint64_t index);
+extern uint64_t term_make_pid(uint64_t pid);
+extern uint64_t term_tuple(void* pcb, uint64_t arity);
+extern uint64_t term_element(uint64_t tuple, uint64_t index);
+extern int term_set_element(uint64_t tuple, uint64_t index, uint64_t value);
+extern uint64_t term_cons(void* pcb, uint64_t head, uint64_t tail);
+extern uint64_t term_head(uint64_t list);
+extern uint64_t term_tail(uint64_t list);
+extern void* set_create(uint64_t max_keys);
+extern int set_destroy(void* set);
+extern int set_insert(void* set, uint64_t key);
+extern int set_freeze(void* set);
+extern uint64_t set_term(void* pcb, void* set);
+
+// Bytecode and term constants (match config.inc)
+enum {
+    OP_HALT, OP_MOVE, OP_LOADK, OP_LOADI, OP_ADD, OP_SUB, OP_MUL, OP_ADDI,
+    OP_JMP, OP_JEQ, OP_JNE, OP_JLT, OP_JGE, OP_NEXT, OP_CONS, OP_REVERSE,
+    OP_TUPLE, OP_GETEL, OP_SETEL, OP_UPDATE, OP_CALL, OP_RET, OP_SEND, OP_MEMBER, OP_COUNT
+};
+#define INTERP_DONE 0
+#define INTERP_YIELD 1
+#define INTERP_HEAP_FULL 2
+#define INTERP_BADARG 3
+#define INTERP_MAX_DEPTH 32
+#define INTERP_FRAME_SIZE 448
+#define TERM_NIL 0x14
+#define TERM_NONE 0x34
+#define DEFAULT_REDUCTIONS 2000
+
+// Instruction words: registers A, B, C or registers A, B and a signed K
+#define ABC(op, a, b, c) ((uint32_t)(op) | (uint32_t)(a) << 8 | (uint32_t)(b) << 12 | (uint32_t)(c) << 16)
+#define ABK(op, a, b, k) ((uint32_t)(op) | (uint32_t)(a) << 8 | (uint32_t)(b) << 12 | (uint32_t)(uint16_t)(k) << 16)
+
+#define INTERP_TEST_HEAP_WORDS 4096
+#define INTERP_TEST_SENDS 8
+
+typedef struct {
+    uint64_t frame[INTERP_FRAME_SIZE / 8];
+    void* states;
+    void* pcb;
+} interp_test_context;
+
+typedef struct {
+    uint64_t count;
+    uint64_t pids[INTERP_TEST_SENDS];
+    uint64_t messages[INTERP_TEST_SENDS];
+} interp_test_mailbox;
+
+static void interp_test_setup(interp_test_context* ctx) {
+    ctx->states = scheduler_state_init(1);
+    scheduler_init(ctx->states, 0);
+    scheduler_set_reduction_count_with_state(ctx->states, 0, DEFAULT_REDUCTIONS);
+    ctx->pcb = test_pcb_with_heap(INTERP_TEST_HEAP_WORDS);
+}
+
+static void interp_test_teardown(interp_test_context* ctx) {
+    test_pcb_free(ctx->pcb);
+    scheduler_state_destroy(ctx->states);
+}
+
+// [first, first + 1, ..., first + count - 1]
+static uint64_t interp_test_list(void* pcb, int64_t first, int64_t count) {
+    uint64_t list = TERM_NIL;
+    for (int64_t i = count - 1; i >= 0; i--) {
+        list = term_cons(pcb, term_make_int(first + i), list);
+    }
+    return list;
+}
+
+// Compare a list of integers against an array
+static int interp_test_list_equals(uint64_t list, const int64_t* values, int count) {
+    for (int i = 0; i < count; i++) {
+        if (list == TERM_NIL || term_int_value(term_head(list)) != values[i]) {
+            return 0;
+        }
+        list = term_tail(list);
+    }
+    return list == TERM_NIL;
+}
+
+static int interp_test_send(void* argument, uint64_t pid, uint64_t message) {
+    interp_test_mailbox* mailbox = argument;
+    if (mailbox->count == INTERP_TEST_SENDS) {
+        return 0;
+    }
+    mailbox->pids[mailbox->count] = pid;
+    mailbox->messages[mailbox->count] = message;
+    mailbox->count++;
+    return 1;
+}
+
+static void test_interp_load() {
+    printf("\n--- Testing bytecode validation ---\n");
+
+    uint32_t halt[] = { ABC(OP_HALT, 0, 0, 0) };
+    uint32_t bad_op[] = { ABC(OP_COUNT, 0, 0, 0) };
+    uint32_t jump_past[] = { ABK(OP_JMP, 0, 0, 1), ABC(OP_HALT, 0, 0, 0) };
+    uint32_t jump_before[] = { ABC(OP_HALT, 0, 0, 0), ABK(OP_JLT, 1, 2, -3) };
+    uint32_t bad_literal[] = { ABK(OP_LOADK, 0, 0, 1), ABC(OP_HALT, 0, 0, 0) };
+    uint64_t literal = term_make_int(1);
+
+    test_assert_true(interp_load(NULL, 1, NULL, 0) == NULL, "load without code");
+    test_assert_true(interp_load(halt, 0, NULL, 0) == NULL, "load zero instructions");
+    test_assert_true(interp_load(halt, 1, NULL, 1) == NULL, "literals missing");
+    test_assert_true(interp_load(bad_op, 1, NULL, 0) == NULL, "unknown opcode");
+    test_assert_true(interp_load(jump_past, 2, NULL, 0) == NULL, "jump past the end");
+    test_assert_true(interp_load(jump_before, 2, NULL, 0) == NULL, "jump before the start");
+    test_assert_true(interp_load(bad_literal, 2, &literal, 1) == NULL, "literal out of range");
+
+    void* program = interp_load(halt, 1, NULL, 0);
+    test_assert_true(program != NULL, "load a minimal program");
+    test_assert_true(interp_program_destroy(program), "destroy");
+    test_assert_true(!interp_program_destroy(NULL), "destroy NULL");
+}
+
+static void test_interp_arithmetic() {
+    printf("\n--- Testing arithmetic and literals ---\n");
+
+    interp_test_context ctx;
+    interp_test_setup(&ctx);
+
+    // r2 = (r0 + 7) * -3 - literal 0
+    uint32_t code[] = {
+        ABK(OP_ADDI, 1, 0, 7),
+        ABK(OP_LOADI, 3, 0, -3),
+        ABC(OP_MUL, 1, 1, 3),
+        ABK(OP_LOADK, 4, 0, 0),
+        ABC(OP_SUB, 2, 1, 4),
+        ABC(OP_HALT, 2, 0, 0),
+    };
+    uint64_t literal = term_make_int(1000);
+    void* program = interp_load(code, 6, &literal, 1);
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    test_assert_equal(TERM_NONE, interp_result(ctx.frame), "no result before HALT");
+    interp_set_register(ctx.frame, 0, term_make_int(5));
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.frame), "arithmetic runs to HALT");
+    test_assert_equal(term_make_int(-1036), interp_result(ctx.frame), "arithmetic result");
+    test_assert_equal(5, interp_pc(ctx.frame), "pc stays on HALT");
+    test_assert_equal(DEFAULT_REDUCTIONS - 6, scheduler_get_reduction_count_with_state(ctx.states, 0),
+                      "one reduction per instruction");
+    test_assert_equal(term_make_int(-36), interp_get_register(ctx.frame, 1), "intermediate register");
+    test_assert_equal(TERM_NONE, interp_get_register(ctx.frame, 16), "register out of range");
+    test_assert_true(!interp_set_register(ctx.frame, 16, TERM_NIL), "set register out of range");
+
+    // A non-integer operand stops on the failing instruction
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    interp_set_register(ctx.frame, 0, term_make_atom(3));
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.frame), "badarg on an atom");
+    test_assert_equal(0, interp_pc(ctx.frame), "pc on the failing instruction");
+
+    // Overflow of a small integer is an error, not a wrap
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    interp_set_register(ctx.frame, 0, term_make_int((int64_t)1 << 59));
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.frame), "multiply overflow");
+    test_assert_equal(2, interp_pc(ctx.frame), "overflow stops on MUL");
+
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, NULL), "run without a frame");
+    test_assert_true(!interp_frame_init(ctx.frame, NULL, ctx.pcb), "frame without a program");
+
+    interp_program_destroy(program);
+    interp_test_teardown(&ctx);
+}
+
+static void test_interp_templates() {
+    printf("\n--- Testing Map, Filter and Reduce ---\n");
+
+    interp_test_context ctx;
+    interp_test_setup(&ctx);
+    uint64_t input = interp_test_list(ctx.pcb, 1, 5);
+
+    // Map: r1 = [X * 2 || X <- r0], the body a CALLed function
+    uint32_t map[] = {
+        ABK(OP_LOADI, 3, 0, 2),
+        ABK(OP_NEXT, 0, 2, 3),            // -> 5
+        ABK(OP_CALL, 0, 0, 4),            // -> 7
+        ABC(OP_CONS, 1, 2, 1),
+        ABK(OP_JMP, 0, 0, -4),            // -> 1
+        ABC(OP_REVERSE, 1, 1, 0),
+        ABC(OP_HALT, 1, 0, 0),
+        ABC(OP_MUL, 2, 2, 3),
+        ABC(OP_RET, 0, 0, 0),
+    };
+    void* program = interp_load(map, 9, NULL, 0);
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    interp_set_register(ctx.frame, 0, input);
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.frame), "map runs");
+    int64_t doubled[] = { 2, 4, 6, 8, 10 };
+    test_assert_true(interp_test_list_equals(interp_result(ctx.frame), doubled, 5), "map result in order");
+    interp_program_destroy(program);
+
+    // Filter: r1 = [X || X <- r0, X > 2]
+    uint32_t filter[] = {
+        ABK(OP_LOADI, 3, 0, 2),
+        ABK(OP_NEXT, 0, 2, 3),            // -> 5
+        ABK(OP_JGE, 3, 2, -2),            // -> 1
+        ABC(OP_CONS, 1, 2, 1),
+        ABK(OP_JMP, 0, 0, -4),            // -> 1
+        ABC(OP_REVERSE, 1, 1, 0),
+        ABC(OP_HALT, 1, 0, 0),
+    };
+    program = interp_load(filter, 7, NULL, 0);
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    interp_set_register(ctx.frame, 0, input);
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.frame), "filter runs");
+    int64_t kept[] = { 3, 4, 5 };
+    test_assert_true(interp_test_list_equals(interp_result(ctx.frame), kept, 3), "filter result");
+    interp_program_destroy(program);
+
+    // Reduce: r1 = sum of r0, over several budgets
+    uint32_t reduce[] = {
+        ABK(OP_LOADI, 1, 0, 0),
+        ABK(OP_NEXT, 0, 2, 2),            // -> 4
+        ABC(OP_ADD, 1, 1, 2),
+        ABK(OP_JMP, 0, 0, -3),            // -> 1
+        ABC(OP_HALT, 1, 0, 0),
+    };
+    program = interp_load(reduce, 5, NULL, 0);
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    interp_set_register(ctx.frame, 0, interp_test_list(ctx.pcb, 1, 100));
+    uint64_t yields = 0;
+    uint64_t status;
+    for (;;) {
+        scheduler_set_reduction_count_with_state(ctx.states, 0, 50);
+        status = interp_run(ctx.states, 0, ctx.frame);
+        if (status != INTERP_YIELD) {
+            break;
+        }
+        test_assert_equal(0, scheduler_get_reduction_count_with_state(ctx.states, 0), "yield spends the budget");
+        yields++;
+    }
+    // LOADI, 100 x (NEXT, ADD, JMP), the last NEXT and HALT: 303
+    test_assert_equal(INTERP_DONE, status, "reduce finishes across yields");
+    test_assert_equal(6, yields, "yields every 50 instructions");
+    test_assert_equal(47, scheduler_get_reduction_count_with_state(ctx.states, 0), "budget left after HALT");
+    test_assert_equal(term_make_int(5050), interp_result(ctx.frame), "reduce result");
+
+    // No budget: nothing runs
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    scheduler_set_reduction_count_with_state(ctx.states, 0, 0);
+    test_assert_equal(INTERP_YIELD, interp_run(ctx.states, 0, ctx.frame), "empty budget yields at once");
+    test_assert_equal(0, interp_pc(ctx.frame), "no instruction ran");
+    interp_program_destroy(program);
+
+    interp_test_teardown(&ctx);
+}
+
+static void test_interp_state_and_messages() {
+    printf("\n--- Testing State Update, For Each and Message ---\n");
+
+    interp_test_context ctx;
+    interp_test_setup(&ctx);
+
+    // For each message in r0: state {Count, Last} = {Count + 1, Last},
+    // then send the message to the literal pid
+    uint32_t code[] = {
+        ABK(OP_LOADK, 3, 0, 0),
+        ABK(OP_NEXT, 0, 2, 5),            // -> 7
+        ABK(OP_GETEL, 4, 1, 0),
+        ABK(OP_ADDI, 4, 4, 1),
+        ABK(OP_UPDATE, 1, 4, 0),
+        ABC(OP_SEND, 3, 2, 0),
+        ABK(OP_JMP, 0, 0, -6),            // -> 1
+        ABC(OP_HALT, 1, 0, 0),
+    };
+    uint64_t pid = term_make_pid(42);
+    void* program = interp_load(code, 8, &pid, 1);
+
+    uint64_t state = term_tuple(ctx.pcb, 2);
+    term_set_element(state, 0, term_make_int(0));
+    term_set_element(state, 1, term_make_atom(7));
+    interp_test_mailbox mailbox = { 0 };
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    interp_set_register(ctx.frame, 0, interp_test_list(ctx.pcb, 10, 3));
+    interp_set_register(ctx.frame, 1, state);
+    interp_set_send(ctx.frame, interp_test_send, &mailbox);
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.frame), "for each runs");
+
+    uint64_t final = interp_result(ctx.frame);
+    test_assert_equal(term_make_int(3), term_element(final, 0), "state updated per message");
+    test_assert_equal(term_make_atom(7), term_element(final, 1), "other elements kept");
+    test_assert_equal(term_make_int(0), term_element(state, 0), "original state untouched");
+    test_assert_equal(3, mailbox.count, "one send per element");
+    test_assert_equal(pid, mailbox.pids[2], "sent to the literal pid");
+    test_assert_equal(term_make_int(11), mailbox.messages[1], "messages in order");
+
+    // Without a send function SEND fails where it stands
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    interp_set_register(ctx.frame, 0, interp_test_list(ctx.pcb, 10, 3));
+    interp_set_register(ctx.frame, 1, state);
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.frame), "send without a function");
+    test_assert_equal(5, interp_pc(ctx.frame), "stopped on SEND");
+
+    // GETEL out of range
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    interp_set_register(ctx.frame, 0, interp_test_list(ctx.pcb, 10, 1));
+    interp_set_register(ctx.frame, 1, term_tuple(ctx.pcb, 0));
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.frame), "element of an empty tuple");
+    test_assert_equal(2, interp_pc(ctx.frame), "stopped on GETEL");
+
+    // TUPLE and SETEL build a fresh tuple in place
+    uint32_t build[] = {
+        ABK(OP_TUPLE, 1, 0, 2),
+        ABK(OP_SETEL, 1, 0, 1),
+        ABC(OP_HALT, 1, 0, 0),
+    };
+    void* builder = interp_load(build, 3, NULL, 0);
+    interp_frame_init(ctx.frame, builder, ctx.pcb);
+    interp_set_register(ctx.frame, 0, term_make_int(9));
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.frame), "build a tuple");
+    test_assert_equal(term_make_int(9), term_element(interp_result(ctx.frame), 1), "element set");
+    test_assert_equal(TERM_NIL, term_element(interp_result(ctx.frame), 0), "other element NIL");
+
+    interp_program_destroy(builder);
+    interp_program_destroy(program);
+    interp_test_teardown(&ctx);
+}
+
+static void test_interp_heap_and_control() {
+    printf("\n--- Testing a full heap and control errors ---\n");
+
+    interp_test_context ctx;
+    interp_test_setup(&ctx);
+
+    // Two cons cells fit in a five-word heap, the third does not
+    void* small = test_pcb_with_heap(5);
+    uint32_t cons[] = {
+        ABC(OP_CONS, 1, 0, 1),
+        ABC(OP_CONS, 1, 0, 1),
+        ABC(OP_CONS, 1, 0, 1),
+        ABC(OP_HALT, 1, 0, 0),
+    };
+    void* program = interp_load(cons, 4, NULL, 0);
+    interp_frame_init(ctx.frame, program, small);
+    interp_set_register(ctx.frame, 0, term_make_int(1));
+    test_assert_equal(INTERP_HEAP_FULL, interp_run(ctx.states, 0, ctx.frame), "heap full");
+    test_assert_equal(2, interp_pc(ctx.frame), "pc on the allocating instruction");
+
+    // Make room and resume
+    uint64_t* heap = calloc(16, sizeof(uint64_t));
+    *(uint64_t*)((uint8_t*)small + PCB_HEAP_POINTER_OFFSET) = (uint64_t)heap;
+    *(uint64_t*)((uint8_t*)small + PCB_HEAP_LIMIT_OFFSET) = (uint64_t)(heap + 16);
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.frame), "resume after heap full");
+    int64_t ones[] = { 1, 1, 1 };
+    test_assert_true(interp_test_list_equals(interp_result(ctx.frame), ones, 3), "every cons done once");
+    free(heap);
+    test_pcb_free(small);
+    interp_program_destroy(program);
+
+    // RET without a CALL
+    uint32_t ret[] = { ABC(OP_RET, 0, 0, 0) };
+    program = interp_load(ret, 1, NULL, 0);
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.frame), "return without a call");
+    interp_program_destroy(program);
+
+    // Unbounded recursion stops at the depth limit
+    uint32_t recurse[] = { ABK(OP_CALL, 0, 0, -1) };
+    program = interp_load(recurse, 1, NULL, 0);
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    scheduler_set_reduction_count_with_state(ctx.states, 0, DEFAULT_REDUCTIONS);
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.frame), "call depth limit");
+    test_assert_equal(DEFAULT_REDUCTIONS - INTERP_MAX_DEPTH - 1, scheduler_get_reduction_count_with_state(ctx.states, 0),
+                      "failed call charged");
+    interp_program_destroy(program);
+
+    // Falling off the end
+    uint32_t fall[] = { ABC(OP_MOVE, 1, 0, 0) };
+    program = interp_load(fall, 1, NULL, 0);
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.frame), "ran off the end");
+    test_assert_equal(1, interp_pc(ctx.frame), "pc past the last instruction");
+    interp_program_destroy(program);
+
+    // NEXT on an improper list
+    uint32_t walk[] = { ABK(OP_NEXT, 0, 1, -1), ABC(OP_HALT, 0, 0, 0) };
+    program = interp_load(walk, 2, NULL, 0);
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    interp_set_register(ctx.frame, 0, term_cons(ctx.pcb, term_make_int(1), term_make_int(2)));
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.frame), "improper list");
+    interp_program_destroy(program);
+
+    interp_test_teardown(&ctx);
+}
+
+static void test_interp_membership() {
+    printf("\n--- Testing Filter against a set ---\n");
+
+    interp_test_context ctx;
+    interp_test_setup(&ctx);
+    void* primes = set_create(8);
+    set_insert(primes, term_make_int(2));
+    set_insert(primes, term_make_int(3));
+    set_insert(primes, term_make_int(5));
+    set_insert(primes, term_make_int(7));
+    set_freeze(primes);
+    uint64_t handle = set_term(ctx.pcb, primes);
+
+    // r1 = [X || X <- r0, X in Set]
+    uint32_t filter[] = {
+        ABK(OP_LOADK, 5, 0, 0),
+        ABK(OP_LOADI, 6, 0, 0),
+        ABK(OP_NEXT, 0, 2, 4),            // -> 7
+        ABC(OP_MEMBER, 3, 2, 5),
+        ABK(OP_JEQ, 3, 6, -3),            // -> 2
+        ABC(OP_CONS, 1, 2, 1),
+        ABK(OP_JMP, 0, 0, -5),            // -> 2
+        ABC(OP_REVERSE, 1, 1, 0),
+        ABC(OP_HALT, 1, 0, 0),
+    };
+    void* program = interp_load(filter, 9, &handle, 1);
+    test_assert_true(program != NULL, "MEMBER loads");
+    interp_frame_init(ctx.frame, program, ctx.pcb);
+    interp_set_register(ctx.frame, 0, interp_test_list(ctx.pcb, 1, 10));
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.frame), "set filter runs");
+    int64_t kept[] = { 2, 3, 5, 7 };
+    test_assert_true(interp_test_list_equals(interp_result(ctx.frame), kept, 4), "set filter result");
+    test_assert_equal(term_make_int(0), interp_get_register(ctx.frame, 3), "MEMBER miss is 0");
+
+    // Anything but a set handle in C is a bad argument
+    uint32_t not_set[] = { ABC(OP_MEMBER, 3, 2, 5), ABC(OP_HALT, 3, 0, 0) };
+    void* bad = interp_load(not_set, 2, NULL, 0);
+    interp_frame_init(ctx.frame, bad, ctx.pcb);
+    interp_set_register(ctx.frame, 5, term_tuple(ctx.pcb, 1));
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.frame), "MEMBER on a tuple");
+    interp_frame_init(ctx.frame, bad, ctx.pcb);
+    interp_set_register(ctx.frame, 5, term_make_int(2));
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.frame), "MEMBER on an integer");
+    test_assert_equal(0, interp_pc(ctx.frame), "stopped on MEMBER");
+
+    // A hit is 1
+    interp_frame_init(ctx.frame, bad, ctx.pcb);
+    interp_set_register(ctx.frame, 2, term_make_int(7));
+    interp_set_register(ctx.frame, 5, handle);
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.frame), "MEMBER hit runs");
+    test_assert_equal(term_make_int(1), interp_result(ctx.frame), "MEMBER hit is 1");
+
+    interp_program_destroy(bad);
+    interp_program_destroy(program);
+    set_destroy(primes);
+    interp_test_teardown(&ctx);
+}
+
+void test_interp_main() {
+    printf("=== TEMPLATE INTERPRETER TEST SUITE ===\n");
+
+    test_interp_load();
+    test_interp_arithmetic();
+    test_interp_templates();
+    test_interp_state_and_messages();
+    test_interp_membership();
+    test_interp_heap_and_control();
+
+    printf("=== TEMPLATE INTERPRETER TEST SUITE COMPLETE ===\n");
+}
@@ -0,0 +1,613 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// test_jit.c — C test suite for Native Template Code
+// ------------------------------------------------------------
+// Tests jit.s: range validation, native code matching the interpreter
+// on results, pcs and reductions (including across yields), mixing
+// interpreted and native functions in one run, compiling a frame's
+// program between runs, set membership through the interpreter's
+// handler, a full heap and runtime errors.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern int jit_compile(void* program, uint64_t first, uint64_t count);
+extern int jit_is_native(void* program, uint64_t index);
+extern void* interp_load(const uint32_t* code, uint64_t count, const uint64_t* literals, uint64_t literal_count);
+extern int interp_program_destroy(void* program);
+extern int interp_frame_init(void* frame, void* program, void* pcb);
+extern int interp_set_register(void* frame, uint64_t index, uint64_t term);
+extern uint64_t interp_get_register(void* frame, uint64_t index);
+extern int interp_set_send(void* frame, int (*send)(void*, uint64_t, uint64_t), void* argument);
+extern uint64_t interp_run(void* scheduler_states, uint64_t core_id, void* frame);
+extern uint64_t interp_result(void* frame);
+extern uint64_t interp_pc(void* frame);
+extern uint64_t term_make_int(int64_t value);
+extern int64_t term_int_value(uint64_t term);
+extern uint64_t term_make_atom(uint64_t index);
+extern uint64_t term_make_pid(uint64_t pid);
+extern uint64_t term_tuple(void* pcb, uint64_t arity);
+extern uint64_t term_element(uint64_t tuple, uint64_t index);
+extern int term_set_element(uint64_t tuple, uint64_t index, uint64_t value);
+extern uint64_t term_cons(void* pcb, uint64_t head, uint64_t tail);
+extern uint64_t term_head(uint64_t list);
+extern uint64_t term_tail(uint64_t list);
+extern void* set_create(uint64_t max_keys);
+extern int set_destroy(void* set);
+extern int set_insert(void* set, uint64_t key);
+extern int set_freeze(void* set);
+extern uint64_t set_term(void* pcb, void* set);
+
+// Bytecode and term constants (match config.inc)
+enum {
+    OP_HALT, OP_MOVE, OP_LOADK, OP_LOADI, OP_ADD, OP_SUB, OP_MUL, OP_ADDI,
+    OP_JMP, OP_JEQ, OP_JNE, OP_JLT, OP_JGE, OP_NEXT, OP_CONS, OP_REVERSE,
+    OP_TUPLE, OP_GETEL, OP_SETEL, OP_UPDATE, OP_CALL, OP_RET, OP_SEND, OP_MEMBER, OP_COUNT
+};
+#define INTERP_DONE 0
+#define INTERP_YIELD 1
+#define INTERP_HEAP_FULL 2
+#define INTERP_BADARG 3
+#define INTERP_MAX_DEPTH 32
+#define INTERP_FRAME_SIZE 448
+#define JIT_MAX_INSTRUCTIONS 4096
+#define TERM_NIL 0x14
+#define TERM_NONE 0x34
+#define DEFAULT_REDUCTIONS 2000
+
+// Instruction words: registers A, B, C or registers A, B and a signed K
+#define ABC(op, a, b, c) ((uint32_t)(op) | (uint32_t)(a) << 8 | (uint32_t)(b) << 12 | (uint32_t)(c) << 16)
+#define ABK(op, a, b, k) ((uint32_t)(op) | (uint32_t)(a) << 8 | (uint32_t)(b) << 12 | (uint32_t)(uint16_t)(k) << 16)
+
+#define JIT_TEST_HEAP_WORDS 8192
+#define JIT_TEST_SENDS 8
+
+typedef struct {
+    uint64_t interpreted[INTERP_FRAME_SIZE / 8];
+    uint64_t native[INTERP_FRAME_SIZE / 8];
+    void* states;
+    void* pcb;
+} jit_test_context;
+
+typedef struct {
+    uint64_t count;
+    uint64_t pids[JIT_TEST_SENDS];
+    uint64_t messages[JIT_TEST_SENDS];
+} jit_test_mailbox;
+
+// Map: r1 = [X * 2 || X <- r0], the body a CALLed function at 7
+static const uint32_t jit_test_map[] = {
+    ABK(OP_LOADI, 3, 0, 2),
+    ABK(OP_NEXT, 0, 2, 3),                // -> 5
+    ABK(OP_CALL, 0, 0, 4),                // -> 7
+    ABC(OP_CONS, 1, 2, 1),
+    ABK(OP_JMP, 0, 0, -4),                // -> 1
+    ABC(OP_REVERSE, 1, 1, 0),
+    ABC(OP_HALT, 1, 0, 0),
+    ABC(OP_MUL, 2, 2, 3),
+    ABC(OP_RET, 0, 0, 0),
+};
+
+// Filter: r1 = [X || X <- r0, X > 2]
+static const uint32_t jit_test_filter[] = {
+    ABK(OP_LOADI, 3, 0, 2),
+    ABK(OP_NEXT, 0, 2, 3),                // -> 5
+    ABK(OP_JGE, 3, 2, -2),                // -> 1
+    ABC(OP_CONS, 1, 2, 1),
+    ABK(OP_JMP, 0, 0, -4),                // -> 1
+    ABC(OP_REVERSE, 1, 1, 0),
+    ABC(OP_HALT, 1, 0, 0),
+};
+
+// Reduce: r1 = sum of r0
+static const uint32_t jit_test_reduce[] = {
+    ABK(OP_LOADI, 1, 0, 0),
+    ABK(OP_NEXT, 0, 2, 2),                // -> 4
+    ABC(OP_ADD, 1, 1, 2),
+    ABK(OP_JMP, 0, 0, -3),                // -> 1
+    ABC(OP_HALT, 1, 0, 0),
+};
+
+// Filter: r1 = [X || X <- r0, X in the set handle literal 0]
+static const uint32_t jit_test_member[] = {
+    ABK(OP_LOADK, 5, 0, 0),
+    ABK(OP_LOADI, 6, 0, 0),
+    ABK(OP_NEXT, 0, 2, 4),                // -> 7
+    ABC(OP_MEMBER, 3, 2, 5),
+    ABK(OP_JEQ, 3, 6, -3),                // -> 2
+    ABC(OP_CONS, 1, 2, 1),
+    ABK(OP_JMP, 0, 0, -5),                // -> 2
+    ABC(OP_REVERSE, 1, 1, 0),
+    ABC(OP_HALT, 1, 0, 0),
+};
+
+static void jit_test_setup(jit_test_context* ctx) {
+    ctx->states = scheduler_state_init(1);
+    scheduler_init(ctx->states, 0);
+    scheduler_set_reduction_count_with_state(ctx->states, 0, DEFAULT_REDUCTIONS);
+    ctx->pcb = test_pcb_with_heap(JIT_TEST_HEAP_WORDS);
+}
+
+static void jit_test_teardown(jit_test_context* ctx) {
+    test_pcb_free(ctx->pcb);
+    scheduler_state_destroy(ctx->states);
+}
+
+// [first, first + 1, ..., first + count - 1]
+static uint64_t jit_test_list(void* pcb, int64_t first, int64_t count) {
+    uint64_t list = TERM_NIL;
+    for (int64_t i = count - 1; i >= 0; i--) {
+        list = term_cons(pcb, term_make_int(first + i), list);
+    }
+    return list;
+}
+
+// Compare two lists of integers element by element
+static int jit_test_lists_equal(uint64_t a, uint64_t b) {
+    while (a != TERM_NIL && b != TERM_NIL) {
+        if (term_int_value(term_head(a)) != term_int_value(term_head(b))) {
+            return 0;
+        }
+        a = term_tail(a);
+        b = term_tail(b);
+    }
+    return a == b;
+}
+
+static int jit_test_send(void* argument, uint64_t pid, uint64_t message) {
+    jit_test_mailbox* mailbox = argument;
+    if (mailbox->count == JIT_TEST_SENDS) {
+        return 0;
+    }
+    mailbox->pids[mailbox->count] = pid;
+    mailbox->messages[mailbox->count] = message;
+    mailbox->count++;
+    return 1;
+}
+
+// Run a frame with a fresh budget each time until it stops yielding;
+// returns the final status, counts the yields and leaves the budget
+static uint64_t jit_test_run(jit_test_context* ctx, void* frame, uint64_t budget, uint64_t* yields) {
+    uint64_t status;
+    *yields = 0;
+    for (;;) {
+        scheduler_set_reduction_count_with_state(ctx->states, 0, budget);
+        status = interp_run(ctx->states, 0, frame);
+        if (status != INTERP_YIELD) {
+            return status;
+        }
+        (*yields)++;
+    }
+}
+
+// Run the interpreted and native frames in lockstep: every run must
+// stop with the same status, pc and budget, the same integers in the
+// first registers and the same kind of term otherwise
+static void jit_test_lockstep(jit_test_context* ctx, uint64_t budget, const char* name) {
+    int same = 1;
+    uint64_t status;
+    do {
+        scheduler_set_reduction_count_with_state(ctx->states, 0, budget);
+        status = interp_run(ctx->states, 0, ctx->interpreted);
+        uint64_t left = scheduler_get_reduction_count_with_state(ctx->states, 0);
+        scheduler_set_reduction_count_with_state(ctx->states, 0, budget);
+        uint64_t native_status = interp_run(ctx->states, 0, ctx->native);
+        same = same && native_status == status;
+        same = same && scheduler_get_reduction_count_with_state(ctx->states, 0) == left;
+        same = same && interp_pc(ctx->interpreted) == interp_pc(ctx->native);
+        for (uint64_t r = 0; r < 4; r++) {
+            uint64_t a = interp_get_register(ctx->interpreted, r);
+            uint64_t b = interp_get_register(ctx->native, r);
+            same = same && ((a & 7) == 0 ? a == b : (a & 7) == (b & 7));
+        }
+    } while (same && status == INTERP_YIELD);
+    test_assert_true(same, name);
+}
+
+static void test_jit_compile() {
+    printf("\n--- Testing range validation ---\n");
+
+    void* program = interp_load(jit_test_map, 9, NULL, 0);
+    test_assert_true(!jit_compile(NULL, 0, 1), "compile without a program");
+    test_assert_true(!jit_compile(program, 0, 0), "empty range");
+    test_assert_true(!jit_compile(program, 9, 1), "range past the program");
+    test_assert_true(!jit_compile(program, 5, 5), "range running past the end");
+    test_assert_true(!jit_compile(program, 0, JIT_MAX_INSTRUCTIONS + 1), "range too long");
+    test_assert_true(!jit_is_native(program, 7), "interpreted before compiling");
+
+    test_assert_true(jit_compile(program, 7, 2), "compile a function");
+    test_assert_true(jit_is_native(program, 7) && jit_is_native(program, 8), "function is native");
+    test_assert_true(!jit_is_native(program, 6), "rest still interpreted");
+    test_assert_true(!jit_compile(program, 6, 2), "overlapping range refused");
+    test_assert_true(jit_compile(program, 0, 7), "compile the rest");
+    test_assert_true(jit_is_native(program, 0), "whole program native");
+    test_assert_true(!jit_is_native(program, 9), "no instruction past the end");
+    test_assert_true(!jit_is_native(NULL, 0), "no program");
+    test_assert_true(interp_program_destroy(program), "destroy with two native ranges");
+}
+
+static void test_jit_arithmetic() {
+    printf("\n--- Testing native arithmetic ---\n");
+
+    jit_test_context ctx;
+    jit_test_setup(&ctx);
+
+    // r2 = (r0 + 7) * -3 - literal 0, with a wide immediate
+    uint32_t code[] = {
+        ABK(OP_ADDI, 1, 0, 7),
+        ABK(OP_LOADI, 3, 0, -3),
+        ABC(OP_MUL, 1, 1, 3),
+        ABK(OP_LOADK, 4, 0, 0),
+        ABC(OP_SUB, 2, 1, 4),
+        ABK(OP_LOADI, 5, 0, 30000),
+        ABC(OP_ADD, 2, 2, 5),
+        ABC(OP_HALT, 2, 0, 0),
+    };
+    uint64_t literal = term_make_int(1000);
+    void* program = interp_load(code, 8, &literal, 1);
+    test_assert_true(jit_compile(program, 0, 8), "compile arithmetic");
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 0, term_make_int(5));
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.native), "native runs to HALT");
+    test_assert_equal(term_make_int(28964), interp_result(ctx.native), "native result");
+    test_assert_equal(7, interp_pc(ctx.native), "pc stays on HALT");
+    test_assert_equal(DEFAULT_REDUCTIONS - 8, scheduler_get_reduction_count_with_state(ctx.states, 0),
+                      "one reduction per native instruction");
+    test_assert_equal(term_make_int(-3), interp_get_register(ctx.native, 3), "negative immediate");
+
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 0, term_make_atom(3));
+    scheduler_set_reduction_count_with_state(ctx.states, 0, DEFAULT_REDUCTIONS);
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.native), "native badarg on an atom");
+    test_assert_equal(0, interp_pc(ctx.native), "pc on the failing instruction");
+
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 0, term_make_int((int64_t)1 << 59));
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.native), "native multiply overflow");
+    test_assert_equal(2, interp_pc(ctx.native), "overflow stops on MUL");
+
+    interp_program_destroy(program);
+    jit_test_teardown(&ctx);
+}
+
+static void test_jit_templates() {
+    printf("\n--- Testing native Map, Filter and Reduce ---\n");
+
+    jit_test_context ctx;
+    jit_test_setup(&ctx);
+    uint64_t input = jit_test_list(ctx.pcb, 1, 40);
+    const struct {
+        const uint32_t* code;
+        uint64_t count;
+        const char* name;
+    } templates[] = {
+        { jit_test_map, 9, "map matches the interpreter across yields" },
+        { jit_test_filter, 7, "filter matches the interpreter across yields" },
+        { jit_test_reduce, 5, "reduce matches the interpreter across yields" },
+    };
+
+    for (int t = 0; t < 3; t++) {
+        void* interpreted = interp_load(templates[t].code, templates[t].count, NULL, 0);
+        void* native = interp_load(templates[t].code, templates[t].count, NULL, 0);
+        jit_compile(native, 0, templates[t].count);
+        interp_frame_init(ctx.interpreted, interpreted, ctx.pcb);
+        interp_frame_init(ctx.native, native, ctx.pcb);
+        interp_set_register(ctx.interpreted, 0, input);
+        interp_set_register(ctx.native, 0, input);
+        jit_test_lockstep(&ctx, 17, templates[t].name);
+        test_assert_true(interp_result(ctx.interpreted) == interp_result(ctx.native) ||
+                             jit_test_lists_equal(interp_result(ctx.interpreted), interp_result(ctx.native)),
+                         "same result");
+        interp_program_destroy(interpreted);
+        interp_program_destroy(native);
+    }
+
+    // The Reduce budget arithmetic of the interpreter holds natively
+    void* program = interp_load(jit_test_reduce, 5, NULL, 0);
+    jit_compile(program, 0, 5);
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 0, jit_test_list(ctx.pcb, 1, 100));
+    uint64_t yields;
+    test_assert_equal(INTERP_DONE, jit_test_run(&ctx, ctx.native, 50, &yields), "native reduce finishes");
+    test_assert_equal(6, yields, "yields every 50 instructions");
+    test_assert_equal(47, scheduler_get_reduction_count_with_state(ctx.states, 0), "budget left after HALT");
+    test_assert_equal(term_make_int(5050), interp_result(ctx.native), "native reduce result");
+    interp_program_destroy(program);
+
+    jit_test_teardown(&ctx);
+}
+
+static void test_jit_mixed() {
+    printf("\n--- Testing mixed interpreted and native code ---\n");
+
+    jit_test_context ctx;
+    jit_test_setup(&ctx);
+    int64_t doubled[5] = { 2, 4, 6, 8, 10 };
+    uint64_t expected = TERM_NIL;
+    for (int i = 4; i >= 0; i--) {
+        expected = term_cons(ctx.pcb, term_make_int(doubled[i]), expected);
+    }
+    uint64_t yields;
+
+    // Interpreted loop calling a native function
+    void* program = interp_load(jit_test_map, 9, NULL, 0);
+    jit_compile(program, 7, 2);
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 0, jit_test_list(ctx.pcb, 1, 5));
+    test_assert_equal(INTERP_DONE, jit_test_run(&ctx, ctx.native, 3, &yields), "native callee, interpreted caller");
+    test_assert_true(jit_test_lists_equal(expected, interp_result(ctx.native)), "native callee result");
+    interp_program_destroy(program);
+
+    // Native loop calling an interpreted function
+    program = interp_load(jit_test_map, 9, NULL, 0);
+    jit_compile(program, 0, 7);
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 0, jit_test_list(ctx.pcb, 1, 5));
+    test_assert_equal(INTERP_DONE, jit_test_run(&ctx, ctx.native, 3, &yields), "interpreted callee, native caller");
+    test_assert_true(jit_test_lists_equal(expected, interp_result(ctx.native)), "interpreted callee result");
+    interp_program_destroy(program);
+
+    // A frame stopped in interpreted code resumes in native code
+    program = interp_load(jit_test_reduce, 5, NULL, 0);
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 0, jit_test_list(ctx.pcb, 1, 100));
+    scheduler_set_reduction_count_with_state(ctx.states, 0, 40);
+    test_assert_equal(INTERP_YIELD, interp_run(ctx.states, 0, ctx.native), "interpreted run yields");
+    test_assert_true(jit_compile(program, 1, 3), "compile the loop between runs");
+    test_assert_equal(INTERP_DONE, jit_test_run(&ctx, ctx.native, 40, &yields), "resumed natively");
+    test_assert_equal(term_make_int(5050), interp_result(ctx.native), "result across the switch");
+    interp_program_destroy(program);
+
+    jit_test_teardown(&ctx);
+}
+
+static void test_jit_state_and_messages() {
+    printf("\n--- Testing native State Update, For Each and Message ---\n");
+
+    jit_test_context ctx;
+    jit_test_setup(&ctx);
+
+    // For each message in r0: state {Count, Last} = {Count + 1, Last},
+    // then send the message to the literal pid
+    uint32_t code[] = {
+        ABK(OP_LOADK, 3, 0, 0),
+        ABK(OP_NEXT, 0, 2, 5),            // -> 7
+        ABK(OP_GETEL, 4, 1, 0),
+        ABK(OP_ADDI, 4, 4, 1),
+        ABK(OP_UPDATE, 1, 4, 0),
+        ABC(OP_SEND, 3, 2, 0),
+        ABK(OP_JMP, 0, 0, -6),            // -> 1
+        ABC(OP_HALT, 1, 0, 0),
+    };
+    uint64_t pid = term_make_pid(42);
+    void* program = interp_load(code, 8, &pid, 1);
+    jit_compile(program, 0, 8);
+
+    uint64_t state = term_tuple(ctx.pcb, 2);
+    term_set_element(state, 0, term_make_int(0));
+    term_set_element(state, 1, term_make_atom(7));
+    jit_test_mailbox mailbox = { 0 };
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 0, jit_test_list(ctx.pcb, 10, 3));
+    interp_set_register(ctx.native, 1, state);
+    interp_set_send(ctx.native, jit_test_send, &mailbox);
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.native), "native for each runs");
+
+    uint64_t final = interp_result(ctx.native);
+    test_assert_equal(term_make_int(3), term_element(final, 0), "state updated per message");
+    test_assert_equal(term_make_atom(7), term_element(final, 1), "other elements kept");
+    test_assert_equal(term_make_int(0), term_element(state, 0), "original state untouched");
+    test_assert_equal(3, mailbox.count, "one native send per element");
+    test_assert_equal(pid, mailbox.pids[2], "sent to the literal pid");
+    test_assert_equal(term_make_int(11), mailbox.messages[1], "messages in order");
+
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 0, jit_test_list(ctx.pcb, 10, 3));
+    interp_set_register(ctx.native, 1, state);
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.native), "native send without a function");
+    test_assert_equal(5, interp_pc(ctx.native), "stopped on SEND");
+
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 0, jit_test_list(ctx.pcb, 10, 1));
+    interp_set_register(ctx.native, 1, term_tuple(ctx.pcb, 0));
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.native), "native element of an empty tuple");
+    test_assert_equal(2, interp_pc(ctx.native), "stopped on GETEL");
+
+    // TUPLE calls term_tuple directly; SETEL and GETEL on element 1
+    uint32_t build[] = {
+        ABK(OP_TUPLE, 1, 0, 2),
+        ABK(OP_SETEL, 1, 0, 1),
+        ABK(OP_GETEL, 2, 1, 1),
+        ABC(OP_HALT, 1, 0, 0),
+    };
+    void* builder = interp_load(build, 4, NULL, 0);
+    jit_compile(builder, 0, 4);
+    interp_frame_init(ctx.native, builder, ctx.pcb);
+    interp_set_register(ctx.native, 0, term_make_int(9));
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.native), "native tuple build");
+    test_assert_equal(term_make_int(9), term_element(interp_result(ctx.native), 1), "element set");
+    test_assert_equal(TERM_NIL, term_element(interp_result(ctx.native), 0), "other element NIL");
+    test_assert_equal(term_make_int(9), interp_get_register(ctx.native, 2), "element read back");
+
+    interp_program_destroy(builder);
+    interp_program_destroy(program);
+    jit_test_teardown(&ctx);
+}
+
+static void test_jit_heap_and_control() {
+    printf("\n--- Testing native heap full and control errors ---\n");
+
+    jit_test_context ctx;
+    jit_test_setup(&ctx);
+
+    // Two inline cons cells fit in a five-word heap, the third does not
+    void* small = test_pcb_with_heap(5);
+    uint32_t cons[] = {
+        ABC(OP_CONS, 1, 0, 1),
+        ABC(OP_CONS, 1, 0, 1),
+        ABC(OP_CONS, 1, 0, 1),
+        ABC(OP_HALT, 1, 0, 0),
+    };
+    void* program = interp_load(cons, 4, NULL, 0);
+    jit_compile(program, 0, 4);
+    interp_frame_init(ctx.native, program, small);
+    interp_set_register(ctx.native, 0, term_make_int(1));
+    test_assert_equal(INTERP_HEAP_FULL, interp_run(ctx.states, 0, ctx.native), "native heap full");
+    test_assert_equal(2, interp_pc(ctx.native), "pc on the allocating instruction");
+    test_assert_equal(DEFAULT_REDUCTIONS - 2, scheduler_get_reduction_count_with_state(ctx.states, 0),
+                      "failed cons refunded");
+
+    uint64_t* heap = calloc(16, sizeof(uint64_t));
+    *(uint64_t*)((uint8_t*)small + PCB_HEAP_POINTER_OFFSET) = (uint64_t)heap;
+    *(uint64_t*)((uint8_t*)small + PCB_HEAP_LIMIT_OFFSET) = (uint64_t)(heap + 16);
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.native), "resume after heap full");
+    uint64_t list = interp_result(ctx.native);
+    test_assert_true(list != TERM_NIL && term_tail(term_tail(term_tail(list))) == TERM_NIL, "every cons done once");
+    free(heap);
+    test_pcb_free(small);
+    interp_program_destroy(program);
+
+    // RET without a CALL
+    uint32_t ret[] = { ABC(OP_RET, 0, 0, 0) };
+    program = interp_load(ret, 1, NULL, 0);
+    jit_compile(program, 0, 1);
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.native), "native return without a call");
+    interp_program_destroy(program);
+
+    // Unbounded recursion stops at the depth limit
+    uint32_t recurse[] = { ABK(OP_CALL, 0, 0, -1) };
+    program = interp_load(recurse, 1, NULL, 0);
+    jit_compile(program, 0, 1);
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    scheduler_set_reduction_count_with_state(ctx.states, 0, DEFAULT_REDUCTIONS);
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.native), "native call depth limit");
+    test_assert_equal(DEFAULT_REDUCTIONS - INTERP_MAX_DEPTH - 1, scheduler_get_reduction_count_with_state(ctx.states, 0),
+                      "failed call charged");
+    interp_program_destroy(program);
+
+    // Falling off the end of the program from native code
+    uint32_t fall[] = { ABC(OP_MOVE, 1, 0, 0) };
+    program = interp_load(fall, 1, NULL, 0);
+    jit_compile(program, 0, 1);
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.native), "native ran off the end");
+    test_assert_equal(1, interp_pc(ctx.native), "pc past the last instruction");
+    interp_program_destroy(program);
+
+    // NEXT on an improper list
+    uint32_t walk[] = { ABK(OP_NEXT, 0, 1, -1), ABC(OP_HALT, 0, 0, 0) };
+    program = interp_load(walk, 2, NULL, 0);
+    jit_compile(program, 0, 2);
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 0, term_cons(ctx.pcb, term_make_int(1), term_make_int(2)));
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.native), "native improper list");
+    test_assert_equal(0, interp_pc(ctx.native), "stopped on NEXT");
+    interp_program_destroy(program);
+
+    jit_test_teardown(&ctx);
+}
+
+static void test_jit_membership() {
+    printf("\n--- Testing MEMBER in native code ---\n");
+
+    jit_test_context ctx;
+    jit_test_setup(&ctx);
+    void* odd = set_create(64);
+    for (int64_t i = 1; i < 40; i += 2) {
+        set_insert(odd, term_make_int(i));
+    }
+    set_freeze(odd);
+    uint64_t handle = set_term(ctx.pcb, odd);
+    uint64_t input = jit_test_list(ctx.pcb, 1, 40);
+
+    void* interpreted = interp_load(jit_test_member, 9, &handle, 1);
+    void* native = interp_load(jit_test_member, 9, &handle, 1);
+    test_assert_true(jit_compile(native, 0, 9), "set filter compiled");
+    test_assert_true(jit_is_native(native, 3), "MEMBER slot enters native code");
+    interp_frame_init(ctx.interpreted, interpreted, ctx.pcb);
+    interp_frame_init(ctx.native, native, ctx.pcb);
+    interp_set_register(ctx.interpreted, 0, input);
+    interp_set_register(ctx.native, 0, input);
+    jit_test_lockstep(&ctx, 17, "set filter matches the interpreter across yields");
+    test_assert_true(jit_test_lists_equal(interp_result(ctx.interpreted), interp_result(ctx.native)),
+                     "same result");
+    int odd_only = 1;
+    uint64_t kept = 0;
+    for (uint64_t list = interp_result(ctx.native); list != TERM_NIL; list = term_tail(list)) {
+        odd_only &= (int)(term_int_value(term_head(list)) & 1);
+        kept++;
+    }
+    test_assert_true(odd_only, "native set filter keeps members only");
+    test_assert_equal(20, kept, "native set filter keeps every member");
+
+    // Anything but a set handle stops on MEMBER
+    uint32_t member[] = { ABC(OP_MEMBER, 3, 2, 5), ABC(OP_HALT, 3, 0, 0) };
+    void* program = interp_load(member, 2, NULL, 0);
+    jit_compile(program, 0, 2);
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 5, term_tuple(ctx.pcb, 1));
+    scheduler_set_reduction_count_with_state(ctx.states, 0, DEFAULT_REDUCTIONS);
+    test_assert_equal(INTERP_BADARG, interp_run(ctx.states, 0, ctx.native), "native MEMBER on a tuple");
+    test_assert_equal(0, interp_pc(ctx.native), "stopped on MEMBER");
+    interp_frame_init(ctx.native, program, ctx.pcb);
+    interp_set_register(ctx.native, 2, term_make_int(39));
+    interp_set_register(ctx.native, 5, handle);
+    test_assert_equal(INTERP_DONE, interp_run(ctx.states, 0, ctx.native), "native MEMBER hit runs");
+    test_assert_equal(term_make_int(1), interp_result(ctx.native), "native MEMBER hit is 1");
+    interp_program_destroy(program);
+
+    interp_program_destroy(interpreted);
+    interp_program_destroy(native);
+    set_destroy(odd);
+    jit_test_teardown(&ctx);
+}
+
+void test_jit_main() {
+    printf("=== NATIVE TEMPLATE CODE TEST SUITE ===\n");
+
+    test_jit_compile();
+    test_jit_arithmetic();
+    test_jit_templates();
+    test_jit_mixed();
+    test_jit_state_and_messages();
+    test_jit_membership();
+    test_jit_heap_and_control();
+
+    printf("=== NATIVE TEMPLATE CODE TEST SUITE COMPLETE ===\n");
+}
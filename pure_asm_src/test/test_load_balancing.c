@@ -47,13 +47,13 @@ extern void test_fail(uint64_t expected, uint64_t actual, const char* test_name)
     } while(0)
 
 // External assembly functions
-extern uint32_t get_scheduler_load(uint64_t core_id);
-extern uint64_t find_busiest_scheduler(uint64_t current_core);
-extern int is_steal_allowed(uint64_t source_core, uint64_t target_core);
+extern uint32_t get_scheduler_load(void* scheduler_states, uint64_t core_id);
+extern uint64_t find_busiest_scheduler(void* scheduler_states, uint64_t current_core);
+extern int is_steal_allowed(uint64_t source_core, uint64_t target_core, void* pcb);
 extern uint64_t select_victim_random(uint64_t current_core);
-extern uint64_t select_victim_by_load(uint64_t current_core);
-extern uint64_t select_victim_locality(uint64_t current_core);
-extern void* try_steal_work(uint64_t current_core);
+extern uint64_t select_victim_by_load(void* scheduler_states, uint64_t current_core);
+extern uint64_t select_victim_locality(void* scheduler_states, uint64_t current_core);
+extern int try_steal_work(void* scheduler_states, uint64_t current_core);
 extern int migrate_process(void* process, uint64_t source_core, uint64_t target_core);
 
 // External constants
@@ -64,6 +64,9 @@ extern void* scheduler_state_init(uint64_t max_cores);
 extern void scheduler_state_destroy(void* scheduler_states);
 extern void scheduler_init(void* scheduler_states, uint64_t core_id);
 
+// Scheduler state used by the tests in this file
+static void* scheduler_state = NULL;
+
 // Forward declarations for test functions
 static void test_get_scheduler_load_basic();
 static void test_get_scheduler_load_priorities();
@@ -77,7 +80,7 @@ void test_load_balancing() {
     printf("=== Testing Load Balancing Functions ===\n");
     
     // Create isolated scheduler state for proper memory isolation
-    void* scheduler_state = scheduler_state_init(1);
+    scheduler_state = scheduler_state_init(1);
     if (scheduler_state == NULL) {
         printf("ERROR: Failed to create scheduler state\n");
         return;
@@ -94,6 +97,7 @@ void test_load_balancing() {
     
     // Clean up scheduler state
     scheduler_state_destroy(scheduler_state);
+    scheduler_state = NULL;
     
     printf("=== Load Balancing Tests Complete ===\n");
     printf("*** LOAD BALANCING TEST FINISHED ***\n");
@@ -104,7 +108,7 @@ static void test_get_scheduler_load_basic() {
     printf("Testing get_scheduler_load basic functionality...\n");
     
     // Test with core 0 (should work even if scheduler not fully initialized)
-    uint32_t load = get_scheduler_load(0);
+    uint32_t load = get_scheduler_load(scheduler_state, 0);
     
     
     // Simple test without framework first
@@ -122,7 +126,7 @@ static void test_get_scheduler_load_priorities() {
     printf("Testing get_scheduler_load priority weights...\n");
     
     // Test with core 0
-    uint32_t load = get_scheduler_load(0);
+    uint32_t load = get_scheduler_load(scheduler_state, 0);
     
     // For now, just verify it returns 0 (empty queues)
     test_assert_equal(0, load, "get_scheduler_load_priorities_zero");
@@ -135,7 +139,7 @@ static void test_get_scheduler_load_invalid_core() {
     printf("Testing get_scheduler_load with invalid core ID...\n");
     
     // Test with invalid core ID (beyond MAX_CORES)
-    uint32_t load = get_scheduler_load(999);
+    uint32_t load = get_scheduler_load(scheduler_state, 999);
     
     // Should return 0 for invalid core ID
     test_assert_equal(0, load, "get_scheduler_load_invalid_core_zero");
@@ -148,7 +152,7 @@ static void test_get_scheduler_load_empty_queues() {
     printf("Testing get_scheduler_load with empty queues...\n");
     
     // Test with core 0 (should have empty queues by default)
-    uint32_t load = get_scheduler_load(0);
+    uint32_t load = get_scheduler_load(scheduler_state, 0);
     
     // Load should be 0 for empty queues
     test_assert_equal(0, load, "get_scheduler_load_empty_queues_zero");
@@ -161,7 +165,7 @@ static void test_get_scheduler_load_mixed_priorities() {
     printf("Testing get_scheduler_load with mixed priorities...\n");
     
     // Test with core 0
-    uint32_t load = get_scheduler_load(0);
+    uint32_t load = get_scheduler_load(scheduler_state, 0);
     
     // For now, just verify it returns 0 (empty queues)
     test_assert_equal(0, load, "get_scheduler_load_mixed_priorities_zero");
@@ -0,0 +1,376 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// ------------------------------------------------------------
+// test_map.c — C test suite for Persistent Hash Array Mapped Tries
+// ------------------------------------------------------------
+// Tests map.s: lookup, insert, replace and delete on a PCB heap,
+// persistence and structural sharing between versions, canonical
+// shapes (bulk construction, puts in any order and deletes agree),
+// hash collisions, heap exhaustion, and map nodes passing through
+// term.s sizing, copying and heap walks.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern uint64_t map_new(void* pcb);
+extern uint64_t map_get(uint64_t map, uint64_t key);
+extern uint64_t map_put(void* pcb, uint64_t map, uint64_t key, uint64_t value);
+extern uint64_t map_delete(void* pcb, uint64_t map, uint64_t key);
+extern uint64_t map_size(uint64_t map);
+extern uint64_t map_from_list(void* pcb, uint64_t list);
+extern uint64_t map_hash(uint64_t term);
+extern uint64_t term_make_int(int64_t value);
+extern uint64_t term_make_atom(uint64_t index);
+extern uint64_t term_type(uint64_t term);
+extern uint64_t term_tuple(void* pcb, uint64_t arity);
+extern int term_set_element(uint64_t tuple, uint64_t index, uint64_t value);
+extern uint64_t term_cons(void* pcb, uint64_t head, uint64_t tail);
+extern uint64_t term_binary(void* pcb, const uint8_t* data, uint64_t length);
+extern uint64_t term_size(uint64_t term);
+extern uint64_t term_copy(void* pcb, uint64_t term);
+extern int term_equal(uint64_t a, uint64_t b);
+extern uint64_t* term_heap_next(uint64_t* object);
+
+// Term constants (match config.inc)
+#define TERM_NIL 0x14
+#define TERM_NONE 0x34
+#define TERM_TYPE_MAP 8
+
+#define MAP_TEST_HEAP_WORDS (1 << 21)
+#define MAP_TEST_KEYS 5000
+
+// Collision search: more keys than needed to find two equal 32-bit
+// hashes, in a table twice that size
+#define MAP_TEST_SEARCH_KEYS (1 << 18)
+#define MAP_TEST_SEARCH_SLOTS (1 << 19)
+
+static uint64_t map_test_pair(void* pcb, uint64_t key, uint64_t value) {
+    uint64_t pair = term_tuple(pcb, 2);
+    term_set_element(pair, 0, key);
+    term_set_element(pair, 1, value);
+    return pair;
+}
+
+// Keys first..first+count-1 bound to ten times themselves, one put each
+static uint64_t map_test_build(void* pcb, uint64_t map, int64_t first, int64_t count) {
+    for (int64_t k = first; k < first + count; k++) {
+        map = map_put(pcb, map, term_make_int(k), term_make_int(10 * k));
+    }
+    return map;
+}
+
+// Two small integers whose keys hash alike
+static int map_test_collision(int64_t* a, int64_t* b) {
+    uint64_t* slots = calloc(MAP_TEST_SEARCH_SLOTS, sizeof(uint64_t));
+    int found = 0;
+    for (int64_t k = 0; k < MAP_TEST_SEARCH_KEYS && !found; k++) {
+        uint64_t hash = map_hash(term_make_int(k));
+        uint64_t slot = hash & (MAP_TEST_SEARCH_SLOTS - 1);
+        while (slots[slot] != 0) {
+            int64_t other = (int64_t)slots[slot] - 1;
+            if (map_hash(term_make_int(other)) == hash) {
+                *a = other;
+                *b = k;
+                found = 1;
+                break;
+            }
+            slot = (slot + 1) & (MAP_TEST_SEARCH_SLOTS - 1);
+        }
+        slots[slot] = (uint64_t)k + 1;
+    }
+    free(slots);
+    return found;
+}
+
+static void test_map_basics() {
+    printf("\n--- Testing map basics ---\n");
+
+    void* pcb = test_pcb_with_heap(MAP_TEST_HEAP_WORDS);
+    uint64_t empty = map_new(pcb);
+    uint64_t one = term_make_int(1);
+    test_assert_equal(TERM_TYPE_MAP, term_type(empty), "type of map");
+    test_assert_equal(0, map_size(empty), "new map is empty");
+    test_assert_equal(TERM_NONE, map_get(empty, one), "empty map has no keys");
+
+    uint64_t m1 = map_put(pcb, empty, one, term_make_atom(5));
+    test_assert_equal(term_make_atom(5), map_get(m1, one), "put then get");
+    test_assert_equal(1, map_size(m1), "one key");
+    test_assert_equal(TERM_NONE, map_get(m1, term_make_int(2)), "other key absent");
+
+    uint64_t m2 = map_put(pcb, m1, one, term_make_atom(6));
+    test_assert_equal(term_make_atom(6), map_get(m2, one), "put replaces");
+    test_assert_equal(1, map_size(m2), "replace keeps the size");
+    uint64_t used = test_pcb_heap_pointer(pcb);
+    test_assert_equal(m2, map_put(pcb, m2, one, term_make_atom(6)), "putting the same value returns the map");
+    test_assert_equal(used, test_pcb_heap_pointer(pcb), "unchanged put allocates nothing");
+
+    uint64_t m3 = map_delete(pcb, m2, one);
+    test_assert_equal(0, map_size(m3), "delete the only key");
+    test_assert_true(term_equal(empty, m3), "deleted map equals the empty map");
+    test_assert_equal(m2, map_delete(pcb, m2, term_make_int(2)), "deleting an absent key returns the map");
+
+    test_assert_equal(TERM_NONE, map_put(pcb, empty, TERM_NONE, one), "TERM_NONE is not a key");
+    test_assert_equal(TERM_NONE, map_put(pcb, empty, one, TERM_NONE), "TERM_NONE is not a value");
+    test_assert_equal(TERM_NONE, map_put(pcb, term_tuple(pcb, 2), one, one), "put into a non-map");
+    test_assert_equal(TERM_NONE, map_get(term_make_int(3), one), "get from a non-map");
+    test_assert_equal(0, map_size(TERM_NIL), "size of a non-map");
+    test_assert_equal(TERM_NONE, map_new(NULL), "map without a PCB");
+
+    // Structured keys match by value, not by identity
+    uint64_t key = map_test_pair(pcb, term_make_atom(3), term_binary(pcb, (const uint8_t*)"key", 3));
+    uint64_t same = map_test_pair(pcb, term_make_atom(3), term_binary(pcb, (const uint8_t*)"key", 3));
+    uint64_t m4 = map_put(pcb, empty, key, one);
+    test_assert_equal(map_hash(key), map_hash(same), "equal terms hash alike");
+    test_assert_equal(one, map_get(m4, same), "tuple key found by an equal tuple");
+    test_assert_equal(0, map_size(map_delete(pcb, m4, same)), "tuple key deleted by an equal tuple");
+
+    test_pcb_free(pcb);
+}
+
+static void test_map_many_keys() {
+    printf("\n--- Testing map with many keys ---\n");
+
+    void* pcb = test_pcb_with_heap(MAP_TEST_HEAP_WORDS);
+    uint64_t map = map_test_build(pcb, map_new(pcb), 0, MAP_TEST_KEYS);
+    test_assert_equal(MAP_TEST_KEYS, map_size(map), "every key stored");
+
+    int found = 1;
+    for (int64_t k = 0; k < MAP_TEST_KEYS; k++) {
+        found &= map_get(map, term_make_int(k)) == term_make_int(10 * k);
+    }
+    test_assert_true(found, "every key maps to its value");
+    test_assert_equal(TERM_NONE, map_get(map, term_make_int(MAP_TEST_KEYS)), "key past the range absent");
+
+    uint64_t odd = map;
+    for (int64_t k = 0; k < MAP_TEST_KEYS; k += 2) {
+        odd = map_delete(pcb, odd, term_make_int(k));
+    }
+    test_assert_equal(MAP_TEST_KEYS / 2, map_size(odd), "half the keys deleted");
+    int right = 1;
+    for (int64_t k = 0; k < MAP_TEST_KEYS; k++) {
+        uint64_t expected = (k & 1) ? term_make_int(10 * k) : TERM_NONE;
+        right &= map_get(odd, term_make_int(k)) == expected;
+    }
+    test_assert_true(right, "only odd keys remain");
+
+    uint64_t rest = odd;
+    for (int64_t k = 1; k < MAP_TEST_KEYS; k += 2) {
+        rest = map_delete(pcb, rest, term_make_int(k));
+    }
+    test_assert_equal(0, map_size(rest), "all keys deleted");
+    test_assert_true(term_equal(map_new(pcb), rest), "deleting everything leaves an empty root");
+
+    test_pcb_free(pcb);
+}
+
+static void test_map_persistence() {
+    printf("\n--- Testing map persistence and sharing ---\n");
+
+    void* pcb = test_pcb_with_heap(MAP_TEST_HEAP_WORDS);
+    uint64_t before = map_test_build(pcb, map_new(pcb), 0, MAP_TEST_KEYS);
+    uint64_t key = term_make_int(1234);
+
+    uint64_t start = test_pcb_heap_pointer(pcb);
+    uint64_t after = map_put(pcb, before, key, term_make_atom(9));
+    uint64_t words = (test_pcb_heap_pointer(pcb) - start) / 8;
+    test_assert_equal(term_make_atom(9), map_get(after, key), "new version has the new value");
+    test_assert_equal(term_make_int(12340), map_get(before, key), "old version keeps the old value");
+    // A path of full nodes is at most 3 x 65 words; a copied map is 10000
+    test_assert_true(words <= 3 * 65, "update copies only the path");
+    test_assert_true(term_size(after) > 2 * MAP_TEST_KEYS, "the whole map is far larger");
+
+    uint64_t removed = map_delete(pcb, before, key);
+    test_assert_equal(TERM_NONE, map_get(removed, key), "deleted in the new version");
+    test_assert_equal(term_make_int(12340), map_get(before, key), "still in the old version");
+    test_assert_equal(MAP_TEST_KEYS, map_size(before), "old version keeps its size");
+    test_assert_equal(MAP_TEST_KEYS - 1, map_size(removed), "new version lost one key");
+
+    // Root slots off the updated path are shared, not copied
+    uint64_t* old_root = (uint64_t*)(before - 1);
+    uint64_t* new_root = (uint64_t*)(after - 1);
+    uint64_t pairs = (old_root[0] >> 8) & 0xFFFFFF;
+    uint64_t shared = 0;
+    for (uint64_t i = 0; i < pairs; i++) {
+        shared += old_root[2 + 2 * i] == new_root[2 + 2 * i];
+    }
+    test_assert_equal(pairs - 1, shared, "every other child is shared");
+
+    test_pcb_free(pcb);
+}
+
+static void test_map_canonical() {
+    printf("\n--- Testing canonical shapes and bulk construction ---\n");
+
+    void* pcb = test_pcb_with_heap(MAP_TEST_HEAP_WORDS);
+    uint64_t forward = map_test_build(pcb, map_new(pcb), 0, 1000);
+    uint64_t backward = map_new(pcb);
+    for (int64_t k = 999; k >= 0; k--) {
+        backward = map_put(pcb, backward, term_make_int(k), term_make_int(10 * k));
+    }
+    test_assert_true(term_equal(forward, backward), "insertion order does not change the shape");
+
+    uint64_t list = TERM_NIL;
+    for (int64_t k = 999; k >= 0; k--) {
+        list = term_cons(pcb, map_test_pair(pcb, term_make_int(k), term_make_int(10 * k)), list);
+    }
+    uint64_t start = test_pcb_heap_pointer(pcb);
+    uint64_t bulk = map_from_list(pcb, list);
+    test_assert_equal(1000, map_size(bulk), "bulk map size");
+    test_assert_true(term_equal(forward, bulk), "bulk build equals repeated puts");
+    test_assert_equal(term_size(bulk) * 8, test_pcb_heap_pointer(pcb) - start, "bulk build is one exact allocation");
+
+    uint64_t trimmed = map_test_build(pcb, map_new(pcb), 0, 500);
+    uint64_t deleted = forward;
+    for (int64_t k = 500; k < 1000; k++) {
+        deleted = map_delete(pcb, deleted, term_make_int(k));
+    }
+    test_assert_true(term_equal(trimmed, deleted), "deletes collapse back to the built shape");
+
+    // Repeated keys: first position, last value
+    uint64_t dup = TERM_NIL;
+    dup = term_cons(pcb, map_test_pair(pcb, term_make_int(7), term_make_int(3)), dup);
+    dup = term_cons(pcb, map_test_pair(pcb, term_make_int(8), term_make_int(2)), dup);
+    dup = term_cons(pcb, map_test_pair(pcb, term_make_int(7), term_make_int(1)), dup);
+    uint64_t from_dup = map_from_list(pcb, dup);
+    test_assert_equal(2, map_size(from_dup), "repeated key stored once");
+    test_assert_equal(term_make_int(3), map_get(from_dup, term_make_int(7)), "last value wins");
+
+    test_assert_true(term_equal(map_new(pcb), map_from_list(pcb, TERM_NIL)), "empty list gives an empty map");
+    uint64_t bad = term_cons(pcb, term_tuple(pcb, 3), TERM_NIL);
+    test_assert_equal(TERM_NONE, map_from_list(pcb, bad), "elements must be pairs");
+    test_assert_equal(TERM_NONE, map_from_list(pcb, term_cons(pcb, map_test_pair(pcb, TERM_NIL, TERM_NIL), term_make_int(1))),
+                      "list must be proper");
+
+    test_pcb_free(pcb);
+}
+
+static void test_map_collisions() {
+    printf("\n--- Testing hash collisions ---\n");
+
+    int64_t a = 0;
+    int64_t b = 0;
+    int found = map_test_collision(&a, &b);
+    test_assert_true(found, "two keys with equal hashes exist");
+    if (!found) {
+        return;
+    }
+
+    void* pcb = test_pcb_with_heap(MAP_TEST_HEAP_WORDS);
+    uint64_t ka = term_make_int(a);
+    uint64_t kb = term_make_int(b);
+    uint64_t base = map_test_build(pcb, map_new(pcb), 1000000, 100);
+    uint64_t both = map_put(pcb, map_put(pcb, base, ka, term_make_atom(1)), kb, term_make_atom(2));
+    test_assert_equal(term_make_atom(1), map_get(both, ka), "first colliding key");
+    test_assert_equal(term_make_atom(2), map_get(both, kb), "second colliding key");
+    test_assert_equal(102, map_size(both), "both stored");
+
+    uint64_t replaced = map_put(pcb, both, kb, term_make_atom(3));
+    test_assert_equal(term_make_atom(3), map_get(replaced, kb), "replace in a collision node");
+    test_assert_equal(term_make_atom(1), map_get(replaced, ka), "neighbour untouched");
+
+    uint64_t list = TERM_NIL;
+    list = term_cons(pcb, map_test_pair(pcb, kb, term_make_atom(2)), list);
+    list = term_cons(pcb, map_test_pair(pcb, ka, term_make_atom(1)), list);
+    uint64_t pair_map = map_put(pcb, map_put(pcb, map_new(pcb), ka, term_make_atom(1)), kb, term_make_atom(2));
+    test_assert_true(term_equal(pair_map, map_from_list(pcb, list)), "bulk build of colliding keys");
+
+    uint64_t without_a = map_delete(pcb, both, ka);
+    test_assert_equal(TERM_NONE, map_get(without_a, ka), "colliding key deleted");
+    test_assert_equal(term_make_atom(2), map_get(without_a, kb), "other colliding key remains");
+    uint64_t only_b = map_put(pcb, base, kb, term_make_atom(2));
+    test_assert_true(term_equal(only_b, without_a), "collision node folds away when one key is left");
+
+    test_pcb_free(pcb);
+}
+
+static void test_map_heap() {
+    printf("\n--- Testing maps on process heaps ---\n");
+
+    void* pcb = test_pcb_with_heap(MAP_TEST_HEAP_WORDS);
+    uint64_t map = map_test_build(pcb, map_new(pcb), 0, 200);
+    uint64_t* base = *(uint64_t**)((uint8_t*)pcb + PCB_HEAP_BASE_OFFSET);
+    uint64_t* object = base;
+    uint64_t* end = (uint64_t*)test_pcb_heap_pointer(pcb);
+    while (object < end) {
+        object = term_heap_next(object);
+    }
+    test_assert_true(object == end, "heap walk steps over every map node");
+
+    void* receiver = test_pcb_with_heap(MAP_TEST_HEAP_WORDS);
+    uint64_t copy = term_copy(receiver, map);
+    test_assert_equal(term_size(map) * 8, test_pcb_heap_pointer(receiver) - (uint64_t)*(uint64_t**)((uint8_t*)receiver + PCB_HEAP_BASE_OFFSET),
+                      "copy is term_size words");
+    test_assert_true(term_equal(map, copy), "copied map is equal");
+    memset(base, 0, (size_t)((uint8_t*)end - (uint8_t*)base));
+    test_assert_equal(term_make_int(1990), map_get(copy, term_make_int(199)), "copy stands alone");
+    test_assert_equal(200, map_size(copy), "copy keeps every key");
+    test_pcb_free(pcb);
+
+    // A full heap refuses the update and keeps no part of it
+    void* small = test_pcb_with_heap(1024);
+    uint64_t tiny = map_test_build(small, map_new(small), 0, 10);
+    uint64_t mark = test_pcb_heap_pointer(small);
+    uint64_t grown = tiny;
+    int64_t k = 10;
+    while (grown != TERM_NONE) {
+        tiny = grown;
+        mark = test_pcb_heap_pointer(small);
+        grown = map_put(small, tiny, term_make_int(k), term_make_int(10 * k));
+        k++;
+    }
+    test_assert_equal(mark, test_pcb_heap_pointer(small), "failed put leaves the heap as it was");
+    test_assert_equal(term_make_int(10 * (k - 2)), map_get(tiny, term_make_int(k - 2)), "last good version intact");
+    *(uint64_t*)((uint8_t*)small + PCB_HEAP_LIMIT_OFFSET) = mark;
+    test_assert_equal(TERM_NONE, map_delete(small, tiny, term_make_int(0)), "delete on a full heap");
+    test_assert_equal(tiny, map_delete(small, tiny, term_make_int(-1)), "absent key needs no heap");
+    test_pcb_free(small);
+    test_pcb_free(receiver);
+}
+
+void test_map_main() {
+    printf("=== MAP TEST SUITE ===\n");
+
+    test_map_basics();
+    test_map_many_keys();
+    test_map_persistence();
+    test_map_canonical();
+    test_map_collisions();
+    test_map_heap();
+
+    printf("=== MAP TEST SUITE COMPLETE ===\n");
+}
@@ -0,0 +1,278 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// test_match.c — C test suite for Compiled Receive Matchers
+// ------------------------------------------------------------
+// Tests match.s and _process_block_on_receive_match: single pattern
+// tests (wildcards, type patterns, nested tuples, list tails,
+// binaries), first-match order across keyed and generic clauses,
+// guards, and selective receive from a process's mailbox ring.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern int match_term(uint64_t pattern, uint64_t term);
+extern void* match_compile(const void* clauses, uint64_t count);
+extern uint64_t match_run(void* matcher, uint64_t message);
+extern int match_destroy(void* matcher);
+extern uint64_t process_block_on_receive_match(void* scheduler_states, uint64_t core_id, void* pcb,
+                                               void* matcher, uint64_t* clause_out);
+extern uint64_t term_make_int(int64_t value);
+extern int64_t term_int_value(uint64_t term);
+extern uint64_t term_make_atom(uint64_t index);
+extern uint64_t term_make_pid(uint64_t pid);
+extern uint64_t term_tuple(void* pcb, uint64_t arity);
+extern uint64_t term_element(uint64_t tuple, uint64_t index);
+extern int term_set_element(uint64_t tuple, uint64_t index, uint64_t value);
+extern uint64_t term_cons(void* pcb, uint64_t head, uint64_t tail);
+extern uint64_t term_binary(void* pcb, const uint8_t* data, uint64_t length);
+extern int message_queue_init(void* queue_ptr, uint32_t size);
+extern uint32_t message_queue_size(void* queue_ptr);
+extern int send_message(void* sender_pcb, void* receiver_pcb, uint64_t message_data);
+extern uint64_t try_receive_message(void* receiver_pcb);
+
+// Term and pattern constants (match config.inc)
+#define TERM_NIL 0x14
+#define TERM_PATTERN_ANY 0x54
+#define TERM_PATTERN_INT 0x74
+#define TERM_PATTERN_ATOM 0x94
+#define TERM_PATTERN_TUPLE 0xF4
+#define TERM_PATTERN_LIST 0x114
+#define MATCH_NO_CLAUSE 0xFFFFFFFF
+
+// Process states (match process.s)
+#define PROCESS_STATE_RUNNING 2
+#define PROCESS_STATE_WAITING 3
+
+#define MATCH_TEST_HEAP_WORDS 1024
+#define MATCH_TEST_TAGS 30
+
+// Atom indices used as message tags
+enum { ATOM_PING = 10, ATOM_STOP = 11, ATOM_OTHER = 12, ATOM_TAG_BASE = 100 };
+
+typedef struct {
+    uint64_t pattern;
+    int (*guard)(uint64_t message, uint64_t argument);
+    uint64_t argument;
+} match_clause;
+
+// A PCB with pid 1 and a MATCH_TEST_HEAP_WORDS heap
+static void* match_test_pcb(void) {
+    void* pcb = test_pcb_with_heap(MATCH_TEST_HEAP_WORDS);
+    *(uint64_t*)((uint8_t*)pcb + PCB_PID_OFFSET) = 1;
+    return pcb;
+}
+
+static uint64_t match_pair(void* pcb, uint64_t first, uint64_t second) {
+    uint64_t tuple = term_tuple(pcb, 2);
+    term_set_element(tuple, 0, first);
+    term_set_element(tuple, 1, second);
+    return tuple;
+}
+
+// Guard: the second element is an integer above the argument
+static int match_test_above(uint64_t message, uint64_t argument) {
+    return term_int_value(term_element(message, 1)) > (int64_t)argument;
+}
+
+static void test_match_terms() {
+    printf("\n--- Testing single pattern matches ---\n");
+
+    void* pcb = match_test_pcb();
+    uint64_t ping = term_make_atom(ATOM_PING);
+    uint64_t message = match_pair(pcb, ping, term_make_int(7));
+
+    test_assert_true(match_term(TERM_PATTERN_ANY, message), "wildcard matches a tuple");
+    test_assert_true(match_term(TERM_PATTERN_TUPLE, message), "type pattern matches a tuple");
+    test_assert_true(!match_term(TERM_PATTERN_ATOM, message), "atom pattern rejects a tuple");
+    test_assert_true(match_term(TERM_PATTERN_INT, term_make_int(-3)), "integer type pattern");
+    test_assert_true(match_term(ping, ping), "exact atom");
+    test_assert_true(!match_term(ping, term_make_atom(ATOM_STOP)), "different atom");
+
+    test_assert_true(match_term(match_pair(pcb, ping, TERM_PATTERN_INT), message), "tuple with a type pattern");
+    test_assert_true(!match_term(match_pair(pcb, ping, term_make_int(8)), message), "tuple with a different value");
+    uint64_t triple = term_tuple(pcb, 3);
+    term_set_element(triple, 0, ping);
+    test_assert_true(!match_term(triple, message), "tuple of another arity");
+
+    uint64_t nested = match_pair(pcb, ping, match_pair(pcb, term_make_pid(5), TERM_NIL));
+    test_assert_true(match_term(match_pair(pcb, TERM_PATTERN_ATOM, match_pair(pcb, TERM_PATTERN_ANY, TERM_NIL)), nested),
+                     "nested tuple pattern");
+
+    uint64_t list = term_cons(pcb, term_make_int(1), term_cons(pcb, term_make_int(2), TERM_NIL));
+    test_assert_true(match_term(term_cons(pcb, term_make_int(1), TERM_PATTERN_ANY), list), "list head with any tail");
+    test_assert_true(match_term(term_cons(pcb, TERM_PATTERN_INT, TERM_PATTERN_LIST), list), "list head with list tail");
+    test_assert_true(!match_term(term_cons(pcb, term_make_int(1), TERM_NIL), list), "shorter list pattern");
+
+    uint64_t binary = term_binary(pcb, (const uint8_t*)"hello", 5);
+    test_assert_true(match_term(term_binary(pcb, (const uint8_t*)"hello", 5), binary), "equal binary");
+    test_assert_true(!match_term(term_binary(pcb, (const uint8_t*)"help!", 5), binary), "different binary");
+
+    test_pcb_free(pcb);
+}
+
+static void test_match_dispatch() {
+    printf("\n--- Testing compiled clause dispatch ---\n");
+
+    void* pcb = match_test_pcb();
+    uint64_t ping = term_make_atom(ATOM_PING);
+
+    // {@ping, Int} when Int > 10; {@ping, _}; {@tag_i, _} ...; @stop;
+    // {Atom, _}; _
+    match_clause clauses[MATCH_TEST_TAGS + 5];
+    uint64_t n = 0;
+    clauses[n++] = (match_clause){ match_pair(pcb, ping, TERM_PATTERN_INT), match_test_above, 10 };
+    clauses[n++] = (match_clause){ match_pair(pcb, ping, TERM_PATTERN_ANY), NULL, 0 };
+    for (uint64_t i = 0; i < MATCH_TEST_TAGS; i++) {
+        clauses[n++] = (match_clause){ match_pair(pcb, term_make_atom(ATOM_TAG_BASE + i), TERM_PATTERN_ANY), NULL, 0 };
+    }
+    clauses[n++] = (match_clause){ term_make_atom(ATOM_STOP), NULL, 0 };
+    clauses[n++] = (match_clause){ match_pair(pcb, TERM_PATTERN_ATOM, TERM_PATTERN_ANY), NULL, 0 };
+    clauses[n++] = (match_clause){ TERM_PATTERN_ANY, NULL, 0 };
+
+    void* matcher = match_compile(clauses, n);
+    test_assert_true(matcher != NULL, "compile a responder");
+    test_assert_equal(0, match_run(matcher, match_pair(pcb, ping, term_make_int(50))), "guard accepts");
+    test_assert_equal(1, match_run(matcher, match_pair(pcb, ping, term_make_int(5))), "guard rejects, next clause");
+    test_assert_equal(1, match_run(matcher, match_pair(pcb, ping, term_make_atom(1))), "type pattern fails, next clause");
+    test_assert_equal(2 + 7, match_run(matcher, match_pair(pcb, term_make_atom(ATOM_TAG_BASE + 7), TERM_NIL)),
+                      "tag dispatch");
+    test_assert_equal(2 + MATCH_TEST_TAGS, match_run(matcher, term_make_atom(ATOM_STOP)), "bare atom");
+    test_assert_equal(3 + MATCH_TEST_TAGS, match_run(matcher, match_pair(pcb, term_make_atom(ATOM_OTHER), TERM_NIL)),
+                      "unknown tag falls to the generic clause");
+    test_assert_equal(4 + MATCH_TEST_TAGS, match_run(matcher, term_make_int(42)), "catch-all");
+    test_assert_true(match_destroy(matcher), "destroy");
+
+    // A generic clause before a keyed one still wins
+    match_clause ordered[] = {
+        { match_pair(pcb, TERM_PATTERN_ATOM, TERM_PATTERN_INT), NULL, 0 },
+        { match_pair(pcb, ping, TERM_PATTERN_ANY), NULL, 0 },
+    };
+    matcher = match_compile(ordered, 2);
+    test_assert_equal(0, match_run(matcher, match_pair(pcb, ping, term_make_int(3))), "earlier generic clause wins");
+    test_assert_equal(1, match_run(matcher, match_pair(pcb, ping, TERM_NIL)), "keyed clause after generic");
+    test_assert_equal(MATCH_NO_CLAUSE, match_run(matcher, term_make_atom(ATOM_STOP)), "no clause matches");
+    match_destroy(matcher);
+
+    // Clauses sharing a key keep their order
+    match_clause same_key[] = {
+        { match_pair(pcb, ping, term_make_int(1)), NULL, 0 },
+        { match_pair(pcb, ping, term_make_int(2)), NULL, 0 },
+    };
+    matcher = match_compile(same_key, 2);
+    test_assert_equal(1, match_run(matcher, match_pair(pcb, ping, term_make_int(2))), "second clause of a shared key");
+    match_destroy(matcher);
+
+    test_assert_true(match_compile(NULL, 1) == NULL, "compile without clauses");
+    test_assert_true(match_compile(clauses, 0) == NULL, "compile zero clauses");
+    test_assert_equal(MATCH_NO_CLAUSE, match_run(NULL, ping), "run without a matcher");
+
+    test_pcb_free(pcb);
+}
+
+static void test_match_receive() {
+    printf("\n--- Testing selective receive with a matcher ---\n");
+
+    void* states = scheduler_state_init(1);
+    scheduler_init(states, 0);
+    void* pcb = match_test_pcb();
+    *(uint64_t*)((uint8_t*)pcb + PCB_STATE_OFFSET) = PROCESS_STATE_RUNNING;
+    scheduler_set_current_process_with_state(states, 0, pcb);
+
+    uint64_t ping = term_make_atom(ATOM_PING);
+    match_clause clauses[] = {
+        { match_pair(pcb, ping, TERM_PATTERN_INT), NULL, 0 },
+        { term_make_atom(ATOM_STOP), NULL, 0 },
+    };
+    void* matcher = match_compile(clauses, 2);
+
+    // A real mailbox ring, filled through send_message
+    uint64_t queue[8];
+    memset(queue, 0, sizeof(queue));
+    test_assert_equal(1, message_queue_init(queue, 8), "mailbox init");
+    *(void**)((uint8_t*)pcb + PCB_MESSAGE_QUEUE_OFFSET) = queue;
+
+    // Mailbox: {@other, 1}, @stop, {@other, 2}, {@ping, 9}
+    uint64_t other1 = match_pair(pcb, term_make_atom(ATOM_OTHER), term_make_int(1));
+    uint64_t stop = term_make_atom(ATOM_STOP);
+    uint64_t other2 = match_pair(pcb, term_make_atom(ATOM_OTHER), term_make_int(2));
+    uint64_t ping9 = match_pair(pcb, ping, term_make_int(9));
+    send_message(pcb, pcb, other1);
+    send_message(pcb, pcb, stop);
+    send_message(pcb, pcb, other2);
+    send_message(pcb, pcb, ping9);
+
+    uint64_t clause = MATCH_NO_CLAUSE;
+    uint64_t received = process_block_on_receive_match(states, 0, pcb, matcher, &clause);
+    test_assert_equal(stop, received, "oldest matching message is taken");
+    test_assert_equal(1, clause, "its clause is reported");
+    test_assert_equal(3, message_queue_size(queue), "message removed from the mailbox");
+
+    received = process_block_on_receive_match(states, 0, pcb, matcher, &clause);
+    test_assert_equal(ping9, received, "next matching message");
+    test_assert_equal(0, clause, "tuple clause");
+    test_assert_equal(2, message_queue_size(queue), "mailbox compacted");
+
+    received = process_block_on_receive_match(states, 0, pcb, matcher, NULL);
+    test_assert_equal(0, received, "no match blocks");
+    test_assert_equal(PROCESS_STATE_WAITING, process_get_state(pcb), "process waits on receive");
+    test_assert_true(*(void**)((uint8_t*)pcb + PCB_MESSAGE_PATTERN_OFFSET) == matcher,
+                     "matcher kept in pcb_message_pattern");
+
+    // Skipped messages stay queued in arrival order, and the ring keeps working
+    test_assert_equal(1, send_message(pcb, pcb, stop), "send after compaction");
+    test_assert_equal(other1, try_receive_message(pcb), "first skipped message kept its place");
+    test_assert_equal(other2, try_receive_message(pcb), "second skipped message kept its place");
+    test_assert_equal(stop, try_receive_message(pcb), "later message follows them");
+    test_assert_equal(0, message_queue_size(queue), "mailbox drained");
+
+    test_assert_equal(0, process_block_on_receive_match(states, 0, pcb, NULL, NULL), "receive without a matcher");
+
+    match_destroy(matcher);
+    test_pcb_free(pcb);
+    scheduler_state_destroy(states);
+}
+
+void test_match_main() {
+    printf("=== RECEIVE MATCHER TEST SUITE ===\n");
+
+    test_match_terms();
+    test_match_dispatch();
+    test_match_receive();
+
+    printf("=== RECEIVE MATCHER TEST SUITE COMPLETE ===\n");
+}
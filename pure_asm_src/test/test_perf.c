@@ -0,0 +1,264 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// test_perf.c — C test suite for Hardware Performance Counters
+// ------------------------------------------------------------
+// Tests perf.s: argument checks, phase switching and per-phase
+// totals on this thread, GC attribution, totals in the stats snapshot
+// and OpenMetrics text, and counters opened by a hosted scheduler's
+// main loop on request. Where perf_event_open is missing (macOS) or
+// not permitted (perf_event_paranoid, containers) only the checks that
+// need no counters run.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern int perf_request(void* scheduler_states, uint64_t core_id);
+extern int perf_open(void* scheduler_states, uint64_t core_id);
+extern int perf_close(void* scheduler_states, uint64_t core_id);
+extern uint64_t perf_enter_phase(void* scheduler_states, uint64_t core_id, uint64_t phase);
+extern uint64_t perf_total(void* scheduler_states, uint64_t core_id, uint64_t phase, uint64_t event);
+extern int process_collect_garbage(void* scheduler_states, uint64_t core_id, void* pcb);
+extern uint64_t stats_snapshot_size(uint64_t cores);
+extern int stats_snapshot(void* scheduler_states, uint64_t cores, void* out);
+extern uint64_t stats_format_openmetrics(const void* snapshot, char* buffer, uint64_t capacity);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern void scheduler_init(void* scheduler_states, uint64_t core_id);
+extern int scheduler_wake(void* scheduler_states, uint64_t core_id);
+extern void* host_runtime_start(uint64_t scheduler_count);
+extern void* host_runtime_states(void* runtime);
+extern int host_runtime_stop(void* runtime);
+extern int host_runtime_join(void* runtime);
+
+// Phases and events (match config.inc)
+#define PERF_PHASE_DISPATCH 0
+#define PERF_PHASE_STEAL 1
+#define PERF_PHASE_MESSAGE 2
+#define PERF_PHASE_GC 3
+#define PERF_PHASE_TIMER 4
+#define PERF_PHASE_COUNT 5
+#define PERF_PHASE_NONE 0xFF
+#define PERF_EVENT_CYCLES 0
+#define PERF_EVENT_INSTRUCTIONS 1
+#define PERF_EVENT_COUNT 5
+
+// Snapshot layout (match config.inc)
+#define STATS_HEADER_SIZE 24
+#define STATS_ROW_PERF_ENABLED 72
+#define STATS_ROW_PERF 80
+#define STATS_ROW_SIZE 280
+
+// Scheduler state layout (match scheduler.s)
+extern const uint64_t SCHEDULER_SIZE_CONST;
+#define SCHEDULER_PERF_OFFSET 296
+
+static uint64_t perf_field(void* states, uint64_t core) {
+    return *(volatile uint64_t*)((uint8_t*)states + core * SCHEDULER_SIZE_CONST + SCHEDULER_PERF_OFFSET);
+}
+
+// Enough user-space work to register on every counter
+static uint64_t perf_busy_work(uint64_t rounds) {
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < rounds; i++) {
+        sum += i * 7 + (sum >> 3);
+    }
+    return sum;
+}
+
+// ------------------------------------------------------------
+// Test Perf Arguments
+// ------------------------------------------------------------
+void test_perf_arguments() {
+    printf("--- Testing Perf Arguments ---\n");
+
+    void* states = scheduler_state_init(1);
+    scheduler_init(states, 0);
+
+    test_assert_equal(0, perf_request(NULL, 0), "perf_request_null_states");
+    test_assert_equal(0, perf_request(states, 128), "perf_request_invalid_core");
+    test_assert_equal(0, perf_open(NULL, 0), "perf_open_null_states");
+    test_assert_equal(0, perf_open(states, 128), "perf_open_invalid_core");
+    test_assert_equal(0, perf_close(NULL, 0), "perf_close_null_states");
+    test_assert_equal(1, perf_close(states, 0), "perf_close_not_counting");
+
+    // Without counters, boundaries and totals are inert
+    test_assert_equal(PERF_PHASE_NONE, perf_enter_phase(states, 0, PERF_PHASE_DISPATCH), "perf_enter_not_counting");
+    test_assert_equal(0, perf_total(states, 0, PERF_PHASE_DISPATCH, PERF_EVENT_CYCLES), "perf_total_not_counting");
+    test_assert_equal(0, perf_total(states, 0, PERF_PHASE_COUNT, PERF_EVENT_CYCLES), "perf_total_invalid_phase");
+    test_assert_equal(0, perf_total(states, 0, PERF_PHASE_DISPATCH, PERF_EVENT_COUNT), "perf_total_invalid_event");
+
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Perf Phases
+// ------------------------------------------------------------
+void test_perf_phases() {
+    printf("--- Testing Perf Phases ---\n");
+
+    void* states = scheduler_state_init(2);
+    scheduler_init(states, 0);
+    scheduler_init(states, 1);
+    if (!perf_open(states, 0)) {
+        printf("perf_event_open unavailable; skipping counted phases\n");
+        test_assert_equal(0, perf_field(states, 0), "perf_open_failure_cleared");
+        scheduler_state_destroy(states);
+        return;
+    }
+    test_assert_true(perf_field(states, 0) > 1, "perf_open_block");
+    test_assert_equal(1, perf_open(states, 0), "perf_open_again");
+
+    // Counting starts outside every phase
+    test_assert_equal(PERF_PHASE_NONE, perf_enter_phase(states, 0, PERF_PHASE_DISPATCH), "perf_enter_from_none");
+    perf_busy_work(100000);
+    test_assert_equal(PERF_PHASE_DISPATCH, perf_enter_phase(states, 0, PERF_PHASE_STEAL), "perf_enter_from_dispatch");
+    perf_busy_work(1000);
+    test_assert_equal(PERF_PHASE_STEAL, perf_enter_phase(states, 0, PERF_PHASE_NONE), "perf_enter_from_steal");
+
+    uint64_t dispatch_cycles = perf_total(states, 0, PERF_PHASE_DISPATCH, PERF_EVENT_CYCLES);
+    uint64_t dispatch_instructions = perf_total(states, 0, PERF_PHASE_DISPATCH, PERF_EVENT_INSTRUCTIONS);
+    test_assert_true(dispatch_cycles > 0, "perf_dispatch_cycles");
+    test_assert_true(dispatch_instructions > 100000, "perf_dispatch_instructions");
+    test_assert_true(perf_total(states, 0, PERF_PHASE_STEAL, PERF_EVENT_INSTRUCTIONS) < dispatch_instructions,
+                     "perf_steal_instructions_smaller");
+
+    // Work outside a phase is not counted
+    perf_busy_work(100000);
+    perf_enter_phase(states, 0, PERF_PHASE_NONE);
+    test_assert_equal(dispatch_cycles, perf_total(states, 0, PERF_PHASE_DISPATCH, PERF_EVENT_CYCLES), "perf_none_not_counted");
+
+    // Collection is its own phase and the interrupted phase resumes
+    uint8_t* pcb = calloc(1, PCB_SIZE);
+    uint8_t heap[64];
+    *(uint64_t*)(pcb + PCB_HEAP_BASE_OFFSET) = (uint64_t)(uintptr_t)heap;
+    *(uint64_t*)(pcb + PCB_HEAP_POINTER_OFFSET) = (uint64_t)(uintptr_t)(heap + 48);
+    perf_enter_phase(states, 0, PERF_PHASE_MESSAGE);
+    test_assert_equal(1, process_collect_garbage(states, 0, pcb), "perf_gc_ran");
+    test_assert_true(perf_total(states, 0, PERF_PHASE_GC, PERF_EVENT_INSTRUCTIONS) > 0, "perf_gc_instructions");
+    test_assert_equal(PERF_PHASE_MESSAGE, perf_enter_phase(states, 0, PERF_PHASE_NONE), "perf_gc_phase_resumed");
+
+    // Snapshot rows carry the totals of counting schedulers only
+    uint8_t* snapshot = calloc(1, stats_snapshot_size(2));
+    test_assert_equal(1, stats_snapshot(states, 2, snapshot), "perf_snapshot_ok");
+    uint8_t* totals = snapshot + STATS_HEADER_SIZE;
+    uint8_t* row0 = totals + STATS_ROW_SIZE;
+    uint8_t* row1 = row0 + STATS_ROW_SIZE;
+    test_assert_equal(1, *(uint64_t*)(row0 + STATS_ROW_PERF_ENABLED), "perf_snapshot_core0_enabled");
+    test_assert_equal(0, *(uint64_t*)(row1 + STATS_ROW_PERF_ENABLED), "perf_snapshot_core1_disabled");
+    test_assert_equal(1, *(uint64_t*)(totals + STATS_ROW_PERF_ENABLED), "perf_snapshot_total_enabled");
+    uint64_t index = PERF_PHASE_DISPATCH * PERF_EVENT_COUNT + PERF_EVENT_CYCLES;
+    test_assert_equal(dispatch_cycles, *(uint64_t*)(row0 + STATS_ROW_PERF + index * 8), "perf_snapshot_dispatch_cycles");
+    test_assert_equal(dispatch_cycles, *(uint64_t*)(totals + STATS_ROW_PERF + index * 8), "perf_snapshot_total_cycles");
+
+    char* text = calloc(1, 16384);
+    uint64_t length = stats_format_openmetrics(snapshot, text, 16383);
+    test_assert_true(length > 0, "perf_openmetrics_written");
+    test_assert_true(strstr(text, "# TYPE actly_scheduler_perf_events counter\n") != NULL, "perf_openmetrics_type");
+    char expected[160];
+    snprintf(expected, sizeof(expected),
+             "actly_scheduler_perf_events_total{scheduler=\"0\",phase=\"dispatch\",event=\"cycles\"} %llu\n",
+             (unsigned long long)dispatch_cycles);
+    test_assert_true(strstr(text, expected) != NULL, "perf_openmetrics_sample");
+    test_assert_true(strstr(text, "{scheduler=\"0\",phase=\"timer\",event=\"branch_misses\"}") != NULL,
+                     "perf_openmetrics_last_label");
+    test_assert_true(strstr(text, "{scheduler=\"1\",phase=") == NULL, "perf_openmetrics_only_counting");
+
+    test_assert_equal(1, perf_close(states, 0), "perf_close");
+    test_assert_equal(0, perf_field(states, 0), "perf_close_cleared");
+    test_assert_equal(0, perf_total(states, 0, PERF_PHASE_DISPATCH, PERF_EVENT_CYCLES), "perf_total_after_close");
+
+    free(text);
+    free(snapshot);
+    free(pcb);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Perf Main Loop
+// ------------------------------------------------------------
+void test_perf_main_loop() {
+    printf("--- Testing Perf Main Loop ---\n");
+
+    void* runtime = host_runtime_start(1);
+    test_assert_true(runtime != NULL, "perf_loop_runtime_started");
+    if (runtime == NULL) {
+        return;
+    }
+    void* states = host_runtime_states(runtime);
+
+    if (!perf_request(states, 0)) {
+        printf("perf_event_open unavailable; skipping main loop counters\n");
+        test_assert_equal(0, perf_field(states, 0), "perf_loop_not_requested");
+    } else {
+        // The scheduler opens its counters on its next pass
+        scheduler_wake(states, 0);
+        for (int i = 0; i < 1000 && perf_field(states, 0) == 1; i++) {
+            usleep(1000);
+        }
+        if (perf_field(states, 0) == 0) {
+            printf("perf_event_open not permitted; skipping main loop counters\n");
+        } else {
+            test_assert_true(perf_field(states, 0) > 1, "perf_loop_opened");
+            // Each wake is one more pass through every phase boundary
+            for (int i = 0; i < 1000 && (perf_total(states, 0, PERF_PHASE_TIMER, PERF_EVENT_INSTRUCTIONS) == 0 ||
+                                         perf_total(states, 0, PERF_PHASE_DISPATCH, PERF_EVENT_INSTRUCTIONS) == 0);
+                 i++) {
+                scheduler_wake(states, 0);
+                usleep(1000);
+            }
+            test_assert_true(perf_total(states, 0, PERF_PHASE_TIMER, PERF_EVENT_INSTRUCTIONS) > 0, "perf_loop_timer_phase");
+            test_assert_true(perf_total(states, 0, PERF_PHASE_DISPATCH, PERF_EVENT_INSTRUCTIONS) > 0, "perf_loop_dispatch_phase");
+        }
+    }
+
+    // Join closes the counters with the rest of the runtime
+    test_assert_equal(1, host_runtime_stop(runtime), "perf_loop_stop");
+    test_assert_equal(1, host_runtime_join(runtime), "perf_loop_join");
+}
+
+// ------------------------------------------------------------
+// Main Perf Test Function
+// ------------------------------------------------------------
+void test_perf_main() {
+    printf("=== PERF COUNTER TEST SUITE ===\n");
+
+    test_perf_arguments();
+    test_perf_phases();
+    test_perf_main_loop();
+
+    printf("=== PERF COUNTER TEST SUITE COMPLETE ===\n");
+}
@@ -0,0 +1,503 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// test_pipeline.c — C test suite for Fused Template Pipelines
+// ------------------------------------------------------------
+// Tests pipeline.s: chain validation, fused and unfused chains giving
+// the same results as C, a fused Map, Filter, Reduce chain allocating
+// nothing, FindIn stopping at its first match, Zip, the caller's
+// literals, Filter and FindIn testing a set, and fused chains yielding
+// and resuming.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern void* pipeline_load(const void* stages, uint64_t count, const uint64_t* literals, uint64_t literal_count, int fused);
+extern int interp_program_destroy(void* program);
+extern int interp_frame_init(void* frame, void* program, void* pcb);
+extern int interp_set_register(void* frame, uint64_t index, uint64_t term);
+extern uint64_t interp_run(void* scheduler_states, uint64_t core_id, void* frame);
+extern uint64_t interp_result(void* frame);
+extern uint64_t term_make_int(int64_t value);
+extern int64_t term_int_value(uint64_t term);
+extern uint64_t term_cons(void* pcb, uint64_t head, uint64_t tail);
+extern uint64_t term_head(uint64_t list);
+extern uint64_t term_tail(uint64_t list);
+extern void* set_create(uint64_t max_keys);
+extern int set_destroy(void* set);
+extern int set_insert(void* set, uint64_t key);
+extern int set_freeze(void* set);
+extern uint64_t set_term(void* pcb, void* set);
+
+// Bytecode, term and pipeline constants (match config.inc)
+enum {
+    OP_HALT, OP_MOVE, OP_LOADK, OP_LOADI, OP_ADD, OP_SUB, OP_MUL, OP_ADDI,
+    OP_JMP, OP_JEQ, OP_JNE, OP_JLT, OP_JGE, OP_NEXT, OP_CONS, OP_REVERSE,
+    OP_TUPLE, OP_GETEL, OP_SETEL, OP_UPDATE, OP_CALL, OP_RET, OP_SEND, OP_MEMBER, OP_COUNT
+};
+enum {
+    STAGE_MAP, STAGE_FILTER, STAGE_ZIP, STAGE_FINDIN, STAGE_REDUCE
+};
+#define INTERP_DONE 0
+#define INTERP_YIELD 1
+#define INTERP_FRAME_SIZE 448
+#define PIPELINE_MAX_STAGES 8
+#define PIPELINE_MAX_CODE 0x8000
+#define TERM_NIL 0x14
+#define PIPELINE_TEST_BUDGET 1000000
+
+// Instruction words: registers A, B, C or registers A, B and a signed K
+#define ABC(op, a, b, c) ((uint32_t)(op) | (uint32_t)(a) << 8 | (uint32_t)(b) << 12 | (uint32_t)(c) << 16)
+#define ABK(op, a, b, k) ((uint32_t)(op) | (uint32_t)(a) << 8 | (uint32_t)(b) << 12 | (uint32_t)(uint16_t)(k) << 16)
+
+#define PIPELINE_TEST_HEAP_WORDS 16384
+
+// A stage as pipeline_load reads it (PIPELINE_STAGE_SIZE bytes)
+typedef struct {
+    uint64_t kind;
+    const uint32_t* body;
+    uint64_t body_count;
+} pipeline_test_stage;
+
+typedef struct {
+    uint64_t frame[INTERP_FRAME_SIZE / 8];
+    void* states;
+    void* pcb;
+} pipeline_test_context;
+
+// What one run of a pipeline cost
+typedef struct {
+    uint64_t status;
+    uint64_t result;
+    uint64_t reductions;
+    uint64_t heap_words;
+    uint64_t yields;
+} pipeline_test_run_info;
+
+// Map: r2 = r2 * 2
+static const uint32_t pipeline_test_double[] = {
+    ABK(OP_LOADI, 8, 0, 2),
+    ABC(OP_MUL, 2, 2, 8),
+    ABC(OP_RET, 0, 0, 0),
+};
+
+// Filter: r3 = r2 > 10
+static const uint32_t pipeline_test_above_ten[] = {
+    ABK(OP_LOADI, 3, 0, 0),
+    ABK(OP_LOADI, 8, 0, 10),
+    ABK(OP_JGE, 8, 2, 1),                 // -> 4
+    ABK(OP_LOADI, 3, 0, 1),
+    ABC(OP_RET, 0, 0, 0),
+};
+
+// FindIn: r3 = r2 >= 25
+static const uint32_t pipeline_test_at_least_25[] = {
+    ABK(OP_LOADI, 3, 0, 0),
+    ABK(OP_LOADI, 8, 0, 25),
+    ABK(OP_JLT, 2, 8, 1),                 // -> 4
+    ABK(OP_LOADI, 3, 0, 1),
+    ABC(OP_RET, 0, 0, 0),
+};
+
+// Reduce: r1 = r1 + r2
+static const uint32_t pipeline_test_sum[] = {
+    ABC(OP_ADD, 1, 1, 2),
+    ABC(OP_RET, 0, 0, 0),
+};
+
+// Map over Zip pairs: r2 = element 0 * element 1
+static const uint32_t pipeline_test_product[] = {
+    ABK(OP_GETEL, 8, 2, 0),
+    ABK(OP_GETEL, 9, 2, 1),
+    ABC(OP_MUL, 2, 8, 9),
+    ABC(OP_RET, 0, 0, 0),
+};
+
+// Map: r2 = r2 + literal 0
+static const uint32_t pipeline_test_offset[] = {
+    ABK(OP_LOADK, 8, 0, 0),
+    ABC(OP_ADD, 2, 2, 8),
+    ABC(OP_RET, 0, 0, 0),
+};
+
+// Filter or FindIn: r3 = r2 in the set handle literal 0
+static const uint32_t pipeline_test_in_set[] = {
+    ABK(OP_LOADK, 8, 0, 0),
+    ABC(OP_MEMBER, 3, 2, 8),
+    ABC(OP_RET, 0, 0, 0),
+};
+
+static const pipeline_test_stage pipeline_test_map_filter[] = {
+    { STAGE_MAP, pipeline_test_double, 3 },
+    { STAGE_FILTER, pipeline_test_above_ten, 5 },
+};
+
+static const pipeline_test_stage pipeline_test_map_filter_reduce[] = {
+    { STAGE_MAP, pipeline_test_double, 3 },
+    { STAGE_FILTER, pipeline_test_above_ten, 5 },
+    { STAGE_REDUCE, pipeline_test_sum, 2 },
+};
+
+static const pipeline_test_stage pipeline_test_map_findin[] = {
+    { STAGE_MAP, pipeline_test_double, 3 },
+    { STAGE_FINDIN, pipeline_test_at_least_25, 5 },
+};
+
+static const pipeline_test_stage pipeline_test_zip_map[] = {
+    { STAGE_ZIP, NULL, 0 },
+    { STAGE_MAP, pipeline_test_product, 4 },
+};
+
+static const pipeline_test_stage pipeline_test_zip_map_reduce[] = {
+    { STAGE_ZIP, NULL, 0 },
+    { STAGE_MAP, pipeline_test_product, 4 },
+    { STAGE_REDUCE, pipeline_test_sum, 2 },
+};
+
+static const pipeline_test_stage pipeline_test_map_filter_set[] = {
+    { STAGE_MAP, pipeline_test_double, 3 },
+    { STAGE_FILTER, pipeline_test_in_set, 3 },
+};
+
+static const pipeline_test_stage pipeline_test_map_findin_set[] = {
+    { STAGE_MAP, pipeline_test_double, 3 },
+    { STAGE_FINDIN, pipeline_test_in_set, 3 },
+};
+
+static void pipeline_test_setup(pipeline_test_context* ctx) {
+    ctx->states = scheduler_state_init(1);
+    scheduler_init(ctx->states, 0);
+    ctx->pcb = test_pcb_with_heap(PIPELINE_TEST_HEAP_WORDS);
+}
+
+static void pipeline_test_teardown(pipeline_test_context* ctx) {
+    test_pcb_free(ctx->pcb);
+    scheduler_state_destroy(ctx->states);
+}
+
+// [first, first + 1, ..., first + count - 1]
+static uint64_t pipeline_test_list(void* pcb, int64_t first, int64_t count) {
+    uint64_t list = TERM_NIL;
+    for (int64_t i = count - 1; i >= 0; i--) {
+        list = term_cons(pcb, term_make_int(first + i), list);
+    }
+    return list;
+}
+
+// Is list exactly the count integers in expected?
+static int pipeline_test_list_is(uint64_t list, const int64_t* expected, uint64_t count) {
+    for (uint64_t i = 0; i < count; i++) {
+        if (list == TERM_NIL || term_int_value(term_head(list)) != expected[i]) {
+            return 0;
+        }
+        list = term_tail(list);
+    }
+    return list == TERM_NIL;
+}
+
+// Load a pipeline, run it on input (r0), zip (r4) and result (r1) with
+// a fresh budget of budget reductions per run until it stops yielding,
+// and destroy it; the status is 0xFF if it fails to load
+static pipeline_test_run_info pipeline_test_run(pipeline_test_context* ctx, const pipeline_test_stage* stages,
+                                                uint64_t count, const uint64_t* literals, uint64_t literal_count,
+                                                int fused, uint64_t input, uint64_t zip, uint64_t result,
+                                                uint64_t budget) {
+    pipeline_test_run_info info = { 0xFF, 0, 0, 0, 0 };
+    void* program = pipeline_load(stages, count, literals, literal_count, fused);
+    if (program == NULL) {
+        return info;
+    }
+    interp_frame_init(ctx->frame, program, ctx->pcb);
+    interp_set_register(ctx->frame, 0, input);
+    interp_set_register(ctx->frame, 1, result);
+    interp_set_register(ctx->frame, 4, zip);
+    uint64_t heap = test_pcb_heap_pointer(ctx->pcb);
+    for (;;) {
+        scheduler_set_reduction_count_with_state(ctx->states, 0, budget);
+        info.status = interp_run(ctx->states, 0, ctx->frame);
+        info.reductions += budget - scheduler_get_reduction_count_with_state(ctx->states, 0);
+        if (info.status != INTERP_YIELD) {
+            break;
+        }
+        info.yields++;
+    }
+    info.heap_words = (test_pcb_heap_pointer(ctx->pcb) - heap) / 8;
+    info.result = interp_result(ctx->frame);
+    interp_program_destroy(program);
+    return info;
+}
+
+static void test_pipeline_validation() {
+    printf("\n--- Testing pipeline validation ---\n");
+
+    pipeline_test_stage stages[PIPELINE_MAX_STAGES + 1];
+    for (int i = 0; i <= PIPELINE_MAX_STAGES; i++) {
+        stages[i] = (pipeline_test_stage){ STAGE_MAP, pipeline_test_double, 3 };
+    }
+    uint64_t literal = term_make_int(1);
+
+    test_assert_true(pipeline_load(NULL, 1, NULL, 0, 1) == NULL, "no stages");
+    test_assert_true(pipeline_load(stages, 0, NULL, 0, 1) == NULL, "empty chain");
+    test_assert_true(pipeline_load(stages, PIPELINE_MAX_STAGES + 1, NULL, 0, 1) == NULL, "too many stages");
+    test_assert_true(pipeline_load(stages, 1, NULL, 1, 1) == NULL, "literal count without literals");
+    test_assert_true(pipeline_load(stages, 1, &literal, 0x10000, 1) == NULL, "too many literals");
+
+    void* program = pipeline_load(stages, PIPELINE_MAX_STAGES, NULL, 0, 1);
+    test_assert_true(program != NULL, "longest chain loads");
+    interp_program_destroy(program);
+    program = pipeline_load(stages, PIPELINE_MAX_STAGES, NULL, 0, 0);
+    test_assert_true(program != NULL, "longest chain loads unfused");
+    interp_program_destroy(program);
+
+    pipeline_test_stage chain[3] = {
+        { STAGE_MAP, pipeline_test_double, 3 },
+        { STAGE_REDUCE, pipeline_test_sum, 2 },
+        { STAGE_MAP, pipeline_test_double, 3 },
+    };
+    test_assert_true(pipeline_load(chain, 3, NULL, 0, 1) == NULL, "Reduce before the last stage");
+    chain[1].kind = STAGE_FINDIN;
+    test_assert_true(pipeline_load(chain, 3, NULL, 0, 0) == NULL, "FindIn before the last stage");
+    chain[1].kind = STAGE_REDUCE + 1;
+    test_assert_true(pipeline_load(chain, 3, NULL, 0, 1) == NULL, "unknown stage kind");
+    chain[0].kind = STAGE_ZIP;
+    chain[1].kind = STAGE_ZIP;
+    test_assert_true(pipeline_load(chain, 3, NULL, 0, 1) == NULL, "two Zips");
+    chain[1] = (pipeline_test_stage){ STAGE_FILTER, NULL, 5 };
+    test_assert_true(pipeline_load(chain, 3, NULL, 0, 1) == NULL, "stage without a body");
+    chain[1] = (pipeline_test_stage){ STAGE_FILTER, pipeline_test_above_ten, 0 };
+    test_assert_true(pipeline_load(chain, 3, NULL, 0, 1) == NULL, "empty body");
+    chain[1] = (pipeline_test_stage){ STAGE_FILTER, pipeline_test_above_ten, PIPELINE_MAX_CODE };
+    test_assert_true(pipeline_load(chain, 3, NULL, 0, 1) == NULL, "body too long");
+
+    // Bodies are checked with the rest of the program by interp_load
+    static const uint32_t bad_body[] = { ABC(OP_COUNT, 0, 0, 0), ABC(OP_RET, 0, 0, 0) };
+    chain[1] = (pipeline_test_stage){ STAGE_FILTER, bad_body, 2 };
+    test_assert_true(pipeline_load(chain, 3, NULL, 0, 1) == NULL, "invalid body");
+    static const uint32_t far_body[] = { ABK(OP_LOADK, 8, 0, 2), ABC(OP_RET, 0, 0, 0) };
+    chain[1] = (pipeline_test_stage){ STAGE_MAP, far_body, 2 };
+    test_assert_true(pipeline_load(chain, 2, &literal, 1, 1) == NULL, "body LOADK past the literals");
+}
+
+static void test_pipeline_collect() {
+    printf("\n--- Testing Map and Filter chains ---\n");
+
+    pipeline_test_context ctx;
+    pipeline_test_setup(&ctx);
+
+    // [X * 2 || X <- 1..20, X * 2 > 10]
+    int64_t expected[20];
+    uint64_t expected_count = 0;
+    for (int64_t x = 1; x <= 20; x++) {
+        if (x * 2 > 10) {
+            expected[expected_count++] = x * 2;
+        }
+    }
+    uint64_t input = pipeline_test_list(ctx.pcb, 1, 20);
+    pipeline_test_run_info fused = pipeline_test_run(&ctx, pipeline_test_map_filter, 2, NULL, 0, 1,
+                                                     input, TERM_NIL, TERM_NIL, PIPELINE_TEST_BUDGET);
+    test_assert_equal(INTERP_DONE, fused.status, "fused Map, Filter finishes");
+    test_assert_true(pipeline_test_list_is(fused.result, expected, expected_count), "fused Map, Filter result");
+    pipeline_test_run_info unfused = pipeline_test_run(&ctx, pipeline_test_map_filter, 2, NULL, 0, 0,
+                                                       input, TERM_NIL, TERM_NIL, PIPELINE_TEST_BUDGET);
+    test_assert_equal(INTERP_DONE, unfused.status, "unfused Map, Filter finishes");
+    test_assert_true(pipeline_test_list_is(unfused.result, expected, expected_count), "unfused Map, Filter result");
+    test_assert_true(fused.heap_words < unfused.heap_words, "fused builds no intermediate list");
+
+    // Empty input
+    fused = pipeline_test_run(&ctx, pipeline_test_map_filter, 2, NULL, 0, 1,
+                              TERM_NIL, TERM_NIL, TERM_NIL, PIPELINE_TEST_BUDGET);
+    test_assert_equal(TERM_NIL, fused.result, "fused chain over []");
+    unfused = pipeline_test_run(&ctx, pipeline_test_map_filter, 2, NULL, 0, 0,
+                                TERM_NIL, TERM_NIL, TERM_NIL, PIPELINE_TEST_BUDGET);
+    test_assert_equal(TERM_NIL, unfused.result, "unfused chain over []");
+
+    // The caller's literals stay at their indices
+    uint64_t literal = term_make_int(1000);
+    pipeline_test_stage offset = { STAGE_MAP, pipeline_test_offset, 3 };
+    int64_t offsets[3] = { 1001, 1002, 1003 };
+    input = pipeline_test_list(ctx.pcb, 1, 3);
+    fused = pipeline_test_run(&ctx, &offset, 1, &literal, 1, 1, input, TERM_NIL, TERM_NIL, PIPELINE_TEST_BUDGET);
+    test_assert_true(pipeline_test_list_is(fused.result, offsets, 3), "fused body reads a literal");
+    unfused = pipeline_test_run(&ctx, &offset, 1, &literal, 1, 0, input, TERM_NIL, TERM_NIL, PIPELINE_TEST_BUDGET);
+    test_assert_true(pipeline_test_list_is(unfused.result, offsets, 3), "unfused body reads a literal");
+
+    pipeline_test_teardown(&ctx);
+}
+
+static void test_pipeline_reduce() {
+    printf("\n--- Testing Reduce chains ---\n");
+
+    pipeline_test_context ctx;
+    pipeline_test_setup(&ctx);
+
+    int64_t sum = 0;
+    for (int64_t x = 1; x <= 100; x++) {
+        sum += x * 2 > 10 ? x * 2 : 0;
+    }
+    uint64_t input = pipeline_test_list(ctx.pcb, 1, 100);
+    pipeline_test_run_info fused = pipeline_test_run(&ctx, pipeline_test_map_filter_reduce, 3, NULL, 0, 1,
+                                                     input, TERM_NIL, term_make_int(0), PIPELINE_TEST_BUDGET);
+    test_assert_equal(INTERP_DONE, fused.status, "fused Map, Filter, Reduce finishes");
+    test_assert_equal(sum, term_int_value(fused.result), "fused Map, Filter, Reduce result");
+    test_assert_equal(0, fused.heap_words, "fused Map, Filter, Reduce allocates nothing");
+
+    pipeline_test_run_info unfused = pipeline_test_run(&ctx, pipeline_test_map_filter_reduce, 3, NULL, 0, 0,
+                                                       input, TERM_NIL, term_make_int(0), PIPELINE_TEST_BUDGET);
+    test_assert_equal(INTERP_DONE, unfused.status, "unfused Map, Filter, Reduce finishes");
+    test_assert_equal(sum, term_int_value(unfused.result), "unfused Map, Filter, Reduce result");
+    test_assert_true(unfused.heap_words > 0, "unfused builds a list per pass");
+    test_assert_true(fused.reductions < unfused.reductions, "fused takes fewer reductions");
+
+    // A budget of a few reductions yields all through the loop and resumes
+    pipeline_test_run_info yielding = pipeline_test_run(&ctx, pipeline_test_map_filter_reduce, 3, NULL, 0, 1,
+                                                        input, TERM_NIL, term_make_int(0), 7);
+    test_assert_equal(INTERP_DONE, yielding.status, "yielding fused chain finishes");
+    test_assert_true(yielding.yields > 100, "fused chain yields");
+    test_assert_equal(sum, term_int_value(yielding.result), "result across yields");
+    test_assert_equal(fused.reductions, yielding.reductions, "same reductions across yields");
+
+    pipeline_test_teardown(&ctx);
+}
+
+static void test_pipeline_findin() {
+    printf("\n--- Testing FindIn chains ---\n");
+
+    pipeline_test_context ctx;
+    pipeline_test_setup(&ctx);
+
+    // First X * 2 >= 25 of 1..1000 is 26, the 13th element
+    uint64_t input = pipeline_test_list(ctx.pcb, 1, 1000);
+    uint64_t none = term_make_int(-1);
+    pipeline_test_run_info fused = pipeline_test_run(&ctx, pipeline_test_map_findin, 2, NULL, 0, 1,
+                                                     input, TERM_NIL, none, PIPELINE_TEST_BUDGET);
+    test_assert_equal(INTERP_DONE, fused.status, "fused FindIn finishes");
+    test_assert_equal(26, term_int_value(fused.result), "fused FindIn match");
+    test_assert_equal(0, fused.heap_words, "fused FindIn allocates nothing");
+    test_assert_true(fused.reductions < 13 * 16, "fused FindIn stops at the match");
+
+    pipeline_test_run_info unfused = pipeline_test_run(&ctx, pipeline_test_map_findin, 2, NULL, 0, 0,
+                                                       input, TERM_NIL, none, PIPELINE_TEST_BUDGET);
+    test_assert_equal(26, term_int_value(unfused.result), "unfused FindIn match");
+    test_assert_true(unfused.reductions > 1000 * 4, "unfused FindIn maps the whole input");
+    test_assert_true(unfused.heap_words >= 2000, "unfused FindIn builds the mapped list");
+
+    // No match leaves the default
+    input = pipeline_test_list(ctx.pcb, 1, 12);
+    fused = pipeline_test_run(&ctx, pipeline_test_map_findin, 2, NULL, 0, 1,
+                              input, TERM_NIL, none, PIPELINE_TEST_BUDGET);
+    test_assert_equal(none, fused.result, "fused FindIn without a match");
+    unfused = pipeline_test_run(&ctx, pipeline_test_map_findin, 2, NULL, 0, 0,
+                                input, TERM_NIL, none, PIPELINE_TEST_BUDGET);
+    test_assert_equal(none, unfused.result, "unfused FindIn without a match");
+
+    pipeline_test_teardown(&ctx);
+}
+
+static void test_pipeline_zip() {
+    printf("\n--- Testing Zip chains ---\n");
+
+    pipeline_test_context ctx;
+    pipeline_test_setup(&ctx);
+
+    // [A * B || {A, B} <- zip(1..5, 10..13)], stopping with the shorter
+    int64_t expected[4] = { 10, 22, 36, 52 };
+    uint64_t a = pipeline_test_list(ctx.pcb, 1, 5);
+    uint64_t b = pipeline_test_list(ctx.pcb, 10, 4);
+    for (int fused = 1; fused >= 0; fused--) {
+        pipeline_test_run_info info = pipeline_test_run(&ctx, pipeline_test_zip_map, 2, NULL, 0, fused,
+                                                        a, b, TERM_NIL, PIPELINE_TEST_BUDGET);
+        test_assert_equal(INTERP_DONE, info.status, fused ? "fused Zip, Map finishes" : "unfused Zip, Map finishes");
+        test_assert_true(pipeline_test_list_is(info.result, expected, 4),
+                         fused ? "fused Zip, Map result" : "unfused Zip, Map result");
+        info = pipeline_test_run(&ctx, pipeline_test_zip_map_reduce, 3, NULL, 0, fused,
+                                 b, a, term_make_int(0), PIPELINE_TEST_BUDGET);
+        test_assert_equal(120, term_int_value(info.result),
+                          fused ? "fused Zip, Map, Reduce result" : "unfused Zip, Map, Reduce result");
+    }
+
+    pipeline_test_teardown(&ctx);
+}
+
+static void test_pipeline_sets() {
+    printf("\n--- Testing Filter and FindIn against a set ---\n");
+
+    pipeline_test_context ctx;
+    pipeline_test_setup(&ctx);
+    void* wanted = set_create(8);
+    set_insert(wanted, term_make_int(40));
+    set_insert(wanted, term_make_int(20));
+    set_insert(wanted, term_make_int(30));
+    set_insert(wanted, term_make_int(7));
+    set_freeze(wanted);
+    uint64_t handle = set_term(ctx.pcb, wanted);
+
+    // [X * 2 || X <- 1..100, X * 2 in {40, 20, 30, 7}], then the first
+    int64_t expected[3] = { 20, 30, 40 };
+    uint64_t input = pipeline_test_list(ctx.pcb, 1, 100);
+    uint64_t none = term_make_int(-1);
+    for (int fused = 1; fused >= 0; fused--) {
+        pipeline_test_run_info info = pipeline_test_run(&ctx, pipeline_test_map_filter_set, 2, &handle, 1, fused,
+                                                        input, TERM_NIL, TERM_NIL, PIPELINE_TEST_BUDGET);
+        test_assert_equal(INTERP_DONE, info.status, fused ? "fused set Filter finishes" : "unfused set Filter finishes");
+        test_assert_true(pipeline_test_list_is(info.result, expected, 3),
+                         fused ? "fused set Filter result" : "unfused set Filter result");
+        info = pipeline_test_run(&ctx, pipeline_test_map_findin_set, 2, &handle, 1, fused,
+                                 input, TERM_NIL, none, PIPELINE_TEST_BUDGET);
+        test_assert_equal(20, term_int_value(info.result),
+                          fused ? "fused set FindIn match" : "unfused set FindIn match");
+        info = pipeline_test_run(&ctx, pipeline_test_map_findin_set, 2, &handle, 1, fused,
+                                 pipeline_test_list(ctx.pcb, 1, 9), TERM_NIL, none, PIPELINE_TEST_BUDGET);
+        test_assert_equal(none, info.result,
+                          fused ? "fused set FindIn without a match" : "unfused set FindIn without a match");
+    }
+
+    set_destroy(wanted);
+    pipeline_test_teardown(&ctx);
+}
+
+void test_pipeline_main() {
+    printf("=== FUSED TEMPLATE PIPELINE TEST SUITE ===\n");
+
+    test_pipeline_validation();
+    test_pipeline_collect();
+    test_pipeline_reduce();
+    test_pipeline_findin();
+    test_pipeline_zip();
+    test_pipeline_sets();
+
+    printf("=== FUSED TEMPLATE PIPELINE TEST SUITE COMPLETE ===\n");
+}
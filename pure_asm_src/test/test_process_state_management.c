@@ -74,16 +74,16 @@ typedef struct {
     uint64_t last_scheduled; // Offset 376: Last scheduled timestamp (8 bytes)
     uint64_t affinity_mask; // Offset 384: CPU affinity mask (8 bytes)
     uint64_t migration_count; // Offset 392: Migration count (8 bytes)
-    uint64_t stack_pointer;   // Offset 400: Current stack pointer (bump allocator) (8 bytes)
-    uint64_t stack_limit;     // Offset 408: Stack limit (8 bytes)
-    uint64_t heap_pointer;   // Offset 416: Current heap pointer (bump allocator) (8 bytes)
-    uint64_t heap_limit;      // Offset 424: Heap limit (8 bytes)
-    uint64_t blocking_reason; // Offset 432: Blocking reason code (8 bytes)
-    uint64_t blocking_data;   // Offset 440: Blocking-specific data (8 bytes)
-    uint64_t wake_time;       // Offset 448: Timer wake time (8 bytes)
-    uint64_t message_pattern; // Offset 456: Receive pattern (8 bytes)
-    uint64_t pcb_size;        // Offset 464: Total PCB size (8 bytes)
-    uint64_t padding[6];      // Offset 472: Padding to align to 512 bytes (48 bytes)
+    uint64_t last_migration_time; // Offset 400: Last migration timestamp (8 bytes)
+    uint64_t stack_pointer;   // Offset 408: Current stack pointer (bump allocator) (8 bytes)
+    uint64_t stack_limit;     // Offset 416: Stack limit (8 bytes)
+    uint64_t heap_pointer;   // Offset 424: Current heap pointer (bump allocator) (8 bytes)
+    uint64_t heap_limit;      // Offset 432: Heap limit (8 bytes)
+    uint64_t blocking_reason; // Offset 440: Blocking reason code (8 bytes)
+    uint64_t blocking_data;   // Offset 448: Blocking-specific data (8 bytes)
+    uint64_t wake_time;       // Offset 456: Timer wake time (8 bytes)
+    uint64_t message_pattern; // Offset 464: Receive pattern (8 bytes)
+    uint64_t profile[5];      // Offset 472: Profiling counters (40 bytes)
     // Total size: 512 bytes (matches PCB_SIZE)
 } mock_process_t;
 
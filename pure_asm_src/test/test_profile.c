@@ -0,0 +1,302 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// test_profile.c — C test suite for Per-Process Profiling
+// ------------------------------------------------------------
+// Tests the PCB profiling counters and profile.s: CPU ticks and
+// reductions charged when a process leaves the core, dispatch and
+// per-reason block counts, reset, top-K selection, and PC samples
+// taken at reduction checks into the trace ring.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern uint64_t profile_get(void* pcb, uint64_t metric);
+extern int profile_reset(void* pcb);
+extern uint64_t profile_top_k(void** pcbs, uint64_t count, uint64_t metric, uint64_t k, void** out);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern void scheduler_init(void* scheduler_states, uint64_t core_id);
+extern int scheduler_enqueue_process(void* scheduler_states, uint64_t core_id, void* process, uint64_t priority);
+extern void* scheduler_schedule(void* scheduler_states, uint64_t core_id);
+extern void* scheduler_deschedule(void* scheduler_states, uint64_t core_id);
+extern void* scheduler_get_current_process_with_state(void* scheduler_states, uint64_t core_id);
+extern void scheduler_set_current_process_with_state(void* scheduler_states, uint64_t core_id, void* process);
+extern void scheduler_decrement_reductions_with_state(void* scheduler_states, uint64_t core_id);
+extern void* process_block(void* scheduler_states, uint64_t core_id, void* pcb, uint64_t reason);
+extern int process_yield_check(void* scheduler_states, uint64_t core_id, void* pcb);
+extern uint64_t clock_read_ticks(void);
+extern int trace_init(void* scheduler_states, uint64_t core_id, uint64_t capacity);
+extern int trace_destroy(void* scheduler_states, uint64_t core_id);
+extern int trace_set_mask(void* scheduler_states, uint64_t core_id, uint64_t mask);
+extern int trace_set_sample_period(void* scheduler_states, uint64_t core_id, uint64_t period);
+extern uint64_t trace_read(void* scheduler_states, uint64_t core_id, void* buffer, uint64_t max_events);
+
+// External constants from assembly
+extern const uint64_t REASON_RECEIVE;
+extern const uint64_t REASON_TIMER;
+
+// Profile metrics (match config.inc)
+#define PROFILE_METRIC_REDUCTIONS 0
+#define PROFILE_METRIC_CPU_TICKS 1
+#define PROFILE_METRIC_DISPATCHES 2
+#define PROFILE_METRIC_BLOCKS 3
+#define PROFILE_METRIC_BLOCKS_RECEIVE 4
+#define PROFILE_METRIC_BLOCKS_TIMER 5
+#define PROFILE_METRIC_COUNT 7
+
+// Trace classes and events (match config.inc)
+#define TRACE_CLASS_SAMPLE 6
+#define TRACE_EVENT_PC_SAMPLE 0x600
+
+#define PROCESS_STATE_RUNNING 2
+#define PROCESS_STATE_TERMINATED 5
+#define PRIORITY_NORMAL 2
+
+typedef struct {
+    uint64_t timestamp;
+    uint32_t event;
+    uint32_t core;
+    uint64_t pid;
+    uint64_t arg;
+} trace_entry;
+
+static uint8_t* create_profile_test_process(uint64_t pid) {
+    uint8_t* pcb = calloc(1, PCB_SIZE);
+    *(uint64_t*)(pcb + PCB_PID_OFFSET) = pid;
+    *(uint64_t*)(pcb + PCB_STATE_OFFSET) = PROCESS_STATE_RUNNING;
+    return pcb;
+}
+
+// ------------------------------------------------------------
+// Test Profile Guards
+// ------------------------------------------------------------
+void test_profile_guards() {
+    printf("--- Testing Profile Guards ---\n");
+
+    uint8_t* pcb = create_profile_test_process(1);
+    *(uint64_t*)(pcb + PCB_TOTAL_REDUCTIONS_OFFSET) = 5;
+
+    test_assert_equal(0, profile_get(NULL, PROFILE_METRIC_REDUCTIONS), "profile_get_null_pcb");
+    test_assert_equal(5, profile_get(pcb, PROFILE_METRIC_REDUCTIONS), "profile_get_reductions");
+    test_assert_equal(0, profile_get(pcb, PROFILE_METRIC_COUNT), "profile_get_unknown_metric");
+    test_assert_equal(0, profile_reset(NULL), "profile_reset_null_pcb");
+
+    void* states = scheduler_state_init(1);
+    scheduler_init(states, 0);
+    test_assert_true(scheduler_deschedule(states, 0) == NULL, "deschedule_nothing_current");
+    test_assert_true(scheduler_deschedule(states, 128) == NULL, "deschedule_invalid_core");
+    scheduler_state_destroy(states);
+
+    free(pcb);
+}
+
+// ------------------------------------------------------------
+// Test Profile Accounting
+// ------------------------------------------------------------
+void test_profile_accounting() {
+    printf("--- Testing Profile Accounting ---\n");
+
+    void* states = scheduler_state_init(1);
+    scheduler_init(states, 0);
+    uint8_t* a = create_profile_test_process(1);
+    uint8_t* b = create_profile_test_process(2);
+
+    scheduler_enqueue_process(states, 0, a, PRIORITY_NORMAL);
+    test_assert_true(scheduler_schedule(states, 0) == a, "profile_scheduled");
+    test_assert_equal(1, profile_get(a, PROFILE_METRIC_DISPATCHES), "profile_dispatch_counted");
+    test_assert_equal(0, profile_get(a, PROFILE_METRIC_REDUCTIONS), "profile_nothing_charged_yet");
+
+    for (int i = 0; i < 25; i++) {
+        scheduler_decrement_reductions_with_state(states, 0);
+    }
+    uint64_t start = clock_read_ticks();
+    while (clock_read_ticks() == start) {
+    }
+
+    // Leaving the core charges the slice and clears the current process
+    test_assert_true(scheduler_deschedule(states, 0) == a, "profile_deschedule_returns_pcb");
+    test_assert_true(scheduler_get_current_process_with_state(states, 0) == NULL, "profile_deschedule_clears_current");
+    test_assert_true(scheduler_deschedule(states, 0) == NULL, "profile_deschedule_twice");
+    test_assert_equal(25, profile_get(a, PROFILE_METRIC_REDUCTIONS), "profile_reductions_charged");
+    test_assert_true(profile_get(a, PROFILE_METRIC_CPU_TICKS) > 0, "profile_cpu_ticks_charged");
+
+    // Switching directly charges the outgoing process
+    scheduler_enqueue_process(states, 0, a, PRIORITY_NORMAL);
+    scheduler_enqueue_process(states, 0, b, PRIORITY_NORMAL);
+    scheduler_schedule(states, 0);
+    for (int i = 0; i < 10; i++) {
+        scheduler_decrement_reductions_with_state(states, 0);
+    }
+    test_assert_true(scheduler_schedule(states, 0) == b, "profile_switch_scheduled");
+    test_assert_equal(35, profile_get(a, PROFILE_METRIC_REDUCTIONS), "profile_switch_charges_outgoing");
+    test_assert_equal(2, profile_get(a, PROFILE_METRIC_DISPATCHES), "profile_switch_dispatches");
+
+    // A terminated process is not charged
+    uint64_t ticks = profile_get(b, PROFILE_METRIC_CPU_TICKS);
+    scheduler_decrement_reductions_with_state(states, 0);
+    *(uint64_t*)(b + PCB_STATE_OFFSET) = PROCESS_STATE_TERMINATED;
+    test_assert_true(scheduler_deschedule(states, 0) == b, "profile_terminated_descheduled");
+    test_assert_equal(0, profile_get(b, PROFILE_METRIC_REDUCTIONS), "profile_terminated_no_reductions");
+    test_assert_equal(ticks, profile_get(b, PROFILE_METRIC_CPU_TICKS), "profile_terminated_no_ticks");
+
+    // Reset starts a new measurement window
+    test_assert_equal(1, profile_reset(a), "profile_reset_ok");
+    test_assert_equal(0, profile_get(a, PROFILE_METRIC_REDUCTIONS), "profile_reset_reductions");
+    test_assert_equal(0, profile_get(a, PROFILE_METRIC_CPU_TICKS), "profile_reset_ticks");
+    test_assert_equal(0, profile_get(a, PROFILE_METRIC_DISPATCHES), "profile_reset_dispatches");
+
+    free(a);
+    free(b);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Profile Block Counts
+// ------------------------------------------------------------
+void test_profile_block_counts() {
+    printf("--- Testing Profile Block Counts ---\n");
+
+    void* states = scheduler_state_init(1);
+    scheduler_init(states, 0);
+    uint8_t* pcb = create_profile_test_process(3);
+
+    scheduler_set_current_process_with_state(states, 0, pcb);
+    process_block(states, 0, pcb, REASON_TIMER);
+    *(uint64_t*)(pcb + PCB_STATE_OFFSET) = PROCESS_STATE_RUNNING;
+    scheduler_set_current_process_with_state(states, 0, pcb);
+    process_block(states, 0, pcb, REASON_TIMER);
+    *(uint64_t*)(pcb + PCB_STATE_OFFSET) = PROCESS_STATE_RUNNING;
+    scheduler_set_current_process_with_state(states, 0, pcb);
+    process_block(states, 0, pcb, REASON_RECEIVE);
+
+    test_assert_equal(2, profile_get(pcb, PROFILE_METRIC_BLOCKS_TIMER), "profile_blocks_timer");
+    test_assert_equal(1, profile_get(pcb, PROFILE_METRIC_BLOCKS_RECEIVE), "profile_blocks_receive");
+    test_assert_equal(3, profile_get(pcb, PROFILE_METRIC_BLOCKS), "profile_blocks_total");
+
+    // The counters sit at process.s's offsets, clear of the fields below
+    uint32_t* counts = (uint32_t*)(pcb + PCB_BLOCK_COUNTS_OFFSET);
+    test_assert_equal(2, counts[REASON_TIMER], "profile_timer_count_offset");
+    test_assert_equal(1, counts[REASON_RECEIVE], "profile_receive_count_offset");
+    test_assert_equal(REASON_RECEIVE, *(uint64_t*)(pcb + PCB_BLOCKING_REASON_OFFSET), "profile_blocking_reason_offset");
+    test_assert_equal(0, *(uint64_t*)(pcb + PCB_HEAP_LIMIT_OFFSET), "profile_heap_limit_untouched");
+
+    free(pcb);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Profile Top K
+// ------------------------------------------------------------
+void test_profile_top_k() {
+    printf("--- Testing Profile Top K ---\n");
+
+    uint64_t reductions[5] = {40, 90, 10, 90, 60};
+    uint8_t* pcbs[6];
+    for (int i = 0; i < 5; i++) {
+        pcbs[i] = create_profile_test_process(i + 1);
+        *(uint64_t*)(pcbs[i] + PCB_TOTAL_REDUCTIONS_OFFSET) = reductions[i];
+    }
+    pcbs[5] = NULL;
+
+    void* out[8];
+    memset(out, 0, sizeof(out));
+    test_assert_equal(3, profile_top_k((void**)pcbs, 6, PROFILE_METRIC_REDUCTIONS, 3, out), "top_k_found");
+    test_assert_true(out[0] == pcbs[1], "top_k_first");
+    test_assert_true(out[1] == pcbs[3], "top_k_tie_array_order");
+    test_assert_true(out[2] == pcbs[4], "top_k_third");
+
+    // More wanted than present: every non-NULL entry, NULL skipped
+    test_assert_equal(5, profile_top_k((void**)pcbs, 6, PROFILE_METRIC_REDUCTIONS, 8, out), "top_k_all");
+    test_assert_true(out[4] == pcbs[2], "top_k_smallest_last");
+
+    test_assert_equal(0, profile_top_k(NULL, 6, PROFILE_METRIC_REDUCTIONS, 3, out), "top_k_null_pcbs");
+    test_assert_equal(0, profile_top_k((void**)pcbs, 6, PROFILE_METRIC_REDUCTIONS, 0, out), "top_k_zero_k");
+    test_assert_equal(0, profile_top_k((void**)pcbs, 6, PROFILE_METRIC_REDUCTIONS, 3, NULL), "top_k_null_out");
+
+    for (int i = 0; i < 5; i++) {
+        free(pcbs[i]);
+    }
+}
+
+// ------------------------------------------------------------
+// Test Profile PC Sampling
+// ------------------------------------------------------------
+void test_profile_pc_sampling() {
+    printf("--- Testing Profile PC Sampling ---\n");
+
+    void* states = scheduler_state_init(1);
+    scheduler_init(states, 0);
+    uint8_t* pcb = create_profile_test_process(9);
+    scheduler_set_current_process_with_state(states, 0, pcb);
+    scheduler_set_reduction_count_with_state(states, 0, 100);
+
+    test_assert_equal(0, trace_set_sample_period(states, 0, 2), "sample_period_needs_ring");
+    trace_init(states, 0, 64);
+    test_assert_equal(0, trace_set_sample_period(states, 128, 2), "sample_period_invalid_core");
+    test_assert_equal(1, trace_set_sample_period(states, 0, 2), "sample_period_set");
+    trace_set_mask(states, 0, 1ULL << TRACE_CLASS_SAMPLE);
+
+    // Every second reduction check is sampled
+    for (int i = 0; i < 6; i++) {
+        process_yield_check(states, 0, pcb);
+    }
+
+    trace_entry events[8];
+    memset(events, 0, sizeof(events));
+    test_assert_equal(3, trace_read(states, 0, events, 8), "sample_count");
+    test_assert_equal(TRACE_EVENT_PC_SAMPLE, events[0].event, "sample_event");
+    test_assert_equal(9, events[0].pid, "sample_pid");
+    test_assert_true(events[0].arg != 0 && events[0].arg == events[2].arg, "sample_pc_call_site");
+
+    free(pcb);
+    trace_destroy(states, 0);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Main Profile Test Function
+// ------------------------------------------------------------
+void test_profile_main() {
+    printf("=== PROFILE TEST SUITE ===\n");
+
+    test_profile_guards();
+    test_profile_accounting();
+    test_profile_block_counts();
+    test_profile_top_k();
+    test_profile_pc_sampling();
+
+    printf("=== PROFILE TEST SUITE COMPLETE ===\n");
+}
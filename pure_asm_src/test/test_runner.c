@@ -64,7 +64,25 @@ extern void test_affinity_main();
 extern void test_communication_main();
 
 // External Phase 9 timer test functions
+extern void test_clock_main();
 extern void test_timer_main();
+extern void test_idle_main();
+extern void test_trace_main();
+extern void test_profile_main();
+extern void test_stats_main();
+extern void test_perf_main();
+extern void test_sim_main();
+extern void test_term_main();
+extern void test_atom_main();
+extern void test_match_main();
+extern void test_interp_main();
+extern void test_jit_main();
+extern void test_pipeline_main();
+extern void test_map_main();
+extern void test_btree_main();
+extern void test_finger_main();
+extern void test_set_main();
+extern void test_host_main();
 
 // External Phase 10 Apple Silicon test functions
 extern void test_apple_silicon_main();
@@ -131,7 +149,25 @@ void test_runner_main() {
     test_communication_main();
 
     // Run Phase 9 timer tests
+    test_clock_main();
     test_timer_main();
+    test_idle_main();
+    test_trace_main();
+    test_profile_main();
+    test_stats_main();
+    test_perf_main();
+    test_sim_main();
+    test_term_main();
+    test_atom_main();
+    test_match_main();
+    test_interp_main();
+    test_jit_main();
+    test_pipeline_main();
+    test_map_main();
+    test_btree_main();
+    test_finger_main();
+    test_set_main();
+    test_host_main();
 
     // Run Phase 10 Apple Silicon tests
     test_apple_silicon_main();
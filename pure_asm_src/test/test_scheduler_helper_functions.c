@@ -142,9 +142,9 @@ void test_scheduler_data_structure_layout() {
     test_assert_equal(24, PRIORITY_QUEUE_SIZE_CONST, "scheduler_priority_queue_size");
     
     // Test that scheduler_size is correct
-    // Should be: core_id + queues + current_process + reduction_count + 3 statistics + waiting queues + yield statistics
-    // = 1 + (4 * 3) + 1 + 1 + 3 + (3 * 3) + 2 = 31 quad words = 248 bytes
-    test_assert_equal(248, SCHEDULER_SIZE_CONST, "scheduler_scheduler_size");
+    // Should be: core_id + queues + current_process + reduction_count + 3 statistics + waiting queues + yield statistics + cached clock + timer wheel + idle word + trace ring + trace mask + steal attempts + perf counters + steal request/scheduler count + inject inbox
+    // = 1 + (4 * 3) + 1 + 1 + 3 + (3 * 3) + 2 + 1 + 1 + 1 + 1 + 1 + 1 + 1 + 1 + 1 = 40 quad words = 320 bytes
+    test_assert_equal(320, SCHEDULER_SIZE_CONST, "scheduler_scheduler_size");
     
     // Test that NUM_PRIORITIES is 4
     test_assert_equal(4, NUM_PRIORITIES_CONST, "scheduler_num_priorities");
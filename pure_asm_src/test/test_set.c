@@ -0,0 +1,368 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// ------------------------------------------------------------
+// test_set.c — C test suite for Swiss-Table Hash Sets
+// ------------------------------------------------------------
+// Tests set.s: inserts, lookups and removals against a reference
+// bitmap, keys sharing a home group and a control byte, in-place
+// growth keeping every key and the set's address, reservation,
+// tombstone-free churn at the highest load, the most-keys limit,
+// frozen sets: read-only pages, rejected updates and mutable copies,
+// and handles boxing a frozen set as a term.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern void* set_create(uint64_t max_keys);
+extern int set_destroy(void* set);
+extern int set_insert(void* set, uint64_t key);
+extern int set_contains(void* set, uint64_t key);
+extern int set_remove(void* set, uint64_t key);
+extern int set_reserve(void* set, uint64_t keys);
+extern void* set_copy(void* set);
+extern int set_freeze(void* set);
+extern uint64_t set_count(void* set);
+extern uint64_t set_capacity(void* set);
+extern uint64_t term_make_int(int64_t value);
+extern uint64_t term_make_atom(uint64_t index);
+extern uint64_t set_term(void* pcb, void* set);
+extern uint64_t term_type(uint64_t term);
+extern uint64_t term_size(uint64_t term);
+extern uint64_t term_copy(void* pcb, uint64_t term);
+extern int term_equal(uint64_t a, uint64_t b);
+
+// Set limits (match config.inc)
+#define SET_MIN_CAPACITY 16
+#define SET_MAX_KEYS 0xE000000
+
+// Term constants (match config.inc)
+#define TERM_NONE 0x34
+#define TERM_TYPE_SET 12
+#define TERM_HEADER_SET_1 0x136      // Arity 1, TERM_KIND_SET
+
+#define SET_TEST_KEYS 20000
+#define SET_TEST_RANGE 65536
+#define SET_TEST_FULL 3584           // 7/8 of 4096 slots
+
+// The i-th of n values in a scrambled order (7919 is prime to n)
+static uint64_t set_test_scrambled(uint64_t i, uint64_t n) {
+    return (i * 7919) % n;
+}
+
+// A small xorshift generator, so runs repeat
+static uint64_t set_test_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void test_set_basics() {
+    test_assert_true(set_create(0) == NULL, "zero keys rejected");
+    test_assert_true(set_create(SET_MAX_KEYS + 1ULL) == NULL, "too many keys rejected");
+    test_assert_equal(0, set_insert(NULL, 1), "insert into NULL");
+    test_assert_equal(0, set_contains(NULL, 1), "lookup in NULL");
+    test_assert_equal(0, set_remove(NULL, 1), "remove from NULL");
+    test_assert_equal(0, set_count(NULL), "count of NULL");
+    test_assert_equal(0, set_destroy(NULL), "destroy NULL");
+
+    void* set = set_create(100);
+    test_assert_true(set != NULL, "set created");
+    test_assert_equal(0, set_count(set), "new set is empty");
+    test_assert_equal(SET_MIN_CAPACITY, set_capacity(set), "new set has one group");
+    test_assert_equal(0, set_contains(set, term_make_int(7)), "empty set holds nothing");
+
+    test_assert_equal(1, set_insert(set, term_make_int(7)), "insert integer");
+    test_assert_equal(1, set_insert(set, term_make_atom(3)), "insert atom");
+    test_assert_equal(1, set_insert(set, 0), "insert zero word");
+    test_assert_equal(1, set_insert(set, ~0ULL), "insert all-ones word");
+    test_assert_equal(4, set_count(set), "four keys");
+    test_assert_equal(1, set_insert(set, term_make_int(7)), "insert again succeeds");
+    test_assert_equal(4, set_count(set), "repeat adds nothing");
+    test_assert_equal(1, set_contains(set, term_make_int(7)), "integer held");
+    test_assert_equal(1, set_contains(set, term_make_atom(3)), "atom held");
+    test_assert_equal(1, set_contains(set, 0), "zero held");
+    test_assert_equal(1, set_contains(set, ~0ULL), "all-ones held");
+    test_assert_equal(0, set_contains(set, term_make_int(3)), "integer 3 is not atom 3");
+
+    test_assert_equal(1, set_remove(set, term_make_int(7)), "remove held key");
+    test_assert_equal(0, set_remove(set, term_make_int(7)), "remove it again");
+    test_assert_equal(0, set_contains(set, term_make_int(7)), "removed key gone");
+    test_assert_equal(3, set_count(set), "three keys left");
+    test_assert_equal(1, set_destroy(set), "set destroyed");
+}
+
+static void test_set_reference() {
+    // Random inserts and removals against a reference bitmap
+    void* set = set_create(SET_TEST_RANGE);
+    uint8_t* held = calloc(SET_TEST_RANGE, 1);
+    uint64_t state = 0x9E3779B97F4A7C15ULL, count = 0;
+    int agree = 1, counted = 1;
+    for (int i = 0; i < 400000; i++) {
+        uint64_t value = set_test_random(&state) % SET_TEST_RANGE;
+        uint64_t key = term_make_int((int64_t)value);
+        if (set_test_random(&state) % 3 == 0) {
+            agree &= set_remove(set, key) == held[value];
+            count -= held[value];
+            held[value] = 0;
+        } else {
+            agree &= set_insert(set, key) == 1;
+            count += !held[value];
+            held[value] = 1;
+        }
+        if (i % 50000 == 0) {
+            for (uint64_t v = 0; v < SET_TEST_RANGE; v++) {
+                agree &= set_contains(set, term_make_int((int64_t)v)) == held[v];
+            }
+        }
+        counted &= set_count(set) == count;
+    }
+    for (uint64_t v = 0; v < SET_TEST_RANGE; v++) {
+        agree &= set_contains(set, term_make_int((int64_t)v)) == held[v];
+    }
+    test_assert_true(agree, "every answer matches the reference");
+    test_assert_true(counted, "count matches the reference throughout");
+    free(held);
+    set_destroy(set);
+}
+
+static void test_set_collisions() {
+    // Keys differing only in their high bits, and (with 128 tags) many
+    // sharing a control byte: probes must read past every tag match
+    void* set = set_create(SET_TEST_KEYS);
+    int held = 1;
+    for (uint64_t i = 0; i < SET_TEST_KEYS; i++) {
+        held &= set_insert(set, i << 40);
+    }
+    test_assert_equal(SET_TEST_KEYS, set_count(set), "high-bit keys all added");
+    for (uint64_t i = 0; i < SET_TEST_KEYS; i++) {
+        held &= set_contains(set, i << 40);
+    }
+    test_assert_true(held, "high-bit keys all found");
+    int absent = 1;
+    for (uint64_t i = 0; i < SET_TEST_KEYS; i++) {
+        absent &= !set_contains(set, (i << 40) | 8);
+    }
+    test_assert_true(absent, "neighbours of high-bit keys absent");
+    for (uint64_t i = 0; i < SET_TEST_KEYS; i += 2) {
+        held &= set_remove(set, i << 40);
+    }
+    for (uint64_t i = 0; i < SET_TEST_KEYS; i++) {
+        held &= set_contains(set, i << 40) == (int)(i & 1);
+    }
+    test_assert_true(held, "removing every other key keeps the rest");
+    set_destroy(set);
+}
+
+static void test_set_growth() {
+    void* set = set_create(SET_TEST_KEYS);
+    void* address = set;
+    uint64_t capacity = set_capacity(set), grew = 0;
+    int held = 1, loaded = 1;
+    for (uint64_t i = 0; i < SET_TEST_KEYS; i++) {
+        uint64_t key = term_make_int((int64_t)set_test_scrambled(i, SET_TEST_KEYS));
+        held &= set_insert(set, key);
+        if (set_capacity(set) != capacity) {
+            grew++;
+            capacity = set_capacity(set);
+            // Every key added so far survives the rehash
+            for (uint64_t j = 0; j <= i; j++) {
+                held &= set_contains(set, term_make_int((int64_t)set_test_scrambled(j, SET_TEST_KEYS)));
+            }
+        }
+        loaded &= set_count(set) * 8 <= set_capacity(set) * 7;
+    }
+    test_assert_true(held, "keys survive every doubling");
+    test_assert_true(grew >= 10, "grew from one group");
+    test_assert_true(loaded, "never more than 7/8 full");
+    test_assert_equal(32768, set_capacity(set), "smallest capacity for the keys");
+    test_assert_true(set == address, "set grew in place");
+
+    // The mapping was sized for SET_TEST_KEYS; no room past 7/8 of it
+    uint64_t extra = 0;
+    while (set_insert(set, term_make_int(-1 - (int64_t)extra))) {
+        extra++;
+    }
+    test_assert_equal(28672, set_count(set), "fills to 7/8 of the largest capacity");
+    test_assert_equal(0, set_contains(set, term_make_int(-1 - (int64_t)extra)), "refused key not added");
+    test_assert_equal(0, set_reserve(set, 28673), "reserve past the mapping refused");
+    set_destroy(set);
+
+    // Reserve grows once, up front
+    set = set_create(SET_TEST_KEYS);
+    test_assert_equal(1, set_reserve(set, SET_TEST_KEYS), "reserve for every key");
+    capacity = set_capacity(set);
+    test_assert_equal(32768, capacity, "reserved capacity");
+    for (uint64_t i = 0; i < SET_TEST_KEYS; i++) {
+        set_insert(set, term_make_int((int64_t)i));
+    }
+    test_assert_equal(capacity, set_capacity(set), "no growth after reserving");
+    test_assert_equal(1, set_reserve(set, 10), "reserving less is a no-op");
+    test_assert_equal(capacity, set_capacity(set), "reserve never shrinks");
+    set_destroy(set);
+}
+
+static void test_set_churn() {
+    // At the highest load, removal and insertion of random keys must
+    // neither lose keys nor wear the set out: no tombstones, so no
+    // growth and no slower probes
+    void* set = set_create(SET_TEST_FULL);
+    for (uint64_t i = 0; i < SET_TEST_FULL; i++) {
+        set_insert(set, term_make_int((int64_t)i));
+    }
+    test_assert_equal(4096, set_capacity(set), "full set capacity");
+    uint64_t state = 12345;
+    int cycled = 1;
+    for (int round = 0; round < 200000; round++) {
+        uint64_t key = term_make_int((int64_t)(set_test_random(&state) % SET_TEST_FULL));
+        cycled &= set_remove(set, key);
+        cycled &= !set_contains(set, key);
+        cycled &= set_insert(set, key);
+    }
+    test_assert_true(cycled, "every churned key removed and re-added");
+    test_assert_equal(SET_TEST_FULL, set_count(set), "count steady under churn");
+    test_assert_equal(4096, set_capacity(set), "churn never grows the set");
+    int held = 1;
+    for (uint64_t i = 0; i < SET_TEST_FULL; i++) {
+        held &= set_contains(set, term_make_int((int64_t)i));
+    }
+    test_assert_true(held, "every key still held after churn");
+    test_assert_equal(0, set_contains(set, term_make_int(SET_TEST_FULL)), "no stray key");
+
+    // Emptying and refilling leaves no trace either
+    for (uint64_t i = 0; i < SET_TEST_FULL; i++) {
+        set_remove(set, term_make_int((int64_t)i));
+    }
+    test_assert_equal(0, set_count(set), "emptied");
+    for (uint64_t i = 0; i < SET_TEST_FULL; i++) {
+        held &= !set_contains(set, term_make_int((int64_t)i));
+    }
+    test_assert_true(held, "emptied set holds nothing");
+    test_assert_equal(1, set_insert(set, term_make_int(5)), "reusable after emptying");
+    test_assert_equal(4096, set_capacity(set), "capacity kept after emptying");
+    set_destroy(set);
+}
+
+static void test_set_frozen() {
+    void* set = set_create(1000);
+    for (int64_t i = 0; i < 1000; i++) {
+        set_insert(set, term_make_int(2 * i));
+    }
+    test_assert_equal(1, set_freeze(set), "set frozen");
+    test_assert_equal(1, set_freeze(set), "freezing again is a no-op");
+    test_assert_equal(0, set_insert(set, term_make_int(1)), "frozen set refuses inserts");
+    test_assert_equal(0, set_remove(set, term_make_int(2)), "frozen set refuses removals");
+    test_assert_equal(0, set_reserve(set, 1000), "frozen set refuses reserves");
+    test_assert_equal(1000, set_count(set), "frozen set unchanged");
+    int held = 1;
+    for (int64_t i = 0; i < 2000; i++) {
+        held &= set_contains(set, term_make_int(i)) == !(i & 1);
+    }
+    test_assert_true(held, "lookups work on a frozen set");
+
+    // A copy is mutable and independent of the original
+    void* copy = set_copy(set);
+    test_assert_true(copy != NULL && copy != set, "copy made");
+    test_assert_equal(1000, set_count(copy), "copy has every key");
+    test_assert_equal(set_capacity(set), set_capacity(copy), "copy keeps the capacity");
+    test_assert_equal(1, set_insert(copy, term_make_int(1)), "copy takes inserts");
+    test_assert_equal(1, set_remove(copy, term_make_int(0)), "copy takes removals");
+    test_assert_equal(0, set_contains(set, term_make_int(1)), "original lacks the copy's insert");
+    test_assert_equal(1, set_contains(set, term_make_int(0)), "original keeps the copy's removal");
+    for (int64_t i = 1000; i < 1700; i++) {
+        set_insert(copy, term_make_int(2 * i));
+    }
+    test_assert_equal(1700, set_count(copy), "copy grows in its own mapping");
+    test_assert_equal(0, set_copy(NULL) != NULL, "copy of NULL");
+    test_assert_equal(1, set_destroy(copy), "copy destroyed");
+    test_assert_equal(1, set_destroy(set), "frozen set destroyed");
+}
+
+static void test_set_handles() {
+    void* pcb = test_pcb_with_heap(4);  // Room for two handles
+    void* other = test_pcb_with_heap(2);
+    void* set = set_create(100);
+    set_insert(set, term_make_int(3));
+
+    test_assert_equal(TERM_NONE, set_term(pcb, set), "mutable set refuses a handle");
+    test_assert_equal(0, test_pcb_heap_used(pcb), "refused handle allocates nothing");
+    set_freeze(set);
+    test_assert_equal(TERM_NONE, set_term(NULL, set), "handle without a PCB");
+    test_assert_equal(TERM_NONE, set_term(pcb, NULL), "handle of NULL");
+
+    uint64_t handle = set_term(pcb, set);
+    test_assert_true(handle != TERM_NONE, "frozen set boxed");
+    test_assert_equal(16, test_pcb_heap_used(pcb), "handle is two words");
+    uint64_t* object = (uint64_t*)(handle - 1);
+    test_assert_equal(TERM_HEADER_SET_1, object[0], "handle header");
+    test_assert_equal((uint64_t)set, object[1], "handle holds the set");
+    test_assert_equal(TERM_TYPE_SET, term_type(handle), "type of a handle");
+    test_assert_equal(2, term_size(handle), "size of a handle");
+
+    // Copies share the set and compare by it
+    uint64_t copy = term_copy(other, handle);
+    test_assert_true(copy != TERM_NONE && copy != handle, "handle copied to another heap");
+    test_assert_equal((uint64_t)set, ((uint64_t*)(copy - 1))[1], "copy names the same set");
+    test_assert_true(term_equal(handle, copy), "copy equals the original");
+    void* twin = set_copy(set);
+    set_freeze(twin);
+    test_assert_true(!term_equal(handle, set_term(pcb, twin)), "handles of different sets differ");
+    test_assert_equal(TERM_NONE, set_term(pcb, set), "handle on a full heap");
+
+    set_destroy(twin);
+    set_destroy(set);
+    test_pcb_free(other);
+    test_pcb_free(pcb);
+}
+
+void test_set_main() {
+    printf("=== HASH SET TEST SUITE ===\n");
+
+    test_set_basics();
+    test_set_reference();
+    test_set_collisions();
+    test_set_growth();
+    test_set_churn();
+    test_set_frozen();
+    test_set_handles();
+
+    printf("=== HASH SET TEST SUITE COMPLETE ===\n");
+}
@@ -0,0 +1,381 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// test_sim.c — C test suite for Deterministic Simulation
+// ------------------------------------------------------------
+// Tests sim.s: argument checks, identical digests and logs for equal
+// seeds, exact replay of a logged schedule through a script, virtual
+// timestamps in trace events and profiles, and idle handling (no
+// sleeping, clock jumps to the next timer deadline).
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern void* sim_create(void* scheduler_states, uint64_t cores, uint64_t seed, uint64_t log_capacity);
+extern int sim_destroy(void* sim);
+extern int sim_set_quantum(void* sim, uint64_t ticks);
+extern int sim_set_script(void* sim, const uint8_t* cores, uint64_t count);
+extern void* sim_step(void* sim, uint64_t* core_out);
+extern uint64_t sim_advance(void* sim, uint64_t ticks);
+extern uint64_t sim_advance_idle(void* sim);
+extern uint64_t sim_now(void* sim);
+extern uint64_t sim_log_read(void* sim, void* out, uint64_t max);
+extern uint64_t sim_digest(void* sim);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern void scheduler_init(void* scheduler_states, uint64_t core_id);
+extern int scheduler_enqueue_process(void* scheduler_states, uint64_t core_id, void* process, uint64_t priority);
+extern void* scheduler_deschedule(void* scheduler_states, uint64_t core_id);
+extern uint64_t scheduler_refresh_now(void* scheduler_states, uint64_t core_id);
+extern int scheduler_idle_sleep(void* scheduler_states, uint64_t core_id);
+extern int timer_wheel_init(void* scheduler_states, uint64_t core_id);
+extern int timer_wheel_destroy(void* scheduler_states, uint64_t core_id);
+extern uint64_t timer_arm(void* scheduler_states, uint64_t core_id, void* pcb,
+                          uint64_t expiry_ticks, void* callback, uint64_t argument);
+extern uint64_t profile_get(void* pcb, uint64_t metric);
+extern int trace_init(void* scheduler_states, uint64_t core_id, uint64_t capacity);
+extern int trace_destroy(void* scheduler_states, uint64_t core_id);
+extern int trace_set_mask(void* scheduler_states, uint64_t core_id, uint64_t mask);
+extern uint64_t trace_read(void* scheduler_states, uint64_t core_id, void* buffer, uint64_t max_events);
+
+// Simulation constants (match config.inc)
+#define SIM_EPOCH 0x10000000
+#define SIM_DEFAULT_QUANTUM 1000
+#define SIM_EVENT_DISPATCH 0
+#define SIM_EVENT_STEAL 1
+#define SIM_EVENT_IDLE 2
+#define SIM_EVENT_ADVANCE 3
+#define SIM_NO_CORE 0xFFFFFFFF
+
+// Trace and profile constants (match config.inc)
+#define TRACE_CLASS_ALL 0x7F
+#define TRACE_EVENT_SCHED_IN 0x000
+#define PROFILE_METRIC_CPU_TICKS 1
+
+// Scheduler state layout (match scheduler.s)
+extern const uint64_t SCHEDULER_SIZE_CONST;
+#define SCHEDULER_FLAGS_OFFSET 284
+#define SCHEDULER_FLAG_VIRTUAL_TIME 0
+#define PRIORITY_NORMAL 2
+
+#define SIM_TEST_CORES 4
+#define SIM_TEST_PROCESSES 8
+#define SIM_TEST_STEPS 200
+#define SIM_TEST_LOG 256
+
+typedef struct {
+    uint64_t now;
+    uint32_t core;
+    uint32_t kind;
+    uint64_t pid;
+    uint64_t arg;
+} sim_entry;
+
+typedef struct {
+    uint64_t timestamp;
+    uint32_t event;
+    uint32_t core;
+    uint64_t pid;
+    uint64_t arg;
+} sim_trace_entry;
+
+static uint32_t sim_flags(void* states, uint64_t core) {
+    return *(uint32_t*)((uint8_t*)states + core * SCHEDULER_SIZE_CONST + SCHEDULER_FLAGS_OFFSET);
+}
+
+// Run every process for one slice when dispatched, then put it back
+// on the scheduler that ran it. The last core starts with no work, so
+// it has to steal through the request and hand-off path.
+static uint64_t sim_run_workload(uint64_t seed, const uint8_t* script, uint64_t script_length,
+                                 sim_entry* log, uint64_t* log_count) {
+    void* states = scheduler_state_init(SIM_TEST_CORES);
+    for (uint64_t c = 0; c < SIM_TEST_CORES; c++) {
+        scheduler_init(states, c);
+    }
+    uint8_t* pcbs = calloc(SIM_TEST_PROCESSES, PCB_SIZE);
+    for (uint64_t i = 0; i < SIM_TEST_PROCESSES; i++) {
+        *(uint64_t*)(pcbs + i * PCB_SIZE + PCB_PID_OFFSET) = i + 1;
+        scheduler_enqueue_process(states, i % (SIM_TEST_CORES - 1), pcbs + i * PCB_SIZE, PRIORITY_NORMAL);
+    }
+
+    void* sim = sim_create(states, SIM_TEST_CORES, seed, SIM_TEST_LOG);
+    sim_set_script(sim, script, script_length);
+    for (int step = 0; step < SIM_TEST_STEPS; step++) {
+        uint64_t core = 0;
+        void* pcb = sim_step(sim, &core);
+        if (pcb != NULL) {
+            scheduler_deschedule(states, core);
+            scheduler_enqueue_process(states, core, pcb, PRIORITY_NORMAL);
+        }
+    }
+    uint64_t digest = sim_digest(sim);
+    if (log != NULL) {
+        *log_count = sim_log_read(sim, log, SIM_TEST_LOG);
+    }
+
+    sim_destroy(sim);
+    scheduler_state_destroy(states);
+    free(pcbs);
+    return digest;
+}
+
+// ------------------------------------------------------------
+// Test Sim Arguments
+// ------------------------------------------------------------
+void test_sim_arguments() {
+    printf("--- Testing Sim Arguments ---\n");
+
+    void* states = scheduler_state_init(2);
+    scheduler_init(states, 0);
+    scheduler_init(states, 1);
+
+    test_assert_true(sim_create(NULL, 2, 1, 64) == NULL, "sim_create_null_states");
+    test_assert_true(sim_create(states, 0, 1, 64) == NULL, "sim_create_no_cores");
+    test_assert_true(sim_create(states, 129, 1, 64) == NULL, "sim_create_too_many_cores");
+    test_assert_true(sim_create(states, 2, 1, 32) == NULL, "sim_create_log_too_small");
+    test_assert_true(sim_create(states, 2, 1, 100) == NULL, "sim_create_log_not_power_of_two");
+    test_assert_equal(0, sim_flags(states, 0), "sim_create_failure_leaves_flags");
+
+    test_assert_true(sim_step(NULL, NULL) == NULL, "sim_step_null");
+    test_assert_equal(0, sim_advance(NULL, 1), "sim_advance_null");
+    test_assert_equal(0, sim_advance_idle(NULL), "sim_advance_idle_null");
+    test_assert_equal(0, sim_now(NULL), "sim_now_null");
+    test_assert_equal(0, sim_digest(NULL), "sim_digest_null");
+    test_assert_equal(0, sim_destroy(NULL), "sim_destroy_null");
+
+    // A wheel armed on real time would never see virtual time advance
+    timer_wheel_init(states, 1);
+    test_assert_true(sim_create(states, 2, 1, 64) == NULL, "sim_create_existing_wheel");
+    timer_wheel_destroy(states, 1);
+
+    void* sim = sim_create(states, 2, 0, 64);
+    test_assert_true(sim != NULL, "sim_create_seed_zero");
+    test_assert_equal(SIM_EPOCH, sim_now(sim), "sim_create_epoch");
+    test_assert_equal(1u << SCHEDULER_FLAG_VIRTUAL_TIME, sim_flags(states, 1), "sim_create_virtual_flag");
+    test_assert_equal(SIM_EPOCH, scheduler_refresh_now(states, 1), "sim_refresh_reads_virtual_clock");
+    test_assert_equal(0, sim_set_quantum(sim, 0), "sim_set_quantum_zero");
+    test_assert_equal(0, sim_set_script(sim, NULL, 3), "sim_set_script_null_with_count");
+    test_assert_equal(1, sim_set_script(sim, NULL, 0), "sim_set_script_clear");
+    test_assert_equal(SIM_EPOCH, sim_advance(sim, 0), "sim_advance_zero");
+    test_assert_equal(SIM_EPOCH + 50, sim_advance(sim, 50), "sim_advance_ticks");
+
+    sim_entry entry;
+    test_assert_equal(1, sim_log_read(sim, &entry, 1), "sim_log_advance_logged");
+    test_assert_equal(SIM_EVENT_ADVANCE, entry.kind, "sim_log_advance_kind");
+    test_assert_equal(SIM_NO_CORE, entry.core, "sim_log_advance_core");
+    test_assert_equal(50, entry.arg, "sim_log_advance_arg");
+
+    test_assert_equal(1, sim_destroy(sim), "sim_destroy");
+    test_assert_equal(0, sim_flags(states, 0), "sim_destroy_clears_flag");
+    test_assert_true(scheduler_refresh_now(states, 0) != SIM_EPOCH + 50, "sim_destroy_real_clock");
+
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Sim Determinism
+// ------------------------------------------------------------
+void test_sim_determinism() {
+    printf("--- Testing Sim Determinism ---\n");
+
+    static sim_entry first[SIM_TEST_LOG];
+    static sim_entry second[SIM_TEST_LOG];
+    uint64_t first_count = 0;
+    uint64_t second_count = 0;
+
+    uint64_t digest = sim_run_workload(42, NULL, 0, first, &first_count);
+    test_assert_equal(SIM_TEST_STEPS, first_count, "sim_log_every_step");
+    test_assert_equal(digest, sim_run_workload(42, NULL, 0, second, &second_count), "sim_same_seed_same_digest");
+    test_assert_equal(first_count, second_count, "sim_same_seed_same_log_length");
+    test_assert_equal(0, (uint64_t)memcmp(first, second, sizeof(sim_entry) * first_count), "sim_same_seed_same_log");
+    test_assert_true(sim_run_workload(43, NULL, 0, NULL, NULL) != digest, "sim_other_seed_other_digest");
+
+    // Time advances one quantum per step, on every core alike
+    test_assert_equal(SIM_EPOCH + SIM_DEFAULT_QUANTUM, first[0].now, "sim_first_step_time");
+    test_assert_equal(SIM_EPOCH + SIM_TEST_STEPS * SIM_DEFAULT_QUANTUM, first[first_count - 1].now, "sim_last_step_time");
+
+    // Every core is picked; the one without work asks for work and
+    // later dispatches what it is handed
+    int dispatched = 0;
+    int stolen = 0;
+    int arrived = 0;
+    int covered[SIM_TEST_CORES] = {0};
+    for (uint64_t i = 0; i < first_count; i++) {
+        dispatched |= first[i].kind == SIM_EVENT_DISPATCH;
+        if (first[i].kind == SIM_EVENT_STEAL && first[i].core == SIM_TEST_CORES - 1) {
+            stolen = 1;
+            test_assert_true(first[i].arg < SIM_TEST_CORES - 1, "sim_log_steal_victim");
+            test_assert_equal(0, first[i].pid, "sim_log_steal_no_pid");
+        }
+        if (first[i].kind == SIM_EVENT_DISPATCH && first[i].core == SIM_TEST_CORES - 1) {
+            test_assert_true(stolen, "sim_log_steal_before_arrival");
+            arrived = 1;
+        }
+        if (first[i].core < SIM_TEST_CORES) {
+            covered[first[i].core] = 1;
+        }
+    }
+    test_assert_true(dispatched, "sim_log_dispatches");
+    test_assert_true(stolen, "sim_log_steals");
+    test_assert_true(arrived, "sim_log_stolen_process_dispatched");
+    test_assert_true(covered[0] && covered[1] && covered[2] && covered[3], "sim_every_core_stepped");
+}
+
+// ------------------------------------------------------------
+// Test Sim Replay
+// ------------------------------------------------------------
+void test_sim_replay() {
+    printf("--- Testing Sim Replay ---\n");
+
+    static sim_entry logged[SIM_TEST_LOG];
+    static sim_entry replayed[SIM_TEST_LOG];
+    static uint8_t script[SIM_TEST_STEPS];
+    uint64_t logged_count = 0;
+    uint64_t replayed_count = 0;
+
+    uint64_t digest = sim_run_workload(7, NULL, 0, logged, &logged_count);
+    for (uint64_t i = 0; i < logged_count; i++) {
+        script[i] = (uint8_t)logged[i].core;
+    }
+
+    // Another seed, but the script decides every step
+    test_assert_equal(digest, sim_run_workload(99, script, logged_count, replayed, &replayed_count), "sim_replay_same_digest");
+    test_assert_equal(0, (uint64_t)memcmp(logged, replayed, sizeof(sim_entry) * logged_count), "sim_replay_same_log");
+
+    // A one-step change to the schedule shows up in the digest
+    script[SIM_TEST_STEPS / 2] = (uint8_t)((script[SIM_TEST_STEPS / 2] + 1) % SIM_TEST_CORES);
+    test_assert_true(sim_run_workload(7, script, logged_count, NULL, NULL) != digest, "sim_replay_divergence");
+}
+
+// ------------------------------------------------------------
+// Test Sim Virtual Time
+// ------------------------------------------------------------
+void test_sim_virtual_time() {
+    printf("--- Testing Sim Virtual Time ---\n");
+
+    void* states = scheduler_state_init(1);
+    scheduler_init(states, 0);
+    trace_init(states, 0, 64);
+    trace_set_mask(states, 0, TRACE_CLASS_ALL);
+    uint8_t* pcb = calloc(1, PCB_SIZE);
+    *(uint64_t*)(pcb + PCB_PID_OFFSET) = 5;
+    scheduler_enqueue_process(states, 0, pcb, PRIORITY_NORMAL);
+
+    void* sim = sim_create(states, 1, 3, 64);
+    sim_set_quantum(sim, 250);
+    test_assert_true(sim_step(sim, NULL) == pcb, "sim_step_dispatches");
+    uint64_t dispatched_at = sim_now(sim);
+    test_assert_equal(SIM_EPOCH + 250, dispatched_at, "sim_step_quantum");
+
+    sim_trace_entry events[8];
+    uint64_t count = trace_read(states, 0, events, 8);
+    int found = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        if (events[i].event == TRACE_EVENT_SCHED_IN) {
+            found = 1;
+            test_assert_equal(dispatched_at, events[i].timestamp, "sim_trace_virtual_timestamp");
+        }
+    }
+    test_assert_true(found, "sim_trace_sched_in");
+
+    // The slice is charged exactly the virtual ticks that passed
+    sim_advance(sim, 1234);
+    scheduler_deschedule(states, 0);
+    test_assert_equal(1234, profile_get(pcb, PROFILE_METRIC_CPU_TICKS), "sim_profile_virtual_ticks");
+
+    sim_destroy(sim);
+    trace_destroy(states, 0);
+    scheduler_state_destroy(states);
+    free(pcb);
+}
+
+// ------------------------------------------------------------
+// Test Sim Idle
+// ------------------------------------------------------------
+static uint64_t sim_timer_fired;
+
+static void sim_timer_callback(void* states, uint64_t core, void* pcb, uint64_t argument) {
+    (void)states;
+    (void)core;
+    (void)pcb;
+    sim_timer_fired = argument;
+}
+
+void test_sim_idle() {
+    printf("--- Testing Sim Idle ---\n");
+
+    void* states = scheduler_state_init(2);
+    scheduler_init(states, 0);
+    scheduler_init(states, 1);
+    void* sim = sim_create(states, 2, 11, 64);
+    test_assert_equal(1, timer_wheel_init(states, 1), "sim_wheel_after_create");
+
+    test_assert_equal(0, sim_advance_idle(sim), "sim_advance_idle_no_timers");
+    test_assert_equal(0, scheduler_idle_sleep(states, 1), "sim_idle_sleep_returns");
+
+    sim_timer_fired = 0;
+    uint64_t expiry = sim_now(sim) + 1000000;
+    test_assert_true(timer_arm(states, 1, NULL, expiry, (void*)sim_timer_callback, 77) != 0, "sim_timer_armed");
+    test_assert_equal(0, scheduler_idle_sleep(states, 1), "sim_idle_sleep_with_timer");
+
+    // Nothing runnable: jump straight to the deadline, then step core 1
+    uint64_t now = sim_advance_idle(sim);
+    test_assert_true(now >= expiry, "sim_advance_idle_reaches_deadline");
+    static const uint8_t core_one[] = {1};
+    sim_set_script(sim, core_one, 1);
+    test_assert_true(sim_step(sim, NULL) == NULL, "sim_idle_step");
+    test_assert_equal(77, sim_timer_fired, "sim_timer_fired_on_virtual_time");
+    test_assert_equal(0, sim_advance_idle(sim), "sim_advance_idle_drained");
+
+    timer_wheel_destroy(states, 1);
+    sim_destroy(sim);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Main Sim Test Function
+// ------------------------------------------------------------
+void test_sim_main() {
+    printf("=== SIMULATION TEST SUITE ===\n");
+
+    test_sim_arguments();
+    test_sim_determinism();
+    test_sim_replay();
+    test_sim_virtual_time();
+    test_sim_idle();
+
+    printf("=== SIMULATION TEST SUITE COMPLETE ===\n");
+}
@@ -0,0 +1,258 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// test_stats.c — C test suite for the Statistics Snapshot
+// ------------------------------------------------------------
+// Tests stats.s: snapshot sizing and argument checks, per-scheduler
+// rows and totals after scheduling and stealing, OpenMetrics text,
+// and scraping the Unix-socket metrics server.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern uint64_t stats_snapshot_size(uint64_t cores);
+extern int stats_snapshot(void* scheduler_states, uint64_t cores, void* out);
+extern uint64_t stats_format_openmetrics(const void* snapshot, char* buffer, uint64_t capacity);
+extern void* stats_server_start(void* scheduler_states, uint64_t cores, const char* path);
+extern int stats_server_stop(void* server);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern void scheduler_init(void* scheduler_states, uint64_t core_id);
+extern int scheduler_enqueue_process(void* scheduler_states, uint64_t core_id, void* process, uint64_t priority);
+extern void* scheduler_schedule(void* scheduler_states, uint64_t core_id);
+extern void* steal_process(void* scheduler_states, uint64_t thief_core, uint64_t victim_core);
+
+// Snapshot layout (match config.inc)
+#define STATS_CORES 0
+#define STATS_UNSTABLE_ROWS 16
+#define STATS_HEADER_SIZE 24
+#define STATS_ROW_SCHEDULED 0
+#define STATS_ROW_MIGRATIONS 16
+#define STATS_ROW_STEALS 24
+#define STATS_ROW_STEAL_ATTEMPTS 32
+#define STATS_ROW_RUN_QUEUE 64
+#define STATS_ROW_PERF_ENABLED 72
+#define STATS_ROW_SIZE 280
+
+#define PRIORITY_NORMAL 2
+
+// Row 0 is the totals, row 1 + core is a scheduler
+static uint64_t stats_value(const uint8_t* snapshot, uint64_t row, uint64_t offset) {
+    return *(const uint64_t*)(snapshot + STATS_HEADER_SIZE + row * STATS_ROW_SIZE + offset);
+}
+
+// Fetch the endpoint's full response, NUL-terminated
+static size_t stats_scrape(const char* path, char* buffer, size_t capacity) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return 0;
+    }
+    const char* request = "GET /metrics HTTP/1.0\r\n\r\n";
+    if (write(fd, request, strlen(request)) < 0) {
+        close(fd);
+        return 0;
+    }
+    size_t length = 0;
+    ssize_t got;
+    while (length + 1 < capacity && (got = read(fd, buffer + length, capacity - 1 - length)) > 0) {
+        length += (size_t)got;
+    }
+    buffer[length] = '\0';
+    close(fd);
+    return length;
+}
+
+// ------------------------------------------------------------
+// Test Stats Snapshot
+// ------------------------------------------------------------
+void test_stats_snapshot() {
+    printf("--- Testing Stats Snapshot ---\n");
+
+    test_assert_equal(STATS_HEADER_SIZE + 3 * STATS_ROW_SIZE, stats_snapshot_size(2), "stats_size_two_cores");
+    test_assert_equal(0, stats_snapshot_size(0), "stats_size_zero_cores");
+    test_assert_equal(0, stats_snapshot_size(129), "stats_size_too_many_cores");
+
+    void* states = scheduler_state_init(2);
+    scheduler_init(states, 0);
+    scheduler_init(states, 1);
+    uint8_t* snapshot = calloc(1, stats_snapshot_size(2));
+    test_assert_equal(0, stats_snapshot(NULL, 2, snapshot), "stats_snapshot_null_states");
+    test_assert_equal(0, stats_snapshot(states, 0, snapshot), "stats_snapshot_zero_cores");
+    test_assert_equal(0, stats_snapshot(states, 2, NULL), "stats_snapshot_null_out");
+
+    // Core 0 dispatches two of four, core 1 steals one, core 0 tries to steal back
+    uint8_t* pcbs = calloc(4, PCB_SIZE);
+    for (int i = 0; i < 4; i++) {
+        scheduler_enqueue_process(states, 0, pcbs + i * PCB_SIZE, PRIORITY_NORMAL);
+    }
+    scheduler_schedule(states, 0);
+    scheduler_schedule(states, 0);
+    test_assert_true(steal_process(states, 1, 0) != NULL, "stats_steal_taken");
+    test_assert_true(steal_process(states, 0, 1) == NULL, "stats_steal_empty_victim");
+
+    test_assert_equal(1, stats_snapshot(states, 2, snapshot), "stats_snapshot_ok");
+    test_assert_equal(2, *(uint64_t*)(snapshot + STATS_CORES), "stats_snapshot_cores");
+    test_assert_equal(0, *(uint64_t*)(snapshot + STATS_UNSTABLE_ROWS), "stats_snapshot_quiet_rows_stable");
+    test_assert_equal(2, stats_value(snapshot, 1, STATS_ROW_SCHEDULED), "stats_core0_scheduled");
+    test_assert_equal(1, stats_value(snapshot, 1, STATS_ROW_STEAL_ATTEMPTS), "stats_core0_attempts");
+    test_assert_equal(0, stats_value(snapshot, 1, STATS_ROW_STEALS), "stats_core0_steals");
+    test_assert_equal(1, stats_value(snapshot, 1, STATS_ROW_RUN_QUEUE), "stats_core0_run_queue");
+    test_assert_equal(1, stats_value(snapshot, 2, STATS_ROW_STEALS), "stats_core1_steals");
+    test_assert_equal(1, stats_value(snapshot, 2, STATS_ROW_MIGRATIONS), "stats_core1_migrations");
+    test_assert_equal(1, stats_value(snapshot, 2, STATS_ROW_STEAL_ATTEMPTS), "stats_core1_attempts");
+    test_assert_equal(2, stats_value(snapshot, 0, STATS_ROW_SCHEDULED), "stats_total_scheduled");
+    test_assert_equal(2, stats_value(snapshot, 0, STATS_ROW_STEAL_ATTEMPTS), "stats_total_attempts");
+    test_assert_equal(1, stats_value(snapshot, 0, STATS_ROW_RUN_QUEUE), "stats_total_run_queue");
+    test_assert_equal(0, stats_value(snapshot, 0, STATS_ROW_PERF_ENABLED), "stats_total_perf_off");
+
+    // A second snapshot overwrites, never accumulates
+    test_assert_equal(1, stats_snapshot(states, 2, snapshot), "stats_snapshot_again");
+    test_assert_equal(2, stats_value(snapshot, 0, STATS_ROW_SCHEDULED), "stats_total_not_accumulated");
+
+    free(pcbs);
+    free(snapshot);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Stats OpenMetrics
+// ------------------------------------------------------------
+void test_stats_openmetrics() {
+    printf("--- Testing Stats OpenMetrics ---\n");
+
+    void* states = scheduler_state_init(2);
+    scheduler_init(states, 0);
+    scheduler_init(states, 1);
+    uint8_t* pcbs = calloc(2, PCB_SIZE);
+    scheduler_enqueue_process(states, 1, pcbs, PRIORITY_NORMAL);
+    scheduler_enqueue_process(states, 1, pcbs + PCB_SIZE, PRIORITY_NORMAL);
+    scheduler_schedule(states, 1);
+
+    uint8_t* snapshot = calloc(1, stats_snapshot_size(2));
+    stats_snapshot(states, 2, snapshot);
+    char* text = calloc(1, 8192);
+    uint64_t length = stats_format_openmetrics(snapshot, text, 8191);
+    test_assert_true(length > 0, "stats_openmetrics_written");
+    test_assert_equal(strlen(text), length, "stats_openmetrics_length");
+    test_assert_true(strstr(text, "# TYPE actly_scheduler_dispatches counter\n") != NULL, "stats_openmetrics_type");
+    test_assert_true(strstr(text, "# HELP actly_scheduler_dispatches ") != NULL, "stats_openmetrics_help");
+    test_assert_true(strstr(text, "actly_scheduler_dispatches_total{scheduler=\"0\"} 0\n") != NULL, "stats_openmetrics_core0");
+    test_assert_true(strstr(text, "actly_scheduler_dispatches_total{scheduler=\"1\"} 1\n") != NULL, "stats_openmetrics_core1");
+    test_assert_true(strstr(text, "# TYPE actly_scheduler_run_queue_length gauge\n") != NULL, "stats_openmetrics_gauge_type");
+    test_assert_true(strstr(text, "actly_scheduler_run_queue_length{scheduler=\"1\"} 1\n") != NULL, "stats_openmetrics_gauge_sample");
+    test_assert_true(strstr(text, "actly_scheduler_perf_events") == NULL, "stats_openmetrics_no_perf_family");
+    test_assert_true(length >= 6 && strcmp(text + length - 6, "# EOF\n") == 0, "stats_openmetrics_eof");
+
+    test_assert_equal(0, stats_format_openmetrics(snapshot, text, 64), "stats_openmetrics_too_small");
+    test_assert_equal(0, stats_format_openmetrics(NULL, text, 8191), "stats_openmetrics_null_snapshot");
+
+    free(text);
+    free(snapshot);
+    free(pcbs);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Stats Server
+// ------------------------------------------------------------
+void test_stats_server() {
+    printf("--- Testing Stats Server ---\n");
+
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/actly_stats_%d.sock", (int)getpid());
+    unlink(path);
+    char long_path[200];
+    memset(long_path, 'a', sizeof(long_path) - 1);
+    long_path[sizeof(long_path) - 1] = '\0';
+
+    void* states = scheduler_state_init(1);
+    scheduler_init(states, 0);
+    uint8_t* pcb = calloc(1, PCB_SIZE);
+    scheduler_enqueue_process(states, 0, pcb, PRIORITY_NORMAL);
+    scheduler_schedule(states, 0);
+
+    test_assert_true(stats_server_start(NULL, 1, path) == NULL, "stats_server_null_states");
+    test_assert_true(stats_server_start(states, 1, long_path) == NULL, "stats_server_path_too_long");
+    test_assert_equal(0, stats_server_stop(NULL), "stats_server_stop_null");
+
+    void* server = stats_server_start(states, 1, path);
+    test_assert_true(server != NULL, "stats_server_started");
+    test_assert_true(stats_server_start(states, 1, path) == NULL, "stats_server_path_in_use");
+
+    char* response = calloc(1, 16384);
+    size_t length = stats_scrape(path, response, 16384);
+    test_assert_true(length > 0, "stats_server_responded");
+    test_assert_true(strncmp(response, "HTTP/1.0 200 OK\r\n", 17) == 0, "stats_server_status");
+    test_assert_true(strstr(response, "application/openmetrics-text") != NULL, "stats_server_content_type");
+    test_assert_true(strstr(response, "actly_scheduler_dispatches_total{scheduler=\"0\"} 1\n") != NULL, "stats_server_sample");
+    test_assert_true(length >= 6 && strcmp(response + length - 6, "# EOF\n") == 0, "stats_server_eof");
+
+    // Each scrape takes a fresh snapshot
+    scheduler_enqueue_process(states, 0, pcb, PRIORITY_NORMAL);
+    scheduler_schedule(states, 0);
+    length = stats_scrape(path, response, 16384);
+    test_assert_true(strstr(response, "actly_scheduler_dispatches_total{scheduler=\"0\"} 2\n") != NULL, "stats_server_fresh_snapshot");
+
+    test_assert_equal(1, stats_server_stop(server), "stats_server_stopped");
+    test_assert_true(access(path, F_OK) != 0, "stats_server_socket_removed");
+
+    free(response);
+    free(pcb);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Main Stats Test Function
+// ------------------------------------------------------------
+void test_stats_main() {
+    printf("=== STATISTICS TEST SUITE ===\n");
+
+    test_stats_snapshot();
+    test_stats_openmetrics();
+    test_stats_server();
+
+    printf("=== STATISTICS TEST SUITE COMPLETE ===\n");
+}
@@ -0,0 +1,294 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// ------------------------------------------------------------
+// test_term.c — C test suite for Tagged-Word Terms
+// ------------------------------------------------------------
+// Tests term.s: immediate encodings and their one-bit tag tests,
+// tuple, list and binary construction on a PCB heap, heap exhaustion,
+// deep copy between two process heaps, structural equality and a
+// linear walk over a heap region.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern uint64_t term_make_int(int64_t value);
+extern int64_t term_int_value(uint64_t term);
+extern uint64_t term_make_atom(uint64_t index);
+extern uint64_t term_atom_index(uint64_t term);
+extern uint64_t term_make_pid(uint64_t pid);
+extern uint64_t term_pid_value(uint64_t term);
+extern uint64_t term_type(uint64_t term);
+extern uint64_t term_tuple(void* pcb, uint64_t arity);
+extern uint64_t term_tuple_arity(uint64_t term);
+extern uint64_t term_element(uint64_t tuple, uint64_t index);
+extern int term_set_element(uint64_t tuple, uint64_t index, uint64_t value);
+extern uint64_t term_cons(void* pcb, uint64_t head, uint64_t tail);
+extern uint64_t term_head(uint64_t list);
+extern uint64_t term_tail(uint64_t list);
+extern uint64_t term_binary(void* pcb, const uint8_t* data, uint64_t length);
+extern uint64_t term_binary_size(uint64_t term);
+extern const uint8_t* term_binary_data(uint64_t term);
+extern uint64_t term_size(uint64_t term);
+extern uint64_t term_copy(void* pcb, uint64_t term);
+extern int term_equal(uint64_t a, uint64_t b);
+extern uint64_t* term_heap_next(uint64_t* object);
+
+// Term constants (match config.inc)
+#define TERM_TAG_MASK 7
+#define TERM_TAG_BOXED 1
+#define TERM_TAG_LIST 2
+#define TERM_TAG_IMMEDIATE 4
+#define TERM_NIL 0x14
+#define TERM_NONE 0x34
+#define TERM_FALSE 0x04
+#define TERM_TRUE 0x24
+#define TERM_TYPE_INT 0
+#define TERM_TYPE_ATOM 1
+#define TERM_TYPE_PID 2
+#define TERM_TYPE_NIL 3
+#define TERM_TYPE_TUPLE 4
+#define TERM_TYPE_LIST 5
+#define TERM_TYPE_BINARY 6
+#define TERM_TYPE_NONE 7
+
+#define TERM_TEST_HEAP_WORDS 256
+
+// {@ok, [1, 2, 3], <<"actly">>, {Pid, []}}
+static uint64_t term_test_sample(void* pcb) {
+    uint64_t list = TERM_NIL;
+    for (int64_t i = 3; i >= 1; i--) {
+        list = term_cons(pcb, term_make_int(i), list);
+    }
+    uint64_t inner = term_tuple(pcb, 2);
+    term_set_element(inner, 0, term_make_pid(42));
+    uint64_t tuple = term_tuple(pcb, 4);
+    term_set_element(tuple, 0, term_make_atom(7));
+    term_set_element(tuple, 1, list);
+    term_set_element(tuple, 2, term_binary(pcb, (const uint8_t*)"actly", 5));
+    term_set_element(tuple, 3, inner);
+    return tuple;
+}
+
+static void test_term_immediates() {
+    printf("\n--- Testing term immediates ---\n");
+
+    uint64_t five = term_make_int(5);
+    uint64_t minus = term_make_int(-9);
+    test_assert_equal(0, five & TERM_TAG_MASK, "small integer tag is 000");
+    test_assert_equal(5, (uint64_t)term_int_value(five), "small integer round trip");
+    test_assert_equal((uint64_t)-9, (uint64_t)term_int_value(minus), "negative integer round trip");
+    test_assert_equal((uint64_t)-4, (uint64_t)term_int_value(five + minus), "tagged integers add without untagging");
+    test_assert_equal((uint64_t)((1ULL << 60) - 1), (uint64_t)term_int_value(term_make_int((int64_t)((1ULL << 60) - 1))),
+                      "largest small integer");
+    test_assert_equal(TERM_NONE, term_make_int((int64_t)(1ULL << 60)), "integer out of range is rejected");
+
+    uint64_t atom = term_make_atom(7);
+    test_assert_true((atom & TERM_TAG_IMMEDIATE) != 0, "atom is an immediate");
+    test_assert_equal(7, term_atom_index(atom), "atom index round trip");
+    test_assert_equal(TERM_FALSE, term_make_atom(0), "atom 0 is @false");
+    test_assert_equal(TERM_TRUE, term_make_atom(1), "atom 1 is @true");
+    test_assert_equal(TERM_NONE, term_make_atom(1ULL << 59), "atom index out of range is rejected");
+
+    uint64_t pid = term_make_pid(1234);
+    test_assert_equal(1234, term_pid_value(pid), "pid round trip");
+
+    test_assert_equal(TERM_TYPE_INT, term_type(five), "type of integer");
+    test_assert_equal(TERM_TYPE_ATOM, term_type(atom), "type of atom");
+    test_assert_equal(TERM_TYPE_PID, term_type(pid), "type of pid");
+    test_assert_equal(TERM_TYPE_NIL, term_type(TERM_NIL), "type of []");
+    test_assert_equal(TERM_TYPE_NONE, term_type(TERM_NONE), "type of TERM_NONE");
+    test_assert_true(term_equal(term_make_int(5), five), "equal integers");
+    test_assert_true(!term_equal(atom, pid), "atom and pid differ");
+}
+
+static void test_term_construction() {
+    printf("\n--- Testing term construction ---\n");
+
+    void* pcb = test_pcb_with_heap(TERM_TEST_HEAP_WORDS);
+
+    uint64_t tuple = term_tuple(pcb, 3);
+    test_assert_equal(TERM_TAG_BOXED, tuple & TERM_TAG_MASK, "tuple is boxed");
+    test_assert_equal(TERM_TYPE_TUPLE, term_type(tuple), "type of tuple");
+    test_assert_equal(3, term_tuple_arity(tuple), "tuple arity");
+    test_assert_equal(TERM_NIL, term_element(tuple, 2), "new tuple elements are []");
+    test_assert_true(term_set_element(tuple, 1, term_make_int(11)), "set element");
+    test_assert_equal(11, (uint64_t)term_int_value(term_element(tuple, 1)), "element round trip");
+    test_assert_equal(TERM_NONE, term_element(tuple, 3), "element index out of range");
+    test_assert_true(!term_set_element(tuple, 3, TERM_NIL), "set element out of range");
+    test_assert_equal(0, term_tuple_arity(term_make_int(1)), "arity of a non-tuple");
+    test_assert_equal(4 * 8, test_pcb_heap_used(pcb), "tuple is header plus elements");
+
+    uint64_t empty = term_tuple(pcb, 0);
+    test_assert_equal(0, term_tuple_arity(empty), "empty tuple");
+
+    uint64_t list = term_cons(pcb, term_make_int(1), TERM_NIL);
+    test_assert_equal(TERM_TAG_LIST, list & TERM_TAG_MASK, "cons is a list pointer");
+    test_assert_equal(TERM_TYPE_LIST, term_type(list), "type of list");
+    test_assert_equal(1, (uint64_t)term_int_value(term_head(list)), "head");
+    test_assert_equal(TERM_NIL, term_tail(list), "tail");
+    test_assert_equal(TERM_NONE, term_head(TERM_NIL), "head of []");
+
+    const char* text = "tagged words!";
+    uint64_t binary = term_binary(pcb, (const uint8_t*)text, strlen(text));
+    test_assert_equal(TERM_TYPE_BINARY, term_type(binary), "type of binary");
+    test_assert_equal(strlen(text), term_binary_size(binary), "binary size");
+    test_assert_true(memcmp(term_binary_data(binary), text, strlen(text)) == 0, "binary bytes");
+    test_assert_equal(0, term_binary_data(binary)[strlen(text)], "binary padding is zeroed");
+    test_assert_true(term_binary_data(tuple) == NULL, "binary data of a non-binary");
+    test_assert_equal(TERM_NONE, term_binary(pcb, NULL, 4), "binary without data");
+    test_assert_equal(0, term_binary_size(term_binary(pcb, NULL, 0)), "empty binary");
+
+    test_assert_equal(TERM_NONE, term_tuple(NULL, 1), "tuple without a PCB");
+
+    test_pcb_free(pcb);
+}
+
+static void test_term_exhaustion() {
+    printf("\n--- Testing term heap exhaustion ---\n");
+
+    void* pcb = test_pcb_with_heap(8);
+    test_assert_true(term_tuple(pcb, 7) != TERM_NONE, "tuple fills the heap exactly");
+    test_assert_equal(TERM_NONE, term_cons(pcb, TERM_NIL, TERM_NIL), "cons on a full heap");
+    test_assert_equal(TERM_NONE, term_tuple(pcb, 0), "tuple on a full heap");
+    test_assert_equal(8 * 8, test_pcb_heap_used(pcb), "failed allocations do not move the heap");
+    test_pcb_free(pcb);
+
+    void* source = test_pcb_with_heap(TERM_TEST_HEAP_WORDS);
+    void* small = test_pcb_with_heap(4);
+    uint64_t sample = term_test_sample(source);
+    test_assert_equal(TERM_NONE, term_copy(small, sample), "copy into a heap that is too small");
+    test_assert_equal(0, test_pcb_heap_used(small), "failed copy leaves nothing behind");
+    test_pcb_free(source);
+    test_pcb_free(small);
+}
+
+static void test_term_copy() {
+    printf("\n--- Testing term copy between heaps ---\n");
+
+    void* sender = test_pcb_with_heap(TERM_TEST_HEAP_WORDS);
+    void* receiver = test_pcb_with_heap(TERM_TEST_HEAP_WORDS);
+
+    uint64_t sample = term_test_sample(sender);
+    uint64_t words = term_size(sample);
+    // Tuple 5 + three cons cells 6 + binary 2 + inner tuple 3
+    test_assert_equal(16, words, "deep size of the sample");
+    test_assert_equal(words * 8, test_pcb_heap_used(sender), "size matches what was allocated");
+    test_assert_equal(0, term_size(term_make_atom(3)), "immediates need no heap");
+
+    uint64_t copy = term_copy(receiver, sample);
+    test_assert_true(copy != sample, "copy is a new term");
+    test_assert_equal(words * 8, test_pcb_heap_used(receiver), "copy is one allocation of term_size words");
+    test_assert_true(term_equal(sample, copy), "copy is structurally equal");
+
+    // Nothing in the copy points back into the sender's heap
+    uint8_t* heap = *(uint8_t**)((uint8_t*)sender + PCB_HEAP_BASE_OFFSET);
+    memset(heap, 0, TERM_TEST_HEAP_WORDS * 8);
+    test_assert_equal(7, term_atom_index(term_element(copy, 0)), "copied atom");
+    uint64_t list = term_element(copy, 1);
+    test_assert_equal(3, (uint64_t)term_int_value(term_head(term_tail(term_tail(list)))), "copied list");
+    test_assert_equal(TERM_NIL, term_tail(term_tail(term_tail(list))), "copied list is proper");
+    test_assert_true(memcmp(term_binary_data(term_element(copy, 2)), "actly", 5) == 0, "copied binary");
+    test_assert_equal(42, term_pid_value(term_element(term_element(copy, 3), 0)), "copied nested tuple");
+
+    test_assert_equal(term_make_int(9), term_copy(receiver, term_make_int(9)), "immediates copy by value");
+
+    test_pcb_free(sender);
+    test_pcb_free(receiver);
+}
+
+static void test_term_equality() {
+    printf("\n--- Testing term equality ---\n");
+
+    void* a = test_pcb_with_heap(TERM_TEST_HEAP_WORDS);
+    void* b = test_pcb_with_heap(TERM_TEST_HEAP_WORDS);
+
+    uint64_t x = term_test_sample(a);
+    uint64_t y = term_test_sample(b);
+    test_assert_true(term_equal(x, y), "equal terms on different heaps");
+
+    term_set_element(term_element(y, 3), 1, term_make_int(0));
+    test_assert_true(!term_equal(x, y), "nested difference is found");
+
+    uint64_t short_list = term_cons(a, term_make_int(1), TERM_NIL);
+    uint64_t long_list = term_cons(b, term_make_int(1), term_cons(b, term_make_int(2), TERM_NIL));
+    test_assert_true(!term_equal(short_list, long_list), "lists of different length");
+
+    uint64_t improper_a = term_cons(a, term_make_int(1), term_make_int(2));
+    uint64_t improper_b = term_cons(b, term_make_int(1), term_make_int(2));
+    test_assert_true(term_equal(improper_a, improper_b), "improper lists compare their tails");
+
+    test_assert_true(!term_equal(term_binary(a, (const uint8_t*)"abc", 3), term_binary(b, (const uint8_t*)"abd", 3)),
+                     "binaries with different bytes");
+    test_assert_true(!term_equal(term_binary(a, (const uint8_t*)"ab", 2), term_tuple(b, 2)),
+                     "binary and tuple differ");
+
+    test_pcb_free(a);
+    test_pcb_free(b);
+}
+
+static void test_term_heap_walk() {
+    printf("\n--- Testing term heap walk ---\n");
+
+    void* pcb = test_pcb_with_heap(TERM_TEST_HEAP_WORDS);
+    term_test_sample(pcb);
+
+    uint64_t* object = *(uint64_t**)((uint8_t*)pcb + PCB_HEAP_BASE_OFFSET);
+    uint64_t* end = *(uint64_t**)((uint8_t*)pcb + PCB_HEAP_POINTER_OFFSET);
+    int objects = 0;
+    while (object < end) {
+        object = term_heap_next(object);
+        objects++;
+    }
+    // Three cons cells, the inner tuple, the binary and the outer tuple
+    test_assert_equal(6, objects, "walk visits every object");
+    test_assert_true(object == end, "walk ends at the heap pointer");
+
+    test_pcb_free(pcb);
+}
+
+void test_term_main() {
+    printf("=== TERM TEST SUITE ===\n");
+
+    test_term_immediates();
+    test_term_construction();
+    test_term_exhaustion();
+    test_term_copy();
+    test_term_equality();
+    test_term_heap_walk();
+
+    printf("=== TERM TEST SUITE COMPLETE ===\n");
+}
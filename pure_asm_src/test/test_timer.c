@@ -24,12 +24,12 @@
 // test_timer.c — C test suite for Timer System
 // ------------------------------------------------------------
 // Tests the timer and timeout functions implemented in timer.s.
-// This includes timer initialization, insertion, cancellation,
-// timeout scheduling, and timer processing.
+// This includes timer insertion, cancellation, timeout scheduling
+// and timer processing on the per-core timer wheels.
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 #include <stdio.h>
 #include <stdint.h>
@@ -41,30 +41,51 @@ void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name
 void test_assert_true(int condition, const char* test_name);
 
 // External assembly functions
-extern int timer_init(void);
 extern uint64_t get_system_ticks(void);
-extern uint64_t insert_timer(uint64_t expiry_ticks, void* callback, uint64_t process_id);
 extern int cancel_timer(uint64_t timer_id);
-extern uint32_t process_timers(void);
-extern void timer_tick(void);
-extern uint64_t schedule_timeout(uint64_t timeout_ticks, uint64_t process_id);
 extern int cancel_timeout(uint64_t timeout_id);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern int scheduler_state_destroy(void* scheduler_states);
+extern int timer_wheel_init(void* scheduler_states, uint64_t core_id);
+extern int timer_wheel_destroy(void* scheduler_states, uint64_t core_id);
+extern uint64_t timer_arm(void* scheduler_states, uint64_t core_id, void* pcb,
+                          uint64_t expiry_ticks, void* callback, uint64_t argument);
+extern uint64_t timer_arm_slack(void* scheduler_states, uint64_t core_id, void* pcb,
+                                uint64_t expiry_ticks, void* callback, uint64_t argument,
+                                uint64_t slack_ticks);
+extern int timer_wheel_set_default_slack(void* scheduler_states, uint64_t core_id, uint64_t slack_ticks);
+extern uint64_t timer_wheel_next_deadline(void* scheduler_states, uint64_t core_id);
+extern uint64_t send_after(void* scheduler_states, uint64_t core_id, void* target_pcb,
+                           uint64_t delay_ticks, uint64_t message);
+extern uint64_t send_interval(void* scheduler_states, uint64_t core_id, void* target_pcb,
+                              uint64_t interval_ticks, uint64_t message);
+extern uint64_t scheduler_refresh_now(void* scheduler_states, uint64_t core_id);
+extern int message_queue_init(void* queue_ptr, uint32_t size);
+extern uint32_t message_queue_size(void* queue_ptr);
+extern uint64_t try_receive_message(void* receiver_pcb);
+extern uint64_t timer_wheel_process(void* scheduler_states, uint64_t core_id, uint64_t now);
+extern void timer_wheel_tick(void* scheduler_states, uint64_t core_id);
+extern uint64_t timer_wheel_next_expiry(void* scheduler_states, uint64_t core_id);
+extern uint64_t timer_wheel_count(void* scheduler_states, uint64_t core_id);
 
-// Test callback function
-static uint64_t test_callback_called = 0;
-static void test_callback(void) {
-    test_callback_called++;
+// Wheel callback records where it ran and with what argument
+static uint64_t wheel_callback_count = 0;
+static uint64_t wheel_callback_core = 0;
+static uint64_t wheel_callback_argument = 0;
+static void wheel_callback(void* scheduler_states, uint64_t core_id, void* pcb, uint64_t argument) {
+    (void)scheduler_states;
+    (void)pcb;
+    wheel_callback_count++;
+    wheel_callback_core = core_id;
+    wheel_callback_argument = argument;
 }
 
-// ------------------------------------------------------------
-// Test Timer Initialization
-// ------------------------------------------------------------
-void test_timer_init_basic() {
-    printf("--- Testing Timer Initialization ---\n");
-    
-    int result = timer_init();
-    test_assert_equal(1, result, "timer_init_basic");
-}
+// Wheel slot granularity and span (matches TIMER_WHEEL_SHIFT/SLOTS)
+#define WHEEL_TICK (1ULL << 14)
+#define WHEEL_SPAN (256ULL * WHEEL_TICK)
+
+// Node address part of a timer ID (generation in bits 48-63)
+#define TIMER_ID_NODE_MASK 0xFFFFFFFFFFFFULL
 
 // ------------------------------------------------------------
 // Test System Ticks
@@ -84,20 +105,22 @@ void test_system_ticks() {
 // ------------------------------------------------------------
 void test_timer_insertion() {
     printf("--- Testing Timer Insertion ---\n");
-    
-    uint64_t expiry = 1000;
-    void* callback = (void*)test_callback;
-    uint64_t process_id = 123;
-    
-    uint64_t timer_id = insert_timer(expiry, callback, process_id);
+
+    void* states = scheduler_state_init(1);
+    uint64_t expiry = get_system_ticks() + WHEEL_TICK;
+
+    uint64_t timer_id = timer_arm(states, 0, NULL, expiry, (void*)wheel_callback, 123);
     test_assert_true(timer_id != 0, "timer_insertion_success");
-    
+    test_assert_equal(1, timer_wheel_count(states, 0), "timer_insertion_linked");
+
     // Test insertion with invalid parameters
-    uint64_t invalid_timer = insert_timer(0, callback, process_id);
-    test_assert_equal(0, invalid_timer, "timer_insertion_invalid_expiry");
-    
-    invalid_timer = insert_timer(expiry, NULL, process_id);
-    test_assert_equal(0, invalid_timer, "timer_insertion_invalid_callback");
+    test_assert_equal(0, timer_arm(states, 0, NULL, 0, (void*)wheel_callback, 123), "timer_insertion_invalid_expiry");
+    test_assert_equal(0, timer_arm(NULL, 0, NULL, expiry, (void*)wheel_callback, 123), "timer_insertion_null_states");
+    test_assert_equal(0, timer_arm(states, 128, NULL, expiry, (void*)wheel_callback, 123), "timer_insertion_invalid_core");
+
+    cancel_timer(timer_id);
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
 }
 
 // ------------------------------------------------------------
@@ -105,12 +128,11 @@ void test_timer_insertion() {
 // ------------------------------------------------------------
 void test_timer_cancellation() {
     printf("--- Testing Timer Cancellation ---\n");
-    
-    uint64_t expiry = 1000;
-    void* callback = (void*)test_callback;
-    uint64_t process_id = 123;
-    
-    uint64_t timer_id = insert_timer(expiry, callback, process_id);
+
+    void* states = scheduler_state_init(1);
+    uint64_t expiry = get_system_ticks() + WHEEL_TICK;
+
+    uint64_t timer_id = timer_arm(states, 0, NULL, expiry, (void*)wheel_callback, 123);
     test_assert_true(timer_id != 0, "timer_cancellation_setup");
     
     int result = cancel_timer(timer_id);
@@ -119,6 +141,9 @@ void test_timer_cancellation() {
     // Test cancellation of invalid timer
     result = cancel_timer(0);
     test_assert_equal(0, result, "timer_cancellation_invalid");
+
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
 }
 
 // ------------------------------------------------------------
@@ -126,14 +151,21 @@ void test_timer_cancellation() {
 // ------------------------------------------------------------
 void test_timer_processing() {
     printf("--- Testing Timer Processing ---\n");
-    
-    uint32_t expired_count = process_timers();
-    test_assert_equal(0, expired_count, "timer_processing_no_expired");
-    
-    // Test timer tick
-    timer_tick();
-    // Should not crash
-    test_assert_true(1, "timer_tick_execution");
+
+    void* states = scheduler_state_init(1);
+    timer_wheel_init(states, 0);
+    uint64_t now = scheduler_refresh_now(states, 0);
+
+    test_assert_equal(0, timer_wheel_process(states, 0, now), "timer_processing_no_expired");
+
+    // The per-pass tick runs the wheel at the scheduler's cached clock
+    wheel_callback_count = 0;
+    timer_arm(states, 0, NULL, now, (void*)wheel_callback, 1);
+    timer_wheel_tick(states, 0);
+    test_assert_equal(1, wheel_callback_count, "timer_tick_fires_due");
+
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
 }
 
 // ------------------------------------------------------------
@@ -141,19 +173,23 @@ void test_timer_processing() {
 // ------------------------------------------------------------
 void test_timeout_scheduling() {
     printf("--- Testing Timeout Scheduling ---\n");
-    
-    uint64_t timeout_ticks = 500;
-    uint64_t process_id = 456;
-    
-    uint64_t timeout_id = schedule_timeout(timeout_ticks, process_id);
+
+    // A timeout is a timer with a PCB and no callback (it wakes the process)
+    void* states = scheduler_state_init(1);
+    uint64_t pcb[64];
+    memset(pcb, 0, sizeof(pcb));
+    uint64_t expiry = get_system_ticks() + 500;
+
+    uint64_t timeout_id = timer_arm(states, 0, pcb, expiry, NULL, 0);
     test_assert_true(timeout_id != 0, "timeout_scheduling_success");
     
     // Test timeout with invalid parameters
-    uint64_t invalid_timeout = schedule_timeout(0, process_id);
-    test_assert_equal(0, invalid_timeout, "timeout_scheduling_invalid_ticks");
-    
-    invalid_timeout = schedule_timeout(timeout_ticks, 0);
-    test_assert_equal(0, invalid_timeout, "timeout_scheduling_invalid_process");
+    test_assert_equal(0, timer_arm(states, 0, pcb, 0, NULL, 0), "timeout_scheduling_invalid_ticks");
+    test_assert_equal(0, timer_arm(states, 128, pcb, expiry, NULL, 0), "timeout_scheduling_invalid_core");
+
+    cancel_timeout(timeout_id);
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
 }
 
 // ------------------------------------------------------------
@@ -161,11 +197,12 @@ void test_timeout_scheduling() {
 // ------------------------------------------------------------
 void test_timeout_cancellation() {
     printf("--- Testing Timeout Cancellation ---\n");
-    
-    uint64_t timeout_ticks = 500;
-    uint64_t process_id = 456;
-    
-    uint64_t timeout_id = schedule_timeout(timeout_ticks, process_id);
+
+    void* states = scheduler_state_init(1);
+    uint64_t pcb[64];
+    memset(pcb, 0, sizeof(pcb));
+
+    uint64_t timeout_id = timer_arm(states, 0, pcb, get_system_ticks() + 500, NULL, 0);
     test_assert_true(timeout_id != 0, "timeout_cancellation_setup");
     
     int result = cancel_timeout(timeout_id);
@@ -174,6 +211,9 @@ void test_timeout_cancellation() {
     // Test cancellation of invalid timeout
     result = cancel_timeout(0);
     test_assert_equal(0, result, "timeout_cancellation_invalid");
+
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
 }
 
 // ------------------------------------------------------------
@@ -181,13 +221,12 @@ void test_timeout_cancellation() {
 // ------------------------------------------------------------
 void test_timer_edge_cases() {
     printf("--- Testing Timer Edge Cases ---\n");
-    
+
+    void* states = scheduler_state_init(1);
+    uint64_t now = get_system_ticks();
+
     // Test very large expiry time
-    uint64_t large_expiry = UINT64_MAX;
-    void* callback = (void*)test_callback;
-    uint64_t process_id = 789;
-    
-    uint64_t timer_id = insert_timer(large_expiry, callback, process_id);
+    uint64_t timer_id = timer_arm(states, 0, NULL, UINT64_MAX, (void*)wheel_callback, 789);
     test_assert_true(timer_id != 0, "timer_edge_case_large_expiry");
     
     // Cancel the timer
@@ -195,20 +234,265 @@ void test_timer_edge_cases() {
     test_assert_equal(1, result, "timer_edge_case_cancel_large");
     
     // Test multiple timers
-    uint64_t timer1 = insert_timer(1000, callback, 1);
-    uint64_t timer2 = insert_timer(2000, callback, 2);
-    uint64_t timer3 = insert_timer(3000, callback, 3);
+    uint64_t timer1 = timer_arm(states, 0, NULL, now + 1000, (void*)wheel_callback, 1);
+    uint64_t timer2 = timer_arm(states, 0, NULL, now + 2000, (void*)wheel_callback, 2);
+    uint64_t timer3 = timer_arm(states, 0, NULL, now + 3000, (void*)wheel_callback, 3);
     
     test_assert_true(timer1 != 0, "timer_edge_case_multiple_1");
     test_assert_true(timer2 != 0, "timer_edge_case_multiple_2");
     test_assert_true(timer3 != 0, "timer_edge_case_multiple_3");
     
     // Cancel all timers
-    cancel_timer(timer1);
-    cancel_timer(timer2);
-    cancel_timer(timer3);
-    
-    test_assert_true(1, "timer_edge_case_multiple_cancel");
+    test_assert_equal(1, cancel_timer(timer1), "timer_edge_case_multiple_cancel_1");
+    test_assert_equal(1, cancel_timer(timer2), "timer_edge_case_multiple_cancel_2");
+    test_assert_equal(1, cancel_timer(timer3), "timer_edge_case_multiple_cancel_3");
+
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Per-Core Timer Wheel
+// ------------------------------------------------------------
+void test_timer_wheel_basic() {
+    printf("--- Testing Per-Core Timer Wheel ---\n");
+
+    void* states = scheduler_state_init(2);
+    test_assert_true(states != NULL, "timer_wheel_setup");
+
+    // Arming without a wheel creates it on first use
+    uint64_t lazy = timer_arm(states, 1, NULL, 100, (void*)wheel_callback, 0);
+    test_assert_true(lazy != 0, "timer_wheel_arm_lazy_init");
+    test_assert_equal(1, timer_wheel_count(states, 1), "timer_wheel_lazy_count");
+    test_assert_equal(1, cancel_timer(lazy), "timer_wheel_lazy_cancel");
+    timer_wheel_destroy(states, 1);
+
+    test_assert_equal(1, timer_wheel_init(states, 0), "timer_wheel_init");
+    test_assert_equal(1, timer_wheel_init(states, 0), "timer_wheel_init_idempotent");
+    test_assert_equal(0, timer_wheel_init(states, 128), "timer_wheel_init_invalid_core");
+    test_assert_equal(UINT64_MAX, timer_wheel_next_expiry(states, 0), "timer_wheel_empty_next_expiry");
+
+    uint64_t now = get_system_ticks();
+
+    // A timer that is already due fires on the next pass
+    wheel_callback_count = 0;
+    uint64_t due = timer_arm(states, 0, NULL, now, (void*)wheel_callback, 42);
+    test_assert_true(due != 0, "timer_wheel_arm_due");
+    test_assert_equal(1, timer_wheel_count(states, 0), "timer_wheel_count_one");
+    test_assert_equal(now, timer_wheel_next_expiry(states, 0), "timer_wheel_next_expiry_tracks_min");
+    test_assert_equal(1, timer_wheel_process(states, 0, now), "timer_wheel_fires_due");
+    test_assert_equal(1, wheel_callback_count, "timer_wheel_callback_ran");
+    test_assert_equal(42, wheel_callback_argument, "timer_wheel_callback_argument");
+    test_assert_equal(0, timer_wheel_count(states, 0), "timer_wheel_count_after_fire");
+
+    // A future timer does not fire early, then fires on time
+    uint64_t later = now + 3 * WHEEL_TICK;
+    timer_arm(states, 0, NULL, later, (void*)wheel_callback, 7);
+    test_assert_equal(0, timer_wheel_process(states, 0, now + WHEEL_TICK), "timer_wheel_not_early");
+    test_assert_true(timer_wheel_next_expiry(states, 0) <= later, "timer_wheel_bound_not_late");
+    test_assert_equal(1, timer_wheel_process(states, 0, later), "timer_wheel_fires_on_time");
+
+    // A timer more than one rotation away survives a full pass
+    uint64_t far = later + WHEEL_SPAN + WHEEL_TICK;
+    timer_arm(states, 0, NULL, far, (void*)wheel_callback, 8);
+    test_assert_equal(0, timer_wheel_process(states, 0, later + WHEEL_TICK), "timer_wheel_far_not_early");
+    test_assert_equal(1, timer_wheel_process(states, 0, far), "timer_wheel_far_fires");
+
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Timer Wheel Cancellation
+// ------------------------------------------------------------
+void test_timer_wheel_cancellation() {
+    printf("--- Testing Timer Wheel Cancellation ---\n");
+
+    void* states = scheduler_state_init(2);
+    timer_wheel_init(states, 0);
+    uint64_t now = get_system_ticks();
+
+    wheel_callback_count = 0;
+    uint64_t timer = timer_arm(states, 0, NULL, now + WHEEL_TICK, (void*)wheel_callback, 1);
+    test_assert_equal(1, cancel_timer(timer), "timer_wheel_cancel_armed");
+    test_assert_equal(0, cancel_timer(timer), "timer_wheel_cancel_twice");
+
+    // Cancelled timer never fires and is reclaimed when its slot is visited
+    test_assert_equal(0, timer_wheel_process(states, 0, now + 2 * WHEEL_TICK), "timer_wheel_cancelled_not_fired");
+    test_assert_equal(0, wheel_callback_count, "timer_wheel_cancelled_no_callback");
+    test_assert_equal(0, timer_wheel_count(states, 0), "timer_wheel_cancelled_reclaimed");
+
+    // Fired timers cannot be cancelled
+    uint64_t fired = timer_arm(states, 0, NULL, now, (void*)wheel_callback, 2);
+    timer_wheel_process(states, 0, now + 2 * WHEEL_TICK);
+    test_assert_equal(0, cancel_timer(fired), "timer_wheel_cancel_after_fire");
+
+    // The fired node is recycled under a new ID; the stale one cannot cancel it
+    uint64_t reused = timer_arm(states, 0, NULL, now + WHEEL_TICK, (void*)wheel_callback, 3);
+    test_assert_equal(fired & TIMER_ID_NODE_MASK, reused & TIMER_ID_NODE_MASK, "timer_wheel_node_reused");
+    test_assert_true(reused != fired, "timer_wheel_reused_new_id");
+    test_assert_equal(0, cancel_timer(fired), "timer_wheel_stale_cancel_rejected");
+    test_assert_equal(0, cancel_timer(timer), "timer_wheel_older_stale_cancel_rejected");
+    test_assert_equal(1, timer_wheel_process(states, 0, now + 3 * WHEEL_TICK), "timer_wheel_reused_still_fires");
+
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Timer Wheel Migration
+// ------------------------------------------------------------
+void test_timer_wheel_migration() {
+    printf("--- Testing Timer Wheel Migration ---\n");
+
+    void* states = scheduler_state_init(2);
+    timer_wheel_init(states, 0);
+    timer_wheel_init(states, 1);
+    uint64_t now = get_system_ticks();
+
+    // PCB armed the timer on core 0, then was stolen by core 1
+    uint64_t pcb[64];
+    memset(pcb, 0, sizeof(pcb));
+    pcb[3] = 0;  // pcb_scheduler_id
+    wheel_callback_count = 0;
+    timer_arm(states, 0, pcb, now, (void*)wheel_callback, 9);
+    pcb[3] = 1;
+
+    // Core 0 forwards instead of firing; core 1 fires it
+    test_assert_equal(0, timer_wheel_process(states, 0, now), "timer_wheel_migration_forwarded");
+    test_assert_equal(0, wheel_callback_count, "timer_wheel_migration_not_fired_on_source");
+    test_assert_equal(1, timer_wheel_process(states, 1, now), "timer_wheel_migration_fired_on_target");
+    test_assert_equal(1, wheel_callback_core, "timer_wheel_migration_callback_core");
+
+    // Cancelling while in flight between cores is honored
+    pcb[3] = 0;
+    uint64_t timer = timer_arm(states, 0, pcb, now, (void*)wheel_callback, 10);
+    pcb[3] = 1;
+    timer_wheel_process(states, 0, now);
+    test_assert_equal(1, cancel_timer(timer), "timer_wheel_migration_cancel_in_flight");
+    test_assert_equal(0, timer_wheel_process(states, 1, now), "timer_wheel_migration_cancelled_not_fired");
+
+    timer_wheel_destroy(states, 0);
+    timer_wheel_destroy(states, 1);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Timer Slack Coalescing
+// ------------------------------------------------------------
+void test_timer_wheel_slack() {
+    printf("--- Testing Timer Slack Coalescing ---\n");
+
+    void* states = scheduler_state_init(2);
+    test_assert_equal(0, timer_wheel_set_default_slack(states, 0, WHEEL_TICK), "timer_slack_default_no_wheel");
+    test_assert_equal(UINT64_MAX, timer_wheel_next_deadline(states, 0), "timer_slack_deadline_no_wheel");
+    timer_wheel_init(states, 0);
+    test_assert_equal(UINT64_MAX, timer_wheel_next_deadline(states, 0), "timer_slack_deadline_empty");
+    uint64_t now = get_system_ticks();
+
+    // Deadline is expiry + slack
+    wheel_callback_count = 0;
+    timer_arm_slack(states, 0, NULL, now + WHEEL_TICK, (void*)wheel_callback, 1, 4 * WHEEL_TICK);
+    test_assert_equal(now + WHEEL_TICK, timer_wheel_next_expiry(states, 0), "timer_slack_expiry_unchanged");
+    test_assert_equal(now + 5 * WHEEL_TICK, timer_wheel_next_deadline(states, 0), "timer_slack_deadline");
+
+    // A tighter timer pulls the deadline in; one wakeup fires both
+    timer_arm_slack(states, 0, NULL, now + 3 * WHEEL_TICK, (void*)wheel_callback, 2, 0);
+    uint64_t deadline = timer_wheel_next_deadline(states, 0);
+    test_assert_equal(now + 3 * WHEEL_TICK, deadline, "timer_slack_deadline_min");
+    test_assert_equal(2, timer_wheel_process(states, 0, deadline), "timer_slack_batched_wakeup");
+    test_assert_equal(UINT64_MAX, timer_wheel_next_deadline(states, 0), "timer_slack_deadline_consumed");
+
+    // Slack never lets a timer fire early
+    timer_arm_slack(states, 0, NULL, now + 6 * WHEEL_TICK, (void*)wheel_callback, 3, 8 * WHEEL_TICK);
+    test_assert_equal(0, timer_wheel_process(states, 0, now + 5 * WHEEL_TICK), "timer_slack_not_early");
+    test_assert_equal(now + 14 * WHEEL_TICK, timer_wheel_next_deadline(states, 0), "timer_slack_deadline_rescanned");
+    test_assert_equal(1, timer_wheel_process(states, 0, now + 14 * WHEEL_TICK), "timer_slack_fires_by_deadline");
+
+    // Saturating deadline for huge slack, default slack used by timer_arm
+    timer_arm_slack(states, 0, NULL, now + 20 * WHEEL_TICK, (void*)wheel_callback, 4, UINT64_MAX);
+    test_assert_equal(UINT64_MAX, timer_wheel_next_deadline(states, 0), "timer_slack_saturates");
+    timer_wheel_process(states, 0, now + 20 * WHEEL_TICK);
+    test_assert_equal(1, timer_wheel_set_default_slack(states, 0, 2 * WHEEL_TICK), "timer_slack_set_default");
+    timer_arm(states, 0, NULL, now + 21 * WHEEL_TICK, (void*)wheel_callback, 5);
+    test_assert_equal(now + 23 * WHEEL_TICK, timer_wheel_next_deadline(states, 0), "timer_slack_default_applied");
+
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Message and Interval Timers
+// ------------------------------------------------------------
+void test_timer_send_after() {
+    printf("--- Testing send_after and Interval Timers ---\n");
+
+    void* states = scheduler_state_init(2);
+    timer_wheel_init(states, 0);
+    uint64_t now = scheduler_refresh_now(states, 0);
+
+    // Target process with a mailbox (pcb_message_queue at offset 368)
+    uint64_t pcb[64];
+    uint64_t queue[8];
+    memset(pcb, 0, sizeof(pcb));
+    memset(queue, 0, sizeof(queue));
+    test_assert_equal(1, message_queue_init(queue, 8), "send_after_mailbox_init");
+    pcb[46] = (uint64_t)queue;
+
+    test_assert_equal(0, send_after(states, 0, NULL, WHEEL_TICK, 1), "send_after_null_target");
+    test_assert_equal(0, send_interval(states, 0, pcb, 0, 1), "send_interval_zero_period");
+    test_assert_equal(0, send_after(states, 0, pcb, WHEEL_TICK, 0), "send_after_zero_message");
+    test_assert_equal(0, send_interval(states, 0, pcb, WHEEL_TICK, 0), "send_interval_zero_message");
+    test_assert_equal(0, timer_wheel_count(states, 0), "send_zero_message_not_armed");
+
+    // One-shot delivery straight into the mailbox
+    uint64_t timer = send_after(states, 0, pcb, 2 * WHEEL_TICK, 0xBEEF);
+    test_assert_true(timer != 0, "send_after_armed");
+    test_assert_equal(0, timer_wheel_process(states, 0, now + WHEEL_TICK), "send_after_not_early");
+    test_assert_equal(0, message_queue_size(queue), "send_after_mailbox_empty");
+    test_assert_equal(1, timer_wheel_process(states, 0, now + 2 * WHEEL_TICK), "send_after_fires");
+    test_assert_equal(1, message_queue_size(queue), "send_after_delivered");
+    test_assert_equal(0xBEEF, try_receive_message(pcb), "send_after_message");
+    test_assert_equal(0, timer_wheel_count(states, 0), "send_after_recycled");
+
+    // Cancelled send_after never delivers
+    timer = send_after(states, 0, pcb, 3 * WHEEL_TICK, 0xDEAD);
+    test_assert_equal(1, cancel_timer(timer), "send_after_cancel");
+    timer_wheel_process(states, 0, now + 4 * WHEEL_TICK);
+    test_assert_equal(0, message_queue_size(queue), "send_after_cancelled_not_delivered");
+
+    // Delivery wakes a target blocked in receive (pcb_state 32, pcb_blocking_reason 440)
+    pcb[4] = 3;   // PROCESS_STATE_WAITING
+    pcb[55] = 1;  // REASON_RECEIVE
+    timer = send_after(states, 0, pcb, WHEEL_TICK, 0xFEED);
+    timer_wheel_process(states, 0, now + 5 * WHEEL_TICK);
+    test_assert_equal(1, pcb[4], "send_after_wakes_receiver");
+    test_assert_equal(0, pcb[55], "send_after_clears_reason");
+    test_assert_equal(0xFEED, try_receive_message(pcb), "send_after_wake_message");
+
+    // Interval timer re-arms in place until cancelled (fresh wheel on core 1)
+    timer_wheel_init(states, 1);
+    pcb[3] = 1;  // pcb_scheduler_id
+    uint64_t start = scheduler_refresh_now(states, 1);
+    timer = send_interval(states, 1, pcb, 2 * WHEEL_TICK, 0xCAFE);
+    test_assert_true(timer != 0, "send_interval_armed");
+    test_assert_equal(1, timer_wheel_process(states, 1, start + 2 * WHEEL_TICK), "send_interval_first");
+    test_assert_equal(1, timer_wheel_count(states, 1), "send_interval_rearmed");
+    test_assert_equal(1, timer_wheel_process(states, 1, start + 4 * WHEEL_TICK), "send_interval_second");
+    test_assert_equal(2, message_queue_size(queue), "send_interval_delivered_twice");
+
+    // Missed periods are skipped, not delivered in a burst
+    test_assert_equal(1, timer_wheel_process(states, 1, start + 20 * WHEEL_TICK), "send_interval_catch_up_once");
+    test_assert_equal(start + 22 * WHEEL_TICK, timer_wheel_next_expiry(states, 1), "send_interval_restarts_from_now");
+
+    test_assert_equal(1, cancel_timer(timer), "send_interval_cancel");
+    test_assert_equal(0, timer_wheel_process(states, 1, start + 22 * WHEEL_TICK), "send_interval_stopped");
+    test_assert_equal(0, timer_wheel_count(states, 1), "send_interval_reclaimed");
+    test_assert_equal(3, message_queue_size(queue), "send_interval_total_deliveries");
+
+    timer_wheel_destroy(states, 1);
+    timer_wheel_destroy(states, 0);
+    scheduler_state_destroy(states);
 }
 
 // ------------------------------------------------------------
@@ -217,7 +501,6 @@ void test_timer_edge_cases() {
 void test_timer_main() {
     printf("=== TIMER SYSTEM TEST SUITE ===\n");
     
-    test_timer_init_basic();
     test_system_ticks();
     test_timer_insertion();
     test_timer_cancellation();
@@ -225,6 +508,11 @@ void test_timer_main() {
     test_timeout_scheduling();
     test_timeout_cancellation();
     test_timer_edge_cases();
+    test_timer_wheel_basic();
+    test_timer_wheel_cancellation();
+    test_timer_wheel_migration();
+    test_timer_wheel_slack();
+    test_timer_send_after();
     
     printf("=== TIMER SYSTEM TEST SUITE COMPLETE ===\n");
 }
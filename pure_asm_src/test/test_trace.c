@@ -0,0 +1,237 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// test_trace.c — C test suite for the Event Trace Rings
+// ------------------------------------------------------------
+// Tests the per-scheduler trace rings implemented in trace.s: argument
+// validation, class masks, record and read-back order, wraparound
+// keeping the newest events, and the events emitted by the scheduler
+// and garbage collection hooks.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scheduler_functions.h"
+
+// Test framework function declarations
+void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
+void test_assert_true(int condition, const char* test_name);
+
+// External assembly functions
+extern int trace_init(void* scheduler_states, uint64_t core_id, uint64_t capacity);
+extern int trace_destroy(void* scheduler_states, uint64_t core_id);
+extern int trace_set_mask(void* scheduler_states, uint64_t core_id, uint64_t mask);
+extern uint64_t trace_get_mask(void* scheduler_states, uint64_t core_id);
+extern int trace_event(void* scheduler_states, uint64_t core_id, uint64_t event, uint64_t pid, uint64_t arg);
+extern uint64_t trace_count(void* scheduler_states, uint64_t core_id);
+extern uint64_t trace_read(void* scheduler_states, uint64_t core_id, void* buffer, uint64_t max_events);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern void scheduler_init(void* scheduler_states, uint64_t core_id);
+extern int scheduler_enqueue_process(void* scheduler_states, uint64_t core_id, void* process, uint64_t priority);
+extern void* scheduler_schedule(void* scheduler_states, uint64_t core_id);
+extern int process_collect_garbage(void* scheduler_states, uint64_t core_id, void* pcb);
+
+// External constants from assembly
+extern const uint64_t TRACE_EVENT_SIZE_CONST;
+
+// Trace classes and events (match config.inc)
+#define TRACE_CLASS_SCHEDULE 0
+#define TRACE_CLASS_MESSAGE 3
+#define TRACE_CLASS_GC 5
+#define TRACE_CLASS_ALL 0x7F
+#define TRACE_EVENT_SCHED_IN 0x000
+#define TRACE_EVENT_SEND 0x300
+#define TRACE_EVENT_RECEIVE 0x301
+#define TRACE_EVENT_GC_START 0x500
+#define TRACE_EVENT_GC_END 0x501
+
+#define PRIORITY_NORMAL 2
+
+typedef struct {
+    uint64_t timestamp;
+    uint32_t event;
+    uint32_t core;
+    uint64_t pid;
+    uint64_t arg;
+} trace_entry;
+
+// ------------------------------------------------------------
+// Test Trace Guards
+// ------------------------------------------------------------
+void test_trace_guards() {
+    printf("--- Testing Trace Guards ---\n");
+
+    test_assert_equal(sizeof(trace_entry), TRACE_EVENT_SIZE_CONST, "trace_event_size");
+    test_assert_equal(0, trace_init(NULL, 0, 64), "trace_init_null_states");
+
+    void* states = scheduler_state_init(2);
+    test_assert_equal(0, trace_init(states, 128, 64), "trace_init_invalid_core");
+    test_assert_equal(0, trace_init(states, 0, 32), "trace_init_too_small");
+    test_assert_equal(0, trace_init(states, 0, 100), "trace_init_not_power_of_two");
+    test_assert_equal(0, trace_init(states, 0, 1ULL << 21), "trace_init_too_large");
+
+    // No ring yet: nothing can be enabled or recorded
+    test_assert_equal(0, trace_set_mask(states, 0, TRACE_CLASS_ALL), "trace_mask_needs_ring");
+    test_assert_equal(1, trace_set_mask(states, 0, 0), "trace_mask_zero_without_ring");
+    test_assert_equal(0, trace_event(states, 0, TRACE_EVENT_SEND, 1, 2), "trace_event_without_ring");
+    test_assert_equal(0, trace_count(states, 0), "trace_count_without_ring");
+    test_assert_equal(1, trace_destroy(states, 0), "trace_destroy_without_ring");
+
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Trace Record and Read
+// ------------------------------------------------------------
+void test_trace_record_read() {
+    printf("--- Testing Trace Record and Read ---\n");
+
+    void* states = scheduler_state_init(2);
+    test_assert_equal(1, trace_init(states, 1, 64), "trace_init_ok");
+    test_assert_equal(1, trace_init(states, 1, 128), "trace_init_idempotent");
+
+    // Disabled until a mask is set
+    test_assert_equal(0, trace_event(states, 1, TRACE_EVENT_SEND, 1, 2), "trace_disabled_by_default");
+
+    // Bits outside the known classes are dropped
+    test_assert_equal(1, trace_set_mask(states, 1, 0xFFFF), "trace_mask_set");
+    test_assert_equal(TRACE_CLASS_ALL, trace_get_mask(states, 1), "trace_mask_clamped");
+
+    test_assert_equal(1, trace_event(states, 1, TRACE_EVENT_SEND, 7, 8), "trace_event_send");
+    test_assert_equal(1, trace_event(states, 1, TRACE_EVENT_RECEIVE, 8, 0x1234), "trace_event_receive");
+    test_assert_equal(2, trace_count(states, 1), "trace_count_two");
+
+    trace_entry events[4];
+    memset(events, 0, sizeof(events));
+    test_assert_equal(2, trace_read(states, 1, events, 4), "trace_read_two");
+    test_assert_equal(TRACE_EVENT_SEND, events[0].event, "trace_read_first_event");
+    test_assert_equal(1, events[0].core, "trace_read_core");
+    test_assert_equal(7, events[0].pid, "trace_read_pid");
+    test_assert_equal(8, events[0].arg, "trace_read_arg");
+    test_assert_equal(TRACE_EVENT_RECEIVE, events[1].event, "trace_read_second_event");
+    test_assert_equal(0x1234, events[1].arg, "trace_read_second_arg");
+    test_assert_true(events[0].timestamp != 0 && events[1].timestamp >= events[0].timestamp,
+                     "trace_read_timestamps_ordered");
+
+    // One class only: the message class is filtered out with a single bit test
+    test_assert_equal(1, trace_set_mask(states, 1, 1ULL << TRACE_CLASS_SCHEDULE), "trace_mask_schedule_only");
+    test_assert_equal(0, trace_event(states, 1, TRACE_EVENT_SEND, 7, 8), "trace_event_filtered");
+    test_assert_equal(0, trace_event(states, 1, 0x4000, 7, 8), "trace_event_unknown_class");
+    test_assert_equal(2, trace_count(states, 1), "trace_count_unchanged");
+
+    test_assert_equal(1, trace_destroy(states, 1), "trace_destroy_ok");
+    test_assert_equal(0, trace_get_mask(states, 1), "trace_destroy_clears_mask");
+    test_assert_equal(0, trace_count(states, 1), "trace_destroy_clears_ring");
+
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Trace Wraparound
+// ------------------------------------------------------------
+void test_trace_wraparound() {
+    printf("--- Testing Trace Wraparound ---\n");
+
+    void* states = scheduler_state_init(1);
+    trace_init(states, 0, 64);
+    trace_set_mask(states, 0, TRACE_CLASS_ALL);
+    for (uint64_t i = 0; i < 100; i++) {
+        trace_event(states, 0, TRACE_EVENT_SEND, 1, i);
+    }
+    test_assert_equal(100, trace_count(states, 0), "trace_wrap_count");
+
+    // Only the newest capacity events survive, oldest first
+    trace_entry* events = calloc(128, sizeof(trace_entry));
+    test_assert_equal(64, trace_read(states, 0, events, 128), "trace_wrap_read_capacity");
+    test_assert_equal(36, events[0].arg, "trace_wrap_oldest_kept");
+    test_assert_equal(99, events[63].arg, "trace_wrap_newest");
+
+    // A smaller buffer gets the newest events
+    test_assert_equal(10, trace_read(states, 0, events, 10), "trace_wrap_read_partial");
+    test_assert_equal(90, events[0].arg, "trace_wrap_partial_oldest");
+    test_assert_equal(99, events[9].arg, "trace_wrap_partial_newest");
+
+    free(events);
+    trace_destroy(states, 0);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Test Trace Hooks
+// ------------------------------------------------------------
+void test_trace_hooks() {
+    printf("--- Testing Trace Hooks ---\n");
+
+    void* states = scheduler_state_init(1);
+    scheduler_init(states, 0);
+    trace_init(states, 0, 64);
+    trace_set_mask(states, 0, (1ULL << TRACE_CLASS_SCHEDULE) | (1ULL << TRACE_CLASS_GC));
+
+    uint8_t* pcb = calloc(1, PCB_SIZE);
+    *(uint64_t*)(pcb + PCB_PID_OFFSET) = 42;
+    scheduler_enqueue_process(states, 0, pcb, PRIORITY_NORMAL);
+    test_assert_true(scheduler_schedule(states, 0) == pcb, "trace_hook_scheduled");
+
+    trace_entry events[8];
+    memset(events, 0, sizeof(events));
+    test_assert_equal(1, trace_read(states, 0, events, 8), "trace_hook_sched_in_only");
+    test_assert_equal(TRACE_EVENT_SCHED_IN, events[0].event, "trace_hook_sched_in");
+    test_assert_equal(42, events[0].pid, "trace_hook_sched_in_pid");
+    test_assert_equal(PRIORITY_NORMAL, events[0].arg, "trace_hook_sched_in_priority");
+
+    // Collection brackets the reset with bytes in use and bytes reclaimed
+    uint8_t heap[64];
+    *(uint64_t*)(pcb + PCB_HEAP_BASE_OFFSET) = (uint64_t)(uintptr_t)heap;
+    *(uint64_t*)(pcb + PCB_HEAP_POINTER_OFFSET) = (uint64_t)(uintptr_t)(heap + 48);
+    test_assert_equal(1, process_collect_garbage(states, 0, pcb), "trace_hook_gc_ran");
+    test_assert_equal(0, process_collect_garbage(states, 0, NULL), "trace_hook_gc_null_pcb");
+    test_assert_equal(3, trace_read(states, 0, events, 8), "trace_hook_gc_events");
+    test_assert_equal(TRACE_EVENT_GC_START, events[1].event, "trace_hook_gc_start");
+    test_assert_equal(48, events[1].arg, "trace_hook_gc_in_use");
+    test_assert_equal(TRACE_EVENT_GC_END, events[2].event, "trace_hook_gc_end");
+    test_assert_equal(48, events[2].arg, "trace_hook_gc_reclaimed");
+
+    free(pcb);
+    trace_destroy(states, 0);
+    scheduler_state_destroy(states);
+}
+
+// ------------------------------------------------------------
+// Main Trace Test Function
+// ------------------------------------------------------------
+void test_trace_main() {
+    printf("=== EVENT TRACE TEST SUITE ===\n");
+
+    test_trace_guards();
+    test_trace_record_read();
+    test_trace_wraparound();
+    test_trace_hooks();
+
+    printf("=== EVENT TRACE TEST SUITE COMPLETE ===\n");
+}
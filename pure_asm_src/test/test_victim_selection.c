@@ -29,12 +29,15 @@
 #include <stdlib.h>
 
 // External assembly functions
-extern uint32_t get_scheduler_load(uint64_t core_id);
-extern uint64_t find_busiest_scheduler(uint64_t current_core);
-extern int is_steal_allowed(uint64_t source_core, uint64_t target_core);
+extern uint32_t get_scheduler_load(void* scheduler_states, uint64_t core_id);
+extern uint64_t find_busiest_scheduler(void* scheduler_states, uint64_t current_core);
+extern int is_steal_allowed(uint64_t source_core, uint64_t target_core, void* pcb);
 extern uint64_t select_victim_random(uint64_t current_core);
-extern uint64_t select_victim_by_load(uint64_t current_core);
-extern uint64_t select_victim_locality(uint64_t current_core);
+extern uint64_t select_victim_by_load(void* scheduler_states, uint64_t current_core);
+extern uint64_t select_victim_locality(void* scheduler_states, uint64_t current_core);
+extern void* scheduler_state_init(uint64_t max_cores);
+extern void scheduler_init(void* scheduler_states, uint64_t core_id);
+extern void scheduler_state_destroy(void* scheduler_states);
 
 // External constants from assembly
 extern const uint64_t MAX_CORES;
@@ -52,6 +55,12 @@ static void test_select_victim_locality();
 static void test_victim_selection_edge_cases();
 static void test_locality_based_selection();
 
+// Scheduler states shared by the tests in this file
+static void* states = NULL;
+
+// Process that has never migrated and may run on any core
+static uint64_t movable_pcb[64];
+
 // Test framework functions
 extern void test_assert_equal(uint64_t expected, uint64_t actual, const char* test_name);
 extern void test_assert_zero(uint64_t value, const char* test_name);
@@ -63,6 +72,16 @@ extern void test_assert_nonzero(uint64_t value, const char* test_name);
 void test_victim_selection() {
     printf("\n--- Testing Victim Selection Algorithms (Pure Assembly) ---\n");
     
+    states = scheduler_state_init(MAX_CORES);
+    if (states == NULL) {
+        test_assert_nonzero(0, "victim_selection_states_init");
+        return;
+    }
+    for (uint64_t core_id = 0; core_id < 4; core_id++) {
+        scheduler_init(states, core_id);
+    }
+    movable_pcb[384 / 8] = ~0ULL;  // pcb_affinity_mask
+    
     test_get_scheduler_load();
     test_find_busiest_scheduler();
     test_is_steal_allowed();
@@ -71,6 +90,9 @@ void test_victim_selection() {
     test_select_victim_locality();
     test_victim_selection_edge_cases();
     test_locality_based_selection();
+    
+    scheduler_state_destroy(states);
+    states = NULL;
 }
 
 // ------------------------------------------------------------
@@ -81,17 +103,17 @@ void test_get_scheduler_load() {
     
     // Test load calculation for different cores
     for (uint64_t core_id = 0; core_id < 4; core_id++) {
-        uint32_t load = get_scheduler_load(core_id);
+        uint32_t load = get_scheduler_load(states, core_id);
         // Load should be non-negative (0 or positive)
         test_assert_nonzero(load >= 0, "scheduler_load_non_negative");
     }
     
     // Test invalid core ID
-    uint32_t load = get_scheduler_load(MAX_CORES);
+    uint32_t load = get_scheduler_load(states, MAX_CORES);
     test_assert_equal(0, load, "scheduler_load_invalid_core");
     
     // Test core ID beyond maximum
-    load = get_scheduler_load(MAX_CORES + 1);
+    load = get_scheduler_load(states, MAX_CORES + 1);
     test_assert_equal(0, load, "scheduler_load_beyond_max");
 }
 
@@ -103,7 +125,7 @@ void test_find_busiest_scheduler() {
     
     // Test with different current cores
     for (uint64_t current_core = 0; current_core < 4; current_core++) {
-        uint64_t busiest = find_busiest_scheduler(current_core);
+        uint64_t busiest = find_busiest_scheduler(states, current_core);
         
         // Busiest core should be valid
         test_assert_nonzero(busiest < MAX_CORES, "busiest_core_valid");
@@ -114,7 +136,7 @@ void test_find_busiest_scheduler() {
     }
     
     // Test with invalid current core
-    uint64_t busiest = find_busiest_scheduler(MAX_CORES);
+    uint64_t busiest = find_busiest_scheduler(states, MAX_CORES);
     test_assert_equal(0, busiest, "busiest_scheduler_invalid_current");
 }
 
@@ -128,7 +150,7 @@ void test_is_steal_allowed() {
     for (uint64_t source = 0; source < 4; source++) {
         for (uint64_t target = 0; target < 4; target++) {
             if (source != target) {
-                int allowed = is_steal_allowed(source, target);
+                int allowed = is_steal_allowed(source, target, movable_pcb);
                 // Should be allowed for different cores
                 test_assert_equal(1, allowed, "steal_allowed_different_cores");
             }
@@ -136,15 +158,15 @@ void test_is_steal_allowed() {
     }
     
     // Test invalid source core
-    int allowed = is_steal_allowed(MAX_CORES, 0);
+    int allowed = is_steal_allowed(MAX_CORES, 0, movable_pcb);
     test_assert_equal(0, allowed, "steal_not_allowed_invalid_source");
     
     // Test invalid target core
-    allowed = is_steal_allowed(0, MAX_CORES);
+    allowed = is_steal_allowed(0, MAX_CORES, movable_pcb);
     test_assert_equal(0, allowed, "steal_not_allowed_invalid_target");
     
     // Test both cores invalid
-    allowed = is_steal_allowed(MAX_CORES, MAX_CORES);
+    allowed = is_steal_allowed(MAX_CORES, MAX_CORES, movable_pcb);
     test_assert_equal(0, allowed, "steal_not_allowed_both_invalid");
 }
 
@@ -179,7 +201,7 @@ void test_select_victim_by_load() {
     
     // Test with different current cores
     for (uint64_t current_core = 0; current_core < 4; current_core++) {
-        uint64_t victim = select_victim_by_load(current_core);
+        uint64_t victim = select_victim_by_load(states, current_core);
         
         // Victim should be valid
         test_assert_nonzero(victim < MAX_CORES, "load_victim_valid");
@@ -190,7 +212,7 @@ void test_select_victim_by_load() {
     }
     
     // Test with invalid current core
-    uint64_t victim = select_victim_by_load(MAX_CORES);
+    uint64_t victim = select_victim_by_load(states, MAX_CORES);
     test_assert_equal(0, victim, "load_victim_invalid_current");
 }
 
@@ -202,7 +224,7 @@ void test_select_victim_locality() {
     
     // Test with different current cores
     for (uint64_t current_core = 0; current_core < 4; current_core++) {
-        uint64_t victim = select_victim_locality(current_core);
+        uint64_t victim = select_victim_locality(states, current_core);
         
         // Victim should be valid
         test_assert_nonzero(victim < MAX_CORES, "locality_victim_valid");
@@ -213,7 +235,7 @@ void test_select_victim_locality() {
     }
     
     // Test with invalid current core
-    uint64_t victim = select_victim_locality(MAX_CORES);
+    uint64_t victim = select_victim_locality(states, MAX_CORES);
     test_assert_equal(0, victim, "locality_victim_invalid_current");
 }
 
@@ -231,26 +253,26 @@ void test_victim_selection_edge_cases() {
     test_assert_nonzero(victim < MAX_CORES, "random_victim_max_core");
     
     // Test load-based selection with max core
-    victim = select_victim_by_load(max_core);
+    victim = select_victim_by_load(states, max_core);
     test_assert_nonzero(victim < MAX_CORES, "load_victim_max_core");
     
     // Test locality-aware selection with max core
-    victim = select_victim_locality(max_core);
+    victim = select_victim_locality(states, max_core);
     test_assert_nonzero(victim < MAX_CORES, "locality_victim_max_core");
     
     // Test load calculation with max core
-    uint32_t load = get_scheduler_load(max_core);
+    uint32_t load = get_scheduler_load(states, max_core);
     test_assert_nonzero(load >= 0, "load_calculation_max_core");
     
     // Test busiest scheduler with max core
-    victim = find_busiest_scheduler(max_core);
+    victim = find_busiest_scheduler(states, max_core);
     test_assert_nonzero(victim < MAX_CORES, "busiest_scheduler_max_core");
     
     // Test steal permission with max core
-    int allowed = is_steal_allowed(max_core, 0);
+    int allowed = is_steal_allowed(max_core, 0, movable_pcb);
     test_assert_equal(1, allowed, "steal_permission_max_core");
     
-    allowed = is_steal_allowed(0, max_core);
+    allowed = is_steal_allowed(0, max_core, movable_pcb);
     test_assert_equal(1, allowed, "steal_permission_to_max_core");
 }
 
@@ -263,7 +285,7 @@ void test_locality_based_selection() {
     // Test 1: Basic locality selection
     printf("Testing basic locality selection...\n");
     for (uint64_t current_core = 0; current_core < 4; current_core++) {
-        uint64_t victim = select_victim_locality(current_core);
+        uint64_t victim = select_victim_locality(states, current_core);
         
         // Victim should be valid
         test_assert_nonzero(victim < MAX_CORES, "locality_selection_valid_victim");
@@ -277,8 +299,8 @@ void test_locality_based_selection() {
     // Test 2: Locality selection consistency
     printf("Testing locality selection consistency...\n");
     for (int i = 0; i < 3; i++) {
-        uint64_t victim1 = select_victim_locality(0);
-        uint64_t victim2 = select_victim_locality(0);
+        uint64_t victim1 = select_victim_locality(states, 0);
+        uint64_t victim2 = select_victim_locality(states, 0);
         
         // Results should be consistent (same or valid fallback)
         test_assert_nonzero(victim1 < MAX_CORES, "locality_consistency_victim1");
@@ -287,20 +309,20 @@ void test_locality_based_selection() {
     
     // Test 3: Edge case cores
     printf("Testing edge case cores...\n");
-    uint64_t edge_victim = select_victim_locality(MAX_CORES - 1);
+    uint64_t edge_victim = select_victim_locality(states, MAX_CORES - 1);
     test_assert_nonzero(edge_victim < MAX_CORES, "locality_selection_edge_core");
     
     // Test 4: Invalid core handling
     printf("Testing invalid core handling...\n");
-    uint64_t invalid_victim = select_victim_locality(MAX_CORES + 1);
+    uint64_t invalid_victim = select_victim_locality(states, MAX_CORES + 1);
     // Should handle gracefully (return valid core or 0)
     test_assert_nonzero(invalid_victim < MAX_CORES, "locality_selection_invalid_core");
     
     // Test 5: Locality vs load-based comparison
     printf("Testing locality vs load-based selection...\n");
     for (uint64_t current_core = 0; current_core < 4; current_core++) {
-        uint64_t locality_victim = select_victim_locality(current_core);
-        uint64_t load_victim = select_victim_by_load(current_core);
+        uint64_t locality_victim = select_victim_locality(states, current_core);
+        uint64_t load_victim = select_victim_by_load(states, current_core);
         
         // Both should return valid victims
         test_assert_nonzero(locality_victim < MAX_CORES, "locality_vs_load_locality");
@@ -315,7 +337,7 @@ void test_locality_based_selection() {
     // Since we have a simplified NUMA implementation (single node),
     // locality selection should fall back to load-based selection
     for (uint64_t current_core = 0; current_core < 4; current_core++) {
-        uint64_t victim = select_victim_locality(current_core);
+        uint64_t victim = select_victim_locality(states, current_core);
         test_assert_nonzero(victim < MAX_CORES, "numa_simulation_valid");
     }
     
@@ -30,26 +30,36 @@
 #include <string.h>
 
 // External assembly functions
-extern void* try_steal_work(void* scheduler_states, uint64_t current_core);
+extern int try_steal_work(void* scheduler_states, uint64_t current_core);
+extern void* serve_steal_request(void* scheduler_states, uint64_t core_id);
 extern int migrate_process(void* process, uint64_t source_core, uint64_t target_core);
-extern uint32_t get_scheduler_load(uint64_t core_id);
-extern uint64_t select_victim_by_load(uint64_t current_core);
+extern void* steal_process(void* scheduler_states, uint64_t thief_core, uint64_t victim_core);
+extern uint32_t get_scheduler_load(void* scheduler_states, uint64_t core_id);
+extern uint64_t select_victim_by_load(void* scheduler_states, uint64_t current_core);
 extern int is_steal_allowed(uint64_t source_core, uint64_t target_core, void* pcb);
 
 // External scheduler functions
 extern void* scheduler_state_init(uint64_t max_cores);
 extern void scheduler_init(void* scheduler_states, uint64_t core_id);
+extern int scheduler_enqueue_process(void* scheduler_states, uint64_t core_id, void* process, uint64_t priority);
+extern void* scheduler_schedule(void* scheduler_states, uint64_t core_id);
 extern void scheduler_state_destroy(void* scheduler_states);
+extern uint64_t scheduler_refresh_now(void* scheduler_states, uint64_t core_id);
+extern uint64_t timer_wheel_process(void* scheduler_states, uint64_t core_id, uint64_t now);
+extern int timer_wheel_destroy(void* scheduler_states, uint64_t core_id);
 
 // External constants from assembly
 extern const uint64_t MAX_CORES;
 extern const uint64_t WORK_STEAL_ENABLED;
 extern const uint64_t MIN_STEAL_QUEUE_SIZE;
 extern const uint64_t MAX_MIGRATIONS;
+extern const uint64_t SCHEDULER_SIZE_CONST;
 
 // Forward declarations for test functions
 static void test_try_steal_work();
 static void test_migrate_process();
+static void test_steal_process();
+static void test_steal_request_handoff();
 static void test_work_stealing_with_load();
 static void test_work_stealing_edge_cases();
 static void test_work_stealing_migration_limits();
@@ -69,6 +79,8 @@ void test_work_stealing() {
     
     test_try_steal_work();
     test_migrate_process();
+    test_steal_process();
+    test_steal_request_handoff();
     test_work_stealing_with_load();
     test_work_stealing_edge_cases();
     test_work_stealing_migration_limits();
@@ -100,23 +112,23 @@ void test_try_steal_work() {
         return;
     }
     memset(dummy_pcb, 0, 512);  // Initialize to zero
+    *(uint64_t*)((uint8_t*)dummy_pcb + 384) = ~0ULL;  // pcb_affinity_mask: any core
     
     // Test with different current cores
     for (uint64_t current_core = 0; current_core < 4; current_core++) {
-        void* stolen_process = try_steal_work(scheduler_state, current_core);
+        int requested = try_steal_work(scheduler_state, current_core);
         
-        // Stolen process should be NULL (no work available in test environment)
-        // or a valid process pointer
-        test_assert_nonzero(stolen_process == NULL || stolen_process != NULL, "steal_work_valid_result");
+        // No scheduler has queued work, so there is nobody to ask
+        test_assert_zero((uint64_t)requested, "steal_work_valid_result");
     }
     
     // Test with invalid current core
-    void* stolen_process = try_steal_work(scheduler_state, MAX_CORES);
-    test_assert_equal(0, (uint64_t)stolen_process, "steal_work_invalid_core");
+    int requested = try_steal_work(scheduler_state, MAX_CORES);
+    test_assert_equal(0, (uint64_t)requested, "steal_work_invalid_core");
     
     // Test with core beyond maximum
-    stolen_process = try_steal_work(scheduler_state, MAX_CORES + 1);
-    test_assert_equal(0, (uint64_t)stolen_process, "steal_work_beyond_max");
+    requested = try_steal_work(scheduler_state, MAX_CORES + 1);
+    test_assert_equal(0, (uint64_t)requested, "steal_work_beyond_max");
     
     // Cleanup
     free(dummy_pcb);
@@ -158,6 +170,132 @@ void test_migrate_process() {
     test_assert_equal(0, result, "migrate_process_both_invalid");
 }
 
+// ------------------------------------------------------------
+// test_steal_process — Test taking a process from a victim queue
+// ------------------------------------------------------------
+void test_steal_process() {
+    printf("Testing steal from victim run queue...\n");
+
+    uint8_t* scheduler_state = scheduler_state_init(2);
+    if (scheduler_state == NULL) {
+        printf("ERROR: Failed to create scheduler state\n");
+        return;
+    }
+    scheduler_init(scheduler_state, 0);
+    scheduler_init(scheduler_state, 1);
+
+    uint8_t* pcbs = calloc(4, 512);
+    if (pcbs == NULL) {
+        printf("ERROR: Failed to allocate PCBs\n");
+        scheduler_state_destroy(scheduler_state);
+        return;
+    }
+    for (int i = 0; i < 3; i++) {
+        scheduler_enqueue_process(scheduler_state, 0, pcbs + i * 512, 2);  // PRIORITY_NORMAL
+    }
+
+    // Nothing to take from an empty victim, or from yourself
+    test_assert_zero((uint64_t)steal_process(scheduler_state, 0, 1), "steal_process_empty_victim");
+    test_assert_zero((uint64_t)steal_process(scheduler_state, 0, 0), "steal_process_same_core");
+    test_assert_zero((uint64_t)steal_process(NULL, 1, 0), "steal_process_null_states");
+    test_assert_zero((uint64_t)steal_process(scheduler_state, 1, MAX_CORES), "steal_process_invalid_victim");
+
+    // The most recently queued process is taken and re-homed
+    uint8_t* stolen = steal_process(scheduler_state, 1, 0);
+    test_assert_equal((uint64_t)(pcbs + 2 * 512), (uint64_t)stolen, "steal_process_takes_tail");
+    test_assert_equal(1, *(uint64_t*)(stolen + 24), "steal_process_rehomes");
+    test_assert_equal(1, *(uint64_t*)(stolen + 392), "steal_process_migration_count");
+    test_assert_zero(*(uint64_t*)(stolen + 0), "steal_process_clears_next");
+    test_assert_equal(1, *(uint64_t*)(scheduler_state + SCHEDULER_SIZE_CONST + 240), "steal_process_thief_steals");
+    test_assert_equal(1, *(uint64_t*)(scheduler_state + SCHEDULER_SIZE_CONST + 288), "steal_process_thief_attempts");
+    test_assert_equal(1, *(uint64_t*)(scheduler_state + 288), "steal_process_failed_attempt_counted");
+
+    // The victim keeps the rest in order
+    test_assert_equal((uint64_t)pcbs, (uint64_t)scheduler_schedule(scheduler_state, 0), "steal_process_victim_head");
+    test_assert_equal((uint64_t)(pcbs + 512), (uint64_t)scheduler_schedule(scheduler_state, 0), "steal_process_victim_next");
+    test_assert_zero((uint64_t)scheduler_schedule(scheduler_state, 0), "steal_process_victim_drained");
+
+    // Higher priority work is taken first; a single entry empties the queue
+    scheduler_enqueue_process(scheduler_state, 0, pcbs, 2);         // PRIORITY_NORMAL
+    scheduler_enqueue_process(scheduler_state, 0, pcbs + 512, 1);   // PRIORITY_HIGH
+    test_assert_equal((uint64_t)(pcbs + 512), (uint64_t)steal_process(scheduler_state, 1, 0), "steal_process_priority_order");
+    test_assert_equal((uint64_t)pcbs, (uint64_t)steal_process(scheduler_state, 1, 0), "steal_process_last_entry");
+    test_assert_zero((uint64_t)scheduler_schedule(scheduler_state, 0), "steal_process_victim_empty");
+
+    free(pcbs);
+    scheduler_state_destroy(scheduler_state);
+}
+
+// ------------------------------------------------------------
+// test_steal_request_handoff — Test the request/hand-off used between scheduler threads
+// ------------------------------------------------------------
+void test_steal_request_handoff() {
+    printf("Testing steal request hand-off...\n");
+
+    uint8_t* scheduler_state = scheduler_state_init(2);
+    if (scheduler_state == NULL) {
+        printf("ERROR: Failed to create scheduler state\n");
+        return;
+    }
+    scheduler_init(scheduler_state, 0);
+    scheduler_init(scheduler_state, 1);
+
+    uint8_t* pcbs = calloc(4, 512);
+    if (pcbs == NULL) {
+        printf("ERROR: Failed to allocate PCBs\n");
+        scheduler_state_destroy(scheduler_state);
+        return;
+    }
+    for (int i = 0; i < 4; i++) {
+        *(uint64_t*)(pcbs + i * 512 + 384) = ~0ULL;  // pcb_affinity_mask: any core
+        scheduler_enqueue_process(scheduler_state, 0, pcbs + i * 512, 2);  // PRIORITY_NORMAL
+    }
+
+    // Victim scans are bounded by the count kept in state 0
+    test_assert_equal(2, *(uint32_t*)(scheduler_state + 308), "steal_request_scheduler_count");
+    test_assert_equal(0, select_victim_by_load(scheduler_state, 1), "steal_request_busiest_victim");
+    test_assert_equal(0, select_victim_by_load(scheduler_state, 0), "steal_request_no_busier_victim");
+    test_assert_zero(try_steal_work(scheduler_state, 0), "steal_request_busiest_not_posted");
+
+    // The idle core posts a request on the busiest one, once
+    uint64_t now = scheduler_refresh_now(scheduler_state, 0);
+    test_assert_equal(1, try_steal_work(scheduler_state, 1), "steal_request_posted");
+    test_assert_equal(2, *(uint32_t*)(scheduler_state + 304), "steal_request_names_thief");
+    test_assert_equal(1, *(uint64_t*)(scheduler_state + SCHEDULER_SIZE_CONST + 288), "steal_request_attempt_counted");
+    test_assert_zero(try_steal_work(scheduler_state, 1), "steal_request_one_pending");
+    test_assert_equal(8, get_scheduler_load(scheduler_state, 0), "steal_request_takes_nothing");
+
+    // The victim consumes the request and hands over its tail
+    uint8_t* handed = serve_steal_request(scheduler_state, 0);
+    test_assert_equal((uint64_t)(pcbs + 3 * 512), (uint64_t)handed, "steal_request_takes_tail");
+    test_assert_zero(*(uint32_t*)(scheduler_state + 304), "steal_request_consumed");
+    test_assert_equal(1, *(uint64_t*)(handed + 24), "steal_request_rehomes");
+    test_assert_equal(6, get_scheduler_load(scheduler_state, 0), "steal_request_victim_load");
+    test_assert_zero((uint64_t)serve_steal_request(scheduler_state, 0), "steal_request_none_pending");
+
+    // The victim's next tick forwards it; the thief's tick queues it
+    test_assert_zero(timer_wheel_process(scheduler_state, 0, now), "steal_request_forwarded");
+    uint64_t thief_now = scheduler_refresh_now(scheduler_state, 1);
+    test_assert_equal(1, timer_wheel_process(scheduler_state, 1, thief_now), "steal_request_arrives");
+    test_assert_equal((uint64_t)handed, (uint64_t)scheduler_schedule(scheduler_state, 1), "steal_request_thief_runs_it");
+    test_assert_equal(1, *(uint64_t*)(handed + 392), "steal_request_migration_count");
+    test_assert_equal(1, *(uint64_t*)(scheduler_state + SCHEDULER_SIZE_CONST + 240), "steal_request_thief_steals");
+    test_assert_equal(1, *(uint64_t*)(scheduler_state + SCHEDULER_SIZE_CONST + 136), "steal_request_thief_migrations");
+    test_assert_zero(*(uint64_t*)(scheduler_state + 240), "steal_request_victim_steals_untouched");
+
+    // A tail pinned to the victim is refused and stays queued
+    *(uint64_t*)(pcbs + 2 * 512 + 384) = 1;  // core 0 only
+    test_assert_equal(1, try_steal_work(scheduler_state, 1), "steal_request_reposted");
+    test_assert_zero((uint64_t)serve_steal_request(scheduler_state, 0), "steal_request_affinity_refused");
+    test_assert_zero(*(uint32_t*)(scheduler_state + 304), "steal_request_refusal_consumed");
+    test_assert_equal(6, get_scheduler_load(scheduler_state, 0), "steal_request_refused_keeps_load");
+
+    timer_wheel_destroy(scheduler_state, 0);
+    timer_wheel_destroy(scheduler_state, 1);
+    free(pcbs);
+    scheduler_state_destroy(scheduler_state);
+}
+
 // ------------------------------------------------------------
 // test_work_stealing_with_load — Test work stealing with load considerations
 // ------------------------------------------------------------
@@ -182,16 +320,17 @@ void test_work_stealing_with_load() {
         return;
     }
     memset(dummy_pcb, 0, 512);  // Initialize to zero
+    *(uint64_t*)((uint8_t*)dummy_pcb + 384) = ~0ULL;  // pcb_affinity_mask: any core
     
     // Test load calculation for different cores
     for (uint64_t core_id = 0; core_id < 4; core_id++) {
-        uint32_t load = get_scheduler_load(core_id);
+        uint32_t load = get_scheduler_load(scheduler_state, core_id);
         test_assert_nonzero(load >= 0, "load_calculation_valid");
     }
     
     // Test victim selection based on load
     for (uint64_t current_core = 0; current_core < 4; current_core++) {
-        uint64_t victim = select_victim_by_load(current_core);
+        uint64_t victim = select_victim_by_load(scheduler_state, current_core);
         test_assert_nonzero(victim < MAX_CORES, "victim_selection_valid");
     }
     
@@ -234,13 +373,14 @@ void test_work_stealing_edge_cases() {
         return;
     }
     memset(dummy_pcb, 0, 512);  // Initialize to zero
+    *(uint64_t*)((uint8_t*)dummy_pcb + 384) = ~0ULL;  // pcb_affinity_mask: any core
     
     // Test with maximum valid core ID
     uint64_t max_core = MAX_CORES - 1;
     
     // Test work stealing with max core
-    void* stolen_process = try_steal_work(scheduler_state, max_core);
-    test_assert_nonzero(stolen_process == NULL || stolen_process != NULL, "steal_work_max_core");
+    int requested = try_steal_work(scheduler_state, max_core);
+    test_assert_zero((uint64_t)requested, "steal_work_max_core");
     
     // Test migration with max core
     void* dummy_process = (void*)0x87654321;
@@ -252,11 +392,11 @@ void test_work_stealing_edge_cases() {
     test_assert_equal(1, result, "migrate_process_to_max_core");
     
     // Test load calculation with max core
-    uint32_t load = get_scheduler_load(max_core);
+    uint32_t load = get_scheduler_load(scheduler_state, max_core);
     test_assert_nonzero(load >= 0, "load_calculation_max_core");
     
     // Test victim selection with max core
-    uint64_t victim = select_victim_by_load(max_core);
+    uint64_t victim = select_victim_by_load(scheduler_state, max_core);
     test_assert_nonzero(victim < MAX_CORES, "victim_selection_max_core");
     
     // Cleanup
@@ -314,6 +454,7 @@ void test_work_stealing_affinity_constraints() {
         return;
     }
     memset(dummy_pcb, 0, 512);  // Initialize to zero
+    *(uint64_t*)((uint8_t*)dummy_pcb + 384) = ~0ULL;  // pcb_affinity_mask: any core
     
     // Test steal permission with different core combinations
     for (uint64_t source = 0; source < 4; source++) {
@@ -332,15 +473,15 @@ void test_work_stealing_affinity_constraints() {
     
     // Test work stealing attempts with different cores
     for (uint64_t current_core = 0; current_core < 4; current_core++) {
-        void* stolen_process = try_steal_work(scheduler_state, current_core);
+        int requested = try_steal_work(scheduler_state, current_core);
         
-        // Result should be valid (NULL or process pointer)
-        test_assert_nonzero(stolen_process == NULL || stolen_process != NULL, "steal_work_affinity_valid");
+        // No scheduler has queued work, so no request is posted
+        test_assert_zero((uint64_t)requested, "steal_work_affinity_valid");
     }
     
     // Test victim selection respects constraints
     for (uint64_t current_core = 0; current_core < 4; current_core++) {
-        uint64_t victim = select_victim_by_load(current_core);
+        uint64_t victim = select_victim_by_load(scheduler_state, current_core);
         
         // Victim should be valid
         test_assert_nonzero(victim < MAX_CORES, "victim_selection_affinity_valid");
@@ -368,6 +509,7 @@ void test_work_stealing_permission_checks() {
         return;
     }
     memset(dummy_pcb, 0, 512);  // Initialize to zero
+    *(uint64_t*)((uint8_t*)dummy_pcb + 384) = ~0ULL;  // pcb_affinity_mask: any core
     
     // Test 1: Basic permission check with valid cores
     printf("Testing basic permission checks...\n");
@@ -163,6 +163,14 @@ void test_deque_push_bottom() {
     uint32_t size = ws_deque_size(deque);
     test_assert_equal(2, size, "deque_size_after_push");
     
+    // Fill to capacity; one more push must fail rather than overwrite
+    for (uintptr_t i = 3; i <= 8; i++) {
+        ws_deque_push_bottom(deque, (void*)i);
+    }
+    result = ws_deque_push_bottom(deque, process1);
+    test_assert_equal(0, result, "deque_push_bottom_when_full");
+    test_assert_equal(8, ws_deque_size(deque), "deque_size_when_full");
+    
     free(deque);
 }
 
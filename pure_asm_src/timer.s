@@ -28,15 +28,18 @@
 // Implements Phase 9 of the research implementation plan.
 //
 // The file provides:
-//   - ARM Generic Timer (CNTPCT_EL0) integration
-//   - Timer insertion and cancellation
-//   - Timeout processing for blocking operations
-//   - Periodic task scheduling for load balancing
-//   - Timer wheel data structure for efficiency
+//   - ARM Generic Timer (CNTVCT_EL0) integration
+//   - Per-core hashed timer wheels owned by each scheduler
+//   - Timer arming and cancellation, and timeouts for blocking
+//     operations (NULL-callback timers that wake their process)
+//   - Lock-free cross-core cancellation and hand-over
+//   - Lazy timer migration that follows stolen processes
+//   - Timer slack and deadline coalescing for idle wakeups
+//   - Message timers (send_after) and interval timers
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
 
     .text
@@ -61,440 +64,1489 @@
 // Author: Lee Barney
 // Last Modified: 2025-01-19
 //
-    .global _timer_init
     .global _get_system_ticks
-    .global _insert_timer
-    .global _insert_timeout_timer
     .global _cancel_timer
-    .global _process_timers
-    .global _timer_tick
-    .global _schedule_timeout
     .global _cancel_timeout
+    .global _timer_wheel_init
+    .global _timer_wheel_destroy
+    .global _timer_arm
+    .global _timer_arm_slack
+    .global _timer_wheel_set_default_slack
+    .global _timer_wheel_next_deadline
+    .global _send_after
+    .global _send_interval
+    .global _timer_wheel_process
+    .global _timer_wheel_tick
+    .global _timer_wheel_next_expiry
+    .global _timer_wheel_count
 
 // ------------------------------------------------------------
 // Timer Structure Layout
 // ------------------------------------------------------------
-// Define the memory layout for individual timer entries.
+// Define the memory layout for individual timer entries. The same
+// node is used by the legacy global API and by the per-core wheels.
+// timer_state is the only field written by non-owning cores (CAS).
+// Its low 32 bits hold TIMER_STATE_* and bits 32-47 the node's
+// generation, bumped each time the node is recycled. Timer IDs carry
+// the generation in bits 48-63 above the node address, so a cancel
+// with the ID of a timer whose node has since been reused fails.
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
+//
+    .equ timer_expiry, 0              // Expiry time in clock ticks (8 bytes)
+    .equ timer_callback, 8            // Callback function pointer (8 bytes)
+    .equ timer_process_id, 16         // Process ID / callback argument (8 bytes)
+    .equ timer_next, 24               // Next timer in slot, inbox or free list (8 bytes)
+    .equ timer_prev, 32               // Previous timer in slot (8 bytes)
+    .equ timer_state, 40              // Generation and TIMER_STATE_* (8 bytes)
+    .equ timer_pcb, 48                // Process that armed the timer, or NULL (8 bytes)
+    .equ timer_owner, 56              // Core ID of the wheel holding the timer (8 bytes)
+    .equ timer_slack, 64              // Allowed lateness in clock ticks (8 bytes)
+    .equ timer_interval, 72           // Re-arm period in ticks, 0 for one-shot (8 bytes)
+    .equ timer_kind, 80               // TIMER_KIND_* (8 bytes)
+    .equ timer_size, 88               // Total timer structure size
+
+// ------------------------------------------------------------
+// Timer Wheel Structure Layout
+// ------------------------------------------------------------
+// One hashed timing wheel per scheduler. Slot i holds a doubly
+// linked list of timers whose expiry tick (expiry >> shift) is
+// congruent to i; timers more than one rotation out stay in their
+// slot until their expiry passes. Each timer may fire up to its
+// slack after expiry; the wheel tracks the earliest "must fire by"
+// time so an idle scheduler can sleep until then and expire every
+// timer due by that point in one batch. Only the owning scheduler touches
+// the slots; other cores hand timers over through the inbox, a
+// lock-free stack kept on its own cache line.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
 //
-    .equ timer_expiry, 0              // Expiry time (8 bytes)
-    .equ timer_callback, 8           // Callback function pointer (8 bytes)
-    .equ timer_process_id, 16         // Process ID (8 bytes)
-    .equ timer_next, 24               // Next timer in list (8 bytes)
-    .equ timer_prev, 32               // Previous timer in list (8 bytes)
-    .equ timer_active, 40             // Active flag (8 bytes)
-    .equ timer_size, 48               // Total timer structure size
+    .equ wheel_core_id, 0             // Owning core ID (8 bytes)
+    .equ wheel_current_tick, 8        // First slot tick not yet fully processed (8 bytes)
+    .equ wheel_shift, 16              // Slot granularity as a shift (8 bytes)
+    .equ wheel_count, 24              // Timers linked into slots (8 bytes)
+    .equ wheel_next_expiry, 32        // Lower bound on earliest expiry, ~0 if none (8 bytes)
+    .equ wheel_free_list, 40          // Recycled timer nodes (8 bytes)
+    .equ wheel_pages, 48              // Chain of node pages for destroy (8 bytes)
+    .equ wheel_fired, 56              // Timers dispatched on this core (8 bytes)
+    .equ wheel_forwarded, 64          // Timers handed to another core (8 bytes)
+    .equ wheel_reclaimed, 72          // Cancelled timers reclaimed (8 bytes)
+    .equ wheel_default_slack, 80      // Slack applied by _timer_arm (8 bytes)
+    .equ wheel_next_deadline, 88      // Lower bound on earliest expiry + slack, ~0 if none (8 bytes)
+    .equ wheel_inbox, 128             // Cross-core MPSC stack head (own cache line)
+    .equ wheel_slots, 256             // Slot heads (TIMER_WHEEL_SLOTS * 8 bytes)
+    .equ wheel_size, 2304             // Total wheel structure size
+
+    // Scheduler state offsets (shared with scheduler.s)
+    .include "scheduler_state.inc"
+
+    // PCB offsets (shared with process.s)
+    .include "pcb.inc"
 
 // ------------------------------------------------------------
-// Timer System Initialization
+// Get System Ticks
 // ------------------------------------------------------------
-// Initialize the timer system with a timer wheel data structure.
-// Allocates memory for timer management and sets up the timer wheel.
+// Get the current system tick count using ARM Generic Timer.
+// Ticks are CNTVCT_EL0 units; use _clock_ticks_to_ns to convert.
 //
 // Parameters:
 //   None
 //
 // Returns:
-//   x0 (int) - success: 1 on success, 0 on failure
+//   x0 (uint64_t) - current_tick: Current system tick count
 //
-// Complexity: O(1) - Constant time initialization
+// Complexity: O(1) - Constant time operation
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-_timer_init:
-    // Save callee-saved registers
-    stp x19, x30, [sp, #-16]!
-    stp x20, x21, [sp, #-16]!
+_get_system_ticks:
+    // Read the ARM Generic Timer virtual counter (see clock.s)
+    b _clock_read_ticks
 
-    // Initialize timer system
-    // For now, this is a simplified implementation
-    // In a full implementation, this would:
-    // - Allocate timer wheel data structure
-    // - Initialize timer lists
-    // - Set up periodic task scheduling
-    // - Configure ARM Generic Timer
+// ------------------------------------------------------------
+// Cancel Timer
+// ------------------------------------------------------------
+// Cancel a previously scheduled timer. Safe to call from any core:
+// the timer state is moved from ARMED to CANCELLED with a single
+// compare-and-swap on {generation, state} and the owning wheel
+// unlinks and recycles the node the next time it visits the timer's
+// slot or inbox. An ID whose node has been recycled since (the timer
+// fired or was cancelled and the node re-armed) no longer matches the
+// generation, so it cannot cancel the unrelated timer now using it.
+//
+// Parameters:
+//   x0 (uint64_t) - timer_id: Timer ID to cancel
+//
+// Returns:
+//   x0 (int) - success: 1 if the timer was armed and is now cancelled,
+//              0 if the ID is NULL, stale, or the timer already
+//              fired/was cancelled
+//
+// Complexity: O(1) - Lock-free, no waiting on the owning core
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_cancel_timer:
+    // Validate timer ID
+    cbz x0, cancel_timer_failed
+
+    // Split the ID into node and expected {generation, ARMED}
+    and x1, x0, #0xFFFFFFFFFFFF
+    add x1, x1, #timer_state
+    lsr x5, x0, #TIMER_HANDLE_GEN_SHIFT
+    lsl x5, x5, #TIMER_GEN_SHIFT
+    orr x3, x5, #TIMER_STATE_CANCELLED
+    orr x5, x5, #TIMER_STATE_ARMED
+
+cancel_timer_retry:
+    ldaxr x2, [x1]
+    cmp x2, x5
+    b.ne cancel_timer_not_armed
+    stlxr w4, x3, [x1]
+    cbnz w4, cancel_timer_retry
 
     // Return success
     mov x0, #1
-    ldp x20, x21, [sp], #16
-    ldp x19, x30, [sp], #16
+    ret
+
+cancel_timer_not_armed:
+    clrex
+cancel_timer_failed:
+    mov x0, #0
     ret
 
 // ------------------------------------------------------------
-// Get System Ticks
+// Cancel Timeout
 // ------------------------------------------------------------
-// Get the current system tick count using ARM Generic Timer.
+// Cancel a timeout armed on a timer wheel (a NULL-callback
+// _timer_arm, as _process_block_on_timer uses). Same as _cancel_timer.
 //
 // Parameters:
-//   None
+//   x0 (uint64_t) - timeout_id: Timeout ID to cancel
 //
 // Returns:
-//   x0 (uint64_t) - current_tick: Current system tick count
+//   x0 (int) - success: 1 on success, 0 on failure
 //
 // Complexity: O(1) - Constant time operation
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-_get_system_ticks:
-    // Read ARM Generic Timer counter
-    // Note: This requires system register access which may not be available
-    // in userspace on macOS. For now, use a simplified approach.
-    
-    // Simplified implementation - return a dummy tick count
-    // In a full implementation, this would use:
-    // mrs x0, CNTPCT_EL0  // Read Generic Timer counter
-    
-    // For testing purposes, return a simple counter
-    mov x0, #1000  // Dummy tick count
-    ret
+_cancel_timeout:
+    // This is just an alias for cancel_timer
+    b _cancel_timer
 
 // ------------------------------------------------------------
-// Insert Timer
+// Timer Wheel Initialization
 // ------------------------------------------------------------
-// Insert a timer into the timer wheel for future execution.
+// Allocate the per-core timer wheel for one scheduler and attach it
+// to the scheduler state. The wheel starts at the scheduler's current
+// clock tick. Calling it again for an initialized core is a no-op.
+// _timer_arm calls it on first use, so schedulers that never arm a
+// timer never map a wheel.
 //
 // Parameters:
-//   x0 (uint64_t) - expiry_ticks: When the timer should expire
-//   x1 (void*) - callback: Callback function to call
-//   x2 (uint64_t) - process_id: Process ID associated with timer
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
 //
 // Returns:
-//   x0 (uint64_t) - timer_id: Timer ID for cancellation, or 0 on failure
+//   x0 (int) - success: 1 on success, 0 on failure
 //
-// Complexity: O(1) - Constant time operation
+// Complexity: O(1) - One mapping, slots are zero-filled by mmap
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-_insert_timer:
+_timer_wheel_init:
     // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
-    stp x22, x23, [sp, #-16]!
 
     // Validate parameters
-    cbz x0, insert_timer_failed  // Check expiry_ticks
-    cbz x1, insert_timer_failed  // Check callback
+    cbz x0, timer_wheel_init_failed
+    cmp x1, #MAX_CORES
+    b.ge timer_wheel_init_failed
 
-    // Save parameters
-    mov x19, x0  // expiry_ticks
-    mov x20, x1  // callback
-    mov x21, x2  // process_id
-
-    // Allocate timer structure using mmap (like other functions)
-    mov x0, xzr                      // addr = NULL (let system choose)
-    mov x1, #timer_size              // length = timer_size bytes
-    mov x2, #3                       // prot = PROT_READ | PROT_WRITE
-    mov x3, #0x1002                 // flags = MAP_PRIVATE | MAP_ANON (macOS)
-    mov x4, #-1                      // fd = -1 (not a file mapping)
-    mov x5, xzr                      // offset = 0
-    bl _mmap                         // Call mmap C library function
-    
-    // Check for mmap failure
-    cmp x0, #-1                      // mmap returns -1 on failure
-    b.eq insert_timer_failed         // Handle allocation failure
-    
-    mov x22, x0  // timer structure
-
-    // Initialize timer structure
-    str x19, [x22, #timer_expiry]      // expiry
-    str x20, [x22, #timer_callback]    // callback
-    str x21, [x22, #timer_process_id]  // process_id
-    str xzr, [x22, #timer_next]        // next = NULL
-    str xzr, [x22, #timer_prev]         // prev = NULL
-    mov x23, #1
-    str x23, [x22, #timer_active]      // active = 1
-
-    // Insert into timer wheel (simplified)
-    // In a full implementation, this would:
-    // - Calculate timer wheel slot
-    // - Insert into appropriate slot
-    // - Maintain sorted order
-
-    // Return timer ID (use timer address as ID)
-    mov x0, x22
-    ldp x22, x23, [sp], #16
+    mov x2, #scheduler_size
+    madd x19, x1, x2, x0              // x19 = scheduler state address
+    mov x20, x1                       // core_id
+
+    // Already initialized?
+    ldr x0, [x19, #scheduler_timer_wheel]
+    cbnz x0, timer_wheel_init_done
+
+    // Allocate wheel (anonymous mappings are zero-filled)
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, #wheel_size               // length = wheel_size bytes
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON  // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq timer_wheel_init_failed
+    mov x21, x0
+
+    // Set the non-zero fields
+    str x20, [x21, #wheel_core_id]
+    mov x0, #TIMER_WHEEL_SHIFT
+    str x0, [x21, #wheel_shift]
+    mov x0, #-1
+    str x0, [x21, #wheel_next_expiry]
+    str x0, [x21, #wheel_next_deadline]
+
+    // Start the wheel at the scheduler's current tick
+    ldr x0, [x19, #scheduler_cached_now]
+    cbnz x0, timer_wheel_init_have_now
+    isb
+    mrs x0, CNTVCT_EL0
+timer_wheel_init_have_now:
+    lsr x0, x0, #TIMER_WHEEL_SHIFT
+    str x0, [x21, #wheel_current_tick]
+
+    // Publish to the scheduler state (release: other cores forward to it)
+    add x0, x19, #scheduler_timer_wheel
+    stlr x21, [x0]
+
+timer_wheel_init_done:
+    mov x0, #1
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
-insert_timer_failed:
+timer_wheel_init_failed:
     mov x0, #0
-    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
 // ------------------------------------------------------------
-// Insert Timeout Timer
+// Timer Wheel Destroy
 // ------------------------------------------------------------
-// Insert a timeout timer for blocking operations (allows NULL callback).
+// Release a scheduler's timer wheel and every node page it
+// allocated. Timers forwarded to other cores may live in these pages,
+// so wheels are destroyed together at shutdown.
 //
 // Parameters:
-//   x0 (uint64_t) - expiry_ticks: When the timer should expire
-//   x1 (void*) - callback: Callback function to call (can be NULL)
-//   x2 (uint64_t) - process_id: Process ID associated with timer
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
 //
 // Returns:
-//   x0 (uint64_t) - timer_id: Timer ID for cancellation, or 0 on failure
+//   x0 (int) - success: 1 on success (including no wheel), 0 on invalid arguments
 //
-// Complexity: O(1) - Constant time operation
+// Complexity: O(p) where p is the number of node pages
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-_insert_timeout_timer:
+_timer_wheel_destroy:
     // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
     stp x20, x21, [sp, #-16]!
-    stp x22, x23, [sp, #-16]!
 
-    // Validate parameters (callback can be NULL for timeout timers)
-    cbz x0, insert_timeout_timer_failed  // Check expiry_ticks
+    // Validate parameters
+    cbz x0, timer_wheel_destroy_failed
+    cmp x1, #MAX_CORES
+    b.ge timer_wheel_destroy_failed
 
-    // Save parameters
-    mov x19, x0  // expiry_ticks
-    mov x20, x1  // callback
-    mov x21, x2  // process_id
-
-    // Allocate timer structure using mmap (like other functions)
-    mov x0, xzr                      // addr = NULL (let system choose)
-    mov x1, #timer_size              // length = timer_size bytes
-    mov x2, #3                       // prot = PROT_READ | PROT_WRITE
-    mov x3, #0x1002                 // flags = MAP_PRIVATE | MAP_ANON (macOS)
-    mov x4, #-1                      // fd = -1 (not a file mapping)
-    mov x5, xzr                      // offset = 0
-    bl _mmap                         // Call mmap C library function
-    
-    // Check for mmap failure
-    cmp x0, #-1                      // mmap returns -1 on failure
-    b.eq insert_timeout_timer_failed // Handle allocation failure
-    
-    mov x22, x0  // timer structure
-
-    // Initialize timer structure
-    str x19, [x22, #timer_expiry]      // expiry
-    str x20, [x22, #timer_callback]    // callback
-    str x21, [x22, #timer_process_id]  // process_id
-    str xzr, [x22, #timer_next]        // next = NULL
-    str xzr, [x22, #timer_prev]         // prev = NULL
-    mov x23, #1
-    str x23, [x22, #timer_active]      // active = 1
-
-    // Insert into timer wheel (simplified)
-    // In a full implementation, this would:
-    // - Calculate timer wheel slot
-    // - Insert into appropriate slot
-    // - Maintain sorted order
-
-    // Return timer ID (use timer address as ID)
-    mov x0, x22
-    ldp x22, x23, [sp], #16
+    mov x2, #scheduler_size
+    madd x19, x1, x2, x0              // x19 = scheduler state address
+    ldr x20, [x19, #scheduler_timer_wheel]
+    cbz x20, timer_wheel_destroy_done
+    str xzr, [x19, #scheduler_timer_wheel]
+
+    // Unmap node pages (first word of each page links the chain)
+    ldr x21, [x20, #wheel_pages]
+timer_wheel_destroy_pages:
+    cbz x21, timer_wheel_destroy_wheel
+    ldr x19, [x21]                    // next page
+    mov x0, x21
+    mov x1, #PAGE_SIZE
+    bl _munmap
+    mov x21, x19
+    b timer_wheel_destroy_pages
+
+timer_wheel_destroy_wheel:
+    mov x0, x20
+    mov x1, #wheel_size
+    bl _munmap
+
+timer_wheel_destroy_done:
+    mov x0, #1
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
-insert_timeout_timer_failed:
+timer_wheel_destroy_failed:
     mov x0, #0
-    ldp x22, x23, [sp], #16
     ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
 // ------------------------------------------------------------
-// Cancel Timer
+// Timer Node Allocate (internal)
 // ------------------------------------------------------------
-// Cancel a previously scheduled timer.
+// Pop a node from the wheel's free list, refilling it one page at a
+// time. The first node-sized slot of each page is the page header.
 //
 // Parameters:
-//   x0 (uint64_t) - timer_id: Timer ID to cancel
+//   x0 (void*) - wheel: Timer wheel
 //
 // Returns:
-//   x0 (int) - success: 1 on success, 0 on failure
+//   x0 (void*) - node: Timer node, or NULL if allocation failed
 //
-// Complexity: O(1) - Constant time operation
+// Complexity: O(1) amortized
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-_cancel_timer:
-    // Save callee-saved registers
+_timer_node_alloc:
+    ldr x1, [x0, #wheel_free_list]
+    cbz x1, timer_node_alloc_refill
+    ldr x2, [x1, #timer_next]
+    str x2, [x0, #wheel_free_list]
+    mov x0, x1
+    ret
+
+timer_node_alloc_refill:
     stp x19, x30, [sp, #-16]!
+    mov x19, x0
 
-    // Validate timer ID
-    cbz x0, cancel_timer_failed
-    mov x19, x0  // timer_id
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, #PAGE_SIZE                // length = one page
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON  // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq timer_node_alloc_failed
 
-    // Mark timer as inactive
-    str xzr, [x19, #timer_active]
+    // Link the page into the wheel's page chain
+    ldr x1, [x19, #wheel_pages]
+    str x1, [x0]
+    str x0, [x19, #wheel_pages]
 
-    // Remove from timer wheel (simplified)
-    // In a full implementation, this would:
-    // - Remove from timer wheel slot
-    // - Update linked list pointers
-    // - Free timer structure
+    // Carve the rest of the page onto the free list
+    add x1, x0, #timer_size           // first node
+    add x2, x0, #PAGE_SIZE            // page end
+    mov x3, xzr                       // free list head
+timer_node_alloc_carve:
+    add x4, x1, #timer_size
+    cmp x4, x2
+    b.hi timer_node_alloc_carved
+    str x3, [x1, #timer_next]
+    mov x3, x1
+    mov x1, x4
+    b timer_node_alloc_carve
 
-    // Return success
-    mov x0, #1
+timer_node_alloc_carved:
+    // Hand out the head, keep the rest
+    ldr x4, [x3, #timer_next]
+    str x4, [x19, #wheel_free_list]
+    mov x0, x3
     ldp x19, x30, [sp], #16
     ret
 
-cancel_timer_failed:
+timer_node_alloc_failed:
     mov x0, #0
     ldp x19, x30, [sp], #16
     ret
 
 // ------------------------------------------------------------
-// Process Timers
+// Timer Node Free (internal)
 // ------------------------------------------------------------
-// Process all expired timers and execute their callbacks.
+// Return a node to the wheel's free list and bump its generation,
+// invalidating every ID handed out for it so far.
 //
 // Parameters:
+//   x0 (void*) - wheel: Timer wheel
+//   x1 (void*) - node: Timer node
+//
+// Returns:
 //   None
 //
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x2, x3
+//
+_timer_node_free:
+    ldr x2, [x1, #timer_state]
+    mov x3, #1
+    add x2, x2, x3, lsl #TIMER_GEN_SHIFT
+    and x2, x2, #0xFFFF00000000        // new generation (wraps), state FREE
+    str x2, [x1, #timer_state]
+    ldr x2, [x0, #wheel_free_list]
+    str x2, [x1, #timer_next]
+    str x1, [x0, #wheel_free_list]
+    ret
+
+// ------------------------------------------------------------
+// Timer Wheel Link (internal)
+// ------------------------------------------------------------
+// Insert a node at the head of the slot for its expiry tick. Timers
+// already due are placed in the current slot so the next pass fires
+// them. Keeps the next-expiry and next-deadline lower bounds up to date.
+//
+// Parameters:
+//   x0 (void*) - wheel: Timer wheel (must be owned by the calling core)
+//   x1 (void*) - node: Timer node with expiry set
+//
 // Returns:
-//   x0 (uint32_t) - expired_count: Number of timers processed
+//   None
 //
-// Complexity: O(n) where n is number of expired timers
+// Complexity: O(1)
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-_process_timers:
-    // Save callee-saved registers
-    stp x19, x30, [sp, #-16]!
+// Clobbers: x2, x3, x4, x5, x6
+//
+_timer_wheel_link:
+    ldr x2, [x1, #timer_expiry]
+    ldr x3, [x0, #wheel_shift]
+    lsr x4, x2, x3                    // expiry tick
+    ldr x5, [x0, #wheel_current_tick]
+    cmp x4, x5
+    csel x4, x5, x4, lo               // past-due timers go in the current slot
+    and x4, x4, #TIMER_WHEEL_SLOT_MASK
+    add x5, x0, #wheel_slots
+    add x5, x5, x4, lsl #3            // slot head address
 
-    // Get current system time
-    bl _get_system_ticks
-    mov x19, x0  // current_time
+    ldr x6, [x5]
+    str x6, [x1, #timer_next]
+    str xzr, [x1, #timer_prev]
+    cbz x6, timer_wheel_link_empty
+    str x1, [x6, #timer_prev]
+timer_wheel_link_empty:
+    str x1, [x5]
 
-    // Process expired timers (simplified)
-    // In a full implementation, this would:
-    // - Iterate through timer wheel slots
-    // - Find all timers with expiry <= current_time
-    // - Execute callbacks
-    // - Remove expired timers
+    ldr x6, [x0, #wheel_count]
+    add x6, x6, #1
+    str x6, [x0, #wheel_count]
 
-    // For now, return 0 (no timers processed)
-    mov x0, #0
-    ldp x19, x30, [sp], #16
+    ldr x6, [x0, #wheel_next_expiry]
+    cmp x2, x6
+    csel x6, x2, x6, lo
+    str x6, [x0, #wheel_next_expiry]
+
+    // Must-fire-by = expiry + slack, saturating
+    ldr x3, [x1, #timer_slack]
+    adds x2, x2, x3
+    csinv x2, x2, xzr, cc
+    ldr x6, [x0, #wheel_next_deadline]
+    cmp x2, x6
+    csel x6, x2, x6, lo
+    str x6, [x0, #wheel_next_deadline]
+
+    ldr x6, [x0, #wheel_core_id]
+    str x6, [x1, #timer_owner]
+    ret
+
+// ------------------------------------------------------------
+// Timer Wheel Unlink (internal)
+// ------------------------------------------------------------
+// Remove a node from the slot list it is linked into.
+//
+// Parameters:
+//   x0 (void*) - wheel: Timer wheel
+//   x1 (void*) - node: Timer node
+//   x2 (void**) - slot: Address of the slot head holding the node
+//
+// Returns:
+//   None
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x3, x4
+//
+_timer_wheel_unlink:
+    ldr x3, [x1, #timer_next]
+    ldr x4, [x1, #timer_prev]
+    cbz x4, timer_wheel_unlink_head
+    str x3, [x4, #timer_next]
+    b timer_wheel_unlink_fix_next
+timer_wheel_unlink_head:
+    str x3, [x2]
+timer_wheel_unlink_fix_next:
+    cbz x3, timer_wheel_unlink_done
+    str x4, [x3, #timer_prev]
+timer_wheel_unlink_done:
+    ldr x3, [x0, #wheel_count]
+    sub x3, x3, #1
+    str x3, [x0, #wheel_count]
     ret
 
 // ------------------------------------------------------------
-// Timer Tick
+// Timer Wheel Push Inbox (internal)
 // ------------------------------------------------------------
-// Called each scheduler loop to process timers and periodic tasks.
+// Hand a timer to another core's wheel. Lock-free push onto the
+// target's inbox stack; the target links it on its next pass.
 //
 // Parameters:
+//   x0 (void*) - wheel: Target timer wheel
+//   x1 (void*) - node: Timer node (not linked in any slot)
+//
+// Returns:
 //   None
 //
+// Complexity: O(1) expected, retries only under contention
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x2, x3, x4, x5
+//
+_timer_wheel_push_inbox:
+    add x2, x0, #wheel_inbox
+timer_push_inbox_retry:
+    ldr x3, [x2]
+    str x3, [x1, #timer_next]
+    ldaxr x4, [x2]
+    cmp x4, x3
+    b.ne timer_push_inbox_changed
+    stlxr w5, x1, [x2]                // release publishes the node fields
+    cbnz w5, timer_push_inbox_retry
+    ret
+timer_push_inbox_changed:
+    clrex
+    b timer_push_inbox_retry
+
+// ------------------------------------------------------------
+// Timer Wheel Drain Inbox (internal)
+// ------------------------------------------------------------
+// Take every timer other cores pushed to this wheel and link it into
+// the slots, reclaiming any that were cancelled in flight.
+//
+// Parameters:
+//   x0 (void*) - wheel: Timer wheel owned by the calling core
+//
 // Returns:
 //   None
 //
-// Complexity: O(n) where n is number of expired timers
+// Complexity: O(k) where k is the number of inbox timers
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-_timer_tick:
-    // Save callee-saved registers
+_timer_wheel_drain_inbox:
     stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    mov x19, x0
+
+    // Detach the whole stack in one exchange
+    add x0, x19, #wheel_inbox
+timer_drain_inbox_swap:
+    ldaxr x20, [x0]
+    stlxr w1, xzr, [x0]
+    cbnz w1, timer_drain_inbox_swap
+
+timer_drain_inbox_loop:
+    cbz x20, timer_drain_inbox_done
+    ldr x21, [x20, #timer_next]
+    ldr w1, [x20, #timer_state]
+    cmp w1, #TIMER_STATE_CANCELLED
+    b.eq timer_drain_inbox_reclaim
+    mov x0, x19
+    mov x1, x20
+    bl _timer_wheel_link
+    b timer_drain_inbox_next
 
-    // Process expired timers
-    bl _process_timers
+timer_drain_inbox_reclaim:
+    mov x0, x19
+    mov x1, x20
+    bl _timer_node_free
+    ldr x1, [x19, #wheel_reclaimed]
+    add x1, x1, #1
+    str x1, [x19, #wheel_reclaimed]
 
-    // Process periodic tasks (simplified)
-    // In a full implementation, this would:
-    // - Check if load balancing check is due
-    // - Update system statistics
-    // - Perform periodic maintenance
+timer_drain_inbox_next:
+    mov x20, x21
+    b timer_drain_inbox_loop
 
+timer_drain_inbox_done:
+    ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
 // ------------------------------------------------------------
-// Schedule Timeout
+// Timer Arm
 // ------------------------------------------------------------
-// Schedule a timeout for a blocking operation.
+// Arm a timer on the calling scheduler's wheel with the wheel's
+// default slack (see _timer_wheel_set_default_slack). The wheel is
+// created on the first arm if the scheduler does not have one yet
+// (zero default slack in that case). The timer is
+// owned by this scheduler; if the process later migrates, the timer
+// follows it lazily when it expires (see _timer_dispatch).
+//
+// Callbacks are invoked on the owning core as
+//   callback(scheduler_states, core_id, pcb, argument).
+// A NULL callback with a PCB wakes the process if it is still blocked
+// on this timer (REASON_TIMER with this timer's ID in
+// pcb_blocking_data), which is how timed blocking is implemented.
+// Timers hold the PCB pointer, so they must be cancelled before the
+// process is destroyed; the timed-blocking timer is cancelled for
+// the caller by _process_wake and on exit.
 //
 // Parameters:
-//   x0 (uint64_t) - timeout_ticks: Timeout duration in ticks
-//   x1 (uint64_t) - process_id: Process ID to timeout
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Calling core ID (0 to MAX_CORES-1)
+//   x2 (void*) - pcb: Process arming the timer, or NULL
+//   x3 (uint64_t) - expiry_ticks: Absolute expiry in clock ticks
+//   x4 (void*) - callback: Callback function, or NULL
+//   x5 (uint64_t) - argument: Value passed to the callback
 //
 // Returns:
-//   x0 (uint64_t) - timeout_id: Timeout ID for cancellation
+//   x0 (uint64_t) - timer_id: Timer ID for cancellation, or 0 on failure
 //
-// Complexity: O(1) - Constant time operation
+// Complexity: O(1) - Slot insertion, no sorting
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
+//
+_timer_arm:
+    // Look up the wheel's default slack; _timer_arm_slack validates
+    mov x6, xzr
+    cbz x0, _timer_arm_slack
+    cmp x1, #MAX_CORES
+    b.hs _timer_arm_slack
+    mov x7, #scheduler_size
+    madd x7, x1, x7, x0
+    ldr x7, [x7, #scheduler_timer_wheel]
+    cbz x7, _timer_arm_slack
+    ldr x6, [x7, #wheel_default_slack]
+    b _timer_arm_slack
+
+// ------------------------------------------------------------
+// Timer Arm with Slack
+// ------------------------------------------------------------
+// Arm a timer that may fire any time in [expiry, expiry + slack].
+// Timers never fire early. Slack lets the idle path batch many
+// nearby deadlines into a single wakeup.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Calling core ID (0 to MAX_CORES-1)
+//   x2 (void*) - pcb: Process arming the timer, or NULL
+//   x3 (uint64_t) - expiry_ticks: Absolute expiry in clock ticks
+//   x4 (void*) - callback: Callback function, or NULL
+//   x5 (uint64_t) - argument: Value passed to the callback
+//   x6 (uint64_t) - slack_ticks: Allowed lateness in clock ticks
+//
+// Returns:
+//   x0 (uint64_t) - timer_id: Timer ID for cancellation, or 0 on failure
 //
-_schedule_timeout:
+// Complexity: O(1) - Slot insertion, no sorting
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_timer_arm_slack:
     // Save callee-saved registers
     stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+    stp x26, x27, [sp, #-16]!
 
     // Validate parameters
-    cbz x0, schedule_timeout_failed  // Check timeout_ticks
-    cbz x1, schedule_timeout_failed  // Check process_id
+    cbz x0, timer_arm_failed
+    cmp x1, #MAX_CORES
+    b.ge timer_arm_failed
+    cbz x3, timer_arm_failed
 
     // Save parameters
-    mov x19, x0  // timeout_ticks
-    mov x20, x1  // process_id
+    mov x19, x0  // scheduler_states
+    mov x20, x1  // core_id
+    mov x21, x2  // pcb
+    mov x22, x3  // expiry_ticks
+    mov x23, x4  // callback
+    mov x24, x5  // argument
+    mov x26, x6  // slack_ticks
+
+    // Find this core's wheel, creating it on first use
+    mov x7, #scheduler_size
+    madd x7, x20, x7, x19
+    ldr x25, [x7, #scheduler_timer_wheel]
+    cbnz x25, timer_arm_have_wheel
+    mov x0, x19
+    mov x1, x20
+    bl _timer_wheel_init
+    cbz x0, timer_arm_failed
+    mov x7, #scheduler_size
+    madd x7, x20, x7, x19
+    ldr x25, [x7, #scheduler_timer_wheel]
 
-    // Get current time and calculate expiry
-    bl _get_system_ticks
-    add x0, x0, x19  // current_time + timeout_ticks
+timer_arm_have_wheel:
 
-    // Create timeout callback (simplified)
-    // In a full implementation, this would create a proper callback
-    mov x1, #0  // Dummy callback
+    mov x0, x25
+    bl _timer_node_alloc
+    cbz x0, timer_arm_failed
+    mov x19, x0  // node (scheduler_states no longer needed)
 
-    // Insert timer
-    mov x2, x20  // process_id
-    bl _insert_timeout_timer
+    // Initialize node
+    str x22, [x19, #timer_expiry]
+    str x23, [x19, #timer_callback]
+    str x24, [x19, #timer_process_id]
+    str x21, [x19, #timer_pcb]
+    str x26, [x19, #timer_slack]
+    str xzr, [x19, #timer_interval]
+    mov x0, #TIMER_KIND_CALLBACK
+    str x0, [x19, #timer_kind]
 
+    // Arm under the node's current generation; release orders the
+    // generation bump in _timer_node_free before a canceller sees ARMED
+    ldr x0, [x19, #timer_state]
+    and x26, x0, #0xFFFF00000000
+    orr x0, x26, #TIMER_STATE_ARMED
+    add x1, x19, #timer_state
+    stlr x0, [x1]
+
+    // Link into the wheel
+    mov x0, x25
+    mov x1, x19
+    bl _timer_wheel_link
+
+    // Timer ID: generation above the node address
+    lsl x26, x26, #(TIMER_HANDLE_GEN_SHIFT - TIMER_GEN_SHIFT)
+    orr x0, x19, x26
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
-schedule_timeout_failed:
+timer_arm_failed:
     mov x0, #0
+    ldp x26, x27, [sp], #16
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
     ldp x19, x30, [sp], #16
     ret
 
 // ------------------------------------------------------------
-// Cancel Timeout
+// Send After
 // ------------------------------------------------------------
-// Cancel a scheduled timeout.
+// Deliver a message to a process after a delay. On expiry the owning
+// scheduler enqueues the message directly into the target's mailbox
+// and wakes the target if it is blocked in receive. No process or
+// callback is involved. If the target migrates, the timer follows it
+// and is delivered by the target's new scheduler. Cancel with
+// _cancel_timer, at the latest before the target is destroyed.
 //
 // Parameters:
-//   x0 (uint64_t) - timeout_id: Timeout ID to cancel
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Calling core ID (0 to MAX_CORES-1)
+//   x2 (void*) - target_pcb: Receiving process
+//   x3 (uint64_t) - delay_ticks: Delay from the scheduler's cached now
+//   x4 (uint64_t) - message: Message data to deliver (non-zero; 0 is
+//                   reserved by _send_message for "no message")
 //
 // Returns:
-//   x0 (int) - success: 1 on success, 0 on failure
+//   x0 (uint64_t) - timer_id: Timer ID for cancellation, or 0 on failure
+//                   (including a message of 0)
 //
-// Complexity: O(1) - Constant time operation
+// Complexity: O(1)
 //
-// Version: 0.10
+// Version: 0.12
 // Author: Lee Barney
-// Last Modified: 2025-01-19
+// Last Modified: 2026-10-18
 //
-_cancel_timeout:
-    // This is just an alias for cancel_timer
-    b _cancel_timer
+_send_after:
+    mov x5, xzr                       // one-shot
+    b timer_arm_message
+
+// ------------------------------------------------------------
+// Send Interval
+// ------------------------------------------------------------
+// Deliver a message to a process every interval_ticks until the timer
+// is cancelled with _cancel_timer. The node is re-armed in place, so
+// a periodic timer allocates nothing after the first period. Periods
+// missed entirely (for example while the scheduler was saturated) are
+// skipped rather than delivered in a burst. A cancel racing with a
+// delivery may let that one delivery through.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Calling core ID (0 to MAX_CORES-1)
+//   x2 (void*) - target_pcb: Receiving process
+//   x3 (uint64_t) - interval_ticks: Period in clock ticks (non-zero)
+//   x4 (uint64_t) - message: Message data to deliver (non-zero, as for
+//                   _send_after)
+//
+// Returns:
+//   x0 (uint64_t) - timer_id: Timer ID for cancellation, or 0 on failure
+//                   (including a message of 0)
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_send_interval:
+    cbz x3, timer_arm_message_invalid
+    mov x5, x3                        // interval = first delay
+
+timer_arm_message:
+    // Shared body: x0-x4 as above, x5 = interval (0 for one-shot)
+    cbz x2, timer_arm_message_invalid
+    cbz x4, timer_arm_message_invalid  // would never be delivered
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+
+    mov x19, x0  // scheduler_states
+    mov x20, x1  // core_id
+    mov x21, x2  // target_pcb
+    mov x22, x3  // delay_ticks
+    mov x23, x4  // message
+    str x5, [sp, #-16]!
+
+    // Expiry relative to this scheduler's clock
+    bl _scheduler_get_cached_now
+    adds x3, x0, x22
+    csinv x3, x3, xzr, cc
+    mov x0, x19
+    mov x1, x20
+    mov x2, x21
+    mov x4, xzr
+    mov x5, x23
+    bl _timer_arm
+    ldr x5, [sp], #16
+    cbz x0, timer_arm_message_done
+
+    // Only this core links or dispatches the node, so finish filling it in
+    and x1, x0, #0xFFFFFFFFFFFF
+    str x5, [x1, #timer_interval]
+    mov x2, #TIMER_KIND_MESSAGE
+    str x2, [x1, #timer_kind]
+
+timer_arm_message_done:
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+timer_arm_message_invalid:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Timer Dispatch (internal)
+// ------------------------------------------------------------
+// Act on an expired timer that has been unlinked from its slot.
+// If the arming process has migrated to another scheduler, the timer
+// is forwarded to that scheduler's inbox instead of firing here, so
+// timers follow processes lazily and never need touching at steal
+// time. Otherwise the timer's action runs: message timers enqueue
+// directly into the target mailbox, callback timers call back, and
+// timers with neither wake the process.
+//
+// One-shot timers are claimed (ARMED -> FIRED) before acting and then
+// recycled. Interval timers stay ARMED so a cancel from any core takes
+// effect at any time; they are re-linked one period later, skipping
+// periods that were missed entirely.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Owning core ID
+//   x2 (void*) - wheel: Owning timer wheel
+//   x3 (void*) - node: Expired timer node
+//   x4 (uint64_t) - now: Current time in clock ticks
+//
+// Returns:
+//   x0 (int) - fired: 1 if dispatched on this core, 0 if forwarded or cancelled
+//
+// Complexity: O(1) plus callback cost
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_timer_dispatch:
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+    stp x22, x23, [sp, #-16]!
+    stp x24, x25, [sp, #-16]!
+
+    mov x19, x0  // scheduler_states
+    mov x20, x1  // core_id
+    mov x21, x2  // wheel
+    mov x22, x3  // node
+    mov x24, x4  // now
+
+    // Has the owning process moved to another scheduler?
+    ldr x0, [x22, #timer_pcb]
+    cbz x0, timer_dispatch_claim
+    ldr x1, [x0, #pcb_scheduler_id]
+    cmp x1, x20
+    b.eq timer_dispatch_claim
+    cmp x1, #MAX_CORES
+    b.hs timer_dispatch_claim
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x19
+    ldr x0, [x2, #scheduler_timer_wheel]
+    cbz x0, timer_dispatch_claim
+    mov x25, x1  // new owner core
+
+    // Trace before the hand-over: the node belongs to the new core after it
+    // (the timer follows its process)
+    mov x0, #scheduler_size
+    madd x0, x20, x0, x19
+    ldr w1, [x0, #scheduler_trace_mask]
+    tbz w1, #TRACE_CLASS_MIGRATE, timer_dispatch_forward_traced
+    mov x1, #TRACE_EVENT_MIGRATE
+    ldr x2, [x22, #timer_pcb]
+    ldr x2, [x2, #pcb_pid]
+    mov x3, x25
+    bl _trace_record
+timer_dispatch_forward_traced:
+
+    // Forward to the new owner and wake it if it is idle
+    mov x2, #scheduler_size
+    madd x2, x25, x2, x19
+    ldr x0, [x2, #scheduler_timer_wheel]
+    mov x1, x22
+    bl _timer_wheel_push_inbox
+    mov x0, x19
+    mov x1, x25
+    bl _scheduler_wake
+    ldr x0, [x21, #wheel_forwarded]
+    add x0, x0, #1
+    str x0, [x21, #wheel_forwarded]
+    mov x0, #0
+    b timer_dispatch_done
+
+timer_dispatch_claim:
+    // Interval timers are not claimed, only checked
+    ldr x0, [x22, #timer_interval]
+    cbz x0, timer_dispatch_claim_once
+    add x1, x22, #timer_state
+    ldar w1, [x1]
+    cmp w1, #TIMER_STATE_ARMED
+    b.ne timer_dispatch_lost
+    b timer_dispatch_run
+
+timer_dispatch_claim_once:
+    // Claim the timer; losing to a concurrent cancel means reclaim
+    add x0, x22, #timer_state
+timer_dispatch_cas:
+    ldaxr x1, [x0]
+    cmp w1, #TIMER_STATE_ARMED
+    b.ne timer_dispatch_lost
+    and x2, x1, #0xFFFF00000000
+    orr x2, x2, #TIMER_STATE_FIRED
+    stlxr w3, x2, [x0]
+    cbnz w3, timer_dispatch_cas
+
+timer_dispatch_run:
+    ldr x0, [x22, #timer_kind]
+    cmp x0, #TIMER_KIND_MESSAGE
+    b.eq timer_dispatch_message
+
+    ldr x23, [x22, #timer_callback]
+    cbz x23, timer_dispatch_default
+    mov x0, x19
+    mov x1, x20
+    ldr x2, [x22, #timer_pcb]
+    ldr x3, [x22, #timer_process_id]
+    blr x23
+    b timer_dispatch_fired
+
+timer_dispatch_default:
+    // Default action: wake the process if it is still blocked on this
+    // timer (REASON_TIMER with this timer's ID in pcb_blocking_data)
+    ldr x2, [x22, #timer_pcb]
+    cbz x2, timer_dispatch_fired
+    ldr x3, [x2, #pcb_state]
+    cmp x3, #PROCESS_STATE_WAITING
+    b.ne timer_dispatch_fired
+    ldr x3, [x2, #pcb_blocking_reason]
+    cmp x3, #REASON_TIMER
+    b.ne timer_dispatch_fired
+    ldr x3, [x22, #timer_state]
+    and x3, x3, #0xFFFF00000000
+    lsl x3, x3, #(TIMER_HANDLE_GEN_SHIFT - TIMER_GEN_SHIFT)
+    orr x3, x3, x22
+    ldr x4, [x2, #pcb_blocking_data]
+    cmp x3, x4
+    b.ne timer_dispatch_fired
+    mov x0, x19
+    mov x1, x20
+    bl _process_wake
+    b timer_dispatch_fired
+
+timer_dispatch_message:
+    // Enqueue straight into the target mailbox (self-addressed, as
+    // the timer has no sending process); a full mailbox drops it
+    ldr x0, [x22, #timer_pcb]
+    mov x1, x0
+    ldr x2, [x22, #timer_process_id]
+    bl _send_message
+
+    // Trace: sent on the process's behalf (no sending process)
+    mov x0, #scheduler_size
+    madd x0, x20, x0, x19
+    ldr w1, [x0, #scheduler_trace_mask]
+    tbz w1, #TRACE_CLASS_MESSAGE, timer_dispatch_message_traced
+    mov x1, #TRACE_EVENT_SEND
+    mov x2, #0
+    ldr x3, [x22, #timer_pcb]
+    ldr x3, [x3, #pcb_pid]
+    bl _trace_record
+timer_dispatch_message_traced:
+
+    // Wake the target if it is blocked in receive
+    ldr x2, [x22, #timer_pcb]
+    ldr x3, [x2, #pcb_state]
+    cmp x3, #PROCESS_STATE_WAITING
+    b.ne timer_dispatch_fired
+    ldr x3, [x2, #pcb_blocking_reason]
+    cmp x3, #REASON_RECEIVE
+    b.ne timer_dispatch_fired
+    mov x0, x19
+    mov x1, x20
+    bl _process_wake
+
+timer_dispatch_fired:
+    ldr x0, [x21, #wheel_fired]
+    add x0, x0, #1
+    str x0, [x21, #wheel_fired]
+
+    ldr x1, [x22, #timer_interval]
+    cbnz x1, timer_dispatch_rearm
+    mov x0, x21
+    mov x1, x22
+    bl _timer_node_free
+    mov x0, #1
+    b timer_dispatch_done
+
+timer_dispatch_rearm:
+    // Next period; if that has already passed, restart from now
+    ldr x0, [x22, #timer_expiry]
+    adds x0, x0, x1
+    b.cs timer_dispatch_rearm_from_now
+    cmp x0, x24
+    b.hs timer_dispatch_rearm_link
+timer_dispatch_rearm_from_now:
+    adds x0, x24, x1
+    csinv x0, x0, xzr, cc
+timer_dispatch_rearm_link:
+    str x0, [x22, #timer_expiry]
+    mov x0, x21
+    mov x1, x22
+    bl _timer_wheel_link
+    mov x0, #1
+    b timer_dispatch_done
+
+timer_dispatch_lost:
+    clrex
+    ldr x0, [x21, #wheel_reclaimed]
+    add x0, x0, #1
+    str x0, [x21, #wheel_reclaimed]
+    mov x0, x21
+    mov x1, x22
+    bl _timer_node_free
+    mov x0, #0
+
+timer_dispatch_done:
+    ldp x24, x25, [sp], #16
+    ldp x22, x23, [sp], #16
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Timer Wheel Process
+// ------------------------------------------------------------
+// Expire timers on one scheduler's wheel. Adopts timers handed over
+// by other cores, walks every slot from the last processed tick up to
+// now (at most one full rotation), dispatches expired timers and
+// reclaims cancelled ones. The current tick's slot is revisited on
+// the next call because it may still hold timers due later in the
+// same tick. Finally refreshes the next-expiry lower bound.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Owning core ID (0 to MAX_CORES-1)
+//   x2 (uint64_t) - now: Current time in clock ticks
+//
+// Returns:
+//   x0 (uint64_t) - fired_count: Timers dispatched on this core
+//
+// Complexity: O(s + n) where s is slots elapsed (<= TIMER_WHEEL_SLOTS)
+//             and n is timers in those slots
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_timer_wheel_process:
+    // Save callee-saved registers
+    stp x19, x20, [sp, #-16]!
+    stp x21, x22, [sp, #-16]!
+    stp x23, x24, [sp, #-16]!
+    stp x25, x26, [sp, #-16]!
+    stp x27, x28, [sp, #-16]!
+    stp x29, x30, [sp, #-16]!
+
+    mov x23, #0  // fired_count
+
+    // Validate parameters
+    cbz x0, timer_wheel_process_done
+    cmp x1, #MAX_CORES
+    b.ge timer_wheel_process_done
+
+    mov x19, x0  // scheduler_states
+    mov x20, x1  // core_id
+    mov x21, x2  // now
+
+    mov x3, #scheduler_size
+    madd x3, x20, x3, x19
+    ldr x22, [x3, #scheduler_timer_wheel]
+    cbz x22, timer_wheel_process_done
+
+    // Adopt timers pushed by other cores
+    mov x0, x22
+    bl _timer_wheel_drain_inbox
+
+    // Slots to visit: current tick through now tick, capped at one rotation
+    ldr x3, [x22, #wheel_shift]
+    lsr x4, x21, x3                   // now tick
+    ldr x24, [x22, #wheel_current_tick]
+    cmp x4, x24
+    b.lo timer_wheel_process_bound
+    sub x25, x4, x24
+    add x25, x25, #1
+    mov x5, #TIMER_WHEEL_SLOTS
+    cmp x25, x5
+    csel x25, x5, x25, hi
+    str x4, [x22, #wheel_current_tick]
+
+timer_wheel_process_slot:
+    cbz x25, timer_wheel_process_bound
+    and x5, x24, #TIMER_WHEEL_SLOT_MASK
+    add x26, x22, #wheel_slots
+    add x26, x26, x5, lsl #3          // slot head address
+    ldr x27, [x26]
+
+timer_wheel_process_node:
+    cbz x27, timer_wheel_process_next_slot
+    ldr x28, [x27, #timer_next]
+    ldr w5, [x27, #timer_state]
+    cmp w5, #TIMER_STATE_CANCELLED
+    b.eq timer_wheel_process_reclaim
+    ldr x5, [x27, #timer_expiry]
+    cmp x5, x21
+    b.hi timer_wheel_process_advance
+
+    // Expired: unlink and dispatch
+    mov x0, x22
+    mov x1, x27
+    mov x2, x26
+    bl _timer_wheel_unlink
+    mov x0, x19
+    mov x1, x20
+    mov x2, x22
+    mov x3, x27
+    mov x4, x21
+    bl _timer_dispatch
+    add x23, x23, x0
+    b timer_wheel_process_advance
+
+timer_wheel_process_reclaim:
+    mov x0, x22
+    mov x1, x27
+    mov x2, x26
+    bl _timer_wheel_unlink
+    mov x0, x22
+    mov x1, x27
+    bl _timer_node_free
+    ldr x0, [x22, #wheel_reclaimed]
+    add x0, x0, #1
+    str x0, [x22, #wheel_reclaimed]
+
+timer_wheel_process_advance:
+    mov x27, x28
+    b timer_wheel_process_node
+
+timer_wheel_process_next_slot:
+    add x24, x24, #1
+    sub x25, x25, #1
+    b timer_wheel_process_slot
+
+timer_wheel_process_bound:
+    // Refresh the lower bounds once either has been consumed
+    ldr x0, [x22, #wheel_count]
+    mov x1, #-1                       // best expiry
+    mov x9, #-1                       // best deadline
+    cbz x0, timer_wheel_process_store_bound
+    ldr x1, [x22, #wheel_next_expiry]
+    cmp x1, x21
+    b.ls timer_wheel_process_rescan
+    ldr x9, [x22, #wheel_next_deadline]
+    cmp x9, x21
+    b.hi timer_wheel_process_done
+
+timer_wheel_process_rescan:
+    // Scan slots in tick order; a slot cannot hold anything earlier
+    // than its start tick, so stop once that passes the best deadline
+    ldr x2, [x22, #wheel_current_tick]
+    ldr x7, [x22, #wheel_shift]
+    mov x1, #-1
+    mov x9, #-1
+    mov x3, #TIMER_WHEEL_SLOTS
+    add x4, x22, #wheel_slots
+timer_wheel_scan_slot:
+    lsl x5, x2, x7                    // earliest possible expiry in this slot
+    cmp x5, x9
+    b.hs timer_wheel_process_store_bound
+    and x5, x2, #TIMER_WHEEL_SLOT_MASK
+    ldr x6, [x4, x5, lsl #3]
+timer_wheel_scan_node:
+    cbz x6, timer_wheel_scan_next_slot
+    ldr w8, [x6, #timer_state]
+    cmp w8, #TIMER_STATE_ARMED
+    b.ne timer_wheel_scan_skip
+    ldr x8, [x6, #timer_expiry]
+    cmp x8, x1
+    csel x1, x8, x1, lo
+    ldr x10, [x6, #timer_slack]
+    adds x8, x8, x10
+    csinv x8, x8, xzr, cc
+    cmp x8, x9
+    csel x9, x8, x9, lo
+timer_wheel_scan_skip:
+    ldr x6, [x6, #timer_next]
+    b timer_wheel_scan_node
+timer_wheel_scan_next_slot:
+    add x2, x2, #1
+    subs x3, x3, #1
+    b.ne timer_wheel_scan_slot
+
+timer_wheel_process_store_bound:
+    str x1, [x22, #wheel_next_expiry]
+    str x9, [x22, #wheel_next_deadline]
+
+timer_wheel_process_done:
+    mov x0, x23
+    ldp x29, x30, [sp], #16
+    ldp x27, x28, [sp], #16
+    ldp x25, x26, [sp], #16
+    ldp x23, x24, [sp], #16
+    ldp x21, x22, [sp], #16
+    ldp x19, x20, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Timer Wheel Tick
+// ------------------------------------------------------------
+// Per-iteration timer work for one scheduler: expire this core's
+// wheel against the scheduler's cached clock. Called from the
+// scheduler main loop after the clock refresh.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (uint64_t) - fired_count: Timers dispatched on this core
+//
+// Complexity: O(s + n) - See _timer_wheel_process
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_timer_wheel_tick:
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+
+    mov x19, x0
+    mov x20, x1
+    bl _scheduler_get_cached_now
+    mov x2, x0
+    mov x0, x19
+    mov x1, x20
+    bl _timer_wheel_process
+
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Timer Wheel Next Expiry
+// ------------------------------------------------------------
+// Lower bound on the earliest pending expiry for one scheduler. Never
+// later than the true earliest timer, so sleeping until it is safe.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (uint64_t) - expiry: Tick value, or UINT64_MAX if no timers/wheel
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_timer_wheel_next_expiry:
+    cbz x0, timer_wheel_next_expiry_none
+    cmp x1, #MAX_CORES
+    b.ge timer_wheel_next_expiry_none
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0
+    ldr x2, [x2, #scheduler_timer_wheel]
+    cbz x2, timer_wheel_next_expiry_none
+    ldr x0, [x2, #wheel_next_expiry]
+    ret
+timer_wheel_next_expiry_none:
+    mov x0, #-1
+    ret
+
+// ------------------------------------------------------------
+// Timer Wheel Next Deadline
+// ------------------------------------------------------------
+// Earliest "must fire by" time (expiry + slack) on one scheduler's
+// wheel. This is when an idle scheduler must wake: processing the
+// wheel at that moment fires every timer already past its expiry, so
+// all deadlines inside the slack window coalesce into one wakeup.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (uint64_t) - deadline: Tick value, or UINT64_MAX if no timers/wheel
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_timer_wheel_next_deadline:
+    cbz x0, timer_wheel_next_deadline_none
+    cmp x1, #MAX_CORES
+    b.ge timer_wheel_next_deadline_none
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0
+    ldr x2, [x2, #scheduler_timer_wheel]
+    cbz x2, timer_wheel_next_deadline_none
+    ldr x0, [x2, #wheel_next_deadline]
+    ret
+timer_wheel_next_deadline_none:
+    mov x0, #-1
+    ret
+
+// ------------------------------------------------------------
+// Timer Wheel Set Default Slack
+// ------------------------------------------------------------
+// Set the slack _timer_arm applies on one scheduler's wheel. Affects
+// timers armed afterwards, including timed blocking.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//   x2 (uint64_t) - slack_ticks: Default slack in clock ticks
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 if the core has no wheel
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_timer_wheel_set_default_slack:
+    cbz x0, timer_wheel_set_slack_failed
+    cmp x1, #MAX_CORES
+    b.ge timer_wheel_set_slack_failed
+    mov x3, #scheduler_size
+    madd x3, x1, x3, x0
+    ldr x3, [x3, #scheduler_timer_wheel]
+    cbz x3, timer_wheel_set_slack_failed
+    str x2, [x3, #wheel_default_slack]
+    mov x0, #1
+    ret
+timer_wheel_set_slack_failed:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Timer Wheel Count
+// ------------------------------------------------------------
+// Number of timers linked into one scheduler's wheel, including
+// cancelled timers not yet reclaimed. Inbox timers are not counted.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (uint64_t) - count: Linked timers, 0 if no wheel
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_timer_wheel_count:
+    cbz x0, timer_wheel_count_none
+    cmp x1, #MAX_CORES
+    b.ge timer_wheel_count_none
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0
+    ldr x2, [x2, #scheduler_timer_wheel]
+    cbz x2, timer_wheel_count_none
+    ldr x0, [x2, #wheel_count]
+    ret
+timer_wheel_count_none:
+    mov x0, #0
+    ret
 
 // Import required functions from other modules
     .extern _mmap
     .extern _free
+    .extern _munmap
+    .extern _clock_read_ticks
+    .extern _scheduler_get_cached_now
+    .extern _process_wake
+    .extern _send_message
+    .extern _scheduler_wake
+    .extern _trace_record
@@ -0,0 +1,666 @@
+// MIT License
+//
+// Copyright (c) 2025 Lee Barney
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ------------------------------------------------------------
+// trace.s — Per-Core Event Trace Rings
+// ------------------------------------------------------------
+// Low-overhead flight recorder for the schedulers. Each scheduler
+// owns one ring of fixed-size binary events and is the only writer,
+// so recording needs no atomics: the event is stored, then the head
+// is published with a release store. When the ring is full the
+// oldest events are overwritten.
+//
+// Recording is gated by the scheduler's trace mask (one bit per
+// TRACE_CLASS_*). Instrumented code tests the class bit with a single
+// ldr/tbz pair on the scheduler state it already holds and only calls
+// _trace_record when the class is enabled, so disabled tracing costs
+// one load and one not-taken branch. A mask can only be set once the
+// ring exists, so _trace_record never checks it.
+//
+// Readers (a dump tool, a debugger, a monitoring thread) copy events
+// out with _trace_read, which discards any event the writer may have
+// overwritten during the copy.
+//
+// The file provides:
+//   - Ring creation and destruction per scheduler
+//   - Class mask control
+//   - Event recording (internal fast path and checked C entry point)
+//   - PC sampling of the running process at reduction checks
+//   - Consistent ring readout, oldest event first
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+
+    .text
+    .align 4
+
+// Include configuration constants
+    .include "config.inc"
+
+// ------------------------------------------------------------
+// Trace Function Exports
+// ------------------------------------------------------------
+// Export the trace functions to make them callable from C code.
+//
+// WARNING: These exports are intended ONLY for unit testing and other
+// testing purposes. There is NO guarantee they will exist over various
+// versions, nor any intention to make them stable or backwards compatible
+// over versions. Do not use these exports in production code.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .global _trace_init
+    .global _trace_destroy
+    .global _trace_set_mask
+    .global _trace_get_mask
+    .global _trace_event
+    .global _trace_record
+    .global _trace_set_sample_period
+    .global _trace_sample
+    .global _trace_count
+    .global _trace_read
+    .global _TRACE_EVENT_SIZE_CONST
+
+// ------------------------------------------------------------
+// Trace Structure Layout
+// ------------------------------------------------------------
+// A ring is one anonymous mapping: a header followed by a power-of-two
+// array of events. head counts every event ever recorded; event i
+// lives in slot (i & mask). The event ID's low 32 bits and the core ID
+// share one word so an event is exactly four words.
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+    .equ trace_ring_head, 0           // Events recorded so far (8 bytes)
+    .equ trace_ring_mask, 8           // capacity - 1 (8 bytes)
+    .equ trace_ring_capacity, 16      // Events the ring holds (8 bytes)
+    .equ trace_ring_length, 24        // Mapping length for munmap (8 bytes)
+    .equ trace_ring_sample_period, 32 // Reduction checks per PC sample (8 bytes)
+    .equ trace_ring_sample_countdown, 40 // Checks until the next sample (8 bytes)
+    .equ trace_ring_events, 64        // First event (header padded to 64)
+
+    .equ trace_event_timestamp, 0     // CNTVCT_EL0 ticks (8 bytes)
+    .equ trace_event_id, 8            // TRACE_EVENT_* (4 bytes)
+    .equ trace_event_core, 12         // Recording core (4 bytes)
+    .equ trace_event_pid, 16          // Process ID, 0 if none (8 bytes)
+    .equ trace_event_arg, 24          // Event-specific argument (8 bytes)
+    .equ trace_event_size, 32         // Total event size
+    .equ TRACE_EVENT_SHIFT, 5         // log2(trace_event_size)
+
+    // Scheduler state offsets (shared with scheduler.s)
+    .include "scheduler_state.inc"
+
+// ------------------------------------------------------------
+// Trace Init
+// ------------------------------------------------------------
+// Create a scheduler's trace ring. Tracing stays disabled (mask 0)
+// until _trace_set_mask. Calling it again for a scheduler that already
+// has a ring succeeds without changing the ring.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//   x2 (uint64_t) - capacity: Events to keep (power of 2,
+//                   TRACE_RING_MIN_EVENTS to TRACE_RING_MAX_EVENTS)
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 on invalid arguments or mmap failure
+//
+// Complexity: O(1) - One mmap
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_trace_init:
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+    stp x20, x21, [sp, #-16]!
+
+    // Validate parameters
+    cbz x0, trace_init_failed
+    cmp x1, #MAX_CORES
+    b.hs trace_init_failed
+    cmp x2, #TRACE_RING_MIN_EVENTS
+    b.lo trace_init_failed
+    mov x3, #TRACE_RING_MAX_EVENTS
+    cmp x2, x3
+    b.hi trace_init_failed
+    sub x3, x2, #1
+    tst x2, x3
+    b.ne trace_init_failed            // Not a power of 2
+
+    mov x3, #scheduler_size
+    madd x19, x1, x3, x0              // x19 = scheduler state address
+    mov x20, x2                       // capacity
+
+    // Already initialized?
+    ldr x0, [x19, #scheduler_trace_ring]
+    cbnz x0, trace_init_done
+
+    // Allocate header + events (anonymous mappings are zero-filled)
+    lsl x21, x20, #TRACE_EVENT_SHIFT
+    add x21, x21, #trace_ring_events
+    mov x0, xzr                       // addr = NULL (let system choose)
+    mov x1, x21                       // length
+    mov x2, #3                        // prot = PROT_READ | PROT_WRITE
+    mov x3, #MMAP_PRIVATE_ANON        // flags = MAP_PRIVATE | MAP_ANON
+    mov x4, #-1                       // fd = -1 (not a file mapping)
+    mov x5, xzr                       // offset = 0
+    bl _mmap
+    cmp x0, #-1
+    b.eq trace_init_failed
+
+    sub x1, x20, #1
+    str x1, [x0, #trace_ring_mask]
+    str x20, [x0, #trace_ring_capacity]
+    str x21, [x0, #trace_ring_length]
+
+    // Publish to the scheduler state (release: readers may be on other cores)
+    add x1, x19, #scheduler_trace_ring
+    stlr x0, [x1]
+
+trace_init_done:
+    mov x0, #1
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+trace_init_failed:
+    mov x0, #0
+    ldp x20, x21, [sp], #16
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Trace Destroy
+// ------------------------------------------------------------
+// Disable tracing on a scheduler and release its ring. Call while the
+// scheduler is stopped (or from its own core) so no event is being
+// recorded into the ring as it is unmapped.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (int) - success: 1 on success (including no ring), 0 on invalid arguments
+//
+// Complexity: O(1) - One munmap
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_trace_destroy:
+    // Save callee-saved registers
+    stp x19, x30, [sp, #-16]!
+
+    // Validate parameters
+    cbz x0, trace_destroy_failed
+    cmp x1, #MAX_CORES
+    b.hs trace_destroy_failed
+
+    mov x2, #scheduler_size
+    madd x2, x1, x2, x0               // x2 = scheduler state address
+
+    // Mask first, so instrumented code stops calling _trace_record
+    str wzr, [x2, #scheduler_trace_mask]
+    ldr x19, [x2, #scheduler_trace_ring]
+    cbz x19, trace_destroy_done
+    str xzr, [x2, #scheduler_trace_ring]
+
+    mov x0, x19
+    ldr x1, [x19, #trace_ring_length]
+    bl _munmap
+
+trace_destroy_done:
+    mov x0, #1
+    ldp x19, x30, [sp], #16
+    ret
+
+trace_destroy_failed:
+    mov x0, #0
+    ldp x19, x30, [sp], #16
+    ret
+
+// ------------------------------------------------------------
+// Trace Set Mask
+// ------------------------------------------------------------
+// Choose which event classes a scheduler records: bit n enables
+// TRACE_CLASS n (TRACE_CLASS_ALL enables everything, 0 disables
+// tracing). Bits outside TRACE_CLASS_ALL are ignored. Takes effect at
+// the scheduler's next instrumented point.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//   x2 (uint64_t) - mask: Enabled TRACE_CLASS_* bits
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 on invalid arguments or if a
+//              non-zero mask is set before _trace_init
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_trace_set_mask:
+    cbz x0, trace_set_mask_failed
+    cmp x1, #MAX_CORES
+    b.hs trace_set_mask_failed
+
+    mov x3, #scheduler_size
+    madd x3, x1, x3, x0               // x3 = scheduler state address
+    and x2, x2, #TRACE_CLASS_ALL
+    cbz x2, trace_set_mask_store
+    ldr x4, [x3, #scheduler_trace_ring]
+    cbz x4, trace_set_mask_failed
+
+trace_set_mask_store:
+    // Release: the ring header is visible before any class is enabled
+    add x3, x3, #scheduler_trace_mask
+    stlr w2, [x3]
+    mov x0, #1
+    ret
+
+trace_set_mask_failed:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Trace Get Mask
+// ------------------------------------------------------------
+// Return the event classes a scheduler currently records.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (uint64_t) - mask: Enabled TRACE_CLASS_* bits, 0 on invalid arguments
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_trace_get_mask:
+    cbz x0, trace_get_mask_none
+    cmp x1, #MAX_CORES
+    b.hs trace_get_mask_none
+    mov x2, #scheduler_size
+    madd x0, x1, x2, x0
+    ldr w0, [x0, #scheduler_trace_mask]
+    ret
+
+trace_get_mask_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Trace Record (internal fast path)
+// ------------------------------------------------------------
+// Append one event to a scheduler's ring. Callers have already
+// tested the event's class bit in scheduler_trace_mask, which is
+// only ever non-zero while the ring exists. Must run on the
+// scheduler's own core (single writer).
+//
+// The timestamp is read without an isb: an event may be stamped a
+// few instructions early, which is immaterial at trace resolution
+// and keeps the pipeline flowing. Under virtual time (sim.s) events
+// are stamped with the scheduler's simulated cached_now instead.
+//
+// Parameters:
+//   x0 (void*) - scheduler_state: This scheduler's state (not the array)
+//   x1 (uint64_t) - event: TRACE_EVENT_*
+//   x2 (uint64_t) - pid: Process ID, or 0
+//   x3 (uint64_t) - arg: Event-specific argument
+//
+// Returns:
+//   None (x0-x8 preserved)
+//
+// Complexity: O(1) - Five stores, no atomics
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x9, x10, x11, x12, x13
+//
+_trace_record:
+    ldr x9, [x0, #scheduler_trace_ring]
+    cbz x9, trace_record_done
+    ldr x10, [x9, #trace_ring_head]
+    ldr x11, [x9, #trace_ring_mask]
+    and x11, x10, x11
+    add x11, x9, x11, lsl #TRACE_EVENT_SHIFT
+    add x11, x11, #trace_ring_events  // x11 = slot
+
+    ldr w12, [x0, #scheduler_flags]
+    tbnz w12, #SCHEDULER_FLAG_VIRTUAL_TIME, trace_record_virtual
+    mrs x12, CNTVCT_EL0
+    b trace_record_stamp
+trace_record_virtual:
+    ldr x12, [x0, #scheduler_cached_now]
+trace_record_stamp:
+    ldr x13, [x0, #scheduler_core_id]
+    orr x13, x1, x13, lsl #32         // id | core << 32
+    stp x12, x13, [x11, #trace_event_timestamp]
+    stp x2, x3, [x11, #trace_event_pid]
+
+    // Publish (release: the event is complete before head covers it)
+    add x10, x10, #1
+    stlr x10, [x9]                    // trace_ring_head = 0
+
+trace_record_done:
+    ret
+
+// ------------------------------------------------------------
+// Trace Event
+// ------------------------------------------------------------
+// Record an event from C or from code that does not hold the
+// scheduler state: validates the arguments and checks the event's
+// class against the scheduler's mask before recording. Must run on
+// the scheduler's own core.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Recording core ID (0 to MAX_CORES-1)
+//   x2 (uint64_t) - event: TRACE_EVENT_*
+//   x3 (uint64_t) - pid: Process ID, or 0
+//   x4 (uint64_t) - arg: Event-specific argument
+//
+// Returns:
+//   x0 (int) - recorded: 1 if recorded, 0 if filtered or invalid
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_trace_event:
+    cbz x0, trace_event_filtered
+    cmp x1, #MAX_CORES
+    b.hs trace_event_filtered
+    mov x5, #scheduler_size
+    madd x0, x1, x5, x0               // x0 = scheduler state address
+
+    // Class bit test
+    ldr w5, [x0, #scheduler_trace_mask]
+    ubfx x6, x2, #8, #8               // class = event >> 8
+    cmp x6, #32
+    b.hs trace_event_filtered
+    lsr w5, w5, w6
+    tbz w5, #0, trace_event_filtered
+
+    mov x1, x2
+    mov x2, x3
+    mov x3, x4
+    mov x7, x30                       // _trace_record preserves x0-x8
+    bl _trace_record
+    mov x30, x7
+    mov x0, #1
+    ret
+
+trace_event_filtered:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Trace Set Sample Period
+// ------------------------------------------------------------
+// Choose how often TRACE_CLASS_SAMPLE records the running process's
+// PC: one PC_SAMPLE event every `period` reduction checks (0 or 1
+// samples every check). Set it before enabling the class, or from the
+// scheduler's own thread.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//   x2 (uint64_t) - period: Reduction checks per sample
+//
+// Returns:
+//   x0 (int) - success: 1 on success, 0 on invalid arguments or no ring
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_trace_set_sample_period:
+    cbz x0, trace_set_sample_period_failed
+    cmp x1, #MAX_CORES
+    b.hs trace_set_sample_period_failed
+    mov x3, #scheduler_size
+    madd x3, x1, x3, x0               // x3 = scheduler state address
+    ldr x4, [x3, #scheduler_trace_ring]
+    cbz x4, trace_set_sample_period_failed
+    str x2, [x4, #trace_ring_sample_period]
+    str x2, [x4, #trace_ring_sample_countdown]
+    mov x0, #1
+    ret
+
+trace_set_sample_period_failed:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Trace Sample
+// ------------------------------------------------------------
+// Count one reduction check towards the next PC sample and, when the
+// period is reached, record PC_SAMPLE for the running process. Called
+// from reduction checks after they have tested TRACE_CLASS_SAMPLE, with
+// the check's return address as the PC, so samples land in the actor
+// code that was running. Must run on the scheduler's own core.
+//
+// Parameters:
+//   x0 (void*) - scheduler_state: This scheduler's state (not the array)
+//   x1 (uint64_t) - pid: Running process ID
+//   x2 (uint64_t) - pc: Sampled program counter
+//
+// Returns:
+//   x0 (int) - sampled: 1 if an event was recorded, 0 otherwise
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+// Clobbers: x1-x7, x9-x13
+//
+_trace_sample:
+    ldr x4, [x0, #scheduler_trace_ring]
+    cbz x4, trace_sample_skipped
+    ldr x5, [x4, #trace_ring_sample_countdown]
+    subs x5, x5, #1
+    b.gt trace_sample_wait
+
+    // Period reached: rearm and record
+    ldr x5, [x4, #trace_ring_sample_period]
+    str x5, [x4, #trace_ring_sample_countdown]
+    mov x3, x2
+    mov x2, x1
+    mov x1, #TRACE_EVENT_PC_SAMPLE
+    mov x7, x30                       // _trace_record preserves x0-x8
+    bl _trace_record
+    mov x30, x7
+    mov x0, #1
+    ret
+
+trace_sample_wait:
+    str x5, [x4, #trace_ring_sample_countdown]
+trace_sample_skipped:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Trace Count
+// ------------------------------------------------------------
+// Total events a scheduler has recorded since its ring was created.
+// Anything beyond the ring capacity has been overwritten.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//
+// Returns:
+//   x0 (uint64_t) - count: Events recorded, 0 if no ring or invalid arguments
+//
+// Complexity: O(1)
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_trace_count:
+    cbz x0, trace_count_none
+    cmp x1, #MAX_CORES
+    b.hs trace_count_none
+    mov x2, #scheduler_size
+    madd x0, x1, x2, x0
+    ldr x0, [x0, #scheduler_trace_ring]
+    cbz x0, trace_count_none
+    ldar x0, [x0]                     // trace_ring_head = 0
+    ret
+
+trace_count_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Trace Read
+// ------------------------------------------------------------
+// Copy a scheduler's most recent events into a caller buffer, oldest
+// first. Safe while the scheduler keeps recording: after the copy the
+// head is re-read and any event the writer could have overwritten in
+// the meantime is dropped from the front of the buffer.
+//
+// Parameters:
+//   x0 (void*) - scheduler_states: Pointer to scheduler states array
+//   x1 (uint64_t) - core_id: Core ID (0 to MAX_CORES-1)
+//   x2 (void*) - buffer: Destination, max_events * trace_event_size bytes
+//   x3 (uint64_t) - max_events: Buffer capacity in events
+//
+// Returns:
+//   x0 (uint64_t) - count: Events copied, 0 if no ring or invalid arguments
+//
+// Complexity: O(n) where n is the number of events copied
+//
+// Version: 0.12
+// Author: Lee Barney
+// Last Modified: 2026-10-18
+//
+_trace_read:
+    cbz x0, trace_read_none
+    cmp x1, #MAX_CORES
+    b.hs trace_read_none
+    cbz x2, trace_read_none
+    cbz x3, trace_read_none
+    mov x4, #scheduler_size
+    madd x4, x1, x4, x0
+    ldr x4, [x4, #scheduler_trace_ring]
+    cbz x4, trace_read_none
+
+    // count = min(head, capacity, max_events); start = head - count
+    ldar x5, [x4]                     // trace_ring_head = 0
+    ldr x6, [x4, #trace_ring_capacity]
+    ldr x7, [x4, #trace_ring_mask]
+    cmp x5, x6
+    csel x8, x5, x6, lo
+    cmp x8, x3
+    csel x8, x8, x3, lo               // x8 = count
+    cbz x8, trace_read_none
+    sub x9, x5, x8                    // x9 = start index
+    add x10, x4, #trace_ring_events
+
+    mov x11, x9
+    mov x12, x2
+trace_read_copy:
+    and x13, x11, x7
+    add x13, x10, x13, lsl #TRACE_EVENT_SHIFT
+    ldp x14, x15, [x13]
+    ldp x16, x17, [x13, #16]
+    stp x14, x15, [x12]
+    stp x16, x17, [x12, #16]
+    add x12, x12, #trace_event_size
+    add x11, x11, #1
+    cmp x11, x5
+    b.lo trace_read_copy
+
+    // The writer may have lapped the copy: events older than
+    // (head + 1 - capacity) can have been overwritten, including the
+    // slot of the event being written right now
+    dmb ishld
+    ldr x11, [x4]                     // trace_ring_head = 0
+    add x11, x11, #1
+    subs x11, x11, x6                 // x11 = oldest safe index
+    b.ls trace_read_done
+    cmp x11, x9
+    b.ls trace_read_done
+    sub x13, x11, x9                  // x13 = events to drop
+    cmp x13, x8
+    b.hs trace_read_none
+    sub x8, x8, x13
+
+    // Slide the surviving events to the front of the buffer
+    add x12, x2, x13, lsl #TRACE_EVENT_SHIFT
+    mov x14, x2
+    mov x15, x8
+trace_read_slide:
+    ldp x16, x17, [x12]
+    stp x16, x17, [x14]
+    ldp x16, x17, [x12, #16]
+    stp x16, x17, [x14, #16]
+    add x12, x12, #trace_event_size
+    add x14, x14, #trace_event_size
+    subs x15, x15, #1
+    b.ne trace_read_slide
+
+trace_read_done:
+    mov x0, x8
+    ret
+
+trace_read_none:
+    mov x0, #0
+    ret
+
+// ------------------------------------------------------------
+// Constant Definitions for C Code
+// ------------------------------------------------------------
+    .data
+    .align 3
+
+_TRACE_EVENT_SIZE_CONST:
+    .quad trace_event_size
@@ -42,6 +42,9 @@
     .text
     .align 4
 
+// Include configuration constants
+    .include "config.inc"
+
 // Define constants (matching scheduler.s and config.inc)
 .equ MAX_CORES, 128
 .equ PRIORITY_LEVELS, 4
@@ -58,19 +61,11 @@
 .equ BIF_YIELD_COST, 1
 .equ MAX_BLOCKING_TIME, 1000000
 
-// Define structure offsets (matching scheduler.s)
-.equ scheduler_current_reductions, 112
-.equ scheduler_total_yields, 128
-.equ scheduler_queues, 8
-.equ queue_count, 16
-    .equ scheduler_size, 248
-.equ queue_size, 24
+// Scheduler state offsets (shared with scheduler.s)
+    .include "scheduler_state.inc"
 
-// Define PCB offsets (matching process.s)
-.equ pcb_state, 32
-.equ pcb_priority, 40
-.equ pcb_next, 0
-.equ pcb_prev, 8
+// PCB offsets (shared with process.s)
+    .include "pcb.inc"
 
 // External function declarations (macOS linker requirements)
 .extern _scheduler_get_current_process
@@ -79,6 +74,8 @@
 .extern _scheduler_schedule
 .extern _process_save_context
 .extern _process_restore_context
+.extern _trace_record
+.extern _trace_sample
 
 // ------------------------------------------------------------
 // Yield Function Exports
@@ -116,6 +113,8 @@
 // Check if reductions are exhausted and yield if needed.
 // This is the core preemption mechanism that checks reduction count
 // and triggers preemption when the time slice is exhausted.
+// With TRACE_CLASS_SAMPLE enabled, counts towards the next PC sample,
+// taking the caller's return address as the running process's PC.
 //
 // Parameters:
 //   x0 (void*) - scheduler_states: Pointer to scheduler states array
@@ -157,6 +156,15 @@ _process_yield_check:
     mul x22, x20, x22
     add x22, x19, x22  // x22 = scheduler state address
 
+    // Profile: sample the PC in the caller (lr is still the caller's)
+    ldr w23, [x22, #scheduler_trace_mask]
+    tbz w23, #TRACE_CLASS_SAMPLE, yield_check_sampled
+    mov x0, x22
+    ldr x1, [x21, #pcb_pid]
+    mov x2, x30
+    bl _trace_sample
+yield_check_sampled:
+
     // Load current reduction count
     ldr x23, [x22, #scheduler_current_reductions]
     cbz x23, yield_check_exhausted
@@ -269,6 +277,16 @@ _process_preempt:
     add x25, x25, #1
     str x25, [x22, #scheduler_total_yields]
 
+    // Trace: preempted for exhausting its reductions
+    ldr w25, [x22, #scheduler_trace_mask]
+    tbz w25, #TRACE_CLASS_YIELD, preempt_trace_done
+    mov x0, x22
+    mov x1, #TRACE_EVENT_PREEMPT
+    ldr x2, [x21, #pcb_pid]
+    mov x3, #TRACE_YIELD_REDUCTIONS
+    bl _trace_record
+preempt_trace_done:
+
     // Schedule next process
     mov x0, x19  // scheduler_states pointer
     mov x1, x20  // core_id
@@ -590,6 +608,16 @@ _process_yield_with_state:
     add x26, x26, #1
     str x26, [x23, #scheduler_total_yields]  // Use scheduler state for scheduler fields
 
+    // Trace: voluntary yield
+    ldr w26, [x23, #scheduler_trace_mask]
+    tbz w26, #TRACE_CLASS_YIELD, yield_with_state_trace_done
+    mov x0, x23
+    mov x1, #TRACE_EVENT_YIELD
+    ldr x2, [x21, #pcb_pid]
+    mov x3, #TRACE_YIELD_VOLUNTARY
+    bl _trace_record
+yield_with_state_trace_done:
+
     // Schedule next process
     mov x0, x19  // scheduler_states
     mov x1, x20  // core_id